@@ -2106,6 +2106,12 @@ void ParseFileOperations(yyjson_val* root, Common::Settings::Settings& out)
         settings.diagnosticsCleanupIntervalMs = diagnosticsCleanupIntervalMs;
     }
 
+    uint32_t bridgeMaxConcurrentFiles = 0;
+    if (GetUInt32(fileOperations, "bridgeMaxConcurrentFiles", bridgeMaxConcurrentFiles))
+    {
+        settings.bridgeMaxConcurrentFiles = bridgeMaxConcurrentFiles;
+    }
+
     out.fileOperations = std::move(settings);
 }
 
@@ -3816,7 +3822,8 @@ HRESULT SaveSettings(std::wstring_view appId, const Settings& settings) noexcept
             settings.fileOperations->diagnosticsInfoEnabled != defaults.diagnosticsInfoEnabled ||
             settings.fileOperations->diagnosticsDebugEnabled != defaults.diagnosticsDebugEnabled || settings.fileOperations->maxIssueReportFiles.has_value() ||
             settings.fileOperations->maxDiagnosticsInMemory.has_value() || settings.fileOperations->maxDiagnosticsPerFlush.has_value() ||
-            settings.fileOperations->diagnosticsFlushIntervalMs.has_value() || settings.fileOperations->diagnosticsCleanupIntervalMs.has_value();
+            settings.fileOperations->diagnosticsFlushIntervalMs.has_value() || settings.fileOperations->diagnosticsCleanupIntervalMs.has_value() ||
+            settings.fileOperations->bridgeMaxConcurrentFiles.has_value();
 
         if (wroteFileOperations)
         {
@@ -3871,6 +3878,11 @@ HRESULT SaveSettings(std::wstring_view appId, const Settings& settings) noexcept
             {
                 yyjson_mut_obj_add_uint(doc, fileOperations, "diagnosticsCleanupIntervalMs", settings.fileOperations->diagnosticsCleanupIntervalMs.value());
             }
+
+            if (settings.fileOperations->bridgeMaxConcurrentFiles.has_value())
+            {
+                yyjson_mut_obj_add_uint(doc, fileOperations, "bridgeMaxConcurrentFiles", settings.fileOperations->bridgeMaxConcurrentFiles.value());
+            }
         }
     }
 
@@ -0,0 +1,644 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#include "PlugInterfaces/FileSystem.h"
+
+// Column storage behind IFilesInformationCompact, shared by the plugins whose listings only carry name, size, last write time
+// and attributes. Per entry it costs 24 bytes plus the name (one byte per character when every name fits in ISO-8859-1),
+// against a FileInfo record of 80 bytes plus a NUL-terminated UTF-16 name.
+class CompactFilesListing
+{
+public:
+    // True when nothing but the four compact columns would be lost: entries carry no file index and no creation, access or change
+    // time that differs from the last write time. Works with any plugin Entry struct exposing the usual field names.
+    template <typename Entry> [[nodiscard]] static bool CanRepresent(const std::vector<Entry>& entries) noexcept
+    {
+        for (const Entry& entry : entries)
+        {
+            if constexpr (requires { entry.fileIndex; })
+            {
+                if (entry.fileIndex != 0)
+                {
+                    return false;
+                }
+            }
+            if constexpr (requires { entry.creationTime; })
+            {
+                if (entry.creationTime != 0 && entry.creationTime != entry.lastWriteTime)
+                {
+                    return false;
+                }
+            }
+            if constexpr (requires { entry.lastAccessTime; })
+            {
+                if (entry.lastAccessTime != 0 && entry.lastAccessTime != entry.lastWriteTime)
+                {
+                    return false;
+                }
+            }
+            if constexpr (requires { entry.changeTime; })
+            {
+                if (entry.changeTime != 0 && entry.changeTime != entry.lastWriteTime)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Copies `entries` in order (callers sort first).
+    template <typename Entry> HRESULT Build(const std::vector<Entry>& entries) noexcept
+    {
+        Clear();
+
+        if (entries.size() >= static_cast<size_t>((std::numeric_limits<unsigned long>::max)()))
+        {
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+        }
+
+        bool narrow      = true;
+        size_t nameChars = 0;
+        for (const Entry& entry : entries)
+        {
+            nameChars += entry.name.size();
+            for (const wchar_t ch : entry.name)
+            {
+                narrow = narrow && static_cast<uint16_t>(ch) <= 0xFFu;
+            }
+        }
+        if (nameChars > static_cast<size_t>((std::numeric_limits<unsigned long>::max)()))
+        {
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+        }
+
+        try
+        {
+            _nameOffsets.reserve(entries.size() + 1u);
+            _attributes.reserve(entries.size());
+            _sizes.reserve(entries.size());
+            _lastWriteTimes.reserve(entries.size());
+            if (narrow)
+            {
+                _narrowNames.reserve(nameChars);
+            }
+            else
+            {
+                _wideNames.reserve(nameChars);
+            }
+
+            for (const Entry& entry : entries)
+            {
+                _nameOffsets.push_back(static_cast<unsigned long>(narrow ? _narrowNames.size() : _wideNames.size()));
+                if (narrow)
+                {
+                    for (const wchar_t ch : entry.name)
+                    {
+                        _narrowNames.push_back(static_cast<char>(static_cast<unsigned char>(ch)));
+                    }
+                }
+                else
+                {
+                    _wideNames.insert(_wideNames.end(), entry.name.begin(), entry.name.end());
+                }
+
+                _attributes.push_back(static_cast<unsigned long>(entry.attributes));
+                _sizes.push_back(static_cast<uint64_t>(entry.sizeBytes));
+                _lastWriteTimes.push_back(static_cast<__int64>(entry.lastWriteTime));
+            }
+            _nameOffsets.push_back(static_cast<unsigned long>(nameChars));
+        }
+        catch (const std::bad_alloc&)
+        {
+            Clear();
+            return E_OUTOFMEMORY;
+        }
+
+        _narrow = narrow;
+        return S_OK;
+    }
+
+    void Clear() noexcept
+    {
+        _nameOffsets.clear();
+        _wideNames.clear();
+        _narrowNames.clear();
+        _attributes.clear();
+        _sizes.clear();
+        _lastWriteTimes.clear();
+        _narrow = false;
+    }
+
+    [[nodiscard]] unsigned long Count() const noexcept
+    {
+        return static_cast<unsigned long>(_attributes.size());
+    }
+
+    [[nodiscard]] uint64_t AllocatedBytes() const noexcept
+    {
+        return static_cast<uint64_t>(_nameOffsets.capacity() * sizeof(unsigned long) + _wideNames.capacity() * sizeof(wchar_t) + _narrowNames.capacity() +
+                                     _attributes.capacity() * sizeof(unsigned long) + _sizes.capacity() * sizeof(uint64_t) +
+                                     _lastWriteTimes.capacity() * sizeof(__int64));
+    }
+
+    void GetView(FilesInformationCompactView& view) const noexcept
+    {
+        view.count          = Count();
+        view.flags          = _narrow ? FILESINFO_COMPACT_NARROW_NAMES : FILESINFO_COMPACT_NONE;
+        view.nameOffsets    = _nameOffsets.data();
+        view.namePool       = _narrow ? static_cast<const void*>(_narrowNames.data()) : static_cast<const void*>(_wideNames.data());
+        view.attributes     = _attributes.data();
+        view.sizes          = _sizes.data();
+        view.lastWriteTimes = _lastWriteTimes.data();
+        view.allocatedBytes = AllocatedBytes();
+    }
+
+    // Returns the names as UTF-16. Wide pools are returned as stored; narrow pools are widened into `widened` when it is empty.
+    HRESULT GetWideNames(std::vector<wchar_t>& widened, const wchar_t** names) const noexcept
+    {
+        if (! _narrow)
+        {
+            *names = _wideNames.data();
+            return S_OK;
+        }
+
+        if (widened.size() != _narrowNames.size())
+        {
+            try
+            {
+                widened.resize(_narrowNames.size());
+            }
+            catch (const std::bad_alloc&)
+            {
+                widened.clear();
+                return E_OUTOFMEMORY;
+            }
+
+            for (size_t i = 0; i < _narrowNames.size(); ++i)
+            {
+                widened[i] = static_cast<wchar_t>(static_cast<unsigned char>(_narrowNames[i]));
+            }
+        }
+
+        *names = widened.data();
+        return S_OK;
+    }
+
+    // Lays the listing out as FileInfo records linked by NextEntryOffset, for IFilesInformation callers.
+    // All four FileInfo timestamps report the last write time (CanRepresent guarantees nothing else was known).
+    HRESULT MaterializeFileInfo(std::vector<std::byte>& buffer) const noexcept
+    {
+        buffer.clear();
+
+        const size_t count = _attributes.size();
+        size_t totalBytes  = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            totalBytes += FileInfoSizeBytes(NameLength(i));
+            if (totalBytes > static_cast<size_t>((std::numeric_limits<unsigned long>::max)()))
+            {
+                return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+            }
+        }
+
+        try
+        {
+            buffer.resize(totalBytes, std::byte{0});
+        }
+        catch (const std::bad_alloc&)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        size_t offset = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t nameLength = NameLength(i);
+            const size_t entrySize  = FileInfoSizeBytes(nameLength);
+
+            auto* entry           = reinterpret_cast<FileInfo*>(buffer.data() + offset);
+            entry->FileAttributes = _attributes[i];
+            entry->EndOfFile      = static_cast<__int64>(_sizes[i]);
+            entry->AllocationSize = static_cast<__int64>(_sizes[i]);
+            entry->CreationTime   = _lastWriteTimes[i];
+            entry->LastAccessTime = _lastWriteTimes[i];
+            entry->LastWriteTime  = _lastWriteTimes[i];
+            entry->ChangeTime     = _lastWriteTimes[i];
+            entry->FileNameSize   = static_cast<unsigned long>(nameLength * sizeof(wchar_t));
+
+            const size_t first = _nameOffsets[i];
+            if (_narrow)
+            {
+                for (size_t c = 0; c < nameLength; ++c)
+                {
+                    entry->FileName[c] = static_cast<wchar_t>(static_cast<unsigned char>(_narrowNames[first + c]));
+                }
+            }
+            else if (nameLength > 0)
+            {
+                std::memcpy(entry->FileName, _wideNames.data() + first, nameLength * sizeof(wchar_t));
+            }
+            entry->FileName[nameLength] = L'\0';
+
+            entry->NextEntryOffset = (i + 1u < count) ? static_cast<unsigned long>(entrySize) : 0u;
+            offset += entrySize;
+        }
+
+        return S_OK;
+    }
+
+    // Size of one FileInfo record holding a name of `nameLength` characters plus its NUL, padded to the record alignment.
+    [[nodiscard]] static size_t FileInfoSizeBytes(size_t nameLength) noexcept
+    {
+        const size_t bytes = offsetof(FileInfo, FileName) + (nameLength + 1u) * sizeof(wchar_t);
+        return (bytes + sizeof(unsigned long) - 1u) & ~(sizeof(unsigned long) - 1u);
+    }
+
+private:
+    [[nodiscard]] size_t NameLength(size_t index) const noexcept
+    {
+        return static_cast<size_t>(_nameOffsets[index + 1u] - _nameOffsets[index]);
+    }
+
+    std::vector<unsigned long> _nameOffsets;
+    std::vector<wchar_t> _wideNames;
+    std::vector<char> _narrowNames;
+    std::vector<unsigned long> _attributes;
+    std::vector<uint64_t> _sizes;
+    std::vector<__int64> _lastWriteTimes;
+    bool _narrow = false;
+};
+
+// IFilesInformation (and IFilesInformationCompact when possible) over a listing the plugin has already sorted.
+// Plugin listing classes derive from this, keep their own Entry struct and sort order, and hand the entries to Assign().
+// Entries CompactFilesListing can represent stay as columns and the FileInfo buffer is built on the first IFilesInformation
+// call that needs it; any other listing is laid out as FileInfo records up front.
+class CompactFilesInformationBase : public IFilesInformation, public IFilesInformationCompact
+{
+public:
+    CompactFilesInformationBase()          = default;
+    virtual ~CompactFilesInformationBase() = default;
+
+    CompactFilesInformationBase(const CompactFilesInformationBase&)            = delete;
+    CompactFilesInformationBase(CompactFilesInformationBase&&)                 = delete;
+    CompactFilesInformationBase& operator=(const CompactFilesInformationBase&) = delete;
+    CompactFilesInformationBase& operator=(CompactFilesInformationBase&&)      = delete;
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) noexcept override
+    {
+        if (ppvObject == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(IFilesInformation))
+        {
+            *ppvObject = static_cast<IFilesInformation*>(this);
+            AddRef();
+            return S_OK;
+        }
+
+        if (riid == __uuidof(IFilesInformationCompact) && _compactMode)
+        {
+            *ppvObject = static_cast<IFilesInformationCompact*>(this);
+            AddRef();
+            return S_OK;
+        }
+
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() noexcept override
+    {
+        return _refCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    ULONG STDMETHODCALLTYPE Release() noexcept override
+    {
+        const ULONG result = _refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (result == 0)
+        {
+            delete this;
+        }
+        return result;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetBuffer(FileInfo** ppFileInfo) noexcept override
+    {
+        if (ppFileInfo == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        const HRESULT bufferHr = EnsureFileInfoBuffer();
+        if (FAILED(bufferHr))
+        {
+            return bufferHr;
+        }
+
+        *ppFileInfo = nullptr;
+
+        if (_usedBytes == 0 || _buffer.empty())
+        {
+            return S_OK;
+        }
+
+        *ppFileInfo = reinterpret_cast<FileInfo*>(_buffer.data());
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetBufferSize(unsigned long* pSize) noexcept override
+    {
+        if (pSize == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        const HRESULT bufferHr = EnsureFileInfoBuffer();
+        if (FAILED(bufferHr))
+        {
+            return bufferHr;
+        }
+
+        *pSize = _usedBytes;
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetAllocatedSize(unsigned long* pSize) noexcept override
+    {
+        if (pSize == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        const HRESULT bufferHr = EnsureFileInfoBuffer();
+        if (FAILED(bufferHr))
+        {
+            return bufferHr;
+        }
+
+        if (_buffer.size() > static_cast<size_t>((std::numeric_limits<unsigned long>::max)()))
+        {
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+        }
+
+        *pSize = static_cast<unsigned long>(_buffer.size());
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetCount(unsigned long* pCount) noexcept override
+    {
+        if (pCount == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        *pCount = _count;
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE Get(unsigned long index, FileInfo** ppEntry) noexcept override
+    {
+        if (ppEntry == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        const HRESULT bufferHr = EnsureFileInfoBuffer();
+        if (FAILED(bufferHr))
+        {
+            return bufferHr;
+        }
+
+        *ppEntry = nullptr;
+
+        if (index >= _count)
+        {
+            return HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES);
+        }
+
+        return LocateEntry(index, ppEntry);
+    }
+
+    // IFilesInformationCompact
+    HRESULT STDMETHODCALLTYPE GetCompactView(FilesInformationCompactView* view) noexcept override
+    {
+        if (view == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        if (! _compactMode)
+        {
+            return E_NOINTERFACE;
+        }
+
+        std::lock_guard lock(_bufferMutex);
+        _compact.GetView(*view);
+        view->allocatedBytes += static_cast<uint64_t>(_buffer.capacity() + _widenedNames.capacity() * sizeof(wchar_t));
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetWideNamePool(const wchar_t** namePool) noexcept override
+    {
+        if (namePool == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        *namePool = nullptr;
+        if (! _compactMode)
+        {
+            return E_NOINTERFACE;
+        }
+
+        std::lock_guard lock(_bufferMutex);
+        return _compact.GetWideNames(_widenedNames, namePool);
+    }
+
+protected:
+    // Replaces the listing with `entries`, in order. Timestamps an Entry does not carry report its last write time.
+    template <typename Entry> HRESULT Assign(const std::vector<Entry>& entries) noexcept
+    {
+        _buffer.clear();
+        _compact.Clear();
+        _widenedNames.clear();
+        _count       = 0;
+        _usedBytes   = 0;
+        _compactMode = false;
+        _bufferReady = true;
+
+        if (entries.empty())
+        {
+            return S_OK;
+        }
+
+        if (CompactFilesListing::CanRepresent(entries))
+        {
+            const HRESULT hr = _compact.Build(entries);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            _compactMode = true;
+            _bufferReady = false;
+            _count       = _compact.Count();
+            return S_OK;
+        }
+
+        size_t totalBytes = 0;
+        for (const Entry& entry : entries)
+        {
+            totalBytes += CompactFilesListing::FileInfoSizeBytes(entry.name.size());
+            if (totalBytes > static_cast<size_t>((std::numeric_limits<unsigned long>::max)()))
+            {
+                return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+            }
+        }
+
+        try
+        {
+            _buffer.resize(totalBytes, std::byte{0});
+        }
+        catch (const std::bad_alloc&)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        std::byte* base     = _buffer.data();
+        size_t offset       = 0;
+        FileInfo* previous  = nullptr;
+        size_t previousSize = 0;
+
+        for (const Entry& source : entries)
+        {
+            const size_t entrySize = CompactFilesListing::FileInfoSizeBytes(source.name.size());
+            auto* entry            = reinterpret_cast<FileInfo*>(base + offset);
+
+            const size_t nameBytes  = source.name.size() * sizeof(wchar_t);
+            const __int64 lastWrite = static_cast<__int64>(source.lastWriteTime);
+
+            entry->FileAttributes = static_cast<unsigned long>(source.attributes);
+            entry->EndOfFile      = static_cast<__int64>(source.sizeBytes);
+            entry->AllocationSize = static_cast<__int64>(source.sizeBytes);
+            entry->CreationTime   = lastWrite;
+            entry->LastAccessTime = lastWrite;
+            entry->LastWriteTime  = lastWrite;
+            entry->ChangeTime     = lastWrite;
+            if constexpr (requires { source.fileIndex; })
+            {
+                entry->FileIndex = static_cast<unsigned long>(source.fileIndex);
+            }
+            if constexpr (requires { source.creationTime; })
+            {
+                entry->CreationTime = static_cast<__int64>(source.creationTime);
+            }
+            if constexpr (requires { source.lastAccessTime; })
+            {
+                entry->LastAccessTime = static_cast<__int64>(source.lastAccessTime);
+            }
+            if constexpr (requires { source.changeTime; })
+            {
+                entry->ChangeTime = static_cast<__int64>(source.changeTime);
+            }
+
+            entry->FileNameSize = static_cast<unsigned long>(nameBytes);
+            if (nameBytes > 0)
+            {
+                std::memcpy(entry->FileName, source.name.data(), nameBytes);
+            }
+            entry->FileName[source.name.size()] = L'\0';
+
+            if (previous)
+            {
+                previous->NextEntryOffset = static_cast<unsigned long>(previousSize);
+            }
+
+            previous     = entry;
+            previousSize = entrySize;
+
+            offset += entrySize;
+            ++_count;
+        }
+
+        _usedBytes = static_cast<unsigned long>(_buffer.size());
+        return S_OK;
+    }
+
+private:
+    HRESULT LocateEntry(unsigned long index, FileInfo** ppEntry) const noexcept
+    {
+        const std::byte* base      = _buffer.data();
+        size_t offset              = 0;
+        unsigned long currentIndex = 0;
+
+        while (offset < _usedBytes && offset + sizeof(FileInfo) <= _buffer.size())
+        {
+            auto* entry = reinterpret_cast<const FileInfo*>(base + offset);
+            if (currentIndex == index)
+            {
+                *ppEntry = const_cast<FileInfo*>(entry);
+                return S_OK;
+            }
+
+            const size_t advance = (entry->NextEntryOffset != 0)
+                                       ? static_cast<size_t>(entry->NextEntryOffset)
+                                       : CompactFilesListing::FileInfoSizeBytes(static_cast<size_t>(entry->FileNameSize) / sizeof(wchar_t));
+            if (advance == 0)
+            {
+                break;
+            }
+
+            offset += advance;
+            ++currentIndex;
+        }
+
+        return HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES);
+    }
+
+    HRESULT EnsureFileInfoBuffer() noexcept
+    {
+        if (! _compactMode)
+        {
+            return S_OK;
+        }
+
+        std::lock_guard lock(_bufferMutex);
+        if (_bufferReady)
+        {
+            return S_OK;
+        }
+
+        const HRESULT hr = _compact.MaterializeFileInfo(_buffer);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        _usedBytes   = static_cast<unsigned long>(_buffer.size());
+        _bufferReady = true;
+        return S_OK;
+    }
+
+    std::atomic_ulong _refCount{1};
+    std::vector<std::byte> _buffer;
+    unsigned long _count     = 0;
+    unsigned long _usedBytes = 0;
+
+    CompactFilesListing _compact;
+    std::vector<wchar_t> _widenedNames; // Built by GetWideNamePool for narrow pools (guarded by _bufferMutex)
+    bool _compactMode = false;
+    bool _bufferReady = true;
+    std::mutex _bufferMutex; // Guards the on-demand FileInfo buffer and _widenedNames
+};
@@ -125,6 +125,9 @@ inline bool LessNoCase(std::wstring_view a, std::wstring_view b) noexcept
 }
 } // namespace OrdinalString
 
+// Listings at or above this many items are sorted with std::execution::par; below it the pool hand-off costs more than it saves.
+inline constexpr size_t kParallelSortThreshold = 1000;
+
 // LoadString from resource ID
 template <typename string_type, size_t stackBufferLength = 256>
 int LoadStringResource(_In_opt_ HINSTANCE hInstance, _In_ UINT uID, string_type& result) WI_NOEXCEPT
@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+// Pixel loops behind the ViewerImgRaw decode, thumbnail and tile paths. Header-only so the host's --benchmarks suite checks
+// and times the same code (viewer.imgraw.kernels.*). Outputs are 32bpp BGRA with opaque alpha.
+//
+// x86/x64 builds pick a path at run time: AVX2 for the 2x2 downsample, SSSE3 for the RGB conversions, SSE2 otherwise. Other
+// targets run the scalar reference loops, which also define the exact results every vector path must reproduce.
+//
+// Deliberately not provided:
+// - premultiply: frames are drawn with D2D1_ALPHA_MODE_IGNORE and every output pixel is opaque, so it would be a no-op;
+// - gamma in the 16 -> 8-bit step: LibRaw output is already gamma-encoded by dcraw_process, so the high byte is kept;
+// - Lanczos: display scaling is a chain of 2x box-filtered mip levels, with D2D's linear filter covering the last fraction;
+// - AVX2 conversions: _mm256_shuffle_epi8 does not cross 128-bit lanes, so the 3-byte RGB layout would need extra permutes
+//   for a loop that is bound by its 4-byte-per-pixel stores anyway.
+namespace PixelKernels
+{
+// Interleaved 8-bit samples (R, G, B, extra channels ignored) -> BGRA. One or two channels replicate R into the missing ones.
+inline void ConvertRgb8ToBgraScalar(const uint8_t* src, uint32_t colors, uint8_t* dst, size_t pixelCount) noexcept
+{
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        const size_t si = i * colors;
+        const uint8_t r = src[si + 0];
+        const uint8_t g = colors >= 2 ? src[si + 1] : r;
+        const uint8_t b = colors >= 3 ? src[si + 2] : r;
+
+        const size_t di = i * 4u;
+        dst[di + 0]     = b;
+        dst[di + 1]     = g;
+        dst[di + 2]     = r;
+        dst[di + 3]     = uint8_t{255};
+    }
+}
+
+// Same for 16-bit samples, keeping the high byte.
+inline void ConvertRgb16ToBgraScalar(const uint16_t* src, uint32_t colors, uint8_t* dst, size_t pixelCount) noexcept
+{
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        const size_t si    = i * colors;
+        const uint16_t r16 = src[si + 0];
+        const uint16_t g16 = colors >= 2 ? src[si + 1] : r16;
+        const uint16_t b16 = colors >= 3 ? src[si + 2] : r16;
+
+        const size_t di = i * 4u;
+        dst[di + 0]     = static_cast<uint8_t>(b16 >> 8);
+        dst[di + 1]     = static_cast<uint8_t>(g16 >> 8);
+        dst[di + 2]     = static_cast<uint8_t>(r16 >> 8);
+        dst[di + 3]     = uint8_t{255};
+    }
+}
+
+namespace detail
+{
+inline void DownsampleBgraBox2x2Pixel(const uint8_t* row0, const uint8_t* row1, uint32_t x, uint32_t srcW, uint8_t* out) noexcept
+{
+    const size_t sx0 = static_cast<size_t>(x) * 8u;
+    const size_t sx1 = static_cast<size_t>(std::min(x * 2u + 1u, srcW - 1u)) * 4u;
+    for (size_t c = 0; c < 4u; ++c)
+    {
+        const uint32_t sum = static_cast<uint32_t>(row0[sx0 + c]) + row0[sx1 + c] + row1[sx0 + c] + row1[sx1 + c];
+        out[c]             = static_cast<uint8_t>((sum + 2u) / 4u);
+    }
+}
+
+#if defined(_M_X64) || defined(_M_IX86)
+inline bool HasSsse3() noexcept
+{
+    static const bool hasSsse3 = []() noexcept
+    {
+        int info[4]{};
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0;
+    }();
+    return hasSsse3;
+}
+
+// AVX2 needs the CPU bit (leaf 7, EBX bit 5) and an OS that saves the YMM state (OSXSAVE + XCR0 bits 1 and 2).
+inline bool HasAvx2() noexcept
+{
+    static const bool hasAvx2 = []() noexcept
+    {
+        int info[4]{};
+        __cpuid(info, 0);
+        if (info[0] < 7)
+        {
+            return false;
+        }
+
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx     = (info[2] & (1 << 28)) != 0;
+        if (! osxsave || ! avx || (_xgetbv(0) & 0x6u) != 0x6u)
+        {
+            return false;
+        }
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+    return hasAvx2;
+}
+
+// 48 bytes of packed RGB (16 pixels) -> 64 bytes of BGRA.
+inline void StoreRgb48AsBgra(__m128i a, __m128i b, __m128i c, uint8_t* dst) noexcept
+{
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i alpha   = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    const __m128i p0 = _mm_shuffle_epi8(a, shuffle);
+    const __m128i p1 = _mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle);
+    const __m128i p2 = _mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle);
+    const __m128i p3 = _mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 0), _mm_or_si128(p0, alpha));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_or_si128(p1, alpha));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_or_si128(p2, alpha));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_or_si128(p3, alpha));
+}
+
+// 16 gray bytes -> 64 bytes of BGRA (SSE2 only).
+inline void StoreGray16AsBgra(__m128i gray, uint8_t* dst) noexcept
+{
+    const __m128i opaque  = _mm_set1_epi8(static_cast<char>(0xFF));
+    const __m128i grayLo  = _mm_unpacklo_epi8(gray, gray);
+    const __m128i grayHi  = _mm_unpackhi_epi8(gray, gray);
+    const __m128i alphaLo = _mm_unpacklo_epi8(gray, opaque);
+    const __m128i alphaHi = _mm_unpackhi_epi8(gray, opaque);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 0), _mm_unpacklo_epi16(grayLo, alphaLo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(grayLo, alphaLo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_unpacklo_epi16(grayHi, alphaHi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_unpackhi_epi16(grayHi, alphaHi));
+}
+
+// Two loads of 8 samples -> 16 high bytes.
+inline __m128i PackHighBytes16(const uint16_t* src) noexcept
+{
+    const __m128i lo = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), 8);
+    const __m128i hi = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8)), 8);
+    return _mm_packus_epi16(lo, hi);
+}
+
+// 8 output pixels per step from 16 source pixels of each row; returns the first output column left to the narrower paths.
+inline uint32_t DownsampleRowAvx2(const uint8_t* row0, const uint8_t* row1, uint32_t srcW, uint8_t* out) noexcept
+{
+    const __m256i zero  = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16(2);
+
+    uint32_t x = 0;
+    for (; x * 2u + 16u <= srcW; x += 8u)
+    {
+        const size_t si  = static_cast<size_t>(x) * 8u;
+        const __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + si));
+        const __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + si + 32u));
+        const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + si));
+        const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + si + 32u));
+
+        // Unpacks stay inside 128-bit lanes: v01 holds source pixels 0,1 | 4,5, v23 holds 2,3 | 6,7, and so on.
+        const __m256i v01 = _mm256_add_epi16(_mm256_unpacklo_epi8(a0, zero), _mm256_unpacklo_epi8(b0, zero));
+        const __m256i v23 = _mm256_add_epi16(_mm256_unpackhi_epi8(a0, zero), _mm256_unpackhi_epi8(b0, zero));
+        const __m256i v45 = _mm256_add_epi16(_mm256_unpacklo_epi8(a1, zero), _mm256_unpacklo_epi8(b1, zero));
+        const __m256i v67 = _mm256_add_epi16(_mm256_unpackhi_epi8(a1, zero), _mm256_unpackhi_epi8(b1, zero));
+
+        // Output pixels 0|2, 1|3, 4|6 and 5|7 in the low four words of each lane.
+        const __m256i s0 = _mm256_add_epi16(v01, _mm256_srli_si256(v01, 8));
+        const __m256i s1 = _mm256_add_epi16(v23, _mm256_srli_si256(v23, 8));
+        const __m256i s2 = _mm256_add_epi16(v45, _mm256_srli_si256(v45, 8));
+        const __m256i s3 = _mm256_add_epi16(v67, _mm256_srli_si256(v67, 8));
+
+        const __m256i out0123 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(s0, s1), round), 2);
+        const __m256i out4567 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(s2, s3), round), 2);
+
+        // The pack interleaves lanes as pixels 0,1,4,5 | 2,3,6,7; restore the order per 64-bit pair.
+        const __m256i packed = _mm256_packus_epi16(out0123, out4567);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + static_cast<size_t>(x) * 4u), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+
+    _mm256_zeroupper();
+    return x;
+}
+
+// 4 output pixels per step from 8 source pixels of each row, starting at output column x.
+inline uint32_t DownsampleRowSse2(const uint8_t* row0, const uint8_t* row1, uint32_t srcW, uint32_t x, uint8_t* out) noexcept
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(2);
+    for (; x * 2u + 8u <= srcW; x += 4u)
+    {
+        const size_t si  = static_cast<size_t>(x) * 8u;
+        const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + si));
+        const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + si + 16u));
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + si));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + si + 16u));
+
+        // Vertical sums per source pixel pair, widened to 16 bits.
+        const __m128i v01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        const __m128i v23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        const __m128i v45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        const __m128i v67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+        // Horizontal sums: the low four lanes of v + (v >> 64 bits) hold one output pixel.
+        const __m128i s0 = _mm_add_epi16(v01, _mm_srli_si128(v01, 8));
+        const __m128i s1 = _mm_add_epi16(v23, _mm_srli_si128(v23, 8));
+        const __m128i s2 = _mm_add_epi16(v45, _mm_srli_si128(v45, 8));
+        const __m128i s3 = _mm_add_epi16(v67, _mm_srli_si128(v67, 8));
+
+        const __m128i out01 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(s0, s1), round), 2);
+        const __m128i out23 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(s2, s3), round), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + static_cast<size_t>(x) * 4u), _mm_packus_epi16(out01, out23));
+    }
+    return x;
+}
+#endif
+} // namespace detail
+
+// Writes rows [rowBegin, rowEnd) of the (srcW + 1) / 2 x (srcH + 1) / 2 box-filtered half of src; odd edges repeat the last column/row.
+inline void DownsampleBgraBox2x2RowsScalar(const uint8_t* src, uint32_t srcW, uint32_t srcH, uint8_t* dst, uint32_t rowBegin, uint32_t rowEnd) noexcept
+{
+    const uint32_t dstW    = (srcW + 1u) / 2u;
+    const size_t srcStride = static_cast<size_t>(srcW) * 4u;
+    const size_t dstStride = static_cast<size_t>(dstW) * 4u;
+
+    for (uint32_t y = rowBegin; y < rowEnd; ++y)
+    {
+        const uint32_t sy0  = y * 2u;
+        const uint32_t sy1  = std::min(sy0 + 1u, srcH - 1u);
+        const uint8_t* row0 = src + static_cast<size_t>(sy0) * srcStride;
+        const uint8_t* row1 = src + static_cast<size_t>(sy1) * srcStride;
+        uint8_t* out        = dst + static_cast<size_t>(y) * dstStride;
+        for (uint32_t x = 0; x < dstW; ++x)
+        {
+            detail::DownsampleBgraBox2x2Pixel(row0, row1, x, srcW, out + static_cast<size_t>(x) * 4u);
+        }
+    }
+}
+
+inline void ConvertRgb8ToBgra(const uint8_t* src, uint32_t colors, uint8_t* dst, size_t pixelCount) noexcept
+{
+    if (! src || ! dst || colors == 0)
+    {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(_M_X64) || defined(_M_IX86)
+    if (colors == 3 && detail::HasSsse3())
+    {
+        for (; i + 16u <= pixelCount; i += 16u)
+        {
+            const uint8_t* in = src + i * 3u;
+            const __m128i a   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 0));
+            const __m128i b   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16));
+            const __m128i c   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 32));
+            detail::StoreRgb48AsBgra(a, b, c, dst + i * 4u);
+        }
+    }
+    else if (colors == 1)
+    {
+        for (; i + 16u <= pixelCount; i += 16u)
+        {
+            detail::StoreGray16AsBgra(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), dst + i * 4u);
+        }
+    }
+#endif
+
+    ConvertRgb8ToBgraScalar(src + i * colors, colors, dst + i * 4u, pixelCount - i);
+}
+
+inline void ConvertRgb16ToBgra(const uint16_t* src, uint32_t colors, uint8_t* dst, size_t pixelCount) noexcept
+{
+    if (! src || ! dst || colors == 0)
+    {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(_M_X64) || defined(_M_IX86)
+    if (colors == 3 && detail::HasSsse3())
+    {
+        for (; i + 16u <= pixelCount; i += 16u)
+        {
+            const uint16_t* in = src + i * 3u;
+            detail::StoreRgb48AsBgra(detail::PackHighBytes16(in + 0), detail::PackHighBytes16(in + 16), detail::PackHighBytes16(in + 32), dst + i * 4u);
+        }
+    }
+    else if (colors == 1)
+    {
+        for (; i + 16u <= pixelCount; i += 16u)
+        {
+            detail::StoreGray16AsBgra(detail::PackHighBytes16(src + i), dst + i * 4u);
+        }
+    }
+#endif
+
+    ConvertRgb16ToBgraScalar(src + i * colors, colors, dst + i * 4u, pixelCount - i);
+}
+
+// Vectorized DownsampleBgraBox2x2RowsScalar.
+inline void DownsampleBgraBox2x2Rows(const uint8_t* src, uint32_t srcW, uint32_t srcH, uint8_t* dst, uint32_t rowBegin, uint32_t rowEnd) noexcept
+{
+    if (! src || ! dst || srcW == 0 || srcH == 0)
+    {
+        return;
+    }
+
+    const uint32_t dstW    = (srcW + 1u) / 2u;
+    const size_t srcStride = static_cast<size_t>(srcW) * 4u;
+    const size_t dstStride = static_cast<size_t>(dstW) * 4u;
+
+#if defined(_M_X64) || defined(_M_IX86)
+    const bool avx2 = detail::HasAvx2();
+#endif
+    for (uint32_t y = rowBegin; y < rowEnd; ++y)
+    {
+        const uint32_t sy0  = y * 2u;
+        const uint32_t sy1  = std::min(sy0 + 1u, srcH - 1u);
+        const uint8_t* row0 = src + static_cast<size_t>(sy0) * srcStride;
+        const uint8_t* row1 = src + static_cast<size_t>(sy1) * srcStride;
+        uint8_t* out        = dst + static_cast<size_t>(y) * dstStride;
+
+        uint32_t x = 0;
+#if defined(_M_X64) || defined(_M_IX86)
+        if (avx2)
+        {
+            x = detail::DownsampleRowAvx2(row0, row1, srcW, out);
+        }
+        // The odd last column stays on the scalar path.
+        x = detail::DownsampleRowSse2(row0, row1, srcW, x, out);
+#endif
+
+        for (; x < dstW; ++x)
+        {
+            detail::DownsampleBgraBox2x2Pixel(row0, row1, x, srcW, out + static_cast<size_t>(x) * 4u);
+        }
+    }
+}
+
+// Runs fn(rowBegin, rowEnd) over bands of `rowsPerBand` rows on the parallel algorithms thread pool.
+// fn must not throw; allocation of the band list may throw std::bad_alloc.
+template <typename Fn> void ForEachRowBand(uint32_t rows, uint32_t rowsPerBand, Fn&& fn)
+{
+    if (rows == 0)
+    {
+        return;
+    }
+
+    rowsPerBand = std::max(rowsPerBand, 1u);
+    if (rows <= rowsPerBand)
+    {
+        fn(0u, rows);
+        return;
+    }
+
+    std::vector<uint32_t> bands((rows + rowsPerBand - 1u) / rowsPerBand);
+    std::iota(bands.begin(), bands.end(), 0u);
+    std::for_each(std::execution::par,
+                  bands.begin(),
+                  bands.end(),
+                  [&](uint32_t band) noexcept
+                  {
+                      const uint32_t rowBegin = band * rowsPerBand;
+                      fn(rowBegin, std::min(rowBegin + rowsPerBand, rows));
+                  });
+}
+} // namespace PixelKernels
@@ -46,6 +46,12 @@ enum FileSystemFlags : uint32_t
     FILESYSTEM_FLAG_CONTINUE_ON_ERROR      = 0x10,
 };
 
+// Informational success codes a plugin MAY pass as the FileSystemItemCompleted status of a successful copy/move item.
+// - FILESYSTEM_S_COPY_SERVER_SIDE: the remote server copied the data itself (no bytes went through the host).
+// - FILESYSTEM_S_COPY_RELAYED: a server-side copy was attempted but the data was relayed through the host.
+#define FILESYSTEM_S_COPY_SERVER_SIDE MAKE_HRESULT(SEVERITY_SUCCESS, FACILITY_ITF, 0x0201)
+#define FILESYSTEM_S_COPY_RELAYED MAKE_HRESULT(SEVERITY_SUCCESS, FACILITY_ITF, 0x0202)
+
 enum class FileSystemIssueAction : uint8_t
 {
     None = 0,
@@ -143,6 +149,47 @@ interface __declspec(uuid("0d9ef549-4e54-4086-8a5c-f9d3e6120211")) __declspec(no
     virtual HRESULT STDMETHODCALLTYPE Get(unsigned long index, FileInfo** ppEntry) noexcept = 0;
 };
 
+enum FilesInformationCompactFlags : uint32_t
+{
+    FILESINFO_COMPACT_NONE = 0,
+    // Names are stored one byte per character; each byte is the UTF-16 code unit U+0000..U+00FF (ISO-8859-1).
+    FILESINFO_COMPACT_NARROW_NAMES = 0x1,
+};
+
+#pragma warning(push)
+#pragma warning(disable : 4820) // padding in data structure
+// Column-oriented view of a listing: one array per field, indexed by entry, plus a shared name pool.
+// All pointers are owned by the IFilesInformationCompact instance and stay valid for its lifetime.
+struct FilesInformationCompactView
+{
+    unsigned long count;
+    FilesInformationCompactFlags flags;
+    // count + 1 offsets into namePool, in characters: name i is [nameOffsets[i], nameOffsets[i + 1]). Names are not NUL-terminated.
+    const unsigned long* nameOffsets;
+    // const wchar_t* by default, const char* when FILESINFO_COMPACT_NARROW_NAMES is set.
+    const void* namePool;
+    const unsigned long* attributes; // FILE_ATTRIBUTE_* flags
+    const uint64_t* sizes;           // End of file in bytes (0 for directories)
+    const __int64* lastWriteTimes;   // FILETIME ticks (0 = unknown)
+    // Bytes held by the listing (used for cache accounting): the columns and the name pool, plus the FileInfo buffer and the
+    // UTF-16 name pool once either has been built on demand. The value can therefore grow after the first view.
+    uint64_t allocatedBytes;
+};
+#pragma warning(pop)
+
+// Optional compact form of a listing, for plugins whose entries only carry name, size, last write time and attributes.
+// - The host obtains this interface via QueryInterface on the IFilesInformation returned by ReadDirectoryInfo.
+// - Entries are in the same order as the IFilesInformation records.
+// - Implementations MAY build their FileInfo buffer lazily on the first IFilesInformation call; hosts that only need the four
+//   columns SHOULD prefer this interface so that buffer is never created.
+interface __declspec(uuid("e184d4a4-197c-483a-9fd2-40842b78f37c")) __declspec(novtable) IFilesInformationCompact : public IUnknown
+{
+    virtual HRESULT STDMETHODCALLTYPE GetCompactView(FilesInformationCompactView * view) noexcept = 0;
+    // The name pool as UTF-16, indexed by the view's nameOffsets. A narrow pool is widened on the first call (thread-safe) and
+    // the copy is kept and shared by every caller until the object is released.
+    virtual HRESULT STDMETHODCALLTYPE GetWideNamePool(const wchar_t** namePool) noexcept = 0;
+};
+
 // Host callback for file operation progress.
 // Notes:
 // - This is NOT a COM interface (no IUnknown inheritance); lifetime is managed by the host.
@@ -181,6 +228,8 @@ interface __declspec(novtable) IFileSystemCallback
     // Notes:
     // - itemIndex is the logical index of the completed item within the original request array (0..count-1).
     // - Plugins MAY complete items out-of-order when executing in parallel; hosts MUST NOT assume ascending completion order.
+    // - status MAY be an informational success code (FILESYSTEM_S_*) describing how a successful item was carried out;
+    //   hosts MUST treat any SUCCEEDED(status) as success.
     virtual HRESULT STDMETHODCALLTYPE FileSystemItemCompleted(FileSystemOperation operationType,
                                                               unsigned long itemIndex,
                                                               const wchar_t* sourcePath,
@@ -278,10 +327,12 @@ interface __declspec(uuid("12519afa-30e7-4e3a-9db2-7990c4be9a21")) __declspec(no
     //     "concurrency": {
     //       "copyMoveMax": 4,
     //       "deleteMax": 8,
-    //       "deleteRecycleBinMax": 2
+    //       "deleteRecycleBinMax": 2,
+    //       "readDirectoryMax": 4
     //     }
     //   }
     //   If "concurrency" is absent, host per-item concurrency falls back to 1.
+    //   "readDirectoryMax" caps concurrent ReadDirectoryInfo calls per compare pane while scanning (default 4, max 16).
     // - Implementations SHOULD return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED) when unsupported.
     virtual HRESULT STDMETHODCALLTYPE GetCapabilities(const char** jsonUtf8) noexcept = 0;
 };
@@ -110,3 +110,30 @@ interface __declspec(uuid("d1da10b7-0d0d-4d5c-9b3c-30c386c9d3c7")) __declspec(no
 
     virtual HRESULT STDMETHODCALLTYPE SetCallback(IViewerCallback * callback, void* cookie) noexcept = 0;
 };
+
+// Decoded thumbnail returned by IViewerThumbnail::GetThumbnail.
+// Pixels are 32bpp BGRA, premultiplied alpha, top-down, tightly packed (stride = width * 4).
+struct ViewerThumbnailImage
+{
+    uint32_t width;
+    uint32_t height;
+    // Caller-owned buffer of `capacityBytes` bytes; plugins write at most maxDimension x maxDimension pixels.
+    uint8_t* pixels;
+    uint64_t capacityBytes;
+};
+
+// Optional thumbnail interface for viewer plugins.
+// Notes:
+// - The host obtains this interface via QueryInterface on an IViewer instance; no window is created.
+// - GetThumbnail MAY be called concurrently from background threads and MUST NOT touch viewer window state.
+// - `fileSystem` remains valid for the duration of the call; read through IFileSystemIO and only the bytes needed
+//   (e.g. the embedded preview of a RAW file) so remote file systems stay responsive.
+// - The result fits in maxDimension x maxDimension (aspect ratio preserved).
+// - Implementations SHOULD return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED) for files they cannot preview.
+interface __declspec(uuid("5b8a1f0e-3d6c-4e59-a2b7-9c41e07d8f36")) __declspec(novtable) IViewerThumbnail : public IUnknown
+{
+    virtual HRESULT STDMETHODCALLTYPE GetThumbnail(IFileSystem * fileSystem,
+                                                   const wchar_t* path,
+                                                   uint32_t maxDimension,
+                                                   ViewerThumbnailImage* image) noexcept = 0;
+};
@@ -265,6 +265,8 @@ struct FileOperationsSettings
     std::optional<uint32_t> maxDiagnosticsPerFlush;
     std::optional<uint32_t> diagnosticsFlushIntervalMs;
     std::optional<uint32_t> diagnosticsCleanupIntervalMs;
+    // Cross-filesystem bridge: files copied concurrently inside one bridged directory (split across parallel top-level items).
+    std::optional<uint32_t> bridgeMaxConcurrentFiles;
 };
 
 struct CompareDirectoriesSettings
@@ -357,6 +359,8 @@ struct ExtensionsSettings
         {L".md", L"builtin/viewer-markdown"},
         {L".json", L"builtin/viewer-json"},
         {L".json5", L"builtin/viewer-json"},
+        {L".ndjson", L"builtin/viewer-json"},
+        {L".jsonl", L"builtin/viewer-json"},
         {L".html", L"builtin/viewer-web"},
         {L".htm", L"builtin/viewer-web"},
         {L".pdf", L"builtin/viewer-web"},
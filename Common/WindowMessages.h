@@ -21,6 +21,7 @@ inline constexpr UINT kFolderViewDirectoryCacheDirty = WM_APP + 0x304;
 inline constexpr UINT kFolderViewBatchIconUpdate     = WM_APP + 0x306;
 inline constexpr UINT kNetworkConnectivityChanged    = WM_APP + 0x305;
 inline constexpr UINT kFolderViewDeferredInit        = WM_APP + 0x307;
+inline constexpr UINT kFolderViewThumbnailReady      = WM_APP + 0x308;
 
 inline constexpr UINT kEditSuggestResults = WM_APP + 0x350;
 
@@ -83,11 +84,14 @@ inline constexpr UINT kViewerWebAsyncLoadComplete      = WM_APP + 0x602;
 inline constexpr UINT kViewerImgRawAsyncOpenComplete   = WM_APP + 0x603;
 inline constexpr UINT kViewerImgRawAsyncProgress       = WM_APP + 0x604;
 inline constexpr UINT kViewerImgRawAsyncExportComplete = WM_APP + 0x605;
+inline constexpr UINT kViewerWebJsonPageReady          = WM_APP + 0x606;
+inline constexpr UINT kViewerImgRawAsyncTilesDecoded   = WM_APP + 0x607;
 
 // RedSalamanderMonitor / ColorTextView
-inline constexpr UINT kColorTextViewLayoutReady = WM_APP + 0x620;
-inline constexpr UINT kColorTextViewWidthReady  = WM_APP + 0x621;
-inline constexpr UINT kColorTextViewEtwBatch    = WM_APP + 0x622;
+inline constexpr UINT kColorTextViewLayoutReady   = WM_APP + 0x620;
+inline constexpr UINT kColorTextViewWidthReady    = WM_APP + 0x621;
+inline constexpr UINT kColorTextViewEtwBatch      = WM_APP + 0x622;
+inline constexpr UINT kColorTextViewSearchResults = WM_APP + 0x623;
 
 // PoC / samples
 inline constexpr UINT kWin32HelloCredHelloResult = WM_APP + 0x680;
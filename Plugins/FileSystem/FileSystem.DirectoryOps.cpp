@@ -538,265 +538,6 @@ HRESULT STDMETHODCALLTYPE FileSystem::CreateDirectory(const wchar_t* path) noexc
     return S_OK;
 }
 
-HRESULT STDMETHODCALLTYPE FileSystem::GetDirectorySize(
-    const wchar_t* path, FileSystemFlags flags, IFileSystemDirectorySizeCallback* callback, void* cookie, FileSystemDirectorySizeResult* result) noexcept
-{
-    if (path == nullptr || result == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    if (path[0] == L'\0')
-    {
-        return E_INVALIDARG;
-    }
-
-    result->totalBytes     = 0;
-    result->fileCount      = 0;
-    result->directoryCount = 0;
-    result->status         = S_OK;
-
-    // Verify path is a directory.
-    const DWORD attrs = ::GetFileAttributesW(path);
-    if (attrs == INVALID_FILE_ATTRIBUTES)
-    {
-        const DWORD lastError = ::GetLastError();
-        result->status        = HRESULT_FROM_WIN32(lastError);
-        return result->status;
-    }
-
-    if ((attrs & FILE_ATTRIBUTE_DIRECTORY) == 0)
-    {
-        WIN32_FILE_ATTRIBUTE_DATA fileData{};
-        if (::GetFileAttributesExW(path, GetFileExInfoStandard, &fileData) == 0)
-        {
-            const DWORD lastError = ::GetLastError();
-            result->status        = HRESULT_FROM_WIN32(lastError != 0 ? lastError : ERROR_GEN_FAILURE);
-            return result->status;
-        }
-
-        result->totalBytes = (static_cast<uint64_t>(fileData.nFileSizeHigh) << 32) | static_cast<uint64_t>(fileData.nFileSizeLow);
-        result->fileCount  = 1;
-
-        if (callback != nullptr)
-        {
-            callback->DirectorySizeProgress(1, result->totalBytes, result->fileCount, result->directoryCount, path, cookie);
-            BOOL cancel = FALSE;
-            callback->DirectorySizeShouldCancel(&cancel, cookie);
-            if (cancel)
-            {
-                result->status = HRESULT_FROM_WIN32(ERROR_CANCELLED);
-                return result->status;
-            }
-
-            callback->DirectorySizeProgress(1, result->totalBytes, result->fileCount, result->directoryCount, nullptr, cookie);
-        }
-
-        result->status = S_OK;
-        return S_OK;
-    }
-
-    if ((attrs & FILE_ATTRIBUTE_REPARSE_POINT) != 0)
-    {
-        // Root reparse points are treated as leaf links for sizing to match safe copy/delete policy.
-        result->status = S_OK;
-        return S_OK;
-    }
-
-    const bool recursive                             = (flags & FILESYSTEM_FLAG_RECURSIVE) != 0;
-    constexpr unsigned long kProgressIntervalEntries = 100;
-    constexpr ULONGLONG kProgressIntervalMs          = 200;
-
-    uint64_t scannedEntries    = 0;
-    ULONGLONG lastProgressTime = ::GetTickCount64();
-
-#ifdef _DEBUG
-    const unsigned int delayMs = _directorySizeDelayMs;
-#else
-    const unsigned int delayMs = 0u;
-#endif
-
-    auto maybeReportProgress = [&](const wchar_t* currentPath) -> bool
-    {
-        if (callback == nullptr)
-        {
-            return true;
-        }
-
-        const bool entryThreshold = (scannedEntries % kProgressIntervalEntries) == 0;
-        const ULONGLONG now       = ::GetTickCount64();
-        const bool timeThreshold  = (now - lastProgressTime) >= kProgressIntervalMs;
-
-        if (entryThreshold || timeThreshold)
-        {
-            lastProgressTime = now;
-            callback->DirectorySizeProgress(scannedEntries, result->totalBytes, result->fileCount, result->directoryCount, currentPath, cookie);
-
-            BOOL cancel = FALSE;
-            callback->DirectorySizeShouldCancel(&cancel, cookie);
-            if (cancel)
-            {
-                result->status = HRESULT_FROM_WIN32(ERROR_CANCELLED);
-                return false;
-            }
-        }
-        return true;
-    };
-
-    struct DirectoryFrame final
-    {
-        DirectoryFrame()                                 = default;
-        DirectoryFrame(const DirectoryFrame&)            = delete;
-        DirectoryFrame(DirectoryFrame&&)                 = default;
-        DirectoryFrame& operator=(const DirectoryFrame&) = delete;
-        DirectoryFrame& operator=(DirectoryFrame&&)      = default;
-
-        std::wstring directoryPath;
-        wil::unique_hfind findHandle;
-        WIN32_FIND_DATAW data{};
-        bool hasData = false;
-    };
-
-    std::vector<DirectoryFrame> stack;
-
-    auto pushDirectory = [&](std::wstring directoryPath) noexcept -> void
-    {
-        std::wstring searchPath = directoryPath;
-        if (! searchPath.empty() && searchPath.back() != L'\\' && searchPath.back() != L'/')
-        {
-            searchPath += L'\\';
-        }
-        searchPath += L'*';
-
-        WIN32_FIND_DATAW findData{};
-        wil::unique_hfind findHandle(
-            ::FindFirstFileExW(searchPath.c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH));
-        if (! findHandle)
-        {
-            const DWORD lastError = ::GetLastError();
-            if (lastError != ERROR_FILE_NOT_FOUND && lastError != ERROR_ACCESS_DENIED)
-            {
-                if (SUCCEEDED(result->status))
-                {
-                    result->status = HRESULT_FROM_WIN32(lastError);
-                }
-            }
-            return;
-        }
-
-        DirectoryFrame frame{};
-        frame.directoryPath = std::move(directoryPath);
-        frame.findHandle    = std::move(findHandle);
-        frame.data          = findData;
-        frame.hasData       = true;
-
-        stack.emplace_back(std::move(frame));
-    };
-
-    const auto advanceFrame = [&](DirectoryFrame& frame) noexcept
-    {
-        WIN32_FIND_DATAW next{};
-        if (::FindNextFileW(frame.findHandle.get(), &next) != 0)
-        {
-            frame.data    = next;
-            frame.hasData = true;
-            return;
-        }
-
-        const DWORD lastError = ::GetLastError();
-        if (lastError != ERROR_NO_MORE_FILES)
-        {
-            if (SUCCEEDED(result->status))
-            {
-                result->status = HRESULT_FROM_WIN32(lastError);
-            }
-        }
-
-        frame.hasData = false;
-    };
-
-    pushDirectory(std::wstring(path));
-
-    while (! stack.empty())
-    {
-        DirectoryFrame& frame = stack.back();
-        if (! frame.hasData)
-        {
-            stack.pop_back();
-            continue;
-        }
-
-        // Copy the current entry so we can safely mutate the frame (advance/push) without accidentally reusing stale data.
-        const WIN32_FIND_DATAW currentData = frame.data;
-
-        // Skip . and ..
-        if (currentData.cFileName[0] == L'.')
-        {
-            if (currentData.cFileName[1] == L'\0')
-            {
-                advanceFrame(frame);
-                continue;
-            }
-            if (currentData.cFileName[1] == L'.' && currentData.cFileName[2] == L'\0')
-            {
-                advanceFrame(frame);
-                continue;
-            }
-        }
-
-        ++scannedEntries;
-        if (delayMs > 0u)
-        {
-            ::Sleep(delayMs);
-        }
-
-        const bool isDirectory    = (currentData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-        const bool isReparsePoint = (currentData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
-
-        if (isDirectory)
-        {
-            ++result->directoryCount;
-        }
-        else
-        {
-            ++result->fileCount;
-            const uint64_t fileSize = (static_cast<uint64_t>(currentData.nFileSizeHigh) << 32) | static_cast<uint64_t>(currentData.nFileSizeLow);
-            result->totalBytes += fileSize;
-        }
-
-        if (! maybeReportProgress(frame.directoryPath.c_str()))
-        {
-            return result->status;
-        }
-
-        if (recursive && isDirectory && ! isReparsePoint)
-        {
-            std::wstring childPath = frame.directoryPath;
-            if (! childPath.empty() && childPath.back() != L'\\' && childPath.back() != L'/')
-            {
-                childPath += L'\\';
-            }
-            childPath += currentData.cFileName;
-
-            // Advance the parent directory BEFORE descending; this keeps the parent frame consistent if the stack reallocates.
-            advanceFrame(frame);
-
-            pushDirectory(std::move(childPath));
-            continue;
-        }
-
-        advanceFrame(frame);
-    }
-
-    // Final progress report.
-    if (callback != nullptr)
-    {
-        callback->DirectorySizeProgress(scannedEntries, result->totalBytes, result->fileCount, result->directoryCount, nullptr, cookie);
-    }
-
-    return result->status;
-}
-
 void FileSystem::EnsureRequestedPath(FilesInformation& info, const std::wstring& path) noexcept
 {
     if (! info.PathEquals(path))
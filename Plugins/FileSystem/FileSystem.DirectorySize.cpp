@@ -0,0 +1,1036 @@
+#include "FileSystem.Internal.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <system_error>
+#include <thread>
+
+using namespace FileSystemInternal;
+
+namespace
+{
+constexpr unsigned int kMaxDirectorySizeWorkers  = 8u;
+constexpr unsigned long kProgressIntervalEntries = 100;
+constexpr ULONGLONG kProgressIntervalMs          = 200;
+constexpr auto kIdleWait                         = std::chrono::milliseconds(2);
+
+// Per-directory counts are published to the shared progress counters in batches to keep workers off one cache line.
+constexpr uint64_t kProgressFlushEntries = 1024;
+
+// Subtrees smaller than this are cheaper to rescan than to keep; the queried root is always stored.
+constexpr uint64_t kMinCachedSubtreeEntries  = 1024;
+constexpr size_t kMaxCachedSubtreesPerRoot   = 65536;
+constexpr size_t kMaxRecentChangesPerRoot    = 4096;
+constexpr size_t kMaxDirectorySizeRoots      = 16;
+constexpr ULONGLONG kDirectorySizeRootIdleMs = 2ull * 60ull * 1000ull; // an unqueried root releases its watch after this
+
+[[nodiscard]] std::wstring FoldPathCase(std::wstring_view text)
+{
+    if (text.empty())
+    {
+        return {};
+    }
+
+    std::wstring folded(text);
+    const int length = static_cast<int>(folded.size());
+    if (LCMapStringEx(LOCALE_NAME_INVARIANT, LCMAP_LOWERCASE, text.data(), length, folded.data(), length, nullptr, nullptr, 0) == 0)
+    {
+        return std::wstring(text);
+    }
+    return folded;
+}
+
+// Case-folded path without "\\?\" prefixes or trailing separators; drive roots keep theirs ("c:\").
+[[nodiscard]] std::wstring MakeDirectorySizeKey(std::wstring_view path)
+{
+    std::wstring normalized;
+    if (path.rfind(L"\\\\?\\UNC\\", 0) == 0)
+    {
+        normalized = L"\\\\";
+        normalized.append(path.substr(8));
+    }
+    else if (path.rfind(L"\\\\?\\", 0) == 0)
+    {
+        normalized.assign(path.substr(4));
+    }
+    else
+    {
+        normalized.assign(path);
+    }
+
+    std::replace(normalized.begin(), normalized.end(), L'/', L'\\');
+    normalized.resize(TrimTrailingSeparators(normalized).size());
+    if (! normalized.empty() && normalized.back() == L':')
+    {
+        normalized.push_back(L'\\');
+    }
+    return FoldPathCase(normalized);
+}
+
+[[nodiscard]] std::wstring AppendKey(const std::wstring& parentKey, std::wstring_view name)
+{
+    std::wstring key = parentKey;
+    if (! key.empty() && key.back() != L'\\')
+    {
+        key.push_back(L'\\');
+    }
+    key.append(FoldPathCase(name));
+    return key;
+}
+
+struct DirectoryIdentity
+{
+    DWORD volumeSerialNumber = 0;
+    uint64_t fileIndex       = 0;
+};
+
+[[nodiscard]] bool IsSameDirectory(const DirectoryIdentity& left, const DirectoryIdentity& right) noexcept
+{
+    return left.volumeSerialNumber == right.volumeSerialNumber && left.fileIndex == right.fileIndex;
+}
+
+// Long-name path of an existing directory without the "\\?\" prefix (UNC paths come back as "\\server\share\..."),
+// plus its file identity so a cache root can tell when its path names a different directory.
+[[nodiscard]] bool TryGetFinalDirectoryPath(const std::wstring& path, std::wstring& out, DirectoryIdentity& identity) noexcept
+{
+    constexpr DWORD kShareAll = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+    wil::unique_hfile directory(::CreateFileW(path.c_str(), FILE_READ_ATTRIBUTES, kShareAll, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr));
+    if (! directory)
+    {
+        return false;
+    }
+
+    BY_HANDLE_FILE_INFORMATION info{};
+    if (! ::GetFileInformationByHandle(directory.get(), &info))
+    {
+        return false;
+    }
+    identity.volumeSerialNumber = info.dwVolumeSerialNumber;
+    identity.fileIndex          = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | static_cast<uint64_t>(info.nFileIndexLow);
+
+    std::wstring buffer(MAX_PATH, L'\0');
+    DWORD length = ::GetFinalPathNameByHandleW(directory.get(), buffer.data(), static_cast<DWORD>(buffer.size()), FILE_NAME_NORMALIZED | VOLUME_NAME_DOS);
+    if (length >= buffer.size())
+    {
+        buffer.resize(static_cast<size_t>(length) + 1u);
+        length = ::GetFinalPathNameByHandleW(directory.get(), buffer.data(), static_cast<DWORD>(buffer.size()), FILE_NAME_NORMALIZED | VOLUME_NAME_DOS);
+    }
+    if (length == 0 || length >= buffer.size())
+    {
+        return false;
+    }
+    buffer.resize(length);
+
+    if (buffer.rfind(L"\\\\?\\UNC\\", 0) == 0)
+    {
+        out = L"\\\\" + buffer.substr(8);
+    }
+    else if (buffer.rfind(L"\\\\?\\", 0) == 0)
+    {
+        out = buffer.substr(4);
+    }
+    else
+    {
+        out = std::move(buffer);
+    }
+    return true;
+}
+
+[[nodiscard]] bool IsSameOrDescendantKey(std::wstring_view key, std::wstring_view ancestor) noexcept
+{
+    if (ancestor.empty() || key.size() < ancestor.size() || key.compare(0, ancestor.size(), ancestor) != 0)
+    {
+        return false;
+    }
+    return key.size() == ancestor.size() || ancestor.back() == L'\\' || key[ancestor.size()] == L'\\';
+}
+
+// Drops `key` and every cached subtree below it. Descendants ("key\...") sort between "key\" and "key]" (']' follows
+// '\'), so this costs a lookup plus the entries removed; a plain file has none.
+template <typename SubtreeMap> void EraseKeyAndDescendants(SubtreeMap& subtrees, const std::wstring& key)
+{
+    subtrees.erase(key);
+
+    std::wstring bound = key;
+    if (bound.empty() || bound.back() != L'\\')
+    {
+        bound.push_back(L'\\');
+    }
+    const auto first = subtrees.lower_bound(bound);
+    bound.back()     = L']';
+    subtrees.erase(first, subtrees.lower_bound(bound));
+}
+} // namespace
+
+// Work-stealing walker behind GetDirectorySize. Each directory is a task; workers pop their own newest task (depth-first,
+// warm directory cache) and steal the oldest task of another worker when they run dry. A directory's totals bubble up to
+// its parent once it and all of its children are done, which is also when the subtree is offered to the size cache.
+// The calling thread is worker 0 and the only one that talks to the progress callback.
+class FileSystem::DirectorySizeWalker final
+{
+public:
+    DirectorySizeWalker(FileSystem& owner, bool recursive, unsigned int delayMs) noexcept : _owner(owner), _recursive(recursive), _delayMs(delayMs)
+    {
+    }
+
+    DirectorySizeWalker(const DirectorySizeWalker&)            = delete;
+    DirectorySizeWalker(DirectorySizeWalker&&)                 = delete;
+    DirectorySizeWalker& operator=(const DirectorySizeWalker&) = delete;
+    DirectorySizeWalker& operator=(DirectorySizeWalker&&)      = delete;
+
+    HRESULT Run(const std::wstring& rootPath, IFileSystemDirectorySizeCallback* callback, void* cookie, FileSystemDirectorySizeResult& result) noexcept
+    {
+        _callback         = callback;
+        _cookie           = cookie;
+        _lastProgressTick = ::GetTickCount64();
+
+        std::wstring rootKey;
+        if (_recursive && _owner.PrepareDirectorySizeCache(rootPath, _cacheRootKey, rootKey, _startSequence))
+        {
+            DirectorySizeTotals cached{};
+            if (_owner.TryGetCachedDirectorySize(_cacheRootKey, rootKey, cached))
+            {
+                result.totalBytes     = cached.totalBytes;
+                result.fileCount      = cached.fileCount;
+                result.directoryCount = cached.directoryCount;
+                result.status         = S_OK;
+                if (_callback != nullptr)
+                {
+                    const uint64_t scanned = cached.fileCount + cached.directoryCount;
+                    _callback->DirectorySizeProgress(scanned, result.totalBytes, result.fileCount, result.directoryCount, nullptr, _cookie);
+                }
+                return S_OK;
+            }
+        }
+
+        unsigned int workerCount = 1u;
+        if (_recursive)
+        {
+            workerCount = std::clamp(std::thread::hardware_concurrency(), 1u, kMaxDirectorySizeWorkers);
+        }
+
+        _workers.reserve(workerCount);
+        for (unsigned int i = 0; i < workerCount; ++i)
+        {
+            _workers.emplace_back(std::make_unique<Worker>());
+        }
+
+        Node& root = _workers[0]->nodes.emplace_back();
+        root.path  = rootPath;
+        root.key   = std::move(rootKey);
+        _outstanding.store(1, std::memory_order_relaxed);
+        ProcessNode(0, root);
+
+        // Helpers are only worth their startup cost once the root has subdirectories to hand out.
+        std::vector<std::jthread> helpers;
+        if (workerCount > 1u && _outstanding.load(std::memory_order_acquire) > 0 && ! _cancelled.load(std::memory_order_acquire))
+        {
+            helpers.reserve(workerCount - 1u);
+            for (unsigned int i = 1; i < workerCount; ++i)
+            {
+                try
+                {
+                    helpers.emplace_back([this, i]() noexcept { WorkerMain(i); });
+                }
+                catch (const std::system_error&)
+                {
+                    break;
+                }
+            }
+        }
+
+        WorkerMain(0);
+
+        _cancelled.store(true, std::memory_order_release);
+        _idleCv.notify_all();
+        helpers.clear();
+
+        result.totalBytes     = _totalBytes.load(std::memory_order_acquire);
+        result.fileCount      = _fileCount.load(std::memory_order_acquire);
+        result.directoryCount = _directoryCount.load(std::memory_order_acquire);
+        if (_userCancelled)
+        {
+            result.status = HRESULT_FROM_WIN32(ERROR_CANCELLED);
+            return result.status;
+        }
+
+        result.status = _status.load(std::memory_order_acquire);
+
+        if (_callback != nullptr)
+        {
+            _callback->DirectorySizeProgress(
+                _scannedEntries.load(std::memory_order_acquire), result.totalBytes, result.fileCount, result.directoryCount, nullptr, _cookie);
+        }
+
+        return result.status;
+    }
+
+private:
+    struct Node
+    {
+        Node* parent = nullptr;
+        std::wstring path;
+        std::wstring key; // empty when the subtree is not offered to the cache
+        std::atomic<uint64_t> totalBytes{0};
+        std::atomic<uint64_t> fileCount{0};
+        std::atomic<uint64_t> directoryCount{0};
+        std::atomic<uint32_t> pending{1}; // own scan + unfinished children
+        std::atomic<bool> incomplete{false};
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Node*> tasks;
+        std::deque<Node> nodes; // appended only by the owning worker; addresses stay stable until the walk ends
+    };
+
+    struct Counts
+    {
+        uint64_t scanned     = 0;
+        uint64_t bytes       = 0;
+        uint64_t files       = 0;
+        uint64_t directories = 0;
+    };
+
+    void WorkerMain(unsigned int index) noexcept
+    {
+        for (;;)
+        {
+            if (_cancelled.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            Node* node = PopTask(index);
+            if (node != nullptr)
+            {
+                ProcessNode(index, *node);
+                continue;
+            }
+
+            if (_outstanding.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+
+            if (index == 0)
+            {
+                MaybeReportProgress(nullptr, true);
+            }
+
+            std::unique_lock lock(_idleMutex);
+            _idleCv.wait_for(lock, kIdleWait);
+        }
+    }
+
+    [[nodiscard]] Node* PopTask(unsigned int index) noexcept
+    {
+        {
+            Worker& own = *_workers[index];
+            std::lock_guard lock(own.mutex);
+            if (! own.tasks.empty())
+            {
+                Node* node = own.tasks.back();
+                own.tasks.pop_back();
+                return node;
+            }
+        }
+
+        const size_t count = _workers.size();
+        for (size_t offset = 1; offset < count; ++offset)
+        {
+            Worker& victim = *_workers[(index + offset) % count];
+            std::lock_guard lock(victim.mutex);
+            if (! victim.tasks.empty())
+            {
+                Node* node = victim.tasks.front();
+                victim.tasks.pop_front();
+                return node;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void ProcessNode(unsigned int index, Node& node) noexcept
+    {
+        if (_pathRequested.exchange(false, std::memory_order_acq_rel))
+        {
+            std::lock_guard lock(_pathMutex);
+            _currentPath = node.path;
+        }
+
+        ScanDirectory(index, node);
+        FinishNode(node);
+
+        if (_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            _idleCv.notify_all();
+        }
+    }
+
+    void ScanDirectory(unsigned int index, Node& node) noexcept
+    {
+        std::wstring searchPath = node.path;
+        if (! searchPath.empty() && searchPath.back() != L'\\' && searchPath.back() != L'/')
+        {
+            searchPath += L'\\';
+        }
+        searchPath += L'*';
+
+        WIN32_FIND_DATAW data{};
+        wil::unique_hfind findHandle(::FindFirstFileExW(searchPath.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH));
+        if (! findHandle)
+        {
+            const DWORD lastError = ::GetLastError();
+            if (lastError != ERROR_FILE_NOT_FOUND && lastError != ERROR_ACCESS_DENIED)
+            {
+                RecordError(HRESULT_FROM_WIN32(lastError));
+                node.incomplete.store(true, std::memory_order_relaxed);
+            }
+            return;
+        }
+
+        Counts local{};   // this directory's own entries (plus cached child subtrees for the totals)
+        Counts publish{}; // not yet added to the shared progress counters
+
+        for (;;)
+        {
+            const bool isDot = data.cFileName[0] == L'.' && (data.cFileName[1] == L'\0' || (data.cFileName[1] == L'.' && data.cFileName[2] == L'\0'));
+            if (! isDot)
+            {
+                if (_cancelled.load(std::memory_order_relaxed))
+                {
+                    node.incomplete.store(true, std::memory_order_relaxed);
+                    break;
+                }
+
+                if (_delayMs > 0u)
+                {
+                    ::Sleep(_delayMs);
+                }
+
+                ++local.scanned;
+                ++publish.scanned;
+
+                const bool isDirectory    = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+                const bool isReparsePoint = (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+                if (isDirectory)
+                {
+                    ++local.directories;
+                    ++publish.directories;
+                }
+                else
+                {
+                    const uint64_t fileSize = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | static_cast<uint64_t>(data.nFileSizeLow);
+                    ++local.files;
+                    local.bytes += fileSize;
+                    ++publish.files;
+                    publish.bytes += fileSize;
+                }
+
+                if (_recursive && isDirectory && ! isReparsePoint)
+                {
+                    QueueChild(index, node, data.cFileName, local, publish);
+                }
+
+                if (publish.scanned >= kProgressFlushEntries)
+                {
+                    Publish(publish);
+                }
+
+                if (index == 0 && (local.scanned % kProgressIntervalEntries) == 0)
+                {
+                    MaybeReportProgress(node.path.c_str(), false);
+                }
+            }
+
+            if (::FindNextFileW(findHandle.get(), &data) == 0)
+            {
+                const DWORD lastError = ::GetLastError();
+                if (lastError != ERROR_NO_MORE_FILES)
+                {
+                    RecordError(HRESULT_FROM_WIN32(lastError));
+                    node.incomplete.store(true, std::memory_order_relaxed);
+                }
+                break;
+            }
+        }
+
+        Publish(publish);
+        node.totalBytes.fetch_add(local.bytes, std::memory_order_relaxed);
+        node.fileCount.fetch_add(local.files, std::memory_order_relaxed);
+        node.directoryCount.fetch_add(local.directories, std::memory_order_relaxed);
+    }
+
+    void QueueChild(unsigned int index, Node& parent, const wchar_t* name, Counts& local, Counts& publish) noexcept
+    {
+        std::wstring childKey;
+        if (! parent.key.empty())
+        {
+            childKey = AppendKey(parent.key, name);
+
+            DirectorySizeTotals cached{};
+            if (_owner.TryGetCachedDirectorySize(_cacheRootKey, childKey, cached))
+            {
+                local.bytes += cached.totalBytes;
+                local.files += cached.fileCount;
+                local.directories += cached.directoryCount;
+                publish.scanned += cached.fileCount + cached.directoryCount;
+                publish.bytes += cached.totalBytes;
+                publish.files += cached.fileCount;
+                publish.directories += cached.directoryCount;
+                return;
+            }
+        }
+
+        Worker& worker = *_workers[index];
+        Node& child    = worker.nodes.emplace_back();
+        child.parent   = &parent;
+        child.path     = AppendPath(parent.path, name);
+        child.key      = std::move(childKey);
+
+        parent.pending.fetch_add(1, std::memory_order_relaxed);
+        _outstanding.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(worker.mutex);
+            worker.tasks.push_back(&child);
+        }
+        _idleCv.notify_one();
+    }
+
+    void FinishNode(Node& finished) noexcept
+    {
+        Node* node = &finished;
+        while (node != nullptr)
+        {
+            if (node->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+
+            DirectorySizeTotals totals{};
+            totals.totalBytes     = node->totalBytes.load(std::memory_order_acquire);
+            totals.fileCount      = node->fileCount.load(std::memory_order_acquire);
+            totals.directoryCount = node->directoryCount.load(std::memory_order_acquire);
+
+            const bool incomplete = node->incomplete.load(std::memory_order_acquire);
+            Node* parent          = node->parent;
+            if (! node->key.empty() && ! incomplete && (parent == nullptr || totals.fileCount + totals.directoryCount >= kMinCachedSubtreeEntries))
+            {
+                _owner.StoreCachedDirectorySize(_cacheRootKey, node->key, totals, _startSequence);
+            }
+
+            if (parent != nullptr)
+            {
+                parent->totalBytes.fetch_add(totals.totalBytes, std::memory_order_relaxed);
+                parent->fileCount.fetch_add(totals.fileCount, std::memory_order_relaxed);
+                parent->directoryCount.fetch_add(totals.directoryCount, std::memory_order_relaxed);
+                if (incomplete)
+                {
+                    parent->incomplete.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            node = parent;
+        }
+    }
+
+    void Publish(Counts& counts) noexcept
+    {
+        if (counts.scanned == 0)
+        {
+            return;
+        }
+
+        _scannedEntries.fetch_add(counts.scanned, std::memory_order_relaxed);
+        _totalBytes.fetch_add(counts.bytes, std::memory_order_relaxed);
+        _fileCount.fetch_add(counts.files, std::memory_order_relaxed);
+        _directoryCount.fetch_add(counts.directories, std::memory_order_relaxed);
+        counts = {};
+    }
+
+    void RecordError(HRESULT hr) noexcept
+    {
+        HRESULT expected = S_OK;
+        _status.compare_exchange_strong(expected, hr, std::memory_order_acq_rel);
+    }
+
+    // Called on the caller's thread only.
+    void MaybeReportProgress(const wchar_t* currentPath, bool idle) noexcept
+    {
+        if (_callback == nullptr)
+        {
+            return;
+        }
+
+        // Scanning calls come every kProgressIntervalEntries entries; idle calls only report on the time interval.
+        const ULONGLONG now = ::GetTickCount64();
+        if (idle && (now - _lastProgressTick) < kProgressIntervalMs)
+        {
+            return;
+        }
+        _lastProgressTick = now;
+
+        std::wstring pathCopy;
+        if (currentPath == nullptr)
+        {
+            std::lock_guard lock(_pathMutex);
+            pathCopy = _currentPath;
+        }
+        _pathRequested.store(true, std::memory_order_release);
+
+        _callback->DirectorySizeProgress(_scannedEntries.load(std::memory_order_relaxed),
+                                         _totalBytes.load(std::memory_order_relaxed),
+                                         _fileCount.load(std::memory_order_relaxed),
+                                         _directoryCount.load(std::memory_order_relaxed),
+                                         currentPath != nullptr ? currentPath : (pathCopy.empty() ? nullptr : pathCopy.c_str()),
+                                         _cookie);
+
+        BOOL cancel = FALSE;
+        _callback->DirectorySizeShouldCancel(&cancel, _cookie);
+        if (cancel)
+        {
+            _userCancelled = true;
+            _cancelled.store(true, std::memory_order_release);
+            _idleCv.notify_all();
+        }
+    }
+
+    FileSystem& _owner;
+    const bool _recursive       = false;
+    const unsigned int _delayMs = 0u;
+    uint64_t _startSequence     = 0;
+    std::wstring _cacheRootKey; // empty when the walk does not use the cache
+
+    IFileSystemDirectorySizeCallback* _callback = nullptr;
+    void* _cookie                               = nullptr;
+    ULONGLONG _lastProgressTick                 = 0;
+    bool _userCancelled                         = false;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<size_t> _outstanding{0}; // queued + running directories
+    std::atomic<bool> _cancelled{false};
+    std::atomic<HRESULT> _status{S_OK};
+    std::mutex _idleMutex;
+    std::condition_variable _idleCv;
+
+    std::atomic<uint64_t> _scannedEntries{0};
+    std::atomic<uint64_t> _totalBytes{0};
+    std::atomic<uint64_t> _fileCount{0};
+    std::atomic<uint64_t> _directoryCount{0};
+
+    std::atomic<bool> _pathRequested{true};
+    std::mutex _pathMutex;
+    std::wstring _currentPath;
+};
+
+HRESULT STDMETHODCALLTYPE FileSystem::GetDirectorySize(
+    const wchar_t* path, FileSystemFlags flags, IFileSystemDirectorySizeCallback* callback, void* cookie, FileSystemDirectorySizeResult* result) noexcept
+{
+    if (path == nullptr || result == nullptr)
+    {
+        return E_POINTER;
+    }
+
+    if (path[0] == L'\0')
+    {
+        return E_INVALIDARG;
+    }
+
+    result->totalBytes     = 0;
+    result->fileCount      = 0;
+    result->directoryCount = 0;
+    result->status         = S_OK;
+
+    // Verify path is a directory.
+    const DWORD attrs = ::GetFileAttributesW(path);
+    if (attrs == INVALID_FILE_ATTRIBUTES)
+    {
+        const DWORD lastError = ::GetLastError();
+        result->status        = HRESULT_FROM_WIN32(lastError);
+        return result->status;
+    }
+
+    if ((attrs & FILE_ATTRIBUTE_DIRECTORY) == 0)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA fileData{};
+        if (::GetFileAttributesExW(path, GetFileExInfoStandard, &fileData) == 0)
+        {
+            const DWORD lastError = ::GetLastError();
+            result->status        = HRESULT_FROM_WIN32(lastError != 0 ? lastError : ERROR_GEN_FAILURE);
+            return result->status;
+        }
+
+        result->totalBytes = (static_cast<uint64_t>(fileData.nFileSizeHigh) << 32) | static_cast<uint64_t>(fileData.nFileSizeLow);
+        result->fileCount  = 1;
+
+        if (callback != nullptr)
+        {
+            callback->DirectorySizeProgress(1, result->totalBytes, result->fileCount, result->directoryCount, path, cookie);
+            BOOL cancel = FALSE;
+            callback->DirectorySizeShouldCancel(&cancel, cookie);
+            if (cancel)
+            {
+                result->status = HRESULT_FROM_WIN32(ERROR_CANCELLED);
+                return result->status;
+            }
+
+            callback->DirectorySizeProgress(1, result->totalBytes, result->fileCount, result->directoryCount, nullptr, cookie);
+        }
+
+        result->status = S_OK;
+        return S_OK;
+    }
+
+    if ((attrs & FILE_ATTRIBUTE_REPARSE_POINT) != 0)
+    {
+        // Root reparse points are treated as leaf links for sizing to match safe copy/delete policy.
+        result->status = S_OK;
+        return S_OK;
+    }
+
+#ifdef _DEBUG
+    const unsigned int delayMs = _directorySizeDelayMs;
+#else
+    const unsigned int delayMs = 0u;
+#endif
+
+    const bool recursive = (flags & FILESYSTEM_FLAG_RECURSIVE) != 0;
+    DirectorySizeWalker walker(*this, recursive, delayMs);
+    return walker.Run(std::wstring(path), callback, cookie, *result);
+}
+
+bool FileSystem::PrepareDirectorySizeCache(const std::wstring& path, std::wstring& cacheRootKey, std::wstring& rootKey, uint64_t& sequence) noexcept
+{
+    cacheRootKey.clear();
+    rootKey.clear();
+    sequence = 0;
+
+#ifdef _DEBUG
+    // The debug delay simulates slow media; cached totals would hide it.
+    if (_directorySizeDelayMs > 0u)
+    {
+        return false;
+    }
+#endif
+
+    // Watch notifications name the real, long-name path; resolve 8.3 names and links in the query to match them.
+    std::wstring finalPath;
+    DirectoryIdentity identity{};
+    if (! TryGetFinalDirectoryPath(path, finalPath, identity))
+    {
+        return false;
+    }
+
+    std::array<wchar_t, MAX_PATH + 1> volumeBuffer{};
+    if (::GetVolumePathNameW(finalPath.c_str(), volumeBuffer.data(), static_cast<DWORD>(volumeBuffer.size())) == 0)
+    {
+        return false;
+    }
+
+    // Only fixed volumes: a recursive watch keeps the queried directory open, which would block ejecting removable media
+    // and puts a subtree notification on remote servers.
+    if (::GetDriveTypeW(volumeBuffer.data()) != DRIVE_FIXED)
+    {
+        return false;
+    }
+
+    std::wstring queryKey = MakeDirectorySizeKey(finalPath);
+    std::wstring coveringKey;
+    std::wstring coveringPath;
+    DirectoryIdentity coveringIdentity{};
+    {
+        std::lock_guard lock(_directorySizeMutex);
+        for (const auto& [key, root] : _directorySizeRoots)
+        {
+            if (IsSameOrDescendantKey(queryKey, key))
+            {
+                coveringKey      = key;
+                coveringPath     = root.path;
+                coveringIdentity = DirectoryIdentity{root.volumeSerialNumber, root.fileIndex};
+                break;
+            }
+        }
+    }
+
+    // A root's own watch does not report the root being renamed away, so check that its path still names the watched
+    // directory before trusting the totals below it.
+    if (! coveringKey.empty())
+    {
+        bool sameDirectory = false;
+        if (coveringKey == queryKey)
+        {
+            sameDirectory = IsSameDirectory(identity, coveringIdentity);
+        }
+        else
+        {
+            std::wstring currentPath;
+            DirectoryIdentity currentIdentity{};
+            sameDirectory = TryGetFinalDirectoryPath(coveringPath, currentPath, currentIdentity) && IsSameDirectory(currentIdentity, coveringIdentity);
+        }
+
+        std::lock_guard lock(_directorySizeMutex);
+        const auto it = _directorySizeRoots.find(coveringKey);
+        if (sameDirectory && it != _directorySizeRoots.end())
+        {
+            it->second.lastUsedTick = ::GetTickCount64();
+            sequence                = it->second.sequence;
+            cacheRootKey            = std::move(coveringKey);
+            rootKey                 = std::move(queryKey);
+            return true;
+        }
+
+        if (! sameDirectory && it != _directorySizeRoots.end())
+        {
+            _directorySizeRoots.erase(it);
+        }
+    }
+
+    // The stale root's watch must be gone before a root for the same key starts (or reuses) one.
+    if (! coveringKey.empty())
+    {
+        StopDirectorySizeWatches({coveringKey});
+    }
+
+    const HRESULT hr = StartDirectorySizeWatch(finalPath, queryKey);
+    if (FAILED(hr))
+    {
+        Debug::Warning(L"FileSystem: directory size cache disabled for '{}' (watch hr=0x{:08X})", finalPath, static_cast<unsigned long>(hr));
+        return false;
+    }
+
+    std::vector<std::wstring> released;
+    {
+        std::lock_guard lock(_directorySizeMutex);
+
+        // A concurrent release may have stopped the watch between starting it and getting here.
+        if (! HasDirectorySizeWatch(queryKey))
+        {
+            return false;
+        }
+
+        // Roots below the new one are covered by its watch, and the least recently queried roots make room past the cap.
+        for (auto it = _directorySizeRoots.begin(); it != _directorySizeRoots.end();)
+        {
+            if (it->first != queryKey && IsSameOrDescendantKey(it->first, queryKey))
+            {
+                released.push_back(it->first);
+                it = _directorySizeRoots.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        const auto lessRecentlyUsed = [](const auto& left, const auto& right) noexcept { return left.second.lastUsedTick < right.second.lastUsedTick; };
+        while (! _directorySizeRoots.contains(queryKey) && _directorySizeRoots.size() >= kMaxDirectorySizeRoots)
+        {
+            const auto oldest = std::min_element(_directorySizeRoots.begin(), _directorySizeRoots.end(), lessRecentlyUsed);
+            released.push_back(oldest->first);
+            _directorySizeRoots.erase(oldest);
+        }
+
+        DirectorySizeRoot& root = _directorySizeRoots[queryKey];
+        if (root.path.empty())
+        {
+            root.path               = finalPath;
+            root.volumeSerialNumber = identity.volumeSerialNumber;
+            root.fileIndex          = identity.fileIndex;
+        }
+        root.lastUsedTick = ::GetTickCount64();
+        ArmDirectorySizeIdleTimerLocked(kDirectorySizeRootIdleMs);
+
+        sequence     = root.sequence;
+        cacheRootKey = queryKey;
+        rootKey      = std::move(queryKey);
+    }
+
+    StopDirectorySizeWatches(released);
+    return true;
+}
+
+void FileSystem::ArmDirectorySizeIdleTimerLocked(ULONGLONG delayMs) noexcept
+{
+    if (! _directorySizeIdleTimer)
+    {
+        _directorySizeIdleTimer.reset(::CreateThreadpoolTimer(
+            [](PTP_CALLBACK_INSTANCE, void* context, PTP_TIMER) noexcept { static_cast<FileSystem*>(context)->ReleaseIdleDirectorySizeRoots(); },
+            this,
+            nullptr));
+        if (! _directorySizeIdleTimer)
+        {
+            return;
+        }
+    }
+
+    // Already armed for an earlier root; that run re-arms for whatever is still in use.
+    if (::IsThreadpoolTimerSet(_directorySizeIdleTimer.get()))
+    {
+        return;
+    }
+
+    ULARGE_INTEGER due{};
+    due.QuadPart = static_cast<ULONGLONG>(-static_cast<LONGLONG>(delayMs * 10'000ull)); // relative, in 100 ns units
+    FILETIME dueTime{};
+    dueTime.dwLowDateTime  = due.LowPart;
+    dueTime.dwHighDateTime = due.HighPart;
+    ::SetThreadpoolTimer(_directorySizeIdleTimer.get(), &dueTime, 0, 0);
+}
+
+// Threadpool timer callback: drops roots nobody queried for kDirectorySizeRootIdleMs, so their watches stop pinning the
+// directories, and re-arms for the next root to go idle.
+void FileSystem::ReleaseIdleDirectorySizeRoots() noexcept
+{
+    std::vector<std::wstring> released;
+    {
+        std::lock_guard lock(_directorySizeMutex);
+        const ULONGLONG now = ::GetTickCount64();
+        ULONGLONG nextDueMs = 0;
+        for (auto it = _directorySizeRoots.begin(); it != _directorySizeRoots.end();)
+        {
+            const ULONGLONG idleMs = now - it->second.lastUsedTick;
+            if (idleMs >= kDirectorySizeRootIdleMs)
+            {
+                released.push_back(it->first);
+                it = _directorySizeRoots.erase(it);
+                continue;
+            }
+
+            const ULONGLONG remainingMs = kDirectorySizeRootIdleMs - idleMs;
+            nextDueMs                   = nextDueMs == 0 ? remainingMs : (std::min)(nextDueMs, remainingMs);
+            ++it;
+        }
+
+        if (nextDueMs > 0)
+        {
+            ArmDirectorySizeIdleTimerLocked(nextDueMs);
+        }
+    }
+
+    StopDirectorySizeWatches(released);
+}
+
+bool FileSystem::TryGetCachedDirectorySize(const std::wstring& cacheRootKey, const std::wstring& key, DirectorySizeTotals& totals) noexcept
+{
+    std::lock_guard lock(_directorySizeMutex);
+    const auto rootIt = _directorySizeRoots.find(cacheRootKey);
+    if (rootIt == _directorySizeRoots.end())
+    {
+        return false;
+    }
+
+    const auto it = rootIt->second.subtrees.find(key);
+    if (it == rootIt->second.subtrees.end())
+    {
+        return false;
+    }
+
+    totals = it->second;
+    return true;
+}
+
+void FileSystem::StoreCachedDirectorySize(const std::wstring& cacheRootKey,
+                                          const std::wstring& key,
+                                          const DirectorySizeTotals& totals,
+                                          uint64_t sinceSequence) noexcept
+{
+    std::lock_guard lock(_directorySizeMutex);
+    const auto rootIt = _directorySizeRoots.find(cacheRootKey);
+    if (rootIt == _directorySizeRoots.end())
+    {
+        return;
+    }
+
+    // A change that landed while this subtree was being walked may or may not be part of the totals.
+    DirectorySizeRoot& root = rootIt->second;
+    if (root.resetSequence > sinceSequence)
+    {
+        return;
+    }
+
+    for (auto it = root.recentChanges.rbegin(); it != root.recentChanges.rend() && it->first > sinceSequence; ++it)
+    {
+        if (IsSameOrDescendantKey(it->second, key) || IsSameOrDescendantKey(key, it->second))
+        {
+            return;
+        }
+    }
+
+    if (root.subtrees.size() >= kMaxCachedSubtreesPerRoot && ! root.subtrees.contains(key))
+    {
+        root.subtrees.clear();
+    }
+
+    root.subtrees.insert_or_assign(key, totals);
+}
+
+void FileSystem::OnDirectorySizeWatchChanged(const FileSystemDirectoryChangeNotification& notification) noexcept
+{
+    if (notification.watchedPath == nullptr)
+    {
+        return;
+    }
+
+    const std::wstring rootKey = MakeDirectorySizeKey(std::wstring_view(notification.watchedPath, notification.watchedPathSize / sizeof(wchar_t)));
+    if (rootKey.empty())
+    {
+        return;
+    }
+
+    const std::wstring prefix = rootKey.back() == L'\\' ? rootKey : rootKey + L'\\';
+
+    std::lock_guard lock(_directorySizeMutex);
+    const auto rootIt = _directorySizeRoots.find(rootKey);
+    if (rootIt == _directorySizeRoots.end())
+    {
+        return;
+    }
+
+    DirectorySizeRoot& root = rootIt->second;
+    if (notification.overflow || notification.changeCount == 0)
+    {
+        root.subtrees.clear();
+        root.recentChanges.clear();
+        root.resetSequence = ++root.sequence;
+        return;
+    }
+
+    for (unsigned long i = 0; i < notification.changeCount; ++i)
+    {
+        const FileSystemDirectoryChange& change = notification.changes[i];
+        const std::wstring_view relative(change.relativePath, change.relativePathSize / sizeof(wchar_t));
+        std::wstring changedKey = prefix + FoldPathCase(relative);
+
+        // Every directory above the change now has stale totals.
+        root.subtrees.erase(rootKey);
+        for (size_t pos = prefix.size(); pos < changedKey.size(); ++pos)
+        {
+            if (changedKey[pos] == L'\\')
+            {
+                root.subtrees.erase(changedKey.substr(0, pos));
+            }
+        }
+
+        // A removed or renamed directory takes its cached subtrees with it (one key range of the ordered map).
+        if (change.action == FILESYSTEM_DIR_CHANGE_REMOVED || change.action == FILESYSTEM_DIR_CHANGE_RENAMED_OLD_NAME ||
+            change.action == FILESYSTEM_DIR_CHANGE_UNKNOWN)
+        {
+            EraseKeyAndDescendants(root.subtrees, changedKey);
+        }
+        else
+        {
+            root.subtrees.erase(changedKey);
+        }
+
+        root.recentChanges.emplace_back(++root.sequence, std::move(changedKey));
+        if (root.recentChanges.size() > kMaxRecentChangesPerRoot)
+        {
+            root.resetSequence = root.recentChanges.front().first;
+            root.recentChanges.pop_front();
+        }
+    }
+}
@@ -80,6 +80,8 @@ struct OperationContext
     FileSystemReparsePointPolicy reparsePointPolicy = FileSystemReparsePointPolicy::CopyReparse;
     std::wstring reparseRootSourcePath;
     std::wstring reparseRootDestinationPath;
+
+    FileSystemOperationTuning tuning{};
 };
 #pragma warning(pop)
 
@@ -1532,7 +1534,8 @@ void InitializeOperationContext(OperationContext& context,
                                 IFileSystemCallback* callback,
                                 void* cookie,
                                 unsigned long totalItems,
-                                FileSystemReparsePointPolicy reparsePointPolicy) noexcept
+                                FileSystemReparsePointPolicy reparsePointPolicy,
+                                const FileSystemOperationTuning& tuning = {}) noexcept
 {
     context.type             = type;
     context.callback         = callback;
@@ -1560,6 +1563,7 @@ void InitializeOperationContext(OperationContext& context,
     context.reparsePointPolicy   = reparsePointPolicy;
     context.reparseRootSourcePath.clear();
     context.reparseRootDestinationPath.clear();
+    context.tuning = tuning;
 }
 
 HRESULT GetFileSizeBytes(const std::wstring& path, uint64_t* sizeBytes) noexcept
@@ -1750,25 +1754,16 @@ HRESULT RemovePathForOverwrite(OperationContext& context, const std::wstring& pa
     return S_OK;
 }
 
-DWORD CALLBACK CopyProgressRoutine(LARGE_INTEGER totalFileSize,
-                                   LARGE_INTEGER totalBytesTransferred,
-                                   [[maybe_unused]] LARGE_INTEGER streamSize,
-                                   [[maybe_unused]] LARGE_INTEGER streamBytesTransferred,
-                                   [[maybe_unused]] DWORD streamNumber,
-                                   [[maybe_unused]] DWORD callbackReason,
-                                   [[maybe_unused]] HANDLE sourceFile,
-                                   [[maybe_unused]] HANDLE destinationFile,
-                                   LPVOID context) noexcept
+// Shared by CopyProgressRoutine (CopyFileExW/MoveFileWithProgressW) and the unbuffered copy engine:
+// accounts bytes, reports progress and applies the bandwidth limit. Returns PROGRESS_CONTINUE or PROGRESS_CANCEL.
+DWORD UpdateCopyProgress(CopyProgressContext* progressContext, uint64_t itemTotal, uint64_t itemCompleted) noexcept
 {
-    auto* progressContext = static_cast<CopyProgressContext*>(context);
     if (! progressContext || ! progressContext->context)
     {
         return PROGRESS_CONTINUE;
     }
 
-    OperationContext& opContext  = *progressContext->context;
-    const uint64_t itemTotal     = static_cast<uint64_t>(totalFileSize.QuadPart);
-    const uint64_t itemCompleted = static_cast<uint64_t>(totalBytesTransferred.QuadPart);
+    OperationContext& opContext = *progressContext->context;
 
     if (opContext.parallel)
     {
@@ -1877,6 +1872,374 @@ DWORD CALLBACK CopyProgressRoutine(LARGE_INTEGER totalFileSize,
     return PROGRESS_CONTINUE;
 }
 
+DWORD CALLBACK CopyProgressRoutine(LARGE_INTEGER totalFileSize,
+                                   LARGE_INTEGER totalBytesTransferred,
+                                   [[maybe_unused]] LARGE_INTEGER streamSize,
+                                   [[maybe_unused]] LARGE_INTEGER streamBytesTransferred,
+                                   [[maybe_unused]] DWORD streamNumber,
+                                   [[maybe_unused]] DWORD callbackReason,
+                                   [[maybe_unused]] HANDLE sourceFile,
+                                   [[maybe_unused]] HANDLE destinationFile,
+                                   LPVOID context) noexcept
+{
+    return UpdateCopyProgress(static_cast<CopyProgressContext*>(context),
+                              static_cast<uint64_t>(totalFileSize.QuadPart),
+                              static_cast<uint64_t>(totalBytesTransferred.QuadPart));
+}
+
+// Unbuffered large-file copy engine (used for files >= FileSystemOperationTuning::unbufferedThresholdBytes).
+// Reads and writes sector-aligned chunks with FILE_FLAG_NO_BUFFERING overlapped I/O, keeping several chunks in flight so
+// reads overlap writes, and preallocates the destination. Files whose metadata CopyFileExW would carry and this engine
+// does not (alternate data streams, EFS, compression, sparse ranges) or that could be block-cloned stay on CopyFileExW.
+constexpr DWORD kUnbufferedCopyChunkBytes    = 1024u * 1024u;
+constexpr size_t kUnbufferedCopyQueueDepth   = 8u;
+constexpr DWORD kUnbufferedCopyMaxSectorSize = 64u * 1024u; // VirtualAlloc returns 64 KiB-aligned blocks
+
+enum class UnbufferedCopySlotState : uint8_t
+{
+    Idle,
+    Reading,
+    Writing,
+};
+
+struct UnbufferedCopySlot
+{
+    OVERLAPPED overlapped{};
+    wil::unique_event_nothrow event;
+    std::byte* buffer             = nullptr;
+    uint64_t offset               = 0;
+    DWORD requestBytes            = 0; // Sector-aligned read length (the tail read is rounded up past end of file)
+    DWORD expectedBytes           = 0; // File bytes in this chunk; less than requestBytes only for the unaligned tail
+    DWORD validBytes              = 0;
+    UnbufferedCopySlotState state = UnbufferedCopySlotState::Idle;
+};
+
+[[nodiscard]] uint64_t AlignUp(uint64_t value, uint64_t alignment) noexcept
+{
+    return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+[[nodiscard]] bool HasAlternateDataStreams(const std::wstring& pathExtended) noexcept
+{
+    WIN32_FIND_STREAM_DATA data{};
+    wil::unique_hfind findHandle(FindFirstStreamW(pathExtended.c_str(), FindStreamInfoStandard, &data, 0));
+    if (! findHandle)
+    {
+        // ERROR_HANDLE_EOF: no streams at all. Anything else: let CopyFileExW decide.
+        return GetLastError() != ERROR_HANDLE_EOF;
+    }
+
+    return FindNextStreamW(findHandle.get(), &data) != FALSE || GetLastError() != ERROR_HANDLE_EOF;
+}
+
+[[nodiscard]] std::wstring GetVolumeRootPath(const std::wstring& pathExtended) noexcept
+{
+    std::array<wchar_t, MAX_PATH + 1> buffer{};
+    if (! GetVolumePathNameW(pathExtended.c_str(), buffer.data(), static_cast<DWORD>(buffer.size())))
+    {
+        return {};
+    }
+    return std::wstring(buffer.data());
+}
+
+// Returns the sector size unbuffered I/O must honor for `volumeRoot` (0 when unknown).
+[[nodiscard]] DWORD GetVolumeSectorSize(const std::wstring& volumeRoot) noexcept
+{
+    DWORD sectorsPerCluster = 0;
+    DWORD bytesPerSector    = 0;
+    DWORD freeClusters      = 0;
+    DWORD totalClusters     = 0;
+    if (volumeRoot.empty() || ! GetDiskFreeSpaceW(volumeRoot.c_str(), &sectorsPerCluster, &bytesPerSector, &freeClusters, &totalClusters))
+    {
+        return 0;
+    }
+    return bytesPerSector;
+}
+
+// Returns S_FALSE when the file is not eligible (nothing was created); the caller then uses CopyFileExW.
+// On failure the partially written destination is deleted (matching CopyFileExW).
+HRESULT CopyFileUnbuffered(OperationContext& context,
+                           const PathInfo& source,
+                           const PathInfo& destination,
+                           uint64_t fileBytes,
+                           CopyProgressContext& progress) noexcept
+{
+    constexpr DWORD kUnsupportedAttributes = FILE_ATTRIBUTE_ENCRYPTED | FILE_ATTRIBUTE_COMPRESSED | FILE_ATTRIBUTE_SPARSE_FILE | FILE_ATTRIBUTE_OFFLINE;
+
+    wil::unique_hfile sourceFile(CreateFileW(source.extended.c_str(),
+                                             GENERIC_READ,
+                                             FILE_SHARE_READ,
+                                             nullptr,
+                                             OPEN_EXISTING,
+                                             FILE_FLAG_NO_BUFFERING | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN,
+                                             nullptr));
+    if (! sourceFile)
+    {
+        return S_FALSE;
+    }
+
+    FILE_BASIC_INFO sourceBasic{};
+    if (! GetFileInformationByHandleEx(sourceFile.get(), FileBasicInfo, &sourceBasic, sizeof(sourceBasic)) ||
+        (sourceBasic.FileAttributes & kUnsupportedAttributes) != 0 || HasAlternateDataStreams(source.extended))
+    {
+        return S_FALSE;
+    }
+
+    const std::wstring sourceVolume      = GetVolumeRootPath(source.extended);
+    const std::wstring destinationVolume = GetVolumeRootPath(destination.extended);
+    if (sourceVolume.empty() || destinationVolume.empty())
+    {
+        return S_FALSE;
+    }
+
+    DWORD volumeFlags = 0;
+    if (GetVolumeInformationByHandleW(sourceFile.get(), nullptr, 0, nullptr, nullptr, &volumeFlags, nullptr, 0) &&
+        (volumeFlags & FILE_SUPPORTS_BLOCK_REFCOUNTING) != 0 && EqualsInsensitive(sourceVolume, destinationVolume))
+    {
+        return S_FALSE; // same ReFS volume: CopyFileExW clones blocks instead of moving data
+    }
+
+    const DWORD sourceSector      = GetVolumeSectorSize(sourceVolume);
+    const DWORD destinationSector = GetVolumeSectorSize(destinationVolume);
+    const DWORD alignment         = std::max(sourceSector, destinationSector);
+    if (sourceSector == 0 || destinationSector == 0 || alignment > kUnbufferedCopyMaxSectorSize || (alignment & (alignment - 1u)) != 0)
+    {
+        return S_FALSE;
+    }
+
+    const size_t slotCount =
+        static_cast<size_t>(std::clamp<uint64_t>((fileBytes + kUnbufferedCopyChunkBytes - 1u) / kUnbufferedCopyChunkBytes, 1u, kUnbufferedCopyQueueDepth));
+    wil::unique_virtualalloc_ptr<std::byte> buffers(
+        static_cast<std::byte*>(VirtualAlloc(nullptr, slotCount * kUnbufferedCopyChunkBytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)));
+    if (! buffers)
+    {
+        return S_FALSE;
+    }
+
+    std::array<UnbufferedCopySlot, kUnbufferedCopyQueueDepth> slots{};
+    for (size_t i = 0; i < slotCount; ++i)
+    {
+        slots[i].event.reset(CreateEventW(nullptr, TRUE, FALSE, nullptr));
+        if (! slots[i].event)
+        {
+            return S_FALSE;
+        }
+        slots[i].buffer = buffers.get() + i * kUnbufferedCopyChunkBytes;
+    }
+
+    DWORD destinationFlags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_OVERLAPPED;
+    if (context.tuning.writeThrough)
+    {
+        destinationFlags |= FILE_FLAG_WRITE_THROUGH;
+    }
+
+    // CreateFileW failures (hidden/system attribute mismatch on overwrite, sharing, ...) are left to CopyFileExW so the
+    // reported error matches the regular path.
+    wil::unique_hfile destinationFile(CreateFileW(destination.extended.c_str(),
+                                                  GENERIC_WRITE | DELETE,
+                                                  0,
+                                                  nullptr,
+                                                  context.allowOverwrite ? CREATE_ALWAYS : CREATE_NEW,
+                                                  destinationFlags,
+                                                  nullptr));
+    if (! destinationFile)
+    {
+        return S_FALSE;
+    }
+
+    bool keepDestination    = false;
+    auto discardDestination = wil::scope_exit(
+        [&]() noexcept
+        {
+            if (! keepDestination)
+            {
+                FILE_DISPOSITION_INFO dispose{};
+                dispose.DeleteFile = TRUE;
+                static_cast<void>(SetFileInformationByHandle(destinationFile.get(), FileDispositionInfo, &dispose, sizeof(dispose)));
+            }
+        });
+
+    // Preallocate: contiguous allocation (best-effort) and the full sector-aligned length up front so writes never extend
+    // the file; the exact size is applied once all data is written.
+    FILE_ALLOCATION_INFO allocation{};
+    allocation.AllocationSize.QuadPart = static_cast<LONGLONG>(fileBytes);
+    static_cast<void>(SetFileInformationByHandle(destinationFile.get(), FileAllocationInfo, &allocation, sizeof(allocation)));
+
+    FILE_END_OF_FILE_INFO endOfFile{};
+    endOfFile.EndOfFile.QuadPart = static_cast<LONGLONG>(AlignUp(fileBytes, alignment));
+    if (! SetFileInformationByHandle(destinationFile.get(), FileEndOfFileInfo, &endOfFile, sizeof(endOfFile)))
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    uint64_t nextReadOffset = 0;
+    uint64_t writtenBytes   = 0;
+    HRESULT hr              = S_OK;
+
+    const auto issue = [&](UnbufferedCopySlot& slot, UnbufferedCopySlotState state) noexcept -> HRESULT
+    {
+        slot.overlapped            = {};
+        slot.overlapped.Offset     = static_cast<DWORD>(slot.offset & 0xFFFFFFFFull);
+        slot.overlapped.OffsetHigh = static_cast<DWORD>(slot.offset >> 32);
+        slot.overlapped.hEvent     = slot.event.get();
+        slot.state                 = state;
+
+        BOOL ok = FALSE;
+        if (state == UnbufferedCopySlotState::Reading)
+        {
+            ok = ReadFile(sourceFile.get(), slot.buffer, slot.requestBytes, nullptr, &slot.overlapped);
+        }
+        else
+        {
+            const DWORD alignedBytes = static_cast<DWORD>(AlignUp(slot.validBytes, alignment));
+            ok                       = WriteFile(destinationFile.get(), slot.buffer, alignedBytes, nullptr, &slot.overlapped);
+        }
+
+        const DWORD error = ok ? ERROR_SUCCESS : GetLastError();
+        if (error != ERROR_SUCCESS && error != ERROR_IO_PENDING)
+        {
+            slot.state = UnbufferedCopySlotState::Idle;
+            return HRESULT_FROM_WIN32(error);
+        }
+        return S_OK;
+    };
+
+    const auto issueNextRead = [&](UnbufferedCopySlot& slot) noexcept -> HRESULT
+    {
+        if (nextReadOffset >= fileBytes)
+        {
+            slot.state = UnbufferedCopySlotState::Idle;
+            return S_OK;
+        }
+
+        // NO_BUFFERING reads must be sector multiples: the tail is requested rounded up and comes back short at end of file.
+        // The chunk size is a multiple of every supported sector size, so the rounded tail still fits the slot buffer.
+        slot.offset        = nextReadOffset;
+        slot.expectedBytes = static_cast<DWORD>(std::min<uint64_t>(kUnbufferedCopyChunkBytes, fileBytes - nextReadOffset));
+        slot.requestBytes  = static_cast<DWORD>(AlignUp(slot.expectedBytes, alignment));
+        slot.validBytes    = 0;
+        nextReadOffset += slot.expectedBytes;
+        return issue(slot, UnbufferedCopySlotState::Reading);
+    };
+
+    for (size_t i = 0; i < slotCount && SUCCEEDED(hr); ++i)
+    {
+        hr = issueNextRead(slots[i]);
+    }
+
+    std::array<HANDLE, kUnbufferedCopyQueueDepth> waitHandles{};
+    std::array<size_t, kUnbufferedCopyQueueDepth> waitSlots{};
+    while (SUCCEEDED(hr))
+    {
+        DWORD waitCount = 0;
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            if (slots[i].state != UnbufferedCopySlotState::Idle)
+            {
+                waitHandles[waitCount] = slots[i].event.get();
+                waitSlots[waitCount]   = i;
+                ++waitCount;
+            }
+        }
+
+        if (waitCount == 0)
+        {
+            break;
+        }
+
+        const DWORD waitResult = WaitForMultipleObjects(waitCount, waitHandles.data(), FALSE, INFINITE);
+        if (waitResult >= WAIT_OBJECT_0 + waitCount)
+        {
+            hr = HRESULT_FROM_WIN32(waitResult == WAIT_FAILED ? GetLastError() : ERROR_INVALID_STATE);
+            break;
+        }
+
+        UnbufferedCopySlot& slot = slots[waitSlots[waitResult - WAIT_OBJECT_0]];
+        const HANDLE file        = slot.state == UnbufferedCopySlotState::Reading ? sourceFile.get() : destinationFile.get();
+        DWORD transferred        = 0;
+        const BOOL completed     = GetOverlappedResult(file, &slot.overlapped, &transferred, FALSE);
+        const DWORD error        = completed ? ERROR_SUCCESS : GetLastError();
+        ResetEvent(slot.event.get());
+
+        if (slot.state == UnbufferedCopySlotState::Reading)
+        {
+            slot.state = UnbufferedCopySlotState::Idle;
+            if (error != ERROR_SUCCESS && error != ERROR_HANDLE_EOF)
+            {
+                hr = HRESULT_FROM_WIN32(error);
+                break;
+            }
+            // Only the final chunk may come back shorter than requested, and then by exactly the unaligned remainder.
+            const bool finalChunk = slot.offset + slot.expectedBytes == fileBytes;
+            if (transferred != slot.expectedBytes || (! finalChunk && transferred != slot.requestBytes))
+            {
+                hr = HRESULT_FROM_WIN32(ERROR_HANDLE_EOF); // source changed size while copying
+                break;
+            }
+
+            slot.validBytes = transferred;
+            hr              = issue(slot, UnbufferedCopySlotState::Writing);
+            continue;
+        }
+
+        slot.state = UnbufferedCopySlotState::Idle;
+        if (error != ERROR_SUCCESS)
+        {
+            hr = HRESULT_FROM_WIN32(error);
+            break;
+        }
+
+        writtenBytes += slot.validBytes;
+        if (UpdateCopyProgress(&progress, fileBytes, writtenBytes) == PROGRESS_CANCEL)
+        {
+            hr = HRESULT_FROM_WIN32(ERROR_CANCELLED);
+            break;
+        }
+
+        hr = issueNextRead(slot);
+    }
+
+    if (FAILED(hr))
+    {
+        // Drain in-flight I/O before the buffers go away.
+        static_cast<void>(CancelIoEx(sourceFile.get(), nullptr));
+        static_cast<void>(CancelIoEx(destinationFile.get(), nullptr));
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            UnbufferedCopySlot& slot = slots[i];
+            if (slot.state != UnbufferedCopySlotState::Idle)
+            {
+                DWORD ignored     = 0;
+                const HANDLE file = slot.state == UnbufferedCopySlotState::Reading ? sourceFile.get() : destinationFile.get();
+                static_cast<void>(GetOverlappedResult(file, &slot.overlapped, &ignored, TRUE));
+                slot.state = UnbufferedCopySlotState::Idle;
+            }
+        }
+        return hr;
+    }
+
+    endOfFile.EndOfFile.QuadPart = static_cast<LONGLONG>(fileBytes);
+    if (! SetFileInformationByHandle(destinationFile.get(), FileEndOfFileInfo, &endOfFile, sizeof(endOfFile)))
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    // Same metadata CopyFileExW carries for a plain data stream: last write time and the basic attribute bits.
+    constexpr DWORD kCopiedAttributes = FILE_ATTRIBUTE_READONLY | FILE_ATTRIBUTE_HIDDEN | FILE_ATTRIBUTE_SYSTEM | FILE_ATTRIBUTE_ARCHIVE |
+                                        FILE_ATTRIBUTE_NOT_CONTENT_INDEXED;
+    FILE_BASIC_INFO destinationBasic{};
+    destinationBasic.LastWriteTime = sourceBasic.LastWriteTime;
+    destinationBasic.FileAttributes =
+        (sourceBasic.FileAttributes & kCopiedAttributes) != 0 ? (sourceBasic.FileAttributes & kCopiedAttributes) : FILE_ATTRIBUTE_NORMAL;
+    if (! SetFileInformationByHandle(destinationFile.get(), FileBasicInfo, &destinationBasic, sizeof(destinationBasic)))
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    keepDestination = true;
+    return S_OK;
+}
+
 HRESULT CopyFileInternal(OperationContext& context, const PathInfo& source, const PathInfo& destination, uint64_t* bytesCopied) noexcept
 {
     if (! bytesCopied)
@@ -1946,8 +2309,24 @@ HRESULT CopyFileInternal(OperationContext& context, const PathInfo& source, cons
         progress.startTick     = GetTickCount64();
     }
 
+    const uint64_t unbufferedThreshold = context.tuning.unbufferedThresholdBytes;
+    HRESULT engineHr                   = S_FALSE;
+    if (unbufferedThreshold > 0 && fileBytes >= unbufferedThreshold)
+    {
+        engineHr = CopyFileUnbuffered(context, source, destination, fileBytes, progress);
+        if (engineHr == HRESULT_FROM_WIN32(ERROR_CANCELLED))
+        {
+            return engineHr;
+        }
+        if (FAILED(engineHr))
+        {
+            return returnFailure(engineHr, fileBytes, progress.lastItemBytesTransferred);
+        }
+    }
+
     const DWORD copyFlags = context.allowOverwrite ? 0u : COPY_FILE_FAIL_IF_EXISTS;
-    if (! CopyFileExW(source.extended.c_str(), destination.extended.c_str(), CopyProgressRoutine, &progress, nullptr, copyFlags))
+    if (engineHr == S_FALSE &&
+        ! CopyFileExW(source.extended.c_str(), destination.extended.c_str(), CopyProgressRoutine, &progress, nullptr, copyFlags))
     {
         DWORD error = GetLastError();
         if (error == ERROR_REQUEST_ABORTED || error == ERROR_CANCELLED)
@@ -2171,7 +2550,166 @@ CopyReparsePointInternal(OperationContext& context, const PathInfo& source, cons
     return S_OK;
 }
 
-HRESULT CopyDirectoryInternal(OperationContext& context, const PathInfo& source, const PathInfo& destination, uint64_t* bytesCopied) noexcept
+// Small-file batch mode (trees of many tiny files). The per-file path pays for progress paths, a cancel check, attribute
+// probes and a progress callback for every file; here a directory's small files are split into units of
+// kSmallFileBatchUnitFiles that one scheduler worker processes back to back, and bytes/items, progress and the cancel check
+// are published once per unit. Entries a unit could not process go back to the regular per-file path, which owns conflict
+// handling (overwrite, read-only, retry/skip prompts).
+constexpr size_t kSmallFileBatchUnitFiles  = 64u;
+constexpr uint64_t kSmallFileBatchMaxBytes = 256ull * 1024ull;
+
+struct DirectoryChildEntry
+{
+    std::wstring name;
+    DWORD attributes        = 0;
+    uint64_t sizeBytes      = 0;
+    bool destinationCreated = false; // copy: destination directory created by the batched pre-pass
+};
+
+HRESULT EnumerateDirectoryChildren(const std::wstring& directoryExtended, std::vector<DirectoryChildEntry>& children) noexcept
+{
+    children.clear();
+
+    std::wstring searchPattern = AppendPath(directoryExtended, L"*");
+    WIN32_FIND_DATAW data{};
+    wil::unique_hfind findHandle(FindFirstFileExW(searchPattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH));
+    if (! findHandle)
+    {
+        const DWORD error = GetLastError();
+        return error == ERROR_FILE_NOT_FOUND ? S_OK : HRESULT_FROM_WIN32(error);
+    }
+
+    do
+    {
+        if (IsDotOrDotDot(data.cFileName))
+        {
+            continue;
+        }
+
+        DirectoryChildEntry& entry = children.emplace_back();
+        entry.name.assign(data.cFileName);
+        entry.attributes = data.dwFileAttributes;
+        entry.sizeBytes  = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | static_cast<uint64_t>(data.nFileSizeLow);
+    } while (FindNextFileW(findHandle.get(), &data));
+
+    const DWORD error = GetLastError();
+    return error == ERROR_NO_MORE_FILES ? S_OK : HRESULT_FROM_WIN32(error);
+}
+
+[[nodiscard]] bool IsSmallFileBatchEnabled(const OperationContext& context, size_t candidateCount) noexcept
+{
+    const size_t minFiles = static_cast<size_t>(context.tuning.smallFileBatchMinFiles);
+    if (minFiles == 0 || candidateCount < minFiles)
+    {
+        return false;
+    }
+
+    // A bandwidth cap is already the bottleneck; keep its per-file pacing.
+    const uint64_t bandwidthLimit =
+        context.parallel ? context.parallel->bandwidthLimitBytesPerSecond.load(std::memory_order_acquire) : GetBandwidthLimit(context.options);
+    return bandwidthLimit == 0;
+}
+
+// Runs processEntry(const DirectoryChildEntry&) -> bool for children[batch[i]] in units. Entries it returns false for are
+// appended to `retry`; `outBytes` receives the bytes of the processed entries.
+template <typename ProcessEntry>
+HRESULT RunSmallFileBatch(OperationContext& context,
+                          const std::vector<DirectoryChildEntry>& children,
+                          const std::vector<size_t>& batch,
+                          bool countItems,
+                          ProcessEntry&& processEntry,
+                          uint64_t& outBytes,
+                          std::vector<size_t>& retry) noexcept
+{
+    outBytes = 0;
+
+    const size_t unitCount = (batch.size() + kSmallFileBatchUnitFiles - 1u) / kSmallFileBatchUnitFiles;
+
+    std::mutex publishMutex; // serializes context updates and callbacks across units
+    std::atomic<bool> stop{false};
+    HRESULT stopHr      = S_OK; // guarded by publishMutex
+    uint64_t totalBytes = 0;    // guarded by publishMutex
+
+    const auto runUnit = [&](size_t unit) noexcept
+    {
+        uint64_t unitBytes      = 0;
+        unsigned long unitFiles = 0;
+        std::vector<size_t> unitRetry;
+
+        const size_t begin = unit * kSmallFileBatchUnitFiles;
+        const size_t end   = std::min(begin + kSmallFileBatchUnitFiles, batch.size());
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (stop.load(std::memory_order_acquire) ||
+                (context.parallel && (context.parallel->cancelRequested.load(std::memory_order_acquire) ||
+                                      context.parallel->stopOnErrorRequested.load(std::memory_order_acquire))))
+            {
+                stop.store(true, std::memory_order_release);
+                break;
+            }
+
+            const DirectoryChildEntry& entry = children[batch[i]];
+            if (processEntry(entry))
+            {
+                unitBytes += entry.sizeBytes;
+                ++unitFiles;
+            }
+            else
+            {
+                unitRetry.push_back(batch[i]);
+            }
+        }
+
+        std::scoped_lock lock(publishMutex);
+        totalBytes += unitBytes;
+        AddCompletedBytes(context, unitBytes);
+        if (countItems)
+        {
+            AddCompletedItems(context, unitFiles);
+        }
+        retry.insert(retry.end(), unitRetry.begin(), unitRetry.end());
+
+        if (FAILED(stopHr))
+        {
+            return;
+        }
+
+        HRESULT hr = ReportProgress(context, 0, 0);
+        if (SUCCEEDED(hr))
+        {
+            hr = CheckCancel(context);
+        }
+        if (FAILED(hr))
+        {
+            stopHr = hr;
+            stop.store(true, std::memory_order_release);
+        }
+    };
+
+    const unsigned int concurrency = context.tuning.smallFileBatchConcurrency;
+    if (concurrency <= 1u || unitCount <= 1u)
+    {
+        for (size_t unit = 0; unit < unitCount && ! stop.load(std::memory_order_acquire); ++unit)
+        {
+            runUnit(unit);
+        }
+    }
+    else
+    {
+        auto job = GetSharedFileOpsJobScheduler().StartJob(concurrency, unitCount, [&](size_t unit, uint64_t) noexcept { runUnit(unit); });
+        GetSharedFileOpsJobScheduler().WaitJob(job);
+    }
+
+    outBytes = totalBytes;
+    if (FAILED(stopHr))
+    {
+        return stopHr;
+    }
+    return stop.load(std::memory_order_acquire) ? HRESULT_FROM_WIN32(ERROR_CANCELLED) : S_OK;
+}
+
+HRESULT CopyDirectoryInternal(
+    OperationContext& context, const PathInfo& source, const PathInfo& destination, uint64_t* bytesCopied, bool destinationCreated = false) noexcept
 {
     if (! bytesCopied)
     {
@@ -2202,61 +2740,127 @@ HRESULT CopyDirectoryInternal(OperationContext& context, const PathInfo& source,
         return failure;
     };
 
-    DWORD destinationAttributes = GetFileAttributesW(destination.extended.c_str());
-    if (destinationAttributes == INVALID_FILE_ATTRIBUTES)
+    if (! destinationCreated)
     {
-        if (! CreateDirectoryW(destination.extended.c_str(), nullptr))
+        DWORD destinationAttributes = GetFileAttributesW(destination.extended.c_str());
+        if (destinationAttributes == INVALID_FILE_ATTRIBUTES)
         {
-            return returnFailure(HRESULT_FROM_WIN32(GetLastError()));
+            if (! CreateDirectoryW(destination.extended.c_str(), nullptr))
+            {
+                return returnFailure(HRESULT_FROM_WIN32(GetLastError()));
+            }
+        }
+        else
+        {
+            if ((destinationAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+            {
+                return returnFailure(HRESULT_FROM_WIN32(ERROR_ALREADY_EXISTS));
+            }
+            if (! context.allowOverwrite)
+            {
+                return returnFailure(HRESULT_FROM_WIN32(ERROR_ALREADY_EXISTS));
+            }
         }
     }
-    else
+
+    std::vector<DirectoryChildEntry> children;
+    hr = EnumerateDirectoryChildren(source.extended, children);
+    if (FAILED(hr))
     {
-        if ((destinationAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+        return returnFailure(hr);
+    }
+
+    const auto followsReparse = [&](DWORD attributes) noexcept
+    { return ! IsReparsePoint(attributes) || context.reparsePointPolicy == FileSystemReparsePointPolicy::FollowTargets; };
+
+    std::vector<size_t> batch;
+    std::vector<size_t> pending;
+    pending.reserve(children.size());
+    for (size_t index = 0; index < children.size(); ++index)
+    {
+        const DirectoryChildEntry& child = children[index];
+        if (! IsDirectory(child.attributes) && ! IsReparsePoint(child.attributes) && child.sizeBytes <= kSmallFileBatchMaxBytes)
         {
-            return returnFailure(HRESULT_FROM_WIN32(ERROR_ALREADY_EXISTS));
+            batch.push_back(index);
         }
-        if (! context.allowOverwrite)
+        else
         {
-            return returnFailure(HRESULT_FROM_WIN32(ERROR_ALREADY_EXISTS));
+            pending.push_back(index);
         }
     }
 
-    std::wstring searchPattern = AppendPath(source.extended, L"*");
-    WIN32_FIND_DATAW data{};
-    wil::unique_hfind findHandle(FindFirstFileExW(searchPattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH));
-    if (! findHandle)
+    if (IsSmallFileBatchEnabled(context, batch.size()))
     {
-        const DWORD error = GetLastError();
-        if (error == ERROR_FILE_NOT_FOUND)
+        // Create the child directories up front (one pass) so the recursion below skips its per-directory existence probe.
+        if (context.recursive)
         {
-            return S_OK;
+            for (const size_t index : pending)
+            {
+                DirectoryChildEntry& child = children[index];
+                if (IsDirectory(child.attributes) && followsReparse(child.attributes))
+                {
+                    child.destinationCreated = CreateDirectoryW(AppendPath(destination.extended, child.name).c_str(), nullptr) != FALSE;
+                }
+            }
+        }
+
+        const DWORD copyFlags = context.allowOverwrite ? 0u : COPY_FILE_FAIL_IF_EXISTS;
+        uint64_t batchBytes   = 0;
+        std::vector<size_t> retry;
+        hr = RunSmallFileBatch(
+            context,
+            children,
+            batch,
+            false,
+            [&](const DirectoryChildEntry& child) noexcept
+            {
+                const std::wstring childSource      = AppendPath(source.extended, child.name);
+                const std::wstring childDestination = AppendPath(destination.extended, child.name);
+                return CopyFileExW(childSource.c_str(), childDestination.c_str(), nullptr, nullptr, nullptr, copyFlags) != FALSE;
+            },
+            batchBytes,
+            retry);
+        *bytesCopied += batchBytes;
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Failed entries (conflicts, read-only targets, transient errors) take the regular per-file path, in listing order.
+        pending.insert(pending.end(), retry.begin(), retry.end());
+        std::ranges::sort(pending);
+
+        hr = SetProgressPaths(context, source.display.c_str(), destination.display.c_str());
+        if (FAILED(hr))
+        {
+            return hr;
         }
-        return returnFailure(HRESULT_FROM_WIN32(error));
+    }
+    else
+    {
+        pending.insert(pending.end(), batch.begin(), batch.end());
+        std::ranges::sort(pending);
     }
 
     bool hadFailure = false;
     bool hadSkipped = false;
 
-    do
+    for (const size_t index : pending)
     {
-        if (IsDotOrDotDot(data.cFileName))
-        {
-            continue;
-        }
+        const DirectoryChildEntry& child = children[index];
 
         PathInfo childSource{};
-        childSource.display  = AppendPath(source.display, data.cFileName);
-        childSource.extended = AppendPath(source.extended, data.cFileName);
+        childSource.display  = AppendPath(source.display, child.name);
+        childSource.extended = AppendPath(source.extended, child.name);
 
         PathInfo childDestination{};
-        childDestination.display  = AppendPath(destination.display, data.cFileName);
-        childDestination.extended = AppendPath(destination.extended, data.cFileName);
+        childDestination.display  = AppendPath(destination.display, child.name);
+        childDestination.extended = AppendPath(destination.extended, child.name);
 
         uint64_t childBytes = 0;
         HRESULT childHr     = S_OK;
 
-        const DWORD childAttributes = data.dwFileAttributes;
+        const DWORD childAttributes = child.attributes;
         const bool childIsDirectory = IsDirectory(childAttributes);
         const bool childIsReparse   = IsReparsePoint(childAttributes);
 
@@ -2285,7 +2889,7 @@ HRESULT CopyDirectoryInternal(OperationContext& context, const PathInfo& source,
                 }
                 else
                 {
-                    childHr = CopyDirectoryInternal(context, childSource, childDestination, &childBytes);
+                    childHr = CopyDirectoryInternal(context, childSource, childDestination, &childBytes, child.destinationCreated);
                 }
             }
             else if (childIsReparse && context.reparsePointPolicy != FileSystemReparsePointPolicy::FollowTargets)
@@ -2362,12 +2966,6 @@ HRESULT CopyDirectoryInternal(OperationContext& context, const PathInfo& source,
         {
             return hr;
         }
-    } while (FindNextFileW(findHandle.get(), &data));
-
-    const DWORD error = GetLastError();
-    if (error != ERROR_NO_MORE_FILES)
-    {
-        return returnFailure(HRESULT_FROM_WIN32(error));
     }
 
     if (hadFailure || hadSkipped)
@@ -2549,8 +3147,15 @@ struct DirectoryChildWorkItem
             }
 
             OperationContext context{};
-            InitializeOperationContext(
-                context, FILESYSTEM_COPY, flags, sharedOptionsState, rootContext.callback, rootContext.callbackCookie, 1, reparsePointPolicy);
+            InitializeOperationContext(context,
+                                       FILESYSTEM_COPY,
+                                       flags,
+                                       sharedOptionsState,
+                                       rootContext.callback,
+                                       rootContext.callbackCookie,
+                                       1,
+                                       reparsePointPolicy,
+                                       rootContext.tuning);
             context.options                    = sharedOptionsState;
             context.parallel                   = &parallel;
             context.totalBytes                 = 0; // let the host provide totals via pre-calc
@@ -2986,6 +3591,7 @@ HRESULT MovePathInternal(OperationContext& context, const PathInfo& source, cons
     deleteContext.useRecycleBin          = false;
     deleteContext.parallel               = nullptr;
     deleteContext.lastProgressReportTick = 0;
+    deleteContext.tuning                 = context.tuning;
 
     const HRESULT deleteHr = DeletePathInternal(deleteContext, source);
     if (FAILED(deleteHr))
@@ -3499,31 +4105,69 @@ HRESULT DeletePathInternal(OperationContext& context, const PathInfo& path) noex
 
 HRESULT DeleteDirectoryRecursive(OperationContext& context, const PathInfo& path) noexcept
 {
-    std::wstring searchPattern = AppendPath(path.extended, L"*");
-    WIN32_FIND_DATAW data{};
-    wil::unique_hfind findHandle(FindFirstFileExW(searchPattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH));
-    if (! findHandle)
+    std::vector<DirectoryChildEntry> children;
+    HRESULT hr = EnumerateDirectoryChildren(path.extended, children);
+    if (FAILED(hr))
     {
-        const DWORD error = GetLastError();
-        if (error == ERROR_FILE_NOT_FOUND)
+        return hr;
+    }
+
+    std::vector<size_t> batch;
+    std::vector<size_t> pending;
+    pending.reserve(children.size());
+    for (size_t index = 0; index < children.size(); ++index)
+    {
+        // Read-only files need the attribute reset (and its allowReplaceReadonly check) of the per-file path.
+        constexpr DWORD kPerFileAttributes = FILE_ATTRIBUTE_DIRECTORY | FILE_ATTRIBUTE_REPARSE_POINT | FILE_ATTRIBUTE_READONLY;
+        if ((children[index].attributes & kPerFileAttributes) == 0 && children[index].sizeBytes <= kSmallFileBatchMaxBytes)
         {
-            return S_OK;
+            batch.push_back(index);
+        }
+        else
+        {
+            pending.push_back(index);
         }
-        return HRESULT_FROM_WIN32(error);
     }
 
-    bool hadFailure = false;
-
-    do
+    if (IsSmallFileBatchEnabled(context, batch.size()))
     {
-        if (IsDotOrDotDot(data.cFileName))
+        hr = SetProgressPaths(context, path.display.c_str(), nullptr);
+        if (FAILED(hr))
         {
-            continue;
+            return hr;
+        }
+
+        uint64_t batchBytes = 0;
+        std::vector<size_t> retry;
+        hr = RunSmallFileBatch(
+            context,
+            children,
+            batch,
+            true,
+            [&](const DirectoryChildEntry& child) noexcept { return DeleteFileW(AppendPath(path.extended, child.name).c_str()) != FALSE; },
+            batchBytes,
+            retry);
+        if (FAILED(hr))
+        {
+            return hr;
         }
 
+        pending.insert(pending.end(), retry.begin(), retry.end());
+        std::ranges::sort(pending);
+    }
+    else
+    {
+        pending.insert(pending.end(), batch.begin(), batch.end());
+        std::ranges::sort(pending);
+    }
+
+    bool hadFailure = false;
+
+    for (const size_t index : pending)
+    {
         PathInfo child{};
-        child.display  = AppendPath(path.display, data.cFileName);
-        child.extended = AppendPath(path.extended, data.cFileName);
+        child.display  = AppendPath(path.display, children[index].name);
+        child.extended = AppendPath(path.extended, children[index].name);
 
         HRESULT childHr = DeletePathInternal(context, child);
         if (FAILED(childHr))
@@ -3540,17 +4184,11 @@ HRESULT DeleteDirectoryRecursive(OperationContext& context, const PathInfo& path
             }
         }
 
-        HRESULT hr = CheckCancel(context);
+        hr = CheckCancel(context);
         if (FAILED(hr))
         {
             return hr;
         }
-    } while (FindNextFileW(findHandle.get(), &data));
-
-    const DWORD error = GetLastError();
-    if (error != ERROR_NO_MORE_FILES)
-    {
-        return HRESULT_FROM_WIN32(error);
     }
 
     if (! RemoveDirectoryW(path.extended.c_str()))
@@ -3587,14 +4225,16 @@ HRESULT STDMETHODCALLTYPE FileSystem::CopyItem(const wchar_t* sourcePath,
 
     FileSystemReparsePointPolicy reparsePointPolicy = FileSystemReparsePointPolicy::CopyReparse;
     unsigned int copyMoveMaxConcurrency             = 1u;
+    FileSystemOperationTuning tuning{};
     {
         std::lock_guard lock(_stateMutex);
         reparsePointPolicy     = _reparsePointPolicy;
         copyMoveMaxConcurrency = _copyMoveMaxConcurrency;
+        tuning                 = GetOperationTuningLocked(FILESYSTEM_COPY);
     }
 
     OperationContext context{};
-    InitializeOperationContext(context, FILESYSTEM_COPY, flags, options, callback, cookie, 1, reparsePointPolicy);
+    InitializeOperationContext(context, FILESYSTEM_COPY, flags, options, callback, cookie, 1, reparsePointPolicy, tuning);
 
     const PathInfo source      = MakePathInfo(sourcePath);
     const PathInfo destination = MakePathInfo(destinationPath);
@@ -3658,13 +4298,15 @@ HRESULT STDMETHODCALLTYPE FileSystem::MoveItem(const wchar_t* sourcePath,
     }
 
     FileSystemReparsePointPolicy reparsePointPolicy = FileSystemReparsePointPolicy::CopyReparse;
+    FileSystemOperationTuning tuning{};
     {
         std::lock_guard lock(_stateMutex);
         reparsePointPolicy = _reparsePointPolicy;
+        tuning             = GetOperationTuningLocked(FILESYSTEM_MOVE);
     }
 
     OperationContext context{};
-    InitializeOperationContext(context, FILESYSTEM_MOVE, flags, options, callback, cookie, 1, reparsePointPolicy);
+    InitializeOperationContext(context, FILESYSTEM_MOVE, flags, options, callback, cookie, 1, reparsePointPolicy, tuning);
 
     const PathInfo source      = MakePathInfo(sourcePath);
     const PathInfo destination = MakePathInfo(destinationPath);
@@ -3706,14 +4348,16 @@ FileSystem::DeleteItem(const wchar_t* path, FileSystemFlags flags, const FileSys
     }
 
     FileSystemReparsePointPolicy reparsePointPolicy = FileSystemReparsePointPolicy::CopyReparse;
+    FileSystemOperationTuning tuning{};
     {
         std::lock_guard lock(_stateMutex);
         reparsePointPolicy = _reparsePointPolicy;
+        tuning             = GetOperationTuningLocked(FILESYSTEM_DELETE);
     }
 
     OperationContext context{};
     // totalItems is 0 because the plugin does not know recursive totals; the host may provide totals via pre-calculation.
-    InitializeOperationContext(context, FILESYSTEM_DELETE, flags, options, callback, cookie, 0, reparsePointPolicy);
+    InitializeOperationContext(context, FILESYSTEM_DELETE, flags, options, callback, cookie, 0, reparsePointPolicy, tuning);
 
     const PathInfo target = MakePathInfo(path);
 
@@ -3820,10 +4464,12 @@ HRESULT STDMETHODCALLTYPE FileSystem::CopyItems(const wchar_t* const* sourcePath
 
     FileSystemReparsePointPolicy reparsePointPolicy = FileSystemReparsePointPolicy::CopyReparse;
     unsigned int copyMoveMaxConcurrency             = 1;
+    FileSystemOperationTuning tuning{};
     {
         std::lock_guard lock(_stateMutex);
         reparsePointPolicy     = _reparsePointPolicy;
         copyMoveMaxConcurrency = _copyMoveMaxConcurrency;
+        tuning                 = GetOperationTuningLocked(FILESYSTEM_COPY);
     }
 
     const PathInfo destinationRoot    = MakePathInfo(destinationFolder);
@@ -3833,7 +4479,7 @@ HRESULT STDMETHODCALLTYPE FileSystem::CopyItems(const wchar_t* const* sourcePath
     if (concurrency <= 1u)
     {
         OperationContext context{};
-        InitializeOperationContext(context, FILESYSTEM_COPY, flags, options, callback, cookie, count, reparsePointPolicy);
+        InitializeOperationContext(context, FILESYSTEM_COPY, flags, options, callback, cookie, count, reparsePointPolicy, tuning);
 
         bool hadFailure = false;
 
@@ -3948,7 +4594,7 @@ HRESULT STDMETHODCALLTYPE FileSystem::CopyItems(const wchar_t* const* sourcePath
             }
 
             OperationContext context{};
-            InitializeOperationContext(context, FILESYSTEM_COPY, flags, &sharedOptionsState, callback, cookie, count, reparsePointPolicy);
+            InitializeOperationContext(context, FILESYSTEM_COPY, flags, &sharedOptionsState, callback, cookie, count, reparsePointPolicy, tuning);
             context.options          = &sharedOptionsState;
             context.parallel         = &parallel;
             context.totalBytes       = 0; // let the host provide totals via pre-calc
@@ -4074,10 +4720,12 @@ HRESULT STDMETHODCALLTYPE FileSystem::MoveItems(const wchar_t* const* sourcePath
 
     FileSystemReparsePointPolicy reparsePointPolicy = FileSystemReparsePointPolicy::CopyReparse;
     unsigned int copyMoveMaxConcurrency             = 1;
+    FileSystemOperationTuning tuning{};
     {
         std::lock_guard lock(_stateMutex);
         reparsePointPolicy     = _reparsePointPolicy;
         copyMoveMaxConcurrency = _copyMoveMaxConcurrency;
+        tuning                 = GetOperationTuningLocked(FILESYSTEM_MOVE);
     }
 
     const PathInfo destinationRoot    = MakePathInfo(destinationFolder);
@@ -4087,7 +4735,7 @@ HRESULT STDMETHODCALLTYPE FileSystem::MoveItems(const wchar_t* const* sourcePath
     if (concurrency <= 1u)
     {
         OperationContext context{};
-        InitializeOperationContext(context, FILESYSTEM_MOVE, flags, options, callback, cookie, count, reparsePointPolicy);
+        InitializeOperationContext(context, FILESYSTEM_MOVE, flags, options, callback, cookie, count, reparsePointPolicy, tuning);
 
         bool hadFailure = false;
 
@@ -4197,7 +4845,7 @@ HRESULT STDMETHODCALLTYPE FileSystem::MoveItems(const wchar_t* const* sourcePath
             }
 
             OperationContext context{};
-            InitializeOperationContext(context, FILESYSTEM_MOVE, flags, &sharedOptionsState, callback, cookie, count, reparsePointPolicy);
+            InitializeOperationContext(context, FILESYSTEM_MOVE, flags, &sharedOptionsState, callback, cookie, count, reparsePointPolicy, tuning);
             context.options          = &sharedOptionsState;
             context.parallel         = &parallel;
             context.totalBytes       = 0; // let the host provide totals via pre-calc
@@ -4309,11 +4957,13 @@ HRESULT STDMETHODCALLTYPE FileSystem::DeleteItems(const wchar_t* const* paths,
     FileSystemReparsePointPolicy reparsePointPolicy = FileSystemReparsePointPolicy::CopyReparse;
     unsigned int deleteMaxConcurrency               = 1;
     unsigned int deleteRecycleBinMaxConcurrency     = 1;
+    FileSystemOperationTuning tuning{};
     {
         std::lock_guard lock(_stateMutex);
         reparsePointPolicy             = _reparsePointPolicy;
         deleteMaxConcurrency           = _deleteMaxConcurrency;
         deleteRecycleBinMaxConcurrency = _deleteRecycleBinMaxConcurrency;
+        tuning                         = GetOperationTuningLocked(FILESYSTEM_DELETE);
     }
 
     const bool useRecycleBin = HasFlag(flags, FILESYSTEM_FLAG_USE_RECYCLE_BIN);
@@ -4450,7 +5100,7 @@ HRESULT STDMETHODCALLTYPE FileSystem::DeleteItems(const wchar_t* const* paths,
 
                 OperationContext context{};
                 // totalItems is 0 because the plugin does not know recursive totals; the host may provide totals via pre-calculation.
-                InitializeOperationContext(context, FILESYSTEM_DELETE, flags, &sharedOptionsState, callback, cookie, 0, reparsePointPolicy);
+                InitializeOperationContext(context, FILESYSTEM_DELETE, flags, &sharedOptionsState, callback, cookie, 0, reparsePointPolicy, tuning);
                 context.options          = &sharedOptionsState;
                 context.parallel         = &parallel;
                 context.totalBytes       = 0; // host pre-calc provides totals when available
@@ -4613,7 +5263,7 @@ HRESULT STDMETHODCALLTYPE FileSystem::DeleteItems(const wchar_t* const* paths,
 
     OperationContext context{};
     // totalItems is 0 because the plugin does not know recursive totals; the host may provide totals via pre-calculation.
-    InitializeOperationContext(context, FILESYSTEM_DELETE, flags, options, callback, cookie, 0, reparsePointPolicy);
+    InitializeOperationContext(context, FILESYSTEM_DELETE, flags, options, callback, cookie, 0, reparsePointPolicy, tuning);
 
     bool hadFailure = false;
 
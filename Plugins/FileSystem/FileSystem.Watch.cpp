@@ -31,13 +31,15 @@ FileSystemDirectoryChangeAction MapDirectoryWatchAction(DWORD action) noexcept
 class FileSystem::DirectoryWatch final
 {
 public:
-    DirectoryWatch(std::wstring watchedPath, std::wstring extendedPath, IFileSystemDirectoryWatchCallback* callback, void* cookie) noexcept
+    DirectoryWatch(
+        std::wstring watchedPath, std::wstring extendedPath, IFileSystemDirectoryWatchCallback* callback, void* cookie, bool watchSubtree = false) noexcept
         : _watchedPath(std::move(watchedPath)),
           _extendedPath(std::move(extendedPath)),
           _callback(callback),
           _cookie(cookie),
           _activeBuffer(kDefaultWatchBufferBytes),
-          _filter(kDefaultWatchFilter)
+          _filter(kDefaultWatchFilter),
+          _watchSubtree(watchSubtree)
     {
         _freeBuffers.reserve(kDefaultWatchBufferPool > 0 ? (kDefaultWatchBufferPool - 1u) : 0u);
         for (size_t i = 1u; i < kDefaultWatchBufferPool; ++i)
@@ -263,9 +265,10 @@ private:
         std::memset(&_overlapped, 0, sizeof(_overlapped));
         ::StartThreadpoolIo(_tpIo.get());
 
-        DWORD bytesReturned = 0;
-        const BOOL ok       = ::ReadDirectoryChangesW(
-            _directory.get(), _activeBuffer.data(), static_cast<DWORD>(_activeBuffer.size()), FALSE, _filter, &bytesReturned, &_overlapped, nullptr);
+        DWORD bytesReturned     = 0;
+        const BOOL watchSubtree = _watchSubtree ? TRUE : FALSE;
+        const BOOL ok           = ::ReadDirectoryChangesW(
+            _directory.get(), _activeBuffer.data(), static_cast<DWORD>(_activeBuffer.size()), watchSubtree, _filter, &bytesReturned, &_overlapped, nullptr);
         if (ok)
         {
             return S_OK;
@@ -636,7 +639,8 @@ private:
     bool _workSubmitted  = false;
     bool _overflowQueued = false;
     OVERLAPPED _overlapped{};
-    DWORD _filter = 0;
+    DWORD _filter      = 0;
+    bool _watchSubtree = false;
 
     std::atomic<bool> _running{false};
     std::atomic<bool> _stopping{false};
@@ -653,6 +657,20 @@ private:
     std::mutex _mutex;
 };
 
+class FileSystem::DirectorySizeWatchCallback final : public IFileSystemDirectoryWatchCallback
+{
+public:
+    HRESULT STDMETHODCALLTYPE FileSystemDirectoryChanged(const FileSystemDirectoryChangeNotification* notification, void* cookie) noexcept override
+    {
+        auto* owner = static_cast<FileSystem*>(cookie);
+        if (owner && notification)
+        {
+            owner->OnDirectorySizeWatchChanged(*notification);
+        }
+        return S_OK;
+    }
+};
+
 FileSystem::FileSystem()
 {
     _metaData.id          = kPluginId;
@@ -671,10 +689,13 @@ FileSystem::FileSystem()
 
 FileSystem::~FileSystem()
 {
+    // Waits for a running idle sweep; it stops watches too.
+    _directorySizeIdleTimer.reset();
+
     std::vector<std::unique_ptr<DirectoryWatch>> watchersToStop;
     {
         std::lock_guard lock(_watchMutex);
-        watchersToStop.reserve(_directoryWatches.size());
+        watchersToStop.reserve(_directoryWatches.size() + _directorySizeWatches.size());
 
         for (auto& entry : _directoryWatches)
         {
@@ -685,6 +706,16 @@ FileSystem::~FileSystem()
         }
 
         _directoryWatches.clear();
+
+        for (auto& entry : _directorySizeWatches)
+        {
+            if (entry.second)
+            {
+                watchersToStop.emplace_back(std::move(entry.second));
+            }
+        }
+
+        _directorySizeWatches.clear();
     }
 
     for (auto& watcher : watchersToStop)
@@ -788,3 +819,86 @@ HRESULT STDMETHODCALLTYPE FileSystem::UnwatchDirectory(const wchar_t* path) noex
 
     return S_OK;
 }
+
+HRESULT FileSystem::StartDirectorySizeWatch(const std::wstring& rootPath, const std::wstring& rootKey) noexcept
+{
+    static DirectorySizeWatchCallback callback;
+
+    const std::wstring extendedPath = ToExtendedPath(rootPath);
+    if (extendedPath.empty())
+    {
+        return E_INVALIDARG;
+    }
+
+    {
+        std::lock_guard lock(_watchMutex);
+        if (_directorySizeWatches.contains(rootKey))
+        {
+            return S_OK;
+        }
+    }
+
+    auto watch       = std::make_unique<DirectoryWatch>(rootPath, extendedPath, &callback, this, true);
+    const HRESULT hr = watch->Start();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    {
+        std::lock_guard lock(_watchMutex);
+        if (_directorySizeWatches.emplace(rootKey, std::move(watch)).second)
+        {
+            return S_OK;
+        }
+    }
+
+    // Another caller started the same root first; its watch covers this one.
+    watch->Stop();
+    return S_OK;
+}
+
+bool FileSystem::HasDirectorySizeWatch(const std::wstring& rootKey) noexcept
+{
+    std::lock_guard lock(_watchMutex);
+    return _directorySizeWatches.contains(rootKey);
+}
+
+void FileSystem::StopDirectorySizeWatches(const std::vector<std::wstring>& rootKeys) noexcept
+{
+    if (rootKeys.empty())
+    {
+        return;
+    }
+
+    std::vector<std::unique_ptr<DirectoryWatch>> watchersToStop;
+    {
+        // A root recreated under the same key since it was released keeps the watch it now relies on.
+        std::scoped_lock lock(_directorySizeMutex, _watchMutex);
+        for (const std::wstring& rootKey : rootKeys)
+        {
+            if (_directorySizeRoots.contains(rootKey))
+            {
+                continue;
+            }
+
+            const auto it = _directorySizeWatches.find(rootKey);
+            if (it == _directorySizeWatches.end())
+            {
+                continue;
+            }
+
+            watchersToStop.emplace_back(std::move(it->second));
+            _directorySizeWatches.erase(it);
+        }
+    }
+
+    // Stop waits for in-flight notifications, which take _directorySizeMutex; never call it under that lock.
+    for (auto& watcher : watchersToStop)
+    {
+        if (watcher)
+        {
+            watcher->Stop();
+        }
+    }
+}
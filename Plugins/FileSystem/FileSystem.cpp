@@ -730,6 +730,9 @@ HRESULT STDMETHODCALLTYPE FileSystem::SetConfiguration(const char* configuration
     unsigned long enumerationSoftMaxBufferMiB       = kDefaultEnumerationSoftMaxBufferMiB;
     unsigned long enumerationHardMaxBufferMiB       = kDefaultEnumerationHardMaxBufferMiB;
     FileSystemReparsePointPolicy reparsePointPolicy = kDefaultReparsePointPolicy;
+    unsigned long unbufferedCopyThresholdMiB        = kDefaultUnbufferedCopyThresholdMiB;
+    bool unbufferedCopyWriteThrough                 = kDefaultUnbufferedCopyWriteThrough;
+    unsigned long smallFileBatchMinFiles            = kDefaultSmallFileBatchMinFiles;
 #ifdef _DEBUG
     unsigned int directorySizeDelayMs = 0u;
 #endif
@@ -810,6 +813,33 @@ HRESULT STDMETHODCALLTYPE FileSystem::SetConfiguration(const char* configuration
                     }
                 }
 
+                yyjson_val* unbufferedThresholdVal = yyjson_obj_get(root, "unbufferedCopyThresholdMiB");
+                if (unbufferedThresholdVal && yyjson_is_int(unbufferedThresholdVal))
+                {
+                    const int64_t value = yyjson_get_int(unbufferedThresholdVal);
+                    if (value >= 0)
+                    {
+                        unbufferedCopyThresholdMiB =
+                            static_cast<unsigned long>(std::min<int64_t>(value, static_cast<int64_t>(kMaxUnbufferedCopyThresholdMiB)));
+                    }
+                }
+
+                yyjson_val* writeThroughVal = yyjson_obj_get(root, "unbufferedCopyWriteThrough");
+                if (writeThroughVal && yyjson_is_bool(writeThroughVal))
+                {
+                    unbufferedCopyWriteThrough = yyjson_get_bool(writeThroughVal);
+                }
+
+                yyjson_val* smallFileBatchVal = yyjson_obj_get(root, "smallFileBatchMinFiles");
+                if (smallFileBatchVal && yyjson_is_int(smallFileBatchVal))
+                {
+                    const int64_t value = yyjson_get_int(smallFileBatchVal);
+                    if (value >= 0)
+                    {
+                        smallFileBatchMinFiles = static_cast<unsigned long>(std::min<int64_t>(value, static_cast<int64_t>(kMaxSmallFileBatchMinFiles)));
+                    }
+                }
+
 #ifdef _DEBUG
                 yyjson_val* delayVal = yyjson_obj_get(root, "directorySizeDelayMs");
                 if (delayVal && yyjson_is_int(delayVal))
@@ -834,13 +864,17 @@ HRESULT STDMETHODCALLTYPE FileSystem::SetConfiguration(const char* configuration
 
     std::string newConfigurationJson;
     newConfigurationJson = std::format("{{\"copyMoveMaxConcurrency\":{},\"deleteMaxConcurrency\":{},\"deleteRecycleBinMaxConcurrency\":{},"
-                                       "\"enumerationSoftMaxBufferMiB\":{},\"enumerationHardMaxBufferMiB\":{},\"reparsePointPolicy\":\"{}\"}}",
+                                       "\"enumerationSoftMaxBufferMiB\":{},\"enumerationHardMaxBufferMiB\":{},\"reparsePointPolicy\":\"{}\","
+                                       "\"unbufferedCopyThresholdMiB\":{},\"unbufferedCopyWriteThrough\":{},\"smallFileBatchMinFiles\":{}}}",
                                        copyMoveMaxConcurrency,
                                        deleteMaxConcurrency,
                                        deleteRecycleBinMaxConcurrency,
                                        enumerationSoftMaxBufferMiB,
                                        enumerationHardMaxBufferMiB,
-                                       ReparsePointPolicyToString(reparsePointPolicy));
+                                       ReparsePointPolicyToString(reparsePointPolicy),
+                                       unbufferedCopyThresholdMiB,
+                                       unbufferedCopyWriteThrough ? "true" : "false",
+                                       smallFileBatchMinFiles);
 
     std::lock_guard lock(_stateMutex);
 
@@ -850,6 +884,9 @@ HRESULT STDMETHODCALLTYPE FileSystem::SetConfiguration(const char* configuration
     _enumerationSoftMaxBufferMiB    = enumerationSoftMaxBufferMiB;
     _enumerationHardMaxBufferMiB    = enumerationHardMaxBufferMiB;
     _reparsePointPolicy             = reparsePointPolicy;
+    _unbufferedCopyThresholdMiB     = unbufferedCopyThresholdMiB;
+    _unbufferedCopyWriteThrough     = unbufferedCopyWriteThrough;
+    _smallFileBatchMinFiles         = smallFileBatchMinFiles;
 #ifdef _DEBUG
     _directorySizeDelayMs = directorySizeDelayMs;
 #endif
@@ -883,11 +920,27 @@ HRESULT STDMETHODCALLTYPE FileSystem::SomethingToSave(BOOL* pSomethingToSave) no
     const bool isDefault = _copyMoveMaxConcurrency == kDefaultCopyMoveMaxConcurrency && _deleteMaxConcurrency == kDefaultDeleteMaxConcurrency &&
                            _deleteRecycleBinMaxConcurrency == kDefaultDeleteRecycleBinMaxConcurrency &&
                            _enumerationSoftMaxBufferMiB == kDefaultEnumerationSoftMaxBufferMiB &&
-                           _enumerationHardMaxBufferMiB == kDefaultEnumerationHardMaxBufferMiB && _reparsePointPolicy == kDefaultReparsePointPolicy;
+                           _enumerationHardMaxBufferMiB == kDefaultEnumerationHardMaxBufferMiB && _reparsePointPolicy == kDefaultReparsePointPolicy &&
+                           _unbufferedCopyThresholdMiB == kDefaultUnbufferedCopyThresholdMiB &&
+                           _unbufferedCopyWriteThrough == kDefaultUnbufferedCopyWriteThrough &&
+                           _smallFileBatchMinFiles == kDefaultSmallFileBatchMinFiles;
     *pSomethingToSave = isDefault ? FALSE : TRUE;
     return S_OK;
 }
 
+FileSystemOperationTuning FileSystem::GetOperationTuningLocked(FileSystemOperation type) const noexcept
+{
+    constexpr uint64_t kMiB = 1024ull * 1024ull;
+
+    FileSystemOperationTuning tuning{};
+    tuning.unbufferedThresholdBytes  = static_cast<uint64_t>(_unbufferedCopyThresholdMiB) * kMiB;
+    tuning.writeThrough              = _unbufferedCopyWriteThrough;
+    tuning.smallFileBatchConcurrency = type == FILESYSTEM_DELETE ? std::clamp(_deleteMaxConcurrency, 1u, kMaxDeleteMaxConcurrency)
+                                                                 : std::clamp(_copyMoveMaxConcurrency, 1u, kMaxCopyMoveMaxConcurrency);
+    tuning.smallFileBatchMinFiles    = _smallFileBatchMinFiles;
+    return tuning;
+}
+
 void FileSystem::UpdateCapabilitiesJson() noexcept
 {
     // NOTE: Caller must hold _stateMutex.
@@ -10,13 +10,16 @@
 #include <cstdint>
 #include <cstring>
 #include <cwchar>
+#include <deque>
 #include <format>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <new>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #pragma warning(push)
@@ -37,6 +40,15 @@ enum class FileSystemReparsePointPolicy : uint8_t
     Skip,
 };
 
+// Per-call tuning (snapshot of plugin configuration taken at the start of each copy/move/delete call).
+struct FileSystemOperationTuning
+{
+    uint64_t unbufferedThresholdBytes      = 0; // 0 disables the unbuffered engine (CopyFileExW for every file)
+    bool writeThrough                      = false;
+    unsigned int smallFileBatchConcurrency = 1; // scheduler workers used for small-file batches (1 = inline on the caller)
+    unsigned long smallFileBatchMinFiles   = 0; // small files a directory needs before batch mode kicks in (0 disables)
+};
+
 class FilesInformation final : public IFilesInformation
 {
 public:
@@ -274,6 +286,31 @@ private:
         { "value": "followTargets", "label": "Follow targets (can loop / escape tree)" },
         { "value": "skip", "label": "Skip reparse points" }
       ]
+    },
+    {
+      "key": "unbufferedCopyThresholdMiB",
+      "type": "value",
+      "label": "Unbuffered copy threshold (MiB)",
+      "description": "Files at least this large are copied with aligned unbuffered overlapped I/O (several reads/writes in flight, preallocated destination, no cache pollution). 0 always uses CopyFileEx.",
+      "default": 256,
+      "min": 0,
+      "max": 1048576
+    },
+    {
+      "key": "unbufferedCopyWriteThrough",
+      "type": "bool",
+      "label": "Unbuffered copy write-through",
+      "description": "Open the destination of unbuffered copies with write-through so data reaches the device before the copy completes.",
+      "default": false
+    },
+    {
+      "key": "smallFileBatchMinFiles",
+      "type": "value",
+      "label": "Small-file batch threshold",
+      "description": "Directories with at least this many small files (<= 256 KiB) copy/delete them in batched work units with coalesced progress. 0 disables batching.",
+      "default": 32,
+      "min": 0,
+      "max": 1000000
     }
   ]
 }
@@ -285,10 +322,15 @@ private:
     static constexpr unsigned long kDefaultEnumerationSoftMaxBufferMiB       = 512ul;
     static constexpr unsigned long kDefaultEnumerationHardMaxBufferMiB       = 2048ul;
     static constexpr FileSystemReparsePointPolicy kDefaultReparsePointPolicy = FileSystemReparsePointPolicy::CopyReparse;
+    static constexpr unsigned long kDefaultUnbufferedCopyThresholdMiB        = 256ul;
+    static constexpr bool kDefaultUnbufferedCopyWriteThrough                 = false;
+    static constexpr unsigned long kDefaultSmallFileBatchMinFiles            = 32ul;
 
     static constexpr unsigned int kMaxCopyMoveMaxConcurrency         = 8u;
     static constexpr unsigned int kMaxDeleteMaxConcurrency           = 64u;
     static constexpr unsigned int kMaxDeleteRecycleBinMaxConcurrency = 16u;
+    static constexpr unsigned long kMaxUnbufferedCopyThresholdMiB    = 1048576ul;
+    static constexpr unsigned long kMaxSmallFileBatchMinFiles        = 1000000ul;
 
     PluginMetaData _metaData{};
 
@@ -308,6 +350,9 @@ private:
     unsigned long _enumerationSoftMaxBufferMiB       = kDefaultEnumerationSoftMaxBufferMiB;
     unsigned long _enumerationHardMaxBufferMiB       = kDefaultEnumerationHardMaxBufferMiB;
     FileSystemReparsePointPolicy _reparsePointPolicy = kDefaultReparsePointPolicy;
+    unsigned long _unbufferedCopyThresholdMiB        = kDefaultUnbufferedCopyThresholdMiB;
+    bool _unbufferedCopyWriteThrough                 = kDefaultUnbufferedCopyWriteThrough;
+    unsigned long _smallFileBatchMinFiles            = kDefaultSmallFileBatchMinFiles;
 #ifdef _DEBUG
     unsigned int _directorySizeDelayMs = 0u;
 #endif
@@ -348,11 +393,58 @@ private:
     HRESULT PopulateBufferHandle(FilesInformation& info, unsigned long& bytesWritten, unsigned long& entryCount, size_t& lastEntrySize) noexcept;
 
     class DirectoryWatch;
+    class DirectorySizeWalker;
+    class DirectorySizeWatchCallback;
 
     std::mutex _watchMutex;
     std::unordered_map<std::wstring, std::unique_ptr<DirectoryWatch>> _directoryWatches;
+    std::unordered_map<std::wstring, std::unique_ptr<DirectoryWatch>> _directorySizeWatches; // keyed by cache root key; guarded by _watchMutex
+
+    // Subtree totals shared by every GetDirectorySize caller (FileSystem.DirectorySize.cpp). Keys are case-folded paths
+    // without a trailing separator (drive roots keep theirs). A queried directory that no watched root covers becomes a
+    // cache root with its own recursive watch, which drops the totals of every directory above a change; roots left
+    // unqueried for a while are released together with their watch.
+    struct DirectorySizeTotals
+    {
+        uint64_t totalBytes     = 0;
+        uint64_t fileCount      = 0;
+        uint64_t directoryCount = 0;
+    };
+
+    struct DirectorySizeRoot
+    {
+        // Ordered, so a directory and its descendants ("a", "a\...") form one key range.
+        std::map<std::wstring, DirectorySizeTotals> subtrees;
+        // Changes newer than a running walk make its subtrees unsafe to store; older ones are trimmed into resetSequence.
+        std::deque<std::pair<uint64_t, std::wstring>> recentChanges;
+        std::wstring path; // long-name path the watch was opened on
+        DWORD volumeSerialNumber = 0;
+        uint64_t fileIndex       = 0;
+        uint64_t sequence        = 0;
+        uint64_t resetSequence   = 0;
+        ULONGLONG lastUsedTick   = 0;
+    };
+
+    std::mutex _directorySizeMutex;
+    std::unordered_map<std::wstring, DirectorySizeRoot> _directorySizeRoots; // keyed by cache root key
+    wil::unique_threadpool_timer _directorySizeIdleTimer;                    // created on first use; guarded by _directorySizeMutex
+
+    [[nodiscard]] bool PrepareDirectorySizeCache(const std::wstring& path, std::wstring& cacheRootKey, std::wstring& rootKey, uint64_t& sequence) noexcept;
+    [[nodiscard]] bool TryGetCachedDirectorySize(const std::wstring& cacheRootKey, const std::wstring& key, DirectorySizeTotals& totals) noexcept;
+    void StoreCachedDirectorySize(const std::wstring& cacheRootKey,
+                                  const std::wstring& key,
+                                  const DirectorySizeTotals& totals,
+                                  uint64_t sinceSequence) noexcept;
+    void ReleaseIdleDirectorySizeRoots() noexcept;
+    void ArmDirectorySizeIdleTimerLocked(ULONGLONG delayMs) noexcept;
+    HRESULT StartDirectorySizeWatch(const std::wstring& rootPath, const std::wstring& rootKey) noexcept;
+    [[nodiscard]] bool HasDirectorySizeWatch(const std::wstring& rootKey) noexcept;
+    void StopDirectorySizeWatches(const std::vector<std::wstring>& rootKeys) noexcept;
+    void OnDirectorySizeWatchChanged(const FileSystemDirectoryChangeNotification& notification) noexcept;
 
     std::atomic_ulong _refCount{1};
 
     void UpdateCapabilitiesJson() noexcept;
+    // NOTE: Caller must hold _stateMutex.
+    FileSystemOperationTuning GetOperationTuningLocked(FileSystemOperation type) const noexcept;
 };
@@ -119,135 +119,8 @@ CreateSevenZipItemFileReader(std::wstring archivePath, std::wstring password, ui
 
 // FilesInformation7z
 
-HRESULT STDMETHODCALLTYPE FilesInformation7z::QueryInterface(REFIID riid, void** ppvObject) noexcept
-{
-    if (ppvObject == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    if (riid == __uuidof(IUnknown) || riid == __uuidof(IFilesInformation))
-    {
-        *ppvObject = static_cast<IFilesInformation*>(this);
-        AddRef();
-        return S_OK;
-    }
-
-    *ppvObject = nullptr;
-    return E_NOINTERFACE;
-}
-
-ULONG STDMETHODCALLTYPE FilesInformation7z::AddRef() noexcept
-{
-    return _refCount.fetch_add(1, std::memory_order_relaxed) + 1;
-}
-
-ULONG STDMETHODCALLTYPE FilesInformation7z::Release() noexcept
-{
-    const ULONG result = _refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
-    if (result == 0)
-    {
-        delete this;
-    }
-    return result;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformation7z::GetBuffer(FileInfo** ppFileInfo) noexcept
-{
-    if (ppFileInfo == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    if (_usedBytes == 0 || _buffer.empty())
-    {
-        *ppFileInfo = nullptr;
-        return S_OK;
-    }
-
-    *ppFileInfo = reinterpret_cast<FileInfo*>(_buffer.data());
-    return S_OK;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformation7z::GetBufferSize(unsigned long* pSize) noexcept
-{
-    if (pSize == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    *pSize = _usedBytes;
-    return S_OK;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformation7z::GetAllocatedSize(unsigned long* pSize) noexcept
-{
-    if (pSize == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    if (_buffer.size() > static_cast<size_t>(std::numeric_limits<unsigned long>::max()))
-    {
-        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-    }
-
-    *pSize = static_cast<unsigned long>(_buffer.size());
-    return S_OK;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformation7z::GetCount(unsigned long* pCount) noexcept
-{
-    if (pCount == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    *pCount = _count;
-    return S_OK;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformation7z::Get(unsigned long index, FileInfo** ppEntry) noexcept
-{
-    if (ppEntry == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    *ppEntry = nullptr;
-
-    if (index >= _count)
-    {
-        return HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES);
-    }
-
-    return LocateEntry(index, ppEntry);
-}
-
-size_t FilesInformation7z::AlignUp(size_t value, size_t alignment) noexcept
-{
-    const size_t mask = alignment - 1u;
-    return (value + mask) & ~mask;
-}
-
-size_t FilesInformation7z::ComputeEntrySizeBytes(std::wstring_view name) noexcept
-{
-    const size_t baseSize = offsetof(FileInfo, FileName);
-    const size_t nameSize = name.size() * sizeof(wchar_t);
-    return AlignUp(baseSize + nameSize + sizeof(wchar_t), sizeof(unsigned long));
-}
-
 HRESULT FilesInformation7z::BuildFromEntries(std::vector<Entry> entries) noexcept
 {
-    _buffer.clear();
-    _count     = 0;
-    _usedBytes = 0;
-
-    if (entries.empty())
-    {
-        return S_OK;
-    }
-
     std::sort(entries.begin(),
               entries.end(),
               [](const Entry& a, const Entry& b)
@@ -267,100 +140,7 @@ HRESULT FilesInformation7z::BuildFromEntries(std::vector<Entry> entries) noexcep
                   return a.sizeBytes < b.sizeBytes;
               });
 
-    size_t totalBytes = 0;
-    for (const auto& entry : entries)
-    {
-        totalBytes += ComputeEntrySizeBytes(entry.name);
-        if (totalBytes > static_cast<size_t>(std::numeric_limits<unsigned long>::max()))
-        {
-            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-        }
-    }
-
-    _buffer.resize(totalBytes, std::byte{0});
-
-    std::byte* base     = _buffer.data();
-    size_t offset       = 0;
-    FileInfo* previous  = nullptr;
-    size_t previousSize = 0;
-
-    for (const auto& source : entries)
-    {
-        const size_t entrySize = ComputeEntrySizeBytes(source.name);
-        if (offset + entrySize > _buffer.size())
-        {
-            return E_FAIL;
-        }
-
-        auto* entry = reinterpret_cast<FileInfo*>(base + offset);
-        std::memset(entry, 0, entrySize);
-
-        const size_t nameBytes = source.name.size() * sizeof(wchar_t);
-        if (nameBytes > static_cast<size_t>(std::numeric_limits<unsigned long>::max()))
-        {
-            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-        }
-
-        entry->FileAttributes = static_cast<unsigned long>(source.attributes);
-        entry->EndOfFile      = static_cast<__int64>(source.sizeBytes);
-        entry->AllocationSize = static_cast<__int64>(source.sizeBytes);
-
-        entry->CreationTime   = source.lastWriteTime;
-        entry->LastAccessTime = source.lastWriteTime;
-        entry->LastWriteTime  = source.lastWriteTime;
-        entry->ChangeTime     = source.lastWriteTime;
-
-        entry->FileNameSize = static_cast<unsigned long>(nameBytes);
-        if (! source.name.empty())
-        {
-            std::memcpy(entry->FileName, source.name.data(), nameBytes);
-        }
-        entry->FileName[source.name.size()] = L'\0';
-
-        if (previous)
-        {
-            previous->NextEntryOffset = static_cast<unsigned long>(previousSize);
-        }
-
-        previous     = entry;
-        previousSize = entrySize;
-
-        offset += entrySize;
-        ++_count;
-    }
-
-    _usedBytes = static_cast<unsigned long>(_buffer.size());
-    return S_OK;
-}
-
-HRESULT FilesInformation7z::LocateEntry(unsigned long index, FileInfo** ppEntry) const noexcept
-{
-    const std::byte* base      = _buffer.data();
-    size_t offset              = 0;
-    unsigned long currentIndex = 0;
-
-    while (offset < _usedBytes && offset + sizeof(FileInfo) <= _buffer.size())
-    {
-        auto* entry = reinterpret_cast<const FileInfo*>(base + offset);
-        if (currentIndex == index)
-        {
-            *ppEntry = const_cast<FileInfo*>(entry);
-            return S_OK;
-        }
-
-        const size_t advance = (entry->NextEntryOffset != 0)
-                                   ? static_cast<size_t>(entry->NextEntryOffset)
-                                   : ComputeEntrySizeBytes(std::wstring_view(entry->FileName, static_cast<size_t>(entry->FileNameSize) / sizeof(wchar_t)));
-        if (advance == 0)
-        {
-            break;
-        }
-
-        offset += advance;
-        ++currentIndex;
-    }
-
-    return HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES);
+    return Assign(entries);
 }
 
 // FileSystem7z
@@ -23,31 +23,14 @@
 #include <wil/resource.h>
 #pragma warning(pop)
 
+#include "CompactFilesListing.h"
 #include "PlugInterfaces/DriveInfo.h"
 #include "PlugInterfaces/FileSystem.h"
 #include "PlugInterfaces/Informations.h"
 
-class FilesInformation7z final : public IFilesInformation
+class FilesInformation7z final : public CompactFilesInformationBase
 {
 public:
-    FilesInformation7z()  = default;
-    ~FilesInformation7z() = default;
-
-    FilesInformation7z(const FilesInformation7z&)            = delete;
-    FilesInformation7z(FilesInformation7z&&)                 = delete;
-    FilesInformation7z& operator=(const FilesInformation7z&) = delete;
-    FilesInformation7z& operator=(FilesInformation7z&&)      = delete;
-
-    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) noexcept override;
-    ULONG STDMETHODCALLTYPE AddRef() noexcept override;
-    ULONG STDMETHODCALLTYPE Release() noexcept override;
-
-    HRESULT STDMETHODCALLTYPE GetBuffer(FileInfo** ppFileInfo) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetBufferSize(unsigned long* pSize) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetAllocatedSize(unsigned long* pSize) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetCount(unsigned long* pCount) noexcept override;
-    HRESULT STDMETHODCALLTYPE Get(unsigned long index, FileInfo** ppEntry) noexcept override;
-
     struct Entry
     {
         std::wstring name;
@@ -56,18 +39,8 @@ public:
         int64_t lastWriteTime = 0;
     };
 
+    // Sorts by name (directories first among equal names) and replaces the listing.
     HRESULT BuildFromEntries(std::vector<Entry> entries) noexcept;
-
-private:
-    static size_t ComputeEntrySizeBytes(std::wstring_view name) noexcept;
-    static size_t AlignUp(size_t value, size_t alignment) noexcept;
-
-    HRESULT LocateEntry(unsigned long index, FileInfo** ppEntry) const noexcept;
-
-    std::atomic_ulong _refCount{1};
-    std::vector<std::byte> _buffer;
-    unsigned long _count     = 0;
-    unsigned long _usedBytes = 0;
 };
 
 class FileSystem7z final : public IFileSystem,
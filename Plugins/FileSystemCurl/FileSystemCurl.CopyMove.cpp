@@ -456,6 +456,12 @@ public:
         return S_OK;
     }
 
+    // Records a directory this operation just created, so lookups of its children skip the listing round trip.
+    void MarkEmptyDirectory(const ConnectionInfo& conn, std::wstring_view directoryPath)
+    {
+        _cache[ConnectionCacheKey(conn)][EnsureTrailingSlash(directoryPath)].clear();
+    }
+
 private:
     using DirectoryMap = std::unordered_map<std::wstring, std::vector<FilesInformationCurl::Entry>>;
     std::unordered_map<ConnectionCacheKey, DirectoryMap, ConnectionCacheKeyHash> _cache;
@@ -538,6 +544,36 @@ private:
     return RemoteDeleteFile(conn, destinationPath);
 }
 
+// Final progress for a copied file: both wire phases (download + upload) count towards the overall bytes.
+[[nodiscard]] HRESULT ReportFileCopied(FileOperationProgress& progress,
+                                       uint64_t baseCompleted,
+                                       uint64_t fileSize,
+                                       std::atomic<uint64_t>* concurrentOverallBytes,
+                                       std::wstring_view sourceFullPath,
+                                       std::wstring_view destinationFullPath) noexcept
+{
+    if (! concurrentOverallBytes)
+    {
+        uint64_t wireTotalBytes = fileSize;
+        if (wireTotalBytes > (std::numeric_limits<uint64_t>::max)() - fileSize)
+        {
+            wireTotalBytes = (std::numeric_limits<uint64_t>::max)();
+        }
+        else
+        {
+            wireTotalBytes += fileSize;
+        }
+
+        progress.completedBytes = (baseCompleted > (std::numeric_limits<uint64_t>::max)() - wireTotalBytes) ? (std::numeric_limits<uint64_t>::max)()
+                                                                                                            : (baseCompleted + wireTotalBytes);
+
+        return progress.ReportProgress(fileSize, fileSize, sourceFullPath, destinationFullPath);
+    }
+
+    return progress.ReportProgressWithCompletedBytes(
+        concurrentOverallBytes->load(std::memory_order_acquire), fileSize, fileSize, sourceFullPath, destinationFullPath);
+}
+
 [[nodiscard]] HRESULT CopyFileViaTemp(const ConnectionInfo& sourceConn,
                                       std::wstring_view sourceRemotePath,
                                       std::wstring_view sourceFullPath,
@@ -569,14 +605,33 @@ private:
         return hr;
     }
 
-    wil::unique_hfile tempFile = CreateTemporaryDeleteOnCloseFile();
+    const uint64_t baseCompleted = concurrentOverallBytes ? 0 : progress.completedBytes;
+
+    // The server may copy the file itself; otherwise it is relayed through a temp file (download, then upload).
+    hr = TryServerSideCopyFile(sourceConn, sourceRemotePath, destinationConn, destinationRemotePath, progress);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    if (hr == S_OK)
+    {
+        DiscardUploadCheckpoint(destinationConn, destinationRemotePath);
+        if (concurrentOverallBytes)
+        {
+            const uint64_t wireTotalBytes = expectedSizeBytes > (std::numeric_limits<uint64_t>::max)() / 2u ? (std::numeric_limits<uint64_t>::max)() / 2u
+                                                                                                            : expectedSizeBytes * 2u;
+            concurrentOverallBytes->fetch_add(wireTotalBytes, std::memory_order_acq_rel);
+        }
+        return ReportFileCopied(progress, baseCompleted, expectedSizeBytes, concurrentOverallBytes, sourceFullPath, destinationFullPath);
+    }
+
+    // Staged in the Resume folder: a Retry after a failed download or upload continues from the bytes already received.
+    wil::unique_hfile tempFile = OpenDownloadStagingFile(sourceConn, sourceRemotePath);
     if (! tempFile)
     {
         return HRESULT_FROM_WIN32(GetLastError());
     }
 
-    const uint64_t baseCompleted = concurrentOverallBytes ? 0 : progress.completedBytes;
-
     TransferProgressContext downloadCtx{};
     downloadCtx.progress               = &progress;
     downloadCtx.sourcePath             = sourceFullPath;
@@ -588,7 +643,7 @@ private:
     downloadCtx.scaleForCopy           = true;
     downloadCtx.scaleForCopySecond     = false;
 
-    hr = CurlDownloadToFile(sourceConn, sourceRemotePath, tempFile.get(), nullptr, &downloadCtx);
+    hr = CurlResumableDownloadToFile(sourceConn, sourceRemotePath, tempFile.get(), &downloadCtx);
     if (FAILED(hr))
     {
         return hr;
@@ -625,43 +680,14 @@ private:
     uploadCtx.scaleForCopy           = true;
     uploadCtx.scaleForCopySecond     = true;
 
-    hr = CurlUploadFromFile(destinationConn, destinationRemotePath, tempFile.get(), fileSize, nullptr, &uploadCtx);
+    hr = CurlResumableUploadFromFile(destinationConn, destinationRemotePath, tempFile.get(), fileSize, &uploadCtx);
     if (FAILED(hr))
     {
         return hr;
     }
 
-    if (! concurrentOverallBytes)
-    {
-        uint64_t wireTotalBytes = fileSize;
-        if (wireTotalBytes > (std::numeric_limits<uint64_t>::max)() - fileSize)
-        {
-            wireTotalBytes = (std::numeric_limits<uint64_t>::max)();
-        }
-        else
-        {
-            wireTotalBytes += fileSize;
-        }
-
-        progress.completedBytes = (baseCompleted > (std::numeric_limits<uint64_t>::max)() - wireTotalBytes) ? (std::numeric_limits<uint64_t>::max)()
-                                                                                                            : (baseCompleted + wireTotalBytes);
-
-        hr = progress.ReportProgress(fileSize, fileSize, sourceFullPath, destinationFullPath);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-    }
-    else
-    {
-        hr = progress.ReportProgressWithCompletedBytes(
-            concurrentOverallBytes->load(std::memory_order_acquire), fileSize, fileSize, sourceFullPath, destinationFullPath);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-    }
-    return S_OK;
+    ReleaseDownloadStagingFile(sourceConn, sourceRemotePath, tempFile.get());
+    return ReportFileCopied(progress, baseCompleted, fileSize, concurrentOverallBytes, sourceFullPath, destinationFullPath);
 }
 
 [[nodiscard]] HRESULT CopyDirectoryRecursive(const ConnectionInfo& sourceConn,
@@ -746,6 +772,495 @@ private:
     return S_OK;
 }
 
+[[nodiscard]] unsigned int CopyPipelineWindow(const ConnectionInfo& destinationConn) noexcept
+{
+    // Twice the endpoint limit keeps every connection busy while the walker lists the next directory.
+    constexpr unsigned int kMaxWindow = 64u;
+    return std::clamp(destinationConn.maxConnectionsPerHost * 2u, 2u, kMaxWindow);
+}
+
+// Remote -> remote copy pipeline on the shared curl_multi engine (used when the destination enables multiTransferEngine).
+// The calling thread walks directories and resolves overwrite targets against a per-operation listing cache; each file
+// is a download -> upload chain of easy handles completed on the engine loop threads, so up to `window` files are in
+// flight without a worker thread per file. Files belong to a group (one per top-level item): a group completes once its
+// walk is sealed and its last file finished, and its walk stops queueing after the first failure.
+class CopyPipeline final
+{
+public:
+    class Group final
+    {
+    public:
+        explicit Group(std::function<void(HRESULT)> onComplete) noexcept : _onComplete(std::move(onComplete))
+        {
+        }
+
+        Group(const Group&)            = delete;
+        Group(Group&&)                 = delete;
+        Group& operator=(const Group&) = delete;
+        Group& operator=(Group&&)      = delete;
+
+        void RecordFailure(HRESULT hr) noexcept
+        {
+            if (SUCCEEDED(hr))
+            {
+                return;
+            }
+
+            long expected = S_OK;
+            static_cast<void>(_firstFailure.compare_exchange_strong(expected, static_cast<long>(hr), std::memory_order_acq_rel));
+        }
+
+        [[nodiscard]] HRESULT Result() const noexcept
+        {
+            return static_cast<HRESULT>(_firstFailure.load(std::memory_order_acquire));
+        }
+
+    private:
+        friend class CopyPipeline;
+
+        void AddRef() noexcept
+        {
+            _outstanding.fetch_add(1u, std::memory_order_acq_rel);
+        }
+
+        void Release() noexcept
+        {
+            if (_outstanding.fetch_sub(1u, std::memory_order_acq_rel) == 1u && _onComplete)
+            {
+                _onComplete(Result());
+            }
+        }
+
+        std::function<void(HRESULT)> _onComplete;
+        std::atomic<long> _firstFailure{S_OK};
+        std::atomic<size_t> _outstanding{1}; // the walker's reference, dropped by Seal
+    };
+
+    CopyPipeline(FileOperationProgress& progress, std::atomic<uint64_t>& overallBytes, FileSystemFlags flags, unsigned int window) noexcept
+        : _progress(progress),
+          _overallBytes(overallBytes),
+          _allowOverwrite(HasFlag(flags, FILESYSTEM_FLAG_ALLOW_OVERWRITE)),
+          _window(std::max(1u, window)),
+          _laneBusy(_window, false)
+    {
+    }
+
+    CopyPipeline(const CopyPipeline&)            = delete;
+    CopyPipeline(CopyPipeline&&)                 = delete;
+    CopyPipeline& operator=(const CopyPipeline&) = delete;
+    CopyPipeline& operator=(CopyPipeline&&)      = delete;
+
+    ~CopyPipeline()
+    {
+        Drain();
+    }
+
+    [[nodiscard]] FileOperationProgress& Progress() noexcept
+    {
+        return _progress;
+    }
+
+    // Walker thread only; the group lives as long as the pipeline.
+    [[nodiscard]] Group& CreateGroup(std::function<void(HRESULT)> onComplete)
+    {
+        _groups.push_back(std::make_unique<Group>(std::move(onComplete)));
+        return *_groups.back();
+    }
+
+    // Ends the walk for `group`; it completes now if none of its files are still in flight.
+    void Seal(Group& group) noexcept
+    {
+        group.Release();
+    }
+
+    [[nodiscard]] HRESULT EnsureDirectory(const ConnectionInfo& conn, std::wstring_view directoryPath) noexcept
+    {
+        const HRESULT hr = RemoteMkdir(conn, directoryPath);
+        if (SUCCEEDED(hr))
+        {
+            _destinationCache.MarkEmptyDirectory(conn, directoryPath);
+            return S_OK;
+        }
+
+        FilesInformationCurl::Entry existing{};
+        const HRESULT existsHr = _destinationCache.GetEntryInfoCached(conn, directoryPath, existing);
+        if (SUCCEEDED(existsHr) && (existing.attributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+        {
+            return S_OK;
+        }
+
+        return hr;
+    }
+
+    // Queues one file copy; blocks while `window` files are in flight. Returns a failure only when the file could not be
+    // queued; transfer failures are recorded on the group.
+    [[nodiscard]] HRESULT EnqueueFile(Group& group,
+                                      const ConnectionInfo& sourceConn,
+                                      std::wstring_view sourceRemotePath,
+                                      std::wstring_view sourceDisplayPath,
+                                      const ConnectionInfo& destinationConn,
+                                      std::wstring_view destinationRemotePath,
+                                      std::wstring_view destinationDisplayPath,
+                                      uint64_t expectedSizeBytes) noexcept
+    {
+        HRESULT hr = _progress.CheckCancel();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // An interrupted upload of this destination continues on the walker thread instead of starting over.
+        if (HasUploadCheckpoint(destinationConn, destinationRemotePath))
+        {
+            const FileSystemFlags flags = _allowOverwrite ? FILESYSTEM_FLAG_ALLOW_OVERWRITE : FILESYSTEM_FLAG_NONE;
+
+            hr = CopyFileViaTemp(sourceConn,
+                                 sourceRemotePath,
+                                 sourceDisplayPath,
+                                 destinationConn,
+                                 destinationRemotePath,
+                                 destinationDisplayPath,
+                                 flags,
+                                 _progress,
+                                 expectedSizeBytes,
+                                 &_overallBytes);
+            group.RecordFailure(hr);
+            return S_OK;
+        }
+
+        hr = EnsureOverwriteTarget(destinationConn, destinationRemotePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        auto job                    = std::make_unique<FileJob>();
+        job->group                  = &group;
+        job->sourceConn             = sourceConn;
+        job->sourceRemotePath       = sourceRemotePath;
+        job->sourceDisplayPath      = sourceDisplayPath;
+        job->destinationConn        = destinationConn;
+        job->destinationRemotePath  = destinationRemotePath;
+        job->destinationDisplayPath = destinationDisplayPath;
+        job->expectedSizeBytes      = expectedSizeBytes;
+
+        job->tempFile = CreateTemporaryDeleteOnCloseFile();
+        if (! job->tempFile)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        job->curl.reset(curl_easy_init());
+        if (! job->curl)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        FileJob& queued = *job;
+        {
+            std::unique_lock lock(_mutex);
+            _cv.wait(lock, [&]() noexcept { return _jobs.size() < _window; });
+
+            const auto freeLane = std::find(_laneBusy.begin(), _laneBusy.end(), false);
+            queued.lane         = static_cast<uint64_t>(std::distance(_laneBusy.begin(), freeLane));
+            *freeLane           = true;
+            _jobs.push_back(std::move(job));
+        }
+
+        group.AddRef();
+
+        hr = StartDownload(queued);
+        if (FAILED(hr))
+        {
+            Finish(queued, hr);
+        }
+        return S_OK;
+    }
+
+    void Drain() noexcept
+    {
+        std::unique_lock lock(_mutex);
+        _cv.wait(lock, [&]() noexcept { return _jobs.empty(); });
+    }
+
+private:
+    struct FileJob final
+    {
+        Group* group = nullptr;
+
+        ConnectionInfo sourceConn{};
+        std::wstring sourceRemotePath;
+        std::wstring sourceDisplayPath;
+        ConnectionInfo destinationConn{};
+        std::wstring destinationRemotePath;
+        std::wstring destinationDisplayPath;
+        uint64_t expectedSizeBytes = 0;
+        uint64_t fileSize          = 0;
+        uint64_t lane              = 0;
+
+        wil::unique_hfile tempFile;
+        unique_curl_easy curl;
+        TransferProgressContext transferCtx{};
+    };
+
+    // Same policy as EnsureOverwriteTargetFile, but lookups share one listing per destination directory.
+    [[nodiscard]] HRESULT EnsureOverwriteTarget(const ConnectionInfo& conn, std::wstring_view destinationPath) noexcept
+    {
+        FilesInformationCurl::Entry existing{};
+        const HRESULT existsHr = _destinationCache.GetEntryInfoCached(conn, destinationPath, existing);
+        if (FAILED(existsHr))
+        {
+            return existsHr == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND) ? S_OK : existsHr;
+        }
+
+        if (! _allowOverwrite || (existing.attributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_EXISTS);
+        }
+
+        return RemoteDeleteFile(conn, destinationPath);
+    }
+
+    [[nodiscard]] HRESULT StartDownload(FileJob& job) noexcept
+    {
+        FileOperationProgress::ProgressStreamScope streamScope(job.lane);
+
+        HRESULT hr = _progress.ReportProgressWithCompletedBytes(
+            _overallBytes.load(std::memory_order_acquire), job.expectedSizeBytes, 0, job.sourceDisplayPath, job.destinationDisplayPath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        TransferProgressContext& ctx = job.transferCtx;
+        ctx.progress                 = &_progress;
+        ctx.sourcePath               = job.sourceDisplayPath;
+        ctx.destinationPath          = job.destinationDisplayPath;
+        ctx.concurrentOverallBytes   = &_overallBytes;
+        ctx.itemTotalBytes           = job.expectedSizeBytes;
+        ctx.isUpload                 = false;
+        ctx.scaleForCopy             = true;
+        ctx.scaleForCopySecond       = false;
+        ctx.progressStreamId         = job.lane;
+
+        hr = PrepareCurlDownload(job.curl.get(), job.sourceConn, job.sourceRemotePath, job.tempFile.get(), nullptr, &ctx);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return CurlMultiSubmit(job.sourceConn, job.curl.get(), &ctx, [this, &job](CURLcode code) noexcept { OnDownloadDone(job, code); });
+    }
+
+    void OnDownloadDone(FileJob& job, CURLcode code) noexcept
+    {
+        HRESULT hr = HResultFromTransfer(code, &job.transferCtx);
+        if (SUCCEEDED(hr))
+        {
+            hr = GetFileSizeBytes(job.tempFile.get(), job.fileSize);
+        }
+        if (SUCCEEDED(hr))
+        {
+            // A failed upload leaves the checkpoint behind, so the retry of this file resumes on the item path.
+            RecordUploadStart(job.destinationConn, job.destinationRemotePath, job.tempFile.get(), job.fileSize);
+            hr = ResetFilePointerToStart(job.tempFile.get());
+        }
+        if (SUCCEEDED(hr))
+        {
+            hr = _progress.CheckCancel();
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            curl_easy_reset(job.curl.get());
+
+            TransferProgressContext& ctx = job.transferCtx;
+            ctx                          = {};
+            ctx.progress                 = &_progress;
+            ctx.sourcePath               = job.sourceDisplayPath;
+            ctx.destinationPath          = job.destinationDisplayPath;
+            ctx.concurrentOverallBytes   = &_overallBytes;
+            ctx.lastConcurrentWireDone   = job.fileSize;
+            ctx.itemTotalBytes           = job.fileSize;
+            ctx.isUpload                 = true;
+            ctx.scaleForCopy             = true;
+            ctx.scaleForCopySecond       = true;
+            ctx.progressStreamId         = job.lane;
+
+            hr = PrepareCurlUpload(job.curl.get(), job.destinationConn, job.destinationRemotePath, job.tempFile.get(), job.fileSize, nullptr, &ctx);
+            if (SUCCEEDED(hr))
+            {
+                hr = CurlMultiSubmit(job.destinationConn, job.curl.get(), &ctx, [this, &job](CURLcode uploadCode) noexcept { OnUploadDone(job, uploadCode); });
+            }
+            if (SUCCEEDED(hr))
+            {
+                return;
+            }
+        }
+
+        Finish(job, hr);
+    }
+
+    void OnUploadDone(FileJob& job, CURLcode code) noexcept
+    {
+        InvalidateCachedParentListing(job.destinationConn, job.destinationRemotePath);
+
+        HRESULT hr = HResultFromTransfer(code, &job.transferCtx);
+        if (SUCCEEDED(hr))
+        {
+            DiscardUploadCheckpoint(job.destinationConn, job.destinationRemotePath);
+
+            FileOperationProgress::ProgressStreamScope streamScope(job.lane);
+            hr = _progress.ReportProgressWithCompletedBytes(
+                _overallBytes.load(std::memory_order_acquire), job.fileSize, job.fileSize, job.sourceDisplayPath, job.destinationDisplayPath);
+        }
+
+        Finish(job, hr);
+    }
+
+    void Finish(FileJob& job, HRESULT hr) noexcept
+    {
+        Group& group = *job.group;
+        group.RecordFailure(hr);
+        group.Release();
+
+        // Notify under the lock: once `_jobs` drains, the walker may destroy the pipeline.
+        std::scoped_lock lock(_mutex);
+        _laneBusy[static_cast<size_t>(job.lane)] = false;
+        const auto found = std::find_if(_jobs.begin(), _jobs.end(), [&](const std::unique_ptr<FileJob>& item) noexcept { return item.get() == &job; });
+        if (found != _jobs.end())
+        {
+            _jobs.erase(found);
+        }
+        _cv.notify_all();
+    }
+
+    FileOperationProgress& _progress;
+    std::atomic<uint64_t>& _overallBytes;
+    const bool _allowOverwrite = false;
+    const unsigned int _window = 1;
+
+    // Walker thread only.
+    DirectoryEntryCache _destinationCache;
+    std::vector<std::unique_ptr<Group>> _groups;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<std::unique_ptr<FileJob>> _jobs;
+    std::vector<bool> _laneBusy;
+};
+
+[[nodiscard]] HRESULT QueueDirectoryCopy(CopyPipeline& pipeline,
+                                         CopyPipeline::Group& group,
+                                         const ConnectionInfo& sourceConn,
+                                         std::wstring_view sourceRemoteDir,
+                                         std::wstring_view sourceFullDir,
+                                         const ConnectionInfo& destinationConn,
+                                         std::wstring_view destinationRemoteDir,
+                                         std::wstring_view destinationFullDir,
+                                         FileSystemFlags flags) noexcept
+{
+    HRESULT hr = pipeline.EnsureDirectory(destinationConn, destinationRemoteDir);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    std::vector<FilesInformationCurl::Entry> entries;
+    hr = ReadDirectoryEntries(sourceConn, sourceRemoteDir, entries);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    for (const auto& entry : entries)
+    {
+        if (IsDotOrDotDotName(entry.name))
+        {
+            continue;
+        }
+
+        // Stop walking once a queued file of this item failed (CopyDirectoryRecursive stops at the first failure too).
+        hr = group.Result();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = pipeline.Progress().CheckCancel();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        const std::wstring sourceChildRemote      = JoinPluginPath(sourceRemoteDir, entry.name);
+        const std::wstring destinationChildRemote = JoinPluginPath(destinationRemoteDir, entry.name);
+        const std::wstring sourceChildFull        = JoinDisplayPath(sourceFullDir, entry.name);
+        const std::wstring destinationChildFull   = JoinDisplayPath(destinationFullDir, entry.name);
+
+        if ((entry.attributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+        {
+            if (! HasFlag(flags, FILESYSTEM_FLAG_RECURSIVE))
+            {
+                return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+            }
+
+            hr = QueueDirectoryCopy(pipeline,
+                                    group,
+                                    sourceConn,
+                                    EnsureTrailingSlash(sourceChildRemote),
+                                    EnsureTrailingSlashDisplay(sourceChildFull),
+                                    destinationConn,
+                                    EnsureTrailingSlash(destinationChildRemote),
+                                    EnsureTrailingSlashDisplay(destinationChildFull),
+                                    flags);
+        }
+        else
+        {
+            hr = pipeline.EnqueueFile(
+                group, sourceConn, sourceChildRemote, sourceChildFull, destinationConn, destinationChildRemote, destinationChildFull, entry.sizeBytes);
+        }
+
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+    }
+
+    return S_OK;
+}
+
+// Copies one directory tree for the single-item entry points: pipelined on the curl_multi engine when the destination
+// enables it, otherwise file by file (also when the pair can copy server-side, which the pipeline does not attempt).
+[[nodiscard]] HRESULT CopyDirectoryTree(const ConnectionInfo& sourceConn,
+                                        std::wstring_view sourceRemoteDir,
+                                        std::wstring_view sourceFullDir,
+                                        const ConnectionInfo& destinationConn,
+                                        std::wstring_view destinationRemoteDir,
+                                        std::wstring_view destinationFullDir,
+                                        FileSystemFlags flags,
+                                        FileOperationProgress& progress) noexcept
+{
+    if (! destinationConn.multiTransferEngine || IsServerSideCopyCandidate(sourceConn, destinationConn))
+    {
+        return CopyDirectoryRecursive(
+            sourceConn, sourceRemoteDir, sourceFullDir, destinationConn, destinationRemoteDir, destinationFullDir, flags, progress, nullptr);
+    }
+
+    std::atomic<uint64_t> overallBytes{progress.completedBytes};
+    {
+        CopyPipeline pipeline(progress, overallBytes, flags, CopyPipelineWindow(destinationConn));
+        CopyPipeline::Group& group = pipeline.CreateGroup({});
+        group.RecordFailure(QueueDirectoryCopy(
+            pipeline, group, sourceConn, sourceRemoteDir, sourceFullDir, destinationConn, destinationRemoteDir, destinationFullDir, flags));
+        pipeline.Seal(group);
+        pipeline.Drain();
+
+        progress.completedBytes = overallBytes.load(std::memory_order_acquire);
+        return group.Result();
+    }
+}
+
 [[nodiscard]] HRESULT DeleteDirectoryRecursive(const ConnectionInfo& conn,
                                                std::wstring_view directoryRemotePath,
                                                std::wstring_view directoryFullPath,
@@ -836,6 +1351,7 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::CopyItem(const wchar_t* sourcePath,
         settings = _settings;
     }
 
+    ServerCopyTallyScope tallyScope;
     FileOperationProgress progress{};
     HRESULT hr = progress.Initialize(FILESYSTEM_COPY, 1, options, callback, cookie);
     if (FAILED(hr))
@@ -888,15 +1404,14 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::CopyItem(const wchar_t* sourcePath,
             hr = EnsureDirectoryExists(destinationResolved.connection, destinationResolved.remotePath);
             if (SUCCEEDED(hr))
             {
-                hr = CopyDirectoryRecursive(sourceResolved.connection,
-                                            EnsureTrailingSlash(sourceResolved.remotePath),
-                                            EnsureTrailingSlashDisplay(sourceDisplay),
-                                            destinationResolved.connection,
-                                            EnsureTrailingSlash(destinationResolved.remotePath),
-                                            EnsureTrailingSlashDisplay(destinationDisplay),
-                                            flags,
-                                            progress,
-                                            nullptr);
+                hr = CopyDirectoryTree(sourceResolved.connection,
+                                       EnsureTrailingSlash(sourceResolved.remotePath),
+                                       EnsureTrailingSlashDisplay(sourceDisplay),
+                                       destinationResolved.connection,
+                                       EnsureTrailingSlash(destinationResolved.remotePath),
+                                       EnsureTrailingSlashDisplay(destinationDisplay),
+                                       flags,
+                                       progress);
             }
         }
     }
@@ -915,7 +1430,7 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::CopyItem(const wchar_t* sourcePath,
     }
 
     progress.completedItems = 1;
-    const HRESULT cbHr      = progress.ReportItemCompleted(0, sourceDisplay, destinationDisplay, hr);
+    const HRESULT cbHr      = progress.ReportItemCompleted(0, sourceDisplay, destinationDisplay, ServerCopyTallyScope::ItemStatus(hr));
     return FAILED(cbHr) ? cbHr : hr;
 }
 
@@ -942,6 +1457,7 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::MoveItem(const wchar_t* sourcePath,
         settings = _settings;
     }
 
+    ServerCopyTallyScope tallyScope;
     FileOperationProgress progress{};
     HRESULT hr = progress.Initialize(FILESYSTEM_MOVE, 1, options, callback, cookie);
     if (FAILED(hr))
@@ -1003,15 +1519,14 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::MoveItem(const wchar_t* sourcePath,
                 }
                 else
                 {
-                    hr = CopyDirectoryRecursive(sourceResolved.connection,
-                                                EnsureTrailingSlash(sourceResolved.remotePath),
-                                                EnsureTrailingSlashDisplay(sourceDisplay),
-                                                destinationResolved.connection,
-                                                EnsureTrailingSlash(destinationResolved.remotePath),
-                                                EnsureTrailingSlashDisplay(destinationDisplay),
-                                                flags,
-                                                progress,
-                                                nullptr);
+                    hr = CopyDirectoryTree(sourceResolved.connection,
+                                           EnsureTrailingSlash(sourceResolved.remotePath),
+                                           EnsureTrailingSlashDisplay(sourceDisplay),
+                                           destinationResolved.connection,
+                                           EnsureTrailingSlash(destinationResolved.remotePath),
+                                           EnsureTrailingSlashDisplay(destinationDisplay),
+                                           flags,
+                                           progress);
                     if (SUCCEEDED(hr))
                     {
                         hr = DeleteDirectoryRecursive(sourceResolved.connection, sourceResolved.remotePath, sourceDisplay, FILESYSTEM_FLAG_RECURSIVE, progress);
@@ -1039,7 +1554,7 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::MoveItem(const wchar_t* sourcePath,
     }
 
     progress.completedItems = 1;
-    const HRESULT cbHr      = progress.ReportItemCompleted(0, sourceDisplay, destinationDisplay, hr);
+    const HRESULT cbHr      = progress.ReportItemCompleted(0, sourceDisplay, destinationDisplay, ServerCopyTallyScope::ItemStatus(hr));
     return FAILED(cbHr) ? cbHr : hr;
 }
 
@@ -1353,6 +1868,28 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::CopyItems(const wchar_t* const* source
 
     const unsigned int concurrency = std::max(1u, static_cast<unsigned int>(desiredParallelism));
 
+    const auto completeTask = [&](const CopyTask& task, HRESULT itemHr) noexcept
+    {
+        if (FAILED(itemHr))
+        {
+            recordFailure(itemHr);
+            if (! continueOnError || NormalizeCancellation(itemHr) == HRESULT_FROM_WIN32(ERROR_CANCELLED))
+            {
+                progress.internalCancel.store(true, std::memory_order_release);
+            }
+        }
+
+        const unsigned long done = completedCount.fetch_add(1u, std::memory_order_acq_rel) + 1u;
+        progress.SetCompletedItems(done);
+
+        const HRESULT cbHr = progress.ReportItemCompleted(task.index, task.sourceDisplayPath, task.destinationDisplayPath, itemHr);
+        if (FAILED(cbHr))
+        {
+            recordFailure(cbHr);
+            progress.internalCancel.store(true, std::memory_order_release);
+        }
+    };
+
     const auto processTask = [&](size_t taskIndex, uint64_t schedulerStreamId) noexcept
     {
         if (taskIndex >= tasks.size())
@@ -1369,6 +1906,7 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::CopyItems(const wchar_t* const* source
         FileOperationProgress::ProgressStreamScope streamScope(progressStreamId);
 
         const CopyTask& task = tasks[taskIndex];
+        ServerCopyTallyScope tallyScope;
 
         HRESULT itemHr = progress.CheckCancel();
         if (SUCCEEDED(itemHr))
@@ -1407,33 +1945,64 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::CopyItems(const wchar_t* const* source
             }
         }
 
-        if (FAILED(itemHr))
+        completeTask(task, ServerCopyTallyScope::ItemStatus(itemHr));
+    };
+
+    // Server-side copies run on the item workers: the pipeline only relays data through this process.
+    const bool serverSideCopy = std::any_of(
+        tasks.begin(), tasks.end(), [&](const CopyTask& task) noexcept { return IsServerSideCopyCandidate(task.sourceConn, destinationResolved.connection); });
+
+    if (destinationResolved.connection.multiTransferEngine && ! serverSideCopy)
+    {
+        // The calling thread walks the items and queues their files; completions run on the curl_multi loop threads.
+        CopyPipeline pipeline(progress, overallBytes, flags, CopyPipelineWindow(destinationResolved.connection));
+        for (const CopyTask& task : tasks)
         {
-            recordFailure(itemHr);
-            if (! continueOnError || NormalizeCancellation(itemHr) == HRESULT_FROM_WIN32(ERROR_CANCELLED))
+            if (progress.internalCancel.load(std::memory_order_acquire))
             {
-                progress.internalCancel.store(true, std::memory_order_release);
+                break;
             }
-        }
 
-        const unsigned long done = completedCount.fetch_add(1u, std::memory_order_acq_rel) + 1u;
-        progress.SetCompletedItems(done);
+            CopyPipeline::Group& group = pipeline.CreateGroup([&completeTask, &task](HRESULT itemHr) noexcept { completeTask(task, itemHr); });
 
-        const HRESULT cbHr = progress.ReportItemCompleted(task.index, task.sourceDisplayPath, task.destinationDisplayPath, itemHr);
-        if (FAILED(cbHr))
-        {
-            recordFailure(cbHr);
-            progress.internalCancel.store(true, std::memory_order_release);
-            return;
-        }
+            HRESULT walkHr = progress.CheckCancel();
+            if (SUCCEEDED(walkHr))
+            {
+                if (! task.isDirectory)
+                {
+                    walkHr = pipeline.EnqueueFile(group,
+                                                  task.sourceConn,
+                                                  task.sourceRemotePath,
+                                                  task.sourceDisplayPath,
+                                                  destinationResolved.connection,
+                                                  task.destinationRemotePath,
+                                                  task.destinationDisplayPath,
+                                                  task.expectedSizeBytes);
+                }
+                else if (! HasFlag(flags, FILESYSTEM_FLAG_RECURSIVE))
+                {
+                    walkHr = HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+                }
+                else
+                {
+                    walkHr = QueueDirectoryCopy(pipeline,
+                                                group,
+                                                task.sourceConn,
+                                                EnsureTrailingSlash(task.sourceRemotePath),
+                                                EnsureTrailingSlashDisplay(task.sourceDisplayPath),
+                                                destinationResolved.connection,
+                                                EnsureTrailingSlash(task.destinationRemotePath),
+                                                EnsureTrailingSlashDisplay(task.destinationDisplayPath),
+                                                flags);
+                }
+            }
 
-        if (FAILED(itemHr) && ! continueOnError)
-        {
-            return;
+            group.RecordFailure(walkHr);
+            pipeline.Seal(group);
         }
-    };
-
-    if (concurrency <= 1u)
+        pipeline.Drain();
+    }
+    else if (concurrency <= 1u)
     {
         for (size_t i = 0; i < tasks.size(); ++i)
         {
@@ -1529,6 +2098,7 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::MoveItems(const wchar_t* const* source
             return hr;
         }
 
+        ServerCopyTallyScope tallyScope;
         ResolvedLocation sourceResolved{};
         HRESULT itemHr = ResolveLocation(_protocol, settings, source, _hostConnections.get(), true, sourceResolved);
         if (SUCCEEDED(itemHr))
@@ -1559,15 +2129,14 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::MoveItems(const wchar_t* const* source
                         }
                         else
                         {
-                            itemHr = CopyDirectoryRecursive(sourceResolved.connection,
-                                                            EnsureTrailingSlash(sourceResolved.remotePath),
-                                                            EnsureTrailingSlashDisplay(sourceDisplay),
-                                                            destinationResolved.connection,
-                                                            EnsureTrailingSlash(destinationRemote),
-                                                            EnsureTrailingSlashDisplay(destDisplay),
-                                                            flags,
-                                                            progress,
-                                                            nullptr);
+                            itemHr = CopyDirectoryTree(sourceResolved.connection,
+                                                       EnsureTrailingSlash(sourceResolved.remotePath),
+                                                       EnsureTrailingSlashDisplay(sourceDisplay),
+                                                       destinationResolved.connection,
+                                                       EnsureTrailingSlash(destinationRemote),
+                                                       EnsureTrailingSlashDisplay(destDisplay),
+                                                       flags,
+                                                       progress);
                             if (SUCCEEDED(itemHr))
                             {
                                 itemHr = DeleteDirectoryRecursive(
@@ -1597,7 +2166,7 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::MoveItems(const wchar_t* const* source
         }
 
         progress.completedItems = index + 1u;
-        const HRESULT cbHr      = progress.ReportItemCompleted(index, sourceDisplay, destDisplay, itemHr);
+        const HRESULT cbHr      = progress.ReportItemCompleted(index, sourceDisplay, destDisplay, ServerCopyTallyScope::ItemStatus(itemHr));
         if (FAILED(cbHr))
         {
             return cbHr;
@@ -303,7 +303,7 @@ public:
                                                   return overwriteHr;
                                               }
 
-                                              return CurlUploadFromFile(resolved.connection, resolved.remotePath, _file.get(), sizeBytes, nullptr, nullptr);
+                                              return CurlResumableUploadFromFile(resolved.connection, resolved.remotePath, _file.get(), sizeBytes, nullptr);
                                           });
         if (FAILED(hr))
         {
@@ -667,6 +667,11 @@ private:
             return;
         }
 
+        // A dropped connection continues after the bytes already handed to the buffer (same seek generation only).
+        unsigned int failedAttempts = 0;
+        uint64_t resumeGen          = (std::numeric_limits<uint64_t>::max)();
+        uint64_t resumeOffset       = 0;
+
         for (;;)
         {
             if (_stopping.load(std::memory_order_acquire) || stopToken.stop_requested())
@@ -683,7 +688,7 @@ private:
             uint64_t startOffset = 0;
             {
                 std::scoped_lock lock(_mutex);
-                startOffset = _positionBytes;
+                startOffset = gen == resumeGen ? resumeOffset : _positionBytes;
             }
 
             const std::string url = BuildUrl(_conn, _remotePath, false, false);
@@ -729,6 +734,7 @@ private:
             }
 
             const CURLcode code = curl_easy_perform(curl.get());
+            ObserveSftpTransfer(_conn, curl.get(), code);
 
             if (_stopping.load(std::memory_order_acquire) || stopToken.stop_requested())
             {
@@ -762,6 +768,25 @@ private:
                 continue;
             }
 
+            uint64_t received = 0;
+            {
+                std::scoped_lock lock(_mutex);
+                received = _positionBytes + _bufferedBytes;
+            }
+
+            if (gen != resumeGen || received > resumeOffset)
+            {
+                failedAttempts = 0;
+            }
+
+            if (ShouldResumeTransfer(_conn, code, failedAttempts))
+            {
+                Debug::Info(L"FileSystemCurl: read of '{}' failed ({}); resuming at {} bytes", _remotePath, static_cast<int>(code), received);
+                resumeGen    = gen;
+                resumeOffset = received;
+                continue;
+            }
+
             const HRESULT hr = HResultFromCurl(code);
             std::scoped_lock lock(_mutex);
             _workerHr = hr;
@@ -898,6 +923,23 @@ public:
             return E_POINTER;
         }
 
+        // The first block identifies the source when a later attempt resumes this destination.
+        bool headComplete = false;
+        {
+            std::scoped_lock lock(_mutex);
+            if (_headBytes < kResumeBlockBytes)
+            {
+                const size_t take = static_cast<size_t>(std::min<uint64_t>(kResumeBlockBytes - _headBytes, bytesToWrite));
+                _headHash         = HashResumeBlock(_headHash, buffer, take);
+                _headBytes += take;
+                headComplete = _headBytes == kResumeBlockBytes;
+            }
+        }
+        if (headComplete)
+        {
+            RecordStreamedUploadStart(_conn, _remotePath, _headHash, _headBytes);
+        }
+
         size_t offset = 0;
         while (offset < bytesToWrite)
         {
@@ -1129,6 +1171,8 @@ private:
         ApplyCommonCurlOptions(curl.get(), _conn, nullptr, true);
 
         const CURLcode code = curl_easy_perform(curl.get());
+        ObserveSftpTransfer(_conn, curl.get(), code);
+        InvalidateCachedParentListing(_conn, _remotePath);
 
         if (_stopping.load(std::memory_order_acquire) || stopToken.stop_requested())
         {
@@ -1138,6 +1182,23 @@ private:
             return;
         }
 
+        // Record what the server kept before reporting the failure: a retry may start as soon as it is reported.
+        if (code == CURLE_OK)
+        {
+            DiscardUploadCheckpoint(_conn, _remotePath);
+        }
+        else
+        {
+            uint64_t headHash  = 0;
+            uint64_t headBytes = 0;
+            {
+                std::scoped_lock lock(_mutex);
+                headHash  = _headHash;
+                headBytes = _headBytes;
+            }
+            RecordStreamedUploadFailure(_conn, _remotePath, headHash, headBytes);
+        }
+
         const HRESULT hr = HResultFromCurl(code);
         std::scoped_lock lock(_mutex);
         _workerHr = hr;
@@ -1162,6 +1223,9 @@ private:
 
     uint64_t _positionBytes = 0;
 
+    uint64_t _headHash  = kResumeHashSeed;
+    uint64_t _headBytes = 0;
+
     std::atomic_bool _stopping{false};
     bool _closedForWrite = false;
     bool _committed      = false;
@@ -1191,20 +1255,44 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::ReadDirectoryInfo(const wchar_t* path,
         settings = _settings;
     }
 
+    // Persistent listing cache: serve a hit without touching the server and revalidate it in the background; watchers
+    // registered through IFileSystemDirectoryWatch get an overflow notification if the folder turned out to differ.
+    CachedListing cached;
+    ResolvedLocation cacheLocation{};
+    const bool cacheHit = settings.persistentListingCache && _protocol != FileSystemCurlProtocol::Imap &&
+                          SUCCEEDED(ResolveLocation(_protocol, settings, path, _hostConnections.get(), false, cacheLocation)) &&
+                          LoadCachedListing(cacheLocation.connection, cacheLocation.remotePath, cached);
+
     std::vector<FilesInformationCurl::Entry> entries;
-    const HRESULT hr = ResolveLocationWithAuthRetry(_protocol,
-                                                    settings,
-                                                    path,
-                                                    _hostConnections.get(),
-                                                    true,
-                                                    [&](const ResolvedLocation& resolved) noexcept
-                                                    {
-                                                        entries.clear();
-                                                        return ReadDirectoryEntries(resolved.connection, resolved.remotePath, entries);
-                                                    });
-    if (FAILED(hr))
+    if (cacheHit)
     {
-        return hr;
+        entries = std::move(cached.entries);
+        if (cached.needsRevalidation)
+        {
+            QueueListingRevalidation(path);
+        }
+    }
+    else
+    {
+        const HRESULT hr = ResolveLocationWithAuthRetry(_protocol,
+                                                        settings,
+                                                        path,
+                                                        _hostConnections.get(),
+                                                        true,
+                                                        [&](const ResolvedLocation& resolved) noexcept
+                                                        {
+                                                            entries.clear();
+                                                            const HRESULT readHr = ReadDirectoryEntries(resolved.connection, resolved.remotePath, entries);
+                                                            if (SUCCEEDED(readHr))
+                                                            {
+                                                                StoreCachedListing(resolved.connection, resolved.remotePath, entries, 0);
+                                                            }
+                                                            return readHr;
+                                                        });
+        if (FAILED(hr))
+        {
+            return hr;
+        }
     }
 
     auto infoImpl = std::unique_ptr<FilesInformationCurl>(new (std::nothrow) FilesInformationCurl());
@@ -1321,20 +1409,27 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::CreateFileReader(const wchar_t* path,
                                                 return S_OK;
                                             }
 
-                                            wil::unique_hfile file = CreateTemporaryDeleteOnCloseFile();
+                                            const bool isImap      = resolved.connection.protocol == Protocol::Imap;
+                                            wil::unique_hfile file = isImap ? CreateTemporaryDeleteOnCloseFile()
+                                                                            : OpenDownloadStagingFile(resolved.connection, resolved.remotePath);
                                             if (! file)
                                             {
                                                 return HRESULT_FROM_WIN32(GetLastError());
                                             }
 
                                             HRESULT dlHr = S_OK;
-                                            if (resolved.connection.protocol == Protocol::Imap)
+                                            if (isImap)
                                             {
                                                 dlHr = ImapDownloadMessageToFile(resolved.connection, resolved.remotePath, file.get());
                                             }
                                             else
                                             {
-                                                dlHr = CurlDownloadToFile(resolved.connection, resolved.remotePath, file.get(), nullptr, nullptr);
+                                                // A failed download keeps its staged bytes for the next reader of this file.
+                                                dlHr = CurlResumableDownloadToFile(resolved.connection, resolved.remotePath, file.get(), nullptr);
+                                                if (SUCCEEDED(dlHr))
+                                                {
+                                                    ReleaseDownloadStagingFile(resolved.connection, resolved.remotePath, file.get());
+                                                }
                                             }
                                             if (FAILED(dlHr))
                                             {
@@ -1402,7 +1497,9 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::CreateFileWriter([[maybe_unused]] cons
                                                 return overwriteHr;
                                             }
 
-                                            if (resolved.connection.protocol != Protocol::Imap)
+                                            // An interrupted upload of this destination continues from a staged copy; a stream cannot rewind.
+                                            const bool resumeStaged = HasUploadCheckpoint(resolved.connection, resolved.remotePath);
+                                            if (resolved.connection.protocol != Protocol::Imap && ! resumeStaged)
                                             {
                                                 auto* impl = new (std::nothrow) CurlStreamingWriter(resolved.connection, resolved.remotePath);
                                                 if (! impl)
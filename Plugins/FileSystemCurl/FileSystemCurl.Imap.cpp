@@ -1,5 +1,6 @@
 #include "FileSystemCurl.Internal.h"
 
+#include <condition_variable>
 #include <span>
 #include <unordered_map>
 
@@ -96,7 +97,7 @@ CurlPerformImapCustomRequest(const ConnectionInfo& conn, std::wstring_view mailb
         curl_easy_setopt(curl.get(), CURLOPT_USE_SSL, CURLUSESSL_TRY);
     }
 
-    const CURLcode code = curl_easy_perform(curl.get());
+    const CURLcode code = CurlPerform(conn, curl.get(), nullptr);
     if (code != CURLE_OK)
     {
         long responseCode = 0;
@@ -503,7 +504,7 @@ CurlPerformImapCustomRequest(const ConnectionInfo& conn, std::wstring_view mailb
     return S_OK;
 }
 
-[[nodiscard]] HRESULT ImapGetHierarchyDelimiter(const ConnectionInfo& conn, wchar_t& outDelimiter) noexcept
+[[nodiscard]] HRESULT ImapQueryHierarchyDelimiter(const ConnectionInfo& conn, wchar_t& outDelimiter) noexcept
 {
     outDelimiter = L'\0';
 
@@ -583,6 +584,32 @@ CurlPerformImapCustomRequest(const ConnectionInfo& conn, std::wstring_view mailb
     return ImapListMailboxes(conn, mailboxes, &outDelimiter);
 }
 
+// The hierarchy delimiter never changes for a server, so it is asked once per endpoint instead of once per operation.
+[[nodiscard]] HRESULT ImapGetHierarchyDelimiter(const ConnectionInfo& conn, wchar_t& outDelimiter) noexcept
+{
+    static std::mutex memoMutex;
+    static std::unordered_map<std::string, wchar_t> memo;
+
+    const std::string endpointKey = BuildEndpointKey(conn);
+    {
+        std::scoped_lock lock(memoMutex);
+        const auto found = memo.find(endpointKey);
+        if (found != memo.end())
+        {
+            outDelimiter = found->second;
+            return S_OK;
+        }
+    }
+
+    const HRESULT hr = ImapQueryHierarchyDelimiter(conn, outDelimiter);
+    if (SUCCEEDED(hr))
+    {
+        std::scoped_lock lock(memoMutex);
+        memo.insert_or_assign(endpointKey, outDelimiter);
+    }
+    return hr;
+}
+
 [[nodiscard]] HRESULT ImapListMessageUids(const ConnectionInfo& conn, std::wstring_view mailboxName, wchar_t delimiter, std::vector<uint64_t>& outUids) noexcept
 {
     outUids.clear();
@@ -2606,397 +2633,402 @@ struct ImapHeaderFields
     return true;
 }
 
-[[nodiscard]] HRESULT ImapFetchMessageSummaries(const ConnectionInfo& conn,
-                                                std::wstring_view mailboxPath,
-                                                std::span<const uint64_t> uids,
-                                                std::unordered_map<uint64_t, ImapMessageSummary>& inOut) noexcept
+// Runs one `UID FETCH <uidSetText> (UID FLAGS INTERNALDATE RFC822.SIZE ENVELOPE)` and merges every parsed summary into
+// `inOut`. `requested` lists the UIDs the set names (empty for ranges such as 1:*) and only feeds the anomaly report.
+[[nodiscard]] HRESULT ImapFetchAndParseMessageSummaries(const ConnectionInfo& conn,
+                                                        std::wstring_view mailboxPath,
+                                                        std::string_view uidSetText,
+                                                        std::span<const uint64_t> requested,
+                                                        std::unordered_map<uint64_t, ImapMessageSummary>& inOut) noexcept
 {
-    if (uids.empty())
+    if (uidSetText.empty())
     {
         return S_OK;
     }
 
-    std::vector<uint64_t> sorted;
-    sorted.reserve(uids.size());
-    for (const uint64_t uid : uids)
+    std::string requestText;
+    requestText = std::format("UID FETCH {} (UID FLAGS INTERNALDATE RFC822.SIZE ENVELOPE)", uidSetText);
+
+    std::string response;
+    HRESULT hr = CurlPerformImapCustomRequest(conn, mailboxPath, requestText, response);
+    if (FAILED(hr))
     {
-        sorted.push_back(uid);
+        return hr;
     }
 
-    std::sort(sorted.begin(), sorted.end());
-    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
-
-    // Keep IMAP commands reasonably short for server compatibility. (RFC 3501: minimum 1000 octets line length support.)
-    constexpr size_t kMaxUidSetChars = 800u;
+    size_t fetchParseFailures    = 0;
+    size_t missingUidCount       = 0;
+    size_t envelopeParseFailures = 0;
+    size_t fetchBlocksParsed     = 0;
 
-    auto fetchAndParse = [&](size_t startIndex, size_t endIndex, std::string_view uidSetText) noexcept -> HRESULT
+    size_t parsePos = 0;
+    while (true)
     {
-        if (startIndex >= endIndex || endIndex > sorted.size() || uidSetText.empty())
+        const size_t msgStart = FindImapUntaggedFetchLine(response, parsePos);
+        if (msgStart == std::string_view::npos)
         {
-            return S_OK;
+            break;
         }
 
-        std::string requestText;
-        requestText = std::format("UID FETCH {} (UID FLAGS INTERNALDATE RFC822.SIZE ENVELOPE)", uidSetText);
-
-        std::string response;
-        HRESULT hr = CurlPerformImapCustomRequest(conn, mailboxPath, requestText, response);
-        if (FAILED(hr))
+        size_t nextPos = 0;
+        std::string_view prefix;
+        std::string_view headerBlock;
+        std::string_view suffix;
+        if (! TryConsumeImapUntaggedFetchResponse(std::string_view(response), msgStart, nextPos, prefix, headerBlock, suffix))
         {
-            return hr;
-        }
+            ++fetchParseFailures;
 
-        size_t fetchParseFailures    = 0;
-        size_t missingUidCount       = 0;
-        size_t envelopeParseFailures = 0;
-        size_t fetchBlocksParsed     = 0;
+            const size_t lineEnd = response.find('\n', msgStart);
+            parsePos             = lineEnd == std::string_view::npos ? response.size() : (lineEnd + 1u);
+            continue;
+        }
 
-        size_t parsePos = 0;
-        while (true)
+        if (nextPos <= msgStart)
         {
-            const size_t msgStart = FindImapUntaggedFetchLine(response, parsePos);
-            if (msgStart == std::string_view::npos)
-            {
-                break;
-            }
-
-            size_t nextPos = 0;
-            std::string_view prefix;
-            std::string_view headerBlock;
-            std::string_view suffix;
-            if (! TryConsumeImapUntaggedFetchResponse(std::string_view(response), msgStart, nextPos, prefix, headerBlock, suffix))
-            {
-                ++fetchParseFailures;
+            ++fetchParseFailures;
+            parsePos = msgStart + 1u;
+            continue;
+        }
 
-                const size_t lineEnd = response.find('\n', msgStart);
-                parsePos             = lineEnd == std::string_view::npos ? response.size() : (lineEnd + 1u);
-                continue;
-            }
+        ImapMessageSummary summary{};
 
-            if (nextPos <= msgStart)
-            {
-                ++fetchParseFailures;
-                parsePos = msgStart + 1u;
-                continue;
-            }
+        uint64_t uid = 0;
+        bool hasUid  = TryParseUintAfterKey(prefix, "UID ", uid);
+        if (! hasUid && ! suffix.empty())
+        {
+            hasUid = TryParseUintAfterKey(suffix, "UID ", uid);
+        }
 
-            ImapMessageSummary summary{};
+        if (! hasUid)
+        {
+            ++missingUidCount;
+            parsePos = nextPos;
+            continue;
+        }
+        summary.uid = uid;
 
-            uint64_t uid = 0;
-            bool hasUid  = TryParseUintAfterKey(prefix, "UID ", uid);
-            if (! hasUid && ! suffix.empty())
-            {
-                hasUid = TryParseUintAfterKey(suffix, "UID ", uid);
-            }
+        bool hasSize = TryParseUintAfterKey(prefix, "RFC822.SIZE ", summary.sizeBytes);
+        if (! hasSize && ! suffix.empty())
+        {
+            static_cast<void>(TryParseUintAfterKey(suffix, "RFC822.SIZE ", summary.sizeBytes));
+        }
 
-            if (! hasUid)
+        // FLAGS (...)
+        {
+            auto parseFlags = [&summary](std::string_view text) noexcept
             {
-                ++missingUidCount;
-                parsePos = nextPos;
-                continue;
-            }
-            summary.uid = uid;
+                const size_t flagsPos = FindAsciiNoCase(text, "FLAGS", 0);
+                if (flagsPos == std::string_view::npos)
+                {
+                    return;
+                }
 
-            bool hasSize = TryParseUintAfterKey(prefix, "RFC822.SIZE ", summary.sizeBytes);
-            if (! hasSize && ! suffix.empty())
-            {
-                static_cast<void>(TryParseUintAfterKey(suffix, "RFC822.SIZE ", summary.sizeBytes));
-            }
+                const size_t open = text.find('(', flagsPos);
+                if (open == std::string_view::npos)
+                {
+                    return;
+                }
 
-            // FLAGS (...)
-            {
-                auto parseFlags = [&summary](std::string_view text) noexcept
+                const size_t close = text.find(')', open);
+                if (close == std::string_view::npos || close <= open)
                 {
-                    const size_t flagsPos = FindAsciiNoCase(text, "FLAGS", 0);
-                    if (flagsPos == std::string_view::npos)
-                    {
-                        return;
-                    }
+                    return;
+                }
 
-                    const size_t open = text.find('(', flagsPos);
-                    if (open == std::string_view::npos)
+                const std::string_view flagsText = text.substr(open + 1u, close - open - 1u);
+                size_t fp                        = 0;
+                while (fp < flagsText.size())
+                {
+                    while (fp < flagsText.size() && (flagsText[fp] == ' ' || flagsText[fp] == '\t'))
                     {
-                        return;
+                        ++fp;
                     }
-
-                    const size_t close = text.find(')', open);
-                    if (close == std::string_view::npos || close <= open)
+                    const size_t startTok = fp;
+                    while (fp < flagsText.size() && flagsText[fp] != ' ' && flagsText[fp] != '\t')
                     {
-                        return;
+                        ++fp;
                     }
-
-                    const std::string_view flagsText = text.substr(open + 1u, close - open - 1u);
-                    size_t fp                        = 0;
-                    while (fp < flagsText.size())
+                    const std::string_view tok = flagsText.substr(startTok, fp - startTok);
+                    if (! tok.empty())
                     {
-                        while (fp < flagsText.size() && (flagsText[fp] == ' ' || flagsText[fp] == '\t'))
+                        if (FindAsciiNoCase(tok, "\\seen", 0) == 0 && tok.size() == 5u)
                         {
-                            ++fp;
+                            summary.seen = true;
                         }
-                        const size_t startTok = fp;
-                        while (fp < flagsText.size() && flagsText[fp] != ' ' && flagsText[fp] != '\t')
+                        else if (FindAsciiNoCase(tok, "\\flagged", 0) == 0 && tok.size() == 8u)
                         {
-                            ++fp;
+                            summary.flagged = true;
                         }
-                        const std::string_view tok = flagsText.substr(startTok, fp - startTok);
-                        if (! tok.empty())
+                        else if (FindAsciiNoCase(tok, "\\deleted", 0) == 0 && tok.size() == 8u)
                         {
-                            if (FindAsciiNoCase(tok, "\\seen", 0) == 0 && tok.size() == 5u)
-                            {
-                                summary.seen = true;
-                            }
-                            else if (FindAsciiNoCase(tok, "\\flagged", 0) == 0 && tok.size() == 8u)
-                            {
-                                summary.flagged = true;
-                            }
-                            else if (FindAsciiNoCase(tok, "\\deleted", 0) == 0 && tok.size() == 8u)
-                            {
-                                summary.deleted = true;
-                            }
+                            summary.deleted = true;
                         }
                     }
-                };
-
-                parseFlags(prefix);
-                if (! suffix.empty())
-                {
-                    parseFlags(suffix);
                 }
+            };
+
+            parseFlags(prefix);
+            if (! suffix.empty())
+            {
+                parseFlags(suffix);
             }
+        }
 
-            // INTERNALDATE "..."
+        // INTERNALDATE "..."
+        {
+            auto parseInternalDate = [&summary](std::string_view text) noexcept
             {
-                auto parseInternalDate = [&summary](std::string_view text) noexcept
+                const size_t idPos = FindAsciiNoCase(text, "INTERNALDATE", 0);
+                if (idPos == std::string_view::npos)
                 {
-                    const size_t idPos = FindAsciiNoCase(text, "INTERNALDATE", 0);
-                    if (idPos == std::string_view::npos)
-                    {
-                        return;
-                    }
-
-                    size_t p           = idPos;
-                    const size_t quote = text.find('"', p);
-                    if (quote == std::string_view::npos)
-                    {
-                        return;
-                    }
+                    return;
+                }
 
-                    p = quote;
-                    std::string internalDate;
-                    if (TryParseImapQuotedString(text, p, internalDate))
-                    {
-                        static_cast<void>(TryParseImapInternalDateToFileTime(internalDate, summary.recvTime));
-                    }
-                };
+                size_t p           = idPos;
+                const size_t quote = text.find('"', p);
+                if (quote == std::string_view::npos)
+                {
+                    return;
+                }
 
-                parseInternalDate(prefix);
-                if (summary.recvTime == 0 && ! suffix.empty())
+                p = quote;
+                std::string internalDate;
+                if (TryParseImapQuotedString(text, p, internalDate))
                 {
-                    parseInternalDate(suffix);
+                    static_cast<void>(TryParseImapInternalDateToFileTime(internalDate, summary.recvTime));
                 }
-            }
+            };
 
-            ImapEnvelopeFields env;
-            bool hasEnvelope = TryExtractEnvelopeFields(prefix, env);
-            if (! hasEnvelope && ! suffix.empty())
+            parseInternalDate(prefix);
+            if (summary.recvTime == 0 && ! suffix.empty())
             {
-                hasEnvelope = TryExtractEnvelopeFields(suffix, env);
+                parseInternalDate(suffix);
             }
+        }
+
+        ImapEnvelopeFields env;
+        bool hasEnvelope = TryExtractEnvelopeFields(prefix, env);
+        if (! hasEnvelope && ! suffix.empty())
+        {
+            hasEnvelope = TryExtractEnvelopeFields(suffix, env);
+        }
+
+        if (hasEnvelope)
+        {
+            summary.subject = DecodeRfc2047EncodedWordsToUtf16(env.subject);
+            summary.from    = Utf16FromImapHeaderValue(env.fromAddrSpec);
 
-            if (hasEnvelope)
+            __int64 sentTime = 0;
+            if (TryParseRfc5322DateToFileTime(env.date, sentTime))
+            {
+                summary.sentTime = sentTime;
+            }
+        }
+        else if (! headerBlock.empty())
+        {
+            ImapHeaderFields headers;
+            if (TryExtractHeaderFields(headerBlock, headers))
             {
-                summary.subject = DecodeRfc2047EncodedWordsToUtf16(env.subject);
-                summary.from    = Utf16FromImapHeaderValue(env.fromAddrSpec);
+                summary.subject = DecodeRfc2047EncodedWordsToUtf16(headers.subject);
+                summary.from    = ExtractEmailAddressFromFromHeader(headers.from);
 
                 __int64 sentTime = 0;
-                if (TryParseRfc5322DateToFileTime(env.date, sentTime))
+                if (TryParseRfc5322DateToFileTime(headers.date, sentTime))
                 {
                     summary.sentTime = sentTime;
                 }
             }
-            else if (! headerBlock.empty())
-            {
-                ImapHeaderFields headers;
-                if (TryExtractHeaderFields(headerBlock, headers))
-                {
-                    summary.subject = DecodeRfc2047EncodedWordsToUtf16(headers.subject);
-                    summary.from    = ExtractEmailAddressFromFromHeader(headers.from);
+        }
+        else
+        {
+            ++envelopeParseFailures;
+        }
 
-                    __int64 sentTime = 0;
-                    if (TryParseRfc5322DateToFileTime(headers.date, sentTime))
-                    {
-                        summary.sentTime = sentTime;
-                    }
-                }
-            }
-            else
-            {
-                ++envelopeParseFailures;
-            }
+        if (summary.sentTime == 0)
+        {
+            summary.sentTime = summary.recvTime;
+        }
 
-            if (summary.sentTime == 0)
-            {
-                summary.sentTime = summary.recvTime;
-            }
+        inOut.insert_or_assign(summary.uid, std::move(summary));
 
-            inOut.insert_or_assign(summary.uid, std::move(summary));
+        ++fetchBlocksParsed;
 
-            ++fetchBlocksParsed;
+        parsePos = nextPos;
+    }
 
-            parsePos = nextPos;
+    size_t missingRequested = 0;
+    std::array<uint64_t, 5> missingSamples{};
+    size_t missingSampleCount = 0;
+    for (const uint64_t uid : requested)
+    {
+        if (inOut.find(uid) == inOut.end())
+        {
+            ++missingRequested;
+            if (missingSampleCount < missingSamples.size())
+            {
+                missingSamples[missingSampleCount++] = uid;
+            }
         }
+    }
 
-        size_t missingRequested = 0;
-        std::array<uint64_t, 5> missingSamples{};
-        size_t missingSampleCount = 0;
-        for (size_t i = startIndex; i < endIndex; ++i)
+    if (fetchParseFailures > 0 || missingUidCount > 0 || envelopeParseFailures > 0 || missingRequested > 0)
+    {
+        std::wstring missingText;
+        if (missingSampleCount > 0)
         {
-            const uint64_t uid = sorted[i];
-            if (inOut.find(uid) == inOut.end())
+            for (size_t i = 0; i < missingSampleCount; ++i)
             {
-                ++missingRequested;
-                if (missingSampleCount < missingSamples.size())
+                if (i != 0)
                 {
-                    missingSamples[missingSampleCount++] = uid;
+                    missingText.append(L",");
                 }
+                missingText.append(std::to_wstring(missingSamples[i]));
             }
         }
 
-        if (fetchParseFailures > 0 || missingUidCount > 0 || envelopeParseFailures > 0 || missingRequested > 0)
+        constexpr size_t kMaxUidSetLog = 160;
+        std::string uidSetShort(uidSetText);
+        if (uidSetShort.size() > kMaxUidSetLog)
+        {
+            uidSetShort.resize(kMaxUidSetLog);
+            uidSetShort.append("...");
+        }
+
+        constexpr size_t kMaxRequestLog = 200;
+        std::string requestShort        = requestText;
+        if (requestShort.size() > kMaxRequestLog)
+        {
+            requestShort.resize(kMaxRequestLog);
+            requestShort.append("...");
+        }
+
+        std::wstring responseFirstLine;
+        std::wstring responseFetchLines;
+
+        // First non-empty line (trimmed)
         {
-            std::wstring missingText;
-            if (missingSampleCount > 0)
+            std::string firstLine;
+            size_t start = 0;
+            while (start < response.size())
             {
-                for (size_t i = 0; i < missingSampleCount; ++i)
+                size_t end = response.find('\n', start);
+                if (end == std::string_view::npos)
                 {
-                    if (i != 0)
-                    {
-                        missingText.append(L",");
-                    }
-                    missingText.append(std::to_wstring(missingSamples[i]));
+                    end = response.size();
                 }
-            }
 
-            constexpr size_t kMaxUidSetLog = 160;
-            std::string uidSetShort(uidSetText);
-            if (uidSetShort.size() > kMaxUidSetLog)
-            {
-                uidSetShort.resize(kMaxUidSetLog);
-                uidSetShort.append("...");
+                std::string_view line = std::string_view(response).substr(start, end - start);
+                if (! line.empty() && line.back() == '\r')
+                {
+                    line.remove_suffix(1);
+                }
+
+                firstLine = TrimAscii(line);
+                if (! firstLine.empty())
+                {
+                    break;
+                }
+                start = end + 1u;
             }
 
-            constexpr size_t kMaxRequestLog = 200;
-            std::string requestShort        = requestText;
-            if (requestShort.size() > kMaxRequestLog)
+            constexpr size_t kMaxLineLog = 200;
+            if (firstLine.size() > kMaxLineLog)
             {
-                requestShort.resize(kMaxRequestLog);
-                requestShort.append("...");
+                firstLine.resize(kMaxLineLog);
+                firstLine.append("...");
             }
 
-            std::wstring responseFirstLine;
-            std::wstring responseFetchLines;
+            responseFirstLine = Utf16FromImapHeaderValue(firstLine);
+        }
 
-            // First non-empty line (trimmed)
+        // First few FETCH lines (no literal payload)
+        {
+            constexpr size_t kMaxFetchLines = 4;
+            size_t scanPos                  = 0;
+            for (size_t i = 0; i < kMaxFetchLines; ++i)
             {
-                std::string firstLine;
-                size_t start = 0;
-                while (start < response.size())
+                const size_t fetchStart = FindImapUntaggedFetchLine(std::string_view(response), scanPos);
+                if (fetchStart == std::string_view::npos)
                 {
-                    size_t end = response.find('\n', start);
-                    if (end == std::string_view::npos)
-                    {
-                        end = response.size();
-                    }
-
-                    std::string_view line = std::string_view(response).substr(start, end - start);
-                    if (! line.empty() && line.back() == '\r')
-                    {
-                        line.remove_suffix(1);
-                    }
+                    break;
+                }
 
-                    firstLine = TrimAscii(line);
-                    if (! firstLine.empty())
-                    {
-                        break;
-                    }
-                    start = end + 1u;
+                size_t fetchLineEnd = response.find('\n', fetchStart);
+                if (fetchLineEnd == std::string_view::npos)
+                {
+                    fetchLineEnd = response.size();
                 }
 
-                constexpr size_t kMaxLineLog = 200;
-                if (firstLine.size() > kMaxLineLog)
+                std::string_view line = std::string_view(response).substr(fetchStart, fetchLineEnd - fetchStart);
+                if (! line.empty() && line.back() == '\r')
                 {
-                    firstLine.resize(kMaxLineLog);
-                    firstLine.append("...");
+                    line.remove_suffix(1);
                 }
+                line = TrimAsciiView(line);
 
-                responseFirstLine = Utf16FromImapHeaderValue(firstLine);
-            }
+                constexpr size_t kMaxFetchLineLog = 220;
+                std::string lineShort(line);
+                if (lineShort.size() > kMaxFetchLineLog)
+                {
+                    lineShort.resize(kMaxFetchLineLog);
+                    lineShort.append("...");
+                }
 
-            // First few FETCH lines (no literal payload)
-            {
-                constexpr size_t kMaxFetchLines = 4;
-                size_t scanPos                  = 0;
-                for (size_t i = 0; i < kMaxFetchLines; ++i)
+                if (! responseFetchLines.empty())
                 {
-                    const size_t fetchStart = FindImapUntaggedFetchLine(std::string_view(response), scanPos);
-                    if (fetchStart == std::string_view::npos)
-                    {
-                        break;
-                    }
+                    responseFetchLines.append(L" | ");
+                }
+                responseFetchLines.append(Utf16FromImapHeaderValue(lineShort));
 
-                    size_t fetchLineEnd = response.find('\n', fetchStart);
-                    if (fetchLineEnd == std::string_view::npos)
-                    {
-                        fetchLineEnd = response.size();
-                    }
+                scanPos = fetchLineEnd + 1u;
+            }
+        }
 
-                    std::string_view line = std::string_view(response).substr(fetchStart, fetchLineEnd - fetchStart);
-                    if (! line.empty() && line.back() == '\r')
-                    {
-                        line.remove_suffix(1);
-                    }
-                    line = TrimAsciiView(line);
+        Debug::Warning(L"imap summary request mailbox='{}' req='{}'", mailboxPath, Utf16FromImapHeaderValue(requestShort));
+        Debug::Warning(L"imap summary response mailbox='{}' firstLine='{}' fetchLines='{}'",
+                       mailboxPath,
+                       responseFirstLine.empty() ? L"(none)" : responseFirstLine,
+                       responseFetchLines.empty() ? L"(none)" : responseFetchLines);
 
-                    constexpr size_t kMaxFetchLineLog = 220;
-                    std::string lineShort(line);
-                    if (lineShort.size() > kMaxFetchLineLog)
-                    {
-                        lineShort.resize(kMaxFetchLineLog);
-                        lineShort.append("...");
-                    }
+        Debug::Warning(L"imap summary parse anomalies mailbox='{}' fetchBlocks={} fetchParseFailures={} envelopeParseFailures={} missingUidInFetch={} "
+                       L"missingRequested={} missingSample='{}' requested={} responseBytes={} uidSet='{}'",
+                       mailboxPath,
+                       fetchBlocksParsed,
+                       fetchParseFailures,
+                       envelopeParseFailures,
+                       missingUidCount,
+                       missingRequested,
+                       missingText.empty() ? L"(none)" : missingText,
+                       requested.size(),
+                       response.size(),
+                       Utf16FromUtf8(uidSetShort));
+    }
 
-                    if (! responseFetchLines.empty())
-                    {
-                        responseFetchLines.append(L" | ");
-                    }
-                    responseFetchLines.append(Utf16FromImapHeaderValue(lineShort));
+    return S_OK;
+}
 
-                    scanPos = fetchLineEnd + 1u;
-                }
-            }
+[[nodiscard]] HRESULT ImapFetchMessageSummaries(const ConnectionInfo& conn,
+                                                std::wstring_view mailboxPath,
+                                                std::span<const uint64_t> uids,
+                                                std::unordered_map<uint64_t, ImapMessageSummary>& inOut) noexcept
+{
+    if (uids.empty())
+    {
+        return S_OK;
+    }
 
-            Debug::Warning(L"imap summary request mailbox='{}' req='{}'", mailboxPath, Utf16FromImapHeaderValue(requestShort));
-            Debug::Warning(L"imap summary response mailbox='{}' firstLine='{}' fetchLines='{}'",
-                           mailboxPath,
-                           responseFirstLine.empty() ? L"(none)" : responseFirstLine,
-                           responseFetchLines.empty() ? L"(none)" : responseFetchLines);
-
-            Debug::Warning(L"imap summary parse anomalies mailbox='{}' fetchBlocks={} fetchParseFailures={} envelopeParseFailures={} missingUidInFetch={} "
-                           L"missingRequested={} missingSample='{}' requested={} responseBytes={} uidSet='{}'",
-                           mailboxPath,
-                           fetchBlocksParsed,
-                           fetchParseFailures,
-                           envelopeParseFailures,
-                           missingUidCount,
-                           missingRequested,
-                           missingText.empty() ? L"(none)" : missingText,
-                           endIndex - startIndex,
-                           response.size(),
-                           Utf16FromUtf8(uidSetShort));
-        }
+    std::vector<uint64_t> sorted;
+    sorted.reserve(uids.size());
+    for (const uint64_t uid : uids)
+    {
+        sorted.push_back(uid);
+    }
 
-        return S_OK;
-    };
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // Keep IMAP commands reasonably short for server compatibility. (RFC 3501: minimum 1000 octets line length support.)
+    constexpr size_t kMaxUidSetChars = 800u;
 
     std::string uidSet;
     uidSet.reserve(std::min(kMaxUidSetChars, sorted.size() * 12u));
@@ -3009,7 +3041,7 @@ struct ImapHeaderFields
 
         if (! uidSet.empty() && uidSet.size() + needed > kMaxUidSetChars)
         {
-            const HRESULT hr = fetchAndParse(groupStart, i, uidSet);
+            const HRESULT hr = ImapFetchAndParseMessageSummaries(conn, mailboxPath, uidSet, std::span(sorted).subspan(groupStart, i - groupStart), inOut);
             if (FAILED(hr))
             {
                 return hr;
@@ -3028,7 +3060,7 @@ struct ImapHeaderFields
 
     if (! uidSet.empty())
     {
-        const HRESULT hr = fetchAndParse(groupStart, sorted.size(), uidSet);
+        const HRESULT hr = ImapFetchAndParseMessageSummaries(conn, mailboxPath, uidSet, std::span(sorted).subspan(groupStart), inOut);
         if (FAILED(hr))
         {
             return hr;
@@ -3277,7 +3309,7 @@ size_t CurlWriteImapFetchToFile(void* ptr, size_t size, size_t nmemb, void* user
         curl_easy_setopt(curl.get(), CURLOPT_USE_SSL, CURLUSESSL_TRY);
     }
 
-    const CURLcode code = curl_easy_perform(curl.get());
+    const CURLcode code = CurlPerform(conn, curl.get(), nullptr);
     if (code == CURLE_WRITE_ERROR && FAILED(ctx.abortHr))
     {
         return ctx.abortHr;
@@ -3314,44 +3346,462 @@ size_t CurlWriteImapFetchToFile(void* ptr, size_t size, size_t nmemb, void* user
     return out;
 }
 
-[[nodiscard]] HRESULT ImapDownloadMessageToFile(const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file) noexcept
+// Compact IMAP sequence set for ascending UIDs ("3:7,9,12:14").
+[[nodiscard]] std::string BuildImapUidSet(std::span<const uint64_t> sortedUids) noexcept
 {
-    const std::wstring fullPath = JoinPluginPathWide(conn.basePathWide, pluginPath);
-
-    const std::wstring_view leaf = LeafName(fullPath);
-    uint64_t uid                 = 0;
-    if (! TryParseImapUidFromLeafName(leaf, uid))
+    std::string out;
+    for (size_t index = 0; index < sortedUids.size();)
     {
-        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
-    }
+        size_t end = index;
+        while (end + 1u < sortedUids.size() && sortedUids[end + 1u] == sortedUids[end] + 1u)
+        {
+            ++end;
+        }
 
-    std::wstring mailboxPath = ParentPath(fullPath);
-    mailboxPath              = std::wstring(TrimTrailingSlash(mailboxPath));
-    if (mailboxPath.empty())
-    {
-        mailboxPath = L"/";
+        if (! out.empty())
+        {
+            out.push_back(',');
+        }
+        out.append(end == index ? std::format("{}", sortedUids[index]) : std::format("{}:{}", sortedUids[index], sortedUids[end]));
+        index = end + 1u;
     }
+    return out;
+}
 
-    if (mailboxPath == L"/")
+// Streams every BODY[] literal of a multi-message `UID FETCH <set> BODY.PEEK[]` into its own cache temp file. Finished
+// bodies are only recorded here; they are published after the transfer, off the curl_multi loop thread.
+struct ImapBatchFetchContext
+{
+    struct FinishedMessage
     {
-        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
-    }
+        uint64_t uid       = 0;
+        uint64_t sizeBytes = 0;
+        std::filesystem::path tempPath;
+    };
 
-    wchar_t delimiter = L'\0';
-    HRESULT hr        = ImapGetHierarchyDelimiter(conn, delimiter);
-    if (FAILED(hr))
+    ImapBatchFetchContext()                                        = default;
+    ImapBatchFetchContext(const ImapBatchFetchContext&)            = delete;
+    ImapBatchFetchContext& operator=(const ImapBatchFetchContext&) = delete;
+    ImapBatchFetchContext(ImapBatchFetchContext&&)                 = delete;
+    ImapBatchFetchContext& operator=(ImapBatchFetchContext&&)      = delete;
+
+    ~ImapBatchFetchContext()
     {
-        return hr;
+        DiscardCurrent();
+        for (const FinishedMessage& message : finished)
+        {
+            static_cast<void>(DeleteFileW(message.tempPath.c_str()));
+        }
     }
 
-    const std::wstring serverMailboxPath = ImapMailboxPathToServerMailboxPath(mailboxPath, delimiter);
-    if (serverMailboxPath.empty())
+    void DiscardCurrent() noexcept
     {
-        return E_OUTOFMEMORY;
+        file.reset();
+        if (! tempPath.empty())
+        {
+            static_cast<void>(DeleteFileW(tempPath.c_str()));
+            tempPath.clear();
+        }
     }
 
-    return ImapFetchMessageToFile(conn, serverMailboxPath, uid, file);
-}
+    unique_curl_easy curl;
+    std::string requestText;
+    CURLcode code = CURLE_OK;
+
+    std::string line;   // response text outside literals, up to the next line end
+    std::string prefix; // FETCH line that announced the current literal
+    wil::unique_hfile file;
+    std::filesystem::path tempPath;
+    uint64_t literalBytes   = 0;
+    uint64_t remainingBytes = 0;
+    HRESULT abortHr         = S_OK;
+
+    std::vector<FinishedMessage> finished;
+};
+
+[[nodiscard]] bool TryParseTrailingImapLiteral(std::string_view line, uint64_t& literalSize) noexcept
+{
+    literalSize = 0;
+    if (line.empty() || line.back() != '}')
+    {
+        return false;
+    }
+
+    const size_t brace = line.rfind('{');
+    if (brace == std::string_view::npos)
+    {
+        return false;
+    }
+
+    std::string_view digits = line.substr(brace + 1u, line.size() - brace - 2u);
+    if (! digits.empty() && digits.back() == '+')
+    {
+        digits.remove_suffix(1);
+    }
+
+    uint64_t value = 0;
+    for (const char ch : digits)
+    {
+        if (ch < '0' || ch > '9' || value > ((std::numeric_limits<uint64_t>::max)() - 9u) / 10u)
+        {
+            return false;
+        }
+        value = (value * 10u) + static_cast<uint64_t>(ch - '0');
+    }
+
+    literalSize = value;
+    return ! digits.empty();
+}
+
+size_t CurlWriteImapBatchFetch(void* ptr, size_t size, size_t nmemb, void* userdata) noexcept
+{
+    const size_t total = size * nmemb;
+    auto* ctx          = static_cast<ImapBatchFetchContext*>(userdata);
+    if (! ptr || ! ctx || total == 0)
+    {
+        return 0;
+    }
+
+    const char* data = static_cast<const char*>(ptr);
+    size_t offset    = 0;
+    while (offset < total)
+    {
+        if (ctx->remainingBytes > 0)
+        {
+            const DWORD take = static_cast<DWORD>(std::min<uint64_t>({ctx->remainingBytes, total - offset, (std::numeric_limits<DWORD>::max)()}));
+
+            DWORD written = 0;
+            if (! WriteFile(ctx->file.get(), data + offset, take, &written, nullptr))
+            {
+                ctx->abortHr = HRESULT_FROM_WIN32(GetLastError());
+                return 0;
+            }
+            if (written != take)
+            {
+                ctx->abortHr = HRESULT_FROM_WIN32(ERROR_WRITE_FAULT);
+                return 0;
+            }
+
+            offset += take;
+            ctx->remainingBytes -= take;
+            continue;
+        }
+
+        const char* lineEnd = static_cast<const char*>(std::memchr(data + offset, '\n', total - offset));
+        const size_t take   = lineEnd ? static_cast<size_t>(lineEnd - (data + offset)) + 1u : total - offset;
+        ctx->line.append(data + offset, take);
+        offset += take;
+
+        constexpr size_t kMaxLineBytes = 256u * 1024u;
+        if (ctx->line.size() > kMaxLineBytes)
+        {
+            ctx->abortHr = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            return 0;
+        }
+
+        if (! lineEnd)
+        {
+            continue;
+        }
+
+        std::string_view text = ctx->line;
+        while (! text.empty() && (text.back() == '\n' || text.back() == '\r'))
+        {
+            text.remove_suffix(1);
+        }
+
+        if (! ctx->tempPath.empty())
+        {
+            // The rest of the FETCH response after the literal; servers may send the UID here instead of before BODY[].
+            uint64_t uid = 0;
+            if (TryParseUintAfterKey(ctx->prefix, "UID ", uid) || TryParseUintAfterKey(text, "UID ", uid))
+            {
+                ctx->file.reset();
+                ctx->finished.push_back({uid, ctx->literalBytes, std::move(ctx->tempPath)});
+                ctx->tempPath.clear();
+            }
+            else
+            {
+                ctx->DiscardCurrent();
+            }
+        }
+        else if (FindImapUntaggedFetchLine(text, 0) == 0 && TryParseTrailingImapLiteral(text, ctx->literalBytes))
+        {
+            ctx->file = CreateImapMessageCacheTempFile(ctx->tempPath);
+            if (! ctx->file)
+            {
+                ctx->abortHr = HRESULT_FROM_WIN32(GetLastError());
+                return 0;
+            }
+
+            ctx->prefix.assign(text);
+            ctx->remainingBytes = ctx->literalBytes;
+        }
+
+        ctx->line.clear();
+    }
+
+    return total;
+}
+
+// Fetches `uids` of one mailbox into the message cache: the set is split over up to maxConnectionsPerHost FETCH commands
+// that run side by side on the curl_multi engine (one pooled connection each) instead of one round trip per message.
+[[nodiscard]] HRESULT
+ImapFetchMessagesToCache(const ConnectionInfo& conn, std::wstring_view serverMailboxPath, uint64_t uidValidity, std::span<const uint64_t> uids) noexcept
+{
+    if (uids.empty())
+    {
+        return S_OK;
+    }
+
+    HRESULT hr = EnsureCurlInitialized();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    const std::string url = BuildImapUrl(conn, serverMailboxPath);
+    if (url.empty())
+    {
+        return E_INVALIDARG;
+    }
+
+    std::vector<uint64_t> sorted(uids.begin(), uids.end());
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    const size_t connectionLimit = std::clamp(conn.maxConnectionsPerHost, 1u, FileSystemCurl::kMaxConnectionsPerHostLimit);
+    const size_t batchCount      = std::min(connectionLimit, sorted.size());
+    const size_t perBatch        = (sorted.size() + batchCount - 1u) / batchCount;
+
+    std::vector<std::unique_ptr<ImapBatchFetchContext>> batches;
+    for (size_t start = 0; start < sorted.size(); start += perBatch)
+    {
+        auto batch = std::make_unique<ImapBatchFetchContext>();
+        batch->curl.reset(curl_easy_init());
+        if (! batch->curl)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        const std::span<const uint64_t> slice = std::span<const uint64_t>(sorted).subspan(start, std::min(perBatch, sorted.size() - start));
+        batch->requestText                    = std::format("UID FETCH {} BODY.PEEK[]", BuildImapUidSet(slice));
+
+        CURL* curl = batch->curl.get();
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, batch->requestText.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CurlWriteImapBatchFetch);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, batch.get());
+        curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+
+        ApplyCommonCurlOptions(curl, conn, nullptr, false);
+        if (ImapSchemeForConnection(conn) == "imap")
+        {
+            curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_TRY);
+        }
+
+        batches.push_back(std::move(batch));
+    }
+
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    size_t running = 0;
+
+    for (auto& batch : batches)
+    {
+        if (conn.multiTransferEngine)
+        {
+            {
+                std::scoped_lock lock(doneMutex);
+                ++running;
+            }
+
+            ImapBatchFetchContext* ctx = batch.get();
+
+            const HRESULT submitHr = CurlMultiSubmit(conn,
+                                                     ctx->curl.get(),
+                                                     nullptr,
+                                                     [&, ctx](CURLcode code) noexcept
+                                                     {
+                                                         std::scoped_lock lock(doneMutex);
+                                                         ctx->code = code;
+                                                         --running;
+                                                         doneCv.notify_one();
+                                                     });
+            if (SUCCEEDED(submitHr))
+            {
+                continue;
+            }
+
+            std::scoped_lock lock(doneMutex);
+            --running;
+        }
+
+        batch->code = CurlPerform(conn, batch->curl.get(), nullptr);
+    }
+
+    {
+        std::unique_lock lock(doneMutex);
+        doneCv.wait(lock, [&]() noexcept { return running == 0; });
+    }
+
+    HRESULT firstFailure = S_OK;
+    size_t stored        = 0;
+    for (auto& batch : batches)
+    {
+        const HRESULT batchHr = batch->code == CURLE_WRITE_ERROR && FAILED(batch->abortHr) ? batch->abortHr : HResultFromCurl(batch->code);
+        if (FAILED(batchHr) && SUCCEEDED(firstFailure))
+        {
+            firstFailure = batchHr;
+        }
+
+        for (auto& message : batch->finished)
+        {
+            CommitImapMessageCacheFile(conn, message.tempPath, GetImapMessageCachePath(conn, serverMailboxPath, uidValidity, message.uid), message.sizeBytes);
+            ++stored;
+        }
+        batch->finished.clear();
+    }
+
+    Debug::Info(L"imap cached {} of {} messages mailbox='{}' batches={}", stored, sorted.size(), serverMailboxPath, batches.size());
+    return stored > 0 ? S_OK : firstFailure;
+}
+
+// UIDVALIDITY of a mailbox (STATUS; libcurl does not expose the SELECT response). Remembered briefly per mailbox so a
+// run of message reads asks once.
+[[nodiscard]] HRESULT ImapGetMailboxUidValidity(const ConnectionInfo& conn, std::wstring_view serverMailboxPath, uint64_t& outUidValidity) noexcept
+{
+    outUidValidity = 0;
+
+    constexpr uint64_t kMemoTtlMs = 30'000;
+
+    struct MemoEntry
+    {
+        uint64_t uidValidity  = 0;
+        uint64_t capturedTick = 0;
+    };
+
+    static std::mutex memoMutex;
+    static std::unordered_map<std::string, MemoEntry> memo;
+
+    std::wstring_view serverName = serverMailboxPath;
+    if (! serverName.empty() && serverName.front() == L'/')
+    {
+        serverName.remove_prefix(1);
+    }
+
+    const std::string nameUtf8 = Utf8FromUtf16(serverName);
+    if (nameUtf8.empty())
+    {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
+    }
+
+    const std::string memoKey = std::format("{}|{}", BuildEndpointKey(conn), nameUtf8);
+    const uint64_t now        = GetTickCount64();
+    {
+        std::scoped_lock lock(memoMutex);
+        const auto found = memo.find(memoKey);
+        if (found != memo.end() && now - found->second.capturedTick < kMemoTtlMs)
+        {
+            outUidValidity = found->second.uidValidity;
+            return S_OK;
+        }
+    }
+
+    std::string response;
+    const HRESULT hr = CurlPerformImapCustomRequest(conn, L"/", std::format("STATUS {} (UIDVALIDITY)", ImapQuoteString(nameUtf8)), response);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    if (! TryParseUintAfterKey(response, "UIDVALIDITY ", outUidValidity) || outUidValidity == 0)
+    {
+        outUidValidity = 0;
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    std::scoped_lock lock(memoMutex);
+    memo.insert_or_assign(memoKey, MemoEntry{outUidValidity, now});
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT ImapDownloadMessageToFile(const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file) noexcept
+{
+    const std::wstring fullPath = JoinPluginPathWide(conn.basePathWide, pluginPath);
+
+    const std::wstring_view leaf = LeafName(fullPath);
+    uint64_t uid                 = 0;
+    if (! TryParseImapUidFromLeafName(leaf, uid))
+    {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
+    }
+
+    std::wstring mailboxPath = ParentPath(fullPath);
+    mailboxPath              = std::wstring(TrimTrailingSlash(mailboxPath));
+    if (mailboxPath.empty())
+    {
+        mailboxPath = L"/";
+    }
+
+    if (mailboxPath == L"/")
+    {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_NAME);
+    }
+
+    wchar_t delimiter = L'\0';
+    HRESULT hr        = ImapGetHierarchyDelimiter(conn, delimiter);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    const std::wstring serverMailboxPath = ImapMailboxPathToServerMailboxPath(mailboxPath, delimiter);
+    if (serverMailboxPath.empty())
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    if (! conn.imapMessageCache)
+    {
+        return ImapFetchMessageToFile(conn, serverMailboxPath, uid, file);
+    }
+
+    uint64_t uidValidity = 0;
+    hr                   = ImapGetMailboxUidValidity(conn, serverMailboxPath, uidValidity);
+    if (FAILED(hr))
+    {
+        Debug::Info(L"imap message cache skipped (no UIDVALIDITY, hr={:#x}) mailbox='{}'", hr, serverMailboxPath);
+        return ImapFetchMessageToFile(conn, serverMailboxPath, uid, file);
+    }
+
+    const std::filesystem::path cachePath = GetImapMessageCachePath(conn, serverMailboxPath, uidValidity, uid);
+    hr                                    = CopyCachedImapMessage(cachePath, file);
+    if (hr != S_FALSE)
+    {
+        return hr;
+    }
+
+    const std::vector<uint64_t> batch = ClaimImapReadahead(conn, mailboxPath, serverMailboxPath, uidValidity, uid);
+    if (! batch.empty())
+    {
+        const HRESULT fetchHr = ImapFetchMessagesToCache(conn, serverMailboxPath, uidValidity, batch);
+        ReleaseImapReadahead(conn, serverMailboxPath, uidValidity, batch);
+        if (FAILED(fetchHr))
+        {
+            Debug::Warning(L"imap batch fetch failed: hr={:#x} mailbox='{}' messages={}", fetchHr, serverMailboxPath, batch.size());
+        }
+    }
+
+    hr = CopyCachedImapMessage(cachePath, file);
+    if (hr != S_FALSE)
+    {
+        return hr;
+    }
+
+    // Not cached after all (cache folder unavailable, or the batch failed or skipped it): fetch the message directly.
+    return ImapFetchMessageToFile(conn, serverMailboxPath, uid, file);
+}
 
 [[nodiscard]] HRESULT ImapDeleteMessage(const ConnectionInfo& conn, std::wstring_view pluginPath) noexcept
 {
@@ -3389,6 +3839,8 @@ size_t CurlWriteImapFetchToFile(void* ptr, size_t size, size_t nmemb, void* user
         return E_OUTOFMEMORY;
     }
 
+    InvalidateImapMailboxSnapshot(conn, mailboxPath);
+
     std::string sink;
     hr = CurlPerformImapCustomRequest(conn, serverMailboxPath, std::format("UID STORE {} +FLAGS.SILENT (\\Deleted)", uid), sink);
     if (FAILED(hr))
@@ -3441,6 +3893,9 @@ size_t CurlWriteImapFetchToFile(void* ptr, size_t size, size_t nmemb, void* user
         return HRESULT_FROM_WIN32(ERROR_NO_UNICODE_TRANSLATION);
     }
 
+    InvalidateImapMailboxSnapshot(conn, trimmed);
+    InvalidateImapMailboxSnapshot(conn, ParentPath(trimmed));
+
     std::string sink;
     return CurlPerformImapCustomRequest(conn, L"/", std::format("DELETE {}", ImapQuoteString(nameUtf8)), sink);
 }
@@ -3481,6 +3936,8 @@ size_t CurlWriteImapFetchToFile(void* ptr, size_t size, size_t nmemb, void* user
         return HRESULT_FROM_WIN32(ERROR_NO_UNICODE_TRANSLATION);
     }
 
+    InvalidateImapMailboxSnapshot(conn, ParentPath(trimmed));
+
     std::string sink;
     return CurlPerformImapCustomRequest(conn, L"/", std::format("CREATE {}", ImapQuoteString(nameUtf8)), sink);
 }
@@ -3530,6 +3987,86 @@ size_t CurlWriteImapFetchToFile(void* ptr, size_t size, size_t nmemb, void* user
     return true;
 }
 
+// Fallback for servers that reject `UID FETCH 1:*`: summaries for the UIDs found by UID SEARCH, in chunks.
+[[nodiscard]] HRESULT ImapFetchMessageSummariesChunked(const ConnectionInfo& conn,
+                                                       std::wstring_view serverMailboxPath,
+                                                       std::wstring_view mailboxName,
+                                                       std::span<const uint64_t> uids,
+                                                       std::unordered_map<uint64_t, ImapMessageSummary>& summaries) noexcept
+{
+    constexpr size_t kFetchChunkSize = 200u;
+    HRESULT metaHr                   = S_OK;
+    for (size_t start = 0; start < uids.size(); start += kFetchChunkSize)
+    {
+        const size_t count = std::min(kFetchChunkSize, uids.size() - start);
+        const std::span<const uint64_t> chunk(uids.data() + start, count);
+        metaHr = ImapFetchMessageSummaries(conn, serverMailboxPath, chunk, summaries);
+        if (FAILED(metaHr))
+        {
+            break;
+        }
+
+        // Some servers are picky about UID sets and may return incomplete FETCH results. If we only missed a few,
+        // retry those UIDs once to avoid a directory listing full of 0B / missing metadata entries.
+        constexpr size_t kMaxRepairUids = 16u;
+        std::array<uint64_t, kMaxRepairUids> missing{};
+        size_t missingCount = 0;
+        size_t missingTotal = 0;
+        for (const uint64_t uid : chunk)
+        {
+            if (summaries.find(uid) != summaries.end())
+            {
+                continue;
+            }
+
+            ++missingTotal;
+            if (missingCount < missing.size())
+            {
+                missing[missingCount++] = uid;
+            }
+        }
+
+        if (missingTotal > 0 && missingTotal <= kMaxRepairUids)
+        {
+            const std::span<const uint64_t> missingSpan(missing.data(), missingCount);
+            const HRESULT repairHr = ImapFetchMessageSummaries(conn, serverMailboxPath, missingSpan, summaries);
+            if (FAILED(repairHr))
+            {
+                Debug::Warning(L"imap message summary repair fetch failed: hr={:#x} mailbox='{}' server='{}' missing={}",
+                               repairHr,
+                               mailboxName,
+                               Utf16FromUtf8(conn.host),
+                               missingTotal);
+            }
+            else
+            {
+                for (size_t i = 0; i < missingCount; ++i)
+                {
+                    const uint64_t uid = missing[i];
+                    if (summaries.find(uid) != summaries.end())
+                    {
+                        continue;
+                    }
+
+                    const uint64_t singleUid = uid;
+                    const std::span<const uint64_t> one(&singleUid, 1);
+                    const HRESULT singleHr = ImapFetchMessageSummaries(conn, serverMailboxPath, one, summaries);
+                    if (FAILED(singleHr))
+                    {
+                        Debug::Warning(L"imap message summary single-uid repair fetch failed: hr={:#x} mailbox='{}' server='{}' uid={}",
+                                       singleHr,
+                                       mailboxName,
+                                       Utf16FromUtf8(conn.host),
+                                       uid);
+                    }
+                }
+            }
+        }
+    }
+
+    return metaHr;
+}
+
 [[nodiscard]] HRESULT
 ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPath, std::vector<FilesInformationCurl::Entry>& entries) noexcept
 {
@@ -3622,19 +4159,6 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
         return S_OK;
     }
 
-    std::vector<uint64_t> uids;
-    hr = ImapListMessageUids(conn, mailboxName, delimiter, uids);
-    if (FAILED(hr))
-    {
-        return hr;
-    }
-
-    std::sort(uids.begin(), uids.end(), std::greater<>());
-    if (uids.empty())
-    {
-        return S_OK;
-    }
-
     std::wstring serverMailboxPath;
     {
         const std::wstring serverName = ImapMailboxNameToServerMailboxName(mailboxName, delimiter);
@@ -3648,77 +4172,38 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
         serverMailboxPath.append(serverName);
     }
 
+    // Headers for the whole mailbox in one round trip instead of a UID SEARCH followed by one FETCH per 200 messages.
+    std::vector<uint64_t> uids;
     std::unordered_map<uint64_t, ImapMessageSummary> summaries;
-    summaries.reserve(uids.size());
-
-    constexpr size_t kFetchChunkSize = 200u;
-    HRESULT metaHr                   = S_OK;
-    for (size_t start = 0; start < uids.size(); start += kFetchChunkSize)
+    HRESULT metaHr = ImapFetchAndParseMessageSummaries(conn, serverMailboxPath, "1:*", {}, summaries);
+    if (SUCCEEDED(metaHr))
     {
-        const size_t count = std::min(kFetchChunkSize, uids.size() - start);
-        const std::span<const uint64_t> chunk(uids.data() + start, count);
-        metaHr = ImapFetchMessageSummaries(conn, serverMailboxPath, chunk, summaries);
-        if (FAILED(metaHr))
+        uids.reserve(summaries.size());
+        for (const auto& item : summaries)
         {
-            break;
+            uids.push_back(item.first);
         }
+        std::sort(uids.begin(), uids.end(), std::greater<>());
+    }
+    else
+    {
+        Debug::Info(L"imap 1:* summary fetch failed (hr={:#x}) mailbox='{}'; falling back to UID SEARCH", metaHr, mailboxName);
+        summaries.clear();
 
-        // Some servers are picky about UID sets and may return incomplete FETCH results. If we only missed a few,
-        // retry those UIDs once to avoid a directory listing full of 0B / missing metadata entries.
-        constexpr size_t kMaxRepairUids = 16u;
-        std::array<uint64_t, kMaxRepairUids> missing{};
-        size_t missingCount = 0;
-        size_t missingTotal = 0;
-        for (const uint64_t uid : chunk)
+        hr = ImapListMessageUids(conn, mailboxName, delimiter, uids);
+        if (FAILED(hr))
         {
-            if (summaries.find(uid) != summaries.end())
-            {
-                continue;
-            }
-
-            ++missingTotal;
-            if (missingCount < missing.size())
-            {
-                missing[missingCount++] = uid;
-            }
+            return hr;
         }
 
-        if (missingTotal > 0 && missingTotal <= kMaxRepairUids)
-        {
-            const std::span<const uint64_t> missingSpan(missing.data(), missingCount);
-            const HRESULT repairHr = ImapFetchMessageSummaries(conn, serverMailboxPath, missingSpan, summaries);
-            if (FAILED(repairHr))
-            {
-                Debug::Warning(L"imap message summary repair fetch failed: hr={:#x} mailbox='{}' server='{}' missing={}",
-                               repairHr,
-                               mailboxName,
-                               Utf16FromUtf8(conn.host),
-                               missingTotal);
-            }
-            else
-            {
-                for (size_t i = 0; i < missingCount; ++i)
-                {
-                    const uint64_t uid = missing[i];
-                    if (summaries.find(uid) != summaries.end())
-                    {
-                        continue;
-                    }
+        std::sort(uids.begin(), uids.end(), std::greater<>());
+        summaries.reserve(uids.size());
+        metaHr = ImapFetchMessageSummariesChunked(conn, serverMailboxPath, mailboxName, uids, summaries);
+    }
 
-                    const uint64_t singleUid = uid;
-                    const std::span<const uint64_t> one(&singleUid, 1);
-                    const HRESULT singleHr = ImapFetchMessageSummaries(conn, serverMailboxPath, one, summaries);
-                    if (FAILED(singleHr))
-                    {
-                        Debug::Warning(L"imap message summary single-uid repair fetch failed: hr={:#x} mailbox='{}' server='{}' uid={}",
-                                       singleHr,
-                                       mailboxName,
-                                       Utf16FromUtf8(conn.host),
-                                       uid);
-                    }
-                }
-            }
-        }
+    if (uids.empty())
+    {
+        return S_OK;
     }
 
     if (FAILED(metaHr))
@@ -3773,7 +4258,12 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
 {
     if (conn.protocol == Protocol::Imap)
     {
-        return ImapReadDirectoryEntries(conn, path, entries);
+        const HRESULT hr = ImapReadDirectoryEntries(conn, path, entries);
+        if (SUCCEEDED(hr))
+        {
+            StoreImapMailboxSnapshot(conn, JoinPluginPathWide(conn.basePathWide, path), entries);
+        }
+        return hr;
     }
 
     std::string listing;
@@ -3846,6 +4336,12 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
     const std::wstring parent    = ParentPath(normalized);
     const std::wstring_view leaf = LeafName(normalized);
 
+    // Per-message lookups right after a listing (opening or exporting messages) must not list a large mailbox again.
+    if (conn.protocol == Protocol::Imap && TryFindImapSnapshotEntry(conn, JoinPluginPathWide(conn.basePathWide, parent), leaf, out))
+    {
+        return S_OK;
+    }
+
     std::vector<FilesInformationCurl::Entry> entries;
     const HRESULT hr = ReadDirectoryEntries(conn, parent, entries);
     if (FAILED(hr))
@@ -3889,12 +4385,10 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
         return E_INVALIDARG;
     }
 
-    if (conn.protocol == Protocol::Ftp)
-    {
-        return CurlPerformQuote(conn, {std::format("MKD {}", remote)});
-    }
-
-    return CurlPerformQuote(conn, {std::format("mkdir {}", remote)});
+    const HRESULT hr = conn.protocol == Protocol::Ftp ? CurlPerformQuote(conn, {std::format("MKD {}", remote)})
+                                                      : CurlPerformQuote(conn, {std::format("mkdir {}", remote)});
+    InvalidateCachedParentListing(conn, path);
+    return hr;
 }
 
 [[nodiscard]] HRESULT RemoteDeleteFile(const ConnectionInfo& conn, std::wstring_view path) noexcept
@@ -3910,12 +4404,10 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
         return E_INVALIDARG;
     }
 
-    if (conn.protocol == Protocol::Ftp)
-    {
-        return CurlPerformQuote(conn, {std::format("DELE {}", remote)});
-    }
-
-    return CurlPerformQuote(conn, {std::format("rm {}", remote)});
+    const HRESULT hr = conn.protocol == Protocol::Ftp ? CurlPerformQuote(conn, {std::format("DELE {}", remote)})
+                                                      : CurlPerformQuote(conn, {std::format("rm {}", remote)});
+    InvalidateCachedParentListing(conn, path);
+    return hr;
 }
 
 [[nodiscard]] HRESULT RemoteRemoveDirectory(const ConnectionInfo& conn, std::wstring_view path) noexcept
@@ -3931,12 +4423,11 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
         return E_INVALIDARG;
     }
 
-    if (conn.protocol == Protocol::Ftp)
-    {
-        return CurlPerformQuote(conn, {std::format("RMD {}", remote)});
-    }
-
-    return CurlPerformQuote(conn, {std::format("rmdir {}", remote)});
+    const HRESULT hr = conn.protocol == Protocol::Ftp ? CurlPerformQuote(conn, {std::format("RMD {}", remote)})
+                                                      : CurlPerformQuote(conn, {std::format("rmdir {}", remote)});
+    InvalidateCachedParentListing(conn, path);
+    InvalidateCachedListing(conn, path);
+    return hr;
 }
 
 [[nodiscard]] HRESULT RemoteRename(const ConnectionInfo& conn, std::wstring_view sourcePath, std::wstring_view destinationPath) noexcept
@@ -3953,12 +4444,13 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
         return E_INVALIDARG;
     }
 
-    if (conn.protocol == Protocol::Ftp)
-    {
-        return CurlPerformQuote(conn, {std::format("RNFR {}", fromRemote), std::format("RNTO {}", toRemote)});
-    }
-
-    return CurlPerformQuote(conn, {std::format("rename {} {}", fromRemote, toRemote)});
+    const HRESULT hr = conn.protocol == Protocol::Ftp
+                           ? CurlPerformQuote(conn, {std::format("RNFR {}", fromRemote), std::format("RNTO {}", toRemote)})
+                           : CurlPerformQuote(conn, {std::format("rename {} {}", fromRemote, toRemote)});
+    InvalidateCachedParentListing(conn, sourcePath);
+    InvalidateCachedParentListing(conn, destinationPath);
+    InvalidateCachedListing(conn, sourcePath);
+    return hr;
 }
 
 [[nodiscard]] HRESULT EnsureDirectoryExists(const ConnectionInfo& conn, std::wstring_view directoryPath) noexcept
@@ -3998,6 +4490,12 @@ ImapReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view pluginPat
         return HRESULT_FROM_WIN32(ERROR_FILE_EXISTS);
     }
 
+    // The partial file of an interrupted upload stays for the upload to continue (or replace) it.
+    if (HasResumableUpload(conn, destinationPath, existing.sizeBytes))
+    {
+        return S_OK;
+    }
+
     const HRESULT deleteHr = RemoteDeleteFile(conn, destinationPath);
     if (FAILED(deleteHr))
     {
@@ -0,0 +1,483 @@
+#include "FileSystemCurl.Internal.h"
+
+#include <chrono>
+#include <condition_variable>
+
+using namespace FileSystemCurlInternal;
+
+namespace
+{
+constexpr wchar_t kImapCacheDirName[]     = L"Imap";
+constexpr wchar_t kMessageFileExtension[] = L".eml";
+constexpr wchar_t kTempFileExtension[]    = L".part";
+
+// The latest listing of a mailbox answers per-message lookups for this long; only the most recent mailboxes are kept.
+constexpr uint64_t kSnapshotTtlMs = 120'000;
+constexpr size_t kMaxSnapshots    = 8;
+
+// A read within this many messages after the previous one (in listing order, either direction) counts as sequential
+// and starts readahead; a batch stops at whichever limit it reaches first.
+constexpr size_t kSequentialReadWindow = 4;
+constexpr size_t kReadaheadMaxMessages = 64;
+constexpr uint64_t kReadaheadMaxBytes  = 32ull * 1024ull * 1024ull;
+
+// Trimming deletes the least recently used bodies until the cache is back under this share of its budget. Leftover
+// temp files (a crashed or killed process) are removed once they are this old.
+constexpr uint64_t kTrimTargetPercent = 90;
+constexpr auto kStaleTempFileAge      = std::chrono::hours(24);
+constexpr size_t kCopyBufferBytes     = 256u * 1024u;
+constexpr uint64_t kBytesPerMegabyte  = 1024ull * 1024ull;
+
+struct MailboxSnapshot
+{
+    uint64_t capturedTick = 0;
+    std::vector<FilesInformationCurl::Entry> entries;
+    std::unordered_map<std::wstring, size_t> indexByName;
+    std::unordered_map<uint64_t, size_t> indexByUid;
+    size_t lastReadIndex = SIZE_MAX;
+};
+
+std::mutex g_snapshotMutex;
+std::unordered_map<std::wstring, MailboxSnapshot> g_snapshots;
+
+// Cache files a readahead batch is fetching; readers of those messages wait for the batch instead of fetching again.
+std::mutex g_pendingMutex;
+std::condition_variable g_pendingCv;
+std::unordered_set<std::wstring> g_pendingFiles;
+
+// Approximate size of the cache folder; measured once, then kept up to date by commits and trims.
+std::mutex g_trimMutex;
+uint64_t g_cacheBytes  = 0;
+bool g_cacheBytesKnown = false;
+
+std::atomic<uint64_t> g_tempFileCounter{0};
+
+[[nodiscard]] std::filesystem::path GetImapCacheDirectory() noexcept
+{
+    static const std::filesystem::path directory = []() noexcept -> std::filesystem::path
+    {
+        const std::filesystem::path root = GetPluginCacheDirectory();
+        if (root.empty())
+        {
+            return {};
+        }
+
+        std::filesystem::path result = root / kImapCacheDirName;
+
+        std::error_code ec;
+        std::filesystem::create_directories(result, ec);
+        if (ec)
+        {
+            Debug::Warning(L"FileSystemCurl: failed to create IMAP message cache folder '{}' ({})", result.native(), Utf16FromUtf8(ec.message()));
+            return {};
+        }
+        return result;
+    }();
+    return directory;
+}
+
+[[nodiscard]] uint64_t HashMessageKey(std::string_view key) noexcept
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (const char ch : key)
+    {
+        hash ^= static_cast<uint8_t>(ch);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+[[nodiscard]] std::wstring BuildSnapshotKey(const ConnectionInfo& conn, std::wstring_view mailboxPath)
+{
+    const std::wstring normalized   = NormalizePluginPath(mailboxPath);
+    const std::wstring_view trimmed = TrimTrailingSlash(normalized);
+    return std::format(L"{}|{}", Utf16FromUtf8(BuildEndpointKey(conn)), trimmed.empty() ? std::wstring_view(L"/") : trimmed);
+}
+
+[[nodiscard]] bool FileExists(const std::filesystem::path& path) noexcept
+{
+    const DWORD attributes = GetFileAttributesW(path.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+}
+
+// Caller holds g_snapshotMutex.
+void PruneSnapshots(uint64_t now) noexcept
+{
+    std::erase_if(g_snapshots, [now](const auto& item) noexcept { return now - item.second.capturedTick >= kSnapshotTtlMs; });
+
+    while (g_snapshots.size() >= kMaxSnapshots)
+    {
+        auto oldest = g_snapshots.begin();
+        for (auto it = g_snapshots.begin(); it != g_snapshots.end(); ++it)
+        {
+            if (it->second.capturedTick < oldest->second.capturedTick)
+            {
+                oldest = it;
+            }
+        }
+        g_snapshots.erase(oldest);
+    }
+}
+
+// Caller holds g_trimMutex.
+[[nodiscard]] uint64_t TrimCacheDirectory(const std::filesystem::path& directory, uint64_t targetBytes) noexcept
+{
+    struct CachedFile
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastWrite;
+        uint64_t sizeBytes = 0;
+    };
+
+    std::vector<CachedFile> files;
+    uint64_t totalBytes = 0;
+
+    const auto staleBefore = std::filesystem::file_time_type::clock::now() - kStaleTempFileAge;
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directory, ec), end; ! ec && it != end; it.increment(ec))
+    {
+        std::error_code entryEc;
+        if (! it->is_regular_file(entryEc))
+        {
+            continue;
+        }
+
+        const std::filesystem::file_time_type lastWrite = it->last_write_time(entryEc);
+        const uint64_t sizeBytes                        = entryEc ? 0u : static_cast<uint64_t>(it->file_size(entryEc));
+        if (entryEc)
+        {
+            continue;
+        }
+
+        const std::wstring extension = it->path().extension().native();
+        if (extension == kTempFileExtension)
+        {
+            if (lastWrite < staleBefore)
+            {
+                static_cast<void>(DeleteFileW(it->path().c_str()));
+            }
+            continue;
+        }
+
+        if (extension != kMessageFileExtension)
+        {
+            continue;
+        }
+
+        totalBytes += sizeBytes;
+        files.push_back(CachedFile{it->path(), lastWrite, sizeBytes});
+    }
+
+    if (totalBytes <= targetBytes)
+    {
+        return totalBytes;
+    }
+
+    std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) noexcept { return a.lastWrite < b.lastWrite; });
+
+    size_t deleted = 0;
+    for (const CachedFile& file : files)
+    {
+        if (totalBytes <= targetBytes)
+        {
+            break;
+        }
+
+        if (DeleteFileW(file.path.c_str()))
+        {
+            totalBytes -= file.sizeBytes;
+            ++deleted;
+        }
+    }
+
+    Debug::Info(L"FileSystemCurl: trimmed {} cached IMAP messages ({} MB kept)", deleted, totalBytes / kBytesPerMegabyte);
+    return totalBytes;
+}
+} // namespace
+
+namespace FileSystemCurlInternal
+{
+[[nodiscard]] std::filesystem::path
+GetImapMessageCachePath(const ConnectionInfo& conn, std::wstring_view serverMailboxPath, uint64_t uidValidity, uint64_t uid) noexcept
+{
+    const std::filesystem::path& directory = GetImapCacheDirectory();
+    if (directory.empty() || uidValidity == 0)
+    {
+        return {};
+    }
+
+    // protocol|host|port|user|mailbox|uidvalidity|uid; the body behind this key can never change.
+    const std::string key = std::format("{}|{}|{}|{}", BuildEndpointKey(conn), Utf8FromUtf16(serverMailboxPath), uidValidity, uid);
+    return directory / std::format(L"{:016x}{}", HashMessageKey(key), kMessageFileExtension);
+}
+
+[[nodiscard]] HRESULT CopyCachedImapMessage(const std::filesystem::path& cachePath, HANDLE file) noexcept
+{
+    if (cachePath.empty())
+    {
+        return S_FALSE;
+    }
+
+    // FILE_WRITE_ATTRIBUTES does not take part in sharing checks, so concurrent readers of the same body still open it.
+    wil::unique_hfile source(CreateFileW(cachePath.c_str(),
+                                         GENERIC_READ | FILE_WRITE_ATTRIBUTES,
+                                         FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                         nullptr,
+                                         OPEN_EXISTING,
+                                         FILE_FLAG_SEQUENTIAL_SCAN,
+                                         nullptr));
+    if (! source)
+    {
+        const DWORD lastError = GetLastError();
+        return lastError == ERROR_FILE_NOT_FOUND || lastError == ERROR_PATH_NOT_FOUND ? S_FALSE : HRESULT_FROM_WIN32(lastError);
+    }
+
+    // The last write time is the LRU stamp used by trimming.
+    FILETIME now{};
+    GetSystemTimeAsFileTime(&now);
+    static_cast<void>(SetFileTime(source.get(), nullptr, nullptr, &now));
+
+    std::vector<std::byte> buffer(kCopyBufferBytes);
+    while (true)
+    {
+        DWORD read = 0;
+        if (! ReadFile(source.get(), buffer.data(), static_cast<DWORD>(buffer.size()), &read, nullptr))
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+        if (read == 0)
+        {
+            return S_OK;
+        }
+
+        DWORD written = 0;
+        if (! WriteFile(file, buffer.data(), read, &written, nullptr))
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+        if (written != read)
+        {
+            return HRESULT_FROM_WIN32(ERROR_WRITE_FAULT);
+        }
+    }
+}
+
+[[nodiscard]] wil::unique_hfile CreateImapMessageCacheTempFile(std::filesystem::path& outTempPath) noexcept
+{
+    outTempPath.clear();
+
+    const std::filesystem::path& directory = GetImapCacheDirectory();
+    if (directory.empty())
+    {
+        return {};
+    }
+
+    std::filesystem::path tempPath = directory / std::format(L"{:08x}-{:016x}{}", GetCurrentProcessId(), ++g_tempFileCounter, kTempFileExtension);
+    wil::unique_hfile file(CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr));
+    if (file)
+    {
+        outTempPath = std::move(tempPath);
+    }
+    return file;
+}
+
+void CommitImapMessageCacheFile(const ConnectionInfo& conn,
+                                const std::filesystem::path& tempPath,
+                                const std::filesystem::path& cachePath,
+                                uint64_t sizeBytes) noexcept
+{
+    if (tempPath.empty())
+    {
+        return;
+    }
+
+    if (cachePath.empty() || ! MoveFileExW(tempPath.c_str(), cachePath.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        static_cast<void>(DeleteFileW(tempPath.c_str()));
+        return;
+    }
+
+    const uint64_t budgetBytes = static_cast<uint64_t>(std::max(conn.imapMessageCacheMaxMB, FileSystemCurl::kMinImapMessageCacheMB)) * kBytesPerMegabyte;
+
+    std::scoped_lock lock(g_trimMutex);
+    if (g_cacheBytesKnown)
+    {
+        g_cacheBytes += sizeBytes;
+        if (g_cacheBytes <= budgetBytes)
+        {
+            return;
+        }
+    }
+
+    // The first commit of a run measures the folder (trimming only when it is over budget).
+    const uint64_t targetBytes = g_cacheBytesKnown ? budgetBytes / 100u * kTrimTargetPercent : budgetBytes;
+    g_cacheBytes               = TrimCacheDirectory(GetImapCacheDirectory(), targetBytes);
+    g_cacheBytesKnown          = true;
+}
+
+void StoreImapMailboxSnapshot(const ConnectionInfo& conn, std::wstring_view mailboxPath, const std::vector<FilesInformationCurl::Entry>& entries) noexcept
+{
+    MailboxSnapshot snapshot;
+    snapshot.capturedTick = GetTickCount64();
+    snapshot.entries      = entries;
+    snapshot.indexByName.reserve(entries.size());
+    snapshot.indexByUid.reserve(entries.size());
+    for (size_t index = 0; index < entries.size(); ++index)
+    {
+        const FilesInformationCurl::Entry& entry = entries[index];
+        snapshot.indexByName.emplace(entry.name, index);
+
+        uint64_t uid = 0;
+        if ((entry.attributes & FILE_ATTRIBUTE_DIRECTORY) == 0 && TryParseImapUidFromLeafName(entry.name, uid))
+        {
+            snapshot.indexByUid.emplace(uid, index);
+        }
+    }
+
+    std::wstring key = BuildSnapshotKey(conn, mailboxPath);
+
+    std::scoped_lock lock(g_snapshotMutex);
+    g_snapshots.erase(key);
+    PruneSnapshots(snapshot.capturedTick);
+    g_snapshots.emplace(std::move(key), std::move(snapshot));
+}
+
+[[nodiscard]] bool
+TryFindImapSnapshotEntry(const ConnectionInfo& conn, std::wstring_view mailboxPath, std::wstring_view leaf, FilesInformationCurl::Entry& out) noexcept
+{
+    const std::wstring key = BuildSnapshotKey(conn, mailboxPath);
+
+    std::scoped_lock lock(g_snapshotMutex);
+    const auto found = g_snapshots.find(key);
+    if (found == g_snapshots.end() || GetTickCount64() - found->second.capturedTick >= kSnapshotTtlMs)
+    {
+        return false;
+    }
+
+    const auto entry = found->second.indexByName.find(std::wstring(leaf));
+    if (entry == found->second.indexByName.end())
+    {
+        return false;
+    }
+
+    out = found->second.entries[entry->second];
+    return true;
+}
+
+void InvalidateImapMailboxSnapshot(const ConnectionInfo& conn, std::wstring_view mailboxPath) noexcept
+{
+    const std::wstring key = BuildSnapshotKey(conn, mailboxPath);
+
+    std::scoped_lock lock(g_snapshotMutex);
+    g_snapshots.erase(key);
+}
+
+[[nodiscard]] std::vector<uint64_t> ClaimImapReadahead(
+    const ConnectionInfo& conn, std::wstring_view mailboxPath, std::wstring_view serverMailboxPath, uint64_t uidValidity, uint64_t uid) noexcept
+{
+    const std::filesystem::path cachePath = GetImapMessageCachePath(conn, serverMailboxPath, uidValidity, uid);
+    if (cachePath.empty())
+    {
+        return {};
+    }
+
+    {
+        std::unique_lock lock(g_pendingMutex);
+        g_pendingCv.wait(lock, [&]() noexcept { return ! g_pendingFiles.contains(cachePath.native()); });
+        if (FileExists(cachePath))
+        {
+            return {};
+        }
+        g_pendingFiles.insert(cachePath.native());
+    }
+
+    std::vector<uint64_t> claimed;
+    claimed.push_back(uid);
+
+    std::vector<uint64_t> candidates;
+    {
+        const std::wstring key = BuildSnapshotKey(conn, mailboxPath);
+
+        std::scoped_lock lock(g_snapshotMutex);
+        const auto found = g_snapshots.find(key);
+        if (found == g_snapshots.end() || GetTickCount64() - found->second.capturedTick >= kSnapshotTtlMs)
+        {
+            return claimed;
+        }
+
+        MailboxSnapshot& snapshot = found->second;
+        const auto position       = snapshot.indexByUid.find(uid);
+        if (position == snapshot.indexByUid.end())
+        {
+            return claimed;
+        }
+
+        const size_t index    = position->second;
+        const size_t previous = std::exchange(snapshot.lastReadIndex, index);
+        if (previous == SIZE_MAX || previous == index)
+        {
+            return claimed;
+        }
+
+        const bool forward  = index > previous && index - previous <= kSequentialReadWindow;
+        const bool backward = previous > index && previous - index <= kSequentialReadWindow;
+        if (! forward && ! backward)
+        {
+            return claimed;
+        }
+
+        uint64_t batchBytes = snapshot.entries[index].sizeBytes;
+        size_t next         = index;
+        while (candidates.size() + 1u < kReadaheadMaxMessages)
+        {
+            if (forward ? next + 1u >= snapshot.entries.size() : next == 0)
+            {
+                break;
+            }
+            next = forward ? next + 1u : next - 1u;
+
+            const FilesInformationCurl::Entry& entry = snapshot.entries[next];
+            uint64_t nextUid                         = 0;
+            if ((entry.attributes & FILE_ATTRIBUTE_DIRECTORY) != 0 || ! TryParseImapUidFromLeafName(entry.name, nextUid))
+            {
+                break;
+            }
+
+            if (batchBytes + entry.sizeBytes > kReadaheadMaxBytes)
+            {
+                break;
+            }
+            batchBytes += entry.sizeBytes;
+            candidates.push_back(nextUid);
+        }
+    }
+
+    std::scoped_lock lock(g_pendingMutex);
+    for (const uint64_t candidate : candidates)
+    {
+        const std::filesystem::path candidatePath = GetImapMessageCachePath(conn, serverMailboxPath, uidValidity, candidate);
+        if (g_pendingFiles.contains(candidatePath.native()) || FileExists(candidatePath))
+        {
+            continue;
+        }
+
+        g_pendingFiles.insert(candidatePath.native());
+        claimed.push_back(candidate);
+    }
+
+    return claimed;
+}
+
+void ReleaseImapReadahead(const ConnectionInfo& conn, std::wstring_view serverMailboxPath, uint64_t uidValidity, std::span<const uint64_t> uids) noexcept
+{
+    {
+        std::scoped_lock lock(g_pendingMutex);
+        for (const uint64_t uid : uids)
+        {
+            g_pendingFiles.erase(GetImapMessageCachePath(conn, serverMailboxPath, uidValidity, uid).native());
+        }
+    }
+    g_pendingCv.notify_all();
+}
+} // namespace FileSystemCurlInternal
@@ -19,8 +19,10 @@
 #include <mutex>
 #include <new>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -116,6 +118,28 @@ struct ConnectionInfo
     unsigned long operationTimeoutMs = 0;
     bool ignoreSslTrust              = false;
 
+    // Shared curl_multi engine (FileSystemCurl.Multi.cpp); the limit applies per protocol/host/port/user endpoint.
+    bool multiTransferEngine           = true;
+    unsigned int maxConnectionsPerHost = 4;
+
+    // SFTP request window in ~30 KB requests; adaptive windows are learned per endpoint (see GetSftpRequestWindow).
+    unsigned int sftpRequestWindow = 64;
+    bool sftpAdaptiveWindow        = true;
+
+    // Persistent listing cache (FileSystemCurl.ListingCache.cpp); never enabled for IMAP.
+    bool persistentListingCache          = false;
+    unsigned long listingCacheTtlSeconds = 86400;
+
+    // Server-side remote -> remote copy (FileSystemCurl.ServerCopy.cpp); never enabled for IMAP.
+    bool serverSideCopy = true;
+
+    // Resumable FTP/SFTP transfers (FileSystemCurl.Resume.cpp); never enabled for SCP or IMAP.
+    bool resumableTransfers = true;
+
+    // IMAP message body cache (FileSystemCurl.ImapCache.cpp); only used by IMAP.
+    bool imapMessageCache               = true;
+    unsigned long imapMessageCacheMaxMB = 1024;
+
     std::string sshPrivateKey;
     std::string sshPublicKey;
     std::string sshKeyPassphrase;
@@ -268,6 +292,18 @@ HRESULT EnsureCurlInitialized() noexcept;
 [[nodiscard]] HRESULT HResultFromCurl(CURLcode code) noexcept;
 void ApplyCommonCurlOptions(CURL* curl, const ConnectionInfo& conn, const FileSystemOptions* options, bool forUpload) noexcept;
 
+// Identifies a server endpoint (protocol + host + port + user) for per-endpoint limits and tuning.
+[[nodiscard]] std::string BuildEndpointKey(const ConnectionInfo& conn);
+
+// SFTP request window.
+// libssh2 splits SFTP reads/writes into ~30 KB requests and keeps as many outstanding as fit in the buffer libcurl
+// hands it, so ApplyCommonCurlOptions sizes CURLOPT_BUFFERSIZE / CURLOPT_UPLOAD_BUFFERSIZE from this window. With
+// sftpAdaptiveWindow, each endpoint starts at sftpRequestWindow and ObserveSftpTransfer doubles the window while
+// finished transfers run at the window's round-trip bound, and halves it back towards the configured size otherwise.
+[[nodiscard]] unsigned int GetSftpRequestWindow(const ConnectionInfo& conn) noexcept;
+void ObserveSftpTransfer(std::string_view endpointKey, CURL* curl, CURLcode code) noexcept;
+void ObserveSftpTransfer(const ConnectionInfo& conn, CURL* curl, CURLcode code) noexcept;
+
 size_t CurlWriteToString(void* buffer, size_t size, size_t nitems, void* outstream) noexcept;
 [[nodiscard]] std::string BuildUrl(const ConnectionInfo& conn, std::wstring_view pluginPath, bool forDirectory, bool forCommand) noexcept;
 
@@ -519,6 +555,9 @@ struct TransferProgressContext
     uint64_t itemTotalBytes = 0;
     bool isUpload           = false;
 
+    // Bytes a resumed transfer skipped because the destination already holds them; curl counts only the rest.
+    uint64_t resumedBytes = 0;
+
     bool scaleForCopy       = false;
     bool scaleForCopySecond = false; // upload phase
 
@@ -534,6 +573,12 @@ struct TransferProgressContext
     uint64_t lastCancelTick = 0;
     uint64_t lastReportTick = 0;
 
+    // Set when the transfer runs on a curl_multi loop thread: progress callbacks report under this stream id, and the
+    // bandwidth limiter records a resume tick (the engine pauses the transfer) instead of sleeping on the shared thread.
+    uint64_t progressStreamId   = 0;
+    bool deferThrottle          = false;
+    uint64_t throttleResumeTick = 0;
+
     HRESULT abortHr = S_OK;
 
     void Begin() noexcept
@@ -545,10 +590,52 @@ struct TransferProgressContext
         lastReportedItemDone = 0;
         lastReportedOverall  = 0;
         lastThrottleBytes    = 0;
+        throttleResumeTick   = 0;
         abortHr              = S_OK;
     }
 };
 
+int CurlXferInfo(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow) noexcept;
+
+[[nodiscard]] inline HRESULT HResultFromTransfer(CURLcode code, const TransferProgressContext* progressCtx) noexcept
+{
+    if (code == CURLE_ABORTED_BY_CALLBACK && progressCtx && FAILED(progressCtx->abortHr))
+    {
+        return progressCtx->abortHr;
+    }
+    return HResultFromCurl(code);
+}
+
+// Shared curl_multi engine (FileSystemCurl.Multi.cpp).
+// A small fixed set of loop threads drives every submitted easy handle with curl_multi_poll. Handles keep the shared
+// curl_share (DNS / TLS session / connection cache) applied by ApplyCommonCurlOptions, and each endpoint
+// (protocol + host + port + user) runs at most ConnectionInfo::maxConnectionsPerHost transfers at once; the rest wait in
+// a FIFO per endpoint. Completions run on a loop thread and must not block (no CurlPerform / Remote* helpers there).
+using CurlCompletion = std::function<void(CURLcode)>;
+
+// Queues `curl` on the engine. The caller keeps `curl` and `progressCtx` alive until `completion` has run; the handle is
+// already removed from the multi handle when `completion` is invoked.
+[[nodiscard]] HRESULT CurlMultiSubmit(const ConnectionInfo& conn, CURL* curl, TransferProgressContext* progressCtx, CurlCompletion completion) noexcept;
+
+// Runs `curl` to completion: on the engine when ConnectionInfo::multiTransferEngine is set (the calling thread only
+// waits), otherwise with curl_easy_perform. Calls made from a loop thread always use curl_easy_perform.
+[[nodiscard]] CURLcode CurlPerform(const ConnectionInfo& conn, CURL* curl, TransferProgressContext* progressCtx) noexcept;
+
+// Configure an easy handle for a file download/upload (URL, data callbacks, progress, common options) without running it.
+[[nodiscard]] HRESULT PrepareCurlDownload(CURL* curl,
+                                          const ConnectionInfo& conn,
+                                          std::wstring_view pluginPath,
+                                          HANDLE file,
+                                          const FileSystemOptions* options,
+                                          TransferProgressContext* progressCtx) noexcept;
+[[nodiscard]] HRESULT PrepareCurlUpload(CURL* curl,
+                                        const ConnectionInfo& conn,
+                                        std::wstring_view pluginPath,
+                                        HANDLE file,
+                                        uint64_t sizeBytes,
+                                        const FileSystemOptions* options,
+                                        TransferProgressContext* progressCtx) noexcept;
+
 [[nodiscard]] HRESULT CurlDownloadToFile(
     const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, const FileSystemOptions* options, TransferProgressContext* progressCtx) noexcept;
 
@@ -564,6 +651,7 @@ struct TransferProgressContext
 [[nodiscard]] HRESULT GetFileSizeBytes(HANDLE file, uint64_t& out) noexcept;
 
 [[nodiscard]] HRESULT ImapDownloadMessageToFile(const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file) noexcept;
+[[nodiscard]] bool TryParseImapUidFromLeafName(std::wstring_view leafName, uint64_t& outUid) noexcept;
 
 [[nodiscard]] HRESULT ReadDirectoryEntries(const ConnectionInfo& conn, std::wstring_view path, std::vector<FilesInformationCurl::Entry>& entries) noexcept;
 [[nodiscard]] HRESULT GetEntryInfo(const ConnectionInfo& conn, std::wstring_view path, FilesInformationCurl::Entry& out) noexcept;
@@ -573,6 +661,165 @@ struct TransferProgressContext
 [[nodiscard]] HRESULT RemoteRemoveDirectory(const ConnectionInfo& conn, std::wstring_view path) noexcept;
 [[nodiscard]] HRESULT RemoteRename(const ConnectionInfo& conn, std::wstring_view sourcePath, std::wstring_view destinationPath) noexcept;
 
+// Persistent listing cache (FileSystemCurl.ListingCache.cpp).
+// One file per directory under %LOCALAPPDATA%\RedSalamander\Cache\FileSystemCurl, keyed by protocol, host, port, user,
+// base path and directory (never by secrets). Hits are served until listingCacheTtlSeconds after the server last
+// confirmed them; RevalidateCachedListing confirms a listing by directory mtime (SFTP stat / FTP MDTM) when the server
+// reports one and relists otherwise. Every helper is a no-op unless ConnectionInfo::persistentListingCache is set.
+struct CachedListing
+{
+    std::vector<FilesInformationCurl::Entry> entries;
+    int64_t directoryMtime = 0;     // Unix seconds; 0 when the server did not report one
+    bool needsRevalidation = false; // last confirmation is older than the revalidation interval
+};
+
+[[nodiscard]] bool LoadCachedListing(const ConnectionInfo& conn, std::wstring_view remotePath, CachedListing& out) noexcept;
+void StoreCachedListing(const ConnectionInfo& conn,
+                        std::wstring_view remotePath,
+                        const std::vector<FilesInformationCurl::Entry>& entries,
+                        int64_t directoryMtime) noexcept;
+void InvalidateCachedListing(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept;
+void InvalidateCachedParentListing(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept;
+[[nodiscard]] HRESULT ProbeDirectoryMtime(const ConnectionInfo& conn, std::wstring_view remotePath, int64_t& outMtime) noexcept;
+// Sets `changed` when the server listing differs from the cached one (the cache already holds the new listing then).
+[[nodiscard]] HRESULT RevalidateCachedListing(const ConnectionInfo& conn, std::wstring_view remotePath, bool& changed) noexcept;
+
+// %LOCALAPPDATA%\RedSalamander\Cache\FileSystemCurl (created on first use); empty when it cannot be created.
+[[nodiscard]] std::filesystem::path GetPluginCacheDirectory() noexcept;
+
+// IMAP message cache (FileSystemCurl.ImapCache.cpp).
+// A message body never changes while its mailbox keeps the same UIDVALIDITY, so fetched bodies are stored once under
+// the plugin cache folder (Imap), one file per endpoint + mailbox + UIDVALIDITY + UID, and trimmed least recently used
+// first to ConnectionInfo::imapMessageCacheMaxMB. The latest listing of each mailbox also stays in memory for a short
+// while, so per-message lookups and readahead planning do not list the mailbox again.
+[[nodiscard]] std::filesystem::path
+GetImapMessageCachePath(const ConnectionInfo& conn, std::wstring_view serverMailboxPath, uint64_t uidValidity, uint64_t uid) noexcept;
+// Copies a cached body into `file` and marks it recently used; S_FALSE when the message is not cached.
+[[nodiscard]] HRESULT CopyCachedImapMessage(const std::filesystem::path& cachePath, HANDLE file) noexcept;
+// Creates a private file in the cache folder; CommitImapMessageCacheFile publishes it once the body is complete.
+[[nodiscard]] wil::unique_hfile CreateImapMessageCacheTempFile(std::filesystem::path& outTempPath) noexcept;
+void CommitImapMessageCacheFile(const ConnectionInfo& conn,
+                                const std::filesystem::path& tempPath,
+                                const std::filesystem::path& cachePath,
+                                uint64_t sizeBytes) noexcept;
+
+// `mailboxPath` is the plugin path of the listed folder (base path included).
+void StoreImapMailboxSnapshot(const ConnectionInfo& conn, std::wstring_view mailboxPath, const std::vector<FilesInformationCurl::Entry>& entries) noexcept;
+[[nodiscard]] bool
+TryFindImapSnapshotEntry(const ConnectionInfo& conn, std::wstring_view mailboxPath, std::wstring_view leaf, FilesInformationCurl::Entry& out) noexcept;
+void InvalidateImapMailboxSnapshot(const ConnectionInfo& conn, std::wstring_view mailboxPath) noexcept;
+
+// Claims `uid` for fetching into the cache, plus the messages that follow it in the latest listing when reads walk that
+// listing in order. Waits first if another reader's batch holds `uid`, and returns an empty list when that batch cached
+// it. Every claimed UID must be handed back to ReleaseImapReadahead.
+[[nodiscard]] std::vector<uint64_t> ClaimImapReadahead(
+    const ConnectionInfo& conn, std::wstring_view mailboxPath, std::wstring_view serverMailboxPath, uint64_t uidValidity, uint64_t uid) noexcept;
+void ReleaseImapReadahead(const ConnectionInfo& conn, std::wstring_view serverMailboxPath, uint64_t uidValidity, std::span<const uint64_t> uids) noexcept;
+
+// Server-side remote -> remote copy (FileSystemCurl.ServerCopy.cpp).
+// Same SFTP/SCP endpoint: `cp -p` over an SSH exec channel. Same FTP endpoint: SITE CPFR/CPTO (when SITE HELP lists it),
+// then FXP. Different FTP servers: FXP (PASV on the source, PORT on the destination). Methods an endpoint rejects are
+// skipped for a while; every failure leaves the file to the regular download -> upload relay.
+[[nodiscard]] bool IsServerSideCopyCandidate(const ConnectionInfo& sourceConn, const ConnectionInfo& destinationConn) noexcept;
+// Returns S_OK when the server copied the file, S_FALSE when the caller must relay it, or a failure (cancellation).
+[[nodiscard]] HRESULT TryServerSideCopyFile(const ConnectionInfo& sourceConn,
+                                            std::wstring_view sourceRemotePath,
+                                            const ConnectionInfo& destinationConn,
+                                            std::wstring_view destinationRemotePath,
+                                            FileOperationProgress& progress) noexcept;
+
+// Counts, on the calling thread, files copied server-side and files relayed after a server-side attempt, so a
+// successful item can complete with FILESYSTEM_S_COPY_SERVER_SIDE / FILESYSTEM_S_COPY_RELAYED for the task diagnostics.
+struct ServerCopyTallyScope final
+{
+    static inline thread_local unsigned long tlsServerSideFiles = 0;
+    static inline thread_local unsigned long tlsRelayedFiles    = 0;
+
+    ServerCopyTallyScope() noexcept
+        : _previousServerSide(std::exchange(tlsServerSideFiles, 0ul)),
+          _previousRelayed(std::exchange(tlsRelayedFiles, 0ul))
+    {
+    }
+
+    ServerCopyTallyScope(const ServerCopyTallyScope&)            = delete;
+    ServerCopyTallyScope& operator=(const ServerCopyTallyScope&) = delete;
+    ServerCopyTallyScope(ServerCopyTallyScope&&)                 = delete;
+    ServerCopyTallyScope& operator=(ServerCopyTallyScope&&)      = delete;
+
+    ~ServerCopyTallyScope()
+    {
+        tlsServerSideFiles = _previousServerSide;
+        tlsRelayedFiles    = _previousRelayed;
+    }
+
+    [[nodiscard]] static HRESULT ItemStatus(HRESULT hr) noexcept
+    {
+        if (hr != S_OK)
+        {
+            return hr;
+        }
+        if (tlsRelayedFiles > 0)
+        {
+            return FILESYSTEM_S_COPY_RELAYED;
+        }
+        return tlsServerSideFiles > 0 ? FILESYSTEM_S_COPY_SERVER_SIDE : hr;
+    }
+
+private:
+    unsigned long _previousServerSide = 0;
+    unsigned long _previousRelayed    = 0;
+};
+
+// Resumable transfers (FileSystemCurl.Resume.cpp).
+// FTP/SFTP uploads keep a checkpoint under the plugin cache folder (Resume), keyed by endpoint + remote path: the
+// source size when known, a hash of the source's first block, and the byte count the server confirmed with a hash of
+// all the source bytes up to there. A later upload of the same destination (an in-transfer retry, a task retry, or the
+// next session) whose source matches and whose partial file on the server holds the same bytes continues at the
+// server's size (FTP APPE / REST, SFTP offset writes) instead of sending the file again; transient failures resume a
+// few times before the error reaches the caller. Downloads resume from the bytes already received (see
+// OpenDownloadStagingFile). Without ConnectionInfo::resumableTransfers every helper falls back to a plain transfer.
+inline constexpr size_t kResumeBlockBytes = 64u * 1024u;
+inline constexpr uint64_t kResumeHashSeed = 14695981039346656037ull;
+
+// FNV-1a over `size` bytes, continuing from `hash` (start with kResumeHashSeed).
+[[nodiscard]] uint64_t HashResumeBlock(uint64_t hash, const void* data, size_t size) noexcept;
+
+// Counts a failed attempt and returns true (after a short back-off) when the transfer should continue from its
+// confirmed offset: the connection is resumable, the failure is transient and attempts remain.
+[[nodiscard]] bool ShouldResumeTransfer(const ConnectionInfo& conn, CURLcode code, unsigned int& failedAttempts) noexcept;
+
+// True when a fresh checkpoint claims `remotePath` as the partial upload of an earlier attempt (of
+// `existingSizeBytes` bytes on the server); when the caller allows overwriting, such a file is continued instead of deleted.
+[[nodiscard]] bool HasResumableUpload(const ConnectionInfo& conn, std::wstring_view remotePath, uint64_t existingSizeBytes) noexcept;
+[[nodiscard]] bool HasUploadCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept;
+void DiscardUploadCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept;
+
+// Streamed uploads (CurlStreamingWriter) cannot rewind their source, so they only record the checkpoint: once the first
+// block has been written, and again with the server's confirmed size when the transfer fails. The next attempt stages
+// the file and resumes through CurlResumableUploadFromFile.
+void RecordStreamedUploadStart(const ConnectionInfo& conn, std::wstring_view remotePath, uint64_t headHash, uint64_t headBytes) noexcept;
+void RecordStreamedUploadFailure(const ConnectionInfo& conn, std::wstring_view remotePath, uint64_t headHash, uint64_t headBytes) noexcept;
+
+// Records a checkpoint for an upload of `file` that runs outside CurlResumableUploadFromFile (the curl_multi copy
+// pipeline), so a retry of that destination resumes; sources of a single block are not worth resuming.
+void RecordUploadStart(const ConnectionInfo& conn, std::wstring_view remotePath, HANDLE file, uint64_t sizeBytes) noexcept;
+
+// Relay copies and file readers stage downloads in a file next to their checkpoint (Resume folder, one per endpoint +
+// path, opened exclusively), so a host Retry or the next session continues after the bytes already received. Without
+// resumableTransfers, or when the staged file is busy or cannot be created, a delete-on-close temporary file is
+// returned instead. ReleaseDownloadStagingFile drops the staged bytes (deleted when `file` closes) and their checkpoint
+// once the caller no longer needs them.
+[[nodiscard]] wil::unique_hfile OpenDownloadStagingFile(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept;
+void ReleaseDownloadStagingFile(const ConnectionInfo& conn, std::wstring_view remotePath, HANDLE file) noexcept;
+
+// CurlUploadFromFile / CurlDownloadToFile with checkpoints and in-transfer resume. `file` must be seekable; downloads
+// continue after the bytes `file` already holds when its download checkpoint still matches the source, and start over
+// otherwise.
+[[nodiscard]] HRESULT CurlResumableUploadFromFile(
+    const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, uint64_t sizeBytes, TransferProgressContext* progressCtx) noexcept;
+[[nodiscard]] HRESULT
+CurlResumableDownloadToFile(const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, TransferProgressContext* progressCtx) noexcept;
+
 [[nodiscard]] HRESULT EnsureDirectoryExists(const ConnectionInfo& conn, std::wstring_view directoryPath) noexcept;
 [[nodiscard]] HRESULT EnsureOverwriteTargetFile(const ConnectionInfo& conn, std::wstring_view destinationPath, bool allowOverwrite) noexcept;
 } // namespace FileSystemCurlInternal
@@ -0,0 +1,732 @@
+#include "FileSystemCurl.Internal.h"
+
+#include <ShlObj.h>
+
+#include <condition_variable>
+#include <span>
+
+using namespace FileSystemCurlInternal;
+
+namespace
+{
+constexpr wchar_t kCompanyDirName[]       = L"RedSalamander";
+constexpr wchar_t kCacheDirName[]         = L"Cache";
+constexpr wchar_t kPluginCacheDirName[]   = L"FileSystemCurl";
+constexpr wchar_t kListingFileExtension[] = L".lst";
+
+constexpr uint32_t kListingCacheMagic   = 0x4C435352u; // "RSCL"
+constexpr uint32_t kListingCacheVersion = 1u;
+
+// Upper bounds applied when reading cache files; anything larger is treated as corrupt.
+constexpr uint64_t kMaxListingFileBytes = 256ull * 1024ull * 1024ull;
+constexpr uint32_t kMaxListingKeyBytes  = 64u * 1024u;
+constexpr uint32_t kMaxEntryNameChars   = 32u * 1024u;
+
+constexpr int64_t kFileTimeTicksPerSecond = 10'000'000;
+
+// A hit younger than this is shown without scheduling another server round trip; this also stops the refresh that
+// follows a changed revalidation from queueing a new one.
+constexpr int64_t kRevalidateIntervalSeconds = 10;
+
+#pragma pack(push, 1)
+struct ListingFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int64_t savedAt;        // FILETIME ticks
+    int64_t validatedAt;    // FILETIME ticks of the last server confirmation
+    int64_t directoryMtime; // Unix seconds reported by the server; 0 when unknown
+    uint32_t keyBytes;
+    uint32_t entryCount;
+};
+
+struct ListingFileRecord
+{
+    uint32_t fileIndex;
+    uint32_t attributes;
+    uint64_t sizeBytes;
+    int64_t creationTime;
+    int64_t lastAccessTime;
+    int64_t lastWriteTime;
+    int64_t changeTime;
+    uint32_t nameChars;
+};
+#pragma pack(pop)
+
+// Serializes file I/O on the cache folder across instances and revalidation callbacks.
+std::mutex g_listingCacheMutex;
+
+[[nodiscard]] int64_t CurrentFileTimeTicks() noexcept
+{
+    FILETIME now{};
+    GetSystemTimeAsFileTime(&now);
+    return static_cast<int64_t>((static_cast<uint64_t>(now.dwHighDateTime) << 32u) | now.dwLowDateTime);
+}
+
+[[nodiscard]] std::wstring NormalizeListingPath(std::wstring_view path)
+{
+    const std::wstring normalized   = NormalizePluginPath(path);
+    const std::wstring_view trimmed = TrimTrailingSlash(normalized);
+    return trimmed.empty() ? std::wstring(L"/") : std::wstring(trimmed);
+}
+
+// protocol|host|port|user|basePath|path; passwords and key passphrases never take part.
+[[nodiscard]] std::string BuildListingCacheKey(const ConnectionInfo& conn, std::wstring_view remotePath)
+{
+    return std::format("{}|{}|{}", BuildEndpointKey(conn), conn.basePath, Utf8FromUtf16(NormalizeListingPath(remotePath)));
+}
+
+[[nodiscard]] uint64_t HashListingKey(std::string_view key) noexcept
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (const char ch : key)
+    {
+        hash ^= static_cast<uint8_t>(ch);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+[[nodiscard]] std::filesystem::path GetListingFilePath(std::string_view key) noexcept
+{
+    const std::filesystem::path& directory = GetPluginCacheDirectory();
+    if (directory.empty())
+    {
+        return {};
+    }
+    return directory / std::format(L"{:016x}{}", HashListingKey(key), kListingFileExtension);
+}
+
+void AppendBytes(std::vector<std::byte>& buffer, const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const std::byte*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+[[nodiscard]] bool ReadBytes(std::span<const std::byte>& source, void* out, size_t size) noexcept
+{
+    if (source.size() < size)
+    {
+        return false;
+    }
+    std::memcpy(out, source.data(), size);
+    source = source.subspan(size);
+    return true;
+}
+
+[[nodiscard]] bool LoadListingFile(const std::filesystem::path& filePath,
+                                   std::string_view key,
+                                   ListingFileHeader& header,
+                                   std::vector<FilesInformationCurl::Entry>* entries) noexcept
+{
+    wil::unique_hfile file(CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+    if (! file)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (! GetFileSizeEx(file.get(), &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(ListingFileHeader)) ||
+        static_cast<uint64_t>(fileSize.QuadPart) > kMaxListingFileBytes)
+    {
+        return false;
+    }
+
+    std::vector<std::byte> buffer(static_cast<size_t>(fileSize.QuadPart));
+    DWORD read = 0;
+    if (! ReadFile(file.get(), buffer.data(), static_cast<DWORD>(buffer.size()), &read, nullptr) || read != buffer.size())
+    {
+        return false;
+    }
+
+    std::span<const std::byte> source(buffer);
+    if (! ReadBytes(source, &header, sizeof(header)) || header.magic != kListingCacheMagic || header.version != kListingCacheVersion ||
+        header.keyBytes != key.size() || header.keyBytes > kMaxListingKeyBytes || source.size() < header.keyBytes)
+    {
+        return false;
+    }
+
+    if (std::memcmp(source.data(), key.data(), key.size()) != 0)
+    {
+        return false; // hash collision with another directory
+    }
+    source = source.subspan(header.keyBytes);
+
+    if (! entries)
+    {
+        return true;
+    }
+
+    entries->clear();
+    entries->reserve(std::min<size_t>(header.entryCount, source.size() / sizeof(ListingFileRecord)));
+    for (uint32_t index = 0; index < header.entryCount; ++index)
+    {
+        ListingFileRecord record{};
+        if (! ReadBytes(source, &record, sizeof(record)) || record.nameChars == 0 || record.nameChars > kMaxEntryNameChars ||
+            source.size() < record.nameChars * sizeof(wchar_t))
+        {
+            return false;
+        }
+
+        FilesInformationCurl::Entry& entry = entries->emplace_back();
+        entry.name.resize(record.nameChars);
+        static_cast<void>(ReadBytes(source, entry.name.data(), record.nameChars * sizeof(wchar_t)));
+        entry.fileIndex      = record.fileIndex;
+        entry.attributes     = record.attributes;
+        entry.sizeBytes      = record.sizeBytes;
+        entry.creationTime   = record.creationTime;
+        entry.lastAccessTime = record.lastAccessTime;
+        entry.lastWriteTime  = record.lastWriteTime;
+        entry.changeTime     = record.changeTime;
+    }
+
+    return source.empty();
+}
+
+[[nodiscard]] HRESULT WriteListingFile(const std::filesystem::path& filePath,
+                                       std::string_view key,
+                                       const std::vector<FilesInformationCurl::Entry>& entries,
+                                       int64_t savedAt,
+                                       int64_t directoryMtime) noexcept
+{
+    if (key.size() > kMaxListingKeyBytes || entries.size() > (std::numeric_limits<uint32_t>::max)())
+    {
+        return E_INVALIDARG;
+    }
+
+    std::vector<std::byte> buffer;
+    ListingFileHeader header{};
+    header.magic          = kListingCacheMagic;
+    header.version        = kListingCacheVersion;
+    header.savedAt        = savedAt;
+    header.validatedAt    = CurrentFileTimeTicks();
+    header.directoryMtime = directoryMtime;
+    header.keyBytes       = static_cast<uint32_t>(key.size());
+    header.entryCount     = static_cast<uint32_t>(entries.size());
+
+    size_t totalBytes = sizeof(header) + key.size();
+    for (const auto& entry : entries)
+    {
+        totalBytes += sizeof(ListingFileRecord) + entry.name.size() * sizeof(wchar_t);
+    }
+    if (totalBytes > kMaxListingFileBytes)
+    {
+        return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+    }
+
+    buffer.reserve(totalBytes);
+    AppendBytes(buffer, &header, sizeof(header));
+    AppendBytes(buffer, key.data(), key.size());
+    for (const auto& entry : entries)
+    {
+        if (entry.name.empty() || entry.name.size() > kMaxEntryNameChars)
+        {
+            return E_INVALIDARG;
+        }
+
+        ListingFileRecord record{};
+        record.fileIndex      = entry.fileIndex;
+        record.attributes     = entry.attributes;
+        record.sizeBytes      = entry.sizeBytes;
+        record.creationTime   = entry.creationTime;
+        record.lastAccessTime = entry.lastAccessTime;
+        record.lastWriteTime  = entry.lastWriteTime;
+        record.changeTime     = entry.changeTime;
+        record.nameChars      = static_cast<uint32_t>(entry.name.size());
+        AppendBytes(buffer, &record, sizeof(record));
+        AppendBytes(buffer, entry.name.data(), entry.name.size() * sizeof(wchar_t));
+    }
+
+    // Write next to the final file and swap it in so readers never see a partial listing.
+    std::filesystem::path tempPath = filePath;
+    tempPath += std::format(L".{}.tmp", GetCurrentThreadId());
+
+    {
+        wil::unique_hfile file(CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (! file)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        DWORD written = 0;
+        if (! WriteFile(file.get(), buffer.data(), static_cast<DWORD>(buffer.size()), &written, nullptr) || written != buffer.size())
+        {
+            const DWORD lastError = GetLastError();
+            file.reset();
+            static_cast<void>(DeleteFileW(tempPath.c_str()));
+            return HRESULT_FROM_WIN32(lastError != ERROR_SUCCESS ? lastError : ERROR_WRITE_FAULT);
+        }
+    }
+
+    if (! MoveFileExW(tempPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        const DWORD lastError = GetLastError();
+        static_cast<void>(DeleteFileW(tempPath.c_str()));
+        return HRESULT_FROM_WIN32(lastError);
+    }
+
+    return S_OK;
+}
+
+[[nodiscard]] bool SameListing(const std::vector<FilesInformationCurl::Entry>& a, const std::vector<FilesInformationCurl::Entry>& b) noexcept
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (size_t index = 0; index < a.size(); ++index)
+    {
+        const auto& left  = a[index];
+        const auto& right = b[index];
+        if (left.name != right.name || left.attributes != right.attributes || left.sizeBytes != right.sizeBytes ||
+            left.lastWriteTime != right.lastWriteTime)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+namespace FileSystemCurlInternal
+{
+[[nodiscard]] std::filesystem::path GetPluginCacheDirectory() noexcept
+{
+    static const std::filesystem::path directory = []() noexcept -> std::filesystem::path
+    {
+        wil::unique_cotaskmem_string localAppData;
+        const HRESULT hr = SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, localAppData.put());
+        if (FAILED(hr) || ! localAppData)
+        {
+            return {};
+        }
+
+        std::filesystem::path result = std::filesystem::path(localAppData.get()) / kCompanyDirName / kCacheDirName / kPluginCacheDirName;
+
+        std::error_code ec;
+        std::filesystem::create_directories(result, ec);
+        if (ec)
+        {
+            Debug::Warning(L"FileSystemCurl: failed to create cache folder '{}' ({})", result.native(), Utf16FromUtf8(ec.message()));
+            return {};
+        }
+        return result;
+    }();
+    return directory;
+}
+
+[[nodiscard]] bool LoadCachedListing(const ConnectionInfo& conn, std::wstring_view remotePath, CachedListing& out) noexcept
+{
+    if (! conn.persistentListingCache)
+    {
+        return false;
+    }
+
+    const std::string key                = BuildListingCacheKey(conn, remotePath);
+    const std::filesystem::path filePath = GetListingFilePath(key);
+    if (filePath.empty())
+    {
+        return false;
+    }
+
+    ListingFileHeader header{};
+    std::scoped_lock lock(g_listingCacheMutex);
+    if (! LoadListingFile(filePath, key, header, &out.entries))
+    {
+        out.entries.clear();
+        return false;
+    }
+
+    const int64_t now           = CurrentFileTimeTicks();
+    const int64_t ttlTicks      = static_cast<int64_t>(conn.listingCacheTtlSeconds) * kFileTimeTicksPerSecond;
+    const int64_t intervalTicks = kRevalidateIntervalSeconds * kFileTimeTicksPerSecond;
+    if (header.validatedAt > now || now - header.validatedAt >= ttlTicks)
+    {
+        out.entries.clear();
+        static_cast<void>(DeleteFileW(filePath.c_str()));
+        return false;
+    }
+
+    out.directoryMtime    = header.directoryMtime;
+    out.needsRevalidation = now - header.validatedAt >= intervalTicks;
+    return true;
+}
+
+void StoreCachedListing(const ConnectionInfo& conn,
+                        std::wstring_view remotePath,
+                        const std::vector<FilesInformationCurl::Entry>& entries,
+                        int64_t directoryMtime) noexcept
+{
+    if (! conn.persistentListingCache)
+    {
+        return;
+    }
+
+    const std::string key                = BuildListingCacheKey(conn, remotePath);
+    const std::filesystem::path filePath = GetListingFilePath(key);
+    if (filePath.empty())
+    {
+        return;
+    }
+
+    std::scoped_lock lock(g_listingCacheMutex);
+
+    // Keep the original save time when the server only confirmed an existing listing.
+    ListingFileHeader previous{};
+    const int64_t savedAt = LoadListingFile(filePath, key, previous, nullptr) && directoryMtime != 0 && previous.directoryMtime == directoryMtime
+                                ? previous.savedAt
+                                : CurrentFileTimeTicks();
+
+    const HRESULT hr = WriteListingFile(filePath, key, entries, savedAt, directoryMtime);
+    if (FAILED(hr))
+    {
+        Debug::Warning(L"FileSystemCurl: failed to store listing cache for '{}' (hr=0x{:08X})", remotePath, static_cast<unsigned long>(hr));
+    }
+}
+
+void InvalidateCachedListing(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept
+{
+    if (! conn.persistentListingCache)
+    {
+        return;
+    }
+
+    const std::filesystem::path filePath = GetListingFilePath(BuildListingCacheKey(conn, remotePath));
+    if (filePath.empty())
+    {
+        return;
+    }
+
+    std::scoped_lock lock(g_listingCacheMutex);
+    static_cast<void>(DeleteFileW(filePath.c_str()));
+}
+
+void InvalidateCachedParentListing(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept
+{
+    if (! conn.persistentListingCache)
+    {
+        return;
+    }
+
+    InvalidateCachedListing(conn, ParentPath(remotePath));
+}
+
+[[nodiscard]] HRESULT ProbeDirectoryMtime(const ConnectionInfo& conn, std::wstring_view remotePath, int64_t& outMtime) noexcept
+{
+    outMtime = 0;
+
+    // SFTP stats the directory itself; FTP asks MDTM for it (servers that refuse MDTM on folders fail the probe).
+    // SCP has no stat, so every revalidation relists.
+    if (conn.protocol != Protocol::Sftp && conn.protocol != Protocol::Ftp)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    HRESULT hr = EnsureCurlInitialized();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    unique_curl_easy curl{curl_easy_init()};
+    if (! curl)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    const std::wstring directoryPath = NormalizeListingPath(remotePath);
+    const std::string url            = BuildUrl(conn, directoryPath, conn.protocol == Protocol::Sftp, false);
+    if (url.empty())
+    {
+        return E_INVALIDARG;
+    }
+
+    curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_FILETIME, 1L);
+    ApplyCommonCurlOptions(curl.get(), conn, nullptr, false);
+
+    const CURLcode code = CurlPerform(conn, curl.get(), nullptr);
+    if (code != CURLE_OK)
+    {
+        return HResultFromCurl(code);
+    }
+
+    curl_off_t fileTime = -1;
+    if (curl_easy_getinfo(curl.get(), CURLINFO_FILETIME_T, &fileTime) != CURLE_OK || fileTime <= 0)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    outMtime = static_cast<int64_t>(fileTime);
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT RevalidateCachedListing(const ConnectionInfo& conn, std::wstring_view remotePath, bool& changed) noexcept
+{
+    changed = false;
+
+    CachedListing cached;
+    if (! LoadCachedListing(conn, remotePath, cached))
+    {
+        return S_FALSE; // invalidated or expired meanwhile; the next read lists the folder anyway
+    }
+
+    int64_t directoryMtime = 0;
+    if (SUCCEEDED(ProbeDirectoryMtime(conn, remotePath, directoryMtime)) && directoryMtime != 0 && directoryMtime == cached.directoryMtime)
+    {
+        StoreCachedListing(conn, remotePath, cached.entries, directoryMtime);
+        return S_OK;
+    }
+
+    std::vector<FilesInformationCurl::Entry> entries;
+    const HRESULT hr = ReadDirectoryEntries(conn, remotePath, entries);
+    if (FAILED(hr))
+    {
+        if (hr == HRESULT_FROM_WIN32(ERROR_PATH_NOT_FOUND) || hr == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+        {
+            InvalidateCachedListing(conn, remotePath);
+            changed = true;
+        }
+        return hr;
+    }
+
+    changed = ! SameListing(cached.entries, entries);
+    StoreCachedListing(conn, remotePath, entries, directoryMtime);
+    return S_OK;
+}
+} // namespace FileSystemCurlInternal
+
+// FileSystemCurl (IFileSystemDirectoryWatch)
+
+namespace
+{
+thread_local const void* g_activeDirectoryWatchCallback = nullptr;
+
+struct DirectoryWatchCallbackScope final
+{
+    explicit DirectoryWatchCallbackScope(const void* watcher) noexcept : _previous(g_activeDirectoryWatchCallback)
+    {
+        g_activeDirectoryWatchCallback = watcher;
+    }
+
+    DirectoryWatchCallbackScope(const DirectoryWatchCallbackScope&)            = delete;
+    DirectoryWatchCallbackScope& operator=(const DirectoryWatchCallbackScope&) = delete;
+    DirectoryWatchCallbackScope(DirectoryWatchCallbackScope&&)                 = delete;
+    DirectoryWatchCallbackScope& operator=(DirectoryWatchCallbackScope&&)      = delete;
+
+    ~DirectoryWatchCallbackScope()
+    {
+        g_activeDirectoryWatchCallback = _previous;
+    }
+
+private:
+    const void* _previous = nullptr;
+};
+
+struct ListingRevalidationJob
+{
+    FileSystemCurl* owner = nullptr;
+    HMODULE module        = nullptr;
+    std::wstring path;
+};
+} // namespace
+
+HRESULT STDMETHODCALLTYPE FileSystemCurl::WatchDirectory(const wchar_t* path, IFileSystemDirectoryWatchCallback* callback, void* cookie) noexcept
+{
+    if (! path || ! callback)
+    {
+        return E_POINTER;
+    }
+
+    if (path[0] == L'\0')
+    {
+        return E_INVALIDARG;
+    }
+
+    auto watch         = std::make_shared<DirectoryWatchRegistration>();
+    watch->watchedPath = path;
+    watch->matchPath   = NormalizeListingPath(path);
+    watch->callback    = callback;
+    watch->cookie      = cookie;
+
+    std::lock_guard lock(_watchMutex);
+    for (const auto& existing : _directoryWatches)
+    {
+        if (existing && existing->active.load(std::memory_order_acquire) && existing->matchPath == watch->matchPath)
+        {
+            return HRESULT_FROM_WIN32(ERROR_ALREADY_EXISTS);
+        }
+    }
+
+    _directoryWatches.push_back(std::move(watch));
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE FileSystemCurl::UnwatchDirectory(const wchar_t* path) noexcept
+{
+    if (! path)
+    {
+        return E_POINTER;
+    }
+
+    if (path[0] == L'\0')
+    {
+        return E_INVALIDARG;
+    }
+
+    const std::wstring matchPath = NormalizeListingPath(path);
+
+    std::unique_lock lock(_watchMutex);
+
+    std::shared_ptr<DirectoryWatchRegistration> removed;
+    for (auto it = _directoryWatches.begin(); it != _directoryWatches.end(); ++it)
+    {
+        if (*it && (*it)->matchPath == matchPath)
+        {
+            removed = *it;
+            _directoryWatches.erase(it);
+            break;
+        }
+    }
+
+    if (! removed)
+    {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+
+    removed->active.store(false, std::memory_order_release);
+    const bool reentrant           = static_cast<const void*>(removed.get()) == g_activeDirectoryWatchCallback;
+    const uint32_t desiredInFlight = reentrant ? 1u : 0u;
+    _watchCv.wait(lock, [&] { return removed->inFlight.load(std::memory_order_acquire) <= desiredInFlight; });
+    return S_OK;
+}
+
+void FileSystemCurl::NotifyListingChanged(std::wstring_view path) noexcept
+{
+    const std::wstring matchPath = NormalizeListingPath(path);
+
+    std::vector<std::shared_ptr<DirectoryWatchRegistration>> watchers;
+    {
+        std::lock_guard lock(_watchMutex);
+        for (const auto& entry : _directoryWatches)
+        {
+            if (entry && entry->active.load(std::memory_order_acquire) && entry->matchPath == matchPath)
+            {
+                entry->inFlight.fetch_add(1u, std::memory_order_acq_rel);
+                watchers.push_back(entry);
+            }
+        }
+    }
+
+    // The listing was replaced wholesale, so report an overflow and let the host resync the folder from the cache.
+    for (const auto& watcher : watchers)
+    {
+        FileSystemDirectoryChangeNotification notification{};
+        notification.watchedPath     = watcher->watchedPath.c_str();
+        notification.watchedPathSize = static_cast<unsigned long>(watcher->watchedPath.size() * sizeof(wchar_t));
+        notification.changes         = nullptr;
+        notification.changeCount     = 0;
+        notification.overflow        = TRUE;
+
+        if (watcher->active.load(std::memory_order_acquire) && watcher->callback)
+        {
+            DirectoryWatchCallbackScope callbackScope(watcher.get());
+            watcher->callback->FileSystemDirectoryChanged(&notification, watcher->cookie);
+        }
+
+        const uint32_t remaining = watcher->inFlight.fetch_sub(1u, std::memory_order_acq_rel) - 1u;
+        if (remaining == 0u || ! watcher->active.load(std::memory_order_acquire))
+        {
+            _watchCv.notify_all();
+        }
+    }
+}
+
+void FileSystemCurl::QueueListingRevalidation(std::wstring_view path) noexcept
+{
+    auto job = std::unique_ptr<ListingRevalidationJob>(new (std::nothrow) ListingRevalidationJob());
+    if (! job)
+    {
+        return;
+    }
+
+    job->path = NormalizeListingPath(path);
+
+    {
+        std::lock_guard lock(_watchMutex);
+        if (! _pendingRevalidations.insert(job->path).second)
+        {
+            return; // already queued
+        }
+    }
+
+    // The callback keeps both this instance and the plugin module alive until it returns.
+    static_cast<void>(GetModuleHandleExW(
+        GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, reinterpret_cast<LPCWSTR>(&FileSystemCurlInternal::RevalidateCachedListing), &job->module));
+    AddRef();
+    job->owner = this;
+
+    const BOOL ok = TrySubmitThreadpoolCallback(
+        [](PTP_CALLBACK_INSTANCE instance, void* context) noexcept
+        {
+            std::unique_ptr<ListingRevalidationJob> job(static_cast<ListingRevalidationJob*>(context));
+            job->owner->RevalidateListing(job->path);
+            job->owner->Release();
+            if (job->module)
+            {
+                FreeLibraryWhenCallbackReturns(instance, job->module);
+            }
+        },
+        job.get(),
+        nullptr);
+
+    if (! ok)
+    {
+        {
+            std::lock_guard lock(_watchMutex);
+            _pendingRevalidations.erase(job->path);
+        }
+        if (job->module)
+        {
+            FreeLibrary(job->module);
+        }
+        Release();
+        return;
+    }
+
+    static_cast<void>(job.release());
+}
+
+void FileSystemCurl::RevalidateListing(const std::wstring& path) noexcept
+{
+    Settings settings;
+    {
+        std::lock_guard lock(_stateMutex);
+        settings = _settings;
+    }
+
+    bool changed     = false;
+    const HRESULT hr = ResolveLocationWithAuthRetry(_protocol,
+                                                    settings,
+                                                    path,
+                                                    _hostConnections.get(),
+                                                    true,
+                                                    [&](const ResolvedLocation& resolved) noexcept
+                                                    { return RevalidateCachedListing(resolved.connection, resolved.remotePath, changed); });
+    if (FAILED(hr))
+    {
+        Debug::Warning(L"FileSystemCurl: listing revalidation failed for '{}' (hr=0x{:08X})", path, static_cast<unsigned long>(hr));
+    }
+
+    {
+        std::lock_guard lock(_watchMutex);
+        _pendingRevalidations.erase(path);
+    }
+
+    if (changed)
+    {
+        NotifyListingChanged(path);
+    }
+}
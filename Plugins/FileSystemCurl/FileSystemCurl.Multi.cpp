@@ -0,0 +1,459 @@
+#include "FileSystemCurl.Internal.h"
+
+#include <condition_variable>
+#include <deque>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+using namespace FileSystemCurlInternal;
+
+namespace
+{
+// Loop threads shared by every FileSystemCurl instance; an endpoint always maps to the same loop so its connection
+// limit is enforced without cross-thread bookkeeping.
+constexpr size_t kMultiLoopCount = 2u;
+constexpr int kIdlePollMs        = 1000;
+
+thread_local bool tlsOnMultiLoop = false;
+
+struct CurlMultiDeleter
+{
+    void operator()(CURLM* multi) const noexcept
+    {
+        if (multi)
+        {
+            curl_multi_cleanup(multi);
+        }
+    }
+};
+
+using unique_curl_multi = std::unique_ptr<CURLM, CurlMultiDeleter>;
+
+struct MultiTransfer final
+{
+    CURL* curl                           = nullptr;
+    TransferProgressContext* progressCtx = nullptr;
+    std::string endpointKey;
+    unsigned int connectionLimit = 1;
+    CurlCompletion completion;
+
+    // Non-zero while the bandwidth limiter keeps the transfer paused (loop thread only).
+    uint64_t resumeTick = 0;
+};
+
+[[nodiscard]] bool IsTransferCancelled(const MultiTransfer& transfer) noexcept
+{
+    return transfer.progressCtx && transfer.progressCtx->progress && transfer.progressCtx->progress->internalCancel.load(std::memory_order_acquire);
+}
+
+int MultiXferInfo(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow) noexcept
+{
+    auto* transfer = static_cast<MultiTransfer*>(clientp);
+    if (! transfer || ! transfer->progressCtx)
+    {
+        return 0;
+    }
+
+    TransferProgressContext* ctx = transfer->progressCtx;
+    FileOperationProgress::ProgressStreamScope streamScope(ctx->progressStreamId);
+
+    const int result = CurlXferInfo(ctx, dltotal, dlnow, ultotal, ulnow);
+    if (result == 0 && ctx->throttleResumeTick != 0)
+    {
+        transfer->resumeTick = std::exchange(ctx->throttleResumeTick, 0);
+        curl_easy_pause(transfer->curl, CURLPAUSE_ALL);
+    }
+    return result;
+}
+
+class CurlMultiLoop final
+{
+public:
+    CurlMultiLoop() = default;
+
+    CurlMultiLoop(const CurlMultiLoop&)            = delete;
+    CurlMultiLoop(CurlMultiLoop&&)                 = delete;
+    CurlMultiLoop& operator=(const CurlMultiLoop&) = delete;
+    CurlMultiLoop& operator=(CurlMultiLoop&&)      = delete;
+
+    ~CurlMultiLoop() noexcept
+    {
+        Stop();
+    }
+
+    [[nodiscard]] HRESULT Start() noexcept
+    {
+        _multi.reset(curl_multi_init());
+        if (! _multi)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        try
+        {
+            _thread = std::jthread([this](std::stop_token stopToken) noexcept { LoopMain(stopToken); });
+        }
+        catch (const std::system_error&)
+        {
+            _multi.reset();
+            return E_OUTOFMEMORY;
+        }
+
+        return S_OK;
+    }
+
+    void Submit(std::unique_ptr<MultiTransfer> transfer) noexcept
+    {
+        {
+            std::scoped_lock lock(_mutex);
+            _incoming.push_back(std::move(transfer));
+        }
+        curl_multi_wakeup(_multi.get());
+    }
+
+    void Stop() noexcept
+    {
+        if (! _thread.joinable())
+        {
+            return;
+        }
+
+        _thread.request_stop();
+        curl_multi_wakeup(_multi.get());
+        _thread.join();
+    }
+
+private:
+    struct Endpoint final
+    {
+        unsigned int active = 0;
+        std::deque<std::unique_ptr<MultiTransfer>> pending;
+    };
+
+    void Complete(std::unique_ptr<MultiTransfer> transfer, CURLcode code) noexcept
+    {
+        if (transfer && transfer->completion)
+        {
+            transfer->completion(code);
+        }
+    }
+
+    void StartTransfer(std::unique_ptr<MultiTransfer> transfer, Endpoint& endpoint) noexcept
+    {
+        if (IsTransferCancelled(*transfer))
+        {
+            Complete(std::move(transfer), CURLE_ABORTED_BY_CALLBACK);
+            return;
+        }
+
+        if (transfer->progressCtx)
+        {
+            transfer->progressCtx->deferThrottle = true;
+            curl_easy_setopt(transfer->curl, CURLOPT_XFERINFOFUNCTION, MultiXferInfo);
+            curl_easy_setopt(transfer->curl, CURLOPT_XFERINFODATA, transfer.get());
+            curl_easy_setopt(transfer->curl, CURLOPT_NOPROGRESS, 0L);
+        }
+
+        if (curl_multi_add_handle(_multi.get(), transfer->curl) != CURLM_OK)
+        {
+            Complete(std::move(transfer), CURLE_FAILED_INIT);
+            return;
+        }
+
+        endpoint.active += 1;
+        CURL* curl = transfer->curl;
+        _running.emplace(curl, std::move(transfer));
+    }
+
+    void Admit(std::unique_ptr<MultiTransfer> transfer) noexcept
+    {
+        const auto [found, inserted] = _endpoints.try_emplace(transfer->endpointKey);
+        Endpoint& endpoint           = found->second;
+        if (endpoint.active < transfer->connectionLimit)
+        {
+            StartTransfer(std::move(transfer), endpoint);
+            if (endpoint.active == 0 && endpoint.pending.empty())
+            {
+                _endpoints.erase(found); // completed without starting (cancelled or rejected)
+            }
+            return;
+        }
+
+        endpoint.pending.push_back(std::move(transfer));
+    }
+
+    void Release(const std::string& endpointKey) noexcept
+    {
+        const auto found = _endpoints.find(endpointKey);
+        if (found == _endpoints.end())
+        {
+            return;
+        }
+
+        Endpoint& endpoint = found->second;
+        if (endpoint.active > 0)
+        {
+            endpoint.active -= 1;
+        }
+
+        while (! endpoint.pending.empty() && endpoint.active < endpoint.pending.front()->connectionLimit)
+        {
+            std::unique_ptr<MultiTransfer> next = std::move(endpoint.pending.front());
+            endpoint.pending.pop_front();
+            StartTransfer(std::move(next), endpoint);
+        }
+
+        if (endpoint.active == 0 && endpoint.pending.empty())
+        {
+            _endpoints.erase(found);
+        }
+    }
+
+    // Resumes transfers whose throttle delay elapsed and returns the poll timeout until the next one is due.
+    [[nodiscard]] int ResumePausedTransfers() noexcept
+    {
+        const uint64_t now = GetTickCount64();
+        uint64_t waitMs    = static_cast<uint64_t>(kIdlePollMs);
+        for (auto& [curl, transfer] : _running)
+        {
+            if (transfer->resumeTick == 0)
+            {
+                continue;
+            }
+
+            if (transfer->resumeTick <= now || IsTransferCancelled(*transfer))
+            {
+                transfer->resumeTick = 0;
+                curl_easy_pause(curl, CURLPAUSE_CONT);
+                waitMs = 0;
+                continue;
+            }
+
+            waitMs = (std::min)(waitMs, transfer->resumeTick - now);
+        }
+        return static_cast<int>(waitMs);
+    }
+
+    void LoopMain(std::stop_token stopToken) noexcept
+    {
+        tlsOnMultiLoop = true;
+
+        std::vector<std::unique_ptr<MultiTransfer>> incoming;
+        while (! stopToken.stop_requested())
+        {
+            {
+                std::scoped_lock lock(_mutex);
+                incoming.swap(_incoming);
+            }
+
+            for (std::unique_ptr<MultiTransfer>& transfer : incoming)
+            {
+                Admit(std::move(transfer));
+            }
+            incoming.clear();
+
+            const int pollMs = ResumePausedTransfers();
+
+            int stillRunning = 0;
+            curl_multi_perform(_multi.get(), &stillRunning);
+
+            int queued = 0;
+            while (CURLMsg* message = curl_multi_info_read(_multi.get(), &queued))
+            {
+                if (message->msg != CURLMSG_DONE)
+                {
+                    continue;
+                }
+
+                // The message does not survive curl_multi_remove_handle.
+                CURL* curl          = message->easy_handle;
+                const CURLcode code = message->data.result;
+                curl_multi_remove_handle(_multi.get(), curl);
+
+                const auto found = _running.find(curl);
+                if (found == _running.end())
+                {
+                    continue;
+                }
+
+                std::unique_ptr<MultiTransfer> transfer = std::move(found->second);
+                _running.erase(found);
+
+                ObserveSftpTransfer(transfer->endpointKey, curl, code);
+                Release(transfer->endpointKey);
+                Complete(std::move(transfer), code);
+            }
+
+            curl_multi_poll(_multi.get(), nullptr, 0, pollMs, nullptr);
+        }
+
+        // Teardown: fail everything still owned by this loop so waiters can proceed.
+        for (auto& [curl, transfer] : _running)
+        {
+            curl_multi_remove_handle(_multi.get(), curl);
+            Complete(std::move(transfer), CURLE_ABORTED_BY_CALLBACK);
+        }
+        _running.clear();
+
+        for (auto& [key, endpoint] : _endpoints)
+        {
+            for (std::unique_ptr<MultiTransfer>& transfer : endpoint.pending)
+            {
+                Complete(std::move(transfer), CURLE_ABORTED_BY_CALLBACK);
+            }
+        }
+        _endpoints.clear();
+
+        {
+            std::scoped_lock lock(_mutex);
+            incoming.swap(_incoming);
+        }
+        for (std::unique_ptr<MultiTransfer>& transfer : incoming)
+        {
+            Complete(std::move(transfer), CURLE_ABORTED_BY_CALLBACK);
+        }
+    }
+
+    unique_curl_multi _multi;
+    std::jthread _thread;
+
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<MultiTransfer>> _incoming;
+
+    // Loop thread only.
+    std::unordered_map<CURL*, std::unique_ptr<MultiTransfer>> _running;
+    std::unordered_map<std::string, Endpoint> _endpoints;
+};
+
+class CurlMultiEngine final
+{
+public:
+    CurlMultiEngine() = default;
+
+    CurlMultiEngine(const CurlMultiEngine&)            = delete;
+    CurlMultiEngine(CurlMultiEngine&&)                 = delete;
+    CurlMultiEngine& operator=(const CurlMultiEngine&) = delete;
+    CurlMultiEngine& operator=(CurlMultiEngine&&)      = delete;
+
+    ~CurlMultiEngine() noexcept
+    {
+        for (std::unique_ptr<CurlMultiLoop>& loop : _loops)
+        {
+            loop->Stop();
+        }
+    }
+
+    [[nodiscard]] HRESULT Submit(std::unique_ptr<MultiTransfer> transfer) noexcept
+    {
+        const HRESULT hr = EnsureLoops();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        const size_t index = std::hash<std::string>{}(transfer->endpointKey) % _loops.size();
+        _loops[index]->Submit(std::move(transfer));
+        return S_OK;
+    }
+
+private:
+    [[nodiscard]] HRESULT EnsureLoops() noexcept
+    {
+        std::call_once(_initOnce,
+                       [this]() noexcept
+                       {
+                           _initResult = EnsureCurlInitialized();
+                           if (FAILED(_initResult))
+                           {
+                               return;
+                           }
+
+                           for (size_t i = 0; i < kMultiLoopCount; ++i)
+                           {
+                               auto loop = std::make_unique<CurlMultiLoop>();
+                               if (FAILED(loop->Start()))
+                               {
+                                   break;
+                               }
+                               _loops.push_back(std::move(loop));
+                           }
+
+                           if (_loops.empty())
+                           {
+                               Debug::Error(L"FileSystemCurl: failed to start the curl_multi engine; falling back to blocking transfers");
+                               _initResult = E_FAIL;
+                           }
+                       });
+
+        return _initResult;
+    }
+
+    std::once_flag _initOnce;
+    HRESULT _initResult = E_FAIL;
+    std::vector<std::unique_ptr<CurlMultiLoop>> _loops;
+};
+
+CurlMultiEngine& GetCurlMultiEngine() noexcept
+{
+    static CurlMultiEngine engine;
+    return engine;
+}
+} // namespace
+
+namespace FileSystemCurlInternal
+{
+[[nodiscard]] HRESULT CurlMultiSubmit(const ConnectionInfo& conn, CURL* curl, TransferProgressContext* progressCtx, CurlCompletion completion) noexcept
+{
+    if (! curl)
+    {
+        return E_INVALIDARG;
+    }
+
+    auto transfer             = std::make_unique<MultiTransfer>();
+    transfer->curl            = curl;
+    transfer->progressCtx     = progressCtx;
+    transfer->endpointKey     = BuildEndpointKey(conn);
+    transfer->connectionLimit = std::clamp(conn.maxConnectionsPerHost, 1u, FileSystemCurl::kMaxConnectionsPerHostLimit);
+    transfer->completion      = std::move(completion);
+    return GetCurlMultiEngine().Submit(std::move(transfer));
+}
+
+[[nodiscard]] CURLcode CurlPerform(const ConnectionInfo& conn, CURL* curl, TransferProgressContext* progressCtx) noexcept
+{
+    if (! conn.multiTransferEngine || tlsOnMultiLoop)
+    {
+        const CURLcode code = curl_easy_perform(curl);
+        ObserveSftpTransfer(conn, curl, code);
+        return code;
+    }
+
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    bool done        = false;
+    CURLcode outcome = CURLE_OK;
+
+    const HRESULT hr = CurlMultiSubmit(conn,
+                                       curl,
+                                       progressCtx,
+                                       [&](CURLcode code) noexcept
+                                       {
+                                           // Notify under the lock: the waiter owns these locals and returns as soon as it sees `done`.
+                                           std::scoped_lock lock(doneMutex);
+                                           outcome = code;
+                                           done    = true;
+                                           doneCv.notify_one();
+                                       });
+    if (FAILED(hr))
+    {
+        const CURLcode code = curl_easy_perform(curl);
+        ObserveSftpTransfer(conn, curl, code);
+        return code;
+    }
+
+    std::unique_lock lock(doneMutex);
+    doneCv.wait(lock, [&]() noexcept { return done; });
+    return outcome;
+}
+} // namespace FileSystemCurlInternal
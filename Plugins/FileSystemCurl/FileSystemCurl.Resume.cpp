@@ -0,0 +1,1053 @@
+#include "FileSystemCurl.Internal.h"
+
+using namespace FileSystemCurlInternal;
+
+namespace
+{
+constexpr wchar_t kResumeDirName[]                   = L"Resume";
+constexpr wchar_t kCheckpointFileExtension[]         = L".rck";
+constexpr wchar_t kDownloadCheckpointFileExtension[] = L".dck";
+constexpr wchar_t kDownloadStagingFileExtension[]    = L".part";
+
+constexpr uint32_t kCheckpointMagic         = 0x4B435352u; // "RSCK"
+constexpr uint32_t kCheckpointVersion       = 2u;
+constexpr uint32_t kDownloadCheckpointMagic = 0x4B445352u; // "RSDK"
+constexpr uint32_t kMaxCheckpointKeyBytes   = 64u * 1024u;
+
+// An older checkpoint no longer claims its partial file: the destination may have been replaced by other means since.
+constexpr int64_t kCheckpointMaxAgeSeconds = 7ll * 24ll * 60ll * 60ll;
+constexpr int64_t kFileTimeTicksPerSecond  = 10'000'000;
+
+// Attempts per transfer (the first one included) while failures stay transient; the back-off grows with each attempt.
+constexpr unsigned int kMaxTransferAttempts = 4u;
+constexpr DWORD kResumeBackoffMs            = 500u;
+
+#pragma pack(push, 1)
+struct CheckpointFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int64_t savedAt;         // FILETIME ticks
+    uint64_t sourceSize;     // 0 when the writer did not know it (streamed uploads)
+    uint64_t headBytes;      // source bytes covered by headHash (kResumeBlockBytes, fewer for small sources)
+    uint64_t headHash;       // HashResumeBlock of the source's first headBytes
+    uint64_t confirmedBytes; // destination size the server reported when the checkpoint was saved; 0 when unknown
+    uint64_t confirmedHash;  // HashResumeBlock of the source's first confirmedBytes (file uploads only, see sourceSize)
+    uint32_t keyBytes;
+};
+
+// Download checkpoints stand next to the staged partial file (same name, .part) and describe the source it was received
+// from; the key is the same endpoint + path key as for uploads.
+struct DownloadCheckpointFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int64_t savedAt;      // FILETIME ticks
+    uint64_t sourceSize;  // size the server reported to the transfer that started at offset 0
+    int64_t modifiedTime; // modification time it reported (-1 when the server has none)
+    uint32_t keyBytes;
+};
+#pragma pack(pop)
+
+struct UploadCheckpoint
+{
+    uint64_t sourceSize     = 0;
+    uint64_t headBytes      = 0;
+    uint64_t headHash       = kResumeHashSeed;
+    uint64_t confirmedBytes = 0;
+    uint64_t confirmedHash  = kResumeHashSeed;
+};
+
+// What the server reported for a download's source: its size and modification time (-1 when the server has none).
+struct RemoteFileStamp
+{
+    uint64_t sizeBytes   = 0;
+    int64_t modifiedTime = -1;
+};
+
+struct RemoteHashContext
+{
+    uint64_t hash  = kResumeHashSeed;
+    uint64_t bytes = 0;
+    uint64_t limit = 0;
+};
+
+// Serializes checkpoint file I/O across writers, copy workers and instances.
+std::mutex g_checkpointMutex;
+
+[[nodiscard]] int64_t CurrentFileTimeTicks() noexcept
+{
+    FILETIME now{};
+    GetSystemTimeAsFileTime(&now);
+    return static_cast<int64_t>((static_cast<uint64_t>(now.dwHighDateTime) << 32u) | now.dwLowDateTime);
+}
+
+// Removes checkpoints nobody resumed in time (their partial files are left alone).
+void PruneExpiredCheckpoints(const std::filesystem::path& directory) noexcept
+{
+    const int64_t cutoff = CurrentFileTimeTicks() - kCheckpointMaxAgeSeconds * kFileTimeTicksPerSecond;
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directory, ec), end; ! ec && it != end; it.increment(ec))
+    {
+        WIN32_FILE_ATTRIBUTE_DATA data{};
+        if (! GetFileAttributesExW(it->path().c_str(), GetFileExInfoStandard, &data))
+        {
+            continue;
+        }
+
+        const int64_t lastWrite =
+            static_cast<int64_t>((static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32u) | data.ftLastWriteTime.dwLowDateTime);
+        if (lastWrite < cutoff)
+        {
+            static_cast<void>(DeleteFileW(it->path().c_str()));
+        }
+    }
+}
+
+[[nodiscard]] const std::filesystem::path& GetResumeDirectory() noexcept
+{
+    static const std::filesystem::path directory = []() noexcept -> std::filesystem::path
+    {
+        const std::filesystem::path root = GetPluginCacheDirectory();
+        if (root.empty())
+        {
+            return {};
+        }
+
+        std::filesystem::path result = root / kResumeDirName;
+
+        std::error_code ec;
+        std::filesystem::create_directories(result, ec);
+        if (ec)
+        {
+            Debug::Warning(L"FileSystemCurl: failed to create resume checkpoint folder '{}' ({})", result.native(), Utf16FromUtf8(ec.message()));
+            return {};
+        }
+
+        PruneExpiredCheckpoints(result);
+        return result;
+    }();
+    return directory;
+}
+
+// protocol|host|port|user|basePath|path; passwords and key passphrases never take part.
+[[nodiscard]] std::string BuildCheckpointKey(const ConnectionInfo& conn, std::wstring_view remotePath)
+{
+    return std::format("{}|{}|{}", BuildEndpointKey(conn), conn.basePath, Utf8FromUtf16(NormalizePluginPath(remotePath)));
+}
+
+[[nodiscard]] std::filesystem::path GetCheckpointPath(std::string_view key, std::wstring_view extension = kCheckpointFileExtension) noexcept
+{
+    const std::filesystem::path& directory = GetResumeDirectory();
+    if (directory.empty())
+    {
+        return {};
+    }
+    return directory / std::format(L"{:016x}{}", HashResumeBlock(kResumeHashSeed, key.data(), key.size()), extension);
+}
+
+[[nodiscard]] bool LoadCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath, UploadCheckpoint& out) noexcept
+{
+    const std::string key                = BuildCheckpointKey(conn, remotePath);
+    const std::filesystem::path filePath = GetCheckpointPath(key);
+    if (filePath.empty())
+    {
+        return false;
+    }
+
+    std::scoped_lock lock(g_checkpointMutex);
+
+    wil::unique_hfile file(CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+    if (! file)
+    {
+        return false;
+    }
+
+    CheckpointFileHeader header{};
+    DWORD read = 0;
+    if (! ReadFile(file.get(), &header, sizeof(header), &read, nullptr) || read != sizeof(header) || header.magic != kCheckpointMagic ||
+        header.version != kCheckpointVersion || header.keyBytes != key.size() || header.keyBytes > kMaxCheckpointKeyBytes)
+    {
+        return false;
+    }
+
+    std::string storedKey(header.keyBytes, '\0');
+    if (! ReadFile(file.get(), storedKey.data(), header.keyBytes, &read, nullptr) || read != header.keyBytes || storedKey != key)
+    {
+        return false; // hash collision with another destination
+    }
+
+    if (CurrentFileTimeTicks() - header.savedAt > kCheckpointMaxAgeSeconds * kFileTimeTicksPerSecond)
+    {
+        file.reset();
+        static_cast<void>(DeleteFileW(filePath.c_str()));
+        return false;
+    }
+
+    out.sourceSize     = header.sourceSize;
+    out.headBytes      = header.headBytes;
+    out.headHash       = header.headHash;
+    out.confirmedBytes = header.confirmedBytes;
+    out.confirmedHash  = header.confirmedHash;
+    return true;
+}
+
+// Writes `header` followed by `key` next to `filePath` and swaps it in, so a crash never leaves a torn checkpoint.
+void WriteCheckpointFile(const std::filesystem::path& filePath, const void* header, size_t headerBytes, std::string_view key) noexcept
+{
+    std::vector<std::byte> buffer(headerBytes + key.size());
+    std::memcpy(buffer.data(), header, headerBytes);
+    std::memcpy(buffer.data() + headerBytes, key.data(), key.size());
+
+    std::scoped_lock lock(g_checkpointMutex);
+
+    std::filesystem::path tempPath = filePath;
+    tempPath += std::format(L".{}.tmp", GetCurrentThreadId());
+
+    {
+        wil::unique_hfile file(CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (! file)
+        {
+            return;
+        }
+
+        DWORD written = 0;
+        if (! WriteFile(file.get(), buffer.data(), static_cast<DWORD>(buffer.size()), &written, nullptr) || written != buffer.size())
+        {
+            file.reset();
+            static_cast<void>(DeleteFileW(tempPath.c_str()));
+            return;
+        }
+    }
+
+    if (! MoveFileExW(tempPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        static_cast<void>(DeleteFileW(tempPath.c_str()));
+    }
+}
+
+void StoreCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath, const UploadCheckpoint& checkpoint) noexcept
+{
+    const std::string key                = BuildCheckpointKey(conn, remotePath);
+    const std::filesystem::path filePath = GetCheckpointPath(key);
+    if (filePath.empty() || key.size() > kMaxCheckpointKeyBytes)
+    {
+        return;
+    }
+
+    CheckpointFileHeader header{};
+    header.magic          = kCheckpointMagic;
+    header.version        = kCheckpointVersion;
+    header.savedAt        = CurrentFileTimeTicks();
+    header.sourceSize     = checkpoint.sourceSize;
+    header.headBytes      = checkpoint.headBytes;
+    header.headHash       = checkpoint.headHash;
+    header.confirmedBytes = checkpoint.confirmedBytes;
+    header.confirmedHash  = checkpoint.confirmedHash;
+    header.keyBytes       = static_cast<uint32_t>(key.size());
+
+    WriteCheckpointFile(filePath, &header, sizeof(header), key);
+}
+
+void DeleteCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept
+{
+    const std::filesystem::path filePath = GetCheckpointPath(BuildCheckpointKey(conn, remotePath));
+    if (filePath.empty())
+    {
+        return;
+    }
+
+    std::scoped_lock lock(g_checkpointMutex);
+    static_cast<void>(DeleteFileW(filePath.c_str()));
+}
+
+[[nodiscard]] bool LoadDownloadCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath, RemoteFileStamp& out) noexcept
+{
+    const std::string key                = BuildCheckpointKey(conn, remotePath);
+    const std::filesystem::path filePath = GetCheckpointPath(key, kDownloadCheckpointFileExtension);
+    if (filePath.empty())
+    {
+        return false;
+    }
+
+    std::scoped_lock lock(g_checkpointMutex);
+
+    wil::unique_hfile file(CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+    if (! file)
+    {
+        return false;
+    }
+
+    DownloadCheckpointFileHeader header{};
+    DWORD read = 0;
+    if (! ReadFile(file.get(), &header, sizeof(header), &read, nullptr) || read != sizeof(header) || header.magic != kDownloadCheckpointMagic ||
+        header.version != kCheckpointVersion || header.keyBytes != key.size() || header.keyBytes > kMaxCheckpointKeyBytes)
+    {
+        return false;
+    }
+
+    std::string storedKey(header.keyBytes, '\0');
+    if (! ReadFile(file.get(), storedKey.data(), header.keyBytes, &read, nullptr) || read != header.keyBytes || storedKey != key)
+    {
+        return false;
+    }
+
+    out.sizeBytes    = header.sourceSize;
+    out.modifiedTime = header.modifiedTime;
+    return CurrentFileTimeTicks() - header.savedAt <= kCheckpointMaxAgeSeconds * kFileTimeTicksPerSecond;
+}
+
+void StoreDownloadCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath, const RemoteFileStamp& stamp) noexcept
+{
+    const std::string key                = BuildCheckpointKey(conn, remotePath);
+    const std::filesystem::path filePath = GetCheckpointPath(key, kDownloadCheckpointFileExtension);
+    if (filePath.empty() || key.size() > kMaxCheckpointKeyBytes)
+    {
+        return;
+    }
+
+    DownloadCheckpointFileHeader header{};
+    header.magic        = kDownloadCheckpointMagic;
+    header.version      = kCheckpointVersion;
+    header.savedAt      = CurrentFileTimeTicks();
+    header.sourceSize   = stamp.sizeBytes;
+    header.modifiedTime = stamp.modifiedTime;
+    header.keyBytes     = static_cast<uint32_t>(key.size());
+
+    WriteCheckpointFile(filePath, &header, sizeof(header), key);
+}
+
+void DeleteDownloadCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept
+{
+    const std::filesystem::path filePath = GetCheckpointPath(BuildCheckpointKey(conn, remotePath), kDownloadCheckpointFileExtension);
+    if (filePath.empty())
+    {
+        return;
+    }
+
+    std::scoped_lock lock(g_checkpointMutex);
+    static_cast<void>(DeleteFileW(filePath.c_str()));
+}
+
+[[nodiscard]] bool IsTransientTransferError(CURLcode code) noexcept
+{
+#pragma warning(push)
+// enum 'xx' is not explicitly handled by a case label
+#pragma warning(disable : 4061)
+    switch (code)
+    {
+        case CURLE_COULDNT_CONNECT:
+        case CURLE_OPERATION_TIMEDOUT:
+        case CURLE_SEND_ERROR:
+        case CURLE_RECV_ERROR:
+        case CURLE_PARTIAL_FILE:
+        case CURLE_GOT_NOTHING:
+        case CURLE_SSH:
+        case CURLE_FTP_ACCEPT_TIMEOUT: return true;
+        default: return false;
+    }
+#pragma warning(pop)
+}
+
+// The block of up to kResumeBlockBytes that ends at `endOffset`.
+[[nodiscard]] std::pair<uint64_t, uint64_t> TailBlock(uint64_t endOffset) noexcept
+{
+    const uint64_t start = endOffset > kResumeBlockBytes ? endOffset - kResumeBlockBytes : 0;
+    return {start, endOffset - start};
+}
+
+[[nodiscard]] HRESULT SeekFile(HANDLE file, uint64_t offset) noexcept
+{
+    LARGE_INTEGER distance{};
+    distance.QuadPart = static_cast<LONGLONG>(offset);
+    if (SetFilePointerEx(file, distance, nullptr, FILE_BEGIN) == 0)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    return S_OK;
+}
+
+// Continues `hash` over bytes [offset, offset + length) of `file`; FNV-1a is sequential, so hashing [0, a) and then
+// [a, b) gives the hash of [0, b).
+[[nodiscard]] HRESULT HashFileRange(HANDLE file, uint64_t offset, uint64_t length, uint64_t& hash) noexcept
+{
+    if (length == 0)
+    {
+        return S_OK;
+    }
+
+    std::unique_ptr<std::byte[]> buffer(new (std::nothrow) std::byte[kResumeBlockBytes]);
+    if (! buffer)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    uint64_t position  = offset;
+    uint64_t remaining = length;
+    while (remaining > 0)
+    {
+        OVERLAPPED overlapped{};
+        overlapped.Offset     = static_cast<DWORD>(position & 0xFFFFFFFFull);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32u);
+
+        const DWORD want = static_cast<DWORD>(std::min<uint64_t>(remaining, kResumeBlockBytes));
+        DWORD read       = 0;
+        if (! ReadFile(file, buffer.get(), want, &read, &overlapped))
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+        if (read == 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        }
+
+        hash = HashResumeBlock(hash, buffer.get(), read);
+        position += read;
+        remaining -= read;
+    }
+
+    return S_OK;
+}
+
+size_t CurlWriteHash(void* ptr, size_t size, size_t nmemb, void* userdata) noexcept
+{
+    auto* ctx          = static_cast<RemoteHashContext*>(userdata);
+    const size_t total = size * nmemb;
+    if (! ctx || ! ptr)
+    {
+        return 0;
+    }
+
+    const size_t take = static_cast<size_t>(std::min<uint64_t>(total, ctx->limit - ctx->bytes));
+    ctx->hash         = HashResumeBlock(ctx->hash, ptr, take);
+    ctx->bytes += take;
+    return total;
+}
+
+// Hashes bytes [offset, offset + length) of a remote file with a ranged download (FTP REST, SFTP seek).
+[[nodiscard]] HRESULT HashRemoteRange(const ConnectionInfo& conn, std::wstring_view pluginPath, uint64_t offset, uint64_t length, uint64_t& outHash) noexcept
+{
+    outHash = kResumeHashSeed;
+    if (length == 0)
+    {
+        return S_OK;
+    }
+
+    const std::string url = BuildUrl(conn, pluginPath, false, false);
+    if (url.empty())
+    {
+        return E_INVALIDARG;
+    }
+
+    unique_curl_easy curl{curl_easy_init()};
+    if (! curl)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    RemoteHashContext ctx{};
+    ctx.limit = length;
+
+    const std::string range = std::format("{}-{}", offset, offset + length - 1u);
+    curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_RANGE, range.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, CurlWriteHash);
+    curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &ctx);
+    curl_easy_setopt(curl.get(), CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 1L);
+    ApplyCommonCurlOptions(curl.get(), conn, nullptr, false);
+
+    const CURLcode code = CurlPerform(conn, curl.get(), nullptr);
+    if (code != CURLE_OK)
+    {
+        return HResultFromCurl(code);
+    }
+    if (ctx.bytes != length)
+    {
+        return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+    }
+
+    outHash = ctx.hash;
+    return S_OK;
+}
+
+// Current size and modification time of a remote file (FTP SIZE/MDTM, SFTP stat) without listing its folder.
+[[nodiscard]] HRESULT ProbeRemoteFileStamp(const ConnectionInfo& conn, std::wstring_view pluginPath, RemoteFileStamp& outStamp) noexcept
+{
+    outStamp = {};
+
+    const std::string url = BuildUrl(conn, pluginPath, false, false);
+    if (url.empty())
+    {
+        return E_INVALIDARG;
+    }
+
+    unique_curl_easy curl{curl_easy_init()};
+    if (! curl)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_FILETIME, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 1L);
+    ApplyCommonCurlOptions(curl.get(), conn, nullptr, false);
+
+    const CURLcode code = CurlPerform(conn, curl.get(), nullptr);
+    if (code != CURLE_OK)
+    {
+        return HResultFromCurl(code);
+    }
+
+    curl_off_t length = -1;
+    if (curl_easy_getinfo(curl.get(), CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) != CURLE_OK || length < 0)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    curl_off_t fileTime = -1;
+    if (curl_easy_getinfo(curl.get(), CURLINFO_FILETIME_T, &fileTime) != CURLE_OK)
+    {
+        fileTime = -1;
+    }
+
+    outStamp.sizeBytes    = static_cast<uint64_t>(length);
+    outStamp.modifiedTime = static_cast<int64_t>(fileTime);
+    return S_OK;
+}
+
+// Current size of a remote file (FTP SIZE, SFTP stat) without listing its folder.
+[[nodiscard]] HRESULT ProbeRemoteFileSize(const ConnectionInfo& conn, std::wstring_view pluginPath, uint64_t& outSize) noexcept
+{
+    RemoteFileStamp stamp{};
+    const HRESULT hr = ProbeRemoteFileStamp(conn, pluginPath, stamp);
+    outSize          = stamp.sizeBytes;
+    return hr;
+}
+
+int CurlSeekFile(void* userp, curl_off_t offset, int origin) noexcept
+{
+    HANDLE file = static_cast<HANDLE>(userp);
+    if (! file || file == INVALID_HANDLE_VALUE)
+    {
+        return CURL_SEEKFUNC_FAIL;
+    }
+
+    DWORD method = FILE_BEGIN;
+    switch (origin)
+    {
+        case SEEK_SET: method = FILE_BEGIN; break;
+        case SEEK_CUR: method = FILE_CURRENT; break;
+        case SEEK_END: method = FILE_END; break;
+        default: return CURL_SEEKFUNC_CANTSEEK;
+    }
+
+    LARGE_INTEGER distance{};
+    distance.QuadPart = static_cast<LONGLONG>(offset);
+    return SetFilePointerEx(file, distance, nullptr, method) != 0 ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_FAIL;
+}
+
+// Returns the offset an upload of `file` may continue from: the server's size of the destination when the checkpoint
+// describes this source and every byte the server holds equals the source's byte at the same offset; 0 otherwise.
+// When a file upload recorded the hash of exactly the bytes the server now holds, only the local range is read again;
+// otherwise (a streamed upload, or a session that died before recording the final size) the server's partial file is
+// read back and compared in full.
+[[nodiscard]] uint64_t VerifyResumeOffset(
+    const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, uint64_t sizeBytes, const UploadCheckpoint& checkpoint) noexcept
+{
+    if (checkpoint.sourceSize != 0 && checkpoint.sourceSize != sizeBytes)
+    {
+        return 0;
+    }
+    if (checkpoint.headBytes == 0 || checkpoint.headBytes > sizeBytes)
+    {
+        return 0;
+    }
+
+    uint64_t headHash = kResumeHashSeed;
+    if (FAILED(HashFileRange(file, 0, checkpoint.headBytes, headHash)) || headHash != checkpoint.headHash)
+    {
+        return 0;
+    }
+
+    uint64_t remoteSize = 0;
+    if (FAILED(ProbeRemoteFileSize(conn, pluginPath, remoteSize)) || remoteSize == 0 || remoteSize > sizeBytes)
+    {
+        return 0;
+    }
+
+    uint64_t localHash = kResumeHashSeed;
+    if (FAILED(HashFileRange(file, 0, remoteSize, localHash)))
+    {
+        return 0;
+    }
+
+    if (checkpoint.sourceSize != 0 && checkpoint.confirmedBytes == remoteSize)
+    {
+        return localHash == checkpoint.confirmedHash ? remoteSize : 0;
+    }
+
+    uint64_t remoteHash = 0;
+    if (FAILED(HashRemoteRange(conn, pluginPath, 0, remoteSize, remoteHash)))
+    {
+        return 0;
+    }
+    return localHash == remoteHash ? remoteSize : 0;
+}
+
+// True when a download may continue after the `receivedBytes` already in `file`: the server still reports the size and
+// modification time the interrupted transfer saw, and the block ending at `receivedBytes` matches the server's bytes.
+[[nodiscard]] bool VerifyDownloadResume(
+    const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, uint64_t receivedBytes, const RemoteFileStamp& checkpoint) noexcept
+{
+    RemoteFileStamp current{};
+    if (FAILED(ProbeRemoteFileStamp(conn, pluginPath, current)) || current.sizeBytes != checkpoint.sizeBytes ||
+        current.modifiedTime != checkpoint.modifiedTime || receivedBytes > current.sizeBytes)
+    {
+        return false;
+    }
+
+    const auto [tailStart, tailLength] = TailBlock(receivedBytes);
+
+    uint64_t localTail  = kResumeHashSeed;
+    uint64_t remoteTail = 0;
+    return SUCCEEDED(HashFileRange(file, tailStart, tailLength, localTail)) &&
+           SUCCEEDED(HashRemoteRange(conn, pluginPath, tailStart, tailLength, remoteTail)) && localTail == remoteTail;
+}
+} // namespace
+
+namespace FileSystemCurlInternal
+{
+[[nodiscard]] uint64_t HashResumeBlock(uint64_t hash, const void* data, size_t size) noexcept
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t index = 0; index < size; ++index)
+    {
+        hash ^= bytes[index];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+[[nodiscard]] bool ShouldResumeTransfer(const ConnectionInfo& conn, CURLcode code, unsigned int& failedAttempts) noexcept
+{
+    if (! conn.resumableTransfers || ! IsTransientTransferError(code))
+    {
+        return false;
+    }
+
+    ++failedAttempts;
+    if (failedAttempts >= kMaxTransferAttempts)
+    {
+        return false;
+    }
+
+    Sleep(kResumeBackoffMs * failedAttempts);
+    return true;
+}
+
+[[nodiscard]] bool HasResumableUpload(const ConnectionInfo& conn, std::wstring_view remotePath, uint64_t existingSizeBytes) noexcept
+{
+    if (! conn.resumableTransfers)
+    {
+        return false;
+    }
+
+    UploadCheckpoint checkpoint{};
+    if (! LoadCheckpoint(conn, remotePath, checkpoint))
+    {
+        return false;
+    }
+
+    if (checkpoint.confirmedBytes != 0 && checkpoint.confirmedBytes != existingSizeBytes)
+    {
+        return false;
+    }
+    return checkpoint.sourceSize == 0 || existingSizeBytes <= checkpoint.sourceSize;
+}
+
+[[nodiscard]] bool HasUploadCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept
+{
+    UploadCheckpoint checkpoint{};
+    return conn.resumableTransfers && LoadCheckpoint(conn, remotePath, checkpoint);
+}
+
+void DiscardUploadCheckpoint(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept
+{
+    if (conn.resumableTransfers)
+    {
+        DeleteCheckpoint(conn, remotePath);
+    }
+}
+
+void RecordStreamedUploadStart(const ConnectionInfo& conn, std::wstring_view remotePath, uint64_t headHash, uint64_t headBytes) noexcept
+{
+    if (! conn.resumableTransfers || headBytes == 0)
+    {
+        return;
+    }
+
+    UploadCheckpoint checkpoint{};
+    checkpoint.headBytes = headBytes;
+    checkpoint.headHash  = headHash;
+    StoreCheckpoint(conn, remotePath, checkpoint);
+}
+
+void RecordStreamedUploadFailure(const ConnectionInfo& conn, std::wstring_view remotePath, uint64_t headHash, uint64_t headBytes) noexcept
+{
+    if (! conn.resumableTransfers || headBytes == 0)
+    {
+        return;
+    }
+
+    // The streamed bytes are gone, so there is no hash of what the server kept: the next attempt reads the server's
+    // partial file back and compares it with the staged source. Only its size is recorded, so HasResumableUpload still
+    // recognizes the file; when the server cannot be asked, the start record stays.
+    uint64_t confirmed = 0;
+    if (FAILED(ProbeRemoteFileSize(conn, remotePath, confirmed)) || confirmed == 0)
+    {
+        return;
+    }
+
+    UploadCheckpoint checkpoint{};
+    checkpoint.headBytes      = headBytes;
+    checkpoint.headHash       = headHash;
+    checkpoint.confirmedBytes = confirmed;
+    StoreCheckpoint(conn, remotePath, checkpoint);
+}
+
+void RecordUploadStart(const ConnectionInfo& conn, std::wstring_view remotePath, HANDLE file, uint64_t sizeBytes) noexcept
+{
+    if (! conn.resumableTransfers || sizeBytes <= kResumeBlockBytes)
+    {
+        return;
+    }
+
+    UploadCheckpoint checkpoint{};
+    checkpoint.sourceSize = sizeBytes;
+    checkpoint.headBytes  = kResumeBlockBytes;
+    if (SUCCEEDED(HashFileRange(file, 0, checkpoint.headBytes, checkpoint.headHash)))
+    {
+        StoreCheckpoint(conn, remotePath, checkpoint);
+    }
+}
+
+[[nodiscard]] HRESULT CurlResumableUploadFromFile(
+    const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, uint64_t sizeBytes, TransferProgressContext* progressCtx) noexcept
+{
+    if (! conn.resumableTransfers)
+    {
+        return CurlUploadFromFile(conn, pluginPath, file, sizeBytes, nullptr, progressCtx);
+    }
+
+    HRESULT hr = EnsureCurlInitialized();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    if (sizeBytes > static_cast<uint64_t>((std::numeric_limits<curl_off_t>::max)()))
+    {
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+    }
+
+    UploadCheckpoint checkpoint{};
+    checkpoint.sourceSize = sizeBytes;
+    checkpoint.headBytes  = std::min<uint64_t>(sizeBytes, kResumeBlockBytes);
+    hr                    = HashFileRange(file, 0, checkpoint.headBytes, checkpoint.headHash);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    uint64_t offset = 0;
+    UploadCheckpoint previous{};
+    if (LoadCheckpoint(conn, pluginPath, previous))
+    {
+        offset = VerifyResumeOffset(conn, pluginPath, file, sizeBytes, previous);
+        if (offset > 0)
+        {
+            Debug::Info(L"FileSystemCurl: resuming upload of '{}' at {} of {} bytes", pluginPath, offset, sizeBytes);
+        }
+    }
+
+    if (sizeBytes > 0 && offset == sizeBytes)
+    {
+        // An earlier attempt sent everything (VerifyResumeOffset compared all of it) but did not live to record it.
+        DeleteCheckpoint(conn, pluginPath);
+        InvalidateCachedParentListing(conn, pluginPath);
+        return S_OK;
+    }
+
+    // checkpoint.confirmedHash covers the source's first checkpoint.confirmedBytes; the confirmed offset only grows, so
+    // each update hashes just the newly confirmed bytes.
+    const auto confirmUpTo = [&](uint64_t confirmed) noexcept
+    {
+        const HRESULT rangeHr = HashFileRange(file, checkpoint.confirmedBytes, confirmed - checkpoint.confirmedBytes, checkpoint.confirmedHash);
+        if (SUCCEEDED(rangeHr))
+        {
+            checkpoint.confirmedBytes = confirmed;
+        }
+        return rangeHr;
+    };
+
+    unsigned int failedAttempts = 0;
+    for (;;)
+    {
+        // Record the starting point first so an interrupted session finds its partial file again.
+        hr = confirmUpTo(offset);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        StoreCheckpoint(conn, pluginPath, checkpoint);
+
+        unique_curl_easy curl{curl_easy_init()};
+        if (! curl)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        hr = ResetFilePointerToStart(file);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = PrepareCurlUpload(curl.get(), conn, pluginPath, file, sizeBytes, nullptr, progressCtx);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // libcurl seeks the source to the resume offset and appends there (FTP APPE, SFTP write at offset).
+        curl_easy_setopt(curl.get(), CURLOPT_SEEKFUNCTION, CurlSeekFile);
+        curl_easy_setopt(curl.get(), CURLOPT_SEEKDATA, file);
+        if (offset > 0)
+        {
+            curl_easy_setopt(curl.get(), CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(offset));
+        }
+        if (progressCtx)
+        {
+            progressCtx->resumedBytes = offset;
+        }
+
+        const CURLcode code = CurlPerform(conn, curl.get(), progressCtx);
+        InvalidateCachedParentListing(conn, pluginPath);
+        if (code == CURLE_OK)
+        {
+            DeleteCheckpoint(conn, pluginPath);
+            return S_OK;
+        }
+
+        hr = HResultFromTransfer(code, progressCtx);
+
+        // Whatever the server kept is confirmed; without an answer the start record stays for a later attempt.
+        uint64_t confirmed = 0;
+        if (FAILED(ProbeRemoteFileSize(conn, pluginPath, confirmed)) || confirmed < offset || confirmed > sizeBytes)
+        {
+            return hr;
+        }
+
+        offset = confirmed;
+        if (! ShouldResumeTransfer(conn, code, failedAttempts))
+        {
+            if (SUCCEEDED(confirmUpTo(offset)))
+            {
+                StoreCheckpoint(conn, pluginPath, checkpoint);
+            }
+            return hr;
+        }
+
+        Debug::Info(L"FileSystemCurl: upload of '{}' failed hr={:#x}; resuming at {} of {} bytes",
+                    pluginPath,
+                    static_cast<unsigned long>(hr),
+                    offset,
+                    sizeBytes);
+    }
+}
+
+[[nodiscard]] wil::unique_hfile OpenDownloadStagingFile(const ConnectionInfo& conn, std::wstring_view remotePath) noexcept
+{
+    if (conn.resumableTransfers)
+    {
+        const std::filesystem::path filePath = GetCheckpointPath(BuildCheckpointKey(conn, remotePath), kDownloadStagingFileExtension);
+        if (! filePath.empty())
+        {
+            wil::unique_hfile file(CreateFileW(filePath.c_str(),
+                                               GENERIC_READ | GENERIC_WRITE | DELETE,
+                                               0,
+                                               nullptr,
+                                               OPEN_ALWAYS,
+                                               FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_SEQUENTIAL_SCAN,
+                                               nullptr));
+            if (file)
+            {
+                return file;
+            }
+            Debug::Warning(L"FileSystemCurl: staged download '{}' unavailable (error {}); using a temporary file", filePath.native(), GetLastError());
+        }
+    }
+
+    return CreateTemporaryDeleteOnCloseFile();
+}
+
+void ReleaseDownloadStagingFile(const ConnectionInfo& conn, std::wstring_view remotePath, HANDLE file) noexcept
+{
+    FILE_DISPOSITION_INFO disposition{};
+    disposition.DeleteFile = TRUE;
+    static_cast<void>(SetFileInformationByHandle(file, FileDispositionInfo, &disposition, sizeof(disposition)));
+
+    if (conn.resumableTransfers)
+    {
+        DeleteDownloadCheckpoint(conn, remotePath);
+    }
+}
+
+[[nodiscard]] HRESULT
+CurlResumableDownloadToFile(const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, TransferProgressContext* progressCtx) noexcept
+{
+    if (! conn.resumableTransfers)
+    {
+        return CurlDownloadToFile(conn, pluginPath, file, nullptr, progressCtx);
+    }
+
+    HRESULT hr = EnsureCurlInitialized();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    // Checkpoint of the source, taken from the transfer that started at offset 0 and kept on disk next to the staged
+    // file. A later attempt (in this call, after a host Retry, or in the next session) continues after the bytes already
+    // in `file` only while the server still reports it and the received tail matches the server's bytes; otherwise the
+    // file is received again from the start.
+    RemoteFileStamp checkpoint{};
+    bool checkpointKnown = false;
+    uint64_t offset      = 0;
+    hr                   = GetFileSizeBytes(file, offset);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    if (offset > 0)
+    {
+        checkpointKnown = LoadDownloadCheckpoint(conn, pluginPath, checkpoint) && offset <= checkpoint.sizeBytes &&
+                          VerifyDownloadResume(conn, pluginPath, file, offset, checkpoint);
+        if (! checkpointKnown)
+        {
+            Debug::Info(L"FileSystemCurl: staged download of '{}' does not match the source; downloading it again", pluginPath);
+            offset = 0;
+            hr     = SeekFile(file, 0);
+            if (FAILED(hr) || ! SetEndOfFile(file))
+            {
+                return FAILED(hr) ? hr : HRESULT_FROM_WIN32(GetLastError());
+            }
+        }
+        else if (offset == checkpoint.sizeBytes)
+        {
+            Debug::Info(L"FileSystemCurl: reusing the staged download of '{}' ({} bytes)", pluginPath, offset);
+            return S_OK;
+        }
+        else
+        {
+            Debug::Info(L"FileSystemCurl: resuming the staged download of '{}' at {} of {} bytes", pluginPath, offset, checkpoint.sizeBytes);
+        }
+    }
+
+    unsigned int failedAttempts = 0;
+    for (;;)
+    {
+        unique_curl_easy curl{curl_easy_init()};
+        if (! curl)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        hr = SeekFile(file, offset);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = PrepareCurlDownload(curl.get(), conn, pluginPath, file, nullptr, progressCtx);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (offset > 0)
+        {
+            curl_easy_setopt(curl.get(), CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(offset));
+        }
+        else
+        {
+            curl_easy_setopt(curl.get(), CURLOPT_FILETIME, 1L);
+        }
+        if (progressCtx)
+        {
+            progressCtx->resumedBytes = offset;
+        }
+
+        const CURLcode code = CurlPerform(conn, curl.get(), progressCtx);
+
+        // Recorded on success too: a relay copy whose upload fails reuses the complete staged file on Retry.
+        if (offset == 0)
+        {
+            curl_off_t length   = -1;
+            curl_off_t fileTime = -1;
+            checkpointKnown     = curl_easy_getinfo(curl.get(), CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) == CURLE_OK && length >= 0;
+            if (curl_easy_getinfo(curl.get(), CURLINFO_FILETIME_T, &fileTime) != CURLE_OK)
+            {
+                fileTime = -1;
+            }
+            checkpoint.sizeBytes    = checkpointKnown ? static_cast<uint64_t>(length) : 0;
+            checkpoint.modifiedTime = static_cast<int64_t>(fileTime);
+
+            if (checkpointKnown)
+            {
+                StoreDownloadCheckpoint(conn, pluginPath, checkpoint);
+            }
+            else
+            {
+                DeleteDownloadCheckpoint(conn, pluginPath);
+            }
+        }
+
+        if (code == CURLE_OK)
+        {
+            return S_OK;
+        }
+
+        hr = HResultFromTransfer(code, progressCtx);
+        if (! ShouldResumeTransfer(conn, code, failedAttempts))
+        {
+            return hr;
+        }
+
+        // Every byte written to `file` was received, so the next request starts after them if the source is unchanged.
+        const HRESULT sizeHr = GetFileSizeBytes(file, offset);
+        if (FAILED(sizeHr) || offset > static_cast<uint64_t>((std::numeric_limits<curl_off_t>::max)()))
+        {
+            return hr;
+        }
+
+        if (offset > 0 && ! (checkpointKnown && VerifyDownloadResume(conn, pluginPath, file, offset, checkpoint)))
+        {
+            Debug::Info(L"FileSystemCurl: source of '{}' changed or could not be verified; downloading it again", pluginPath);
+            offset = 0;
+            if (FAILED(SeekFile(file, 0)) || ! SetEndOfFile(file))
+            {
+                return hr;
+            }
+            continue;
+        }
+
+        Debug::Info(L"FileSystemCurl: download of '{}' failed hr={:#x}; resuming at {} bytes", pluginPath, static_cast<unsigned long>(hr), offset);
+    }
+}
+} // namespace FileSystemCurlInternal
@@ -0,0 +1,1126 @@
+#include "FileSystemCurl.Internal.h"
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+// Re-included so the winsock sections (unique_socket / unique_addrinfo_ansi) are enabled now that winsock is visible.
+#include <wil/resource.h>
+
+#include <libssh2.h>
+
+#include <cctype>
+#include <cstdlib>
+
+#pragma comment(lib, "Ws2_32.lib")
+
+using namespace FileSystemCurlInternal;
+
+namespace
+{
+// A method an endpoint rejected (or that failed this many times in a row) is skipped for kRejectRetryMs before it is
+// probed again, so unsupported servers cost one attempt per session instead of one per file.
+constexpr uint64_t kRejectRetryMs              = 10ull * 60ull * 1000ull;
+constexpr unsigned int kMaxConsecutiveFailures = 3u;
+constexpr unsigned long kPollIntervalMs        = 250ul;
+constexpr unsigned long kDefaultConnectTimeout = 30000ul;
+constexpr uint64_t kIdleSshSessionMs           = 60ull * 1000ull;
+constexpr size_t kMaxCommandOutputBytes        = 4096u;
+constexpr int kShellCommandNotFoundExitStatus  = 127;
+constexpr unsigned int kDefaultSshPort         = 22u;
+constexpr unsigned int kDefaultFtpPort         = 21u;
+constexpr char kFtpAnonymousUser[]             = "anonymous";
+constexpr char kFtpAnonymousPassword[]         = "ftp@example.com";
+
+enum class ServerCopyMethod : uint8_t
+{
+    SshExec,
+    SiteCopy,
+    Fxp,
+};
+
+[[nodiscard]] const wchar_t* MethodName(ServerCopyMethod method) noexcept
+{
+    switch (method)
+    {
+        case ServerCopyMethod::SshExec: return L"ssh-cp";
+        case ServerCopyMethod::SiteCopy: return L"site-cpfr";
+        case ServerCopyMethod::Fxp: return L"fxp";
+    }
+    return L"?";
+}
+
+// Outcome of one server-side attempt.
+enum class AttemptResult : uint8_t
+{
+    Copied,
+    Failed,   // this file only; the next file tries again
+    Rejected, // the endpoint does not support the method
+};
+
+struct MethodState
+{
+    unsigned int consecutiveFailures = 0;
+    uint64_t rejectedUntilTick       = 0;
+};
+
+struct ServerCopyRegistry
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, MethodState> methods;     // method|endpoint(s)
+    std::unordered_map<std::string, bool> siteCopyAdvertised; // FTP endpoint -> SITE HELP lists CPFR/CPTO
+};
+
+[[nodiscard]] ServerCopyRegistry& GetServerCopyRegistry() noexcept
+{
+    static ServerCopyRegistry registry;
+    return registry;
+}
+
+[[nodiscard]] std::string BuildMethodKey(ServerCopyMethod method, const ConnectionInfo& sourceConn, const ConnectionInfo& destinationConn)
+{
+    if (method == ServerCopyMethod::Fxp)
+    {
+        return std::format("fxp|{}>{}", BuildEndpointKey(sourceConn), BuildEndpointKey(destinationConn));
+    }
+    return std::format("{}|{}", static_cast<int>(method), BuildEndpointKey(destinationConn));
+}
+
+[[nodiscard]] bool IsMethodRejected(const std::string& key) noexcept
+{
+    ServerCopyRegistry& registry = GetServerCopyRegistry();
+
+    std::scoped_lock lock(registry.mutex);
+    const auto it = registry.methods.find(key);
+    return it != registry.methods.end() && it->second.rejectedUntilTick > GetTickCount64();
+}
+
+void RecordAttempt(const std::string& key, AttemptResult result) noexcept
+{
+    ServerCopyRegistry& registry = GetServerCopyRegistry();
+
+    std::scoped_lock lock(registry.mutex);
+    MethodState& state = registry.methods[key];
+    if (result == AttemptResult::Copied)
+    {
+        state = {};
+        return;
+    }
+
+    state.consecutiveFailures += 1u;
+    if (result == AttemptResult::Rejected || state.consecutiveFailures >= kMaxConsecutiveFailures)
+    {
+        state.consecutiveFailures = 0;
+        state.rejectedUntilTick   = GetTickCount64() + kRejectRetryMs;
+    }
+}
+
+[[nodiscard]] bool IsSameEndpoint(const ConnectionInfo& sourceConn, const ConnectionInfo& destinationConn) noexcept
+{
+    // Remote paths are resolved against each side's base path, so only the account has to match.
+    return sourceConn.protocol == destinationConn.protocol && sourceConn.host == destinationConn.host && sourceConn.port == destinationConn.port &&
+           sourceConn.user == destinationConn.user;
+}
+
+// Methods to try for a pair, in order of preference.
+[[nodiscard]] std::vector<ServerCopyMethod> SelectMethods(const ConnectionInfo& sourceConn, const ConnectionInfo& destinationConn) noexcept
+{
+    std::vector<ServerCopyMethod> methods;
+    if (! sourceConn.serverSideCopy || ! destinationConn.serverSideCopy || sourceConn.protocol != destinationConn.protocol)
+    {
+        return methods;
+    }
+
+    const bool sameEndpoint = IsSameEndpoint(sourceConn, destinationConn);
+    switch (sourceConn.protocol)
+    {
+        case Protocol::Sftp:
+        case Protocol::Scp:
+            if (sameEndpoint)
+            {
+                methods.push_back(ServerCopyMethod::SshExec);
+            }
+            break;
+        case Protocol::Ftp:
+            if (sameEndpoint)
+            {
+                methods.push_back(ServerCopyMethod::SiteCopy);
+            }
+            methods.push_back(ServerCopyMethod::Fxp);
+            break;
+        case Protocol::Imap: break;
+    }
+    return methods;
+}
+
+[[nodiscard]] unsigned long ConnectTimeoutMs(const ConnectionInfo& conn) noexcept
+{
+    return conn.connectTimeoutMs != 0 ? conn.connectTimeoutMs : kDefaultConnectTimeout;
+}
+
+[[nodiscard]] HRESULT HResultFromWsa(int error) noexcept
+{
+    return HRESULT_FROM_WIN32(static_cast<unsigned long>(error != 0 ? error : WSAECONNABORTED));
+}
+
+// Waits until `socket` is readable (or writable), polling cancellation every kPollIntervalMs.
+// Returns S_OK when ready, HRESULT_FROM_WIN32(ERROR_TIMEOUT) once `timeoutMs` (0 = none) elapses.
+[[nodiscard]] HRESULT WaitSocket(SOCKET socket, bool forWrite, unsigned long timeoutMs, FileOperationProgress* progress) noexcept
+{
+    const uint64_t start = GetTickCount64();
+    for (;;)
+    {
+        fd_set readSet{};
+        fd_set writeSet{};
+        fd_set errorSet{};
+        FD_SET(socket, forWrite ? &writeSet : &readSet);
+        FD_SET(socket, &errorSet);
+
+        timeval wait{};
+        wait.tv_usec = static_cast<long>(kPollIntervalMs * 1000ul);
+
+        const int ready = select(0, &readSet, &writeSet, &errorSet, &wait);
+        if (ready == SOCKET_ERROR)
+        {
+            return HResultFromWsa(WSAGetLastError());
+        }
+        if (ready > 0)
+        {
+            return S_OK;
+        }
+
+        if (progress)
+        {
+            const HRESULT cancelHr = progress->CheckCancel();
+            if (FAILED(cancelHr))
+            {
+                return cancelHr;
+            }
+        }
+
+        if (timeoutMs != 0 && GetTickCount64() - start >= timeoutMs)
+        {
+            return HRESULT_FROM_WIN32(ERROR_TIMEOUT);
+        }
+    }
+}
+
+[[nodiscard]] HRESULT ConnectTcp(const std::string& host, unsigned int port, int family, unsigned long timeoutMs, wil::unique_socket& out) noexcept
+{
+    out.reset();
+
+    const HRESULT initHr = EnsureCurlInitialized(); // curl_global_init runs WSAStartup
+    if (FAILED(initHr))
+    {
+        return initHr;
+    }
+
+    addrinfo hints{};
+    hints.ai_family   = family;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    const std::string service = std::to_string(port);
+
+    wil::unique_addrinfo_ansi addresses;
+    const int resolveError = getaddrinfo(host.c_str(), service.c_str(), &hints, addresses.put());
+    if (resolveError != 0)
+    {
+        return HResultFromWsa(resolveError);
+    }
+
+    HRESULT lastHr = HRESULT_FROM_WIN32(WSAEHOSTUNREACH);
+    for (const addrinfo* address = addresses.get(); address; address = address->ai_next)
+    {
+        wil::unique_socket candidate(socket(address->ai_family, address->ai_socktype, address->ai_protocol));
+        if (! candidate)
+        {
+            lastHr = HResultFromWsa(WSAGetLastError());
+            continue;
+        }
+
+        u_long nonBlocking = 1;
+        ioctlsocket(candidate.get(), FIONBIO, &nonBlocking);
+
+        if (connect(candidate.get(), address->ai_addr, static_cast<int>(address->ai_addrlen)) == SOCKET_ERROR)
+        {
+            const int connectError = WSAGetLastError();
+            if (connectError != WSAEWOULDBLOCK)
+            {
+                lastHr = HResultFromWsa(connectError);
+                continue;
+            }
+
+            lastHr = WaitSocket(candidate.get(), true, timeoutMs, nullptr);
+            if (FAILED(lastHr))
+            {
+                continue;
+            }
+
+            int socketError    = 0;
+            int socketErrorLen = sizeof(socketError);
+            getsockopt(candidate.get(), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&socketError), &socketErrorLen);
+            if (socketError != 0)
+            {
+                lastHr = HResultFromWsa(socketError);
+                continue;
+            }
+        }
+
+        u_long blocking = 0;
+        ioctlsocket(candidate.get(), FIONBIO, &blocking);
+
+        out = std::move(candidate);
+        return S_OK;
+    }
+
+    return lastHr;
+}
+
+// Quotes a remote path for a POSIX shell. libcurl's home-relative "/~/" prefix becomes "$HOME"/.
+[[nodiscard]] std::string QuoteShellPath(std::string_view path)
+{
+    std::string out;
+    if (path == "/~")
+    {
+        return "\"$HOME\"";
+    }
+    if (path.starts_with("/~/"))
+    {
+        out.append("\"$HOME\"/");
+        path.remove_prefix(3);
+    }
+
+    out.push_back('\'');
+    for (const char ch : path)
+    {
+        if (ch == '\'')
+        {
+            out.append("'\\''");
+        }
+        else
+        {
+            out.push_back(ch);
+        }
+    }
+    out.push_back('\'');
+    return out;
+}
+
+// SSH exec ----------------------------------------------------------------------------------------------------------
+
+class SshSession final
+{
+public:
+    SshSession() = default;
+
+    SshSession(const SshSession&)            = delete;
+    SshSession(SshSession&&)                 = delete;
+    SshSession& operator=(const SshSession&) = delete;
+    SshSession& operator=(SshSession&&)      = delete;
+
+    ~SshSession()
+    {
+        if (_session)
+        {
+            libssh2_session_set_blocking(_session, 1);
+            libssh2_session_disconnect(_session, "done");
+            libssh2_session_free(_session);
+        }
+    }
+
+    [[nodiscard]] HRESULT Open(const ConnectionInfo& conn) noexcept
+    {
+        static std::once_flag libssh2InitOnce;
+        std::call_once(libssh2InitOnce, []() noexcept { static_cast<void>(libssh2_init(0)); });
+
+        const unsigned int port = conn.port.value_or(kDefaultSshPort);
+
+        HRESULT hr = ConnectTcp(conn.host, port, AF_UNSPEC, ConnectTimeoutMs(conn), _socket);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        _session = libssh2_session_init();
+        if (! _session)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        libssh2_session_set_blocking(_session, 1);
+        libssh2_session_set_timeout(_session, static_cast<long>(ConnectTimeoutMs(conn)));
+
+        if (libssh2_session_handshake(_session, static_cast<libssh2_socket_t>(_socket.get())) != 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_CONNECTION_REFUSED);
+        }
+
+        hr = VerifyHostKey(conn, port);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return Authenticate(conn);
+    }
+
+    // Runs `command`; stderr is kept for diagnostics. The session is unusable after a cancelled run.
+    [[nodiscard]] HRESULT
+    Execute(const std::string& command, const ConnectionInfo& conn, FileOperationProgress& progress, int& exitStatus, std::string& errorText) noexcept
+    {
+        exitStatus = -1;
+        errorText.clear();
+
+        libssh2_session_set_blocking(_session, 1);
+        LIBSSH2_CHANNEL* channel = libssh2_channel_open_session(_session);
+        if (! channel)
+        {
+            return HRESULT_FROM_WIN32(ERROR_CONNECTION_ABORTED);
+        }
+
+        if (libssh2_channel_exec(channel, command.c_str()) != 0)
+        {
+            libssh2_channel_free(channel);
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+
+        libssh2_session_set_blocking(_session, 0);
+
+        const uint64_t start = GetTickCount64();
+        HRESULT hr           = S_OK;
+        std::array<char, 1024> buffer{};
+        while (! libssh2_channel_eof(channel))
+        {
+            bool gotData = false;
+            for (const int stream : {0, SSH_EXTENDED_DATA_STDERR})
+            {
+                const ssize_t read = libssh2_channel_read_ex(channel, stream, buffer.data(), buffer.size());
+                if (read > 0)
+                {
+                    gotData = true;
+                    if (stream != 0 && errorText.size() < kMaxCommandOutputBytes)
+                    {
+                        errorText.append(buffer.data(), static_cast<size_t>(read));
+                    }
+                }
+                else if (read < 0 && read != LIBSSH2_ERROR_EAGAIN)
+                {
+                    hr = HRESULT_FROM_WIN32(ERROR_CONNECTION_ABORTED);
+                }
+            }
+
+            if (FAILED(hr))
+            {
+                break;
+            }
+            if (gotData)
+            {
+                continue;
+            }
+
+            const int directions = libssh2_session_block_directions(_session);
+            hr = WaitSocket(_socket.get(), (directions & LIBSSH2_SESSION_BLOCK_OUTBOUND) != 0, kPollIntervalMs, &progress);
+            if (hr == HRESULT_FROM_WIN32(ERROR_TIMEOUT))
+            {
+                hr = S_OK;
+            }
+            if (FAILED(hr))
+            {
+                break;
+            }
+
+            if (conn.operationTimeoutMs != 0 && GetTickCount64() - start >= conn.operationTimeoutMs)
+            {
+                hr = HRESULT_FROM_WIN32(ERROR_TIMEOUT);
+                break;
+            }
+        }
+
+        if (FAILED(hr))
+        {
+            libssh2_channel_free(channel);
+            return hr;
+        }
+
+        libssh2_session_set_blocking(_session, 1);
+        libssh2_channel_close(channel);
+        libssh2_channel_wait_closed(channel);
+        exitStatus = libssh2_channel_get_exit_status(channel);
+        libssh2_channel_free(channel);
+        return S_OK;
+    }
+
+    uint64_t lastUsedTick = 0;
+
+private:
+    [[nodiscard]] HRESULT VerifyHostKey(const ConnectionInfo& conn, unsigned int port) noexcept
+    {
+        // Like libcurl: without a known_hosts file the host key is not checked; with one, it must match.
+        if (conn.sshKnownHosts.empty())
+        {
+            return S_OK;
+        }
+
+        LIBSSH2_KNOWNHOSTS* knownHosts = libssh2_knownhost_init(_session);
+        if (! knownHosts)
+        {
+            return E_OUTOFMEMORY;
+        }
+        const auto freeKnownHosts = wil::scope_exit([&]() noexcept { libssh2_knownhost_free(knownHosts); });
+
+        if (libssh2_knownhost_readfile(knownHosts, conn.sshKnownHosts.c_str(), LIBSSH2_KNOWNHOST_FILE_OPENSSH) < 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        size_t keyLength    = 0;
+        int keyType         = 0;
+        const char* hostKey = libssh2_session_hostkey(_session, &keyLength, &keyType);
+        if (! hostKey)
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+
+        int keyBit = 0;
+        switch (keyType)
+        {
+            case LIBSSH2_HOSTKEY_TYPE_RSA: keyBit = LIBSSH2_KNOWNHOST_KEY_SSHRSA; break;
+            case LIBSSH2_HOSTKEY_TYPE_DSS: keyBit = LIBSSH2_KNOWNHOST_KEY_SSHDSS; break;
+            case LIBSSH2_HOSTKEY_TYPE_ECDSA_256: keyBit = LIBSSH2_KNOWNHOST_KEY_ECDSA_256; break;
+            case LIBSSH2_HOSTKEY_TYPE_ECDSA_384: keyBit = LIBSSH2_KNOWNHOST_KEY_ECDSA_384; break;
+            case LIBSSH2_HOSTKEY_TYPE_ECDSA_521: keyBit = LIBSSH2_KNOWNHOST_KEY_ECDSA_521; break;
+            case LIBSSH2_HOSTKEY_TYPE_ED25519: keyBit = LIBSSH2_KNOWNHOST_KEY_ED25519; break;
+            default: return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+
+        const int check = libssh2_knownhost_checkp(knownHosts,
+                                                   conn.host.c_str(),
+                                                   static_cast<int>(port),
+                                                   hostKey,
+                                                   keyLength,
+                                                   LIBSSH2_KNOWNHOST_TYPE_PLAIN | LIBSSH2_KNOWNHOST_KEYENC_RAW | keyBit,
+                                                   nullptr);
+        return check == LIBSSH2_KNOWNHOST_CHECK_MATCH ? S_OK : HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    [[nodiscard]] HRESULT Authenticate(const ConnectionInfo& conn) noexcept
+    {
+        const unsigned int userLength = static_cast<unsigned int>(conn.user.size());
+
+        int rc = LIBSSH2_ERROR_AUTHENTICATION_FAILED;
+        if (! conn.sshPrivateKey.empty())
+        {
+            rc = libssh2_userauth_publickey_fromfile_ex(_session,
+                                                        conn.user.c_str(),
+                                                        userLength,
+                                                        conn.sshPublicKey.empty() ? nullptr : conn.sshPublicKey.c_str(),
+                                                        conn.sshPrivateKey.c_str(),
+                                                        conn.sshKeyPassphrase.empty() ? nullptr : conn.sshKeyPassphrase.c_str());
+        }
+        if (rc != 0 && ! conn.password.empty())
+        {
+            rc = libssh2_userauth_password_ex(
+                _session, conn.user.c_str(), userLength, conn.password.c_str(), static_cast<unsigned int>(conn.password.size()), nullptr);
+        }
+        return rc == 0 ? S_OK : HRESULT_FROM_WIN32(ERROR_LOGON_FAILURE);
+    }
+
+    wil::unique_socket _socket;
+    LIBSSH2_SESSION* _session = nullptr;
+};
+
+// Idle authenticated sessions per endpoint, so a folder of small files pays for one SSH handshake instead of one each.
+struct SshSessionPool
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, std::vector<std::unique_ptr<SshSession>>> idle;
+};
+
+[[nodiscard]] SshSessionPool& GetSshSessionPool() noexcept
+{
+    static SshSessionPool pool;
+    return pool;
+}
+
+[[nodiscard]] std::unique_ptr<SshSession> TakeIdleSshSession(const std::string& endpointKey) noexcept
+{
+    SshSessionPool& pool = GetSshSessionPool();
+    std::vector<std::unique_ptr<SshSession>> stale;
+    std::unique_ptr<SshSession> session;
+    {
+        std::scoped_lock lock(pool.mutex);
+        const auto it = pool.idle.find(endpointKey);
+        if (it != pool.idle.end())
+        {
+            const uint64_t now = GetTickCount64();
+            while (! it->second.empty())
+            {
+                std::unique_ptr<SshSession> candidate = std::move(it->second.back());
+                it->second.pop_back();
+                if (now - candidate->lastUsedTick < kIdleSshSessionMs)
+                {
+                    session = std::move(candidate);
+                    break;
+                }
+                stale.push_back(std::move(candidate));
+            }
+        }
+    }
+
+    // Stale sessions disconnect outside the lock.
+    stale.clear();
+    return session;
+}
+
+void ReturnSshSession(const std::string& endpointKey, std::unique_ptr<SshSession> session, unsigned int maxIdle) noexcept
+{
+    session->lastUsedTick = GetTickCount64();
+
+    SshSessionPool& pool = GetSshSessionPool();
+    {
+        std::scoped_lock lock(pool.mutex);
+        auto& sessions = pool.idle[endpointKey];
+        if (sessions.size() < std::max(1u, maxIdle))
+        {
+            sessions.push_back(std::move(session));
+        }
+    }
+}
+
+[[nodiscard]] AttemptResult CopyViaSshExec(const ConnectionInfo& sourceConn,
+                                           std::wstring_view sourceRemotePath,
+                                           const ConnectionInfo& destinationConn,
+                                           std::wstring_view destinationRemotePath,
+                                           FileOperationProgress& progress,
+                                           HRESULT& cancelHr) noexcept
+{
+    const std::string command = std::format("cp -p -- {} {}",
+                                            QuoteShellPath(RemotePathForCommand(sourceConn, sourceRemotePath)),
+                                            QuoteShellPath(RemotePathForCommand(destinationConn, destinationRemotePath)));
+    const std::string endpointKey = BuildEndpointKey(destinationConn);
+
+    // A pooled session may have been dropped by the server; retry once on a fresh one.
+    std::unique_ptr<SshSession> session = TakeIdleSshSession(endpointKey);
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        const bool pooled = session != nullptr;
+        if (! pooled)
+        {
+            session = std::make_unique<SshSession>();
+            const HRESULT openHr = session->Open(destinationConn);
+            if (FAILED(openHr))
+            {
+                Debug::Warning(L"server copy: ssh session to '{}' failed hr={:#x}", Utf16FromUtf8(destinationConn.host), static_cast<unsigned long>(openHr));
+                return AttemptResult::Rejected;
+            }
+        }
+
+        int exitStatus = -1;
+        std::string errorText;
+        const HRESULT hr = session->Execute(command, destinationConn, progress, exitStatus, errorText);
+        if (NormalizeCancellation(hr) == HRESULT_FROM_WIN32(ERROR_CANCELLED))
+        {
+            cancelHr = hr;
+            return AttemptResult::Failed;
+        }
+        if (FAILED(hr))
+        {
+            session.reset();
+            if (pooled)
+            {
+                continue;
+            }
+            return hr == HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED) ? AttemptResult::Rejected : AttemptResult::Failed;
+        }
+
+        ReturnSshSession(endpointKey, std::move(session), destinationConn.maxConnectionsPerHost);
+        if (exitStatus == 0)
+        {
+            return AttemptResult::Copied;
+        }
+
+        Debug::Warning(L"server copy: '{}' exited with {} on '{}': {}",
+                       Utf16FromUtf8(command),
+                       exitStatus,
+                       Utf16FromUtf8(destinationConn.host),
+                       Utf16FromUtf8(TrimAscii(errorText)));
+        return exitStatus == kShellCommandNotFoundExitStatus ? AttemptResult::Rejected : AttemptResult::Failed;
+    }
+
+    return AttemptResult::Failed;
+}
+
+// FTP SITE CPFR / CPTO ----------------------------------------------------------------------------------------------
+
+// Sends FTP commands on a fresh login without a transfer; server replies are appended to `replies`.
+[[nodiscard]] HRESULT FtpQuote(const ConnectionInfo& conn, const std::vector<std::string>& commands, std::string& replies) noexcept
+{
+    HRESULT hr = EnsureCurlInitialized();
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    unique_curl_easy curl{curl_easy_init()};
+    if (! curl)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    const std::string url = BuildUrl(conn, L"/", true, true);
+    if (url.empty())
+    {
+        return E_INVALIDARG;
+    }
+
+    unique_curl_slist list;
+    for (const auto& command : commands)
+    {
+        curl_slist* appended = curl_slist_append(list.get(), command.c_str());
+        if (! appended)
+        {
+            return E_OUTOFMEMORY;
+        }
+        list.release();
+        list.reset(appended);
+    }
+
+    curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_QUOTE, list.get());
+    curl_easy_setopt(curl.get(), CURLOPT_HEADERFUNCTION, CurlWriteToString);
+    curl_easy_setopt(curl.get(), CURLOPT_HEADERDATA, &replies);
+
+    ApplyCommonCurlOptions(curl.get(), conn, nullptr, false);
+
+    return HResultFromCurl(CurlPerform(conn, curl.get(), nullptr));
+}
+
+[[nodiscard]] bool IsSiteCopyAdvertised(const ConnectionInfo& conn) noexcept
+{
+    const std::string endpointKey = BuildEndpointKey(conn);
+    ServerCopyRegistry& registry  = GetServerCopyRegistry();
+    {
+        std::scoped_lock lock(registry.mutex);
+        const auto it = registry.siteCopyAdvertised.find(endpointKey);
+        if (it != registry.siteCopyAdvertised.end())
+        {
+            return it->second;
+        }
+    }
+
+    // proftpd's mod_copy lists CPFR/CPTO in the SITE HELP reply; other servers answer 5xx or omit them.
+    std::string replies;
+    const bool advertised = SUCCEEDED(FtpQuote(conn, {"SITE HELP"}, replies)) && replies.find("CPFR") != std::string::npos &&
+                            replies.find("CPTO") != std::string::npos;
+
+    std::scoped_lock lock(registry.mutex);
+    registry.siteCopyAdvertised[endpointKey] = advertised;
+    return advertised;
+}
+
+[[nodiscard]] AttemptResult CopyViaSiteCopy(const ConnectionInfo& sourceConn,
+                                            std::wstring_view sourceRemotePath,
+                                            const ConnectionInfo& destinationConn,
+                                            std::wstring_view destinationRemotePath) noexcept
+{
+    if (! IsSiteCopyAdvertised(destinationConn))
+    {
+        return AttemptResult::Rejected;
+    }
+
+    const std::vector<std::string> commands{
+        "SITE CPFR " + RemotePathForCommand(sourceConn, sourceRemotePath),
+        "SITE CPTO " + RemotePathForCommand(destinationConn, destinationRemotePath),
+    };
+
+    std::string replies;
+    const HRESULT hr = FtpQuote(destinationConn, commands, replies);
+    if (FAILED(hr))
+    {
+        Debug::Warning(L"server copy: SITE CPFR/CPTO failed on '{}' hr={:#x}", Utf16FromUtf8(destinationConn.host), static_cast<unsigned long>(hr));
+        return AttemptResult::Failed;
+    }
+    return AttemptResult::Copied;
+}
+
+// FXP ---------------------------------------------------------------------------------------------------------------
+
+// Minimal blocking FTP control connection (IPv4 only: PASV/PORT carry IPv4 addresses).
+class FtpControlConnection final
+{
+public:
+    [[nodiscard]] HRESULT Open(const ConnectionInfo& conn, FileOperationProgress& progress) noexcept
+    {
+        _progress  = &progress;
+        _timeoutMs = ConnectTimeoutMs(conn);
+
+        HRESULT hr = ConnectTcp(conn.host, conn.port.value_or(kDefaultFtpPort), AF_INET, _timeoutMs, _socket);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        int code = 0;
+        hr       = ReadReply(code, nullptr, _timeoutMs);
+        if (FAILED(hr) || code != 220)
+        {
+            return FAILED(hr) ? hr : HRESULT_FROM_WIN32(ERROR_CONNECTION_REFUSED);
+        }
+
+        const bool anonymous = conn.user.empty();
+        hr                   = Command("USER " + (anonymous ? std::string(kFtpAnonymousUser) : conn.user), code);
+        if (SUCCEEDED(hr) && code == 331)
+        {
+            hr = Command("PASS " + (anonymous ? std::string(kFtpAnonymousPassword) : conn.password), code);
+        }
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        if (code != 230 && code != 202)
+        {
+            return HRESULT_FROM_WIN32(ERROR_LOGON_FAILURE);
+        }
+
+        hr = Command("TYPE I", code);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        return code == 200 ? S_OK : HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    [[nodiscard]] HRESULT Command(const std::string& line, int& code, std::string* text = nullptr) noexcept
+    {
+        const HRESULT hr = Send(line);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        return ReadReply(code, text, _timeoutMs);
+    }
+
+    [[nodiscard]] HRESULT Send(const std::string& line) noexcept
+    {
+        const std::string wire = line + "\r\n";
+        size_t sent            = 0;
+        while (sent < wire.size())
+        {
+            const int chunk = send(_socket.get(), wire.data() + sent, static_cast<int>(wire.size() - sent), 0);
+            if (chunk == SOCKET_ERROR)
+            {
+                return HResultFromWsa(WSAGetLastError());
+            }
+            sent += static_cast<size_t>(chunk);
+        }
+        return S_OK;
+    }
+
+    // Reads one (possibly multi-line) reply; `timeoutMs` 0 waits until the server answers or the task is cancelled.
+    [[nodiscard]] HRESULT ReadReply(int& code, std::string* text, unsigned long timeoutMs) noexcept
+    {
+        code = 0;
+        if (text)
+        {
+            text->clear();
+        }
+
+        int multiLineCode = 0;
+        for (;;)
+        {
+            const size_t lineEnd = _buffer.find("\r\n");
+            if (lineEnd == std::string::npos)
+            {
+                HRESULT hr = WaitSocket(_socket.get(), false, timeoutMs, _progress);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+
+                std::array<char, 1024> chunk{};
+                const int received = recv(_socket.get(), chunk.data(), static_cast<int>(chunk.size()), 0);
+                if (received <= 0)
+                {
+                    return received == 0 ? HRESULT_FROM_WIN32(ERROR_GRACEFUL_DISCONNECT) : HResultFromWsa(WSAGetLastError());
+                }
+                _buffer.append(chunk.data(), static_cast<size_t>(received));
+                continue;
+            }
+
+            const std::string line = _buffer.substr(0, lineEnd);
+            _buffer.erase(0, lineEnd + 2u);
+            if (text)
+            {
+                text->append(line).push_back('\n');
+            }
+
+            const bool hasCode = line.size() >= 4u && std::isdigit(static_cast<unsigned char>(line[0])) &&
+                                 std::isdigit(static_cast<unsigned char>(line[1])) && std::isdigit(static_cast<unsigned char>(line[2]));
+            if (! hasCode)
+            {
+                continue;
+            }
+
+            const int lineCode = (line[0] - '0') * 100 + (line[1] - '0') * 10 + (line[2] - '0');
+            if (multiLineCode == 0 && line[3] == '-')
+            {
+                multiLineCode = lineCode;
+                continue;
+            }
+            if (multiLineCode != 0 && (lineCode != multiLineCode || line[3] != ' '))
+            {
+                continue;
+            }
+
+            code = lineCode;
+            return S_OK;
+        }
+    }
+
+    [[nodiscard]] bool GetPeerAddress(in_addr& out) const noexcept
+    {
+        sockaddr_in peer{};
+        int peerLength = sizeof(peer);
+        if (getpeername(_socket.get(), reinterpret_cast<sockaddr*>(&peer), &peerLength) != 0 || peer.sin_family != AF_INET)
+        {
+            return false;
+        }
+        out = peer.sin_addr;
+        return true;
+    }
+
+    void Quit() noexcept
+    {
+        if (_socket)
+        {
+            static_cast<void>(Send("QUIT"));
+            _socket.reset();
+        }
+    }
+
+private:
+    wil::unique_socket _socket;
+    std::string _buffer;
+    unsigned long _timeoutMs         = 0;
+    FileOperationProgress* _progress = nullptr;
+};
+
+[[nodiscard]] bool IsPrivateOrUnspecifiedIpv4(const std::array<unsigned int, 4>& octets) noexcept
+{
+    return octets[0] == 0 || octets[0] == 10 || octets[0] == 127 || (octets[0] == 172 && octets[1] >= 16 && octets[1] <= 31) ||
+           (octets[0] == 192 && octets[1] == 168) || (octets[0] == 169 && octets[1] == 254);
+}
+
+// Parses "227 Entering Passive Mode (h1,h2,h3,h4,p1,p2)" into the PORT argument "h1,h2,h3,h4,p1,p2". NAT'd servers
+// often advertise a private address; the destination cannot reach that, so the control connection's peer is used.
+[[nodiscard]] bool BuildPortArgument(const std::string& pasvReply, const FtpControlConnection& source, std::string& out) noexcept
+{
+    const size_t open = pasvReply.find('(');
+    if (open == std::string::npos)
+    {
+        return false;
+    }
+
+    std::array<unsigned int, 6> values{};
+    const char* cursor = pasvReply.c_str() + open + 1u;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        char* end       = nullptr;
+        const auto part = std::strtoul(cursor, &end, 10);
+        if (end == cursor || part > 255u || (i + 1u < values.size() && *end != ','))
+        {
+            return false;
+        }
+        values[i] = static_cast<unsigned int>(part);
+        cursor    = end + 1;
+    }
+
+    std::array<unsigned int, 4> octets{values[0], values[1], values[2], values[3]};
+    in_addr peer{};
+    if (IsPrivateOrUnspecifiedIpv4(octets) && source.GetPeerAddress(peer))
+    {
+        const std::array<unsigned int, 4> peerOctets{peer.S_un.S_un_b.s_b1, peer.S_un.S_un_b.s_b2, peer.S_un.S_un_b.s_b3, peer.S_un.S_un_b.s_b4};
+        if (! IsPrivateOrUnspecifiedIpv4(peerOctets))
+        {
+            octets = peerOctets;
+        }
+    }
+
+    out = std::format("{},{},{},{},{},{}", octets[0], octets[1], octets[2], octets[3], values[4], values[5]);
+    return true;
+}
+
+[[nodiscard]] bool IsPreliminaryReply(int code) noexcept
+{
+    return code == 125 || code == 150;
+}
+
+[[nodiscard]] bool IsTransferCompleteReply(int code) noexcept
+{
+    return code == 226 || code == 250;
+}
+
+[[nodiscard]] AttemptResult CopyViaFxp(const ConnectionInfo& sourceConn,
+                                       std::wstring_view sourceRemotePath,
+                                       const ConnectionInfo& destinationConn,
+                                       std::wstring_view destinationRemotePath,
+                                       FileOperationProgress& progress,
+                                       HRESULT& cancelHr) noexcept
+{
+    const auto isCancel = [&](HRESULT hr) noexcept
+    {
+        if (NormalizeCancellation(hr) == HRESULT_FROM_WIN32(ERROR_CANCELLED))
+        {
+            cancelHr = hr;
+            return true;
+        }
+        return false;
+    };
+
+    FtpControlConnection source;
+    FtpControlConnection destination;
+
+    HRESULT hr = source.Open(sourceConn, progress);
+    if (SUCCEEDED(hr))
+    {
+        hr = destination.Open(destinationConn, progress);
+    }
+    if (FAILED(hr))
+    {
+        return isCancel(hr) ? AttemptResult::Failed : AttemptResult::Rejected;
+    }
+
+    int code = 0;
+    std::string reply;
+    std::string portArgument;
+    hr = source.Command("PASV", code, &reply);
+    if (FAILED(hr) || code != 227 || ! BuildPortArgument(reply, source, portArgument))
+    {
+        return isCancel(hr) ? AttemptResult::Failed : AttemptResult::Rejected;
+    }
+
+    // Servers with FXP protection refuse a PORT that names a host other than the client.
+    hr = destination.Command("PORT " + portArgument, code);
+    if (FAILED(hr) || code != 200)
+    {
+        return isCancel(hr) ? AttemptResult::Failed : AttemptResult::Rejected;
+    }
+
+    const std::string destinationPath = RemotePathForCommand(destinationConn, destinationRemotePath);
+    hr                                = destination.Command("STOR " + destinationPath, code);
+    if (FAILED(hr) || ! IsPreliminaryReply(code))
+    {
+        static_cast<void>(isCancel(hr));
+        return AttemptResult::Failed;
+    }
+
+    const auto abandon = [&]() noexcept
+    {
+        // The destination may hold a partial file; DELE it on a fresh reply cycle (best-effort).
+        static_cast<void>(destination.Send("ABOR"));
+        source.Quit();
+        int ignored = 0;
+        static_cast<void>(destination.ReadReply(ignored, nullptr, ConnectTimeoutMs(destinationConn)));
+        static_cast<void>(destination.Command("DELE " + destinationPath, ignored));
+        destination.Quit();
+        InvalidateCachedParentListing(destinationConn, destinationRemotePath);
+    };
+
+    hr = source.Command("RETR " + RemotePathForCommand(sourceConn, sourceRemotePath), code);
+    if (FAILED(hr) || ! IsPreliminaryReply(code))
+    {
+        abandon();
+        static_cast<void>(isCancel(hr));
+        return AttemptResult::Failed;
+    }
+
+    // The servers move the data between themselves; both answer once the data connection closes.
+    hr = source.ReadReply(code, nullptr, destinationConn.operationTimeoutMs);
+    if (SUCCEEDED(hr) && IsTransferCompleteReply(code))
+    {
+        hr = destination.ReadReply(code, nullptr, destinationConn.operationTimeoutMs);
+    }
+    if (FAILED(hr) || ! IsTransferCompleteReply(code))
+    {
+        abandon();
+        static_cast<void>(isCancel(hr));
+        return AttemptResult::Failed;
+    }
+
+    source.Quit();
+    destination.Quit();
+    return AttemptResult::Copied;
+}
+} // namespace
+
+namespace FileSystemCurlInternal
+{
+bool IsServerSideCopyCandidate(const ConnectionInfo& sourceConn, const ConnectionInfo& destinationConn) noexcept
+{
+    for (const ServerCopyMethod method : SelectMethods(sourceConn, destinationConn))
+    {
+        if (! IsMethodRejected(BuildMethodKey(method, sourceConn, destinationConn)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+HRESULT TryServerSideCopyFile(const ConnectionInfo& sourceConn,
+                              std::wstring_view sourceRemotePath,
+                              const ConnectionInfo& destinationConn,
+                              std::wstring_view destinationRemotePath,
+                              FileOperationProgress& progress) noexcept
+{
+    bool attempted = false;
+    for (const ServerCopyMethod method : SelectMethods(sourceConn, destinationConn))
+    {
+        const std::string key = BuildMethodKey(method, sourceConn, destinationConn);
+        if (IsMethodRejected(key))
+        {
+            continue;
+        }
+
+        HRESULT cancelHr     = S_OK;
+        AttemptResult result = AttemptResult::Failed;
+        switch (method)
+        {
+            case ServerCopyMethod::SshExec:
+                result = CopyViaSshExec(sourceConn, sourceRemotePath, destinationConn, destinationRemotePath, progress, cancelHr);
+                break;
+            case ServerCopyMethod::SiteCopy: result = CopyViaSiteCopy(sourceConn, sourceRemotePath, destinationConn, destinationRemotePath); break;
+            case ServerCopyMethod::Fxp: result = CopyViaFxp(sourceConn, sourceRemotePath, destinationConn, destinationRemotePath, progress, cancelHr); break;
+        }
+
+        if (FAILED(cancelHr))
+        {
+            // A cancelled cp/FXP may leave a partial destination file.
+            static_cast<void>(RemoteDeleteFile(destinationConn, destinationRemotePath));
+            return cancelHr;
+        }
+
+        attempted = true;
+        RecordAttempt(key, result);
+        if (result == AttemptResult::Copied)
+        {
+            InvalidateCachedParentListing(destinationConn, destinationRemotePath);
+            ServerCopyTallyScope::tlsServerSideFiles += 1u;
+            return S_OK;
+        }
+
+        Debug::Info(L"server copy: {} {} for '{}' -> '{}'; trying next method",
+                    MethodName(method),
+                    result == AttemptResult::Rejected ? L"unsupported" : L"failed",
+                    sourceRemotePath,
+                    destinationRemotePath);
+    }
+
+    if (attempted)
+    {
+        ServerCopyTallyScope::tlsRelayedFiles += 1u;
+    }
+    return S_FALSE;
+}
+} // namespace FileSystemCurlInternal
@@ -165,136 +165,8 @@ namespace FileSystemCurlInternal
 
 // FilesInformationCurl
 
-HRESULT STDMETHODCALLTYPE FilesInformationCurl::QueryInterface(REFIID riid, void** ppvObject) noexcept
-{
-    if (ppvObject == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    if (riid == __uuidof(IUnknown) || riid == __uuidof(IFilesInformation))
-    {
-        *ppvObject = static_cast<IFilesInformation*>(this);
-        AddRef();
-        return S_OK;
-    }
-
-    *ppvObject = nullptr;
-    return E_NOINTERFACE;
-}
-
-ULONG STDMETHODCALLTYPE FilesInformationCurl::AddRef() noexcept
-{
-    return _refCount.fetch_add(1, std::memory_order_relaxed) + 1;
-}
-
-ULONG STDMETHODCALLTYPE FilesInformationCurl::Release() noexcept
-{
-    const ULONG result = _refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
-    if (result == 0)
-    {
-        delete this;
-    }
-    return result;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformationCurl::GetBuffer(FileInfo** ppFileInfo) noexcept
-{
-    if (ppFileInfo == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    *ppFileInfo = nullptr;
-
-    if (_usedBytes == 0 || _buffer.empty())
-    {
-        return S_OK;
-    }
-
-    *ppFileInfo = reinterpret_cast<FileInfo*>(_buffer.data());
-    return S_OK;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformationCurl::GetBufferSize(unsigned long* pSize) noexcept
-{
-    if (pSize == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    *pSize = _usedBytes;
-    return S_OK;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformationCurl::GetAllocatedSize(unsigned long* pSize) noexcept
-{
-    if (pSize == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    if (_buffer.size() > static_cast<size_t>((std::numeric_limits<unsigned long>::max)()))
-    {
-        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-    }
-
-    *pSize = static_cast<unsigned long>(_buffer.size());
-    return S_OK;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformationCurl::GetCount(unsigned long* pCount) noexcept
-{
-    if (pCount == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    *pCount = _count;
-    return S_OK;
-}
-
-HRESULT STDMETHODCALLTYPE FilesInformationCurl::Get(unsigned long index, FileInfo** ppEntry) noexcept
-{
-    if (ppEntry == nullptr)
-    {
-        return E_POINTER;
-    }
-
-    *ppEntry = nullptr;
-
-    if (index >= _count)
-    {
-        return HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES);
-    }
-
-    return LocateEntry(index, ppEntry);
-}
-
-size_t FilesInformationCurl::AlignUp(size_t value, size_t alignment) noexcept
-{
-    const size_t mask = alignment - 1u;
-    return (value + mask) & ~mask;
-}
-
-size_t FilesInformationCurl::ComputeEntrySizeBytes(std::wstring_view name) noexcept
-{
-    const size_t baseSize = offsetof(FileInfo, FileName);
-    const size_t nameSize = name.size() * sizeof(wchar_t);
-    return AlignUp(baseSize + nameSize + sizeof(wchar_t), sizeof(unsigned long));
-}
-
 HRESULT FilesInformationCurl::BuildFromEntries(std::vector<Entry> entries) noexcept
 {
-    _buffer.clear();
-    _count     = 0;
-    _usedBytes = 0;
-
-    if (entries.empty())
-    {
-        return S_OK;
-    }
-
     std::sort(entries.begin(),
               entries.end(),
               [](const Entry& a, const Entry& b)
@@ -315,101 +187,7 @@ HRESULT FilesInformationCurl::BuildFromEntries(std::vector<Entry> entries) noexc
                   return a.sizeBytes < b.sizeBytes;
               });
 
-    size_t totalBytes = 0;
-    for (const auto& entry : entries)
-    {
-        totalBytes += ComputeEntrySizeBytes(entry.name);
-        if (totalBytes > static_cast<size_t>((std::numeric_limits<unsigned long>::max)()))
-        {
-            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-        }
-    }
-
-    _buffer.resize(totalBytes, std::byte{0});
-
-    std::byte* base     = _buffer.data();
-    size_t offset       = 0;
-    FileInfo* previous  = nullptr;
-    size_t previousSize = 0;
-
-    for (const auto& source : entries)
-    {
-        const size_t entrySize = ComputeEntrySizeBytes(source.name);
-        if (offset + entrySize > _buffer.size())
-        {
-            return E_FAIL;
-        }
-
-        auto* entry = reinterpret_cast<FileInfo*>(base + offset);
-        std::memset(entry, 0, entrySize);
-
-        const size_t nameBytes = source.name.size() * sizeof(wchar_t);
-        if (nameBytes > static_cast<size_t>((std::numeric_limits<unsigned long>::max)()))
-        {
-            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-        }
-
-        entry->FileAttributes = source.attributes;
-        entry->FileIndex      = source.fileIndex;
-        entry->EndOfFile      = static_cast<__int64>(source.sizeBytes);
-        entry->AllocationSize = static_cast<__int64>(source.sizeBytes);
-
-        entry->CreationTime   = source.creationTime;
-        entry->LastAccessTime = source.lastAccessTime;
-        entry->LastWriteTime  = source.lastWriteTime;
-        entry->ChangeTime     = source.changeTime;
-
-        entry->FileNameSize = static_cast<unsigned long>(nameBytes);
-        if (! source.name.empty())
-        {
-            std::memcpy(entry->FileName, source.name.data(), nameBytes);
-        }
-        entry->FileName[source.name.size()] = L'\0';
-
-        if (previous)
-        {
-            previous->NextEntryOffset = static_cast<unsigned long>(previousSize);
-        }
-
-        previous     = entry;
-        previousSize = entrySize;
-
-        offset += entrySize;
-        ++_count;
-    }
-
-    _usedBytes = static_cast<unsigned long>(_buffer.size());
-    return S_OK;
-}
-
-HRESULT FilesInformationCurl::LocateEntry(unsigned long index, FileInfo** ppEntry) const noexcept
-{
-    const std::byte* base      = _buffer.data();
-    size_t offset              = 0;
-    unsigned long currentIndex = 0;
-
-    while (offset < _usedBytes && offset + sizeof(FileInfo) <= _buffer.size())
-    {
-        auto* entry = reinterpret_cast<const FileInfo*>(base + offset);
-        if (currentIndex == index)
-        {
-            *ppEntry = const_cast<FileInfo*>(entry);
-            return S_OK;
-        }
-
-        const size_t advance = (entry->NextEntryOffset != 0)
-                                   ? static_cast<size_t>(entry->NextEntryOffset)
-                                   : ComputeEntrySizeBytes(std::wstring_view(entry->FileName, static_cast<size_t>(entry->FileNameSize) / sizeof(wchar_t)));
-        if (advance == 0)
-        {
-            break;
-        }
-
-        offset += advance;
-        ++currentIndex;
-    }
-
-    return HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES);
+    return Assign(entries);
 }
 
 namespace FileSystemCurlInternal
@@ -790,10 +568,27 @@ namespace FileSystemCurlInternal
     out.connection.connectTimeoutMs   = settings.connectTimeoutMs;
     out.connection.operationTimeoutMs = settings.operationTimeoutMs;
     out.connection.ignoreSslTrust     = settings.ignoreSslTrust;
-    out.connection.sshPrivateKey      = Utf8FromUtf16(settings.sshPrivateKey);
-    out.connection.sshPublicKey       = Utf8FromUtf16(settings.sshPublicKey);
-    out.connection.sshKeyPassphrase   = Utf8FromUtf16(settings.sshKeyPassphrase);
-    out.connection.sshKnownHosts      = Utf8FromUtf16(settings.sshKnownHosts);
+
+    out.connection.multiTransferEngine   = settings.multiTransferEngine;
+    out.connection.maxConnectionsPerHost = settings.maxConnectionsPerHost;
+    out.connection.sftpRequestWindow     = settings.sftpRequestWindow;
+    out.connection.sftpAdaptiveWindow    = settings.sftpAdaptiveWindow;
+
+    out.connection.persistentListingCache = settings.persistentListingCache && protocol != Protocol::Imap;
+    out.connection.listingCacheTtlSeconds = settings.listingCacheTtlSeconds;
+
+    out.connection.serverSideCopy = settings.serverSideCopy && protocol != Protocol::Imap;
+
+    // libcurl resumes FTP and SFTP transfers only (no offsets for SCP; IMAP appends whole messages).
+    out.connection.resumableTransfers = settings.resumableTransfers && (protocol == Protocol::Ftp || protocol == Protocol::Sftp);
+
+    out.connection.imapMessageCache      = settings.imapMessageCache && protocol == Protocol::Imap;
+    out.connection.imapMessageCacheMaxMB = settings.imapMessageCacheMaxMB;
+
+    out.connection.sshPrivateKey    = Utf8FromUtf16(settings.sshPrivateKey);
+    out.connection.sshPublicKey     = Utf8FromUtf16(settings.sshPublicKey);
+    out.connection.sshKeyPassphrase = Utf8FromUtf16(settings.sshKeyPassphrase);
+    out.connection.sshKnownHosts    = Utf8FromUtf16(settings.sshKnownHosts);
 
     const std::wstring normalizedFull = NormalizePluginPath(pluginPath);
 
@@ -1735,8 +1530,130 @@ void CurlShareUnlock(CURL* /*handle*/, curl_lock_data data, void* userptr) noexc
 
     return ctx.share;
 }
+
+constexpr uint64_t kSftpRequestBytes          = 30000u;             // libssh2 MAX_SFTP_READ_SIZE / write chunk
+constexpr uint64_t kCurlMaxDownloadBufferSize = 10ull * 1024 * 1024; // CURLOPT_BUFFERSIZE upper bound
+constexpr uint64_t kCurlMaxUploadBufferSize   = 2ull * 1024 * 1024;  // CURLOPT_UPLOAD_BUFFERSIZE upper bound
+constexpr uint64_t kSftpMinWindowsPerSample   = 4u;                  // shorter transfers end before the window matters
+constexpr double kSftpGrowRatio               = 0.6;
+constexpr double kSftpShrinkRatio             = 0.25;
+
+struct SftpWindowState final
+{
+    unsigned int configured = 1;
+    unsigned int window     = 1;
+    uint64_t rttUs          = 0; // smoothed (1/8 weight per sample)
+};
+
+struct SftpWindowRegistry final
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, SftpWindowState> endpoints;
+};
+
+[[nodiscard]] SftpWindowRegistry& GetSftpWindowRegistry() noexcept
+{
+    static SftpWindowRegistry registry;
+    return registry;
+}
+
+[[nodiscard]] uint64_t GetCurlInfoUInt(CURL* curl, CURLINFO info) noexcept
+{
+    curl_off_t value = 0;
+    if (curl_easy_getinfo(curl, info, &value) != CURLE_OK || value < 0)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(value);
+}
 } // namespace
 
+std::string BuildEndpointKey(const ConnectionInfo& conn)
+{
+    return std::format("{}|{}|{}|{}", static_cast<int>(conn.protocol), conn.host, conn.port.value_or(0u), conn.user);
+}
+
+unsigned int GetSftpRequestWindow(const ConnectionInfo& conn) noexcept
+{
+    const unsigned int configured = std::clamp(conn.sftpRequestWindow, 1u, FileSystemCurl::kMaxSftpRequestWindow);
+    if (! conn.sftpAdaptiveWindow)
+    {
+        return configured;
+    }
+
+    SftpWindowRegistry& registry = GetSftpWindowRegistry();
+    const std::string key        = BuildEndpointKey(conn);
+
+    std::scoped_lock lock(registry.mutex);
+    SftpWindowState& state = registry.endpoints[key];
+    if (state.configured != configured || state.window < configured)
+    {
+        state.configured = configured;
+        state.window     = configured;
+    }
+    return state.window;
+}
+
+void ObserveSftpTransfer(std::string_view endpointKey, CURL* curl, CURLcode code) noexcept
+{
+    if (! curl || code != CURLE_OK)
+    {
+        return;
+    }
+
+    const uint64_t bytes       = (std::max)(GetCurlInfoUInt(curl, CURLINFO_SIZE_DOWNLOAD_T), GetCurlInfoUInt(curl, CURLINFO_SIZE_UPLOAD_T));
+    const uint64_t connectUs   = GetCurlInfoUInt(curl, CURLINFO_CONNECT_TIME_T);
+    const uint64_t preUs       = GetCurlInfoUInt(curl, CURLINFO_PRETRANSFER_TIME_T);
+    const uint64_t firstByteUs = GetCurlInfoUInt(curl, CURLINFO_STARTTRANSFER_TIME_T);
+    const uint64_t totalUs     = GetCurlInfoUInt(curl, CURLINFO_TOTAL_TIME_T);
+
+    // RTT sample: the TCP handshake on a fresh connection, otherwise the first request/response after the handle opened.
+    const uint64_t rttSampleUs = connectUs > 0 ? connectUs : (firstByteUs > preUs ? firstByteUs - preUs : 0);
+    const uint64_t dataUs      = totalUs > firstByteUs ? totalUs - firstByteUs : 0;
+
+    SftpWindowRegistry& registry = GetSftpWindowRegistry();
+    std::scoped_lock lock(registry.mutex);
+    const auto found = registry.endpoints.find(std::string(endpointKey));
+    if (found == registry.endpoints.end())
+    {
+        return; // not an adaptive SFTP endpoint
+    }
+
+    SftpWindowState& state = found->second;
+    if (rttSampleUs > 0)
+    {
+        state.rttUs = state.rttUs == 0 ? rttSampleUs : (state.rttUs * 7u + rttSampleUs) / 8u;
+    }
+
+    const uint64_t windowBytes = static_cast<uint64_t>(state.window) * kSftpRequestBytes;
+    if (state.rttUs == 0 || dataUs == 0 || bytes < windowBytes * kSftpMinWindowsPerSample)
+    {
+        return;
+    }
+
+    // A window of W requests cannot move more than W * request size per round trip.
+    const double windowBoundBytesPerUs = static_cast<double>(windowBytes) / static_cast<double>(state.rttUs);
+    const double measuredBytesPerUs    = static_cast<double>(bytes) / static_cast<double>(dataUs);
+    if (measuredBytesPerUs >= windowBoundBytesPerUs * kSftpGrowRatio)
+    {
+        state.window = (std::min)(state.window * 2u, FileSystemCurl::kMaxSftpRequestWindow);
+    }
+    else if (measuredBytesPerUs < windowBoundBytesPerUs * kSftpShrinkRatio)
+    {
+        state.window = (std::max)(state.window / 2u, state.configured);
+    }
+}
+
+void ObserveSftpTransfer(const ConnectionInfo& conn, CURL* curl, CURLcode code) noexcept
+{
+    if (conn.protocol != Protocol::Sftp || ! conn.sftpAdaptiveWindow)
+    {
+        return;
+    }
+
+    ObserveSftpTransfer(BuildEndpointKey(conn), curl, code);
+}
+
 [[nodiscard]] HRESULT HResultFromCurl(CURLcode code) noexcept
 {
 #pragma warning(push)
@@ -1798,6 +1715,16 @@ void ApplyCommonCurlOptions(CURL* curl, const ConnectionInfo& conn, const FileSy
             curl_easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, kBufferBytes);
         }
     }
+    else if (conn.protocol == Protocol::Sftp)
+    {
+        // Uploads top out at libcurl's 2 MiB upload buffer (~69 outstanding WRITE requests).
+        const uint64_t windowBytes = static_cast<uint64_t>(GetSftpRequestWindow(conn)) * kSftpRequestBytes;
+        curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, static_cast<long>((std::min)(windowBytes, kCurlMaxDownloadBufferSize)));
+        if (forUpload)
+        {
+            curl_easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, static_cast<long>((std::min)(windowBytes, kCurlMaxUploadBufferSize)));
+        }
+    }
     curl_easy_setopt(curl, CURLOPT_FTP_USE_EPSV, conn.ftpUseEpsv ? 1L : 0L);
     curl_easy_setopt(curl, CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
     curl_easy_setopt(curl, CURLOPT_PROXY_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
@@ -2107,8 +2034,13 @@ int CurlXferInfo(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t
 
     const uint64_t nowTick = GetTickCount64();
 
-    const uint64_t phaseTotal = ClampCurlOffToUInt64(ctx->isUpload ? ultotal : dltotal);
-    const uint64_t phaseNow   = ClampCurlOffToUInt64(ctx->isUpload ? ulnow : dlnow);
+    const uint64_t curlTotal = ClampCurlOffToUInt64(ctx->isUpload ? ultotal : dltotal);
+    const uint64_t curlNow   = ClampCurlOffToUInt64(ctx->isUpload ? ulnow : dlnow);
+
+    // A resumed transfer reports only the bytes after its resume offset; the item still counts from zero.
+    constexpr uint64_t kMaxBytes = (std::numeric_limits<uint64_t>::max)();
+    const uint64_t phaseTotal    = curlTotal == 0 ? 0 : (curlTotal > kMaxBytes - ctx->resumedBytes ? kMaxBytes : curlTotal + ctx->resumedBytes);
+    const uint64_t phaseNow      = curlNow > kMaxBytes - ctx->resumedBytes ? kMaxBytes : curlNow + ctx->resumedBytes;
 
     if (ctx->itemTotalBytes == 0 && phaseTotal > 0)
     {
@@ -2195,16 +2127,24 @@ int CurlXferInfo(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t
     if (limit > 0 && ctx->throttleStartTick != 0)
     {
         const uint64_t elapsedMs = nowTick - ctx->throttleStartTick;
-        if (elapsedMs > 0 && phaseNow > 0)
+        if (elapsedMs > 0 && curlNow > 0)
         {
-            const double expectedMs = (static_cast<double>(phaseNow) * 1000.0) / static_cast<double>(limit);
+            const double expectedMs = (static_cast<double>(curlNow) * 1000.0) / static_cast<double>(limit);
             const double elapsed    = static_cast<double>(elapsedMs);
             if (expectedMs > elapsed)
             {
                 const double sleepMs = expectedMs - elapsed;
                 if (sleepMs >= 1.0)
                 {
-                    Sleep(static_cast<DWORD>((std::min)(sleepMs, 200.0)));
+                    const DWORD delayMs = static_cast<DWORD>((std::min)(sleepMs, 200.0));
+                    if (ctx->deferThrottle)
+                    {
+                        ctx->throttleResumeTick = nowTick + delayMs;
+                    }
+                    else
+                    {
+                        Sleep(delayMs);
+                    }
                 }
             }
         }
@@ -2255,7 +2195,7 @@ int CurlXferInfo(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t
 
     ApplyCommonCurlOptions(curl.get(), conn, nullptr, false);
 
-    const CURLcode code = curl_easy_perform(curl.get());
+    const CURLcode code = CurlPerform(conn, curl.get(), nullptr);
     if (code != CURLE_OK)
     {
         long responseCode = 0;
@@ -2341,7 +2281,7 @@ int CurlXferInfo(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t
 
     ApplyCommonCurlOptions(curl.get(), conn, nullptr, false);
 
-    const CURLcode code = curl_easy_perform(curl.get());
+    const CURLcode code = CurlPerform(conn, curl.get(), nullptr);
     if (code != CURLE_OK)
     {
         long responseCode = 0;
@@ -2375,61 +2315,83 @@ int CurlXferInfo(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t
     return HResultFromCurl(code);
 }
 
-[[nodiscard]] HRESULT CurlDownloadToFile(
-    const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, const FileSystemOptions* options, TransferProgressContext* progressCtx) noexcept
+[[nodiscard]] HRESULT PrepareCurlDownload(CURL* curl,
+                                          const ConnectionInfo& conn,
+                                          std::wstring_view pluginPath,
+                                          HANDLE file,
+                                          const FileSystemOptions* options,
+                                          TransferProgressContext* progressCtx) noexcept
 {
-    HRESULT hr = EnsureCurlInitialized();
-    if (FAILED(hr))
+    const std::string url = BuildUrl(conn, pluginPath, false, false);
+    if (url.empty())
     {
-        return hr;
+        return E_INVALIDARG;
     }
 
-    unique_curl_easy curl{curl_easy_init()};
-    if (! curl)
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CurlWriteToFile);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, file);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+
+    if (progressCtx)
     {
-        return E_OUTOFMEMORY;
+        progressCtx->Begin();
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, CurlXferInfo);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, progressCtx);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        ApplyCommonCurlOptions(curl, conn, nullptr, false);
+    }
+    else
+    {
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 1L);
+        ApplyCommonCurlOptions(curl, conn, options, false);
     }
 
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT PrepareCurlUpload(CURL* curl,
+                                        const ConnectionInfo& conn,
+                                        std::wstring_view pluginPath,
+                                        HANDLE file,
+                                        uint64_t sizeBytes,
+                                        const FileSystemOptions* options,
+                                        TransferProgressContext* progressCtx) noexcept
+{
     const std::string url = BuildUrl(conn, pluginPath, false, false);
     if (url.empty())
     {
         return E_INVALIDARG;
     }
 
-    curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, CurlWriteToFile);
-    curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, file);
-    curl_easy_setopt(curl.get(), CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+    curl_easy_setopt(curl, CURLOPT_READFUNCTION, CurlReadFromFile);
+    curl_easy_setopt(curl, CURLOPT_READDATA, file);
+    curl_easy_setopt(curl,
+                     CURLOPT_INFILESIZE_LARGE,
+                     static_cast<curl_off_t>(std::min<uint64_t>(sizeBytes, static_cast<uint64_t>((std::numeric_limits<curl_off_t>::max)()))));
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
 
     if (progressCtx)
     {
         progressCtx->Begin();
-        curl_easy_setopt(curl.get(), CURLOPT_XFERINFOFUNCTION, CurlXferInfo);
-        curl_easy_setopt(curl.get(), CURLOPT_XFERINFODATA, progressCtx);
-        curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 0L);
-        ApplyCommonCurlOptions(curl.get(), conn, nullptr, false);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, CurlXferInfo);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, progressCtx);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        ApplyCommonCurlOptions(curl, conn, nullptr, true);
     }
     else
     {
-        curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 1L);
-        ApplyCommonCurlOptions(curl.get(), conn, options, false);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 1L);
+        ApplyCommonCurlOptions(curl, conn, options, true);
     }
 
-    const CURLcode code = curl_easy_perform(curl.get());
-    if (code == CURLE_ABORTED_BY_CALLBACK && progressCtx && FAILED(progressCtx->abortHr))
-    {
-        return progressCtx->abortHr;
-    }
-
-    return HResultFromCurl(code);
+    return S_OK;
 }
 
-[[nodiscard]] HRESULT CurlUploadFromFile(const ConnectionInfo& conn,
-                                         std::wstring_view pluginPath,
-                                         HANDLE file,
-                                         uint64_t sizeBytes,
-                                         const FileSystemOptions* options,
-                                         TransferProgressContext* progressCtx) noexcept
+[[nodiscard]] HRESULT CurlDownloadToFile(
+    const ConnectionInfo& conn, std::wstring_view pluginPath, HANDLE file, const FileSystemOptions* options, TransferProgressContext* progressCtx) noexcept
 {
     HRESULT hr = EnsureCurlInitialized();
     if (FAILED(hr))
@@ -2443,42 +2405,43 @@ int CurlXferInfo(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t
         return E_OUTOFMEMORY;
     }
 
-    const std::string url = BuildUrl(conn, pluginPath, false, false);
-    if (url.empty())
+    hr = PrepareCurlDownload(curl.get(), conn, pluginPath, file, options, progressCtx);
+    if (FAILED(hr))
     {
-        return E_INVALIDARG;
+        return hr;
     }
 
-    curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 1L);
-    curl_easy_setopt(curl.get(), CURLOPT_READFUNCTION, CurlReadFromFile);
-    curl_easy_setopt(curl.get(), CURLOPT_READDATA, file);
-    curl_easy_setopt(curl.get(),
-                     CURLOPT_INFILESIZE_LARGE,
-                     static_cast<curl_off_t>(std::min<uint64_t>(sizeBytes, static_cast<uint64_t>((std::numeric_limits<curl_off_t>::max)()))));
-    curl_easy_setopt(curl.get(), CURLOPT_FAILONERROR, 1L);
+    return HResultFromTransfer(CurlPerform(conn, curl.get(), progressCtx), progressCtx);
+}
 
-    if (progressCtx)
+[[nodiscard]] HRESULT CurlUploadFromFile(const ConnectionInfo& conn,
+                                         std::wstring_view pluginPath,
+                                         HANDLE file,
+                                         uint64_t sizeBytes,
+                                         const FileSystemOptions* options,
+                                         TransferProgressContext* progressCtx) noexcept
+{
+    HRESULT hr = EnsureCurlInitialized();
+    if (FAILED(hr))
     {
-        progressCtx->Begin();
-        curl_easy_setopt(curl.get(), CURLOPT_XFERINFOFUNCTION, CurlXferInfo);
-        curl_easy_setopt(curl.get(), CURLOPT_XFERINFODATA, progressCtx);
-        curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 0L);
-        ApplyCommonCurlOptions(curl.get(), conn, nullptr, true);
+        return hr;
     }
-    else
+
+    unique_curl_easy curl{curl_easy_init()};
+    if (! curl)
     {
-        curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 1L);
-        ApplyCommonCurlOptions(curl.get(), conn, options, true);
+        return E_OUTOFMEMORY;
     }
 
-    const CURLcode code = curl_easy_perform(curl.get());
-    if (code == CURLE_ABORTED_BY_CALLBACK && progressCtx && FAILED(progressCtx->abortHr))
+    hr = PrepareCurlUpload(curl.get(), conn, pluginPath, file, sizeBytes, options, progressCtx);
+    if (FAILED(hr))
     {
-        return progressCtx->abortHr;
+        return hr;
     }
 
-    return HResultFromCurl(code);
+    hr = HResultFromTransfer(CurlPerform(conn, curl.get(), progressCtx), progressCtx);
+    InvalidateCachedParentListing(conn, pluginPath);
+    return hr;
 }
 } // namespace FileSystemCurlInternal
 
@@ -2554,6 +2517,13 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::QueryInterface(REFIID riid, void** ppv
         return S_OK;
     }
 
+    if (riid == __uuidof(IFileSystemDirectoryWatch) && _protocol != FileSystemCurlProtocol::Imap)
+    {
+        *ppvObject = static_cast<IFileSystemDirectoryWatch*>(this);
+        AddRef();
+        return S_OK;
+    }
+
     if (riid == __uuidof(IInformations))
     {
         *ppvObject = static_cast<IInformations*>(this);
@@ -2713,6 +2683,67 @@ HRESULT STDMETHODCALLTYPE FileSystemCurl::SetConfiguration(const char* configura
         _settings.ftpUseEpsv = ftpUseEpsv.value();
     }
 
+    const auto multiTransferEngine = TryGetJsonBool(root, "multiTransferEngine");
+    if (multiTransferEngine.has_value())
+    {
+        _settings.multiTransferEngine = multiTransferEngine.value();
+    }
+
+    const auto maxConnectionsPerHost = TryGetJsonUInt(root, "maxConnectionsPerHost");
+    if (maxConnectionsPerHost.has_value())
+    {
+        _settings.maxConnectionsPerHost = static_cast<unsigned int>(std::clamp<uint64_t>(maxConnectionsPerHost.value(), 1u, kMaxConnectionsPerHostLimit));
+    }
+
+    const auto sftpRequestWindow = TryGetJsonUInt(root, "sftpRequestWindow");
+    if (sftpRequestWindow.has_value())
+    {
+        _settings.sftpRequestWindow = static_cast<unsigned int>(std::clamp<uint64_t>(sftpRequestWindow.value(), 1u, kMaxSftpRequestWindow));
+    }
+
+    const auto sftpAdaptiveWindow = TryGetJsonBool(root, "sftpAdaptiveWindow");
+    if (sftpAdaptiveWindow.has_value())
+    {
+        _settings.sftpAdaptiveWindow = sftpAdaptiveWindow.value();
+    }
+
+    const auto persistentListingCache = TryGetJsonBool(root, "persistentListingCache");
+    if (persistentListingCache.has_value())
+    {
+        _settings.persistentListingCache = persistentListingCache.value();
+    }
+
+    const auto listingCacheTtlSeconds = TryGetJsonUInt(root, "listingCacheTtlSeconds");
+    if (listingCacheTtlSeconds.has_value())
+    {
+        _settings.listingCacheTtlSeconds = static_cast<unsigned long>(std::clamp<uint64_t>(listingCacheTtlSeconds.value(), 1u, kMaxListingCacheTtlSeconds));
+    }
+
+    const auto serverSideCopy = TryGetJsonBool(root, "serverSideCopy");
+    if (serverSideCopy.has_value())
+    {
+        _settings.serverSideCopy = serverSideCopy.value();
+    }
+
+    const auto resumableTransfers = TryGetJsonBool(root, "resumableTransfers");
+    if (resumableTransfers.has_value())
+    {
+        _settings.resumableTransfers = resumableTransfers.value();
+    }
+
+    const auto imapMessageCache = TryGetJsonBool(root, "imapMessageCache");
+    if (imapMessageCache.has_value())
+    {
+        _settings.imapMessageCache = imapMessageCache.value();
+    }
+
+    const auto imapMessageCacheMaxMB = TryGetJsonUInt(root, "imapMessageCacheMaxMB");
+    if (imapMessageCacheMaxMB.has_value())
+    {
+        _settings.imapMessageCacheMaxMB =
+            static_cast<unsigned long>(std::clamp<uint64_t>(imapMessageCacheMaxMB.value(), kMinImapMessageCacheMB, kMaxImapMessageCacheMB));
+    }
+
     const auto sshPrivateKey = TryGetJsonString(root, "sshPrivateKey");
     if (sshPrivateKey.has_value())
     {
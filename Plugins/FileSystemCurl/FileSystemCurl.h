@@ -5,13 +5,16 @@
 #include <windows.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_set>
 #include <vector>
 
 #pragma warning(push)
@@ -20,6 +23,7 @@
 #include <wil/resource.h>
 #pragma warning(pop)
 
+#include "CompactFilesListing.h"
 #include "PlugInterfaces/DriveInfo.h"
 #include "PlugInterfaces/FileSystem.h"
 #include "PlugInterfaces/Informations.h"
@@ -36,7 +40,7 @@ enum class FileSystemCurlProtocol
     Imap,
 };
 
-class FilesInformationCurl final : public IFilesInformation
+class FilesInformationCurl final : public CompactFilesInformationBase
 {
 public:
     struct Entry
@@ -51,41 +55,14 @@ public:
         __int64 changeTime       = 0;
     };
 
-    FilesInformationCurl()  = default;
-    ~FilesInformationCurl() = default;
-
-    FilesInformationCurl(const FilesInformationCurl&)            = delete;
-    FilesInformationCurl(FilesInformationCurl&&)                 = delete;
-    FilesInformationCurl& operator=(const FilesInformationCurl&) = delete;
-    FilesInformationCurl& operator=(FilesInformationCurl&&)      = delete;
-
-    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) noexcept override;
-    ULONG STDMETHODCALLTYPE AddRef() noexcept override;
-    ULONG STDMETHODCALLTYPE Release() noexcept override;
-
-    HRESULT STDMETHODCALLTYPE GetBuffer(FileInfo** ppFileInfo) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetBufferSize(unsigned long* pSize) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetAllocatedSize(unsigned long* pSize) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetCount(unsigned long* pCount) noexcept override;
-    HRESULT STDMETHODCALLTYPE Get(unsigned long index, FileInfo** ppEntry) noexcept override;
-
+    // Sorts by name (directories first among equal names) and replaces the listing.
     HRESULT BuildFromEntries(std::vector<Entry> entries) noexcept;
-
-private:
-    static size_t AlignUp(size_t value, size_t alignment) noexcept;
-    static size_t ComputeEntrySizeBytes(std::wstring_view name) noexcept;
-
-    HRESULT LocateEntry(unsigned long index, FileInfo** ppEntry) const noexcept;
-
-    std::atomic_ulong _refCount{1};
-    std::vector<std::byte> _buffer;
-    unsigned long _count     = 0;
-    unsigned long _usedBytes = 0;
 };
 
 class FileSystemCurl final : public IFileSystem,
                              public IFileSystemIO,
                              public IFileSystemDirectoryOperations,
+                             public IFileSystemDirectoryWatch,
                              public IInformations,
                              public INavigationMenu,
                              public IDriveInfo
@@ -197,6 +174,11 @@ public:
                                                void* cookie,
                                                FileSystemDirectorySizeResult* result) noexcept override;
 
+    // IFileSystemDirectoryWatch
+    // Only listing cache revalidations report changes (as overflow notifications); other remote changes are not observed.
+    HRESULT STDMETHODCALLTYPE WatchDirectory(const wchar_t* path, IFileSystemDirectoryWatchCallback* callback, void* cookie) noexcept override;
+    HRESULT STDMETHODCALLTYPE UnwatchDirectory(const wchar_t* path) noexcept override;
+
 private:
     ~FileSystemCurl() = default;
 
@@ -374,6 +356,52 @@ private:
       "default": 0,
       "min": 0,
       "max": 3600000
+    },
+    {
+      "key": "maxConnectionsPerHost",
+      "label": "Max connections per host",
+      "type": "value",
+      "default": 4,
+      "min": 1,
+      "max": 32,
+      "description": "Upper bound on simultaneous transfers and listings per server endpoint (host, port and user)."
+    },
+    {
+      "key": "multiTransferEngine",
+      "label": "Multiplexed transfer engine",
+      "type": "bool",
+      "default": true,
+      "description": "Drives transfers and listings from a few shared curl_multi threads and pipelines multi-file copies (disable to use one blocking worker per transfer)."
+    },
+    {
+      "key": "persistentListingCache",
+      "label": "Persistent listing cache",
+      "type": "bool",
+      "default": false,
+      "description": "Keeps directory listings on disk, shows them at once on revisit and refreshes the panel if a background check finds changes."
+    },
+    {
+      "key": "listingCacheTtlSeconds",
+      "label": "Listing cache TTL (seconds)",
+      "type": "value",
+      "default": 86400,
+      "min": 1,
+      "max": 31536000,
+      "description": "How long a cached listing may be shown after the server last confirmed it; older listings are fetched again."
+    },
+    {
+      "key": "serverSideCopy",
+      "label": "Server-side copy",
+      "type": "bool",
+      "default": true,
+      "description": "Copies remote files on the server when it can (SSH cp, FTP SITE CPFR/CPTO or FXP) instead of relaying them through this PC."
+    },
+    {
+      "key": "resumableTransfers",
+      "label": "Resumable transfers",
+      "type": "bool",
+      "default": true,
+      "description": "Continues interrupted uploads and downloads where they stopped (also after a retry or restart) instead of sending the file again."
     },
      {
        "key": "ftpUseEpsv",
@@ -443,6 +471,68 @@ private:
       "min": 0,
       "max": 3600000
     },
+    {
+      "key": "maxConnectionsPerHost",
+      "label": "Max connections per host",
+      "type": "value",
+      "default": 4,
+      "min": 1,
+      "max": 32,
+      "description": "Upper bound on simultaneous transfers and listings per server endpoint (host, port and user)."
+    },
+    {
+      "key": "multiTransferEngine",
+      "label": "Multiplexed transfer engine",
+      "type": "bool",
+      "default": true,
+      "description": "Drives transfers and listings from a few shared curl_multi threads and pipelines multi-file copies (disable to use one blocking worker per transfer)."
+    },
+    {
+      "key": "persistentListingCache",
+      "label": "Persistent listing cache",
+      "type": "bool",
+      "default": false,
+      "description": "Keeps directory listings on disk, shows them at once on revisit and refreshes the panel if a background check finds changes."
+    },
+    {
+      "key": "listingCacheTtlSeconds",
+      "label": "Listing cache TTL (seconds)",
+      "type": "value",
+      "default": 86400,
+      "min": 1,
+      "max": 31536000,
+      "description": "How long a cached listing may be shown after the server last confirmed it; older listings are fetched again."
+    },
+    {
+      "key": "serverSideCopy",
+      "label": "Server-side copy",
+      "type": "bool",
+      "default": true,
+      "description": "Copies remote files on the server when it can (SSH cp, FTP SITE CPFR/CPTO or FXP) instead of relaying them through this PC."
+    },
+    {
+      "key": "resumableTransfers",
+      "label": "Resumable transfers",
+      "type": "bool",
+      "default": true,
+      "description": "Continues interrupted uploads and downloads where they stopped (also after a retry or restart) instead of sending the file again."
+    },
+    {
+      "key": "sftpRequestWindow",
+      "label": "SFTP request window",
+      "type": "value",
+      "default": 64,
+      "min": 1,
+      "max": 256,
+      "description": "Outstanding SFTP read/write requests (about 30 KB each) kept in flight per file; raise for high-latency links."
+    },
+    {
+      "key": "sftpAdaptiveWindow",
+      "label": "Adaptive SFTP request window",
+      "type": "bool",
+      "default": true,
+      "description": "Grows the request window per server while transfers are limited by round-trip time instead of bandwidth."
+    },
     {
       "key": "sshPrivateKey",
       "label": "SSH private key file",
@@ -532,6 +622,45 @@ private:
       "min": 0,
       "max": 3600000
     },
+    {
+      "key": "maxConnectionsPerHost",
+      "label": "Max connections per host",
+      "type": "value",
+      "default": 4,
+      "min": 1,
+      "max": 32,
+      "description": "Upper bound on simultaneous transfers and listings per server endpoint (host, port and user)."
+    },
+    {
+      "key": "multiTransferEngine",
+      "label": "Multiplexed transfer engine",
+      "type": "bool",
+      "default": true,
+      "description": "Drives transfers and listings from a few shared curl_multi threads and pipelines multi-file copies (disable to use one blocking worker per transfer)."
+    },
+    {
+      "key": "persistentListingCache",
+      "label": "Persistent listing cache",
+      "type": "bool",
+      "default": false,
+      "description": "Keeps directory listings on disk, shows them at once on revisit and refreshes the panel if a background check finds changes."
+    },
+    {
+      "key": "listingCacheTtlSeconds",
+      "label": "Listing cache TTL (seconds)",
+      "type": "value",
+      "default": 86400,
+      "min": 1,
+      "max": 31536000,
+      "description": "How long a cached listing may be shown after the server last confirmed it; older listings are fetched again."
+    },
+    {
+      "key": "serverSideCopy",
+      "label": "Server-side copy",
+      "type": "bool",
+      "default": true,
+      "description": "Copies remote files on the server when it can (SSH cp, FTP SITE CPFR/CPTO or FXP) instead of relaying them through this PC."
+    },
     {
       "key": "sshPrivateKey",
       "label": "SSH private key file",
@@ -627,12 +756,43 @@ private:
       "default": 0,
       "min": 0,
       "max": 3600000
+    },
+    {
+      "key": "maxConnectionsPerHost",
+      "label": "Max connections per host",
+      "type": "value",
+      "default": 4,
+      "min": 1,
+      "max": 32,
+      "description": "Upper bound on simultaneous IMAP connections per server account; batched message downloads spread over them."
+    },
+    {
+      "key": "imapMessageCache",
+      "label": "Message cache",
+      "type": "bool",
+      "default": true,
+      "description": "Keeps downloaded messages on this PC (keyed by mailbox UIDVALIDITY and UID) so opening or copying them again needs no download."
+    },
+    {
+      "key": "imapMessageCacheMaxMB",
+      "label": "Message cache size (MB)",
+      "type": "value",
+      "default": 1024,
+      "min": 16,
+      "max": 65536,
+      "description": "Least recently used messages are removed once the cache grows past this size."
     }
   ]
 }
 )json";
 
 public:
+    static constexpr unsigned int kMaxConnectionsPerHostLimit = 32u;
+    static constexpr unsigned int kMaxSftpRequestWindow       = 256u;
+    static constexpr unsigned long kMaxListingCacheTtlSeconds = 365ul * 24ul * 60ul * 60ul;
+    static constexpr unsigned long kMinImapMessageCacheMB     = 16ul;
+    static constexpr unsigned long kMaxImapMessageCacheMB     = 64ul * 1024ul;
+
     struct Settings
     {
         std::wstring defaultHost;
@@ -647,6 +807,22 @@ public:
         bool ignoreSslTrust = false;
         bool ftpUseEpsv     = true;
 
+        bool multiTransferEngine           = true;
+        unsigned int maxConnectionsPerHost = 4;
+
+        unsigned int sftpRequestWindow = 64;
+        bool sftpAdaptiveWindow        = true;
+
+        bool persistentListingCache          = false;
+        unsigned long listingCacheTtlSeconds = 86400;
+
+        bool serverSideCopy = true;
+
+        bool resumableTransfers = true;
+
+        bool imapMessageCache               = true;
+        unsigned long imapMessageCacheMaxMB = 1024;
+
         std::wstring sshPrivateKey;
         std::wstring sshPublicKey;
         std::wstring sshKeyPassphrase;
@@ -663,6 +839,28 @@ private:
         unsigned int commandId = 0;
     };
 
+    struct DirectoryWatchRegistration
+    {
+        DirectoryWatchRegistration() = default;
+
+        DirectoryWatchRegistration(const DirectoryWatchRegistration&)            = delete;
+        DirectoryWatchRegistration& operator=(const DirectoryWatchRegistration&) = delete;
+        DirectoryWatchRegistration(DirectoryWatchRegistration&&)                 = delete;
+        DirectoryWatchRegistration& operator=(DirectoryWatchRegistration&&)      = delete;
+
+        std::wstring watchedPath;
+        std::wstring matchPath;
+        IFileSystemDirectoryWatchCallback* callback = nullptr;
+        void* cookie                                = nullptr;
+        std::atomic_uint32_t inFlight{0};
+        std::atomic_bool active{true};
+    };
+
+    // Persistent listing cache (FileSystemCurl.ListingCache.cpp).
+    void QueueListingRevalidation(std::wstring_view path) noexcept;
+    void RevalidateListing(const std::wstring& path) noexcept;
+    void NotifyListingChanged(std::wstring_view path) noexcept;
+
     std::atomic_ulong _refCount{1};
 
     std::mutex _stateMutex;
@@ -687,4 +885,10 @@ private:
 
     std::mutex _propertiesMutex;
     std::string _lastPropertiesJson;
+
+    // DirectoryWatch state.
+    std::mutex _watchMutex;
+    std::condition_variable _watchCv;
+    std::vector<std::shared_ptr<DirectoryWatchRegistration>> _directoryWatches;
+    std::unordered_set<std::wstring> _pendingRevalidations;
 };
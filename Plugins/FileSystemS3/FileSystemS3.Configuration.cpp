@@ -78,6 +78,11 @@ HRESULT STDMETHODCALLTYPE FileSystemS3::SetConfiguration(const char* configurati
         }
     }
 
+    if (const auto v = FsS3::TryGetJsonBool(root, "resumableUploads"); v.has_value())
+    {
+        _settings.resumableUploads = v.value();
+    }
+
     return S_OK;
 }
 
@@ -1047,6 +1047,7 @@ HRESULT STDMETHODCALLTYPE FileSystemS3::GetItemProperties([[maybe_unused]] const
     addField(connection, "useVirtualAddressing", ctx.useVirtualAddressing ? "true" : "false");
     addField(connection, "maxKeys", std::format("{}", ctx.maxKeys));
     addField(connection, "maxTableResults", std::format("{}", ctx.maxTableResults));
+    addField(connection, "resumableUploads", ctx.resumableUploads ? "true" : "false");
     addField(connection, "hasExplicitRegion", ctx.explicitRegion.has_value() ? "true" : "false");
     addField(connection, "hasAccessKeyId", ctx.accessKeyId.has_value() ? "true" : "false");
     addField(connection, "hasSecretAccessKey", ctx.secretAccessKey.has_value() ? "true" : "false");
@@ -56,6 +56,7 @@ struct ResolvedAwsContext
     bool useVirtualAddressing     = true;
     unsigned long maxKeys         = 1000;
     unsigned long maxTableResults = 1000;
+    bool resumableUploads         = true;
 
     std::optional<std::string> accessKeyId;
     std::optional<std::string> secretAccessKey;
@@ -230,6 +231,13 @@ DownloadS3ObjectToTempFile(const ResolvedAwsContext& ctx, std::string_view bucke
 [[nodiscard]] HRESULT
 UploadS3ObjectFromFile(const ResolvedAwsContext& ctx, std::string_view bucket, std::string_view key, HANDLE file, uint64_t sizeBytes) noexcept;
 
+// Resumable multipart uploads (FileSystemS3.Multipart.cpp). The upload id and source fingerprint are checkpointed under
+// %LOCALAPPDATA%\RedSalamander\Cache\FileSystemS3\Resume; a later upload of the same source to the same key lists the
+// parts S3 already holds and sends only the parts whose size or MD5 differ.
+[[nodiscard]] bool ShouldUseMultipartUpload(const ResolvedAwsContext& ctx, uint64_t sizeBytes) noexcept;
+[[nodiscard]] HRESULT
+UploadS3ObjectMultipart(const ResolvedAwsContext& ctx, std::string_view bucket, std::string_view key, HANDLE file, uint64_t sizeBytes) noexcept;
+
 [[nodiscard]] HRESULT
 ListS3TableNamespaces(FileSystemS3& fs, const ResolvedAwsContext& ctx, std::wstring_view bucketName, std::vector<FilesInformationS3::Entry>& out) noexcept;
 
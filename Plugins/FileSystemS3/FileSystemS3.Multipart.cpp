@@ -0,0 +1,675 @@
+#include "FileSystemS3.Internal.h"
+
+#include <ShlObj.h>
+
+#include <atomic>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+
+#include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/s3-crt/model/AbortMultipartUploadRequest.h>
+#include <aws/s3-crt/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3-crt/model/CompletedMultipartUpload.h>
+#include <aws/s3-crt/model/CompletedPart.h>
+#include <aws/s3-crt/model/CreateMultipartUploadRequest.h>
+#include <aws/s3-crt/model/ListPartsRequest.h>
+#include <aws/s3-crt/model/UploadPartRequest.h>
+
+namespace FileSystemS3Internal
+{
+namespace
+{
+constexpr wchar_t kCompanyDirName[]          = L"RedSalamander";
+constexpr wchar_t kCacheDirName[]            = L"Cache";
+constexpr wchar_t kPluginCacheDirName[]      = L"FileSystemS3";
+constexpr wchar_t kResumeDirName[]           = L"Resume";
+constexpr wchar_t kCheckpointFileExtension[] = L".rck";
+
+constexpr uint32_t kCheckpointMagic   = 0x55335352u; // "RS3U"
+constexpr uint32_t kCheckpointVersion = 1u;
+
+constexpr uint32_t kMaxCheckpointKeyBytes      = 64u * 1024u;
+constexpr uint32_t kMaxCheckpointUploadIdBytes = 4u * 1024u;
+
+// S3 allows at most 10000 parts per upload; parts other than the last must be at least 5 MiB.
+constexpr uint64_t kMinPartBytes    = 16ull * 1024ull * 1024ull;
+constexpr uint64_t kPartBytesAlign  = 1024ull * 1024ull;
+constexpr uint64_t kMaxPartCount    = 10000ull;
+constexpr uint64_t kHeadHashBytes   = 64ull * 1024ull;
+constexpr uint64_t kReadChunkBytes  = 8ull * 1024ull * 1024ull;
+constexpr int kMaxPartAttempts      = 3;
+constexpr DWORD kPartRetryBackoffMs = 500;
+constexpr int64_t kCheckpointMaxAge = 7ll * 24ll * 60ll * 60ll * 10'000'000ll; // FILETIME ticks
+constexpr uint64_t kFnvOffsetBasis  = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime        = 1099511628211ull;
+
+// Parts in flight at once; each holds its part in memory, so huge files (larger parts) get fewer workers.
+constexpr uint64_t kMaxConcurrentParts = 4ull;
+constexpr uint64_t kMaxPartBufferBytes = 256ull * 1024ull * 1024ull;
+
+#pragma pack(push, 1)
+struct CheckpointFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int64_t savedAt; // FILETIME ticks
+    uint64_t sourceSize;
+    uint64_t partBytes;
+    uint64_t headHash; // FNV-1a of the first kHeadHashBytes of the source
+    uint32_t keyBytes;
+    uint32_t uploadIdBytes;
+};
+#pragma pack(pop)
+
+struct UploadCheckpoint
+{
+    int64_t savedAt     = 0;
+    uint64_t sourceSize = 0;
+    uint64_t partBytes  = 0;
+    uint64_t headHash   = 0;
+    std::string uploadId;
+};
+
+// Serializes checkpoint file updates; concurrent uploads to the same key would otherwise race on the rename.
+std::mutex g_checkpointMutex;
+
+[[nodiscard]] int64_t CurrentFileTimeTicks() noexcept
+{
+    FILETIME now{};
+    GetSystemTimeAsFileTime(&now);
+    ULARGE_INTEGER value{};
+    value.LowPart  = now.dwLowDateTime;
+    value.HighPart = now.dwHighDateTime;
+    return static_cast<int64_t>(value.QuadPart);
+}
+
+[[nodiscard]] const std::filesystem::path& GetResumeDirectory() noexcept
+{
+    static const std::filesystem::path directory = []() noexcept -> std::filesystem::path
+    {
+        wil::unique_cotaskmem_string localAppData;
+        const HRESULT hr = SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, localAppData.put());
+        if (FAILED(hr) || ! localAppData)
+        {
+            return {};
+        }
+
+        std::filesystem::path result = std::filesystem::path(localAppData.get()) / kCompanyDirName / kCacheDirName / kPluginCacheDirName / kResumeDirName;
+
+        std::error_code ec;
+        std::filesystem::create_directories(result, ec);
+        if (ec)
+        {
+            Debug::Warning(L"S3: failed to create upload checkpoint folder '{}' ({})", result.native(), Utf16FromUtf8(ec.message()));
+            return {};
+        }
+        return result;
+    }();
+    return directory;
+}
+
+[[nodiscard]] uint64_t HashBytes(uint64_t hash, const void* data, size_t size) noexcept
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+[[nodiscard]] std::string BuildCheckpointKey(const ResolvedAwsContext& ctx, std::string_view bucket, std::string_view key)
+{
+    return std::format("{}|{}|{}|{}|{}", Utf8FromUtf16(ctx.connectionName), ctx.endpointOverride, ctx.region, bucket, key);
+}
+
+[[nodiscard]] std::filesystem::path GetCheckpointPath(std::string_view checkpointKey) noexcept
+{
+    const std::filesystem::path& directory = GetResumeDirectory();
+    if (directory.empty())
+    {
+        return {};
+    }
+    return directory / std::format(L"{:016x}{}", HashBytes(kFnvOffsetBasis, checkpointKey.data(), checkpointKey.size()), kCheckpointFileExtension);
+}
+
+[[nodiscard]] bool ReadExact(HANDLE file, void* out, DWORD size) noexcept
+{
+    DWORD read = 0;
+    return ReadFile(file, out, size, &read, nullptr) != 0 && read == size;
+}
+
+[[nodiscard]] bool WriteExact(HANDLE file, const void* data, DWORD size) noexcept
+{
+    DWORD written = 0;
+    return WriteFile(file, data, size, &written, nullptr) != 0 && written == size;
+}
+
+[[nodiscard]] bool LoadCheckpoint(std::string_view checkpointKey, UploadCheckpoint& out) noexcept
+{
+    const std::filesystem::path filePath = GetCheckpointPath(checkpointKey);
+    if (filePath.empty())
+    {
+        return false;
+    }
+
+    std::lock_guard lock(g_checkpointMutex);
+    wil::unique_hfile file(CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+    if (! file)
+    {
+        return false;
+    }
+
+    CheckpointFileHeader header{};
+    if (! ReadExact(file.get(), &header, sizeof(header)) || header.magic != kCheckpointMagic || header.version != kCheckpointVersion ||
+        header.keyBytes != checkpointKey.size() || header.keyBytes > kMaxCheckpointKeyBytes || header.uploadIdBytes == 0 ||
+        header.uploadIdBytes > kMaxCheckpointUploadIdBytes)
+    {
+        return false;
+    }
+
+    std::string storedKey(header.keyBytes, '\0');
+    std::string uploadId(header.uploadIdBytes, '\0');
+    if (! ReadExact(file.get(), storedKey.data(), header.keyBytes) || storedKey != checkpointKey ||
+        ! ReadExact(file.get(), uploadId.data(), header.uploadIdBytes))
+    {
+        return false;
+    }
+
+    out.savedAt    = header.savedAt;
+    out.sourceSize = header.sourceSize;
+    out.partBytes  = header.partBytes;
+    out.headHash   = header.headHash;
+    out.uploadId   = std::move(uploadId);
+    return true;
+}
+
+void StoreCheckpoint(std::string_view checkpointKey, const UploadCheckpoint& checkpoint) noexcept
+{
+    const std::filesystem::path filePath = GetCheckpointPath(checkpointKey);
+    if (filePath.empty() || checkpointKey.size() > kMaxCheckpointKeyBytes || checkpoint.uploadId.size() > kMaxCheckpointUploadIdBytes)
+    {
+        return;
+    }
+
+    CheckpointFileHeader header{};
+    header.magic         = kCheckpointMagic;
+    header.version       = kCheckpointVersion;
+    header.savedAt       = checkpoint.savedAt;
+    header.sourceSize    = checkpoint.sourceSize;
+    header.partBytes     = checkpoint.partBytes;
+    header.headHash      = checkpoint.headHash;
+    header.keyBytes      = static_cast<uint32_t>(checkpointKey.size());
+    header.uploadIdBytes = static_cast<uint32_t>(checkpoint.uploadId.size());
+
+    std::filesystem::path tempPath = filePath;
+    tempPath += L".tmp";
+
+    std::lock_guard lock(g_checkpointMutex);
+    {
+        wil::unique_hfile file(CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (! file)
+        {
+            Debug::Warning(L"S3: failed to write upload checkpoint '{}' (error {})", tempPath.native(), GetLastError());
+            return;
+        }
+
+        if (! WriteExact(file.get(), &header, sizeof(header)) || ! WriteExact(file.get(), checkpointKey.data(), header.keyBytes) ||
+            ! WriteExact(file.get(), checkpoint.uploadId.data(), header.uploadIdBytes))
+        {
+            Debug::Warning(L"S3: failed to write upload checkpoint '{}' (error {})", tempPath.native(), GetLastError());
+            file.reset();
+            DeleteFileW(tempPath.c_str());
+            return;
+        }
+    }
+
+    if (MoveFileExW(tempPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING) == 0)
+    {
+        Debug::Warning(L"S3: failed to replace upload checkpoint '{}' (error {})", filePath.native(), GetLastError());
+        DeleteFileW(tempPath.c_str());
+    }
+}
+
+void DeleteCheckpoint(std::string_view checkpointKey) noexcept
+{
+    const std::filesystem::path filePath = GetCheckpointPath(checkpointKey);
+    if (filePath.empty())
+    {
+        return;
+    }
+
+    std::lock_guard lock(g_checkpointMutex);
+    DeleteFileW(filePath.c_str());
+}
+
+// Upload body over a part already read into memory. The SDK rewinds bodies for hashing and retries; seeking a
+// preallocated buffer costs nothing, where a file-backed body would read the range from disk again.
+class PartBodyIStream final : public Aws::IOStream
+{
+public:
+    PartBodyIStream(unsigned char* data, uint64_t length) noexcept : Aws::IOStream(nullptr), _buf(data, length)
+    {
+        rdbuf(&_buf);
+    }
+
+    PartBodyIStream(const PartBodyIStream&)            = delete;
+    PartBodyIStream(PartBodyIStream&&)                 = delete;
+    PartBodyIStream& operator=(const PartBodyIStream&) = delete;
+    PartBodyIStream& operator=(PartBodyIStream&&)      = delete;
+
+private:
+    Aws::Utils::Stream::PreallocatedStreamBuf _buf;
+};
+
+[[nodiscard]] HRESULT HashSourceHead(HANDLE file, uint64_t sizeBytes, uint64_t& outHash) noexcept
+{
+    std::array<char, kHeadHashBytes> buffer{};
+    const DWORD toRead = static_cast<DWORD>(std::min<uint64_t>(sizeBytes, buffer.size()));
+
+    OVERLAPPED overlapped{};
+    DWORD read = 0;
+    if (ReadFile(file, buffer.data(), toRead, &read, &overlapped) == 0)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    if (read != toRead)
+    {
+        return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+    }
+
+    outHash = HashBytes(kFnvOffsetBasis, buffer.data(), read);
+    return S_OK;
+}
+
+// Reads [start, start + length) with positional reads, so the part workers can share the caller's handle.
+[[nodiscard]] HRESULT ReadPart(HANDLE file, uint64_t start, uint64_t length, unsigned char* out) noexcept
+{
+    uint64_t done = 0;
+    while (done < length)
+    {
+        const uint64_t offset = start + done;
+        const DWORD toRead    = static_cast<DWORD>(std::min<uint64_t>(length - done, kReadChunkBytes));
+
+        OVERLAPPED overlapped{};
+        overlapped.Offset     = static_cast<DWORD>(offset & 0xFFFFFFFFu);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD read = 0;
+        if (ReadFile(file, out + done, toRead, &read, &overlapped) == 0)
+        {
+            const DWORD lastError = GetLastError();
+            return HRESULT_FROM_WIN32(lastError != 0 ? lastError : ERROR_READ_FAULT);
+        }
+        if (read == 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        }
+        done += read;
+    }
+    return S_OK;
+}
+
+[[nodiscard]] std::string_view TrimETagQuotes(std::string_view etag) noexcept
+{
+    if (etag.size() >= 2 && etag.front() == '"' && etag.back() == '"')
+    {
+        return etag.substr(1, etag.size() - 2);
+    }
+    return etag;
+}
+
+[[nodiscard]] bool ETagMatchesMd5(const Aws::String& etag, const Aws::Utils::ByteBuffer& md5) noexcept
+{
+    const Aws::String hex         = Aws::Utils::HashingUtils::HexEncode(md5);
+    const std::string_view stored = TrimETagQuotes(std::string_view(etag.data(), etag.size()));
+    if (stored.size() != hex.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < stored.size(); ++i)
+    {
+        const char ch = (stored[i] >= 'A' && stored[i] <= 'F') ? static_cast<char>(stored[i] - 'A' + 'a') : stored[i];
+        if (ch != hex[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+[[nodiscard]] uint64_t ChoosePartBytes(uint64_t sizeBytes) noexcept
+{
+    const uint64_t minimumForCount = (sizeBytes + kMaxPartCount - 1u) / kMaxPartCount;
+    const uint64_t partBytes       = std::max(kMinPartBytes, minimumForCount);
+    return (partBytes + kPartBytesAlign - 1u) / kPartBytesAlign * kPartBytesAlign;
+}
+
+void AbortUpload(Aws::S3Crt::S3CrtClient& client,
+                 const ResolvedAwsContext& ctx,
+                 std::string_view bucket,
+                 std::string_view key,
+                 const std::string& uploadId) noexcept
+{
+    Aws::S3Crt::Model::AbortMultipartUploadRequest req;
+    req.SetBucket(Aws::String(bucket.data(), bucket.size()));
+    req.SetKey(Aws::String(key.data(), key.size()));
+    req.SetUploadId(Aws::String(uploadId.data(), uploadId.size()));
+
+    const auto outcome = client.AbortMultipartUpload(req);
+    if (! outcome.IsSuccess() && HresultFromAwsError(outcome.GetError()) != HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+    {
+        const std::wstring details = std::format(L"bucket='{}' key='{}'", Utf16FromUtf8(bucket), Utf16FromUtf8(key));
+        LogAwsFailure(L"S3", L"AbortMultipartUpload", ctx, outcome.GetError(), details);
+    }
+}
+
+// Collects the parts S3 already holds for an upload. Returns ERROR_FILE_NOT_FOUND when the upload no longer exists
+// (completed, aborted, or expired by a bucket lifecycle rule).
+[[nodiscard]] HRESULT ListUploadedParts(Aws::S3Crt::S3CrtClient& client,
+                                        const ResolvedAwsContext& ctx,
+                                        std::string_view bucket,
+                                        std::string_view key,
+                                        const std::string& uploadId,
+                                        std::unordered_map<int, Aws::S3Crt::Model::Part>& out) noexcept
+{
+    out.clear();
+
+    int marker = 0;
+    for (;;)
+    {
+        Aws::S3Crt::Model::ListPartsRequest req;
+        req.SetBucket(Aws::String(bucket.data(), bucket.size()));
+        req.SetKey(Aws::String(key.data(), key.size()));
+        req.SetUploadId(Aws::String(uploadId.data(), uploadId.size()));
+        if (marker > 0)
+        {
+            req.SetPartNumberMarker(marker);
+        }
+
+        auto outcome = client.ListParts(req);
+        if (! outcome.IsSuccess())
+        {
+            const HRESULT hr = HresultFromAwsError(outcome.GetError());
+            if (hr != HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+            {
+                const std::wstring details = std::format(L"bucket='{}' key='{}'", Utf16FromUtf8(bucket), Utf16FromUtf8(key));
+                LogAwsFailure(L"S3", L"ListParts", ctx, outcome.GetError(), details);
+            }
+            return hr;
+        }
+
+        const auto& result = outcome.GetResult();
+        for (const auto& part : result.GetParts())
+        {
+            out[part.GetPartNumber()] = part;
+        }
+
+        const int next = static_cast<int>(result.GetNextPartNumberMarker());
+        if (! result.GetIsTruncated() || next <= marker)
+        {
+            return S_OK;
+        }
+        marker = next;
+    }
+}
+
+[[nodiscard]] HRESULT UploadPart(Aws::S3Crt::S3CrtClient& client,
+                                 const ResolvedAwsContext& ctx,
+                                 std::string_view bucket,
+                                 std::string_view key,
+                                 const std::string& uploadId,
+                                 int partNumber,
+                                 unsigned char* data,
+                                 uint64_t length,
+                                 const Aws::Utils::ByteBuffer& md5,
+                                 Aws::String& outETag) noexcept
+{
+    for (int attempt = 1;; ++attempt)
+    {
+        Aws::S3Crt::Model::UploadPartRequest req;
+        req.SetBucket(Aws::String(bucket.data(), bucket.size()));
+        req.SetKey(Aws::String(key.data(), key.size()));
+        req.SetUploadId(Aws::String(uploadId.data(), uploadId.size()));
+        req.SetPartNumber(partNumber);
+        req.SetContentLength(static_cast<long long>(length));
+        req.SetContentMD5(Aws::Utils::HashingUtils::Base64Encode(md5));
+
+        req.SetBody(Aws::MakeShared<PartBodyIStream>("rs3-part", data, length));
+
+        auto outcome = client.UploadPart(req);
+        if (outcome.IsSuccess())
+        {
+            outETag = outcome.GetResult().GetETag();
+            return S_OK;
+        }
+
+        const auto& err = outcome.GetError();
+        if (attempt >= kMaxPartAttempts || ! err.ShouldRetry())
+        {
+            const std::wstring details = std::format(L"bucket='{}' key='{}' part={}", Utf16FromUtf8(bucket), Utf16FromUtf8(key), partNumber);
+            LogAwsFailure(L"S3", L"UploadPart", ctx, err, details);
+            return HresultFromAwsError(err);
+        }
+
+        Debug::Info(L"S3: retrying part {} of '{}' (attempt {})", partNumber, Utf16FromUtf8(key), attempt + 1);
+        Sleep(kPartRetryBackoffMs * static_cast<DWORD>(attempt));
+    }
+}
+} // namespace
+
+[[nodiscard]] bool ShouldUseMultipartUpload(const ResolvedAwsContext& ctx, uint64_t sizeBytes) noexcept
+{
+    return ctx.resumableUploads && sizeBytes >= 2u * kMinPartBytes;
+}
+
+[[nodiscard]] HRESULT
+UploadS3ObjectMultipart(const ResolvedAwsContext& ctx, std::string_view bucket, std::string_view key, HANDLE file, uint64_t sizeBytes) noexcept
+{
+    if (bucket.empty() || key.empty())
+    {
+        return E_INVALIDARG;
+    }
+
+    if (! file || file == INVALID_HANDLE_VALUE)
+    {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_HANDLE);
+    }
+
+    const uint64_t partBytes = ChoosePartBytes(sizeBytes);
+    const uint64_t partCount = (sizeBytes + partBytes - 1u) / partBytes;
+    if (partCount == 0 || partCount > kMaxPartCount || partBytes > static_cast<uint64_t>((std::numeric_limits<long long>::max)()))
+    {
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+    }
+
+    uint64_t headHash = 0;
+    HRESULT hr        = HashSourceHead(file, sizeBytes, headHash);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    Aws::S3Crt::S3CrtClient client  = MakeS3Client(ctx);
+    const std::string checkpointKey = BuildCheckpointKey(ctx, bucket, key);
+    const std::wstring details      = std::format(L"bucket='{}' key='{}'", Utf16FromUtf8(bucket), Utf16FromUtf8(key));
+
+    // Reuse the upload a previous attempt left behind when it was for the same source; otherwise abort it so its parts
+    // stop accruing storage.
+    UploadCheckpoint checkpoint{};
+    std::unordered_map<int, Aws::S3Crt::Model::Part> uploadedParts;
+    if (LoadCheckpoint(checkpointKey, checkpoint))
+    {
+        const bool expired = CurrentFileTimeTicks() - checkpoint.savedAt > kCheckpointMaxAge;
+        const bool matches = ! expired && checkpoint.sourceSize == sizeBytes && checkpoint.partBytes == partBytes && checkpoint.headHash == headHash;
+        if (matches)
+        {
+            hr = ListUploadedParts(client, ctx, bucket, key, checkpoint.uploadId, uploadedParts);
+            if (FAILED(hr) && hr != HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+            {
+                return hr;
+            }
+        }
+        else
+        {
+            AbortUpload(client, ctx, bucket, key, checkpoint.uploadId);
+        }
+
+        if (! matches || FAILED(hr))
+        {
+            DeleteCheckpoint(checkpointKey);
+            checkpoint.uploadId.clear();
+            uploadedParts.clear();
+        }
+    }
+
+    if (checkpoint.uploadId.empty())
+    {
+        Aws::S3Crt::Model::CreateMultipartUploadRequest req;
+        req.SetBucket(Aws::String(bucket.data(), bucket.size()));
+        req.SetKey(Aws::String(key.data(), key.size()));
+
+        auto outcome = client.CreateMultipartUpload(req);
+        if (! outcome.IsSuccess())
+        {
+            LogAwsFailure(L"S3", L"CreateMultipartUpload", ctx, outcome.GetError(), details);
+            return HresultFromAwsError(outcome.GetError());
+        }
+
+        const Aws::String& uploadId = outcome.GetResult().GetUploadId();
+        checkpoint.uploadId.assign(uploadId.data(), uploadId.size());
+        checkpoint.sourceSize = sizeBytes;
+        checkpoint.partBytes  = partBytes;
+        checkpoint.headHash   = headHash;
+    }
+
+    checkpoint.savedAt = CurrentFileTimeTicks();
+    StoreCheckpoint(checkpointKey, checkpoint);
+
+    // Workers pull part numbers from a shared counter and stop at the first failure. Each part is read once: the MD5
+    // sent as Content-MD5 (and compared with the ETag of a part a previous attempt stored) and every send attempt come
+    // from the same buffer.
+    const uint64_t workerCount = std::clamp<uint64_t>(kMaxPartBufferBytes / partBytes, 1ull, std::min(kMaxConcurrentParts, partCount));
+    std::vector<Aws::String> etags(static_cast<size_t>(partCount));
+    std::atomic<uint64_t> nextIndex{0};
+    std::atomic<uint64_t> skippedParts{0};
+    std::atomic<HRESULT> firstFailure{S_OK};
+
+    const auto uploadParts = [&]() noexcept
+    {
+        const auto fail = [&](HRESULT failure) noexcept
+        {
+            HRESULT expected = S_OK;
+            firstFailure.compare_exchange_strong(expected, failure, std::memory_order_acq_rel);
+        };
+
+        std::unique_ptr<unsigned char[]> buffer(new (std::nothrow) unsigned char[static_cast<size_t>(partBytes)]);
+        if (! buffer)
+        {
+            fail(E_OUTOFMEMORY);
+            return;
+        }
+
+        while (SUCCEEDED(firstFailure.load(std::memory_order_acquire)))
+        {
+            const uint64_t index = nextIndex.fetch_add(1u, std::memory_order_relaxed);
+            if (index >= partCount)
+            {
+                return;
+            }
+
+            const int partNumber = static_cast<int>(index + 1u);
+            const uint64_t start = index * partBytes;
+            const uint64_t len   = std::min(partBytes, sizeBytes - start);
+
+            HRESULT partHr = ReadPart(file, start, len, buffer.get());
+            if (FAILED(partHr))
+            {
+                fail(partHr);
+                return;
+            }
+
+            PartBodyIStream md5Stream(buffer.get(), len);
+            const Aws::Utils::ByteBuffer md5 = Aws::Utils::HashingUtils::CalculateMD5(md5Stream);
+
+            // A part is kept only when S3 reports the same size and the same content hash as the local range.
+            Aws::String etag;
+            if (const auto it = uploadedParts.find(partNumber);
+                it != uploadedParts.end() && static_cast<uint64_t>(it->second.GetSize()) == len && ETagMatchesMd5(it->second.GetETag(), md5))
+            {
+                etag = it->second.GetETag();
+                skippedParts.fetch_add(1u, std::memory_order_relaxed);
+            }
+            else
+            {
+                partHr = UploadPart(client, ctx, bucket, key, checkpoint.uploadId, partNumber, buffer.get(), len, md5, etag);
+                if (FAILED(partHr))
+                {
+                    fail(partHr);
+                    return;
+                }
+            }
+
+            etags[static_cast<size_t>(index)] = std::move(etag);
+        }
+    };
+
+    {
+        std::vector<std::jthread> helpers;
+        helpers.reserve(static_cast<size_t>(workerCount - 1u));
+        for (uint64_t i = 1; i < workerCount; ++i)
+        {
+            try
+            {
+                helpers.emplace_back(uploadParts);
+            }
+            catch (const std::system_error&)
+            {
+                break;
+            }
+        }
+
+        uploadParts();
+    }
+
+    hr = firstFailure.load(std::memory_order_acquire);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    Aws::S3Crt::Model::CompletedMultipartUpload completed;
+    for (uint64_t index = 0; index < partCount; ++index)
+    {
+        Aws::S3Crt::Model::CompletedPart part;
+        part.SetPartNumber(static_cast<int>(index + 1u));
+        part.SetETag(std::move(etags[static_cast<size_t>(index)]));
+        completed.AddParts(std::move(part));
+    }
+
+    if (const uint64_t skipped = skippedParts.load(std::memory_order_relaxed); skipped != 0)
+    {
+        Debug::Info(L"S3: resumed upload of '{}' with {} of {} parts already stored", Utf16FromUtf8(key), skipped, partCount);
+    }
+
+    Aws::S3Crt::Model::CompleteMultipartUploadRequest req;
+    req.SetBucket(Aws::String(bucket.data(), bucket.size()));
+    req.SetKey(Aws::String(key.data(), key.size()));
+    req.SetUploadId(Aws::String(checkpoint.uploadId.data(), checkpoint.uploadId.size()));
+    req.SetMultipartUpload(std::move(completed));
+
+    const auto outcome = client.CompleteMultipartUpload(req);
+    if (! outcome.IsSuccess())
+    {
+        LogAwsFailure(L"S3", L"CompleteMultipartUpload", ctx, outcome.GetError(), details);
+        return HresultFromAwsError(outcome.GetError());
+    }
+
+    DeleteCheckpoint(checkpointKey);
+    return S_OK;
+}
+} // namespace FileSystemS3Internal
@@ -525,6 +525,11 @@ UploadS3ObjectFromFile(const ResolvedAwsContext& ctx, std::string_view bucket, s
         return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
     }
 
+    if (ShouldUseMultipartUpload(ctx, sizeBytes))
+    {
+        return UploadS3ObjectMultipart(ctx, bucket, key, file, sizeBytes);
+    }
+
     Aws::S3Crt::S3CrtClient client = MakeS3Client(ctx);
     Aws::S3Crt::Model::PutObjectRequest req;
     req.SetBucket(Aws::String(bucket.data(), bucket.size()));
@@ -454,6 +454,7 @@ namespace
     out.useVirtualAddressing = defaults.useVirtualAddressing;
     out.maxKeys              = defaults.maxKeys;
     out.maxTableResults      = defaults.maxTableResults;
+    out.resumableUploads     = defaults.resumableUploads;
 
     // extra payload (optional; forwarded by host as `extra`)
     if (yyjson_val* extra = yyjson_obj_get(root, "extra"); extra && yyjson_is_obj(extra))
@@ -617,6 +618,7 @@ namespace
     outContext.useVirtualAddressing = defaults.useVirtualAddressing;
     outContext.maxKeys              = defaults.maxKeys;
     outContext.maxTableResults      = defaults.maxTableResults;
+    outContext.resumableUploads     = defaults.resumableUploads;
 
     // Canonicalize authority-based paths (s3://bucket/...) into "/bucket/..."
     if (! authority.empty())
@@ -22,6 +22,7 @@
 #include <wil/resource.h>
 #pragma warning(pop)
 
+#include "CompactFilesListing.h"
 #include "PlugInterfaces/DriveInfo.h"
 #include "PlugInterfaces/FileSystem.h"
 #include "PlugInterfaces/Host.h"
@@ -39,7 +40,7 @@ namespace FileSystemS3Internal
 struct ResolvedAwsContext;
 }
 
-class FilesInformationS3 final : public IFilesInformation
+class FilesInformationS3 final : public CompactFilesInformationBase
 {
 public:
     struct Entry
@@ -54,35 +55,8 @@ public:
         __int64 changeTime       = 0;
     };
 
-    FilesInformationS3()  = default;
-    ~FilesInformationS3() = default;
-
-    FilesInformationS3(const FilesInformationS3&)            = delete;
-    FilesInformationS3(FilesInformationS3&&)                 = delete;
-    FilesInformationS3& operator=(const FilesInformationS3&) = delete;
-    FilesInformationS3& operator=(FilesInformationS3&&)      = delete;
-
-    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) noexcept override;
-    ULONG STDMETHODCALLTYPE AddRef() noexcept override;
-    ULONG STDMETHODCALLTYPE Release() noexcept override;
-
-    HRESULT STDMETHODCALLTYPE GetBuffer(FileInfo** ppFileInfo) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetBufferSize(unsigned long* pSize) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetAllocatedSize(unsigned long* pSize) noexcept override;
-    HRESULT STDMETHODCALLTYPE GetCount(unsigned long* pCount) noexcept override;
-    HRESULT STDMETHODCALLTYPE Get(unsigned long index, FileInfo** ppEntry) noexcept override;
-
+    // Sorts by name (directories first among equal names) and replaces the listing.
     HRESULT BuildFromEntries(std::vector<Entry> entries) noexcept;
-
-private:
-    static size_t AlignUp(size_t value, size_t alignment) noexcept;
-    static size_t ComputeEntrySizeBytes(std::wstring_view name) noexcept;
-    HRESULT LocateEntry(unsigned long index, FileInfo** ppEntry) const noexcept;
-
-    std::atomic_ulong _refCount{1};
-    std::vector<std::byte> _buffer;
-    unsigned long _count     = 0;
-    unsigned long _usedBytes = 0;
 };
 
 class FileSystemS3 final : public IFileSystem,
@@ -208,6 +182,7 @@ public:
         bool useVirtualAddressing     = true;
         unsigned long maxKeys         = 1000;
         unsigned long maxTableResults = 1000;
+        bool resumableUploads         = true;
     };
 
 private:
@@ -304,6 +279,13 @@ private:
       "default": 1000,
       "min": 1,
       "max": 1000
+    },
+    {
+      "key": "resumableUploads",
+      "label": "Resumable uploads",
+      "type": "bool",
+      "default": true,
+      "description": "Upload large files as multipart uploads that continue from the parts already stored after a failure or restart."
     }
   ]
 }
@@ -1,8 +1,10 @@
 #include "ViewerImgRaw.h"
 
 #include "ViewerImgRaw.Internal.h"
+#include "PixelKernels.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstring>
 #include <ctime>
@@ -26,6 +28,25 @@ namespace
 {
 static const int kViewerImgRawModuleAnchor = 0;
 
+constexpr uint32_t kConvertRowsPerBand = 64u; // Rows per parallel task for full-frame conversion/downscale
+constexpr size_t kMaxPrefetchWorkers    = 2u;  // Concurrent neighbor decodes; each LibRaw decode holds several times the frame size
+
+// Bytes of decoded pixels kept for the current image and its neighbors: a quarter of physical memory, within [256 MiB, 2 GiB].
+size_t NeighborCacheBudgetBytes() noexcept
+{
+    constexpr uint64_t kMinBudget = 256ull * 1024ull * 1024ull;
+    constexpr uint64_t kMaxBudget = 2048ull * 1024ull * 1024ull;
+
+    MEMORYSTATUSEX status{};
+    status.dwLength = sizeof(status);
+    if (! GlobalMemoryStatusEx(&status))
+    {
+        return static_cast<size_t>(kMinBudget * 4ull);
+    }
+
+    return static_cast<size_t>(std::clamp<uint64_t>(status.ullTotalPhys / 4ull, kMinBudget, kMaxBudget));
+}
+
 std::wstring WideFromUtf8(std::string_view text)
 {
     if (text.empty())
@@ -451,6 +472,109 @@ ExifData ExtractExifFromJpeg(const uint8_t* data, size_t sizeBytes) noexcept
     return out;
 }
 
+// Locates the JPEG thumbnail of the EXIF IFD1 (tags 0x0201/0x0202) inside the APP1 segment. Only bytes present in `data`
+// are considered, so this works on a prefix of the file.
+[[nodiscard]] bool FindJpegExifThumbnail(const uint8_t* data, size_t sizeBytes, const uint8_t*& outThumb, size_t& outThumbBytes) noexcept
+{
+    outThumb      = nullptr;
+    outThumbBytes = 0;
+
+    if (! data || sizeBytes < 4 || data[0] != 0xFF || data[1] != 0xD8)
+    {
+        return false;
+    }
+
+    size_t pos = 2;
+    while (pos + 4 <= sizeBytes && data[pos] == 0xFF)
+    {
+        const uint8_t marker = data[pos + 1];
+        if (marker == 0xDA || marker == 0xD9) // SOS or EOI
+        {
+            return false;
+        }
+
+        const uint16_t segLen = static_cast<uint16_t>((static_cast<uint16_t>(data[pos + 2]) << 8) | static_cast<uint16_t>(data[pos + 3]));
+        if (segLen < 2)
+        {
+            return false;
+        }
+
+        const size_t segData    = pos + 4;
+        const size_t segDataLen = static_cast<size_t>(segLen - 2);
+        if (! InRange(segData, segDataLen, sizeBytes))
+        {
+            return false;
+        }
+
+        if (marker == 0xE1 && segDataLen >= 14 && std::memcmp(data + segData, "Exif\0\0", 6) == 0)
+        {
+            const uint8_t* tiff   = data + segData + 6;
+            const size_t tiffSize = segDataLen - 6;
+            const bool little     = tiff[0] == 'I' && tiff[1] == 'I';
+            if (ReadU16(tiff + 2, little) != 42)
+            {
+                return false;
+            }
+
+            const uint32_t ifd0Off = ReadU32(tiff + 4, little);
+            if (! InRange(ifd0Off, 2, tiffSize))
+            {
+                return false;
+            }
+
+            const size_t ifd0Count = ReadU16(tiff + ifd0Off, little);
+            const size_t nextOff   = static_cast<size_t>(ifd0Off) + 2u + ifd0Count * 12u;
+            if (! InRange(nextOff, 4, tiffSize))
+            {
+                return false;
+            }
+
+            const uint32_t ifd1Off = ReadU32(tiff + nextOff, little);
+            if (ifd1Off == 0 || ! InRange(ifd1Off, 2, tiffSize))
+            {
+                return false;
+            }
+
+            uint32_t thumbOff        = 0;
+            uint32_t thumbBytes      = 0;
+            const uint16_t ifd1Count = ReadU16(tiff + ifd1Off, little);
+            for (uint16_t i = 0; i < ifd1Count; ++i)
+            {
+                const size_t entryOff = static_cast<size_t>(ifd1Off) + 2u + static_cast<size_t>(i) * 12u;
+                if (! InRange(entryOff, 12, tiffSize))
+                {
+                    break;
+                }
+
+                const uint16_t tag           = ReadU16(tiff + entryOff, little);
+                const uint32_t cnt           = ReadU32(tiff + entryOff + 4, little);
+                const uint32_t valueOrOffset = ReadU32(tiff + entryOff + 8, little);
+                if (tag == 0x0201)
+                {
+                    static_cast<void>(ReadTiffLong(tiff, tiffSize, little, valueOrOffset, cnt, thumbOff));
+                }
+                else if (tag == 0x0202)
+                {
+                    static_cast<void>(ReadTiffLong(tiff, tiffSize, little, valueOrOffset, cnt, thumbBytes));
+                }
+            }
+
+            if (thumbOff == 0 || thumbBytes < 4 || ! InRange(thumbOff, thumbBytes, tiffSize) || tiff[thumbOff] != 0xFF || tiff[thumbOff + 1] != 0xD8)
+            {
+                return false;
+            }
+
+            outThumb      = tiff + thumbOff;
+            outThumbBytes = thumbBytes;
+            return true;
+        }
+
+        pos = segData + segDataLen;
+    }
+
+    return false;
+}
+
 std::wstring TrimSpaces(std::wstring_view text)
 {
     size_t start = 0;
@@ -526,6 +650,7 @@ struct LibRawProgressHost final
     const std::atomic_uint64_t* requestIdCounter = nullptr;
     uint64_t requestId                           = 0;
     HWND hwnd                                    = nullptr;
+    const std::atomic_bool* cancelled            = nullptr; // Background decodes: abort once set (no progress messages)
 };
 
 struct LibRawProgressContext final
@@ -538,7 +663,17 @@ struct LibRawProgressContext final
 int LibRawProgressCallback(void* data, enum LibRaw_progress stage, int iteration, int expected) noexcept
 {
     auto* ctx = static_cast<LibRawProgressContext*>(data);
-    if (! ctx || ! ctx->host.requestIdCounter || ! ctx->host.hwnd)
+    if (! ctx)
+    {
+        return 0;
+    }
+
+    if (ctx->host.cancelled && ctx->host.cancelled->load(std::memory_order_acquire))
+    {
+        return 1;
+    }
+
+    if (! ctx->host.requestIdCounter || ! ctx->host.hwnd)
     {
         return 0;
     }
@@ -661,6 +796,38 @@ HRESULT ReadFileAllBytes(IFileSystem* fileSystem, const std::wstring& path, std:
     return S_OK;
 }
 
+// Grows `bytes` to `targetBytes` with sequential reads from the reader's current position (which must be bytes.size()).
+HRESULT ReadMoreBytes(IFileReader* reader, size_t targetBytes, std::vector<uint8_t>& bytes) noexcept
+{
+    size_t offset = bytes.size();
+    try
+    {
+        bytes.resize(targetBytes);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    while (offset < bytes.size())
+    {
+        const unsigned long want = static_cast<unsigned long>(std::min<size_t>(bytes.size() - offset, 1024u * 1024u));
+        unsigned long got        = 0;
+        const HRESULT readHr     = reader->Read(bytes.data() + offset, want, &got);
+        if (FAILED(readHr))
+        {
+            return readHr;
+        }
+        if (got == 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+        }
+        offset += got;
+    }
+
+    return S_OK;
+}
+
 HRESULT DecodeImageToBgraWic(const uint8_t* data, size_t sizeBytes, uint32_t& outWidth, uint32_t& outHeight, std::vector<uint8_t>& outBgra) noexcept
 {
     outWidth  = 0;
@@ -1049,12 +1216,19 @@ HRESULT DecodeJpegToBgraTurboJpeg(const uint8_t* data, size_t sizeBytes, uint32_
     return DecodeJpegToBgraTurboJpegScaled(data, sizeBytes, kMaxJpegDim, outWidth, outHeight, outBgra);
 }
 
-bool TryDecodeRawEmbeddedThumbnailFromBufferToBgra(const std::vector<uint8_t>& fileBytes,
-                                                   uint32_t& outWidth,
-                                                   uint32_t& outHeight,
-                                                   std::vector<uint8_t>& outBgra,
-                                                   bool& outThumbAvailable,
-                                                   ExifData& outExif) noexcept
+// Decodes a JPEG for a thumbnail: TurboJPEG picks the smallest DCT scale that still covers `maxDim`,
+// then the result is box-filtered down to fit.
+HRESULT DecodeJpegThumbnailToBgra(
+    const uint8_t* data, size_t sizeBytes, uint32_t maxDim, uint32_t& outWidth, uint32_t& outHeight, std::vector<uint8_t>& outBgra) noexcept;
+
+// Opened LibRaw instance -> embedded thumbnail. maxDim == 0 decodes JPEG previews at full size.
+bool TryDecodeRawEmbeddedThumbnailToBgra(LibRaw& raw,
+                                         uint32_t maxDim,
+                                         uint32_t& outWidth,
+                                         uint32_t& outHeight,
+                                         std::vector<uint8_t>& outBgra,
+                                         bool& outThumbAvailable,
+                                         ExifData& outExif) noexcept
 {
     outWidth  = 0;
     outHeight = 0;
@@ -1062,19 +1236,6 @@ bool TryDecodeRawEmbeddedThumbnailFromBufferToBgra(const std::vector<uint8_t>& f
     outThumbAvailable = false;
     outExif           = {};
 
-    if (fileBytes.empty())
-    {
-        return false;
-    }
-
-    LibRaw raw;
-    const int openRet = raw.open_buffer(fileBytes.data(), fileBytes.size());
-    if (openRet != LIBRAW_SUCCESS)
-    {
-        return false;
-    }
-    auto recycle = wil::scope_exit([&] { raw.recycle(); });
-
     const int thumbRet = raw.unpack_thumb();
     if (thumbRet != LIBRAW_SUCCESS)
     {
@@ -1124,8 +1285,10 @@ bool TryDecodeRawEmbeddedThumbnailFromBufferToBgra(const std::vector<uint8_t>& f
         }
         outExif.valid = outExif.valid || jpegExif.valid || outExif.orientation != 1;
 
-        const HRESULT hr =
-            DecodeJpegToBgraTurboJpeg(reinterpret_cast<const uint8_t*>(thumb.thumb), static_cast<size_t>(thumb.tlength), outWidth, outHeight, outBgra);
+        const auto* jpegData   = reinterpret_cast<const uint8_t*>(thumb.thumb);
+        const size_t jpegBytes = static_cast<size_t>(thumb.tlength);
+        const HRESULT hr       = maxDim > 0 ? DecodeJpegThumbnailToBgra(jpegData, jpegBytes, maxDim, outWidth, outHeight, outBgra)
+                                            : DecodeJpegToBgraTurboJpeg(jpegData, jpegBytes, outWidth, outHeight, outBgra);
         return SUCCEEDED(hr);
     }
 
@@ -1161,41 +1324,11 @@ bool TryDecodeRawEmbeddedThumbnailFromBufferToBgra(const std::vector<uint8_t>& f
 
     if (bits == 8)
     {
-        const uint8_t* src = reinterpret_cast<const uint8_t*>(thumb.thumb);
-        for (uint64_t i = 0; i < pixelCount; ++i)
-        {
-            const size_t si = static_cast<size_t>(i) * colors;
-            const uint8_t r = colors >= 1 ? src[si + 0] : uint8_t{0};
-            const uint8_t g = colors >= 2 ? src[si + 1] : r;
-            const uint8_t b = colors >= 3 ? src[si + 2] : r;
-
-            const size_t di = static_cast<size_t>(i) * 4u;
-            outBgra[di + 0] = b;
-            outBgra[di + 1] = g;
-            outBgra[di + 2] = r;
-            outBgra[di + 3] = uint8_t{255};
-        }
+        PixelKernels::ConvertRgb8ToBgra(reinterpret_cast<const uint8_t*>(thumb.thumb), colors, outBgra.data(), static_cast<size_t>(pixelCount));
     }
     else
     {
-        const uint16_t* src = reinterpret_cast<const uint16_t*>(thumb.thumb);
-        for (uint64_t i = 0; i < pixelCount; ++i)
-        {
-            const size_t si    = static_cast<size_t>(i) * colors;
-            const uint16_t r16 = colors >= 1 ? src[si + 0] : uint16_t{0};
-            const uint16_t g16 = colors >= 2 ? src[si + 1] : r16;
-            const uint16_t b16 = colors >= 3 ? src[si + 2] : r16;
-
-            const uint8_t r = static_cast<uint8_t>(r16 >> 8);
-            const uint8_t g = static_cast<uint8_t>(g16 >> 8);
-            const uint8_t b = static_cast<uint8_t>(b16 >> 8);
-
-            const size_t di = static_cast<size_t>(i) * 4u;
-            outBgra[di + 0] = b;
-            outBgra[di + 1] = g;
-            outBgra[di + 2] = r;
-            outBgra[di + 3] = uint8_t{255};
-        }
+        PixelKernels::ConvertRgb16ToBgra(reinterpret_cast<const uint16_t*>(thumb.thumb), colors, outBgra.data(), static_cast<size_t>(pixelCount));
     }
 
     outWidth  = w;
@@ -1203,164 +1336,638 @@ bool TryDecodeRawEmbeddedThumbnailFromBufferToBgra(const std::vector<uint8_t>& f
     return true;
 }
 
-HRESULT DecodeRawFullImageFromBufferToBgra(const RawDecodeSettings& cfg,
-                                           const std::vector<uint8_t>& fileBytes,
-                                           uint32_t& outWidth,
-                                           uint32_t& outHeight,
-                                           std::vector<uint8_t>& outBgra,
-                                           std::wstring& outStatusMessage,
-                                           ExifData& outExif,
-                                           const LibRawProgressHost* progressHost) noexcept
+bool TryDecodeRawEmbeddedThumbnailFromBufferToBgra(const std::vector<uint8_t>& fileBytes,
+                                                   uint32_t& outWidth,
+                                                   uint32_t& outHeight,
+                                                   std::vector<uint8_t>& outBgra,
+                                                   bool& outThumbAvailable,
+                                                   ExifData& outExif) noexcept
 {
     outWidth  = 0;
     outHeight = 0;
     outBgra.clear();
-    outStatusMessage.clear();
-    outExif = {};
+    outThumbAvailable = false;
+    outExif           = {};
 
     if (fileBytes.empty())
     {
-        outStatusMessage = L"ViewerImgRaw: File is empty.";
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        return false;
     }
 
     LibRaw raw;
-    raw.imgdata.params.half_size      = cfg.halfSize ? 1 : 0;
-    raw.imgdata.params.use_camera_wb  = cfg.useCameraWb ? 1 : 0;
-    raw.imgdata.params.use_auto_wb    = cfg.autoWb ? 1 : 0;
-    raw.imgdata.params.no_auto_bright = 1;
-    raw.imgdata.params.output_bps     = 8;
-
-    LibRawProgressContext progressCtx{};
-    if (progressHost && progressHost->requestIdCounter && progressHost->hwnd)
-    {
-        progressCtx.host = *progressHost;
-        raw.set_progress_handler(&LibRawProgressCallback, &progressCtx);
-    }
-
     const int openRet = raw.open_buffer(fileBytes.data(), fileBytes.size());
     if (openRet != LIBRAW_SUCCESS)
     {
-        outStatusMessage = std::format(L"ViewerImgRaw: LibRaw open failed: {} (code={}).", WideFromUtf8(LibRaw::strerror(openRet)), openRet);
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        return false;
     }
+    auto recycle = wil::scope_exit([&] { raw.recycle(); });
 
-    const int unpackRet = raw.unpack();
-    if (unpackRet != LIBRAW_SUCCESS)
+    return TryDecodeRawEmbeddedThumbnailToBgra(raw, 0, outWidth, outHeight, outBgra, outThumbAvailable, outExif);
+}
+
+void DownscaleBgraToFit(uint32_t& width, uint32_t& height, std::vector<uint8_t>& bgra, uint32_t maxDim) noexcept
+{
+    if (width == 0 || height == 0 || maxDim == 0 || (width <= maxDim && height <= maxDim))
     {
-        outStatusMessage = std::format(L"ViewerImgRaw: LibRaw unpack failed: {} (code={}).", WideFromUtf8(LibRaw::strerror(unpackRet)), unpackRet);
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        return;
     }
 
-    outExif = ExtractExifData(raw);
+    const double scale  = static_cast<double>(maxDim) / static_cast<double>(std::max(width, height));
+    const uint32_t outW = std::max(1u, static_cast<uint32_t>(std::lround(static_cast<double>(width) * scale)));
+    const uint32_t outH = std::max(1u, static_cast<uint32_t>(std::lround(static_cast<double>(height) * scale)));
 
-    const int processRet = raw.dcraw_process();
-    if (processRet != LIBRAW_SUCCESS)
+    // Halve with the vectorized 2x2 kernel while the result still covers the target, so the general box filter below only
+    // handles the last (< 2x) step.
+    try
     {
-        outStatusMessage = std::format(L"ViewerImgRaw: LibRaw process failed: {} (code={}).", WideFromUtf8(LibRaw::strerror(processRet)), processRet);
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        while ((width + 1u) / 2u >= outW && (height + 1u) / 2u >= outH && (width > outW || height > outH))
+        {
+            const uint32_t halfW = (width + 1u) / 2u;
+            const uint32_t halfH = (height + 1u) / 2u;
+            std::vector<uint8_t> half(static_cast<size_t>(halfW) * halfH * 4u);
+            PixelKernels::ForEachRowBand(halfH,
+                                         kConvertRowsPerBand,
+                                         [&](uint32_t rowBegin, uint32_t rowEnd) noexcept
+                                         { PixelKernels::DownsampleBgraBox2x2Rows(bgra.data(), width, height, half.data(), rowBegin, rowEnd); });
+
+            bgra   = std::move(half);
+            width  = halfW;
+            height = halfH;
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        // Keep whatever level was reached; the box filter below finishes from there.
     }
 
-    int memErr                       = 0;
-    libraw_processed_image_t* memImg = raw.dcraw_make_mem_image(&memErr);
-    if (! memImg || memErr != LIBRAW_SUCCESS)
+    if (width == outW && height == outH)
     {
-        outStatusMessage = std::format(L"ViewerImgRaw: LibRaw make_mem_image failed: {} (code={}).", WideFromUtf8(LibRaw::strerror(memErr)), memErr);
-        if (memImg)
-        {
-            LibRaw::dcraw_clear_mem(memImg);
-        }
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        return;
     }
 
-    auto freeMemImg = wil::scope_exit(
-        [&]
+    const size_t srcStride = static_cast<size_t>(width) * 4u;
+
+    // Box filter: each destination pixel averages its source footprint.
+    std::vector<uint8_t> out(static_cast<size_t>(outW) * outH * 4u);
+    for (uint32_t y = 0; y < outH; ++y)
+    {
+        const uint32_t sy0 = static_cast<uint32_t>(static_cast<uint64_t>(y) * height / outH);
+        const uint32_t sy1 = std::max(sy0 + 1u, static_cast<uint32_t>(static_cast<uint64_t>(y + 1u) * height / outH));
+        for (uint32_t x = 0; x < outW; ++x)
         {
-            LibRaw::dcraw_clear_mem(memImg);
-            raw.recycle();
-        });
+            const uint32_t sx0 = static_cast<uint32_t>(static_cast<uint64_t>(x) * width / outW);
+            const uint32_t sx1 = std::max(sx0 + 1u, static_cast<uint32_t>(static_cast<uint64_t>(x + 1u) * width / outW));
 
-    const uint32_t w      = static_cast<uint32_t>(memImg->width);
-    const uint32_t h      = static_cast<uint32_t>(memImg->height);
-    const uint32_t colors = static_cast<uint32_t>(memImg->colors);
-    const uint32_t bits   = static_cast<uint32_t>(memImg->bits);
+            uint32_t sum[4]{};
+            for (uint32_t sy = sy0; sy < sy1; ++sy)
+            {
+                const uint8_t* row = bgra.data() + static_cast<size_t>(sy) * srcStride;
+                for (uint32_t sx = sx0; sx < sx1; ++sx)
+                {
+                    const uint8_t* px = row + static_cast<size_t>(sx) * 4u;
+                    sum[0] += px[0];
+                    sum[1] += px[1];
+                    sum[2] += px[2];
+                    sum[3] += px[3];
+                }
+            }
 
-    if (w == 0 || h == 0 || colors == 0)
-    {
-        outStatusMessage = L"ViewerImgRaw: Invalid decoded image dimensions.";
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            const uint32_t count = (sy1 - sy0) * (sx1 - sx0);
+            uint8_t* dst         = out.data() + (static_cast<size_t>(y) * outW + x) * 4u;
+            for (size_t c = 0; c < 4; ++c)
+            {
+                dst[c] = static_cast<uint8_t>((sum[c] + count / 2u) / count);
+            }
+        }
     }
 
-    static constexpr uint32_t kMaxBitmapDim = 16384u;
-    if (w > kMaxBitmapDim || h > kMaxBitmapDim)
+    bgra   = std::move(out);
+    width  = outW;
+    height = outH;
+}
+
+// Bakes an EXIF orientation (1..8) into the pixels so thumbnails draw upright without a transform.
+void ApplyExifOrientationToBgra(uint32_t& width, uint32_t& height, std::vector<uint8_t>& bgra, uint16_t orientation) noexcept
+{
+    orientation = NormalizeExifOrientation(orientation);
+    if (orientation == 1 || width == 0 || height == 0)
     {
-        outStatusMessage = std::format(L"ViewerImgRaw: Image too large ({}×{}).", w, h);
-        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        return;
     }
 
-    const uint64_t pixelCount = static_cast<uint64_t>(w) * static_cast<uint64_t>(h);
-    if (pixelCount == 0 || pixelCount > (static_cast<uint64_t>(std::numeric_limits<size_t>::max()) / 4ull))
+    const bool swapAxes = orientation >= 5;
+    const uint32_t outW = swapAxes ? height : width;
+    const uint32_t outH = swapAxes ? width : height;
+
+    std::vector<uint8_t> out(bgra.size());
+    for (uint32_t y = 0; y < outH; ++y)
     {
-        outStatusMessage = L"ViewerImgRaw: Decoded image is too large.";
-        return E_OUTOFMEMORY;
+        for (uint32_t x = 0; x < outW; ++x)
+        {
+            uint32_t sx = x;
+            uint32_t sy = y;
+            switch (orientation)
+            {
+                case 2: sx = width - 1u - x; break;
+                case 3:
+                    sx = width - 1u - x;
+                    sy = height - 1u - y;
+                    break;
+                case 4: sy = height - 1u - y; break;
+                case 5:
+                    sx = y;
+                    sy = x;
+                    break;
+                case 6:
+                    sx = y;
+                    sy = height - 1u - x;
+                    break;
+                case 7:
+                    sx = width - 1u - y;
+                    sy = height - 1u - x;
+                    break;
+                case 8:
+                    sx = width - 1u - y;
+                    sy = x;
+                    break;
+                default: break;
+            }
+
+            const size_t dstOffset = (static_cast<size_t>(y) * outW + x) * 4u;
+            const size_t srcOffset = (static_cast<size_t>(sy) * width + sx) * 4u;
+            std::memcpy(out.data() + dstOffset, bgra.data() + srcOffset, 4u);
+        }
     }
 
-    const size_t outBytes = static_cast<size_t>(pixelCount) * 4u;
-    outBgra.assign(outBytes, 0);
+    bgra   = std::move(out);
+    width  = outW;
+    height = outH;
+}
 
-    const size_t bytesPerSample    = bits == 16 ? 2u : 1u;
-    const size_t expectedDataBytes = static_cast<size_t>(pixelCount) * static_cast<size_t>(colors) * bytesPerSample;
-    if (memImg->data_size < expectedDataBytes)
+HRESULT DecodeJpegThumbnailToBgra(
+    const uint8_t* data, size_t sizeBytes, uint32_t maxDim, uint32_t& outWidth, uint32_t& outHeight, std::vector<uint8_t>& outBgra) noexcept
+{
+    outWidth  = 0;
+    outHeight = 0;
+    outBgra.clear();
+
+    if (! data || sizeBytes == 0 || maxDim == 0 || sizeBytes > static_cast<size_t>(std::numeric_limits<unsigned long>::max()))
     {
-        outStatusMessage = L"ViewerImgRaw: Decoded image buffer is truncated.";
-        outBgra.clear();
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        return E_INVALIDARG;
     }
 
-    if (bits == 8)
+    int w = 0;
+    int h = 0;
     {
-        const uint8_t* src = memImg->data;
-        for (uint64_t i = 0; i < pixelCount; ++i)
+        wil::unique_any<tjhandle, decltype(&tjDestroy), tjDestroy> handle(tjInitDecompress());
+        if (! handle)
         {
-            const size_t si = static_cast<size_t>(i) * colors;
-            const uint8_t r = colors >= 1 ? src[si + 0] : uint8_t{0};
-            const uint8_t g = colors >= 2 ? src[si + 1] : r;
-            const uint8_t b = colors >= 3 ? src[si + 2] : r;
+            return E_FAIL;
+        }
 
-            const size_t di = static_cast<size_t>(i) * 4u;
-            outBgra[di + 0] = b;
-            outBgra[di + 1] = g;
-            outBgra[di + 2] = r;
-            outBgra[di + 3] = 255u;
+        int subsamp               = 0;
+        int colorspace            = 0;
+        const auto* jpegBytes     = reinterpret_cast<const unsigned char*>(data);
+        const unsigned long bytes = static_cast<unsigned long>(sizeBytes);
+        const int headerRc        = tjDecompressHeader3(handle.get(), jpegBytes, bytes, &w, &h, &subsamp, &colorspace);
+        if (headerRc != 0 || w <= 0 || h <= 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
         }
     }
-    else if (bits == 16)
+
+    // Smallest DCT scale whose longer side still covers maxDim (DecodeJpegToBgraTurboJpegScaled picks the largest that fits).
+    int decodeBound                = std::max(w, h);
+    int factorCount                = 0;
+    const tjscalingfactor* factors = tjGetScalingFactors(&factorCount);
+    for (int i = 0; factors && i < factorCount; ++i)
     {
-        const uint16_t* src = reinterpret_cast<const uint16_t*>(memImg->data);
-        for (uint64_t i = 0; i < pixelCount; ++i)
+        const int side = std::max(TJSCALED(w, factors[i]), TJSCALED(h, factors[i]));
+        if (side >= static_cast<int>(maxDim) && side < decodeBound)
         {
-            const size_t si    = static_cast<size_t>(i) * colors;
-            const uint16_t r16 = colors >= 1 ? src[si + 0] : uint16_t{0};
-            const uint16_t g16 = colors >= 2 ? src[si + 1] : r16;
-            const uint16_t b16 = colors >= 3 ? src[si + 2] : r16;
-
-            const uint8_t r = static_cast<uint8_t>(r16 >> 8);
-            const uint8_t g = static_cast<uint8_t>(g16 >> 8);
-            const uint8_t b = static_cast<uint8_t>(b16 >> 8);
-
-            const size_t di = static_cast<size_t>(i) * 4u;
-            outBgra[di + 0] = b;
-            outBgra[di + 1] = g;
-            outBgra[di + 2] = r;
-            outBgra[di + 3] = 255u;
+            decodeBound = side;
         }
     }
-    else
-    {
-        outStatusMessage = std::format(L"ViewerImgRaw: Unsupported bit depth ({}).", bits);
-        outBgra.clear();
-        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
-    }
+
+    const HRESULT hr = DecodeJpegToBgraTurboJpegScaled(data, sizeBytes, decodeBound, outWidth, outHeight, outBgra);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    DownscaleBgraToFit(outWidth, outHeight, outBgra, maxDim);
+    return S_OK;
+}
+
+// LibRaw stream over IFileReader: LibRaw seeks to the metadata and embedded preview, so a RAW thumbnail
+// reads a few blocks instead of the whole file (matters for FTP/SFTP/S3 file systems).
+class FileReaderDataStream final : public LibRaw_abstract_datastream
+{
+public:
+    FileReaderDataStream(IFileReader* reader, uint64_t sizeBytes) noexcept : _reader(reader), _size(sizeBytes)
+    {
+    }
+
+    FileReaderDataStream(const FileReaderDataStream&)            = delete;
+    FileReaderDataStream& operator=(const FileReaderDataStream&) = delete;
+
+    [[nodiscard]] uint64_t BytesRead() const noexcept
+    {
+        return _bytesRead;
+    }
+
+    int valid() override
+    {
+        return _reader && ! _failed ? 1 : 0;
+    }
+
+    int read(void* ptr, size_t size, size_t nmemb) override
+    {
+        if (size == 0 || nmemb == 0 || ! ptr)
+        {
+            return 0;
+        }
+
+        const uint64_t want      = static_cast<uint64_t>(size) * static_cast<uint64_t>(nmemb);
+        const uint64_t available = _pos < _size ? _size - _pos : 0;
+        const size_t toRead      = static_cast<size_t>(std::min(want, available));
+        const size_t got         = ReadAt(_pos, static_cast<uint8_t*>(ptr), toRead);
+        _pos += got;
+        return static_cast<int>((got + size - 1u) / size);
+    }
+
+    int seek(INT64 offset, int whence) override
+    {
+        int64_t base = 0;
+        switch (whence)
+        {
+            case SEEK_SET: base = 0; break;
+            case SEEK_CUR: base = static_cast<int64_t>(_pos); break;
+            case SEEK_END: base = static_cast<int64_t>(_size); break;
+            default: return -1;
+        }
+
+        const int64_t target = std::clamp<int64_t>(base + static_cast<int64_t>(offset), 0, static_cast<int64_t>(_size));
+        _pos                 = static_cast<uint64_t>(target);
+        return 0;
+    }
+
+    INT64 tell() override
+    {
+        return static_cast<INT64>(_pos);
+    }
+
+    INT64 size() override
+    {
+        return static_cast<INT64>(_size);
+    }
+
+    int get_char() override
+    {
+        uint8_t ch = 0;
+        if (ReadAt(_pos, &ch, 1u) != 1u)
+        {
+            return -1;
+        }
+        ++_pos;
+        return ch;
+    }
+
+    char* gets(char* str, int sz) override
+    {
+        if (! str || sz < 1)
+        {
+            return nullptr;
+        }
+
+        int count = 0;
+        while (count < sz - 1)
+        {
+            const int ch = get_char();
+            if (ch < 0)
+            {
+                break;
+            }
+            str[count++] = static_cast<char>(ch);
+            if (ch == '\n')
+            {
+                break;
+            }
+        }
+        str[count] = '\0';
+        return count > 0 ? str : nullptr;
+    }
+
+    int scanf_one(const char* fmt, void* val) override
+    {
+        // Mirrors LibRaw_buffer_datastream: scan one token, then skip past it.
+        char token[32]{};
+        const size_t got = ReadAt(_pos, reinterpret_cast<uint8_t*>(token), sizeof(token) - 1u);
+        if (got == 0)
+        {
+            return -1;
+        }
+
+#pragma warning(suppress : 4996) // Format comes from LibRaw ("%d"/"%f"); no string conversions
+        const int scanned = sscanf(token, fmt, val);
+        if (scanned > 0)
+        {
+            size_t advance = 0;
+            while (_pos < _size)
+            {
+                ++_pos;
+                ++advance;
+                const char ch = advance < got ? token[advance] : '\0';
+                if (ch == '\0' || ch == ' ' || ch == '\t' || ch == '\n' || advance > 24u)
+                {
+                    break;
+                }
+            }
+        }
+        return scanned;
+    }
+
+    int eof() override
+    {
+        return _pos >= _size ? 1 : 0;
+    }
+
+private:
+    static constexpr size_t kBlockBytes = 64u * 1024u;
+    static constexpr size_t kBlockCount = 4u;
+
+    struct Block
+    {
+        uint64_t index    = std::numeric_limits<uint64_t>::max();
+        uint64_t lastUse  = 0;
+        size_t validBytes = 0;
+        std::vector<uint8_t> bytes;
+    };
+
+    bool ReadRaw(uint64_t offset, uint8_t* dst, size_t count, size_t& outRead) noexcept
+    {
+        outRead         = 0;
+        uint64_t newPos = 0;
+        if (FAILED(_reader->Seek(static_cast<__int64>(offset), FILE_BEGIN, &newPos)))
+        {
+            _failed = true;
+            return false;
+        }
+
+        while (outRead < count)
+        {
+            const unsigned long want = static_cast<unsigned long>(std::min<size_t>(count - outRead, 1024u * 1024u));
+            unsigned long got        = 0;
+            if (FAILED(_reader->Read(dst + outRead, want, &got)))
+            {
+                _failed = true;
+                return false;
+            }
+            if (got == 0)
+            {
+                break;
+            }
+            outRead += got;
+        }
+
+        _bytesRead += outRead;
+        return true;
+    }
+
+    Block* GetBlock(uint64_t blockIndex) noexcept
+    {
+        Block* victim = &_blocks[0];
+        for (Block& block : _blocks)
+        {
+            if (block.index == blockIndex)
+            {
+                block.lastUse = ++_useCounter;
+                return &block;
+            }
+            if (block.lastUse < victim->lastUse)
+            {
+                victim = &block;
+            }
+        }
+
+        victim->bytes.resize(kBlockBytes);
+        const uint64_t offset = blockIndex * kBlockBytes;
+        const size_t count    = static_cast<size_t>(std::min<uint64_t>(kBlockBytes, _size - std::min(offset, _size)));
+        size_t got            = 0;
+        if (! ReadRaw(offset, victim->bytes.data(), count, got))
+        {
+            victim->index = std::numeric_limits<uint64_t>::max();
+            return nullptr;
+        }
+
+        victim->index      = blockIndex;
+        victim->validBytes = got;
+        victim->lastUse    = ++_useCounter;
+        return victim;
+    }
+
+    size_t ReadAt(uint64_t offset, uint8_t* dst, size_t count) noexcept
+    {
+        if (_failed || count == 0 || offset >= _size)
+        {
+            return 0;
+        }
+
+        // Large reads (the embedded preview itself) bypass the block cache.
+        if (count >= kBlockBytes)
+        {
+            size_t got = 0;
+            static_cast<void>(ReadRaw(offset, dst, count, got));
+            return got;
+        }
+
+        size_t copied = 0;
+        while (copied < count)
+        {
+            const uint64_t position = offset + copied;
+            const Block* block      = GetBlock(position / kBlockBytes);
+            if (! block)
+            {
+                break;
+            }
+
+            const size_t inBlock = static_cast<size_t>(position % kBlockBytes);
+            if (inBlock >= block->validBytes)
+            {
+                break;
+            }
+
+            const size_t chunk = std::min(count - copied, block->validBytes - inBlock);
+            std::memcpy(dst + copied, block->bytes.data() + inBlock, chunk);
+            copied += chunk;
+        }
+        return copied;
+    }
+
+    IFileReader* _reader = nullptr;
+    uint64_t _size       = 0;
+    uint64_t _pos        = 0;
+    uint64_t _bytesRead  = 0;
+    uint64_t _useCounter = 0;
+    bool _failed         = false;
+    std::array<Block, kBlockCount> _blocks{};
+};
+
+HRESULT DecodeRawFullImageFromBufferToBgra(const RawDecodeSettings& cfg,
+                                           const std::vector<uint8_t>& fileBytes,
+                                           uint32_t& outWidth,
+                                           uint32_t& outHeight,
+                                           std::vector<uint8_t>& outBgra,
+                                           std::wstring& outStatusMessage,
+                                           ExifData& outExif,
+                                           const LibRawProgressHost* progressHost) noexcept
+{
+    outWidth  = 0;
+    outHeight = 0;
+    outBgra.clear();
+    outStatusMessage.clear();
+    outExif = {};
+
+    if (fileBytes.empty())
+    {
+        outStatusMessage = L"ViewerImgRaw: File is empty.";
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    LibRaw raw;
+    raw.imgdata.params.half_size      = cfg.halfSize ? 1 : 0;
+    raw.imgdata.params.use_camera_wb  = cfg.useCameraWb ? 1 : 0;
+    raw.imgdata.params.use_auto_wb    = cfg.autoWb ? 1 : 0;
+    raw.imgdata.params.no_auto_bright = 1;
+    raw.imgdata.params.output_bps     = 8;
+
+    LibRawProgressContext progressCtx{};
+    if (progressHost && ((progressHost->requestIdCounter && progressHost->hwnd) || progressHost->cancelled))
+    {
+        progressCtx.host = *progressHost;
+        raw.set_progress_handler(&LibRawProgressCallback, &progressCtx);
+    }
+
+    const int openRet = raw.open_buffer(fileBytes.data(), fileBytes.size());
+    if (openRet != LIBRAW_SUCCESS)
+    {
+        outStatusMessage = std::format(L"ViewerImgRaw: LibRaw open failed: {} (code={}).", WideFromUtf8(LibRaw::strerror(openRet)), openRet);
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    const int unpackRet = raw.unpack();
+    if (unpackRet != LIBRAW_SUCCESS)
+    {
+        outStatusMessage = std::format(L"ViewerImgRaw: LibRaw unpack failed: {} (code={}).", WideFromUtf8(LibRaw::strerror(unpackRet)), unpackRet);
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    outExif = ExtractExifData(raw);
+
+    const int processRet = raw.dcraw_process();
+    if (processRet != LIBRAW_SUCCESS)
+    {
+        outStatusMessage = std::format(L"ViewerImgRaw: LibRaw process failed: {} (code={}).", WideFromUtf8(LibRaw::strerror(processRet)), processRet);
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    int memErr                       = 0;
+    libraw_processed_image_t* memImg = raw.dcraw_make_mem_image(&memErr);
+    if (! memImg || memErr != LIBRAW_SUCCESS)
+    {
+        outStatusMessage = std::format(L"ViewerImgRaw: LibRaw make_mem_image failed: {} (code={}).", WideFromUtf8(LibRaw::strerror(memErr)), memErr);
+        if (memImg)
+        {
+            LibRaw::dcraw_clear_mem(memImg);
+        }
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    auto freeMemImg = wil::scope_exit(
+        [&]
+        {
+            LibRaw::dcraw_clear_mem(memImg);
+            raw.recycle();
+        });
+
+    const uint32_t w      = static_cast<uint32_t>(memImg->width);
+    const uint32_t h      = static_cast<uint32_t>(memImg->height);
+    const uint32_t colors = static_cast<uint32_t>(memImg->colors);
+    const uint32_t bits   = static_cast<uint32_t>(memImg->bits);
+
+    if (w == 0 || h == 0 || colors == 0)
+    {
+        outStatusMessage = L"ViewerImgRaw: Invalid decoded image dimensions.";
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    static constexpr uint32_t kMaxBitmapDim = 16384u;
+    if (w > kMaxBitmapDim || h > kMaxBitmapDim)
+    {
+        outStatusMessage = std::format(L"ViewerImgRaw: Image too large ({}×{}).", w, h);
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    const uint64_t pixelCount = static_cast<uint64_t>(w) * static_cast<uint64_t>(h);
+    if (pixelCount == 0 || pixelCount > (static_cast<uint64_t>(std::numeric_limits<size_t>::max()) / 4ull))
+    {
+        outStatusMessage = L"ViewerImgRaw: Decoded image is too large.";
+        return E_OUTOFMEMORY;
+    }
+
+    const size_t outBytes = static_cast<size_t>(pixelCount) * 4u;
+    outBgra.assign(outBytes, 0);
+
+    const size_t bytesPerSample    = bits == 16 ? 2u : 1u;
+    const size_t expectedDataBytes = static_cast<size_t>(pixelCount) * static_cast<size_t>(colors) * bytesPerSample;
+    if (memImg->data_size < expectedDataBytes)
+    {
+        outStatusMessage = L"ViewerImgRaw: Decoded image buffer is truncated.";
+        outBgra.clear();
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    const size_t rowPixels = static_cast<size_t>(w);
+    try
+    {
+        if (bits == 8)
+        {
+            const uint8_t* src = memImg->data;
+            PixelKernels::ForEachRowBand(h,
+                                         kConvertRowsPerBand,
+                                         [&](uint32_t rowBegin, uint32_t rowEnd) noexcept
+                                         {
+                                             const size_t first = static_cast<size_t>(rowBegin) * rowPixels;
+                                             const size_t count = static_cast<size_t>(rowEnd - rowBegin) * rowPixels;
+                                             PixelKernels::ConvertRgb8ToBgra(src + first * colors, colors, outBgra.data() + first * 4u, count);
+                                         });
+        }
+        else if (bits == 16)
+        {
+            const uint16_t* src = reinterpret_cast<const uint16_t*>(memImg->data);
+            PixelKernels::ForEachRowBand(h,
+                                         kConvertRowsPerBand,
+                                         [&](uint32_t rowBegin, uint32_t rowEnd) noexcept
+                                         {
+                                             const size_t first = static_cast<size_t>(rowBegin) * rowPixels;
+                                             const size_t count = static_cast<size_t>(rowEnd - rowBegin) * rowPixels;
+                                             PixelKernels::ConvertRgb16ToBgra(src + first * colors, colors, outBgra.data() + first * 4u, count);
+                                         });
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        outStatusMessage = L"ViewerImgRaw: Out of memory converting the decoded image.";
+        outBgra.clear();
+        return E_OUTOFMEMORY;
+    }
+
+    if (bits != 8 && bits != 16)
+    {
+        outStatusMessage = std::format(L"ViewerImgRaw: Unsupported bit depth ({}).", bits);
+        outBgra.clear();
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
 
     outWidth  = w;
     outHeight = h;
@@ -1368,6 +1975,130 @@ HRESULT DecodeRawFullImageFromBufferToBgra(const RawDecodeSettings& cfg,
 }
 } // namespace
 
+HRESULT STDMETHODCALLTYPE ViewerImgRaw::GetThumbnail(IFileSystem* fileSystem, const wchar_t* path, uint32_t maxDimension, ViewerThumbnailImage* image) noexcept
+{
+    if (! fileSystem || ! path || ! image || ! image->pixels || maxDimension == 0 ||
+        image->capacityBytes < static_cast<uint64_t>(maxDimension) * static_cast<uint64_t>(maxDimension) * 4ull)
+    {
+        return E_INVALIDARG;
+    }
+
+    image->width  = 0;
+    image->height = 0;
+
+    const std::wstring_view extension = PathExtensionView(path);
+    const bool isJpeg                 = IsJpegExtension(extension);
+    if (! isJpeg && ! IsLikelyRawExtension(extension))
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    wil::com_ptr<IFileSystemIO> fileIo;
+    HRESULT hr = fileSystem->QueryInterface(__uuidof(IFileSystemIO), fileIo.put_void());
+    if (FAILED(hr) || ! fileIo)
+    {
+        return FAILED(hr) ? hr : HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    wil::com_ptr<IFileReader> reader;
+    hr = fileIo->CreateFileReader(path, reader.put());
+    if (FAILED(hr) || ! reader)
+    {
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+
+    uint64_t sizeBytes = 0;
+    hr                 = reader->GetSize(&sizeBytes);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    if (sizeBytes == 0)
+    {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    uint32_t width       = 0;
+    uint32_t height      = 0;
+    uint16_t orientation = 1;
+    std::vector<uint8_t> bgra;
+
+    if (isJpeg)
+    {
+        // The EXIF thumbnail (typically 160×120) sits in APP1 at the start of the file, and one APP1 segment is at most 64 KiB.
+        // Reading just that prefix spares pulling whole photos over slow file systems; the full image is read only when the
+        // embedded thumbnail is missing or smaller than the requested size.
+        static constexpr uint64_t kExifPrefixBytes  = 68ull * 1024ull;
+        static constexpr uint64_t kMaxJpegFileBytes = 1024ull * 1024ull * 1024ull; // 1 GiB, as for the viewer itself
+        if (sizeBytes > kMaxJpegFileBytes)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+        }
+
+        std::vector<uint8_t> fileBytes;
+        hr = ReadMoreBytes(reader.get(), static_cast<size_t>(std::min(sizeBytes, kExifPrefixBytes)), fileBytes);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        const uint8_t* exifThumb = nullptr;
+        size_t exifThumbBytes    = 0;
+        const bool exifThumbFits = FindJpegExifThumbnail(fileBytes.data(), fileBytes.size(), exifThumb, exifThumbBytes) &&
+                                   SUCCEEDED(DecodeJpegThumbnailToBgra(exifThumb, exifThumbBytes, maxDimension, width, height, bgra)) &&
+                                   std::max(width, height) >= maxDimension;
+
+        orientation = ExtractExifFromJpeg(fileBytes.data(), fileBytes.size()).orientation;
+
+        if (! exifThumbFits)
+        {
+            // TurboJPEG needs the whole stream; DCT scaling keeps the decode itself small.
+            hr = ReadMoreBytes(reader.get(), static_cast<size_t>(sizeBytes), fileBytes);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = DecodeJpegThumbnailToBgra(fileBytes.data(), fileBytes.size(), maxDimension, width, height, bgra);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+    }
+    else
+    {
+        FileReaderDataStream stream(reader.get(), sizeBytes);
+        LibRaw raw;
+        if (raw.open_datastream(&stream) != LIBRAW_SUCCESS)
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+        auto recycle = wil::scope_exit([&] { raw.recycle(); });
+
+        bool thumbAvailable = false;
+        ExifData exif;
+        if (! TryDecodeRawEmbeddedThumbnailToBgra(raw, maxDimension, width, height, bgra, thumbAvailable, exif))
+        {
+            return HRESULT_FROM_WIN32(thumbAvailable ? ERROR_INVALID_DATA : ERROR_NOT_SUPPORTED);
+        }
+
+        DownscaleBgraToFit(width, height, bgra, maxDimension);
+        orientation = exif.orientation;
+    }
+
+    ApplyExifOrientationToBgra(width, height, bgra, orientation);
+    if (width == 0 || height == 0 || width > maxDimension || height > maxDimension || bgra.size() > image->capacityBytes)
+    {
+        return E_UNEXPECTED;
+    }
+
+    std::memcpy(image->pixels, bgra.data(), bgra.size());
+    image->width  = width;
+    image->height = height;
+    return S_OK;
+}
+
 void ViewerImgRaw::OnAsyncProgress(int stage, int percent) noexcept
 {
     _rawProgressStage     = stage;
@@ -1389,6 +2120,16 @@ void ViewerImgRaw::ClearImageCache() noexcept
 
     {
         std::scoped_lock lock(_cacheMutex);
+        ++_cacheEpoch;
+        if (_prefetchBatch)
+        {
+            _prefetchBatch->superseded.store(true, std::memory_order_release);
+            for (const auto& task : _prefetchBatch->tasks)
+            {
+                task->cancelled.store(true, std::memory_order_release);
+            }
+            _prefetchBatch.reset();
+        }
         _inflightDecodes.clear();
         _imageCache.clear();
     }
@@ -1396,7 +2137,7 @@ void ViewerImgRaw::ClearImageCache() noexcept
     _currentImageOwned.reset();
     _currentImage = nullptr;
     _currentImageKey.clear();
-    _imageBitmap.reset();
+    ResetImageBitmaps();
     _exifOverlayText.clear();
     _rawProgressPercent = -1;
     _rawProgressStage   = -1;
@@ -1434,7 +2175,7 @@ bool ViewerImgRaw::TryUseCachedImage(HWND hwnd, const std::wstring& path, bool&
         return false;
     }
 
-    const bool hasRaw   = cached->rawWidth != 0 && cached->rawHeight != 0 && ! cached->rawBgra.empty();
+    const bool hasRaw   = HasRawFrame(*cached);
     const bool hasThumb = cached->thumbDecoded && cached->thumbWidth != 0 && cached->thumbHeight != 0 && ! cached->thumbBgra.empty();
 
     if (_displayMode == DisplayMode::Raw)
@@ -1473,7 +2214,7 @@ bool ViewerImgRaw::TryUseCachedImage(HWND hwnd, const std::wstring& path, bool&
     }
 
     _statusMessage.clear();
-    _imageBitmap.reset();
+    ResetImageBitmaps();
 
     _currentImageOwned.reset();
     _currentImage    = cached;
@@ -1503,7 +2244,7 @@ bool ViewerImgRaw::HasDisplayImage() const noexcept
         return image->thumbDecoded && image->thumbWidth != 0 && image->thumbHeight != 0 && ! image->thumbBgra.empty();
     }
 
-    return image->rawWidth != 0 && image->rawHeight != 0 && ! image->rawBgra.empty();
+    return HasRawFrame(*image);
 }
 
 bool ViewerImgRaw::IsDisplayingThumbnail() const noexcept
@@ -1529,13 +2270,13 @@ void ViewerImgRaw::SetDisplayMode(DisplayMode mode) noexcept
     const CachedImage* image = _currentImage;
     if (image && _currentImageKey == _currentPath)
     {
-        const bool hasRaw   = image->rawWidth != 0 && image->rawHeight != 0 && ! image->rawBgra.empty();
+        const bool hasRaw   = HasRawFrame(*image);
         const bool hasThumb = image->thumbDecoded && image->thumbWidth != 0 && image->thumbHeight != 0 && ! image->thumbBgra.empty();
 
         if (_displayMode == DisplayMode::Raw && hasRaw)
         {
             _displayedMode = DisplayMode::Raw;
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateOrientationState();
             RebuildExifOverlayText();
             _panOffsetXPx = 0.0f;
@@ -1548,7 +2289,7 @@ void ViewerImgRaw::SetDisplayMode(DisplayMode mode) noexcept
         if (_displayMode == DisplayMode::Thumbnail && hasThumb)
         {
             _displayedMode = DisplayMode::Thumbnail;
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateOrientationState();
             RebuildExifOverlayText();
             _panOffsetXPx = 0.0f;
@@ -1873,8 +2614,131 @@ std::wstring ViewerImgRaw::BuildStatusBarRightText(bool drewImage, float display
         anyAdjust = true;
     }
 
-    static_cast<void>(anyAdjust);
-    return details;
+    static_cast<void>(anyAdjust);
+    return details;
+}
+
+struct ViewerImgRaw::PrefetchTask final
+{
+    std::wstring primaryPath;
+    std::wstring sidecarJpegPath;
+    bool isRaw       = false;
+    bool previewOnly = false; // Embedded/sidecar JPEG only; full decodes are queued after every neighbor's preview
+    std::atomic_bool cancelled{false};
+};
+
+struct ViewerImgRaw::PrefetchBatch final
+{
+    std::vector<std::shared_ptr<PrefetchTask>> tasks; // Priority order
+    std::atomic_size_t nextTask{0};
+    std::atomic_bool superseded{false}; // A newer batch exists: stop taking tasks (running ones continue unless cancelled)
+    wil::com_ptr<IFileSystem> fileSystem;
+    DisplayMode mode = DisplayMode::Raw;
+    RawDecodeSettings decodeCfg{};
+    size_t budgetBytes  = 0;
+    uint64_t cacheEpoch = 0; // Results are dropped once ClearImageCache moves _cacheEpoch on (decode settings changed)
+};
+
+size_t ViewerImgRaw::CachedImageBytes(const CachedImage& image) noexcept
+{
+    size_t bytes = image.rawBgra.size() + image.thumbBgra.size();
+    for (const ImageMipLevel& level : image.rawMips)
+    {
+        bytes += level.bgra.size();
+    }
+    if (image.rawSource)
+    {
+        bytes += image.rawSource->fileBytes.size();
+    }
+    return bytes;
+}
+
+std::vector<size_t> ViewerImgRaw::NeighborPrefetchOrder() const
+{
+    std::vector<size_t> order;
+
+    const size_t count = _otherItems.size();
+    if (count <= 1 || _otherIndex >= count)
+    {
+        return order;
+    }
+
+    const bool forward     = _navDirection >= 0;
+    const uint32_t prevN   = std::min<uint32_t>(std::min<uint32_t>(_config.prevCache, 8u), static_cast<uint32_t>(count - 1));
+    const uint32_t nextN   = std::min<uint32_t>(std::min<uint32_t>(_config.nextCache, 8u), static_cast<uint32_t>(count - 1));
+    const uint32_t aheadN  = forward ? nextN : prevN;
+    const uint32_t behindN = forward ? prevN : nextN;
+
+    const auto push = [&](bool ahead, uint32_t distance)
+    {
+        const bool towardNext = ahead == forward;
+        const size_t idx      = towardNext ? (_otherIndex + distance) % count : (_otherIndex + count - distance) % count;
+        if (idx != _otherIndex && std::find(order.begin(), order.end(), idx) == order.end())
+        {
+            order.push_back(idx);
+        }
+    };
+
+    // Two steps in the direction of travel for each step back: holding an arrow key lands there next.
+    uint32_t ahead  = 0;
+    uint32_t behind = 0;
+    while (ahead < aheadN || behind < behindN)
+    {
+        for (int step = 0; step < 2 && ahead < aheadN; ++step)
+        {
+            push(true, ++ahead);
+        }
+        if (behind < behindN)
+        {
+            push(false, ++behind);
+        }
+    }
+
+    return order;
+}
+
+void ViewerImgRaw::TrimImageCacheToBudgetLocked(const std::vector<size_t>& neighborOrder, size_t budgetBytes) noexcept
+{
+    size_t total = 0;
+    for (const auto& [path, image] : _imageCache)
+    {
+        total += image ? CachedImageBytes(*image) : 0;
+    }
+
+    // Full frames of the least likely neighbors go first, then their previews; the current image is never in neighborOrder.
+    for (int pass = 0; pass < 2 && total > budgetBytes; ++pass)
+    {
+        for (auto it = neighborOrder.rbegin(); it != neighborOrder.rend() && total > budgetBytes; ++it)
+        {
+            const auto entry = _imageCache.find(_otherItems[*it].primaryPath);
+            if (entry == _imageCache.end() || ! entry->second)
+            {
+                continue;
+            }
+
+            CachedImage& image = *entry->second;
+            if (pass == 0)
+            {
+                size_t frameBytes = image.rawBgra.size() + (image.rawSource ? image.rawSource->fileBytes.size() : 0);
+                for (const ImageMipLevel& level : image.rawMips)
+                {
+                    frameBytes += level.bgra.size();
+                }
+
+                image.rawWidth  = 0;
+                image.rawHeight = 0;
+                std::vector<uint8_t>().swap(image.rawBgra);
+                std::vector<ImageMipLevel>().swap(image.rawMips);
+                image.rawSource.reset();
+                total -= std::min(total, frameBytes);
+            }
+            else
+            {
+                total -= std::min(total, CachedImageBytes(image));
+                _imageCache.erase(entry);
+            }
+        }
+    }
 }
 
 void ViewerImgRaw::UpdateNeighborCache(uint64_t requestId) noexcept
@@ -1895,39 +2759,44 @@ void ViewerImgRaw::UpdateNeighborCache(uint64_t requestId) noexcept
         return;
     }
 
-    const size_t reserveCount =
-        1ull + static_cast<size_t>(std::min<uint32_t>(_config.prevCache, 8u)) + static_cast<size_t>(std::min<uint32_t>(_config.nextCache, 8u));
+    const std::vector<size_t> order = NeighborPrefetchOrder();
 
     std::unordered_set<std::wstring> keep;
-    keep.reserve(reserveCount);
+    keep.reserve(order.size() + 1u);
     keep.insert(_otherItems[_otherIndex].primaryPath);
-
-    const uint32_t prevN = std::min<uint32_t>(_config.prevCache, static_cast<uint32_t>(count - 1));
-    const uint32_t nextN = std::min<uint32_t>(_config.nextCache, static_cast<uint32_t>(count - 1));
-
-    for (uint32_t i = 1; i <= prevN; ++i)
-    {
-        const size_t idx = (_otherIndex + count - i) % count;
-        keep.insert(_otherItems[idx].primaryPath);
-    }
-
-    for (uint32_t i = 1; i <= nextN; ++i)
+    for (const size_t idx : order)
     {
-        const size_t idx = (_otherIndex + i) % count;
         keep.insert(_otherItems[idx].primaryPath);
     }
 
-    std::scoped_lock lock(_cacheMutex);
-    for (auto it = _imageCache.begin(); it != _imageCache.end();)
     {
-        if (keep.find(it->first) == keep.end())
+        std::scoped_lock lock(_cacheMutex);
+        for (auto it = _imageCache.begin(); it != _imageCache.end();)
         {
-            it = _imageCache.erase(it);
+            if (keep.find(it->first) == keep.end())
+            {
+                it = _imageCache.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
         }
-        else
+
+        // The user moved on: decodes of items that left the window are abandoned (LibRaw stops at its next progress callback).
+        if (_prefetchBatch)
         {
-            ++it;
+            _prefetchBatch->superseded.store(true, std::memory_order_release);
+            for (const auto& task : _prefetchBatch->tasks)
+            {
+                if (keep.find(task->primaryPath) == keep.end())
+                {
+                    task->cancelled.store(true, std::memory_order_release);
+                }
+            }
         }
+
+        TrimImageCacheToBudgetLocked(order, NeighborCacheBudgetBytes());
     }
 
     StartPrefetchNeighbors(requestId);
@@ -1940,64 +2809,65 @@ void ViewerImgRaw::StartPrefetchNeighbors(uint64_t requestId) noexcept
         return;
     }
 
-    if (_otherItems.size() <= 1)
-    {
-        return;
-    }
-
-    const size_t count = _otherItems.size();
-    if (_otherIndex >= count)
+    const wil::com_ptr<IFileSystem> fileSystem = _fileSystem;
+    if (! fileSystem || requestId != _openRequestId.load(std::memory_order_acquire))
     {
         return;
     }
 
-    const wil::com_ptr<IFileSystem> fileSystem = _fileSystem;
-    if (! fileSystem)
+    const std::vector<size_t> order = NeighborPrefetchOrder();
+    if (order.empty())
     {
         return;
     }
 
-    struct PrefetchItem final
+    std::shared_ptr<PrefetchBatch> batch;
+    try
     {
-        std::wstring primaryPath;
-        std::wstring sidecarJpegPath;
-        bool isRaw = false;
-    };
+        batch                        = std::make_shared<PrefetchBatch>();
+        batch->fileSystem            = fileSystem;
+        batch->mode                  = _displayMode;
+        batch->decodeCfg.halfSize    = _config.halfSize;
+        batch->decodeCfg.useCameraWb = _config.useCameraWb;
+        batch->decodeCfg.autoWb      = _config.autoWb;
+        batch->budgetBytes           = NeighborCacheBudgetBytes();
 
-    std::vector<PrefetchItem> items;
-    const uint32_t prevN = std::min<uint32_t>(_config.prevCache, static_cast<uint32_t>(count - 1));
-    const uint32_t nextN = std::min<uint32_t>(_config.nextCache, static_cast<uint32_t>(count - 1));
+        // Previews of every RAW neighbor first (a few milliseconds each), then full decodes in the same priority order.
+        batch->tasks.reserve(order.size() * 2u);
+        for (const bool previewPass : {true, false})
+        {
+            for (const size_t idx : order)
+            {
+                const OtherItem& other = _otherItems[idx];
+                if (other.primaryPath.empty() || (previewPass && ! other.isRaw))
+                {
+                    continue;
+                }
 
-    items.reserve(static_cast<size_t>(prevN) + static_cast<size_t>(nextN));
-    for (uint32_t i = 1; i <= prevN; ++i)
+                auto task             = std::make_shared<PrefetchTask>();
+                task->primaryPath     = other.primaryPath;
+                task->sidecarJpegPath = other.sidecarJpegPath;
+                task->isRaw           = other.isRaw;
+                task->previewOnly     = previewPass;
+                batch->tasks.push_back(std::move(task));
+            }
+        }
+    }
+    catch (const std::bad_alloc&)
     {
-        const size_t idx = (_otherIndex + count - i) % count;
-        PrefetchItem prefetch{};
-        const OtherItem& other   = _otherItems[idx];
-        prefetch.primaryPath     = other.primaryPath;
-        prefetch.sidecarJpegPath = other.sidecarJpegPath;
-        prefetch.isRaw           = other.isRaw;
-        items.push_back(std::move(prefetch));
+        return;
     }
 
-    for (uint32_t i = 1; i <= nextN; ++i)
     {
-        const size_t idx = (_otherIndex + i) % count;
-        PrefetchItem prefetch{};
-        const OtherItem& other   = _otherItems[idx];
-        prefetch.primaryPath     = other.primaryPath;
-        prefetch.sidecarJpegPath = other.sidecarJpegPath;
-        prefetch.isRaw           = other.isRaw;
-        items.push_back(std::move(prefetch));
+        std::scoped_lock lock(_cacheMutex);
+        if (_prefetchBatch)
+        {
+            _prefetchBatch->superseded.store(true, std::memory_order_release);
+        }
+        batch->cacheEpoch = _cacheEpoch;
+        _prefetchBatch    = batch;
     }
 
-    const DisplayMode prefetchMode = _displayMode;
-    RawDecodeSettings decodeCfg{};
-    decodeCfg.halfSize    = _config.halfSize;
-    decodeCfg.useCameraWb = _config.useCameraWb;
-    decodeCfg.autoWb      = _config.autoWb;
-
-    AddRef();
     struct PrefetchWorkItem final
     {
         PrefetchWorkItem()                                   = default;
@@ -2008,222 +2878,275 @@ void ViewerImgRaw::StartPrefetchNeighbors(uint64_t requestId) noexcept
         std::function<void()> work;
     };
 
-    auto ctx = std::unique_ptr<PrefetchWorkItem>(new (std::nothrow) PrefetchWorkItem{});
-
-    ctx->moduleKeepAlive = AcquireModuleReferenceFromAddress(&kViewerImgRawModuleAnchor);
-    ctx->work            = [this, fileSystem, items = std::move(items), requestId, prefetchMode, decodeCfg]() mutable
+    const size_t workers = std::min(kMaxPrefetchWorkers, batch->tasks.size());
+    for (size_t worker = 0; worker < workers; ++worker)
     {
-        auto releaseSelf = wil::scope_exit([&] { Release(); });
-
-        for (size_t index = 0; index < items.size(); ++index)
+        auto ctx = std::unique_ptr<PrefetchWorkItem>(new (std::nothrow) PrefetchWorkItem{});
+        if (! ctx)
         {
-            if (requestId != _openRequestId.load(std::memory_order_acquire))
-            {
-                return;
-            }
+            break;
+        }
 
-            const PrefetchItem& item = items[index];
-            const std::wstring& path = item.primaryPath;
+        AddRef();
+        ctx->moduleKeepAlive = AcquireModuleReferenceFromAddress(&kViewerImgRawModuleAnchor);
+        ctx->work            = [this, batch]()
+        {
+            auto releaseSelf = wil::scope_exit([&] { Release(); });
 
-            if (path.empty())
+            while (! batch->superseded.load(std::memory_order_acquire))
             {
-                continue;
+                const size_t index = batch->nextTask.fetch_add(1, std::memory_order_acq_rel);
+                if (index >= batch->tasks.size())
+                {
+                    return;
+                }
+
+                PrefetchTask& task = *batch->tasks[index];
+                if (! task.cancelled.load(std::memory_order_acquire))
+                {
+                    RunPrefetchTask(*batch, task);
+                }
             }
+        };
 
+        const BOOL queued = TrySubmitThreadpoolCallback(
+            [](PTP_CALLBACK_INSTANCE /*instance*/, void* context) noexcept
             {
-                std::scoped_lock lock(_cacheMutex);
-                if (_imageCache.find(path) != _imageCache.end())
+                std::unique_ptr<PrefetchWorkItem> ctx(static_cast<PrefetchWorkItem*>(context));
+                if (! ctx)
                 {
-                    continue;
+                    return;
                 }
-                if (_inflightDecodes.find(path) != _inflightDecodes.end())
+
+                static_cast<void>(ctx->moduleKeepAlive);
+                if (ctx->work)
                 {
-                    continue;
+                    ctx->work();
                 }
-                _inflightDecodes.insert(path);
-            }
+            },
+            ctx.get(),
+            nullptr);
+
+        if (queued == 0)
+        {
+            Debug::Error(L"ViewerImgRaw: Failed to queue neighbor prefetch work item.");
+            Release();
+            break;
+        }
+
+        ctx.release();
+    }
+}
+
+void ViewerImgRaw::RunPrefetchTask(const PrefetchBatch& batch, PrefetchTask& task) noexcept
+{
+    const std::wstring& path = task.primaryPath;
+
+    bool hasRawAlready = false;
+    {
+        std::scoped_lock lock(_cacheMutex);
+        const auto it             = _imageCache.find(path);
+        const CachedImage* cached = (it != _imageCache.end()) ? it->second.get() : nullptr;
+        hasRawAlready             = cached && HasRawFrame(*cached);
+        const bool hasThumb       = cached && cached->thumbDecoded && ! cached->thumbBgra.empty();
+
+        if (batch.cacheEpoch != _cacheEpoch)
+        {
+            return;
+        }
+        if (task.previewOnly ? (hasRawAlready || hasThumb) : (hasRawAlready || (batch.mode == DisplayMode::Thumbnail && hasThumb)))
+        {
+            return;
+        }
 
-            if (requestId != _openRequestId.load(std::memory_order_acquire))
+        if (! task.previewOnly)
+        {
+            if (_inflightDecodes.find(path) != _inflightDecodes.end())
             {
-                std::scoped_lock lock(_cacheMutex);
-                _inflightDecodes.erase(path);
                 return;
             }
 
-            std::vector<uint8_t> fileBytes;
-            std::wstring readStatus;
-            const HRESULT readHr = ReadFileAllBytes(fileSystem.get(), path, fileBytes, readStatus);
-            if (FAILED(readHr))
+            // Budget exhausted by nearer neighbors: this one keeps only its preview.
+            size_t total = 0;
+            for (const auto& [cachedPath, image] : _imageCache)
             {
-                std::scoped_lock lock(_cacheMutex);
-                _inflightDecodes.erase(path);
-                continue;
+                total += image ? CachedImageBytes(*image) : 0;
+            }
+            if (total >= batch.budgetBytes)
+            {
+                return;
             }
 
-            bool hasRawAlready = false;
+            _inflightDecodes.insert(path);
+        }
+    }
+
+    auto clearInflight = wil::scope_exit(
+        [&]
+        {
+            if (! task.previewOnly)
             {
                 std::scoped_lock lock(_cacheMutex);
-                const auto it = _imageCache.find(path);
-                if (it != _imageCache.end() && it->second)
-                {
-                    const CachedImage* cached = it->second.get();
-                    hasRawAlready             = cached->rawWidth != 0 && cached->rawHeight != 0 && ! cached->rawBgra.empty();
-                }
+                _inflightDecodes.erase(path);
             }
+        });
+
+    std::vector<uint8_t> fileBytes;
+    std::wstring readStatus;
+    const HRESULT readHr = ReadFileAllBytes(batch.fileSystem.get(), path, fileBytes, readStatus);
+    if (FAILED(readHr) || task.cancelled.load(std::memory_order_acquire))
+    {
+        return;
+    }
 
-            uint32_t rawW = 0;
-            uint32_t rawH = 0;
-            std::vector<uint8_t> rawBgra;
-            std::wstring rawStatus;
-            ExifData rawExif{};
-            HRESULT rawHr = S_OK;
+    uint32_t rawW = 0;
+    uint32_t rawH = 0;
+    std::vector<uint8_t> rawBgra;
+    std::vector<ImageMipLevel> rawMips;
+    std::shared_ptr<const ImageRegionSource> rawSource; // Large WIC frames: decoded per tile, rawMips holds the coarsest level
+    std::wstring rawStatus;
+    ExifData rawExif{};
+    HRESULT rawHr = E_FAIL;
 
-            bool thumbAvailable = ! item.sidecarJpegPath.empty();
-            ExifData thumbExif{};
-            uint32_t thumbW = 0;
-            uint32_t thumbH = 0;
-            std::vector<uint8_t> thumbBgra;
-            bool thumbDecoded                    = false;
-            CachedImage::ThumbSource thumbSource = CachedImage::ThumbSource::None;
+    bool thumbAvailable = ! task.sidecarJpegPath.empty();
+    ExifData thumbExif{};
+    uint32_t thumbW = 0;
+    uint32_t thumbH = 0;
+    std::vector<uint8_t> thumbBgra;
+    bool thumbDecoded                    = false;
+    CachedImage::ThumbSource thumbSource = CachedImage::ThumbSource::None;
 
-            if (! item.isRaw)
+    if (task.previewOnly)
+    {
+        if (! task.sidecarJpegPath.empty())
+        {
+            std::vector<uint8_t> sidecarBytes;
+            std::wstring sidecarStatus;
+            const HRESULT sidecarReadHr = ReadFileAllBytes(batch.fileSystem.get(), task.sidecarJpegPath, sidecarBytes, sidecarStatus);
+            if (SUCCEEDED(sidecarReadHr) && ! sidecarBytes.empty())
             {
-                if (! hasRawAlready)
+                const HRESULT sidecarDecodeHr = DecodeJpegToBgraTurboJpeg(sidecarBytes.data(), sidecarBytes.size(), thumbW, thumbH, thumbBgra);
+                if (SUCCEEDED(sidecarDecodeHr))
                 {
-                    const std::wstring_view ext = PathExtensionView(path);
-                    if (IsJpegExtension(ext))
-                    {
-                        rawHr   = DecodeJpegToBgraTurboJpeg(fileBytes.data(), fileBytes.size(), rawW, rawH, rawBgra);
-                        rawExif = ExtractExifFromJpeg(fileBytes.data(), fileBytes.size());
-                    }
-                    else
-                    {
-                        rawHr = DecodeImageToBgraWic(fileBytes.data(), fileBytes.size(), rawW, rawH, rawBgra);
-                    }
+                    thumbDecoded = true;
+                    thumbSource  = CachedImage::ThumbSource::SidecarJpeg;
+                    thumbExif    = ExtractExifFromJpeg(sidecarBytes.data(), sidecarBytes.size());
                 }
             }
-            else
-            {
-                if (! item.sidecarJpegPath.empty())
-                {
-                    std::vector<uint8_t> sidecarBytes;
-                    std::wstring sidecarStatus;
-                    const HRESULT sidecarReadHr = ReadFileAllBytes(fileSystem.get(), item.sidecarJpegPath, sidecarBytes, sidecarStatus);
-                    if (SUCCEEDED(sidecarReadHr) && ! sidecarBytes.empty())
-                    {
-                        const HRESULT sidecarDecodeHr = DecodeJpegToBgraTurboJpeg(sidecarBytes.data(), sidecarBytes.size(), thumbW, thumbH, thumbBgra);
-                        if (SUCCEEDED(sidecarDecodeHr))
-                        {
-                            thumbDecoded = true;
-                            thumbSource  = CachedImage::ThumbSource::SidecarJpeg;
-                            thumbExif    = ExtractExifFromJpeg(sidecarBytes.data(), sidecarBytes.size());
-                        }
-                    }
-                }
-
-                if (! thumbDecoded)
-                {
-                    thumbDecoded = TryDecodeRawEmbeddedThumbnailFromBufferToBgra(fileBytes, thumbW, thumbH, thumbBgra, thumbAvailable, thumbExif);
-                    if (thumbDecoded)
-                    {
-                        thumbSource = CachedImage::ThumbSource::Embedded;
-                    }
-                }
+        }
 
-                const bool needRawDecode = (prefetchMode == DisplayMode::Raw) || ! thumbDecoded;
-                if (needRawDecode && ! hasRawAlready)
-                {
-                    rawHr = DecodeRawFullImageFromBufferToBgra(decodeCfg, fileBytes, rawW, rawH, rawBgra, rawStatus, rawExif, nullptr);
-                }
+        if (! thumbDecoded)
+        {
+            thumbDecoded = TryDecodeRawEmbeddedThumbnailFromBufferToBgra(fileBytes, thumbW, thumbH, thumbBgra, thumbAvailable, thumbExif);
+            if (thumbDecoded)
+            {
+                thumbSource = CachedImage::ThumbSource::Embedded;
             }
-
-            if (requestId == _openRequestId.load(std::memory_order_acquire))
+        }
+    }
+    else if (! task.isRaw)
+    {
+        const std::wstring_view ext = PathExtensionView(path);
+        if (IsJpegExtension(ext))
+        {
+            rawHr   = DecodeJpegToBgraTurboJpeg(fileBytes.data(), fileBytes.size(), rawW, rawH, rawBgra);
+            rawExif = ExtractExifFromJpeg(fileBytes.data(), fileBytes.size());
+        }
+        else
+        {
+            rawHr = OpenImageRegionSource(fileBytes, rawSource, rawMips);
+            if (rawHr == S_OK)
             {
-                std::unique_ptr<CachedImage> created(new (std::nothrow) CachedImage{});
+                rawW = rawSource->width;
+                rawH = rawSource->height;
+            }
+            else
+            {
+                rawHr = DecodeImageToBgraWic(fileBytes.data(), fileBytes.size(), rawW, rawH, rawBgra);
+            }
+        }
+    }
+    else
+    {
+        LibRawProgressHost host{};
+        host.cancelled = &task.cancelled;
+        rawHr          = DecodeRawFullImageFromBufferToBgra(batch.decodeCfg, fileBytes, rawW, rawH, rawBgra, rawStatus, rawExif, &host);
+    }
 
-                std::scoped_lock lock(_cacheMutex);
-                auto& entry = _imageCache[path];
-                if (! entry)
-                {
-                    entry = std::move(created);
-                }
+    const bool hasRaw = SUCCEEDED(rawHr) && rawW != 0 && rawH != 0 && (! rawBgra.empty() || rawSource);
+    if (hasRaw && ! rawSource && ! task.cancelled.load(std::memory_order_acquire))
+    {
+        BuildImageMipChain(rawW, rawH, rawBgra, rawMips);
+    }
 
-                if (entry)
-                {
-                    entry->thumbAvailable = entry->thumbAvailable || thumbAvailable;
+    if (task.cancelled.load(std::memory_order_acquire))
+    {
+        return;
+    }
 
-                    if (thumbDecoded && thumbW != 0 && thumbH != 0 && ! thumbBgra.empty())
-                    {
-                        entry->thumbWidth       = thumbW;
-                        entry->thumbHeight      = thumbH;
-                        entry->thumbOrientation = NormalizeExifOrientation(thumbExif.orientation);
-                        entry->thumbBgra        = std::move(thumbBgra);
-                        entry->thumbDecoded     = true;
-                        entry->thumbSource      = thumbSource;
-                    }
+    std::unique_ptr<CachedImage> created(new (std::nothrow) CachedImage{});
 
-                    if (SUCCEEDED(rawHr) && rawW != 0 && rawH != 0 && ! rawBgra.empty())
-                    {
-                        entry->rawWidth       = rawW;
-                        entry->rawHeight      = rawH;
-                        entry->rawOrientation = NormalizeExifOrientation(rawExif.orientation);
-                        entry->rawBgra        = std::move(rawBgra);
-                    }
+    std::scoped_lock lock(_cacheMutex);
+    if (batch.cacheEpoch != _cacheEpoch)
+    {
+        return;
+    }
 
-                    if (rawExif.valid)
-                    {
-                        entry->exif.camera         = rawExif.camera;
-                        entry->exif.lens           = rawExif.lens;
-                        entry->exif.dateTime       = rawExif.dateTime;
-                        entry->exif.iso            = rawExif.iso;
-                        entry->exif.shutterSeconds = rawExif.shutterSeconds;
-                        entry->exif.aperture       = rawExif.aperture;
-                        entry->exif.focalLengthMm  = rawExif.focalLengthMm;
-                        entry->exif.valid          = true;
-                    }
-                    else if (! entry->exif.valid && thumbExif.valid)
-                    {
-                        entry->exif.camera         = thumbExif.camera;
-                        entry->exif.lens           = thumbExif.lens;
-                        entry->exif.dateTime       = thumbExif.dateTime;
-                        entry->exif.iso            = thumbExif.iso;
-                        entry->exif.shutterSeconds = thumbExif.shutterSeconds;
-                        entry->exif.aperture       = thumbExif.aperture;
-                        entry->exif.focalLengthMm  = thumbExif.focalLengthMm;
-                        entry->exif.valid          = true;
-                    }
-                }
-            }
+    auto& entry = _imageCache[path];
+    if (! entry)
+    {
+        entry = std::move(created);
+    }
 
-            std::scoped_lock lock(_cacheMutex);
-            _inflightDecodes.erase(path);
-        }
-    };
+    if (! entry)
+    {
+        return;
+    }
 
-    const BOOL queued = TrySubmitThreadpoolCallback(
-        [](PTP_CALLBACK_INSTANCE /*instance*/, void* context) noexcept
-        {
-            std::unique_ptr<PrefetchWorkItem> ctx(static_cast<PrefetchWorkItem*>(context));
-            if (! ctx)
-            {
-                return;
-            }
+    entry->thumbAvailable = entry->thumbAvailable || thumbAvailable;
 
-            static_cast<void>(ctx->moduleKeepAlive);
-            if (ctx->work)
-            {
-                ctx->work();
-            }
-        },
-        ctx.get(),
-        nullptr);
+    if (thumbDecoded && thumbW != 0 && thumbH != 0 && ! thumbBgra.empty() && ! entry->thumbDecoded)
+    {
+        entry->thumbWidth       = thumbW;
+        entry->thumbHeight      = thumbH;
+        entry->thumbOrientation = NormalizeExifOrientation(thumbExif.orientation);
+        entry->thumbBgra        = std::move(thumbBgra);
+        entry->thumbDecoded     = true;
+        entry->thumbSource      = thumbSource;
+    }
 
-    if (queued == 0)
+    if (hasRaw && ! HasRawFrame(*entry))
     {
-        Debug::Error(L"ViewerImgRaw: Failed to queue neighbor prefetch work item.");
+        entry->rawWidth       = rawW;
+        entry->rawHeight      = rawH;
+        entry->rawOrientation = NormalizeExifOrientation(rawExif.orientation);
+        entry->rawBgra        = std::move(rawBgra);
+        entry->rawMips        = std::move(rawMips);
+        entry->rawSource      = std::move(rawSource);
     }
 
-    ctx.release();
+    if (rawExif.valid)
+    {
+        entry->exif.camera         = rawExif.camera;
+        entry->exif.lens           = rawExif.lens;
+        entry->exif.dateTime       = rawExif.dateTime;
+        entry->exif.iso            = rawExif.iso;
+        entry->exif.shutterSeconds = rawExif.shutterSeconds;
+        entry->exif.aperture       = rawExif.aperture;
+        entry->exif.focalLengthMm  = rawExif.focalLengthMm;
+        entry->exif.valid          = true;
+    }
+    else if (! entry->exif.valid && thumbExif.valid)
+    {
+        entry->exif.camera         = thumbExif.camera;
+        entry->exif.lens           = thumbExif.lens;
+        entry->exif.dateTime       = thumbExif.dateTime;
+        entry->exif.iso            = thumbExif.iso;
+        entry->exif.shutterSeconds = thumbExif.shutterSeconds;
+        entry->exif.aperture       = thumbExif.aperture;
+        entry->exif.focalLengthMm  = thumbExif.focalLengthMm;
+        entry->exif.valid          = true;
+    }
 }
 
 void ViewerImgRaw::StartAsyncOpen(HWND hwnd, std::wstring_view path, bool updateOtherFiles) noexcept
@@ -2239,7 +3162,7 @@ void ViewerImgRaw::StartAsyncOpen(HWND hwnd, std::wstring_view path, bool update
     EndLoadingUi();
 
     _statusMessage.clear();
-    _imageBitmap.reset();
+    ResetImageBitmaps();
     _currentImageOwned.reset();
     _currentImage = nullptr;
     _currentImageKey.clear();
@@ -2382,6 +3305,12 @@ void ViewerImgRaw::StartAsyncOpen(HWND hwnd, std::wstring_view path, bool update
                     return;
                 }
 
+                if (SUCCEEDED(result->hr) && result->isFinal && result->frameMode == DisplayMode::Raw && ! result->rawSource &&
+                    requestId == _openRequestId.load(std::memory_order_acquire))
+                {
+                    BuildImageMipChain(result->width, result->height, result->bgra, result->mips);
+                }
+
                 static_cast<void>(PostMessagePayload(hwnd, kAsyncOpenCompleteMessage, 0, std::move(result)));
             });
 
@@ -2615,6 +3544,24 @@ void ViewerImgRaw::StartAsyncOpen(HWND hwnd, std::wstring_view path, bool update
                 }
                 else
                 {
+                    // Frames drawn as tiles keep only the encoded bytes and the coarsest level; tiles are decoded as the view needs them.
+                    const HRESULT regionHr = OpenImageRegionSource(fileBytes, result->rawSource, result->mips);
+                    if (regionHr == S_OK)
+                    {
+                        result->exif.orientation = 1;
+                        result->exif.valid       = false;
+
+                        result->hr        = S_OK;
+                        result->frameMode = DisplayMode::Raw;
+                        result->isFinal   = true;
+                        result->width     = result->rawSource->width;
+                        result->height    = result->rawSource->height;
+                        result->statusMessage.clear();
+                        result->thumbAvailable = false;
+                        result->thumbSource    = CachedImage::ThumbSource::None;
+                        return;
+                    }
+
                     uint32_t w = 0;
                     uint32_t h = 0;
                     std::vector<uint8_t> bgra;
@@ -2883,11 +3830,13 @@ void ViewerImgRaw::OnAsyncOpenComplete(std::unique_ptr<AsyncOpenResult> result)
             else
             {
                 image->rawOrientation = NormalizeExifOrientation(result->exif.orientation);
-                if (result->width != 0 && result->height != 0 && ! result->bgra.empty())
+                if (result->width != 0 && result->height != 0 && (! result->bgra.empty() || result->rawSource))
                 {
                     image->rawWidth  = result->width;
                     image->rawHeight = result->height;
                     image->rawBgra   = std::move(result->bgra);
+                    image->rawMips   = std::move(result->mips);
+                    image->rawSource = std::move(result->rawSource);
                 }
                 _displayedMode = DisplayMode::Raw;
             }
@@ -2905,7 +3854,7 @@ void ViewerImgRaw::OnAsyncOpenComplete(std::unique_ptr<AsyncOpenResult> result)
             _currentImageKey = result->path;
 
             _statusMessage.clear();
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateOrientationState();
             RebuildExifOverlayText();
 
@@ -2931,7 +3880,7 @@ void ViewerImgRaw::OnAsyncOpenComplete(std::unique_ptr<AsyncOpenResult> result)
             _currentImage = nullptr;
             _currentImageKey.clear();
         }
-        _imageBitmap.reset();
+        ResetImageBitmaps();
         _statusMessage =
             keepImage ? L"" : (result->statusMessage.empty() ? LoadStringResource(g_hInstance, IDS_VIEWERRAW_STATUS_ERROR) : result->statusMessage);
 
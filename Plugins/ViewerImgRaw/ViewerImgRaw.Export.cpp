@@ -603,7 +603,10 @@ void ViewerImgRaw::BeginExport(HWND hwnd)
     const uint32_t h                 = exportingThumb ? image->thumbHeight : image->rawHeight;
     const std::vector<uint8_t>& bgra = exportingThumb ? image->thumbBgra : image->rawBgra;
 
-    if (w == 0 || h == 0 || bgra.empty())
+    // Region-decoded frames have no resident pixels; the worker decodes the whole frame for the encoder.
+    const std::shared_ptr<const ImageRegionSource> regionSource = exportingThumb ? nullptr : image->rawSource;
+
+    if (w == 0 || h == 0 || (bgra.empty() && ! regionSource))
     {
         if (_hostAlerts)
         {
@@ -717,7 +720,15 @@ void ViewerImgRaw::BeginExport(HWND hwnd)
     auto ctx = std::unique_ptr<AsyncExportWorkItem>(new (std::nothrow) AsyncExportWorkItem{});
 
     ctx->moduleKeepAlive = AcquireModuleReferenceFromAddress(&kViewerImgRawModuleAnchor);
-    ctx->work            = [this, hwnd, exportFormat, width = w, height = h, encoderOptions, output = std::move(output), pixels = std::move(pixels)]() mutable
+    ctx->work            = [this,
+                 hwnd,
+                 exportFormat,
+                 width  = w,
+                 height = h,
+                 encoderOptions,
+                 output = std::move(output),
+                 pixels = std::move(pixels),
+                 regionSource]() mutable
     {
         auto releaseSelf = wil::scope_exit([&] { Release(); });
 
@@ -748,7 +759,16 @@ void ViewerImgRaw::BeginExport(HWND hwnd)
         }
         else
         {
-            result->hr = EncodeBgraToImageFileWic(output, exportFormat, width, height, pixels, encoderOptions, result->statusMessage);
+            result->hr = regionSource ? DecodeImageRegionFrame(*regionSource, pixels) : S_OK;
+            if (FAILED(result->hr))
+            {
+                result->statusMessage =
+                    std::format(L"ViewerImgRaw: Failed to decode the image for export (hr=0x{:08X}).", static_cast<unsigned long>(result->hr));
+            }
+            else
+            {
+                result->hr = EncodeBgraToImageFileWic(output, exportFormat, width, height, pixels, encoderOptions, result->statusMessage);
+            }
         }
 
         if (! hwnd || GetWindowLongPtrW(hwnd, GWLP_USERDATA) != reinterpret_cast<LONG_PTR>(this))
@@ -0,0 +1,974 @@
+#include "ViewerImgRaw.h"
+
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include <d2d1.h>
+#include <d2d1helper.h>
+#include <objbase.h>
+#include <wincodec.h>
+
+#include "Helpers.h"
+
+namespace
+{
+static const int kViewerImgRawModuleAnchor = 0;
+
+constexpr uint32_t kTiledImageMinDimension  = 4096u; // Larger frames get a mip chain and are drawn as tiles (also avoids max bitmap size limits)
+constexpr uint32_t kImageMipMinDimension    = 512u;  // The chain stops at the first level that fits in this size (drawn whole as the base)
+constexpr uint32_t kImageTileSize           = 512u;  // Tile payload in pixels; bitmaps add a 1-pixel gutter on each interior side
+constexpr uint32_t kImageMipRowsPerTask     = 64u;
+constexpr size_t kImageTileBudgetBytes      = 256ull * 1024ull * 1024ull;
+constexpr size_t kMaxTileUploadsPerFrame    = 24u; // Keeps a paint responsive while zooming/panning; the rest arrive on the next frames
+constexpr uint32_t kMaxRegionImageDimension = 65535u;                    // Region-decoded frames are not bound by the 16384 px full-decode limit
+constexpr size_t kRegionTileBudgetBytes     = 128ull * 1024ull * 1024ull; // Decoded region tiles kept for re-upload (adjustments, GPU tile eviction)
+constexpr size_t kMaxRegionTilesPerDecode   = 16u;                        // One decode job; the repaint it triggers queues the next visible tiles
+
+uint64_t MakeImageTileKey(uint32_t level, uint32_t tileX, uint32_t tileY) noexcept
+{
+    return (static_cast<uint64_t>(level) << 48u) | (static_cast<uint64_t>(tileY) << 24u) | static_cast<uint64_t>(tileX);
+}
+
+struct TileBounds final
+{
+    uint32_t left   = 0;
+    uint32_t top    = 0;
+    uint32_t right  = 0;
+    uint32_t bottom = 0;
+};
+
+// Pixels of a tile in its level, including the gutter that duplicates neighbouring pixels so linear filtering at tile edges
+// matches an unsplit bitmap.
+TileBounds ComputeTileBounds(uint32_t levelW, uint32_t levelH, uint32_t tileX, uint32_t tileY) noexcept
+{
+    const uint32_t payloadLeft = tileX * kImageTileSize;
+    const uint32_t payloadTop  = tileY * kImageTileSize;
+
+    TileBounds bounds{};
+    bounds.left   = payloadLeft > 0 ? payloadLeft - 1u : 0u;
+    bounds.top    = payloadTop > 0 ? payloadTop - 1u : 0u;
+    bounds.right  = std::min(payloadLeft + kImageTileSize + 1u, levelW);
+    bounds.bottom = std::min(payloadTop + kImageTileSize + 1u, levelH);
+    return bounds;
+}
+
+// Drops the least recently drawn tiles until `bytes` fits `budgetBytes`; tiles drawn in `frame` stay even over budget.
+template <typename Tile, typename BytesOf>
+void TrimTilesToBudget(std::unordered_map<uint64_t, Tile>& tiles, size_t& bytes, size_t budgetBytes, uint64_t frame, BytesOf bytesOf) noexcept
+{
+    if (bytes <= budgetBytes)
+    {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> byAge; // (lastUsedFrame, key)
+    try
+    {
+        byAge.reserve(tiles.size());
+    }
+    catch (const std::bad_alloc&)
+    {
+        return;
+    }
+
+    for (const auto& [key, tile] : tiles)
+    {
+        if (tile.lastUsedFrame != frame)
+        {
+            byAge.emplace_back(tile.lastUsedFrame, key);
+        }
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    for (const auto& [lastUsed, key] : byAge)
+    {
+        if (bytes <= budgetBytes)
+        {
+            break;
+        }
+
+        const auto it = tiles.find(key);
+        if (it == tiles.end())
+        {
+            continue;
+        }
+
+        bytes -= std::min(bytes, bytesOf(it->second));
+        tiles.erase(it);
+    }
+}
+
+HRESULT CreateWicFactory(wil::com_ptr<IWICImagingFactory>& outFactory) noexcept
+{
+    outFactory.reset();
+    HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory2, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(outFactory.addressof()));
+    if (FAILED(hr))
+    {
+        hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(outFactory.addressof()));
+    }
+    if (FAILED(hr) || ! outFactory)
+    {
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+    return S_OK;
+}
+
+// Frame 0 of an encoded image as a 32bpp BGRA source. Nothing is decoded until CopyPixels; `fileBytes` must outlive the source.
+HRESULT OpenBgraFrameSource(
+    IWICImagingFactory* factory, const std::vector<uint8_t>& fileBytes, wil::com_ptr<IWICBitmapSource>& outSource, UINT& outWidth, UINT& outHeight) noexcept
+{
+    outSource.reset();
+    outWidth  = 0;
+    outHeight = 0;
+
+    if (fileBytes.empty() || fileBytes.size() > static_cast<size_t>(std::numeric_limits<DWORD>::max()))
+    {
+        return E_INVALIDARG;
+    }
+
+    wil::com_ptr<IWICStream> stream;
+    HRESULT hr = factory->CreateStream(stream.addressof());
+    if (FAILED(hr) || ! stream)
+    {
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+
+    hr = stream->InitializeFromMemory(const_cast<BYTE*>(fileBytes.data()), static_cast<DWORD>(fileBytes.size()));
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    wil::com_ptr<IWICBitmapDecoder> decoder;
+    hr = factory->CreateDecoderFromStream(stream.get(), nullptr, WICDecodeMetadataCacheOnDemand, decoder.addressof());
+    if (FAILED(hr) || ! decoder)
+    {
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+
+    wil::com_ptr<IWICBitmapFrameDecode> frame;
+    hr = decoder->GetFrame(0, frame.addressof());
+    if (FAILED(hr) || ! frame)
+    {
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+
+    hr = frame->GetSize(&outWidth, &outHeight);
+    if (FAILED(hr) || outWidth == 0 || outHeight == 0)
+    {
+        return FAILED(hr) ? hr : HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    wil::com_ptr<IWICFormatConverter> converter;
+    hr = factory->CreateFormatConverter(converter.addressof());
+    if (FAILED(hr) || ! converter)
+    {
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+
+    hr = converter->Initialize(frame.get(), GUID_WICPixelFormat32bppBGRA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    outSource = std::move(converter);
+    return S_OK;
+}
+
+// `frame` at a mip level's size. The scaler only reads the source rows a CopyPixels rectangle needs, so a tile of a coarse
+// level never holds more than a band of the full-resolution frame.
+HRESULT CreateLevelSource(IWICImagingFactory* factory,
+                          IWICBitmapSource* frame,
+                          UINT frameW,
+                          UINT frameH,
+                          uint32_t levelW,
+                          uint32_t levelH,
+                          wil::com_ptr<IWICBitmapSource>& outSource) noexcept
+{
+    outSource.reset();
+    if (levelW == frameW && levelH == frameH)
+    {
+        outSource = frame;
+        return S_OK;
+    }
+
+    wil::com_ptr<IWICBitmapScaler> scaler;
+    HRESULT hr = factory->CreateBitmapScaler(scaler.addressof());
+    if (FAILED(hr) || ! scaler)
+    {
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+
+    hr = scaler->Initialize(frame, levelW, levelH, WICBitmapInterpolationModeFant);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    outSource = std::move(scaler);
+    return S_OK;
+}
+} // namespace
+
+void ViewerImgRaw::BuildImageMipChain(uint32_t width, uint32_t height, const std::vector<uint8_t>& bgra, std::vector<ImageMipLevel>& outLevels) noexcept
+{
+    outLevels.clear();
+
+    if (width == 0 || height == 0 || std::max(width, height) <= kTiledImageMinDimension)
+    {
+        return;
+    }
+    if (bgra.size() < static_cast<size_t>(width) * static_cast<size_t>(height) * 4u)
+    {
+        return;
+    }
+
+    try
+    {
+        // Level 0 is the decoded frame itself; each further level halves the previous one until it fits kImageMipMinDimension.
+        const uint8_t* srcPixels = bgra.data();
+        uint32_t srcW            = width;
+        uint32_t srcH            = height;
+        while (std::max(srcW, srcH) > kImageMipMinDimension)
+        {
+            ImageMipLevel level;
+            level.width  = (srcW + 1u) / 2u;
+            level.height = (srcH + 1u) / 2u;
+            level.bgra.resize(static_cast<size_t>(level.width) * static_cast<size_t>(level.height) * 4u);
+
+            // Row bands are independent; large frames spend most of the time in the first (full-resolution) pass.
+            PixelKernels::ForEachRowBand(level.height,
+                                         kImageMipRowsPerTask,
+                                         [&](uint32_t rowBegin, uint32_t rowEnd) noexcept
+                                         { PixelKernels::DownsampleBgraBox2x2Rows(srcPixels, srcW, srcH, level.bgra.data(), rowBegin, rowEnd); });
+
+            outLevels.push_back(std::move(level));
+            srcPixels = outLevels.back().bgra.data();
+            srcW      = outLevels.back().width;
+            srcH      = outLevels.back().height;
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        // Without a mip chain the frame falls back to a single bitmap (which may fail to upload for huge frames).
+        outLevels.clear();
+        Debug::Warning(L"ViewerImgRaw: Out of memory building mip chain for {}x{} image", width, height);
+    }
+}
+
+HRESULT ViewerImgRaw::OpenImageRegionSource(std::vector<uint8_t>& fileBytes,
+                                            std::shared_ptr<const ImageRegionSource>& outSource,
+                                            std::vector<ImageMipLevel>& outLevels) noexcept
+{
+    outSource.reset();
+    outLevels.clear();
+
+    wil::com_ptr<IWICImagingFactory> factory;
+    HRESULT hr = CreateWicFactory(factory);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    wil::com_ptr<IWICBitmapSource> frame;
+    UINT width  = 0;
+    UINT height = 0;
+    hr          = OpenBgraFrameSource(factory.get(), fileBytes, frame, width, height);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    // Frames that are not drawn as tiles are decoded whole by the caller.
+    if (std::max(width, height) <= kTiledImageMinDimension)
+    {
+        return S_FALSE;
+    }
+    if (width > kMaxRegionImageDimension || height > kMaxRegionImageDimension)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    try
+    {
+        // Same level sizes as BuildImageMipChain; only the coarsest level is decoded here, the others per tile.
+        uint32_t levelW = width;
+        uint32_t levelH = height;
+        while (std::max(levelW, levelH) > kImageMipMinDimension)
+        {
+            levelW = (levelW + 1u) / 2u;
+            levelH = (levelH + 1u) / 2u;
+
+            ImageMipLevel level;
+            level.width  = levelW;
+            level.height = levelH;
+            outLevels.push_back(std::move(level));
+        }
+
+        ImageMipLevel& base = outLevels.back();
+        base.bgra.resize(static_cast<size_t>(base.width) * static_cast<size_t>(base.height) * 4u);
+
+        wil::com_ptr<IWICBitmapSource> baseSource;
+        hr = CreateLevelSource(factory.get(), frame.get(), width, height, base.width, base.height, baseSource);
+        if (SUCCEEDED(hr))
+        {
+            hr = baseSource->CopyPixels(nullptr, base.width * 4u, static_cast<UINT>(base.bgra.size()), base.bgra.data());
+        }
+        if (FAILED(hr))
+        {
+            outLevels.clear();
+            return hr;
+        }
+
+        auto source    = std::make_shared<ImageRegionSource>();
+        source->width  = width;
+        source->height = height;
+        // The WIC stream points into the vector's buffer, which the move keeps in place.
+        source->fileBytes = std::move(fileBytes);
+        outSource         = std::move(source);
+    }
+    catch (const std::bad_alloc&)
+    {
+        outLevels.clear();
+        return E_OUTOFMEMORY;
+    }
+
+    return S_OK;
+}
+
+HRESULT ViewerImgRaw::DecodeImageRegionTiles(const ImageRegionSource& source, std::vector<RegionTile>& tiles) noexcept
+{
+    wil::com_ptr<IWICImagingFactory> factory;
+    HRESULT hr = CreateWicFactory(factory);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    wil::com_ptr<IWICBitmapSource> frame;
+    UINT width  = 0;
+    UINT height = 0;
+    hr          = OpenBgraFrameSource(factory.get(), source.fileBytes, frame, width, height);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    if (width != source.width || height != source.height)
+    {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    // The tiles of one row of one level are read as a single band, top to bottom, so decoders that only read forward (PNG,
+    // BMP, strip TIFF) are not restarted for every tile.
+    std::sort(tiles.begin(),
+              tiles.end(),
+              [](const RegionTile& a, const RegionTile& b) noexcept
+              {
+                  if (a.level != b.level)
+                  {
+                      return a.level < b.level;
+                  }
+                  return a.tileY != b.tileY ? a.tileY < b.tileY : a.tileX < b.tileX;
+              });
+
+    try
+    {
+        std::vector<uint8_t> band;
+        wil::com_ptr<IWICBitmapSource> levelSource;
+        uint32_t sourceLevel = std::numeric_limits<uint32_t>::max();
+        for (size_t first = 0; first < tiles.size();)
+        {
+            const RegionTile& head = tiles[first];
+            size_t last            = first + 1u;
+            while (last < tiles.size() && tiles[last].level == head.level && tiles[last].tileY == head.tileY)
+            {
+                ++last;
+            }
+
+            if (head.level != sourceLevel)
+            {
+                hr = CreateLevelSource(factory.get(), frame.get(), width, height, head.levelWidth, head.levelHeight, levelSource);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+                sourceLevel = head.level;
+            }
+
+            const TileBounds firstBounds = ComputeTileBounds(head.levelWidth, head.levelHeight, head.tileX, head.tileY);
+            const TileBounds lastBounds  = ComputeTileBounds(head.levelWidth, head.levelHeight, tiles[last - 1u].tileX, head.tileY);
+            if (firstBounds.right <= firstBounds.left || firstBounds.bottom <= firstBounds.top || lastBounds.right <= firstBounds.left)
+            {
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            }
+
+            const uint32_t bandW    = lastBounds.right - firstBounds.left;
+            const uint32_t bandH    = firstBounds.bottom - firstBounds.top;
+            const size_t bandStride = static_cast<size_t>(bandW) * 4u;
+            band.resize(bandStride * bandH);
+
+            const WICRect rect{static_cast<INT>(firstBounds.left), static_cast<INT>(firstBounds.top), static_cast<INT>(bandW), static_cast<INT>(bandH)};
+            hr = levelSource->CopyPixels(&rect, static_cast<UINT>(bandStride), static_cast<UINT>(band.size()), band.data());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            for (size_t i = first; i < last; ++i)
+            {
+                RegionTile& tile          = tiles[i];
+                const TileBounds bounds   = ComputeTileBounds(tile.levelWidth, tile.levelHeight, tile.tileX, tile.tileY);
+                tile.width                = bounds.right - bounds.left;
+                tile.height               = bounds.bottom - bounds.top;
+                const size_t tileStride   = static_cast<size_t>(tile.width) * 4u;
+                const uint8_t* bandPixels = band.data() + static_cast<size_t>(bounds.left - firstBounds.left) * 4u;
+                tile.bgra.resize(tileStride * tile.height);
+                for (uint32_t row = 0; row < tile.height; ++row)
+                {
+                    std::memcpy(tile.bgra.data() + row * tileStride, bandPixels + row * bandStride, tileStride);
+                }
+            }
+
+            first = last;
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    return S_OK;
+}
+
+HRESULT ViewerImgRaw::DecodeImageRegionFrame(const ImageRegionSource& source, std::vector<uint8_t>& outBgra) noexcept
+{
+    outBgra.clear();
+
+    const uint64_t bytes = static_cast<uint64_t>(source.width) * static_cast<uint64_t>(source.height) * 4ull;
+    if (bytes == 0 || bytes > static_cast<uint64_t>(std::numeric_limits<UINT>::max()))
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    wil::com_ptr<IWICImagingFactory> factory;
+    HRESULT hr = CreateWicFactory(factory);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    wil::com_ptr<IWICBitmapSource> frame;
+    UINT width  = 0;
+    UINT height = 0;
+    hr          = OpenBgraFrameSource(factory.get(), source.fileBytes, frame, width, height);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    if (width != source.width || height != source.height)
+    {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    try
+    {
+        outBgra.resize(static_cast<size_t>(bytes));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    hr = frame->CopyPixels(nullptr, width * 4u, static_cast<UINT>(bytes), outBgra.data());
+    if (FAILED(hr))
+    {
+        outBgra.clear();
+    }
+    return hr;
+}
+
+bool ViewerImgRaw::HasRawFrame(const CachedImage& image) noexcept
+{
+    return image.rawWidth != 0 && image.rawHeight != 0 && (! image.rawBgra.empty() || image.rawSource);
+}
+
+void ViewerImgRaw::ResetImageBitmaps() noexcept
+{
+    _imageBitmap.reset();
+    _imageTiles.clear();
+    _imageTileBase.reset();
+    _imageTileBytes = 0;
+    SyncRegionTiles();
+}
+
+// Decoded region tiles belong to one source; they go once the current image is a different one.
+void ViewerImgRaw::SyncRegionTiles() noexcept
+{
+    const CachedImage* image                               = _currentImage;
+    const std::shared_ptr<const ImageRegionSource> current = image ? image->rawSource : nullptr;
+    if (current && _regionTilesSource.lock() == current)
+    {
+        return;
+    }
+
+    _regionTiles.clear();
+    _regionTileBytes        = 0;
+    _regionTileDecodeFailed = false;
+    _regionTilesSource      = current;
+}
+
+void ViewerImgRaw::StartRegionTileDecode(std::vector<RegionTile> tiles) noexcept
+{
+    const CachedImage* image = _currentImage;
+    const HWND hwnd          = _hWnd.get();
+    if (! image || ! image->rawSource || ! hwnd || tiles.empty() || _regionTileDecodeQueued)
+    {
+        return;
+    }
+
+    struct RegionTileWorkItem final
+    {
+        RegionTileWorkItem()                                     = default;
+        RegionTileWorkItem(const RegionTileWorkItem&)            = delete;
+        RegionTileWorkItem& operator=(const RegionTileWorkItem&) = delete;
+
+        wil::unique_hmodule moduleKeepAlive;
+        std::function<void()> work;
+    };
+
+    auto ctx = std::unique_ptr<RegionTileWorkItem>(new (std::nothrow) RegionTileWorkItem{});
+    if (! ctx)
+    {
+        return;
+    }
+
+    AddRef();
+    ctx->moduleKeepAlive = AcquireModuleReferenceFromAddress(&kViewerImgRawModuleAnchor);
+    ctx->work            = [this, hwnd, source = image->rawSource, tiles = std::move(tiles)]() mutable
+    {
+        auto releaseSelf = wil::scope_exit([&] { Release(); });
+
+        const HRESULT coinitHr  = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        const bool shouldUninit = SUCCEEDED(coinitHr);
+        auto coUninit           = wil::scope_exit(
+            [&]
+            {
+                if (shouldUninit)
+                {
+                    CoUninitialize();
+                }
+            });
+
+        // Posted even when empty: the window clears _regionTileDecodeQueued on receipt.
+        std::unique_ptr<AsyncTileDecodeResult> result(new (std::nothrow) AsyncTileDecodeResult{});
+        if (result)
+        {
+            result->source = source;
+            result->hr     = (FAILED(coinitHr) && coinitHr != RPC_E_CHANGED_MODE) ? coinitHr : DecodeImageRegionTiles(*source, tiles);
+            if (SUCCEEDED(result->hr))
+            {
+                result->tiles = std::move(tiles);
+            }
+        }
+
+        if (! hwnd || GetWindowLongPtrW(hwnd, GWLP_USERDATA) != reinterpret_cast<LONG_PTR>(this))
+        {
+            return;
+        }
+
+        static_cast<void>(PostMessagePayload(hwnd, kAsyncTilesDecodedMessage, 0, std::move(result)));
+    };
+
+    const BOOL queued = TrySubmitThreadpoolCallback(
+        [](PTP_CALLBACK_INSTANCE /*instance*/, void* context) noexcept
+        {
+            std::unique_ptr<RegionTileWorkItem> ctx(static_cast<RegionTileWorkItem*>(context));
+            if (! ctx)
+            {
+                return;
+            }
+
+            static_cast<void>(ctx->moduleKeepAlive);
+            if (ctx->work)
+            {
+                ctx->work();
+            }
+        },
+        ctx.get(),
+        nullptr);
+
+    if (queued == 0)
+    {
+        Debug::Error(L"ViewerImgRaw: Failed to queue region tile decode work item");
+        Release();
+        return;
+    }
+
+    ctx.release();
+    _regionTileDecodeQueued = true;
+}
+
+void ViewerImgRaw::OnAsyncTilesDecoded(std::unique_ptr<AsyncTileDecodeResult> result) noexcept
+{
+    _regionTileDecodeQueued = false;
+    SyncRegionTiles();
+
+    const CachedImage* image = _currentImage;
+    if (! result || ! image || ! image->rawSource || result->source != image->rawSource)
+    {
+        return;
+    }
+
+    if (FAILED(result->hr))
+    {
+        // The coarsest level stays on screen; retrying would only repeat the failure on every repaint.
+        _regionTileDecodeFailed = true;
+        Debug::Warning(L"ViewerImgRaw: Failed to decode image tiles: 0x{:08X}", static_cast<unsigned long>(result->hr));
+        return;
+    }
+
+    for (RegionTile& tile : result->tiles)
+    {
+        const uint64_t key = MakeImageTileKey(tile.level, tile.tileX, tile.tileY);
+        if (tile.bgra.empty() || _regionTiles.contains(key))
+        {
+            continue;
+        }
+
+        tile.lastUsedFrame = _imageTileFrame;
+        const size_t bytes = tile.bgra.size();
+        try
+        {
+            _regionTiles.emplace(key, std::move(tile));
+        }
+        catch (const std::bad_alloc&)
+        {
+            break;
+        }
+        _regionTileBytes += bytes;
+    }
+
+    if (_hWnd)
+    {
+        InvalidateRect(_hWnd.get(), &_contentRect, FALSE);
+    }
+}
+
+bool ViewerImgRaw::UseTiledImage() const noexcept
+{
+    return ! IsDisplayingThumbnail() && _currentImage && ! _currentImage->rawMips.empty();
+}
+
+ID2D1Bitmap* ViewerImgRaw::EnsureImageTile(uint32_t level, uint32_t tileX, uint32_t tileY) noexcept
+{
+    const CachedImage* image = _currentImage;
+    if (! image || ! _d2dTarget || level > image->rawMips.size())
+    {
+        return nullptr;
+    }
+
+    const uint64_t key = MakeImageTileKey(level, tileX, tileY);
+    if (const auto it = _imageTiles.find(key); it != _imageTiles.end())
+    {
+        it->second.lastUsedFrame = _imageTileFrame;
+        return it->second.bitmap.get();
+    }
+
+    const uint32_t levelW                   = level == 0 ? image->rawWidth : image->rawMips[level - 1u].width;
+    const uint32_t levelH                   = level == 0 ? image->rawHeight : image->rawMips[level - 1u].height;
+    const std::vector<uint8_t>& levelPixels = level == 0 ? image->rawBgra : image->rawMips[level - 1u].bgra;
+    if (tileX * kImageTileSize >= levelW || tileY * kImageTileSize >= levelH)
+    {
+        return nullptr;
+    }
+
+    const TileBounds bounds   = ComputeTileBounds(levelW, levelH, tileX, tileY);
+    const uint32_t tileW      = bounds.right - bounds.left;
+    const uint32_t tileH      = bounds.bottom - bounds.top;
+    const uint8_t* uploadData = nullptr;
+    size_t sourceStride       = 0;
+    if (! levelPixels.empty())
+    {
+        sourceStride = static_cast<size_t>(levelW) * 4u;
+        uploadData   = levelPixels.data() + static_cast<size_t>(bounds.top) * sourceStride + static_cast<size_t>(bounds.left) * 4u;
+    }
+    else
+    {
+        // Levels of region-decoded images are not resident; their tiles arrive from the decode worker (see DrawImageTiles).
+        const auto region = _regionTiles.find(key);
+        if (region == _regionTiles.end() || region->second.width != tileW || region->second.height != tileH)
+        {
+            return nullptr;
+        }
+
+        region->second.lastUsedFrame = _imageTileFrame;
+        uploadData                   = region->second.bgra.data();
+        sourceStride                 = static_cast<size_t>(tileW) * 4u;
+    }
+
+    UINT32 uploadStride = static_cast<UINT32>(sourceStride);
+    if (HasImageAdjustments())
+    {
+        const size_t tileStride = static_cast<size_t>(tileW) * 4u;
+        if (_imageTileScratch.size() < tileStride * tileH)
+        {
+            try
+            {
+                _imageTileScratch.resize(tileStride * tileH);
+            }
+            catch (const std::bad_alloc&)
+            {
+                return nullptr;
+            }
+        }
+
+        ApplyImageAdjustments(uploadData, sourceStride, _imageTileScratch.data(), tileStride, tileW, tileH);
+        uploadData   = _imageTileScratch.data();
+        uploadStride = static_cast<UINT32>(tileStride);
+    }
+
+    wil::com_ptr<ID2D1Bitmap> bitmap;
+    const D2D1_BITMAP_PROPERTIES props = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_IGNORE));
+    const HRESULT hr                   = _d2dTarget->CreateBitmap(D2D1::SizeU(tileW, tileH), uploadData, uploadStride, props, bitmap.put());
+    if (FAILED(hr) || ! bitmap)
+    {
+        Debug::Warning(L"ViewerImgRaw: Failed to create image tile (level {}, {}, {}): 0x{:08X}", level, tileX, tileY, static_cast<unsigned long>(hr));
+        return nullptr;
+    }
+
+    try
+    {
+        ImageTile tile;
+        tile.bitmap        = std::move(bitmap);
+        tile.bytes         = static_cast<size_t>(tileW) * static_cast<size_t>(tileH) * 4u;
+        tile.lastUsedFrame = _imageTileFrame;
+
+        const size_t bytes = tile.bytes;
+        auto inserted      = _imageTiles.emplace(key, std::move(tile));
+        _imageTileBytes += bytes;
+        return inserted.first->second.bitmap.get();
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void ViewerImgRaw::TrimImageTiles() noexcept
+{
+    TrimTilesToBudget(_imageTiles, _imageTileBytes, kImageTileBudgetBytes, _imageTileFrame, [](const ImageTile& tile) noexcept { return tile.bytes; });
+    TrimTilesToBudget(
+        _regionTiles, _regionTileBytes, kRegionTileBudgetBytes, _imageTileFrame, [](const RegionTile& tile) noexcept { return tile.bgra.size(); });
+}
+
+bool ViewerImgRaw::DrawImageTiles(const D2D1_MATRIX_3X2_F& transform, float zoom, UINT dpi) noexcept
+{
+    const CachedImage* image = _currentImage;
+    if (! image || ! _d2dTarget || image->rawMips.empty() || image->rawWidth == 0 || image->rawHeight == 0 || dpi == 0)
+    {
+        return false;
+    }
+
+    ++_imageTileFrame;
+    SyncRegionTiles();
+
+    // The paint transform maps image-local DIPs (image pixels * 96 / dpi) to the target; tile bitmaps use 96 DPI so their DIPs are pixels.
+    const float pxToDip         = 96.0f / static_cast<float>(dpi);
+    const uint32_t maxLevel     = static_cast<uint32_t>(image->rawMips.size());
+    const ImageMipLevel& top    = image->rawMips.back();
+    const D2D1_RECT_F imageRect = D2D1::RectF(0.0f, 0.0f, static_cast<float>(image->rawWidth) * pxToDip, static_cast<float>(image->rawHeight) * pxToDip);
+
+    const D2D1_ANTIALIAS_MODE oldAntialias = _d2dTarget->GetAntialiasMode();
+    _d2dTarget->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+    auto restoreAntialias = wil::scope_exit(
+        [&]() noexcept
+        {
+            if (_d2dTarget)
+            {
+                _d2dTarget->SetAntialiasMode(oldAntialias);
+            }
+        });
+
+    // The coarsest level is small enough to draw whole; it covers any tile that is still pending.
+    if (! _imageTileBase)
+    {
+        const UINT32 topStride    = top.width * 4u;
+        const uint8_t* uploadData = top.bgra.data();
+        if (HasImageAdjustments())
+        {
+            try
+            {
+                _imageTileScratch.resize(std::max(_imageTileScratch.size(), top.bgra.size()));
+            }
+            catch (const std::bad_alloc&)
+            {
+                return false;
+            }
+
+            ApplyImageAdjustments(top.bgra.data(), topStride, _imageTileScratch.data(), topStride, top.width, top.height);
+            uploadData = _imageTileScratch.data();
+        }
+
+        const D2D1_BITMAP_PROPERTIES props = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_IGNORE));
+        const HRESULT hr                   = _d2dTarget->CreateBitmap(D2D1::SizeU(top.width, top.height), uploadData, topStride, props, _imageTileBase.put());
+        if (FAILED(hr))
+        {
+            _imageTileBase.reset();
+            return false;
+        }
+    }
+
+    _d2dTarget->DrawBitmap(_imageTileBase.get(), imageRect, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+
+    // One source pixel of level L spans 2^L screen pixels at zoom 1; pick the finest level that is not magnified below 1:1.
+    uint32_t level = 0;
+    if (zoom > 0.0f && zoom < 1.0f)
+    {
+        level = static_cast<uint32_t>(std::clamp(std::floor(std::log2(1.0f / zoom)), 0.0f, static_cast<float>(maxLevel)));
+    }
+    if (level == maxLevel)
+    {
+        TrimImageTiles();
+        return true;
+    }
+
+    // Visible part of the content area in image-local DIPs.
+    D2D1::Matrix3x2F inverse = *D2D1::Matrix3x2F::ReinterpretBaseType(&transform);
+    if (! inverse.Invert())
+    {
+        return true;
+    }
+
+    const D2D1_RECT_F contentDip = D2D1::RectF(static_cast<float>(_contentRect.left) * pxToDip,
+                                               static_cast<float>(_contentRect.top) * pxToDip,
+                                               static_cast<float>(_contentRect.right) * pxToDip,
+                                               static_cast<float>(_contentRect.bottom) * pxToDip);
+    const std::array<D2D1_POINT_2F, 4> corners = {inverse.TransformPoint(D2D1::Point2F(contentDip.left, contentDip.top)),
+                                                  inverse.TransformPoint(D2D1::Point2F(contentDip.right, contentDip.top)),
+                                                  inverse.TransformPoint(D2D1::Point2F(contentDip.left, contentDip.bottom)),
+                                                  inverse.TransformPoint(D2D1::Point2F(contentDip.right, contentDip.bottom))};
+
+    float minX = corners[0].x;
+    float minY = corners[0].y;
+    float maxX = corners[0].x;
+    float maxY = corners[0].y;
+    for (const D2D1_POINT_2F& corner : corners)
+    {
+        minX = std::min(minX, corner.x);
+        minY = std::min(minY, corner.y);
+        maxX = std::max(maxX, corner.x);
+        maxY = std::max(maxY, corner.y);
+    }
+
+    const uint32_t levelW    = level == 0 ? image->rawWidth : image->rawMips[level - 1u].width;
+    const uint32_t levelH    = level == 0 ? image->rawHeight : image->rawMips[level - 1u].height;
+    const bool levelResident = level == 0 ? ! image->rawBgra.empty() : ! image->rawMips[level - 1u].bgra.empty();
+    const float dipToLevelX  = static_cast<float>(levelW) / (static_cast<float>(image->rawWidth) * pxToDip);
+    const float dipToLevelY  = static_cast<float>(levelH) / (static_cast<float>(image->rawHeight) * pxToDip);
+    const uint32_t tilesX    = (levelW + kImageTileSize - 1u) / kImageTileSize;
+    const uint32_t tilesY    = (levelH + kImageTileSize - 1u) / kImageTileSize;
+    const auto tileIndex     = [](float levelPx, uint32_t count) noexcept
+    {
+        const float index = std::floor(levelPx / static_cast<float>(kImageTileSize));
+        return static_cast<uint32_t>(std::clamp(index, 0.0f, static_cast<float>(count - 1u)));
+    };
+    const uint32_t firstTileX = tileIndex(minX * dipToLevelX, tilesX);
+    const uint32_t lastTileX  = tileIndex(maxX * dipToLevelX, tilesX);
+    const uint32_t firstTileY = tileIndex(minY * dipToLevelY, tilesY);
+    const uint32_t lastTileY  = tileIndex(maxY * dipToLevelY, tilesY);
+
+    size_t uploads  = 0;
+    bool hasPending = false;
+    std::vector<RegionTile> regionRequests;
+    bool canRequestRegion = ! levelResident && ! _regionTileDecodeQueued && ! _regionTileDecodeFailed;
+    if (canRequestRegion)
+    {
+        try
+        {
+            regionRequests.reserve(kMaxRegionTilesPerDecode);
+        }
+        catch (const std::bad_alloc&)
+        {
+            canRequestRegion = false;
+        }
+    }
+
+    for (uint32_t tileY = firstTileY; tileY <= lastTileY; ++tileY)
+    {
+        for (uint32_t tileX = firstTileX; tileX <= lastTileX; ++tileX)
+        {
+            const uint64_t key = MakeImageTileKey(level, tileX, tileY);
+            const bool cached  = _imageTiles.contains(key);
+            if (! cached && ! levelResident && ! _regionTiles.contains(key))
+            {
+                // Not decoded yet: the coarsest level shows through until the worker's result repaints the view.
+                if (canRequestRegion && regionRequests.size() < kMaxRegionTilesPerDecode)
+                {
+                    RegionTile& request = regionRequests.emplace_back();
+                    request.level       = level;
+                    request.tileX       = tileX;
+                    request.tileY       = tileY;
+                    request.levelWidth  = levelW;
+                    request.levelHeight = levelH;
+                }
+                continue;
+            }
+
+            if (! cached && uploads >= kMaxTileUploadsPerFrame)
+            {
+                hasPending = true;
+                continue;
+            }
+
+            ID2D1Bitmap* bitmap = EnsureImageTile(level, tileX, tileY);
+            if (! cached)
+            {
+                ++uploads;
+            }
+            if (! bitmap)
+            {
+                continue;
+            }
+
+            const uint32_t payloadLeft   = tileX * kImageTileSize;
+            const uint32_t payloadTop    = tileY * kImageTileSize;
+            const uint32_t payloadRight  = std::min(payloadLeft + kImageTileSize, levelW);
+            const uint32_t payloadBottom = std::min(payloadTop + kImageTileSize, levelH);
+            const float gutterX          = payloadLeft > 0 ? 1.0f : 0.0f;
+            const float gutterY          = payloadTop > 0 ? 1.0f : 0.0f;
+
+            const D2D1_RECT_F source = D2D1::RectF(gutterX,
+                                                   gutterY,
+                                                   gutterX + static_cast<float>(payloadRight - payloadLeft),
+                                                   gutterY + static_cast<float>(payloadBottom - payloadTop));
+            const D2D1_RECT_F dest   = D2D1::RectF(static_cast<float>(payloadLeft) / dipToLevelX,
+                                                 static_cast<float>(payloadTop) / dipToLevelY,
+                                                 static_cast<float>(payloadRight) / dipToLevelX,
+                                                 static_cast<float>(payloadBottom) / dipToLevelY);
+            _d2dTarget->DrawBitmap(bitmap, dest, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, source);
+        }
+    }
+
+    TrimImageTiles();
+
+    if (! regionRequests.empty())
+    {
+        StartRegionTileDecode(std::move(regionRequests));
+    }
+
+    if (hasPending && _hWnd)
+    {
+        InvalidateRect(_hWnd.get(), &_contentRect, FALSE);
+    }
+
+    return true;
+}
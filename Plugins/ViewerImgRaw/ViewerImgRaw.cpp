@@ -575,6 +575,13 @@ HRESULT STDMETHODCALLTYPE ViewerImgRaw::QueryInterface(REFIID riid, void** ppvOb
         return S_OK;
     }
 
+    if (riid == __uuidof(IViewerThumbnail))
+    {
+        *ppvObject = static_cast<IViewerThumbnail*>(this);
+        AddRef();
+        return S_OK;
+    }
+
     return E_NOINTERFACE;
 }
 
@@ -896,6 +903,12 @@ LRESULT ViewerImgRaw::WndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) noexcep
             OnAsyncExportComplete(std::move(result));
             return 0;
         }
+        case kAsyncTilesDecodedMessage:
+        {
+            auto result = TakeMessagePayload<AsyncTileDecodeResult>(lp);
+            OnAsyncTilesDecoded(std::move(result));
+            return 0;
+        }
         case WM_CLOSE: DestroyWindow(hwnd); return 0;
         case WM_NCACTIVATE:
         {
@@ -946,7 +959,7 @@ LRESULT ViewerImgRaw::OnMouseWheel(HWND hwnd, short delta, UINT keyState, int x,
                 _brightness = std::clamp(_brightness + static_cast<float>(detents) * 0.05f, -1.0f, 1.0f);
             }
 
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
         }
@@ -2585,6 +2598,7 @@ void ViewerImgRaw::OnCommand(HWND hwnd, UINT id, UINT code, HWND control)
             const size_t index = static_cast<size_t>(sel);
             if (index < _otherItems.size())
             {
+                _navDirection           = index < _otherIndex ? -1 : 1;
                 _otherIndex             = index;
                 _currentSidecarJpegPath = _otherItems[_otherIndex].sidecarJpegPath;
                 _currentLabel           = _otherItems[_otherIndex].label;
@@ -2607,7 +2621,8 @@ void ViewerImgRaw::OnCommand(HWND hwnd, UINT id, UINT code, HWND control)
         case IDM_VIEWERRAW_OTHER_NEXT:
             if (_otherItems.size() > 1)
             {
-                _otherIndex = (_otherIndex + 1) % _otherItems.size();
+                _otherIndex   = (_otherIndex + 1) % _otherItems.size();
+                _navDirection = 1;
                 SyncFileComboSelection();
                 _currentSidecarJpegPath = _otherItems[_otherIndex].sidecarJpegPath;
                 _currentLabel           = _otherItems[_otherIndex].label;
@@ -2617,7 +2632,8 @@ void ViewerImgRaw::OnCommand(HWND hwnd, UINT id, UINT code, HWND control)
         case IDM_VIEWERRAW_OTHER_PREVIOUS:
             if (_otherItems.size() > 1)
             {
-                _otherIndex = (_otherIndex + _otherItems.size() - 1) % _otherItems.size();
+                _otherIndex   = (_otherIndex + _otherItems.size() - 1) % _otherItems.size();
+                _navDirection = -1;
                 SyncFileComboSelection();
                 _currentSidecarJpegPath = _otherItems[_otherIndex].sidecarJpegPath;
                 _currentLabel           = _otherItems[_otherIndex].label;
@@ -2627,7 +2643,8 @@ void ViewerImgRaw::OnCommand(HWND hwnd, UINT id, UINT code, HWND control)
         case IDM_VIEWERRAW_OTHER_FIRST:
             if (_otherItems.size() > 1)
             {
-                _otherIndex = 0;
+                _otherIndex   = 0;
+                _navDirection = 1;
                 SyncFileComboSelection();
                 _currentSidecarJpegPath = _otherItems[_otherIndex].sidecarJpegPath;
                 _currentLabel           = _otherItems[_otherIndex].label;
@@ -2637,7 +2654,8 @@ void ViewerImgRaw::OnCommand(HWND hwnd, UINT id, UINT code, HWND control)
         case IDM_VIEWERRAW_OTHER_LAST:
             if (_otherItems.size() > 1)
             {
-                _otherIndex = _otherItems.size() - 1;
+                _otherIndex   = _otherItems.size() - 1;
+                _navDirection = -1;
                 SyncFileComboSelection();
                 _currentSidecarJpegPath = _otherItems[_otherIndex].sidecarJpegPath;
                 _currentLabel           = _otherItems[_otherIndex].label;
@@ -2837,56 +2855,56 @@ void ViewerImgRaw::OnCommand(HWND hwnd, UINT id, UINT code, HWND control)
             return;
         case IDM_VIEWERRAW_VIEW_BRIGHTNESS_INCREASE:
             _brightness = std::clamp(_brightness + 0.05f, -1.0f, 1.0f);
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateMenuChecks(hwnd);
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
             return;
         case IDM_VIEWERRAW_VIEW_BRIGHTNESS_DECREASE:
             _brightness = std::clamp(_brightness - 0.05f, -1.0f, 1.0f);
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateMenuChecks(hwnd);
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
             return;
         case IDM_VIEWERRAW_VIEW_CONTRAST_INCREASE:
             _contrast = std::clamp(_contrast + 0.05f, 0.10f, 3.00f);
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateMenuChecks(hwnd);
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
             return;
         case IDM_VIEWERRAW_VIEW_CONTRAST_DECREASE:
             _contrast = std::clamp(_contrast - 0.05f, 0.10f, 3.00f);
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateMenuChecks(hwnd);
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
             return;
         case IDM_VIEWERRAW_VIEW_GAMMA_INCREASE:
             _gamma = std::clamp(_gamma + 0.05f, 0.10f, 5.00f);
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateMenuChecks(hwnd);
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
             return;
         case IDM_VIEWERRAW_VIEW_GAMMA_DECREASE:
             _gamma = std::clamp(_gamma - 0.05f, 0.10f, 5.00f);
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateMenuChecks(hwnd);
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
             return;
         case IDM_VIEWERRAW_VIEW_TOGGLE_GRAYSCALE:
             _grayscale = ! _grayscale;
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateMenuChecks(hwnd);
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
             return;
         case IDM_VIEWERRAW_VIEW_TOGGLE_NEGATIVE:
             _negative = ! _negative;
-            _imageBitmap.reset();
+            ResetImageBitmaps();
             UpdateMenuChecks(hwnd);
             InvalidateRect(hwnd, &_contentRect, FALSE);
             InvalidateRect(hwnd, &_statusRect, FALSE);
@@ -3508,7 +3526,7 @@ bool ViewerImgRaw::EnsureDirect2D(HWND hwnd) noexcept
 
 void ViewerImgRaw::DiscardDirect2D() noexcept
 {
-    _imageBitmap.reset();
+    ResetImageBitmaps();
     _solidBrush.reset();
     _uiTextFormat.reset();
     _uiTextFormatRight.reset();
@@ -3519,6 +3537,70 @@ void ViewerImgRaw::DiscardDirect2D() noexcept
     _d2dFactory.reset();
 }
 
+bool ViewerImgRaw::HasImageAdjustments() const noexcept
+{
+    return std::fabs(_brightness) > 0.001f || std::fabs(_contrast - 1.0f) > 0.001f || std::fabs(_gamma - 1.0f) > 0.001f || _grayscale || _negative;
+}
+
+void ViewerImgRaw::ApplyImageAdjustments(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, uint32_t width, uint32_t height) const noexcept
+{
+    std::array<uint8_t, 256> map{};
+    const float gamma      = std::clamp(_gamma, 0.10f, 5.00f);
+    const float invGamma   = (std::fabs(gamma - 1.0f) < 0.0001f) ? 1.0f : (1.0f / gamma);
+    const float contrast   = std::clamp(_contrast, 0.10f, 3.00f);
+    const float brightness = std::clamp(_brightness, -1.0f, 1.0f);
+
+    for (int i = 0; i < 256; ++i)
+    {
+        float x = static_cast<float>(i) / 255.0f;
+        x       = (x - 0.5f) * contrast + 0.5f + brightness;
+        x       = std::clamp(x, 0.0f, 1.0f);
+        if (invGamma != 1.0f)
+        {
+            x = std::pow(x, invGamma);
+        }
+        const int out               = static_cast<int>(std::lround(x * 255.0f));
+        map[static_cast<size_t>(i)] = static_cast<uint8_t>(std::clamp(out, 0, 255));
+    }
+
+    for (uint32_t row = 0; row < height; ++row)
+    {
+        const uint8_t* srcRow = src + static_cast<size_t>(row) * srcStride;
+        uint8_t* dstRow       = dst + static_cast<size_t>(row) * dstStride;
+        for (uint32_t col = 0; col < width; ++col)
+        {
+            const size_t di = static_cast<size_t>(col) * 4u;
+            uint8_t b       = srcRow[di + 0];
+            uint8_t g       = srcRow[di + 1];
+            uint8_t r       = srcRow[di + 2];
+
+            if (_negative)
+            {
+                b = static_cast<uint8_t>(255u - b);
+                g = static_cast<uint8_t>(255u - g);
+                r = static_cast<uint8_t>(255u - r);
+            }
+
+            if (_grayscale)
+            {
+                const uint16_t y = static_cast<uint16_t>((54u * r + 183u * g + 19u * b + 128u) >> 8);
+                const uint8_t o  = map[static_cast<size_t>(std::min<uint16_t>(y, 255u))];
+                dstRow[di + 0]   = o;
+                dstRow[di + 1]   = o;
+                dstRow[di + 2]   = o;
+            }
+            else
+            {
+                dstRow[di + 0] = map[static_cast<size_t>(b)];
+                dstRow[di + 1] = map[static_cast<size_t>(g)];
+                dstRow[di + 2] = map[static_cast<size_t>(r)];
+            }
+
+            dstRow[di + 3] = 255u;
+        }
+    }
+}
+
 bool ViewerImgRaw::EnsureImageBitmap() noexcept
 {
     if (_imageBitmap || ! _d2dTarget)
@@ -3540,75 +3622,19 @@ bool ViewerImgRaw::EnsureImageBitmap() noexcept
         return false;
     }
 
-    const bool needAdjust =
-        std::fabs(_brightness) > 0.001f || std::fabs(_contrast - 1.0f) > 0.001f || std::fabs(_gamma - 1.0f) > 0.001f || _grayscale || _negative;
-
+    const UINT32 stride       = w * 4u;
     const uint8_t* uploadData = bgra.data();
-    if (needAdjust)
+    if (HasImageAdjustments())
     {
         if (_adjustedBgra.size() != bgra.size())
         {
             _adjustedBgra.assign(bgra.size(), 0);
         }
 
-        std::array<uint8_t, 256> map{};
-        const float gamma      = std::clamp(_gamma, 0.10f, 5.00f);
-        const float invGamma   = (std::fabs(gamma - 1.0f) < 0.0001f) ? 1.0f : (1.0f / gamma);
-        const float contrast   = std::clamp(_contrast, 0.10f, 3.00f);
-        const float brightness = std::clamp(_brightness, -1.0f, 1.0f);
-
-        for (int i = 0; i < 256; ++i)
-        {
-            float x = static_cast<float>(i) / 255.0f;
-            x       = (x - 0.5f) * contrast + 0.5f + brightness;
-            x       = std::clamp(x, 0.0f, 1.0f);
-            if (invGamma != 1.0f)
-            {
-                x = std::pow(x, invGamma);
-            }
-            const int out               = static_cast<int>(std::lround(x * 255.0f));
-            map[static_cast<size_t>(i)] = static_cast<uint8_t>(std::clamp(out, 0, 255));
-        }
-
-        const uint8_t* src      = bgra.data();
-        uint8_t* dst            = _adjustedBgra.data();
-        const size_t pixelCount = static_cast<size_t>(w) * static_cast<size_t>(h);
-        for (size_t i = 0; i < pixelCount; ++i)
-        {
-            const size_t di = i * 4u;
-            uint8_t b       = src[di + 0];
-            uint8_t g       = src[di + 1];
-            uint8_t r       = src[di + 2];
-
-            if (_negative)
-            {
-                b = static_cast<uint8_t>(255u - b);
-                g = static_cast<uint8_t>(255u - g);
-                r = static_cast<uint8_t>(255u - r);
-            }
-
-            if (_grayscale)
-            {
-                const uint16_t y = static_cast<uint16_t>((54u * r + 183u * g + 19u * b + 128u) >> 8);
-                const uint8_t o  = map[static_cast<size_t>(std::min<uint16_t>(y, 255u))];
-                dst[di + 0]      = o;
-                dst[di + 1]      = o;
-                dst[di + 2]      = o;
-            }
-            else
-            {
-                dst[di + 0] = map[static_cast<size_t>(b)];
-                dst[di + 1] = map[static_cast<size_t>(g)];
-                dst[di + 2] = map[static_cast<size_t>(r)];
-            }
-
-            dst[di + 3] = 255u;
-        }
-
+        ApplyImageAdjustments(bgra.data(), stride, _adjustedBgra.data(), stride, w, h);
         uploadData = _adjustedBgra.data();
     }
 
-    const UINT32 stride                = w * 4u;
     const D2D1_BITMAP_PROPERTIES props = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_IGNORE));
     const HRESULT hr                   = _d2dTarget->CreateBitmap(D2D1::SizeU(w, h), uploadData, stride, props, _imageBitmap.put());
     if (FAILED(hr))
@@ -3760,10 +3786,11 @@ void ViewerImgRaw::OnPaint()
         }
 
         // Image
-        const bool hasBitmap = EnsureImageBitmap();
-        float displayedZoom  = _manualZoom;
-        bool drewImage       = false;
-        if (hasBitmap && _imageBitmap)
+        const bool tiledImage = UseTiledImage();
+        const bool hasBitmap  = tiledImage || EnsureImageBitmap();
+        float displayedZoom   = _manualZoom;
+        bool drewImage        = false;
+        if (hasBitmap)
         {
             float x     = 0.0f;
             float y     = 0.0f;
@@ -3797,9 +3824,16 @@ void ViewerImgRaw::OnPaint()
                                                         D2D1::Matrix3x2F::Scale(displayedZoom, displayedZoom) * D2D1::Matrix3x2F::Translation(xDip, yDip);
                     _d2dTarget->SetTransform(transform);
 
-                    const D2D1_RECT_F dstLocal = D2D1::RectF(0.0f, 0.0f, imgWDip, imgHDip);
-                    _d2dTarget->DrawBitmap(_imageBitmap.get(), dstLocal, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
-                    drewImage = true;
+                    if (tiledImage)
+                    {
+                        drewImage = DrawImageTiles(transform, displayedZoom, dpi);
+                    }
+                    else
+                    {
+                        const D2D1_RECT_F dstLocal = D2D1::RectF(0.0f, 0.0f, imgWDip, imgHDip);
+                        _d2dTarget->DrawBitmap(_imageBitmap.get(), dstLocal, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+                        drewImage = true;
+                    }
                 }
             }
         }
@@ -40,7 +40,7 @@ struct ID2D1SolidColorBrush;
 struct IDWriteFactory;
 struct IDWriteTextFormat;
 
-class ViewerImgRaw final : public IViewer, public IInformations
+class ViewerImgRaw final : public IViewer, public IInformations, public IViewerThumbnail
 {
 public:
     ViewerImgRaw();
@@ -68,6 +68,9 @@ public:
     HRESULT STDMETHODCALLTYPE SetTheme(const ViewerTheme* theme) noexcept override;
     HRESULT STDMETHODCALLTYPE SetCallback(IViewerCallback* callback, void* cookie) noexcept override;
 
+    // IViewerThumbnail (stateless; safe to call concurrently from host worker threads)
+    HRESULT STDMETHODCALLTYPE GetThumbnail(IFileSystem* fileSystem, const wchar_t* path, uint32_t maxDimension, ViewerThumbnailImage* image) noexcept override;
+
 private:
     enum class DisplayMode : uint8_t
     {
@@ -112,6 +115,22 @@ private:
         bool operator==(const Config&) const = default;
     };
 
+    // One downsampled level of a large image (2x2 box filter of the previous level), 32bpp BGRA, stride = width * 4.
+    struct ImageMipLevel final
+    {
+        uint32_t width  = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> bgra;
+    };
+
+    // Encoded bytes of a large WIC image (TIFF, PNG, BMP, ...) that is decoded per tile region instead of as a whole frame.
+    struct ImageRegionSource final
+    {
+        std::vector<uint8_t> fileBytes;
+        uint32_t width  = 0;
+        uint32_t height = 0;
+    };
+
     struct CachedImage final
     {
         enum class ThumbSource : uint8_t
@@ -125,6 +144,8 @@ private:
         uint32_t rawHeight      = 0;
         uint16_t rawOrientation = 1; // orientation to apply when displaying RAW frame (1..8)
         std::vector<uint8_t> rawBgra;
+        std::vector<ImageMipLevel> rawMips; // Levels 1..n of rawBgra; only for images drawn as tiles (see BuildImageMipChain)
+        std::shared_ptr<const ImageRegionSource> rawSource; // Replaces rawBgra for region-decoded images; only the last rawMips level is resident
 
         uint32_t thumbWidth       = 0;
         uint32_t thumbHeight      = 0;
@@ -172,11 +193,45 @@ private:
         uint32_t width  = 0;
         uint32_t height = 0;
         std::vector<uint8_t> bgra;
+        std::vector<ImageMipLevel> mips; // Raw frames only; built on the worker thread
+        std::shared_ptr<const ImageRegionSource> rawSource;
 
         std::wstring statusMessage;
         ExifInfo exif;
     };
 
+    struct ImageTile final
+    {
+        wil::com_ptr<ID2D1Bitmap> bitmap;
+        size_t bytes           = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    // Pixels of one tile of a region-decoded image (gutters included), 32bpp BGRA, stride = width * 4.
+    struct RegionTile final
+    {
+        uint32_t level         = 0;
+        uint32_t tileX         = 0;
+        uint32_t tileY         = 0;
+        uint32_t levelWidth    = 0;
+        uint32_t levelHeight   = 0;
+        uint32_t width         = 0;
+        uint32_t height        = 0;
+        uint64_t lastUsedFrame = 0;
+        std::vector<uint8_t> bgra;
+    };
+
+    struct AsyncTileDecodeResult
+    {
+        HRESULT hr = E_FAIL;
+        std::shared_ptr<const ImageRegionSource> source;
+        std::vector<RegionTile> tiles;
+    };
+
+    // Neighbor prefetch scheduling (defined in ViewerImgRaw.Decode.cpp).
+    struct PrefetchTask;
+    struct PrefetchBatch;
+
     struct AsyncExportResult
     {
         ViewerImgRaw* viewer = nullptr;
@@ -211,6 +266,7 @@ private:
     void OnAsyncOpenComplete(std::unique_ptr<AsyncOpenResult> result) noexcept;
     void OnAsyncProgress(int stage, int percent) noexcept;
     void OnAsyncExportComplete(std::unique_ptr<AsyncExportResult> result) noexcept;
+    void OnAsyncTilesDecoded(std::unique_ptr<AsyncTileDecodeResult> result) noexcept;
     void OnNcActivate(bool windowActive) noexcept;
     LRESULT OnNcDestroy(HWND hwnd, WPARAM wp, LPARAM lp) noexcept;
     LRESULT OnInputLangChange(HWND hwnd, WPARAM wp, LPARAM lp) noexcept;
@@ -243,11 +299,31 @@ private:
     bool EnsureDirect2D(HWND hwnd) noexcept;
     void DiscardDirect2D() noexcept;
     bool EnsureImageBitmap() noexcept;
+    void ResetImageBitmaps() noexcept;
+    bool HasImageAdjustments() const noexcept;
+    void ApplyImageAdjustments(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, uint32_t width, uint32_t height) const noexcept;
+    static void BuildImageMipChain(uint32_t width, uint32_t height, const std::vector<uint8_t>& bgra, std::vector<ImageMipLevel>& outLevels) noexcept;
+    static HRESULT OpenImageRegionSource(std::vector<uint8_t>& fileBytes,
+                                         std::shared_ptr<const ImageRegionSource>& outSource,
+                                         std::vector<ImageMipLevel>& outLevels) noexcept;
+    static HRESULT DecodeImageRegionTiles(const ImageRegionSource& source, std::vector<RegionTile>& tiles) noexcept;
+    static HRESULT DecodeImageRegionFrame(const ImageRegionSource& source, std::vector<uint8_t>& outBgra) noexcept;
+    static bool HasRawFrame(const CachedImage& image) noexcept;
+    bool UseTiledImage() const noexcept;
+    bool DrawImageTiles(const D2D1_MATRIX_3X2_F& transform, float zoom, UINT dpi) noexcept;
+    ID2D1Bitmap* EnsureImageTile(uint32_t level, uint32_t tileX, uint32_t tileY) noexcept;
+    void TrimImageTiles() noexcept;
+    void SyncRegionTiles() noexcept;
+    void StartRegionTileDecode(std::vector<RegionTile> tiles) noexcept;
     bool ComputeImageLayoutPx(float& outZoom, float& outX, float& outY, float& outDrawW, float& outDrawH) noexcept;
     void ApplyZoom(HWND hwnd, float newZoom, std::optional<POINT> anchorClientPt) noexcept;
     void ClearImageCache() noexcept;
     void UpdateNeighborCache(uint64_t requestId) noexcept;
     void StartPrefetchNeighbors(uint64_t requestId) noexcept;
+    static size_t CachedImageBytes(const CachedImage& image) noexcept;
+    std::vector<size_t> NeighborPrefetchOrder() const;
+    void TrimImageCacheToBudgetLocked(const std::vector<size_t>& neighborOrder, size_t budgetBytes) noexcept;
+    void RunPrefetchTask(const PrefetchBatch& batch, PrefetchTask& task) noexcept;
     bool TryUseCachedImage(HWND hwnd, const std::wstring& path, bool& outContinueDecoding) noexcept;
     bool HasDisplayImage() const noexcept;
     bool IsDisplayingThumbnail() const noexcept;
@@ -294,6 +370,7 @@ private:
     std::wstring _currentLabel;
     std::vector<OtherItem> _otherItems;
     size_t _otherIndex     = 0;
+    int _navDirection      = 1; // +1 after moving to the next item, -1 after moving back; prefetch favors this direction
     bool _syncingFileCombo = false;
 
     bool _hasTheme = false;
@@ -331,6 +408,8 @@ private:
     std::mutex _cacheMutex;
     std::unordered_map<std::wstring, std::unique_ptr<CachedImage>> _imageCache;
     std::unordered_set<std::wstring> _inflightDecodes;
+    std::shared_ptr<PrefetchBatch> _prefetchBatch; // Latest neighbor prefetch; guarded by _cacheMutex
+    uint64_t _cacheEpoch = 0;                      // Bumped by ClearImageCache; guarded by _cacheMutex
     std::unique_ptr<CachedImage> _currentImageOwned;
     CachedImage* _currentImage = nullptr;
     std::wstring _currentImageKey;
@@ -374,6 +453,20 @@ private:
     wil::com_ptr<IDWriteTextFormat> _uiTextFormatRight;
     wil::com_ptr<ID2D1Bitmap> _imageBitmap;
 
+    // Tiled rendering of large images: only tiles of the mip level matching the zoom that intersect the view are uploaded.
+    std::unordered_map<uint64_t, ImageTile> _imageTiles; // key: level << 48 | tileY << 24 | tileX
+    wil::com_ptr<ID2D1Bitmap> _imageTileBase;            // Coarsest mip level; drawn under tiles that are not uploaded yet
+    size_t _imageTileBytes   = 0;
+    uint64_t _imageTileFrame = 0;
+    std::vector<uint8_t> _imageTileScratch;
+
+    // Decoded tile pixels of the current region-decoded image; kept across ResetImageBitmaps so adjustments do not re-decode.
+    std::unordered_map<uint64_t, RegionTile> _regionTiles; // key as in _imageTiles
+    std::weak_ptr<const ImageRegionSource> _regionTilesSource;
+    size_t _regionTileBytes      = 0;
+    bool _regionTileDecodeQueued = false; // One decode job at a time; its completion repaints and queues the next visible tiles
+    bool _regionTileDecodeFailed = false; // Stops re-queueing tiles of a source that does not decode
+
     // Callback (weak)
     IViewerCallback* _callback = nullptr;
     void* _callbackCookie      = nullptr;
@@ -382,5 +475,6 @@ private:
 inline constexpr UINT kAsyncOpenCompleteMessage   = WndMsg::kViewerImgRawAsyncOpenComplete;
 inline constexpr UINT kAsyncProgressMessage       = WndMsg::kViewerImgRawAsyncProgress;
 inline constexpr UINT kAsyncExportCompleteMessage = WndMsg::kViewerImgRawAsyncExportComplete;
+inline constexpr UINT kAsyncTilesDecodedMessage   = WndMsg::kViewerImgRawAsyncTilesDecoded;
 
 extern HINSTANCE g_hInstance;
@@ -0,0 +1,229 @@
+#include "ViewerPE.Image.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include <bcrypt.h>
+
+#pragma comment(lib, "bcrypt")
+
+#include "Helpers.h"
+
+namespace
+{
+constexpr size_t kMaxCachedReports = 8;
+
+struct CachedReport
+{
+    PeReportCacheKey key;
+    std::wstring subtitle;
+    std::wstring body;
+};
+
+std::mutex g_reportCacheMutex;
+std::vector<CachedReport> g_reportCache; // Most recently used first
+
+[[nodiscard]] bool KeysEqual(const PeReportCacheKey& a, const PeReportCacheKey& b) noexcept
+{
+    return a.sizeBytes == b.sizeBytes && a.lastWriteTime == b.lastWriteTime && a.path == b.path;
+}
+} // namespace
+
+HRESULT MapPeImage(const wchar_t* path, uint64_t sizeBytes, PeImageBytes& image) noexcept
+{
+    if (! path || sizeBytes == 0 || sizeBytes > static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+    {
+        return E_INVALIDARG;
+    }
+
+    // A read error on a mapped page raises EXCEPTION_IN_PAGE_ERROR inside peparse or the hashes instead of failing a call,
+    // so only fixed local volumes are mapped; removable media can go away and network files can fail mid-read.
+    std::array<wchar_t, MAX_PATH + 1> volumeBuffer{};
+    if (GetVolumePathNameW(path, volumeBuffer.data(), static_cast<DWORD>(volumeBuffer.size())) == 0)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    if (GetDriveTypeW(volumeBuffer.data()) != DRIVE_FIXED)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    wil::unique_hfile file(CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr));
+    if (! file)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    LARGE_INTEGER size{};
+    if (GetFileSizeEx(file.get(), &size) == 0)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    if (static_cast<uint64_t>(size.QuadPart) != sizeBytes)
+    {
+        return E_CHANGED_STATE;
+    }
+
+    wil::unique_handle mapping(CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+    if (! mapping)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    wil::unique_mapview_ptr<std::uint8_t> view(static_cast<std::uint8_t*>(MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0)));
+    if (! view)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    image.buffer.clear();
+    image.data    = view.get();
+    image.size    = static_cast<size_t>(sizeBytes);
+    image.mapped  = true;
+    image.file    = std::move(file);
+    image.mapping = std::move(mapping);
+    image.view    = std::move(view);
+    return S_OK;
+}
+
+HRESULT ReadPeImage(IFileReader* reader, uint64_t sizeBytes, const std::stop_token& st, PeImageBytes& image) noexcept
+{
+    if (! reader || sizeBytes == 0 || sizeBytes > static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+    {
+        return E_INVALIDARG;
+    }
+
+    std::vector<std::uint8_t> bytes;
+    try
+    {
+        bytes.resize(static_cast<size_t>(sizeBytes));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    size_t offset = 0;
+    while (offset < bytes.size())
+    {
+        if (st.stop_requested())
+        {
+            return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+        }
+
+        const size_t remaining   = bytes.size() - offset;
+        const unsigned long want = static_cast<unsigned long>((std::min)(remaining, static_cast<size_t>(16u * 1024u * 1024u)));
+        unsigned long read       = 0;
+        const HRESULT hr         = reader->Read(bytes.data() + offset, want, &read);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        if (read == 0)
+        {
+            break;
+        }
+        offset += static_cast<size_t>(read);
+    }
+
+    if (offset == 0)
+    {
+        return E_FAIL;
+    }
+    if (offset < bytes.size())
+    {
+        bytes.resize(offset);
+    }
+
+    image.view.reset();
+    image.mapping.reset();
+    image.file.reset();
+    image.buffer = std::move(bytes);
+    image.data   = image.buffer.data();
+    image.size   = image.buffer.size();
+    image.mapped = false;
+    return S_OK;
+}
+
+bool ComputeSha256(const std::uint8_t* data, size_t size, std::array<std::uint8_t, 32>& digest) noexcept
+{
+    if (! data && size > 0)
+    {
+        return false;
+    }
+
+    BCRYPT_HASH_HANDLE hash = nullptr;
+    if (! BCRYPT_SUCCESS(BCryptCreateHash(BCRYPT_SHA256_ALG_HANDLE, &hash, nullptr, 0, nullptr, 0, 0)))
+    {
+        return false;
+    }
+    auto destroyHash = wil::scope_exit([&]() noexcept { BCryptDestroyHash(hash); });
+
+    // BCryptHashData takes ULONG lengths; feed large sections in chunks.
+    static constexpr size_t kChunkBytes = 64u * 1024u * 1024u;
+    for (size_t offset = 0; offset < size; offset += kChunkBytes)
+    {
+        const ULONG chunk = static_cast<ULONG>((std::min)(kChunkBytes, size - offset));
+        if (! BCRYPT_SUCCESS(BCryptHashData(hash, const_cast<PUCHAR>(data + offset), chunk, 0)))
+        {
+            return false;
+        }
+    }
+
+    return BCRYPT_SUCCESS(BCryptFinishHash(hash, digest.data(), static_cast<ULONG>(digest.size()), 0));
+}
+
+bool TryGetCachedPeReport(const PeReportCacheKey& key, std::wstring& subtitle, std::wstring& body) noexcept
+{
+    if (key.path.empty() || key.lastWriteTime == 0)
+    {
+        return false;
+    }
+
+    try
+    {
+        std::scoped_lock lock(g_reportCacheMutex);
+        const auto it = std::find_if(g_reportCache.begin(), g_reportCache.end(), [&](const CachedReport& entry) noexcept { return KeysEqual(entry.key, key); });
+        if (it == g_reportCache.end())
+        {
+            return false;
+        }
+
+        std::rotate(g_reportCache.begin(), it, it + 1);
+        subtitle = g_reportCache.front().subtitle;
+        body     = g_reportCache.front().body;
+        return true;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+}
+
+void StorePeReport(const PeReportCacheKey& key, const std::wstring& subtitle, const std::wstring& body) noexcept
+{
+    if (key.path.empty() || key.lastWriteTime == 0)
+    {
+        return;
+    }
+
+    try
+    {
+        CachedReport entry{key, subtitle, body};
+
+        std::scoped_lock lock(g_reportCacheMutex);
+        std::erase_if(g_reportCache, [&](const CachedReport& existing) noexcept { return existing.key.path == key.path; });
+        g_reportCache.insert(g_reportCache.begin(), std::move(entry));
+        if (g_reportCache.size() > kMaxCachedReports)
+        {
+            g_reportCache.resize(kMaxCachedReports);
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        Debug::Warning(L"ViewerPE: Out of memory while caching the report for {}", key.path);
+    }
+}
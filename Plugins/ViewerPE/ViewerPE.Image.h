@@ -0,0 +1,56 @@
+#pragma once
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#pragma warning(push)
+#pragma warning(disable : 4625 4626 5026 5027 4820 28182) // WIL: deleted copy/move operators and padding
+#include <wil/resource.h>
+#pragma warning(pop)
+
+#include "PlugInterfaces/FileSystem.h"
+
+// Read-only bytes of the image being inspected. Paths of the local "file" plugin on fixed volumes are memory-mapped, so peparse
+// and the section hashes only fault in the pages they touch; everything else falls back to reading the whole image through
+// IFileReader.
+// peparse keeps pointers into these bytes, so a PeImageBytes must outlive every parsed_pe created from it.
+struct PeImageBytes
+{
+    const std::uint8_t* data = nullptr;
+    size_t size              = 0;
+    bool mapped              = false;
+
+    wil::unique_hfile file;
+    wil::unique_handle mapping;
+    wil::unique_mapview_ptr<std::uint8_t> view;
+    std::vector<std::uint8_t> buffer;
+};
+
+// Maps `path` read-only. The file is opened without FILE_SHARE_WRITE so it cannot be truncated underneath the view.
+// Returns HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED) for files not on a fixed local volume; callers fall back to ReadPeImage
+// when this fails (e.g. the file is open for writing elsewhere).
+HRESULT MapPeImage(const wchar_t* path, uint64_t sizeBytes, PeImageBytes& image) noexcept;
+
+// Reads up to `sizeBytes` from `reader` into image.buffer. Returns HRESULT_FROM_WIN32(ERROR_CANCELLED) when `st` is signalled.
+HRESULT ReadPeImage(IFileReader* reader, uint64_t sizeBytes, const std::stop_token& st, PeImageBytes& image) noexcept;
+
+bool ComputeSha256(const std::uint8_t* data, size_t size, std::array<std::uint8_t, 32>& digest) noexcept;
+
+// Finished reports keyed by path + size + last write time, so reopening or cycling through other files does not re-parse.
+struct PeReportCacheKey
+{
+    std::wstring path;
+    uint64_t sizeBytes    = 0;
+    __int64 lastWriteTime = 0;
+};
+
+bool TryGetCachedPeReport(const PeReportCacheKey& key, std::wstring& subtitle, std::wstring& body) noexcept;
+void StorePeReport(const PeReportCacheKey& key, const std::wstring& subtitle, const std::wstring& body) noexcept;
@@ -3,9 +3,11 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <execution>
 #include <format>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <string_view>
 #include <utility>
@@ -30,6 +32,7 @@
 #pragma comment(lib, "uxtheme")
 
 #include "Helpers.h"
+#include "ViewerPE.Image.h"
 #include "WindowMessages.h"
 #include "resource.h"
 
@@ -461,6 +464,605 @@ struct ParsedPeDeleter
         default: return L"PE";
     }
 }
+
+struct SectionRow
+{
+    std::wstring name;
+    std::uint32_t rva     = 0;
+    std::uint32_t vsize   = 0;
+    std::uint32_t rawPtr  = 0;
+    std::uint32_t rawSize = 0;
+    std::uint32_t chars   = 0;
+};
+
+void AppendLine(std::wstring& text, std::wstring_view line) noexcept
+{
+    text.append(line);
+    text.append(L"\n");
+}
+
+void AppendBlankLine(std::wstring& text) noexcept
+{
+    text.append(L"\n");
+}
+
+template <typename... Args> void AppendFormat(std::wstring& text, std::wformat_string<Args...> fmt, Args&&... args) noexcept
+{
+    text.append(std::format(fmt, std::forward<Args>(args)...));
+}
+
+void AppendImportsReport(peparse::parsed_pe* pe, std::wstring& text) noexcept
+{
+    static constexpr size_t kMaxImportRows  = 600;
+    static constexpr size_t kHardMaxImports = 6000;
+
+    struct ImportRow
+    {
+        uint64_t va = 0;
+        std::wstring module;
+        std::wstring name;
+    };
+
+    std::vector<ImportRow> imports;
+    imports.reserve(128);
+
+    struct ImportCollect
+    {
+        std::vector<ImportRow>* out = nullptr;
+        size_t maxRows              = 0;
+        size_t hardMax              = 0;
+        size_t seen                 = 0;
+        bool truncated              = false;
+    };
+
+    ImportCollect importCollect{&imports, kMaxImportRows, kHardMaxImports, 0, false};
+    peparse::IterImpVAString(
+        pe,
+        [](void* ctx, const peparse::VA& va, const std::string& module, const std::string& name) -> int
+        {
+            auto* c = static_cast<ImportCollect*>(ctx);
+            if (! c)
+            {
+                return 0;
+            }
+
+            c->seen += 1;
+            if (c->out && c->out->size() < c->maxRows)
+            {
+                ImportRow row{};
+                row.va     = static_cast<uint64_t>(va);
+                row.module = Utf16FromUtf8(module);
+                row.name   = Utf16FromUtf8(name);
+
+                c->out->push_back(std::move(row));
+            }
+
+            if (c->seen >= c->hardMax)
+            {
+                c->truncated = true;
+                return 1;
+            }
+
+            return 0;
+        },
+        &importCollect);
+
+    AppendBlankLine(text);
+    if (importCollect.seen == 0)
+    {
+        AppendLine(text, L"Imports: (none)");
+    }
+    else
+    {
+        AppendFormat(text, L"Imports: {:L}{}\n", importCollect.seen, importCollect.truncated ? L"+" : L"");
+        AppendLine(text, L"VA                 Module                   Import");
+        AppendLine(text, L"-----------------  -----------------------  ------------------------------");
+        for (const auto& imp : imports)
+        {
+            AppendFormat(text, L"0x{:016X} {:<23}  {}\n", imp.va, imp.module, imp.name);
+        }
+        if (importCollect.seen > imports.size())
+        {
+            AppendFormat(text, L"... (truncated; showing first {:L} entries)\n", imports.size());
+        }
+    }
+}
+
+void AppendExportsReport(peparse::parsed_pe* pe, std::wstring& text) noexcept
+{
+    static constexpr size_t kMaxExportRows  = 600;
+    static constexpr size_t kHardMaxExports = 6000;
+
+    struct ExportRow
+    {
+        uint64_t va       = 0;
+        std::uint16_t ord = 0;
+        std::wstring name;
+        std::wstring forward;
+    };
+
+    std::vector<ExportRow> exports;
+    exports.reserve(128);
+
+    struct ExportCollect
+    {
+        std::vector<ExportRow>* out = nullptr;
+        size_t maxRows              = 0;
+        size_t hardMax              = 0;
+        size_t seen                 = 0;
+        bool truncated              = false;
+    };
+
+    ExportCollect exportCollect{&exports, kMaxExportRows, kHardMaxExports, 0, false};
+    peparse::IterExpFull(
+        pe,
+        [](void* ctx, const peparse::VA& va, std::uint16_t ord, const std::string& name, const std::string& /*module*/, const std::string& forwardStr) -> int
+        {
+            auto* c = static_cast<ExportCollect*>(ctx);
+            if (! c)
+            {
+                return 0;
+            }
+
+            c->seen += 1;
+            if (c->out && c->out->size() < c->maxRows)
+            {
+                ExportRow row{};
+                row.va      = static_cast<uint64_t>(va);
+                row.ord     = ord;
+                row.name    = Utf16FromUtf8(name);
+                row.forward = Utf16FromUtf8(forwardStr);
+
+                c->out->push_back(std::move(row));
+            }
+
+            if (c->seen >= c->hardMax)
+            {
+                c->truncated = true;
+                return 1;
+            }
+
+            return 0;
+        },
+        &exportCollect);
+
+    AppendBlankLine(text);
+    if (exportCollect.seen == 0)
+    {
+        AppendLine(text, L"Exports: (none)");
+    }
+    else
+    {
+        AppendFormat(text, L"Exports: {:L}{}\n", exportCollect.seen, exportCollect.truncated ? L"+" : L"");
+        AppendLine(text, L"Ord   VA                 Name");
+        AppendLine(text, L"----  -----------------  --------------------------------------------");
+        for (const auto& exp : exports)
+        {
+            if (exp.va != 0)
+            {
+                AppendFormat(text, L"{:>4} 0x{:016X}  {}\n", exp.ord, exp.va, exp.name);
+            }
+            else if (! exp.forward.empty())
+            {
+                AppendFormat(text, L"{:>4} (forwarded)        {} -> {}\n", exp.ord, exp.name, exp.forward);
+            }
+            else
+            {
+                AppendFormat(text, L"{:>4} (n/a)              {}\n", exp.ord, exp.name);
+            }
+        }
+        if (exportCollect.seen > exports.size())
+        {
+            AppendFormat(text, L"... (truncated; showing first {:L} entries)\n", exports.size());
+        }
+    }
+}
+
+void AppendResourcesReport(peparse::parsed_pe* pe, std::wstring& text) noexcept
+{
+    static constexpr size_t kMaxResourceRows  = 600;
+    static constexpr size_t kHardMaxResources = 6000;
+
+    struct ResourceRow
+    {
+        std::wstring type;
+        std::wstring name;
+        std::wstring lang;
+        std::uint32_t codepage = 0;
+        std::uint32_t rva      = 0;
+        std::uint32_t size     = 0;
+    };
+
+    std::vector<ResourceRow> resources;
+    resources.reserve(128);
+
+    struct ResourceCollect
+    {
+        std::vector<ResourceRow>* out = nullptr;
+        size_t maxRows                = 0;
+        size_t hardMax                = 0;
+        size_t seen                   = 0;
+        bool truncated                = false;
+    };
+
+    ResourceCollect rsrcCollect{&resources, kMaxResourceRows, kHardMaxResources, 0, false};
+    peparse::IterRsrc(
+        pe,
+        [](void* ctx, const peparse::resource& res) -> int
+        {
+            auto* c = static_cast<ResourceCollect*>(ctx);
+            if (! c)
+            {
+                return 0;
+            }
+
+            c->seen += 1;
+            if (c->out && c->out->size() < c->maxRows)
+            {
+                ResourceRow row{};
+                row.type     = Utf16FromUtf8(res.type_str);
+                row.name     = Utf16FromUtf8(res.name_str);
+                row.lang     = Utf16FromUtf8(res.lang_str);
+                row.codepage = res.codepage;
+                row.rva      = res.RVA;
+                row.size     = res.size;
+
+                if (row.type.empty())
+                {
+                    row.type = std::to_wstring(res.type);
+                }
+                if (row.name.empty())
+                {
+                    row.name = std::to_wstring(res.name);
+                }
+                if (row.lang.empty())
+                {
+                    row.lang = std::to_wstring(res.lang);
+                }
+
+                c->out->push_back(std::move(row));
+            }
+
+            if (c->seen >= c->hardMax)
+            {
+                c->truncated = true;
+                return 1;
+            }
+
+            return 0;
+        },
+        &rsrcCollect);
+
+    AppendBlankLine(text);
+    if (rsrcCollect.seen == 0)
+    {
+        AppendLine(text, L"Resources: (none)");
+    }
+    else
+    {
+        AppendFormat(text, L"Resources: {:L}{}\n", rsrcCollect.seen, rsrcCollect.truncated ? L"+" : L"");
+        AppendLine(text, L"RVA        Size       CodePage  Type / Name / Lang");
+        AppendLine(text, L"---------  ---------  --------  ---------------------------------------");
+        for (const auto& res : resources)
+        {
+            AppendFormat(text, L"0x{:08X} 0x{:08X} {:>8}  {}/{}/{}\n", res.rva, res.size, res.codepage, res.type, res.name, res.lang);
+        }
+        if (rsrcCollect.seen > resources.size())
+        {
+            AppendFormat(text, L"... (truncated; showing first {:L} entries)\n", resources.size());
+        }
+    }
+}
+
+void AppendRelocationsReport(peparse::parsed_pe* pe, std::wstring& text) noexcept
+{
+    static constexpr size_t kMaxRelocRows  = 600;
+    static constexpr size_t kHardMaxRelocs = 20000;
+
+    struct RelocRow
+    {
+        uint64_t va              = 0;
+        peparse::reloc_type type = peparse::RELOC_ABSOLUTE;
+    };
+
+    std::vector<RelocRow> relocs;
+    relocs.reserve(256);
+
+    struct RelocCollect
+    {
+        std::vector<RelocRow>* out = nullptr;
+        size_t maxRows             = 0;
+        size_t hardMax             = 0;
+        size_t seen                = 0;
+        bool truncated             = false;
+    };
+
+    RelocCollect relocCollect{&relocs, kMaxRelocRows, kHardMaxRelocs, 0, false};
+    peparse::IterRelocs(
+        pe,
+        [](void* ctx, const peparse::VA& va, const peparse::reloc_type& type) -> int
+        {
+            auto* c = static_cast<RelocCollect*>(ctx);
+            if (! c)
+            {
+                return 0;
+            }
+
+            c->seen += 1;
+            if (c->out && c->out->size() < c->maxRows)
+            {
+                RelocRow row{};
+                row.va   = static_cast<uint64_t>(va);
+                row.type = type;
+
+                c->out->push_back(row);
+            }
+
+            if (c->seen >= c->hardMax)
+            {
+                c->truncated = true;
+                return 1;
+            }
+
+            return 0;
+        },
+        &relocCollect);
+
+    AppendBlankLine(text);
+    if (relocCollect.seen == 0)
+    {
+        AppendLine(text, L"Relocations: (none)");
+    }
+    else
+    {
+        AppendFormat(text, L"Relocations: {:L}{}\n", relocCollect.seen, relocCollect.truncated ? L"+" : L"");
+        AppendLine(text, L"VA                 Type");
+        AppendLine(text, L"-----------------  ----");
+        for (const auto& rel : relocs)
+        {
+            AppendFormat(text, L"0x{:016X}  {:L}\n", rel.va, static_cast<unsigned long>(rel.type));
+        }
+        if (relocCollect.seen > relocs.size())
+        {
+            AppendFormat(text, L"... (truncated; showing first {:L} entries)\n", relocs.size());
+        }
+    }
+}
+
+void AppendDebugDirectoriesReport(peparse::parsed_pe* pe, std::wstring& text) noexcept
+{
+    static constexpr size_t kMaxDebugRows  = 256;
+    static constexpr size_t kHardMaxDebugs = 2000;
+
+    struct DebugRow
+    {
+        std::uint32_t type = 0;
+        std::uint32_t size = 0;
+    };
+
+    std::vector<DebugRow> debugs;
+    debugs.reserve(32);
+
+    struct DebugCollect
+    {
+        std::vector<DebugRow>* out = nullptr;
+        size_t maxRows             = 0;
+        size_t hardMax             = 0;
+        size_t seen                = 0;
+        bool truncated             = false;
+    };
+
+    DebugCollect debugCollect{&debugs, kMaxDebugRows, kHardMaxDebugs, 0, false};
+    peparse::IterDebugs(
+        pe,
+        [](void* ctx, const std::uint32_t& type, const peparse::bounded_buffer* buf) -> int
+        {
+            auto* c = static_cast<DebugCollect*>(ctx);
+            if (! c)
+            {
+                return 0;
+            }
+
+            c->seen += 1;
+            if (c->out && c->out->size() < c->maxRows)
+            {
+                DebugRow row{};
+                row.type = type;
+                row.size = buf ? buf->bufLen : 0;
+                c->out->push_back(row);
+            }
+
+            if (c->seen >= c->hardMax)
+            {
+                c->truncated = true;
+                return 1;
+            }
+
+            return 0;
+        },
+        &debugCollect);
+
+    AppendBlankLine(text);
+    if (debugCollect.seen == 0)
+    {
+        AppendLine(text, L"Debug Directories: (none)");
+    }
+    else
+    {
+        AppendFormat(text, L"Debug Directories: {:L}{}\n", debugCollect.seen, debugCollect.truncated ? L"+" : L"");
+        AppendLine(text, L"Type       Size");
+        AppendLine(text, L"---------  ---------");
+        for (const auto& dbg : debugs)
+        {
+            AppendFormat(text, L"{:>9} 0x{:08X}\n", dbg.type, dbg.size);
+        }
+        if (debugCollect.seen > debugs.size())
+        {
+            AppendFormat(text, L"... (truncated; showing first {:L} entries)\n", debugs.size());
+        }
+    }
+}
+
+void AppendSymbolsReport(peparse::parsed_pe* pe, std::wstring& text) noexcept
+{
+    static constexpr size_t kMaxSymbolRows  = 600;
+    static constexpr size_t kHardMaxSymbols = 6000;
+
+    struct SymbolRow
+    {
+        std::wstring name;
+        std::uint32_t value  = 0;
+        std::int16_t section = 0;
+        std::uint16_t type   = 0;
+        std::uint8_t storage = 0;
+        std::uint8_t aux     = 0;
+    };
+
+    std::vector<SymbolRow> symbols;
+    symbols.reserve(128);
+
+    struct SymbolCollect
+    {
+        std::vector<SymbolRow>* out = nullptr;
+        size_t maxRows              = 0;
+        size_t hardMax              = 0;
+        size_t seen                 = 0;
+        bool truncated              = false;
+    };
+
+    SymbolCollect symbolCollect{&symbols, kMaxSymbolRows, kHardMaxSymbols, 0, false};
+    peparse::IterSymbols(
+        pe,
+        [](void* ctx,
+           const std::string& name,
+           const std::uint32_t& value,
+           const std::int16_t& section,
+           const std::uint16_t& type,
+           const std::uint8_t& storage,
+           const std::uint8_t& aux) -> int
+        {
+            auto* c = static_cast<SymbolCollect*>(ctx);
+            if (! c)
+            {
+                return 0;
+            }
+
+            c->seen += 1;
+            if (c->out && c->out->size() < c->maxRows)
+            {
+                SymbolRow row{};
+                row.name    = Utf16FromUtf8(name);
+                row.value   = value;
+                row.section = section;
+                row.type    = type;
+                row.storage = storage;
+                row.aux     = aux;
+
+                c->out->push_back(std::move(row));
+            }
+
+            if (c->seen >= c->hardMax)
+            {
+                c->truncated = true;
+                return 1;
+            }
+
+            return 0;
+        },
+        &symbolCollect);
+
+    AppendBlankLine(text);
+    if (symbolCollect.seen == 0)
+    {
+        AppendLine(text, L"Symbols: (none)");
+    }
+    else
+    {
+        AppendFormat(text, L"Symbols: {:L}{}\n", symbolCollect.seen, symbolCollect.truncated ? L"+" : L"");
+        AppendLine(text, L"Value      Sect Type  Stor Aux Name");
+        AppendLine(text, L"---------  ---- ----  ---- --- --------------------------------");
+        for (const auto& sym : symbols)
+        {
+            AppendFormat(text, L"0x{:08X} {:>4} 0x{:04X} {:>4} {:>3} {}\n", sym.value, sym.section, sym.type, sym.storage, sym.aux, sym.name);
+        }
+        if (symbolCollect.seen > symbols.size())
+        {
+            AppendFormat(text, L"... (truncated; showing first {:L} entries)\n", symbols.size());
+        }
+    }
+}
+
+// Directory walks that stay off the header path: they run in parallel once the headers have been posted, each into its own slot.
+using DeferredReportFn = void (*)(peparse::parsed_pe* pe, std::wstring& text) noexcept;
+
+constexpr std::array<DeferredReportFn, 6> kDeferredReports = {
+    AppendImportsReport,
+    AppendExportsReport,
+    AppendResourcesReport,
+    AppendRelocationsReport,
+    AppendDebugDirectoriesReport,
+    AppendSymbolsReport,
+};
+
+using SectionDigest = std::array<std::uint8_t, 32>;
+
+// Hashing reads every byte of a section, which would fault a whole mapped image in; larger sections are listed unhashed.
+constexpr uint32_t kMaxHashedSectionBytes = 32u * 1024u * 1024u;
+
+[[nodiscard]] bool IsSectionTooLargeToHash(const SectionRow& section) noexcept
+{
+    return section.rawSize > kMaxHashedSectionBytes;
+}
+
+// SHA-256 of the section's raw data, clamped to the bytes actually present in the file.
+[[nodiscard]] std::optional<SectionDigest> HashSectionRawData(const PeImageBytes& image, const SectionRow& section) noexcept
+{
+    if (section.rawSize == 0 || section.rawPtr >= image.size || IsSectionTooLargeToHash(section))
+    {
+        return std::nullopt;
+    }
+
+    const size_t length = std::min(static_cast<size_t>(section.rawSize), image.size - section.rawPtr);
+    SectionDigest digest{};
+    if (! ComputeSha256(image.data + section.rawPtr, length, digest))
+    {
+        return std::nullopt;
+    }
+    return digest;
+}
+
+void AppendSectionHashesReport(const std::vector<SectionRow>& sections, const std::vector<std::optional<SectionDigest>>& hashes, std::wstring& text) noexcept
+{
+    static constexpr std::wstring_view kHexDigits = L"0123456789abcdef";
+
+    AppendBlankLine(text);
+    AppendLine(text, L"Section Hashes (SHA-256 of raw data):");
+    AppendLine(text, L"Name       SHA-256");
+    AppendLine(text, L"---------- ----------------------------------------------------------------");
+    for (size_t i = 0; i < sections.size() && i < hashes.size(); ++i)
+    {
+        if (! hashes[i])
+        {
+            if (IsSectionTooLargeToHash(sections[i]))
+            {
+                AppendFormat(text, L"{:<10} (skipped; raw data over {:L} MiB)\n", sections[i].name, kMaxHashedSectionBytes / (1024u * 1024u));
+                continue;
+            }
+
+            AppendFormat(text, L"{:<10} (no raw data)\n", sections[i].name);
+            continue;
+        }
+
+        std::wstring hex;
+        hex.reserve(64);
+        for (const std::uint8_t byte : *hashes[i])
+        {
+            hex.push_back(kHexDigits[byte >> 4]);
+            hex.push_back(kHexDigits[byte & 0x0Fu]);
+        }
+        AppendFormat(text, L"{:<10} {}\n", sections[i].name, hex);
+    }
+}
 } // namespace
 
 ViewerPE::ViewerPE()
@@ -1878,9 +2480,10 @@ void ViewerPE::StartAsyncParse(HWND hwnd, wil::com_ptr<IFileSystem> fileSystem,
     }
 
     _worker = std::jthread(
-        [hwnd, requestId, fileSystem = std::move(fileSystem), path = std::move(path)](std::stop_token st) noexcept
+        [hwnd, requestId, fileSystemIsWin32 = _fileSystemIsWin32, fileSystem = std::move(fileSystem), path = std::move(path)](std::stop_token st) noexcept
         {
-            auto postResult = [&](HRESULT hr, std::wstring title, std::wstring subtitle, std::wstring body, std::wstring markdown) noexcept
+            auto postResult =
+                [&](HRESULT hr, std::wstring title, std::wstring subtitle, std::wstring body, std::wstring markdown, bool complete = true) noexcept
             {
                 if (st.stop_requested())
                 {
@@ -1904,6 +2507,7 @@ void ViewerPE::StartAsyncParse(HWND hwnd, wil::com_ptr<IFileSystem> fileSystem,
                 result->subtitle  = std::move(subtitle);
                 result->body      = std::move(body);
                 result->markdown  = std::move(markdown);
+                result->complete  = complete;
                 static_cast<void>(PostMessagePayload(hwnd, kAsyncParseCompleteMessage, 0, std::move(result)));
             };
 
@@ -1938,44 +2542,61 @@ void ViewerPE::StartAsyncParse(HWND hwnd, wil::com_ptr<IFileSystem> fileSystem,
                 return;
             }
 
-            std::vector<std::uint8_t> bytes;
-            bytes.resize(static_cast<size_t>(sizeBytes));
-
-            size_t offset = 0;
-            while (offset < bytes.size())
+            const std::wstring title = std::filesystem::path(path).filename().wstring();
+            const auto buildMarkdown = [&](const std::wstring& subtitle, const std::wstring& body)
             {
-                if (st.stop_requested())
+                const std::wstring mdTitle = title.empty() ? LoadStringResource(g_hInstance, IDS_VIEWERPE_NAME) : title;
+                return std::format(L"# {}\n\n{}\n\n```text\n{}\n```\n", mdTitle, subtitle, body);
+            };
+
+            PeReportCacheKey cacheKey;
+            cacheKey.path      = path;
+            cacheKey.sizeBytes = sizeBytes;
+
+            FileSystemBasicInformation basicInfo{};
+            if (SUCCEEDED(fsio->GetFileBasicInformation(path.c_str(), &basicInfo)))
+            {
+                cacheKey.lastWriteTime = basicInfo.lastWriteTime;
+            }
+
+            std::wstring cachedSubtitle;
+            std::wstring cachedBody;
+            if (TryGetCachedPeReport(cacheKey, cachedSubtitle, cachedBody))
+            {
+                std::wstring markdown = buildMarkdown(cachedSubtitle, cachedBody);
+                postResult(S_OK, title, std::move(cachedSubtitle), std::move(cachedBody), std::move(markdown));
+                return;
+            }
+
+            // peparse keeps pointers into `image`, so it is declared before `pe` and outlives it.
+            PeImageBytes image;
+            if (fileSystemIsWin32)
+            {
+                const HRESULT mapHr = MapPeImage(path.c_str(), sizeBytes, image);
+                if (FAILED(mapHr))
                 {
-                    return;
+                    Debug::Info(L"ViewerPE: Mapping {} failed (0x{:08X}); reading it instead.", path, static_cast<unsigned long>(mapHr));
                 }
+            }
 
-                const size_t remaining   = bytes.size() - offset;
-                const unsigned long want = static_cast<unsigned long>((std::min)(remaining, static_cast<size_t>(16u * 1024u * 1024u)));
-                unsigned long read       = 0;
-                hr                       = reader->Read(bytes.data() + offset, want, &read);
-                if (FAILED(hr))
+            if (! image.mapped)
+            {
+                hr = ReadPeImage(reader.get(), sizeBytes, st, image);
+                if (hr == HRESULT_FROM_WIN32(ERROR_CANCELLED))
                 {
-                    postResult(hr, {}, {}, LoadStringResource(g_hInstance, IDS_VIEWERPE_ERROR_READ_FAILED), {});
                     return;
                 }
-                if (read == 0)
+                if (FAILED(hr))
                 {
-                    break;
+                    postResult(hr, {}, {}, LoadStringResource(g_hInstance, IDS_VIEWERPE_ERROR_READ_FAILED), {});
+                    return;
                 }
-                offset += static_cast<size_t>(read);
             }
+            reader.reset();
 
-            if (offset == 0)
-            {
-                postResult(E_FAIL, {}, {}, LoadStringResource(g_hInstance, IDS_VIEWERPE_ERROR_READ_FAILED), {});
-                return;
-            }
-            if (offset < bytes.size())
-            {
-                bytes.resize(offset);
-            }
-
-            std::unique_ptr<peparse::parsed_pe, ParsedPeDeleter> pe(peparse::ParsePEFromPointer(bytes.data(), static_cast<std::uint32_t>(bytes.size())));
+            // ParsePEFromPointer takes a mutable pointer but only reads through it, so a read-only view is fine.
+            std::unique_ptr<peparse::parsed_pe, ParsedPeDeleter> pe(
+                peparse::ParsePEFromPointer(const_cast<std::uint8_t*>(image.data), static_cast<std::uint32_t>(image.size)));
             if (! pe)
             {
                 std::wstring err          = LoadStringResource(g_hInstance, IDS_VIEWERPE_ERROR_PARSE_FAILED);
@@ -2045,16 +2666,6 @@ void ViewerPE::StartAsyncParse(HWND hwnd, wil::com_ptr<IFileSystem> fileSystem,
 
             body += std::format(L"{:<10} {:>10} {:>10} {:>10} {:>10} {:>10}\n", L"Name", L"RVA", L"VSize", L"RawPtr", L"RawSize", L"Chars");
 
-            struct SectionRow
-            {
-                std::wstring name;
-                std::uint32_t rva     = 0;
-                std::uint32_t vsize   = 0;
-                std::uint32_t rawPtr  = 0;
-                std::uint32_t rawSize = 0;
-                std::uint32_t chars   = 0;
-            };
-
             std::vector<SectionRow> sections;
             peparse::IterSec(
                 pe.get(),
@@ -2095,35 +2706,22 @@ void ViewerPE::StartAsyncParse(HWND hwnd, wil::com_ptr<IFileSystem> fileSystem,
                 body += line;
             }
 
-            const auto safeAppend = [&](std::wstring_view text) noexcept { body.append(text); };
-
-            const auto safeAppendLine = [&](std::wstring_view text) noexcept
-            {
-                safeAppend(text);
-                safeAppend(L"\n");
-            };
-
-            const auto safeAppendFormat = [&]<typename... Args>(std::wformat_string<Args...> fmt, Args&&... args) noexcept
-            { safeAppend(std::format(fmt, std::forward<Args>(args)...)); };
-
-            const auto safeAppendBlankLine = [&]() noexcept { safeAppend(L"\n"); };
-
-            safeAppendBlankLine();
-            safeAppendLine(L"Rich Header:");
-            safeAppendFormat(L"Present: {}\n", pe->peHeader.rich.isPresent ? L"Yes" : L"No");
-            safeAppendFormat(L"Valid: {}\n", pe->peHeader.rich.isValid ? L"Yes" : L"No");
+            AppendBlankLine(body);
+            AppendLine(body, L"Rich Header:");
+            AppendFormat(body, L"Present: {}\n", pe->peHeader.rich.isPresent ? L"Yes" : L"No");
+            AppendFormat(body, L"Valid: {}\n", pe->peHeader.rich.isValid ? L"Yes" : L"No");
             if (pe->peHeader.rich.isPresent)
             {
-                safeAppendFormat(L"DecryptionKey: 0x{:08X}\n", pe->peHeader.rich.DecryptionKey);
-                safeAppendFormat(L"Checksum: 0x{:08X}\n", pe->peHeader.rich.Checksum);
-                safeAppendFormat(L"Entries: {:L}\n", pe->peHeader.rich.Entries.size());
+                AppendFormat(body, L"DecryptionKey: 0x{:08X}\n", pe->peHeader.rich.DecryptionKey);
+                AppendFormat(body, L"Checksum: 0x{:08X}\n", pe->peHeader.rich.Checksum);
+                AppendFormat(body, L"Entries: {:L}\n", pe->peHeader.rich.Entries.size());
 
                 static constexpr size_t kMaxRichEntries = 256;
                 if (! pe->peHeader.rich.Entries.empty())
                 {
-                    safeAppendBlankLine();
-                    safeAppendLine(L"ProductId Build     Count      Product");
-                    safeAppendLine(L"-------- -----     ---------  ------------------------------");
+                    AppendBlankLine(body);
+                    AppendLine(body, L"ProductId Build     Count      Product");
+                    AppendLine(body, L"-------- -----     ---------  ------------------------------");
 
                     size_t shown = 0;
                     for (const auto& entry : pe->peHeader.rich.Entries)
@@ -2135,7 +2733,7 @@ void ViewerPE::StartAsyncParse(HWND hwnd, wil::com_ptr<IFileSystem> fileSystem,
 
                         if (shown >= kMaxRichEntries)
                         {
-                            safeAppendFormat(L"... (truncated; showing first {:L} entries)\n", kMaxRichEntries);
+                            AppendFormat(body, L"... (truncated; showing first {:L} entries)\n", kMaxRichEntries);
                             break;
                         }
 
@@ -2148,592 +2746,125 @@ void ViewerPE::StartAsyncParse(HWND hwnd, wil::com_ptr<IFileSystem> fileSystem,
                             label += Utf16FromUtf8(obj);
                         }
 
-                        safeAppendFormat(L"{:>8} {:>5}     {:>9}  {}\n", entry.ProductId, entry.BuildNumber, entry.Count, label);
+                        AppendFormat(body, L"{:>8} {:>5}     {:>9}  {}\n", entry.ProductId, entry.BuildNumber, entry.Count, label);
                         shown += 1;
                     }
                 }
             }
 
-            safeAppendBlankLine();
-            safeAppendLine(L"File Header:");
-            safeAppendFormat(L"NumberOfSections: {:L}\n", fileHeader.NumberOfSections);
-            safeAppendFormat(L"SizeOfOptionalHeader: {:L}\n", fileHeader.SizeOfOptionalHeader);
-            safeAppendFormat(L"PointerToSymbolTable: 0x{:08X}\n", fileHeader.PointerToSymbolTable);
-            safeAppendFormat(L"NumberOfSymbols: {:L}\n", fileHeader.NumberOfSymbols);
+            AppendBlankLine(body);
+            AppendLine(body, L"File Header:");
+            AppendFormat(body, L"NumberOfSections: {:L}\n", fileHeader.NumberOfSections);
+            AppendFormat(body, L"SizeOfOptionalHeader: {:L}\n", fileHeader.SizeOfOptionalHeader);
+            AppendFormat(body, L"PointerToSymbolTable: 0x{:08X}\n", fileHeader.PointerToSymbolTable);
+            AppendFormat(body, L"NumberOfSymbols: {:L}\n", fileHeader.NumberOfSymbols);
 
-            safeAppendBlankLine();
-            safeAppendLine(L"Optional Header:");
+            AppendBlankLine(body);
+            AppendLine(body, L"Optional Header:");
             if (is64)
             {
-                safeAppendFormat(L"Magic: 0x{:04X}\n", opt64.Magic);
-                safeAppendFormat(L"LinkerVersion: {}.{}\n", opt64.MajorLinkerVersion, opt64.MinorLinkerVersion);
-                safeAppendFormat(L"SizeOfImage: 0x{:08X}\n", opt64.SizeOfImage);
-                safeAppendFormat(L"SizeOfHeaders: 0x{:08X}\n", opt64.SizeOfHeaders);
-                safeAppendFormat(L"CheckSum: 0x{:08X}\n", opt64.CheckSum);
-                safeAppendFormat(L"DllCharacteristics: 0x{:04X}\n", opt64.DllCharacteristics);
-                safeAppendFormat(L"SectionAlignment: 0x{:08X}\n", opt64.SectionAlignment);
-                safeAppendFormat(L"FileAlignment: 0x{:08X}\n", opt64.FileAlignment);
-                safeAppendFormat(L"OSVersion: {}.{}\n", opt64.MajorOperatingSystemVersion, opt64.MinorOperatingSystemVersion);
-                safeAppendFormat(L"ImageVersion: {}.{}\n", opt64.MajorImageVersion, opt64.MinorImageVersion);
-                safeAppendFormat(L"SubsystemVersion: {}.{}\n", opt64.MajorSubsystemVersion, opt64.MinorSubsystemVersion);
-                safeAppendFormat(L"SizeOfStackReserve: 0x{:016X}\n", opt64.SizeOfStackReserve);
-                safeAppendFormat(L"SizeOfStackCommit: 0x{:016X}\n", opt64.SizeOfStackCommit);
-                safeAppendFormat(L"SizeOfHeapReserve: 0x{:016X}\n", opt64.SizeOfHeapReserve);
-                safeAppendFormat(L"SizeOfHeapCommit: 0x{:016X}\n", opt64.SizeOfHeapCommit);
-                safeAppendFormat(L"NumberOfRvaAndSizes: {:L}\n", opt64.NumberOfRvaAndSizes);
+                AppendFormat(body, L"Magic: 0x{:04X}\n", opt64.Magic);
+                AppendFormat(body, L"LinkerVersion: {}.{}\n", opt64.MajorLinkerVersion, opt64.MinorLinkerVersion);
+                AppendFormat(body, L"SizeOfImage: 0x{:08X}\n", opt64.SizeOfImage);
+                AppendFormat(body, L"SizeOfHeaders: 0x{:08X}\n", opt64.SizeOfHeaders);
+                AppendFormat(body, L"CheckSum: 0x{:08X}\n", opt64.CheckSum);
+                AppendFormat(body, L"DllCharacteristics: 0x{:04X}\n", opt64.DllCharacteristics);
+                AppendFormat(body, L"SectionAlignment: 0x{:08X}\n", opt64.SectionAlignment);
+                AppendFormat(body, L"FileAlignment: 0x{:08X}\n", opt64.FileAlignment);
+                AppendFormat(body, L"OSVersion: {}.{}\n", opt64.MajorOperatingSystemVersion, opt64.MinorOperatingSystemVersion);
+                AppendFormat(body, L"ImageVersion: {}.{}\n", opt64.MajorImageVersion, opt64.MinorImageVersion);
+                AppendFormat(body, L"SubsystemVersion: {}.{}\n", opt64.MajorSubsystemVersion, opt64.MinorSubsystemVersion);
+                AppendFormat(body, L"SizeOfStackReserve: 0x{:016X}\n", opt64.SizeOfStackReserve);
+                AppendFormat(body, L"SizeOfStackCommit: 0x{:016X}\n", opt64.SizeOfStackCommit);
+                AppendFormat(body, L"SizeOfHeapReserve: 0x{:016X}\n", opt64.SizeOfHeapReserve);
+                AppendFormat(body, L"SizeOfHeapCommit: 0x{:016X}\n", opt64.SizeOfHeapCommit);
+                AppendFormat(body, L"NumberOfRvaAndSizes: {:L}\n", opt64.NumberOfRvaAndSizes);
             }
             else
             {
-                safeAppendFormat(L"Magic: 0x{:04X}\n", opt32.Magic);
-                safeAppendFormat(L"LinkerVersion: {}.{}\n", opt32.MajorLinkerVersion, opt32.MinorLinkerVersion);
-                safeAppendFormat(L"SizeOfImage: 0x{:08X}\n", opt32.SizeOfImage);
-                safeAppendFormat(L"SizeOfHeaders: 0x{:08X}\n", opt32.SizeOfHeaders);
-                safeAppendFormat(L"CheckSum: 0x{:08X}\n", opt32.CheckSum);
-                safeAppendFormat(L"DllCharacteristics: 0x{:04X}\n", opt32.DllCharacteristics);
-                safeAppendFormat(L"SectionAlignment: 0x{:08X}\n", opt32.SectionAlignment);
-                safeAppendFormat(L"FileAlignment: 0x{:08X}\n", opt32.FileAlignment);
-                safeAppendFormat(L"OSVersion: {}.{}\n", opt32.MajorOperatingSystemVersion, opt32.MinorOperatingSystemVersion);
-                safeAppendFormat(L"ImageVersion: {}.{}\n", opt32.MajorImageVersion, opt32.MinorImageVersion);
-                safeAppendFormat(L"SubsystemVersion: {}.{}\n", opt32.MajorSubsystemVersion, opt32.MinorSubsystemVersion);
-                safeAppendFormat(L"SizeOfStackReserve: 0x{:08X}\n", opt32.SizeOfStackReserve);
-                safeAppendFormat(L"SizeOfStackCommit: 0x{:08X}\n", opt32.SizeOfStackCommit);
-                safeAppendFormat(L"SizeOfHeapReserve: 0x{:08X}\n", opt32.SizeOfHeapReserve);
-                safeAppendFormat(L"SizeOfHeapCommit: 0x{:08X}\n", opt32.SizeOfHeapCommit);
-                safeAppendFormat(L"NumberOfRvaAndSizes: {:L}\n", opt32.NumberOfRvaAndSizes);
+                AppendFormat(body, L"Magic: 0x{:04X}\n", opt32.Magic);
+                AppendFormat(body, L"LinkerVersion: {}.{}\n", opt32.MajorLinkerVersion, opt32.MinorLinkerVersion);
+                AppendFormat(body, L"SizeOfImage: 0x{:08X}\n", opt32.SizeOfImage);
+                AppendFormat(body, L"SizeOfHeaders: 0x{:08X}\n", opt32.SizeOfHeaders);
+                AppendFormat(body, L"CheckSum: 0x{:08X}\n", opt32.CheckSum);
+                AppendFormat(body, L"DllCharacteristics: 0x{:04X}\n", opt32.DllCharacteristics);
+                AppendFormat(body, L"SectionAlignment: 0x{:08X}\n", opt32.SectionAlignment);
+                AppendFormat(body, L"FileAlignment: 0x{:08X}\n", opt32.FileAlignment);
+                AppendFormat(body, L"OSVersion: {}.{}\n", opt32.MajorOperatingSystemVersion, opt32.MinorOperatingSystemVersion);
+                AppendFormat(body, L"ImageVersion: {}.{}\n", opt32.MajorImageVersion, opt32.MinorImageVersion);
+                AppendFormat(body, L"SubsystemVersion: {}.{}\n", opt32.MajorSubsystemVersion, opt32.MinorSubsystemVersion);
+                AppendFormat(body, L"SizeOfStackReserve: 0x{:08X}\n", opt32.SizeOfStackReserve);
+                AppendFormat(body, L"SizeOfStackCommit: 0x{:08X}\n", opt32.SizeOfStackCommit);
+                AppendFormat(body, L"SizeOfHeapReserve: 0x{:08X}\n", opt32.SizeOfHeapReserve);
+                AppendFormat(body, L"SizeOfHeapCommit: 0x{:08X}\n", opt32.SizeOfHeapCommit);
+                AppendFormat(body, L"NumberOfRvaAndSizes: {:L}\n", opt32.NumberOfRvaAndSizes);
             }
 
-            safeAppendBlankLine();
-            safeAppendLine(L"Data Directories:");
-            safeAppendLine(L"Name                 RVA        Size");
-            safeAppendLine(L"-------------------  ---------  ---------");
+            AppendBlankLine(body);
+            AppendLine(body, L"Data Directories:");
+            AppendLine(body, L"Name                 RVA        Size");
+            AppendLine(body, L"-------------------  ---------  ---------");
             for (size_t i = 0; i < kDataDirectoryNames.size(); ++i)
             {
                 const peparse::data_directory dir = is64 ? opt64.DataDirectory[i] : opt32.DataDirectory[i];
-                safeAppendFormat(L"{:<19}  0x{:08X}  0x{:08X}\n", kDataDirectoryNames[i], dir.VirtualAddress, dir.Size);
-            }
-
-            if (st.stop_requested())
-            {
-                return;
-            }
-
-            static constexpr size_t kMaxImportRows  = 600;
-            static constexpr size_t kHardMaxImports = 6000;
-
-            struct ImportRow
-            {
-                uint64_t va = 0;
-                std::wstring module;
-                std::wstring name;
-            };
-
-            std::vector<ImportRow> imports;
-            imports.reserve(128);
-
-            struct ImportCollect
-            {
-                std::vector<ImportRow>* out = nullptr;
-                size_t maxRows              = 0;
-                size_t hardMax              = 0;
-                size_t seen                 = 0;
-                bool truncated              = false;
-            };
-
-            ImportCollect importCollect{&imports, kMaxImportRows, kHardMaxImports, 0, false};
-            peparse::IterImpVAString(
-                pe.get(),
-                [](void* ctx, const peparse::VA& va, const std::string& module, const std::string& name) -> int
-                {
-                    auto* c = static_cast<ImportCollect*>(ctx);
-                    if (! c)
-                    {
-                        return 0;
-                    }
-
-                    c->seen += 1;
-                    if (c->out && c->out->size() < c->maxRows)
-                    {
-                        ImportRow row{};
-                        row.va     = static_cast<uint64_t>(va);
-                        row.module = Utf16FromUtf8(module);
-                        row.name   = Utf16FromUtf8(name);
-
-                        c->out->push_back(std::move(row));
-                    }
-
-                    if (c->seen >= c->hardMax)
-                    {
-                        c->truncated = true;
-                        return 1;
-                    }
-
-                    return 0;
-                },
-                &importCollect);
-
-            safeAppendBlankLine();
-            if (importCollect.seen == 0)
-            {
-                safeAppendLine(L"Imports: (none)");
-            }
-            else
-            {
-                safeAppendFormat(L"Imports: {:L}{}\n", importCollect.seen, importCollect.truncated ? L"+" : L"");
-                safeAppendLine(L"VA                 Module                   Import");
-                safeAppendLine(L"-----------------  -----------------------  ------------------------------");
-                for (const auto& imp : imports)
-                {
-                    safeAppendFormat(L"0x{:016X} {:<23}  {}\n", imp.va, imp.module, imp.name);
-                }
-                if (importCollect.seen > imports.size())
-                {
-                    safeAppendFormat(L"... (truncated; showing first {:L} entries)\n", imports.size());
-                }
-            }
-
-            if (st.stop_requested())
-            {
-                return;
-            }
-
-            static constexpr size_t kMaxExportRows  = 600;
-            static constexpr size_t kHardMaxExports = 6000;
-
-            struct ExportRow
-            {
-                uint64_t va       = 0;
-                std::uint16_t ord = 0;
-                std::wstring name;
-                std::wstring forward;
-            };
-
-            std::vector<ExportRow> exports;
-            exports.reserve(128);
-
-            struct ExportCollect
-            {
-                std::vector<ExportRow>* out = nullptr;
-                size_t maxRows              = 0;
-                size_t hardMax              = 0;
-                size_t seen                 = 0;
-                bool truncated              = false;
-            };
-
-            ExportCollect exportCollect{&exports, kMaxExportRows, kHardMaxExports, 0, false};
-            peparse::IterExpFull(
-                pe.get(),
-                [](void* ctx, const peparse::VA& va, std::uint16_t ord, const std::string& name, const std::string& /*module*/, const std::string& forwardStr)
-                    -> int
-                {
-                    auto* c = static_cast<ExportCollect*>(ctx);
-                    if (! c)
-                    {
-                        return 0;
-                    }
-
-                    c->seen += 1;
-                    if (c->out && c->out->size() < c->maxRows)
-                    {
-                        ExportRow row{};
-                        row.va      = static_cast<uint64_t>(va);
-                        row.ord     = ord;
-                        row.name    = Utf16FromUtf8(name);
-                        row.forward = Utf16FromUtf8(forwardStr);
-
-                        c->out->push_back(std::move(row));
-                    }
-
-                    if (c->seen >= c->hardMax)
-                    {
-                        c->truncated = true;
-                        return 1;
-                    }
-
-                    return 0;
-                },
-                &exportCollect);
-
-            safeAppendBlankLine();
-            if (exportCollect.seen == 0)
-            {
-                safeAppendLine(L"Exports: (none)");
-            }
-            else
-            {
-                safeAppendFormat(L"Exports: {:L}{}\n", exportCollect.seen, exportCollect.truncated ? L"+" : L"");
-                safeAppendLine(L"Ord   VA                 Name");
-                safeAppendLine(L"----  -----------------  --------------------------------------------");
-                for (const auto& exp : exports)
-                {
-                    if (exp.va != 0)
-                    {
-                        safeAppendFormat(L"{:>4} 0x{:016X}  {}\n", exp.ord, exp.va, exp.name);
-                    }
-                    else if (! exp.forward.empty())
-                    {
-                        safeAppendFormat(L"{:>4} (forwarded)        {} -> {}\n", exp.ord, exp.name, exp.forward);
-                    }
-                    else
-                    {
-                        safeAppendFormat(L"{:>4} (n/a)              {}\n", exp.ord, exp.name);
-                    }
-                }
-                if (exportCollect.seen > exports.size())
-                {
-                    safeAppendFormat(L"... (truncated; showing first {:L} entries)\n", exports.size());
-                }
-            }
-
-            if (st.stop_requested())
-            {
-                return;
-            }
-
-            static constexpr size_t kMaxResourceRows  = 600;
-            static constexpr size_t kHardMaxResources = 6000;
-
-            struct ResourceRow
-            {
-                std::wstring type;
-                std::wstring name;
-                std::wstring lang;
-                std::uint32_t codepage = 0;
-                std::uint32_t rva      = 0;
-                std::uint32_t size     = 0;
-            };
-
-            std::vector<ResourceRow> resources;
-            resources.reserve(128);
-
-            struct ResourceCollect
-            {
-                std::vector<ResourceRow>* out = nullptr;
-                size_t maxRows                = 0;
-                size_t hardMax                = 0;
-                size_t seen                   = 0;
-                bool truncated                = false;
-            };
-
-            ResourceCollect rsrcCollect{&resources, kMaxResourceRows, kHardMaxResources, 0, false};
-            peparse::IterRsrc(
-                pe.get(),
-                [](void* ctx, const peparse::resource& res) -> int
-                {
-                    auto* c = static_cast<ResourceCollect*>(ctx);
-                    if (! c)
-                    {
-                        return 0;
-                    }
-
-                    c->seen += 1;
-                    if (c->out && c->out->size() < c->maxRows)
-                    {
-                        ResourceRow row{};
-                        row.type     = Utf16FromUtf8(res.type_str);
-                        row.name     = Utf16FromUtf8(res.name_str);
-                        row.lang     = Utf16FromUtf8(res.lang_str);
-                        row.codepage = res.codepage;
-                        row.rva      = res.RVA;
-                        row.size     = res.size;
-
-                        if (row.type.empty())
-                        {
-                            row.type = std::to_wstring(res.type);
-                        }
-                        if (row.name.empty())
-                        {
-                            row.name = std::to_wstring(res.name);
-                        }
-                        if (row.lang.empty())
-                        {
-                            row.lang = std::to_wstring(res.lang);
-                        }
-
-                        c->out->push_back(std::move(row));
-                    }
-
-                    if (c->seen >= c->hardMax)
-                    {
-                        c->truncated = true;
-                        return 1;
-                    }
-
-                    return 0;
-                },
-                &rsrcCollect);
-
-            safeAppendBlankLine();
-            if (rsrcCollect.seen == 0)
-            {
-                safeAppendLine(L"Resources: (none)");
+                AppendFormat(body, L"{:<19}  0x{:08X}  0x{:08X}\n", kDataDirectoryNames[i], dir.VirtualAddress, dir.Size);
             }
-            else
-            {
-                safeAppendFormat(L"Resources: {:L}{}\n", rsrcCollect.seen, rsrcCollect.truncated ? L"+" : L"");
-                safeAppendLine(L"RVA        Size       CodePage  Type / Name / Lang");
-                safeAppendLine(L"---------  ---------  --------  ---------------------------------------");
-                for (const auto& res : resources)
-                {
-                    safeAppendFormat(L"0x{:08X} 0x{:08X} {:>8}  {}/{}/{}\n", res.rva, res.size, res.codepage, res.type, res.name, res.lang);
-                }
-                if (rsrcCollect.seen > resources.size())
-                {
-                    safeAppendFormat(L"... (truncated; showing first {:L} entries)\n", resources.size());
-                }
-            }
-
-            if (st.stop_requested())
-            {
-                return;
-            }
-
-            static constexpr size_t kMaxRelocRows  = 600;
-            static constexpr size_t kHardMaxRelocs = 20000;
-
-            struct RelocRow
-            {
-                uint64_t va              = 0;
-                peparse::reloc_type type = peparse::RELOC_ABSOLUTE;
-            };
-
-            std::vector<RelocRow> relocs;
-            relocs.reserve(256);
-
-            struct RelocCollect
-            {
-                std::vector<RelocRow>* out = nullptr;
-                size_t maxRows             = 0;
-                size_t hardMax             = 0;
-                size_t seen                = 0;
-                bool truncated             = false;
-            };
-
-            RelocCollect relocCollect{&relocs, kMaxRelocRows, kHardMaxRelocs, 0, false};
-            peparse::IterRelocs(
-                pe.get(),
-                [](void* ctx, const peparse::VA& va, const peparse::reloc_type& type) -> int
-                {
-                    auto* c = static_cast<RelocCollect*>(ctx);
-                    if (! c)
-                    {
-                        return 0;
-                    }
-
-                    c->seen += 1;
-                    if (c->out && c->out->size() < c->maxRows)
-                    {
-                        RelocRow row{};
-                        row.va   = static_cast<uint64_t>(va);
-                        row.type = type;
-
-                        c->out->push_back(row);
-                    }
-
-                    if (c->seen >= c->hardMax)
-                    {
-                        c->truncated = true;
-                        return 1;
-                    }
 
-                    return 0;
-                },
-                &relocCollect);
+            // Headers are complete at this point; show them while the directory walks and section hashes run.
+            postResult(S_OK, title, subtitle, body + L"\n" + LoadStringResource(g_hInstance, IDS_VIEWERPE_STATUS_LOADING) + L"\n", {}, false);
 
-            safeAppendBlankLine();
-            if (relocCollect.seen == 0)
+            std::array<std::wstring, kDeferredReports.size()> deferredText;
+            std::vector<std::optional<SectionDigest>> sectionHashes;
+            try
             {
-                safeAppendLine(L"Relocations: (none)");
+                sectionHashes.resize(sections.size());
+
+                // One task per deferred report followed by one per section hash; results are joined in task order afterwards.
+                std::vector<size_t> tasks(kDeferredReports.size() + sections.size());
+                std::iota(tasks.begin(), tasks.end(), size_t{0});
+                std::for_each(std::execution::par,
+                              tasks.begin(),
+                              tasks.end(),
+                              [&](size_t task) noexcept
+                              {
+                                  if (st.stop_requested())
+                                  {
+                                      return;
+                                  }
+
+                                  if (task < kDeferredReports.size())
+                                  {
+                                      kDeferredReports[task](pe.get(), deferredText[task]);
+                                      return;
+                                  }
+
+                                  const size_t section   = task - kDeferredReports.size();
+                                  sectionHashes[section] = HashSectionRawData(image, sections[section]);
+                              });
             }
-            else
-            {
-                safeAppendFormat(L"Relocations: {:L}{}\n", relocCollect.seen, relocCollect.truncated ? L"+" : L"");
-                safeAppendLine(L"VA                 Type");
-                safeAppendLine(L"-----------------  ----");
-                for (const auto& rel : relocs)
-                {
-                    safeAppendFormat(L"0x{:016X}  {:L}\n", rel.va, static_cast<unsigned long>(rel.type));
-                }
-                if (relocCollect.seen > relocs.size())
-                {
-                    safeAppendFormat(L"... (truncated; showing first {:L} entries)\n", relocs.size());
-                }
-            }
-
-            if (st.stop_requested())
+            catch (const std::bad_alloc&)
             {
+                Debug::Warning(L"ViewerPE: Out of memory while building the report for {}", path);
+                std::wstring markdown = buildMarkdown(subtitle, body);
+                postResult(E_OUTOFMEMORY, title, std::move(subtitle), std::move(body), std::move(markdown));
                 return;
             }
 
-            static constexpr size_t kMaxDebugRows  = 256;
-            static constexpr size_t kHardMaxDebugs = 2000;
-
-            struct DebugRow
-            {
-                std::uint32_t type = 0;
-                std::uint32_t size = 0;
-            };
-
-            std::vector<DebugRow> debugs;
-            debugs.reserve(32);
-
-            struct DebugCollect
-            {
-                std::vector<DebugRow>* out = nullptr;
-                size_t maxRows             = 0;
-                size_t hardMax             = 0;
-                size_t seen                = 0;
-                bool truncated             = false;
-            };
-
-            DebugCollect debugCollect{&debugs, kMaxDebugRows, kHardMaxDebugs, 0, false};
-            peparse::IterDebugs(
-                pe.get(),
-                [](void* ctx, const std::uint32_t& type, const peparse::bounded_buffer* buf) -> int
-                {
-                    auto* c = static_cast<DebugCollect*>(ctx);
-                    if (! c)
-                    {
-                        return 0;
-                    }
-
-                    c->seen += 1;
-                    if (c->out && c->out->size() < c->maxRows)
-                    {
-                        DebugRow row{};
-                        row.type = type;
-                        row.size = buf ? buf->bufLen : 0;
-                        c->out->push_back(row);
-                    }
-
-                    if (c->seen >= c->hardMax)
-                    {
-                        c->truncated = true;
-                        return 1;
-                    }
-
-                    return 0;
-                },
-                &debugCollect);
-
-            safeAppendBlankLine();
-            if (debugCollect.seen == 0)
-            {
-                safeAppendLine(L"Debug Directories: (none)");
-            }
-            else
-            {
-                safeAppendFormat(L"Debug Directories: {:L}{}\n", debugCollect.seen, debugCollect.truncated ? L"+" : L"");
-                safeAppendLine(L"Type       Size");
-                safeAppendLine(L"---------  ---------");
-                for (const auto& dbg : debugs)
-                {
-                    safeAppendFormat(L"{:>9} 0x{:08X}\n", dbg.type, dbg.size);
-                }
-                if (debugCollect.seen > debugs.size())
-                {
-                    safeAppendFormat(L"... (truncated; showing first {:L} entries)\n", debugs.size());
-                }
-            }
-
             if (st.stop_requested())
             {
                 return;
             }
 
-            static constexpr size_t kMaxSymbolRows  = 600;
-            static constexpr size_t kHardMaxSymbols = 6000;
-
-            struct SymbolRow
-            {
-                std::wstring name;
-                std::uint32_t value  = 0;
-                std::int16_t section = 0;
-                std::uint16_t type   = 0;
-                std::uint8_t storage = 0;
-                std::uint8_t aux     = 0;
-            };
-
-            std::vector<SymbolRow> symbols;
-            symbols.reserve(128);
-
-            struct SymbolCollect
+            for (const auto& text : deferredText)
             {
-                std::vector<SymbolRow>* out = nullptr;
-                size_t maxRows              = 0;
-                size_t hardMax              = 0;
-                size_t seen                 = 0;
-                bool truncated              = false;
-            };
-
-            SymbolCollect symbolCollect{&symbols, kMaxSymbolRows, kHardMaxSymbols, 0, false};
-            peparse::IterSymbols(
-                pe.get(),
-                [](void* ctx,
-                   const std::string& name,
-                   const std::uint32_t& value,
-                   const std::int16_t& section,
-                   const std::uint16_t& type,
-                   const std::uint8_t& storage,
-                   const std::uint8_t& aux) -> int
-                {
-                    auto* c = static_cast<SymbolCollect*>(ctx);
-                    if (! c)
-                    {
-                        return 0;
-                    }
-
-                    c->seen += 1;
-                    if (c->out && c->out->size() < c->maxRows)
-                    {
-                        SymbolRow row{};
-                        row.name    = Utf16FromUtf8(name);
-                        row.value   = value;
-                        row.section = section;
-                        row.type    = type;
-                        row.storage = storage;
-                        row.aux     = aux;
-
-                        c->out->push_back(std::move(row));
-                    }
-
-                    if (c->seen >= c->hardMax)
-                    {
-                        c->truncated = true;
-                        return 1;
-                    }
-
-                    return 0;
-                },
-                &symbolCollect);
-
-            safeAppendBlankLine();
-            if (symbolCollect.seen == 0)
-            {
-                safeAppendLine(L"Symbols: (none)");
+                body += text;
             }
-            else
-            {
-                safeAppendFormat(L"Symbols: {:L}{}\n", symbolCollect.seen, symbolCollect.truncated ? L"+" : L"");
-                safeAppendLine(L"Value      Sect Type  Stor Aux Name");
-                safeAppendLine(L"---------  ---- ----  ---- --- --------------------------------");
-                for (const auto& sym : symbols)
-                {
-                    safeAppendFormat(L"0x{:08X} {:>4} 0x{:04X} {:>4} {:>3} {}\n", sym.value, sym.section, sym.type, sym.storage, sym.aux, sym.name);
-                }
-                if (symbolCollect.seen > symbols.size())
-                {
-                    safeAppendFormat(L"... (truncated; showing first {:L} entries)\n", symbols.size());
-                }
-            }
-
-            std::wstring title;
-            title = std::filesystem::path(path).filename().wstring();
+            AppendSectionHashesReport(sections, sectionHashes, body);
 
-            std::wstring markdown;
-            const std::wstring mdTitle = title.empty() ? LoadStringResource(g_hInstance, IDS_VIEWERPE_NAME) : title;
-            markdown                   = std::format(L"# {}\n\n{}\n\n```text\n{}\n```\n", mdTitle, subtitle, body);
+            StorePeReport(cacheKey, subtitle, body);
 
-            postResult(S_OK, std::move(title), std::move(subtitle), std::move(body), std::move(markdown));
+            std::wstring markdown = buildMarkdown(subtitle, body);
+            postResult(S_OK, title, std::move(subtitle), std::move(body), std::move(markdown));
         });
 }
 
@@ -2753,7 +2884,7 @@ void ViewerPE::OnAsyncParseComplete(std::unique_ptr<AsyncParseResult> result) no
     _subtitleText = std::move(result->subtitle);
     _bodyText     = std::move(result->body);
     _markdownText = std::move(result->markdown);
-    _isLoading    = false;
+    _isLoading    = ! result->complete;
 
     if (_hWnd)
     {
@@ -2763,8 +2894,8 @@ void ViewerPE::OnAsyncParseComplete(std::unique_ptr<AsyncParseResult> result) no
         SetWindowTextW(_hWnd.get(), title.c_str());
     }
 
+    // StartAsyncParse already reset the scroll position; keep wherever the user scrolled the headers-only report.
     _textLayout.reset();
-    _scrollDip = 0.0f;
     if (_hWnd)
     {
         UpdateMenuState(_hWnd.get());
@@ -2854,7 +2985,19 @@ HRESULT STDMETHODCALLTYPE ViewerPE::Open(const ViewerOpenContext* context) noexc
         static_cast<void>(SetForegroundWindow(_hWnd.get()));
     }
 
-    _fileSystem = context->fileSystem;
+    _fileSystem        = context->fileSystem;
+    _fileSystemIsWin32 = false;
+
+    // Only the local file system plugin hands out Win32 paths that can be memory-mapped directly.
+    wil::com_ptr<IInformations> fileSystemInfo;
+    if (_fileSystem.try_query_to(fileSystemInfo.put()) && fileSystemInfo)
+    {
+        const PluginMetaData* metaData = nullptr;
+        if (SUCCEEDED(fileSystemInfo->GetMetaData(&metaData)) && metaData != nullptr && metaData->shortId != nullptr)
+        {
+            _fileSystemIsWin32 = std::wstring_view(metaData->shortId) == L"file";
+        }
+    }
 
     _currentPath = context->focusedPath;
     _otherFiles.clear();
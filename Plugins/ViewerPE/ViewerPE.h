@@ -108,6 +108,7 @@ private:
         std::wstring subtitle;
         std::wstring body;
         std::wstring markdown;
+        bool complete = true; // false: headers only, the deferred sections follow in a second result
     };
 
     void StartAsyncParse(HWND hwnd, wil::com_ptr<IFileSystem> fileSystem, std::wstring path) noexcept;
@@ -134,6 +135,7 @@ private:
     wil::com_ptr<IHostAlerts> _hostAlerts;
 
     wil::com_ptr<IFileSystem> _fileSystem;
+    bool _fileSystemIsWin32 = false;
     std::wstring _currentPath;
     std::vector<std::wstring> _otherFiles;
     size_t _otherIndex     = 0;
@@ -0,0 +1,724 @@
+#include "ViewerWeb.JsonIndex.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <new>
+#include <string_view>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#endif
+
+#pragma warning(push)
+#pragma warning(disable : 4625 4626 5026 5027 4820 28182) // WIL: deleted copy/move operators and padding
+#include <wil/resource.h>
+#pragma warning(pop)
+
+#pragma warning(push)
+// (C6297) Arithmetic overflow. Results might not be an expected value.
+// (C28182) Dereferencing NULL pointer.
+#pragma warning(disable : 6297 28182)
+#include <yyjson.h>
+#pragma warning(pop)
+
+namespace
+{
+constexpr size_t kScanChunkBytes        = 1024u * 1024u;
+constexpr size_t kCursorBufferBytes     = 64u * 1024u;
+constexpr size_t kMaxInlineScalarBytes  = 64u * 1024u; // Larger strings/numbers are reported by size only
+constexpr yyjson_read_flag kReadFlags   = YYJSON_READ_JSON5;
+constexpr yyjson_write_flag kWriteFlags = YYJSON_WRITE_INF_AND_NAN_AS_NULL;
+
+using unique_yyjson_doc    = wil::unique_any<yyjson_doc*, decltype(&yyjson_doc_free), yyjson_doc_free>;
+using unique_malloc_string = wil::unique_any<char*, decltype(&::free), ::free>;
+
+bool IsJsonWhitespace(uint8_t c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Brackets fold onto '{' / '}' with | 0x20 ('[' is 0x5B, ']' is 0x5D).
+bool IsStructuralByte(uint8_t c, bool ndjson) noexcept
+{
+    const uint8_t folded = static_cast<uint8_t>(c | 0x20u);
+    return folded == '{' || folded == '}' || c == '"' || c == ',' || (ndjson && c == '\n');
+}
+
+// Index of the next '"' or '\\' in [p, p + n), or n.
+size_t FindStringSpecial(const uint8_t* p, size_t n) noexcept
+{
+    size_t i = 0;
+#if defined(_M_X64) || defined(_M_IX86)
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for (; i + 16u <= n; i += 16u)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const int mask  = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+        if (mask != 0)
+        {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned int>(mask)));
+        }
+    }
+#endif
+
+    for (; i < n; ++i)
+    {
+        if (p[i] == '"' || p[i] == '\\')
+        {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Index of the next byte that can change the scanner state outside strings, or n.
+size_t FindStructural(const uint8_t* p, size_t n, bool ndjson) noexcept
+{
+    size_t i = 0;
+#if defined(_M_X64) || defined(_M_IX86)
+    const __m128i fold    = _mm_set1_epi8(0x20);
+    const __m128i open    = _mm_set1_epi8('{');
+    const __m128i close   = _mm_set1_epi8('}');
+    const __m128i quote   = _mm_set1_epi8('"');
+    const __m128i comma   = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8(ndjson ? '\n' : '"');
+    for (; i + 16u <= n; i += 16u)
+    {
+        const __m128i v      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i folded = _mm_or_si128(v, fold);
+        const __m128i hits   = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                                          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, comma)), _mm_cmpeq_epi8(v, newline)));
+        const int mask       = _mm_movemask_epi8(hits);
+        if (mask != 0)
+        {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned int>(mask)));
+        }
+    }
+#endif
+
+    for (; i < n; ++i)
+    {
+        if (IsStructuralByte(p[i], ndjson))
+        {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Sequential buffered reads over an IFileReader with cheap repositioning inside the current buffer.
+class FileCursor final
+{
+public:
+    explicit FileCursor(IFileReader* reader) : _reader(reader), _buffer(kCursorBufferBytes)
+    {
+    }
+
+    HRESULT SeekTo(uint64_t offset) noexcept
+    {
+        if (offset >= _bufferOffset && offset < _bufferOffset + _length)
+        {
+            _pos = static_cast<size_t>(offset - _bufferOffset);
+            return S_OK;
+        }
+
+        uint64_t newPosition = 0;
+        const HRESULT hr     = _reader->Seek(static_cast<__int64>(offset), FILE_BEGIN, &newPosition);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        _bufferOffset = offset;
+        _length       = 0;
+        _pos          = 0;
+        return S_OK;
+    }
+
+    uint64_t Offset() const noexcept
+    {
+        return _bufferOffset + _pos;
+    }
+
+    // S_FALSE at end of file.
+    HRESULT Peek(uint8_t& c) noexcept
+    {
+        if (_pos >= _length)
+        {
+            const HRESULT hr = Fill();
+            if (hr != S_OK)
+            {
+                return hr;
+            }
+        }
+
+        c = _buffer[_pos];
+        return S_OK;
+    }
+
+    void Advance() noexcept
+    {
+        ++_pos;
+    }
+
+    HRESULT SkipWhitespace(uint8_t& c) noexcept
+    {
+        for (;;)
+        {
+            const HRESULT hr = Peek(c);
+            if (hr != S_OK || ! IsJsonWhitespace(c))
+            {
+                return hr;
+            }
+            Advance();
+        }
+    }
+
+private:
+    HRESULT Fill() noexcept
+    {
+        _bufferOffset += _length;
+        _length = 0;
+        _pos    = 0;
+
+        unsigned long read = 0;
+        const HRESULT hr   = _reader->Read(_buffer.data(), static_cast<unsigned long>(_buffer.size()), &read);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        _length = read;
+        return read == 0 ? S_FALSE : S_OK;
+    }
+
+    IFileReader* _reader = nullptr;
+    std::vector<uint8_t> _buffer;
+    uint64_t _bufferOffset = 0;
+    size_t _length         = 0;
+    size_t _pos            = 0;
+};
+
+struct ScannedValue
+{
+    uint64_t begin                                = 0;
+    uint64_t end                                  = 0;
+    const JsonStructuralIndex::Container* indexed = nullptr;
+    bool truncated                                = false;
+};
+
+// Consumes one value at the cursor (which must be on its first byte). Indexed containers are skipped by seeking past them;
+// anything else is copied into `text`. Non-indexed containers are below kJsonIndexedContainerMinBytes by construction, so only
+// scalars longer than kMaxInlineScalarBytes come back truncated.
+HRESULT ScanValue(FileCursor& cursor, const JsonStructuralIndex& index, std::string& text, ScannedValue& value) noexcept
+{
+    text.clear();
+    value       = {};
+    value.begin = cursor.Offset();
+
+    uint8_t c  = 0;
+    HRESULT hr = cursor.Peek(c);
+    if (hr != S_OK)
+    {
+        return FAILED(hr) ? hr : HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    if (c == '{' || c == '[')
+    {
+        value.indexed = index.FindContainer(value.begin);
+        if (value.indexed)
+        {
+            value.end = value.indexed->end;
+            return cursor.SeekTo(value.end);
+        }
+    }
+
+    const size_t captureLimit = (c == '{' || c == '[') ? static_cast<size_t>(kJsonIndexedContainerMinBytes) : kMaxInlineScalarBytes;
+
+    uint32_t depth = 0;
+    bool inString  = false;
+    bool escape    = false;
+    for (;;)
+    {
+        hr = cursor.Peek(c);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        if (hr == S_FALSE)
+        {
+            if (depth != 0 || inString)
+            {
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            }
+            break;
+        }
+
+        bool done = false;
+        if (inString)
+        {
+            if (escape)
+            {
+                escape = false;
+            }
+            else if (c == '\\')
+            {
+                escape = true;
+            }
+            else if (c == '"')
+            {
+                inString = false;
+                done     = depth == 0;
+            }
+        }
+        else if (c == '"')
+        {
+            inString = true;
+        }
+        else if (c == '{' || c == '[')
+        {
+            ++depth;
+        }
+        else if (c == '}' || c == ']')
+        {
+            if (depth == 0)
+            {
+                break; // Closing bracket of the enclosing container
+            }
+            --depth;
+            done = depth == 0;
+        }
+        else if (depth == 0 && (c == ',' || IsJsonWhitespace(c)))
+        {
+            break;
+        }
+
+        if (text.size() < captureLimit)
+        {
+            text.push_back(static_cast<char>(c));
+        }
+        else
+        {
+            value.truncated = true;
+        }
+
+        cursor.Advance();
+        if (done)
+        {
+            break;
+        }
+    }
+
+    value.end = cursor.Offset();
+    if (value.end == value.begin)
+    {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+    return S_OK;
+}
+
+// Re-serializes `text` through yyjson so the page only ever carries well-formed, minified JSON.
+bool AppendNormalizedJson(std::string_view text, std::string& out) noexcept
+{
+    yyjson_read_err err{};
+    unique_yyjson_doc doc(yyjson_read_opts(const_cast<char*>(text.data()), text.size(), kReadFlags, nullptr, &err));
+    if (! doc)
+    {
+        return false;
+    }
+
+    size_t length = 0;
+    unique_malloc_string written(yyjson_write_opts(doc.get(), kWriteFlags, nullptr, &length, nullptr));
+    if (! written)
+    {
+        return false;
+    }
+
+    out.append(written.get(), length);
+    return true;
+}
+
+void AppendPageItem(const std::string* keyText, const std::string& valueText, const ScannedValue& value, bool& firstItem, std::string& out) noexcept
+{
+    if (! firstItem)
+    {
+        out.push_back(',');
+    }
+    firstItem = false;
+
+    out.push_back('{');
+    if (keyText)
+    {
+        out += "\"k\":";
+        if (! AppendNormalizedJson(*keyText, out))
+        {
+            out += "\"\"";
+        }
+        out.push_back(',');
+    }
+
+    if (value.indexed)
+    {
+        out += "\"c\":";
+        AppendJsonIndexContainerRef(*value.indexed, out);
+    }
+    else if (value.truncated)
+    {
+        out += std::format("\"x\":{}", value.end - value.begin);
+    }
+    else
+    {
+        const size_t mark = out.size();
+        out += "\"v\":";
+        if (! AppendNormalizedJson(valueText, out))
+        {
+            out.resize(mark);
+            out += std::format("\"e\":\"Invalid JSON at offset {}\"", value.begin);
+        }
+    }
+    out.push_back('}');
+}
+} // namespace
+
+const JsonStructuralIndex::Container* JsonStructuralIndex::FindContainer(uint64_t begin) const noexcept
+{
+    const auto it =
+        std::lower_bound(containers.begin(), containers.end(), begin, [](const Container& c, uint64_t offset) noexcept { return c.begin < offset; });
+    if (it == containers.end() || it->begin != begin)
+    {
+        return nullptr;
+    }
+    return &*it;
+}
+
+HRESULT BuildJsonStructuralIndex(IFileReader* reader, bool ndjson, const std::atomic<bool>* cancelled, JsonStructuralIndex& index) noexcept
+{
+    index = {};
+    if (! reader)
+    {
+        return E_INVALIDARG;
+    }
+
+    try
+    {
+        HRESULT hr = reader->GetSize(&index.fileSize);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        uint64_t position = 0;
+        hr                = reader->Seek(0, FILE_BEGIN, &position);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        index.ndjson = ndjson;
+
+        struct Frame
+        {
+            uint64_t begin        = 0;
+            uint64_t childCount   = 0;
+            size_t checkpointBase = 0; // Start of this frame's entries in `pending`
+            bool isObject         = false;
+        };
+
+        // Frames nest, so their pending checkpoints form a stack as well; only containers that end up indexed keep theirs.
+        std::vector<Frame> stack;
+        std::vector<uint64_t> pending;
+        std::vector<uint8_t> buffer(kScanChunkBytes);
+
+        bool inString      = false;
+        bool escapePending = false;
+        bool awaitingStart = true; // Next non-whitespace byte starts a root, record or child value
+        bool rootSeen      = false;
+        uint64_t base      = 0;
+
+        for (;;)
+        {
+            if (cancelled && cancelled->load(std::memory_order_relaxed))
+            {
+                return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+            }
+
+            unsigned long read = 0;
+            hr                 = reader->Read(buffer.data(), static_cast<unsigned long>(buffer.size()), &read);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            if (read == 0)
+            {
+                break;
+            }
+
+            const uint8_t* data = buffer.data();
+            const size_t count  = read;
+            size_t i            = 0;
+
+            if (base == 0)
+            {
+                if (count >= 2 && ((data[0] == 0xFF && data[1] == 0xFE) || (data[0] == 0xFE && data[1] == 0xFF)))
+                {
+                    return HRESULT_FROM_WIN32(ERROR_UNSUPPORTED_TYPE);
+                }
+                if (count >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF)
+                {
+                    i = 3;
+                }
+            }
+
+            while (i < count)
+            {
+                if (escapePending)
+                {
+                    escapePending = false;
+                    ++i;
+                    continue;
+                }
+
+                if (inString)
+                {
+                    i += FindStringSpecial(data + i, count - i);
+                    if (i >= count)
+                    {
+                        break;
+                    }
+
+                    if (data[i] == '\\')
+                    {
+                        escapePending = true;
+                    }
+                    else
+                    {
+                        inString = false;
+                    }
+                    ++i;
+                    continue;
+                }
+
+                if (! awaitingStart)
+                {
+                    i += FindStructural(data + i, count - i, ndjson);
+                    if (i >= count)
+                    {
+                        break;
+                    }
+                }
+
+                const uint8_t c       = data[i];
+                const uint64_t offset = base + i;
+                ++i;
+
+                if (IsJsonWhitespace(c))
+                {
+                    if (c == '\n' && ndjson && stack.empty())
+                    {
+                        awaitingStart = true;
+                    }
+                    continue;
+                }
+
+                const bool isClose = c == '}' || c == ']';
+                if (awaitingStart)
+                {
+                    awaitingStart = false;
+                    if (stack.empty())
+                    {
+                        if (ndjson)
+                        {
+                            index.records.push_back(offset);
+                        }
+                        else if (! rootSeen)
+                        {
+                            index.rootOffset = offset;
+                            rootSeen         = true;
+                        }
+                    }
+                    else if (! isClose)
+                    {
+                        Frame& frame = stack.back();
+                        if (frame.childCount % kJsonIndexCheckpointStride == 0)
+                        {
+                            pending.push_back(offset);
+                        }
+                        ++frame.childCount;
+                    }
+                }
+
+                if (c == '"')
+                {
+                    inString = true;
+                }
+                else if (c == '{' || c == '[')
+                {
+                    stack.push_back(Frame{offset, 0, pending.size(), c == '{'});
+                    awaitingStart = true;
+                }
+                else if (c == ',')
+                {
+                    awaitingStart = ! stack.empty();
+                }
+                else if (isClose)
+                {
+                    if (stack.empty() || stack.back().isObject != (c == '}'))
+                    {
+                        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+                    }
+
+                    const Frame frame = stack.back();
+                    stack.pop_back();
+
+                    const uint64_t end = offset + 1u;
+                    if ((stack.empty() && ! ndjson) || end - frame.begin >= kJsonIndexedContainerMinBytes)
+                    {
+                        JsonStructuralIndex::Container container;
+                        container.begin           = frame.begin;
+                        container.end             = end;
+                        container.childCount      = frame.childCount;
+                        container.firstCheckpoint = index.checkpoints.size();
+                        container.checkpointCount = pending.size() - frame.checkpointBase;
+                        container.isObject        = frame.isObject;
+                        index.checkpoints.insert(index.checkpoints.end(), pending.begin() + static_cast<std::ptrdiff_t>(frame.checkpointBase), pending.end());
+                        index.containers.push_back(container);
+                    }
+                    pending.resize(frame.checkpointBase);
+                }
+            }
+
+            base += read;
+        }
+
+        if (inString || ! stack.empty() || (! ndjson && ! rootSeen))
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+
+        // Containers were emitted as they closed (children first).
+        std::sort(index.containers.begin(), index.containers.end(), [](const auto& a, const auto& b) noexcept { return a.begin < b.begin; });
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        index = {};
+        return E_OUTOFMEMORY;
+    }
+}
+
+HRESULT AppendJsonIndexPageItems(
+    IFileReader* reader, const JsonStructuralIndex& index, bool records, uint64_t containerOffset, uint64_t first, uint32_t count, std::string& out) noexcept
+{
+    if (! reader)
+    {
+        return E_INVALIDARG;
+    }
+
+    FileCursor cursor(reader);
+    std::string keyText;
+    std::string valueText;
+    ScannedValue value;
+    bool firstItem = true;
+
+    out.push_back('[');
+
+    if (records)
+    {
+        const uint64_t last = std::min<uint64_t>(first + count, index.records.size());
+        for (uint64_t record = first; record < last; ++record)
+        {
+            HRESULT hr = cursor.SeekTo(index.records[static_cast<size_t>(record)]);
+            if (SUCCEEDED(hr))
+            {
+                hr = ScanValue(cursor, index, valueText, value);
+            }
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            AppendPageItem(nullptr, valueText, value, firstItem, out);
+        }
+
+        out.push_back(']');
+        return S_OK;
+    }
+
+    const JsonStructuralIndex::Container* container = index.FindContainer(containerOffset);
+    if (! container)
+    {
+        return E_INVALIDARG;
+    }
+
+    const uint64_t last = std::min<uint64_t>(first + count, container->childCount);
+    if (first < last && container->checkpointCount > 0)
+    {
+        const size_t checkpoint = static_cast<size_t>(std::min<uint64_t>(first / kJsonIndexCheckpointStride, container->checkpointCount - 1u));
+        HRESULT hr              = cursor.SeekTo(index.checkpoints[container->firstCheckpoint + checkpoint]);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        for (uint64_t child = static_cast<uint64_t>(checkpoint) * kJsonIndexCheckpointStride; child < last; ++child)
+        {
+            uint8_t c = 0;
+            hr        = cursor.SkipWhitespace(c);
+            if (hr == S_OK && container->isObject)
+            {
+                ScannedValue keyValue;
+                hr = ScanValue(cursor, index, keyText, keyValue);
+                if (hr == S_OK)
+                {
+                    hr = cursor.SkipWhitespace(c);
+                }
+                if (hr == S_OK && c != ':')
+                {
+                    hr = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+                }
+                if (hr == S_OK)
+                {
+                    cursor.Advance();
+                    hr = cursor.SkipWhitespace(c);
+                }
+            }
+            if (hr == S_OK)
+            {
+                hr = ScanValue(cursor, index, valueText, value);
+            }
+            if (hr != S_OK)
+            {
+                return FAILED(hr) ? hr : HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            }
+
+            if (child >= first)
+            {
+                AppendPageItem(container->isObject ? &keyText : nullptr, valueText, value, firstItem, out);
+            }
+
+            hr = cursor.SkipWhitespace(c);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            if (hr == S_OK && c == ',')
+            {
+                cursor.Advance();
+            }
+        }
+    }
+
+    out.push_back(']');
+    return S_OK;
+}
+
+void AppendJsonIndexContainerRef(const JsonStructuralIndex::Container& container, std::string& out) noexcept
+{
+    out += std::format("{{\"o\":{},\"obj\":{},\"n\":{},\"b\":{}}}",
+                       container.begin,
+                       container.isObject ? "true" : "false",
+                       container.childCount,
+                       container.end - container.begin);
+}
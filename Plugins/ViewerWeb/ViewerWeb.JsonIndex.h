@@ -0,0 +1,58 @@
+#pragma once
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "PlugInterfaces/FileSystem.h"
+
+// Structural index for JSON documents and NDJSON / JSON Lines files that are too large to load as one yyjson document.
+// BuildJsonStructuralIndex makes one streaming pass over the file and records every container spanning at least
+// kJsonIndexedContainerMinBytes (plus the JSON root), with the offset of every kJsonIndexCheckpointStride-th child.
+// Everything smaller is parsed with yyjson only when a page that contains it is requested.
+// The index accepts strict JSON framing only (no JSON5 comments or single-quoted strings); UTF-16 files are rejected.
+inline constexpr uint64_t kJsonIndexedContainerMinBytes = 32ull * 1024ull;
+inline constexpr uint64_t kJsonIndexCheckpointStride    = 256ull;
+
+struct JsonStructuralIndex
+{
+    struct Container
+    {
+        uint64_t begin         = 0; // Offset of '{' / '['
+        uint64_t end           = 0; // Offset one past the matching '}' / ']'
+        uint64_t childCount    = 0;
+        size_t firstCheckpoint = 0; // checkpoints[firstCheckpoint + i] is the offset of child i * kJsonIndexCheckpointStride
+        size_t checkpointCount = 0;
+        bool isObject          = false;
+    };
+
+    uint64_t fileSize   = 0;
+    uint64_t rootOffset = 0; // JSON: first byte of the root value
+    bool ndjson         = false;
+
+    std::vector<Container> containers; // Sorted by begin
+    std::vector<uint64_t> checkpoints;
+    std::vector<uint64_t> records; // NDJSON: offset of the first byte of each record
+
+    const Container* FindContainer(uint64_t begin) const noexcept;
+};
+
+// Returns HRESULT_FROM_WIN32(ERROR_CANCELLED) when `cancelled` becomes true, HRESULT_FROM_WIN32(ERROR_INVALID_DATA) on unbalanced brackets.
+HRESULT BuildJsonStructuralIndex(IFileReader* reader, bool ndjson, const std::atomic<bool>* cancelled, JsonStructuralIndex& index) noexcept;
+
+// Appends the JSON array of items for children [first, first + count) of the indexed container starting at `containerOffset`,
+// or of NDJSON records [first, first + count) when `records` is true. Each item is an object with:
+//   "k": member key (objects only),
+//   "v": the parsed child value, or "c": {"o":offset,"obj":bool,"n":childCount,"b":bytes} for an indexed container,
+//   or "x": byte size of a scalar too large to inline, or "e": a parse error message.
+HRESULT AppendJsonIndexPageItems(
+    IFileReader* reader, const JsonStructuralIndex& index, bool records, uint64_t containerOffset, uint64_t first, uint32_t count, std::string& out) noexcept;
+
+// Appends {"o":offset,"obj":bool,"n":childCount,"b":bytes} for `container`.
+void AppendJsonIndexContainerRef(const JsonStructuralIndex::Container& container, std::string& out) noexcept;
@@ -1,4 +1,5 @@
 #include "ViewerWeb.h"
+#include "ViewerWeb.JsonIndex.h"
 
 #include <algorithm>
 #include <array>
@@ -53,7 +54,10 @@ extern HINSTANCE g_hInstance;
 namespace
 {
 constexpr UINT kAsyncLoadCompleteMessage = WndMsg::kViewerWebAsyncLoadComplete;
+constexpr UINT kJsonPageReadyMessage     = WndMsg::kViewerWebJsonPageReady;
 constexpr int kHeaderHeightDip           = 28;
+constexpr uint32_t kJsonPageItems        = 200; // Children per indexed page request
+constexpr uint32_t kJsonPageMaxItems     = 1000;
 
 static const int kViewerWebModuleAnchor = 0;
 
@@ -361,6 +365,23 @@ bool StartsWithNoCase(std::wstring_view value, std::wstring_view prefix) noexcep
     return CompareStringOrdinal(value.data(), len, prefix.data(), len, TRUE) == CSTR_EQUAL;
 }
 
+bool EndsWithNoCase(std::wstring_view value, std::wstring_view suffix) noexcept
+{
+    if (value.size() < suffix.size())
+    {
+        return false;
+    }
+
+    const int len = static_cast<int>(suffix.size());
+    return CompareStringOrdinal(value.data() + (value.size() - suffix.size()), len, suffix.data(), len, TRUE) == CSTR_EQUAL;
+}
+
+// NDJSON / JSON Lines: one JSON value per line, never parsed as a single document.
+bool IsJsonLinesPath(std::wstring_view path) noexcept
+{
+    return EndsWithNoCase(path, L".ndjson") || EndsWithNoCase(path, L".jsonl");
+}
+
 // Forward declarations for file-scope helpers defined later in this file.
 bool CopyUnicodeTextToClipboard(HWND hwnd, std::wstring_view text) noexcept;
 [[nodiscard]] bool IsProbablyWin32Path(std::wstring_view path) noexcept;
@@ -547,7 +568,7 @@ constexpr char kViewerJsonSchemaJson[] = R"json({
             "key": "maxDocumentMiB",
             "type": "value",
             "label": "Max document size (MiB)",
-            "description": "Maximum size for in-memory loads.",
+            "description": "Maximum size for in-memory loads. Larger files open in an indexed tree that loads values on demand.",
             "default": 32,
             "min": 1,
             "max": 512
@@ -701,6 +722,12 @@ void ViewerWeb::OnDestroy() noexcept
     _hFindDialog.reset();
     DiscardWebView2();
 
+    if (_loadCancelled)
+    {
+        _loadCancelled->store(true, std::memory_order_relaxed);
+    }
+    _jsonIndex.reset();
+
     if (_tempExtractedPath.has_value() && ! _tempExtractedPath->empty())
     {
         std::error_code ec;
@@ -1852,6 +1879,12 @@ LRESULT ViewerWeb::WndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) noexcept
             OnAsyncLoadComplete(std::move(result));
             return 0;
         }
+        case kJsonPageReadyMessage:
+        {
+            auto request = TakeMessagePayload<JsonPageRequest>(lp);
+            OnJsonPageReady(std::move(request));
+            return 0;
+        }
         case WM_CLOSE: DestroyWindow(hwnd); return 0;
         case WM_NCACTIVATE:
         {
@@ -1882,6 +1915,16 @@ void ViewerWeb::OnAsyncLoadComplete(std::unique_ptr<AsyncLoadResult> result) noe
     }
 
     _statusMessage = result->statusMessage;
+    _jsonIndex     = std::move(result->jsonIndex);
+    _jsonIndexPath = _jsonIndex ? result->path : std::wstring();
+
+    // The indexed page is always a tree, whatever viewMode says.
+    if (HMENU menu = _kind == ViewerWebKind::Json && _hWnd ? GetMenu(_hWnd.get()) : nullptr)
+    {
+        const UINT treeState = (_config.jsonViewMode == JsonViewMode::Tree || _jsonIndex) ? MF_ENABLED : MF_GRAYED;
+        EnableMenuItem(menu, IDM_VIEWERWEB_TOOLS_JSON_EXPAND_ALL, MF_BYCOMMAND | treeState);
+        EnableMenuItem(menu, IDM_VIEWERWEB_TOOLS_JSON_COLLAPSE_ALL, MF_BYCOMMAND | treeState);
+    }
 
     if (FAILED(result->hr))
     {
@@ -2001,6 +2044,74 @@ void ViewerWeb::OnAsyncLoadComplete(std::unique_ptr<AsyncLoadResult> result) noe
     }
 }
 
+void ViewerWeb::OnWebMessage(std::wstring_view messageJson) noexcept
+{
+    // Only the indexed JSON page talks back to the host.
+    if (_kind != ViewerWebKind::Json || ! _jsonIndex || ! _webView)
+    {
+        return;
+    }
+
+    std::string utf8 = Utf8FromUtf16(messageJson);
+    if (utf8.empty())
+    {
+        return;
+    }
+
+    yyjson_read_err err{};
+    unique_yyjson_doc doc(yyjson_read_opts(utf8.data(), utf8.size(), YYJSON_READ_NOFLAG, nullptr, &err));
+    yyjson_val* root = doc ? yyjson_doc_get_root(doc.get()) : nullptr;
+    if (! root || ! yyjson_is_obj(root))
+    {
+        return;
+    }
+
+    const auto getUint = [root](const char* key) noexcept -> uint64_t
+    {
+        yyjson_val* v = yyjson_obj_get(root, key);
+        return yyjson_is_uint(v) ? yyjson_get_uint(v) : 0u;
+    };
+
+    const char* type = yyjson_get_str(yyjson_obj_get(root, "type"));
+    if (! type)
+    {
+        return;
+    }
+
+    const std::string_view typeView(type);
+    const bool records = typeView == "records";
+    if (! records && typeView != "page")
+    {
+        return;
+    }
+
+    const uint64_t pageId = getUint("id");
+    const uint32_t count  = static_cast<uint32_t>(std::min<uint64_t>(getUint("count"), kJsonPageMaxItems));
+    const HRESULT hr      = StartJsonPageRequest(records, getUint("o"), getUint("first"), count, pageId);
+    if (FAILED(hr))
+    {
+        const std::wstring reply =
+            std::format(L"{{\"type\":\"page\",\"id\":{},\"error\":\"Failed to queue page request (hr=0x{:08X}).\"}}", pageId, static_cast<unsigned long>(hr));
+        static_cast<void>(_webView->PostWebMessageAsJson(reply.c_str()));
+    }
+}
+
+void ViewerWeb::OnJsonPageReady(std::unique_ptr<JsonPageRequest> request) noexcept
+{
+    if (! request || request->viewer != this || request->requestId != _openRequestId || ! _webView)
+    {
+        return;
+    }
+
+    const std::wstring message = Utf16FromUtf8(request->messageJson);
+    if (message.empty())
+    {
+        return;
+    }
+
+    static_cast<void>(_webView->PostWebMessageAsJson(message.c_str()));
+}
+
 void ViewerWeb::Layout(HWND hwnd) noexcept
 {
     if (! hwnd)
@@ -2239,7 +2350,7 @@ void ViewerWeb::ApplyTheme(HWND hwnd) noexcept
     HMENU menu = hwnd ? GetMenu(hwnd) : nullptr;
     if (menu)
     {
-        const bool jsonTreeMode = _kind == ViewerWebKind::Json && _config.jsonViewMode == JsonViewMode::Tree;
+        const bool jsonTreeMode = _kind == ViewerWebKind::Json && (_config.jsonViewMode == JsonViewMode::Tree || _jsonIndex);
 
         EnableMenuItem(menu, IDM_VIEWERWEB_VIEW_DEVTOOLS, static_cast<UINT>(MF_BYCOMMAND | (_config.devToolsEnabled ? MF_ENABLED : MF_GRAYED)));
 
@@ -2539,6 +2650,25 @@ HRESULT ViewerWeb::EnsureWebView2(HWND hwnd) noexcept
                                     .get(),
                                 &_navCompletedToken));
 
+                            static_cast<void>(_webView->add_WebMessageReceived(
+                                MakeComCallback<ICoreWebView2WebMessageReceivedEventHandler, ICoreWebView2*, ICoreWebView2WebMessageReceivedEventArgs*>(
+                                    [this](ICoreWebView2* /*sender*/, ICoreWebView2WebMessageReceivedEventArgs* args) -> HRESULT
+                                    {
+                                        if (! args)
+                                        {
+                                            return S_OK;
+                                        }
+
+                                        wil::unique_cotaskmem_string message;
+                                        if (SUCCEEDED(args->get_WebMessageAsJson(message.put())) && message)
+                                        {
+                                            OnWebMessage(message.get());
+                                        }
+                                        return S_OK;
+                                    })
+                                    .get(),
+                                &_webMessageToken));
+
                             static_cast<void>(_webViewController->add_AcceleratorKeyPressed(
                                 MakeComCallback<ICoreWebView2AcceleratorKeyPressedEventHandler,
                                                 ICoreWebView2Controller*,
@@ -2770,11 +2900,13 @@ void ViewerWeb::DiscardWebView2() noexcept
     {
         static_cast<void>(_webView->remove_NavigationStarting(_navStartingToken));
         static_cast<void>(_webView->remove_NavigationCompleted(_navCompletedToken));
+        static_cast<void>(_webView->remove_WebMessageReceived(_webMessageToken));
     }
 
     _navStartingToken  = {};
     _navCompletedToken = {};
     _accelToken        = {};
+    _webMessageToken   = {};
 
     // Close the WebView2 controller. Note: Close() is asynchronous and may have
     // pending I/O operations that complete on thread pool threads. This is why
@@ -2967,6 +3099,13 @@ HRESULT ViewerWeb::StartAsyncLoad(HWND hwnd, const std::wstring& path) noexcept
     _openRequestId += 1u;
     const uint64_t requestId = _openRequestId;
 
+    // A large JSON index pass for the previous file would otherwise keep reading until the end.
+    if (_loadCancelled)
+    {
+        _loadCancelled->store(true, std::memory_order_relaxed);
+    }
+    _loadCancelled = std::make_shared<std::atomic<bool>>(false);
+
     std::unique_ptr<AsyncLoadResult> payload(new (std::nothrow) AsyncLoadResult{});
     if (! payload)
     {
@@ -2978,6 +3117,7 @@ HRESULT ViewerWeb::StartAsyncLoad(HWND hwnd, const std::wstring& path) noexcept
     payload->requestId = requestId;
     payload->path      = path;
     payload->hr        = E_FAIL;
+    payload->cancelled = _loadCancelled;
 
     AddRef();
 
@@ -3310,6 +3450,163 @@ void ViewerWeb::AsyncLoadProc(AsyncLoadResult* payload) noexcept
     }
 
     const uint64_t maxBytes = static_cast<uint64_t>(config.maxDocumentMiB) * 1024ull * 1024ull;
+    const bool jsonLines    = kind == ViewerWebKind::Json && IsJsonLinesPath(result->path);
+    if (kind == ViewerWebKind::Json && (jsonLines || sizeBytes > maxBytes))
+    {
+        // Too large for one in-memory document (or not a single document at all): index the structure in one streaming pass
+        // and let the page pull subtrees, which are parsed individually, through web messages.
+        auto index            = std::make_shared<JsonStructuralIndex>();
+        const HRESULT indexHr = BuildJsonStructuralIndex(reader.get(), jsonLines, result->cancelled.get(), *index);
+        if (FAILED(indexHr))
+        {
+            result->hr = indexHr;
+            if (indexHr == HRESULT_FROM_WIN32(ERROR_UNSUPPORTED_TYPE))
+            {
+                result->statusMessage = std::format(L"UTF-16 JSON documents are limited to {}.", FormatBytesCompact(maxBytes));
+            }
+            else if (indexHr == HRESULT_FROM_WIN32(ERROR_INVALID_DATA))
+            {
+                result->statusMessage = L"Failed to index JSON document (unbalanced brackets or unterminated string).";
+            }
+            else
+            {
+                result->statusMessage = L"Failed to index JSON document.";
+            }
+            postBack(false);
+            return;
+        }
+
+        std::string docJson;
+        if (jsonLines)
+        {
+            docJson = std::format("{{\"ndjson\":true,\"records\":{},\"b\":{}}}", index->records.size(), index->fileSize);
+        }
+        else
+        {
+            const JsonStructuralIndex::Container* rootContainer = index->FindContainer(index->rootOffset);
+            if (! rootContainer)
+            {
+                result->hr            = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+                result->statusMessage = std::format(L"JSON documents over {} must have an object or array root.", FormatBytesCompact(maxBytes));
+                postBack(false);
+                return;
+            }
+
+            docJson = "{\"ndjson\":false,\"root\":";
+            AppendJsonIndexContainerRef(*rootContainer, docJson);
+            docJson += "}";
+        }
+
+        const COLORREF codeBg   = BlendColor(bg, fg, theme.darkMode ? 20u : 10u);
+        const COLORREF border   = BlendColor(bg, fg, theme.darkMode ? 35u : 45u);
+        const COLORREF mutedFg  = BlendColor(bg, fg, 140u);
+        const COLORREF strColor = BlendColor(accent, fg, 60u);
+        const COLORREF numColor = BlendColor(accent, fg, 90u);
+        const COLORREF litColor = BlendColor(accent, fg, 120u);
+
+        std::string html;
+        html.reserve(16384);
+        html += "<!doctype html><html><head><meta charset=\"utf-8\">";
+        html += "<style>";
+        html += ":root{--rs-bg:" + cssRgb(bg) + ";--rs-fg:" + cssRgb(fg) + ";--rs-sel-bg:" + cssRgb(selBg) + ";--rs-sel-fg:" + cssRgb(selFg) +
+                ";--rs-accent:" + cssRgb(accent) + ";--rs-code-bg:" + cssRgb(codeBg) + ";--rs-border:" + cssRgb(border) + ";--rs-muted-fg:" + cssRgb(mutedFg) +
+                ";--rs-string:" + cssRgb(strColor) + ";--rs-number:" + cssRgb(numColor) + ";--rs-literal:" + cssRgb(litColor) + ";}";
+        html += "html,body{height:100%;margin:0;}body{background:var(--rs-bg);color:var(--rs-fg);font-family:Segoe UI,sans-serif;}";
+        html += "::selection{background:var(--rs-sel-bg);color:var(--rs-sel-fg);}";
+        html += "#app{height:100%;box-sizing:border-box;padding:12px;display:flex;flex-direction:column;gap:8px;}";
+        html += "#bar{display:flex;align-items:center;gap:8px;font-size:12px;color:var(--rs-muted-fg);}";
+        html += "#bar input,#bar button{background:var(--rs-code-bg);color:var(--rs-fg);border:1px solid var(--rs-border);border-radius:4px;padding:2px 8px;}";
+        html += "#bar input{width:140px;}";
+        html += "#tree{flex:1;overflow:auto;background:var(--rs-code-bg);border:1px solid var(--rs-border);border-radius:6px;padding:8px 12px;"
+                "font-family:Consolas,ui-monospace,monospace;font-size:13px;line-height:1.45;}";
+        html += ".kids{padding-left:18px;}.row{white-space:pre;}.row.x{cursor:pointer;}.tog{display:inline-block;width:14px;color:var(--rs-muted-fg);}";
+        html += ".key{color:var(--rs-accent);}.str{color:var(--rs-string);}.num{color:var(--rs-number);}.lit{color:var(--rs-literal);}";
+        html += ".muted{color:var(--rs-muted-fg);}.more{color:var(--rs-accent);cursor:pointer;text-decoration:underline;}.err{color:#d13438;}";
+        html += "</style></head><body><div id=\"app\"><div id=\"bar\"><span id=\"info\"></span>";
+        if (jsonLines)
+        {
+            html += "<input id=\"goto\" type=\"number\" min=\"0\" placeholder=\"Record #\"><button id=\"go\">Go</button>";
+        }
+        html += "</div><div id=\"tree\"></div></div>";
+        html += "<script>";
+        html += "(() => {";
+        html += "const initialTheme=" + themeObj + ";";
+        html += "const doc=" + docJson + ";";
+        html += std::format("const pageItems={};", kJsonPageItems);
+        html += "function parseRgb(s){const m=/rgb\\((\\d+),(\\d+),(\\d+)\\)/.exec(s.replace(/\\s+/g,''));return m?{r:+m[1],g:+m[2],b:+m[3]}:{r:0,g:0,b:0};}";
+        html += "function rgb(c){return `rgb(${c.r},${c.g},${c.b})`;}";
+        html += "function blend(u,o,a){const inv=255-a;return "
+                "{r:Math.round((u.r*inv+o.r*a)/255),g:Math.round((u.g*inv+o.g*a)/255),b:Math.round((u.b*inv+o.b*a)/255)};}";
+        html += "function luma(c){return (c.r*299+c.g*587+c.b*114)/1000;}";
+        html += "function applyTheme(t){const "
+                "r=document.documentElement.style;r.setProperty('--rs-bg',t.bg);r.setProperty('--rs-fg',t.fg);r.setProperty('--rs-sel-bg',t.selBg);r."
+                "setProperty('--rs-sel-fg',t.selFg);r.setProperty('--rs-accent',t.accent);const "
+                "bg=parseRgb(t.bg),fg=parseRgb(t.fg),acc=parseRgb(t.accent);const "
+                "dark=luma(bg)<128;r.setProperty('--rs-code-bg',rgb(blend(bg,fg,dark?20:10)));r.setProperty('--rs-border',rgb(blend(bg,fg,dark?35:45)));r."
+                "setProperty('--rs-muted-fg',rgb(blend(bg,fg,140)));r.setProperty('--rs-string',rgb(blend(acc,fg,60)));r.setProperty('--rs-number',rgb("
+                "blend(acc,fg,90)));r.setProperty('--rs-literal',rgb(blend(acc,fg,120)));}";
+        // Page protocol: {type:'page',o,first,count} for an indexed container, {type:'records',first,count} for NDJSON; the host
+        // answers {type:'page',id,items} (see AppendJsonIndexPageItems) or {type:'page',id,error}.
+        html += "const pending=new Map();let nextId=1;";
+        html += "function request(msg){return new Promise((resolve)=>{const "
+                "id=nextId++;msg.id=id;pending.set(id,resolve);window.chrome.webview.postMessage(msg);});}";
+        html += "window.chrome.webview.addEventListener('message',(e)=>{const m=e.data;if(!m||m.type!=='page'){return;}const "
+                "r=pending.get(m.id);if(r){pending.delete(m.id);r(m);}});";
+        html += "function fmtBytes(b){const u=['B','KB','MB','GB','TB'];let "
+                "i=0;while(b>=1024&&i<u.length-1){b/=1024;i++;}return (i?b.toFixed(1):String(b))+' '+u[i];}";
+        html += "function count(n,what){return n.toLocaleString()+' '+what+(n===1?'':'s');}";
+        html += "function el(tag,cls,text){const e=document.createElement(tag);if(cls){e.className=cls;}if(text!==undefined){e.textContent=text;}return e;}";
+        html += "function scalar(v){if(v===null){return el('span','lit','null');}if(typeof v==='string'){return el('span','str',JSON.stringify(v));}"
+                "if(typeof v==='number'){return el('span','num',String(v));}return el('span','lit',String(v));}";
+        html += "function row(label,content,toggle){const r=el('div',toggle?'row x':'row');r.appendChild(el('span','tog',toggle?'\\u25B8':''));"
+                "if(label!==null){r.appendChild(el('span','key',label));r.appendChild(el('span','muted',': '));}r.appendChild(content);return r;}";
+        html += "function leaf(label,content){const w=el('div','node');w.appendChild(row(label,content,false));return w;}";
+        html += "function expandable(label,summary,remote,fill){const w=el('div','node');const r=row(label,el('span','muted',summary),true);const "
+                "kids=el('div','kids');kids.hidden=true;let filled=false;w.rsRemote=remote;w.rsKids=kids;"
+                "w.rsToggle=(open)=>{if(open!==kids.hidden){return;}kids.hidden=!open;r.firstChild.textContent=open?'\\u25BE':'\\u25B8';"
+                "if(open&&!filled){filled=true;fill(kids);}};r.addEventListener('click',()=>w.rsToggle(kids.hidden));"
+                "w.appendChild(r);w.appendChild(kids);return w;}";
+        html += "function node(label,it){if(it.e!==undefined){return leaf(label,el('span','err',it.e));}"
+                "if(it.x!==undefined){return leaf(label,el('span','muted','string, '+fmtBytes(it.x)+' (not shown)'));}"
+                "if(it.c){const c=it.c;return expandable(label,(c.obj?'{\\u2026} ':'[\\u2026] ')+count(c.n,c.obj?'key':'item')+', "
+                "'+fmtBytes(c.b),true,(kids)=>loadPage(kids,{type:'page',o:c.o},c.n,c.obj,0));}"
+                "const v=it.v;if(v!==null&&typeof v==='object'){const arr=Array.isArray(v);const keys=arr?null:Object.keys(v);"
+                "return expandable(label,(arr?'[\\u2026] ':'{\\u2026} ')+count(arr?v.length:keys.length,arr?'item':'key'),false,(kids)=>{"
+                "if(arr){v.forEach((x,i)=>kids.appendChild(node(String(i),{v:x})));}else{keys.forEach((k)=>kids.appendChild(node(k,{v:v[k]})));}});}"
+                "return leaf(label,scalar(v));}";
+        html += "async function loadPage(kids,base,total,obj,first){const status=el('div','row muted','Loading\\u2026');kids.appendChild(status);"
+                "const m=await request(Object.assign({first:first,count:pageItems},base));status.remove();"
+                "if(m.error){kids.appendChild(el('div','row err',m.error));return;}"
+                "m.items.forEach((it,i)=>kids.appendChild(node(obj?(it.k!==undefined?it.k:'?'):String(first+i),it)));"
+                "const next=first+m.items.length;if(next<total&&m.items.length>0){const more=el('div','row more','Show "
+                "'+Math.min(pageItems,total-next).toLocaleString()+' more ('+(total-next).toLocaleString()+' remaining)');"
+                "more.addEventListener('click',()=>{more.remove();loadPage(kids,base,total,obj,next);});kids.appendChild(more);}}";
+        html += "const tree=document.getElementById('tree');let rootNode=null;";
+        html += "function showRoot(first){tree.textContent='';rootNode=doc.ndjson?expandable(null,count(doc.records,'record')+(first?' (from "
+                "#'+first.toLocaleString()+')':''),true,(kids)=>loadPage(kids,{type:'records'},doc.records,false,first)):node(null,{c:doc.root});"
+                "tree.appendChild(rootNode);rootNode.rsToggle(true);}";
+        html += "function expandAll(){for(let pass=0;pass<32;pass++){let changed=false;tree.querySelectorAll('.node').forEach((w)=>{"
+                "if(!w.rsRemote&&w.rsKids&&w.rsKids.hidden){w.rsToggle(true);changed=true;}});if(!changed){break;}}}";
+        html += "function collapseAll(){tree.querySelectorAll('.node').forEach((w)=>{if(w!==rootNode&&w.rsKids&&!w.rsKids.hidden){w.rsToggle(false);}});}";
+        html += "document.getElementById('info').textContent=doc.ndjson?'JSON Lines, '+count(doc.records,'record')+', "
+                "'+fmtBytes(doc.b):'Indexed view, '+fmtBytes(doc.root.b)+', large values load on expand';";
+        html += "const go=document.getElementById('go');if(go){const input=document.getElementById('goto');const jump=()=>{const "
+                "n=Math.max(0,Math.min(doc.records-1,parseInt(input.value,10)||0));showRoot(n);};go.addEventListener('click',jump);"
+                "input.addEventListener('keydown',(e)=>{if(e.key==='Enter'){jump();}});}";
+        html += "window.RS={applyTheme:applyTheme,expandAll:expandAll,collapseAll:collapseAll};";
+        html += "applyTheme(initialTheme);showRoot(0);";
+        html += "})();";
+        html += "</script></body></html>";
+
+        result->statusMessage = jsonLines ? std::format(L"{} records", index->records.size())
+                                          : std::format(L"Indexed ({} large containers)", index->containers.size());
+        result->utf8          = std::move(html);
+        result->jsonIndex     = std::move(index);
+        result->hr            = S_OK;
+        postBack(false);
+        return;
+    }
+
     if (sizeBytes > maxBytes)
     {
         result->hr            = HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
@@ -3574,6 +3871,124 @@ void ViewerWeb::AsyncLoadProc(AsyncLoadResult* payload) noexcept
     postBack(false);
 }
 
+HRESULT ViewerWeb::StartJsonPageRequest(bool records, uint64_t offset, uint64_t first, uint32_t count, uint64_t pageId) noexcept
+{
+    if (! _hWnd || ! _jsonIndex || ! _fileSystem)
+    {
+        return E_FAIL;
+    }
+
+    std::unique_ptr<JsonPageRequest> payload(new (std::nothrow) JsonPageRequest{});
+    if (! payload)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    payload->viewer     = this;
+    payload->hwnd       = _hWnd.get();
+    payload->requestId  = _openRequestId;
+    payload->pageId     = pageId;
+    payload->records    = records;
+    payload->offset     = offset;
+    payload->first      = first;
+    payload->count      = count;
+    payload->path       = _jsonIndexPath;
+    payload->fileSystem = _fileSystem;
+    payload->index      = _jsonIndex;
+
+    AddRef();
+
+    struct JsonPageWorkItem final
+    {
+        JsonPageWorkItem()                                   = default;
+        JsonPageWorkItem(const JsonPageWorkItem&)            = delete;
+        JsonPageWorkItem& operator=(const JsonPageWorkItem&) = delete;
+
+        std::unique_ptr<JsonPageRequest> payload;
+        wil::unique_hmodule moduleKeepAlive;
+    };
+
+    auto ctx = std::unique_ptr<JsonPageWorkItem>(new (std::nothrow) JsonPageWorkItem{});
+    if (! ctx)
+    {
+        Release();
+        return E_OUTOFMEMORY;
+    }
+
+    ctx->payload         = std::move(payload);
+    ctx->moduleKeepAlive = AcquireModuleReferenceFromAddress(&kViewerWebModuleAnchor);
+
+    const BOOL queued = TrySubmitThreadpoolCallback(
+        [](PTP_CALLBACK_INSTANCE /*instance*/, void* context) noexcept
+        {
+            std::unique_ptr<JsonPageWorkItem> ctx(static_cast<JsonPageWorkItem*>(context));
+            if (! ctx || ! ctx->payload)
+            {
+                return;
+            }
+
+            static_cast<void>(ctx->moduleKeepAlive);
+            JsonPageProc(ctx->payload.release());
+        },
+        ctx.get(),
+        nullptr);
+
+    if (queued == 0)
+    {
+        Release();
+        return E_FAIL;
+    }
+
+    ctx.release();
+    return S_OK;
+}
+
+void ViewerWeb::JsonPageProc(JsonPageRequest* payload) noexcept
+{
+    std::unique_ptr<JsonPageRequest> request(payload);
+    if (! request || ! request->viewer)
+    {
+        return;
+    }
+
+    ViewerWeb* self  = request->viewer;
+    auto releaseSelf = wil::scope_exit([&] { self->Release(); });
+
+    // Each page gets its own reader: IFileReader carries a file position, and pages for different nodes may run concurrently.
+    wil::com_ptr<IFileSystemIO> fileIo;
+    wil::com_ptr<IFileReader> reader;
+    HRESULT hr = request->fileSystem && request->index ? request->fileSystem->QueryInterface(__uuidof(IFileSystemIO), fileIo.put_void()) : E_FAIL;
+    if (SUCCEEDED(hr))
+    {
+        hr = fileIo ? fileIo->CreateFileReader(request->path.c_str(), reader.put()) : E_NOINTERFACE;
+    }
+
+    request->messageJson = std::format("{{\"type\":\"page\",\"id\":{},\"items\":", request->pageId);
+    if (SUCCEEDED(hr))
+    {
+        hr = reader ? AppendJsonIndexPageItems(
+                          reader.get(), *request->index, request->records, request->offset, request->first, request->count, request->messageJson)
+                    : E_FAIL;
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        request->messageJson += "}";
+    }
+    else
+    {
+        request->messageJson = std::format("{{\"type\":\"page\",\"id\":{},\"error\":\"Failed to read this part of the file (hr=0x{:08X}).\"}}",
+                                           request->pageId,
+                                           static_cast<unsigned long>(hr));
+    }
+
+    const HWND hwnd = request->hwnd;
+    if (hwnd)
+    {
+        static_cast<void>(PostMessagePayload(hwnd, kJsonPageReadyMessage, 0, std::move(request)));
+    }
+}
+
 HRESULT ViewerWeb::CommandSaveAs(HWND hwnd) noexcept
 {
     if (_currentPath.empty() || ! _fileSystem)
@@ -3852,7 +4267,7 @@ void ViewerWeb::CommandToggleDevTools() noexcept
 
 void ViewerWeb::CommandJsonExpandAll() noexcept
 {
-    if (_kind != ViewerWebKind::Json || _config.jsonViewMode != JsonViewMode::Tree || ! _webView)
+    if (_kind != ViewerWebKind::Json || (_config.jsonViewMode != JsonViewMode::Tree && ! _jsonIndex) || ! _webView)
     {
         return;
     }
@@ -3862,7 +4277,7 @@ void ViewerWeb::CommandJsonExpandAll() noexcept
 
 void ViewerWeb::CommandJsonCollapseAll() noexcept
 {
-    if (_kind != ViewerWebKind::Json || _config.jsonViewMode != JsonViewMode::Tree || ! _webView)
+    if (_kind != ViewerWebKind::Json || (_config.jsonViewMode != JsonViewMode::Tree && ! _jsonIndex) || ! _webView)
     {
         return;
     }
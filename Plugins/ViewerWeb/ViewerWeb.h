@@ -30,6 +30,8 @@
 #include "PlugInterfaces/Informations.h"
 #include "PlugInterfaces/Viewer.h"
 
+struct JsonStructuralIndex;
+
 enum class ViewerWebKind : uint8_t
 {
     Web,
@@ -101,6 +103,25 @@ private:
         std::string utf8;
         std::wstring statusMessage;
         std::optional<std::filesystem::path> extractedWin32Path;
+        std::shared_ptr<const JsonStructuralIndex> jsonIndex;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    // One page of children requested by the indexed JSON page; served from a fresh reader on the thread pool.
+    struct JsonPageRequest
+    {
+        ViewerWeb* viewer  = nullptr;
+        HWND hwnd          = nullptr;
+        uint64_t requestId = 0; // _openRequestId the index belongs to
+        uint64_t pageId    = 0; // Correlation id chosen by the page script
+        bool records       = false;
+        uint64_t offset    = 0;
+        uint64_t first     = 0;
+        uint32_t count     = 0;
+        std::wstring path;
+        wil::com_ptr<IFileSystem> fileSystem;
+        std::shared_ptr<const JsonStructuralIndex> index;
+        std::string messageJson;
     };
 
     static ATOM RegisterWndClass(HINSTANCE instance) noexcept;
@@ -122,6 +143,8 @@ private:
     LRESULT OnMeasureItem(HWND hwnd, MEASUREITEMSTRUCT* measure) noexcept;
     LRESULT OnDrawItem(HWND hwnd, DRAWITEMSTRUCT* draw) noexcept;
     void OnAsyncLoadComplete(std::unique_ptr<AsyncLoadResult> result) noexcept;
+    void OnWebMessage(std::wstring_view messageJson) noexcept;
+    void OnJsonPageReady(std::unique_ptr<JsonPageRequest> request) noexcept;
 
     void Layout(HWND hwnd) noexcept;
     void ComputeLayoutRects(HWND hwnd) noexcept;
@@ -140,6 +163,8 @@ private:
 
     HRESULT StartAsyncLoad(HWND hwnd, const std::wstring& path) noexcept;
     static void AsyncLoadProc(AsyncLoadResult* payload) noexcept;
+    HRESULT StartJsonPageRequest(bool records, uint64_t offset, uint64_t first, uint32_t count, uint64_t pageId) noexcept;
+    static void JsonPageProc(JsonPageRequest* payload) noexcept;
 
     HRESULT CommandSaveAs(HWND hwnd) noexcept;
     void CommandFind(HWND hwnd) noexcept;
@@ -201,6 +226,11 @@ private:
 
     uint64_t _openRequestId = 0;
     std::wstring _statusMessage;
+    std::shared_ptr<std::atomic<bool>> _loadCancelled;
+
+    // Set while the current JSON document is shown from its structural index (large JSON, NDJSON / JSON Lines).
+    std::shared_ptr<const JsonStructuralIndex> _jsonIndex;
+    std::wstring _jsonIndexPath;
 
     std::optional<std::wstring> _pendingPath;
     std::optional<std::wstring> _pendingWebContent;
@@ -216,6 +246,7 @@ private:
     EventRegistrationToken _navStartingToken{};
     EventRegistrationToken _navCompletedToken{};
     EventRegistrationToken _accelToken{};
+    EventRegistrationToken _webMessageToken{};
 
     wil::unique_hwnd _hFindDialog;
     std::array<wchar_t, 256> _findBuffer{};
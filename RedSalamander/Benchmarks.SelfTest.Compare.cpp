@@ -0,0 +1,450 @@
+#include "Benchmarks.SelfTestInternal.h"
+
+#include "Framework.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CompareDirectoriesEngine.h"
+#include "SettingsStore.h"
+
+namespace
+{
+constexpr size_t kCompareFolderCount    = 8;
+constexpr size_t kCompareFilesPerFolder = 250;
+constexpr size_t kCompareJoinStride     = 7919; // prime: emits synthetic listings in a scrambled (unsorted) order
+
+// Immutable FileInfo arena handed out by SyntheticCompareFileSystem.
+class SyntheticFilesInformation final : public IFilesInformation
+{
+public:
+    SyntheticFilesInformation(std::vector<std::byte> buffer, std::vector<unsigned long> offsets) noexcept
+        : _buffer(std::move(buffer)),
+          _offsets(std::move(offsets))
+    {
+    }
+
+    SyntheticFilesInformation(const SyntheticFilesInformation&)            = delete;
+    SyntheticFilesInformation& operator=(const SyntheticFilesInformation&) = delete;
+    SyntheticFilesInformation(SyntheticFilesInformation&&)                 = delete;
+    SyntheticFilesInformation& operator=(SyntheticFilesInformation&&)      = delete;
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) noexcept override
+    {
+        if (ppvObject == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(IFilesInformation))
+        {
+            *ppvObject = static_cast<IFilesInformation*>(this);
+            AddRef();
+            return S_OK;
+        }
+
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() noexcept override
+    {
+        return _refCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    ULONG STDMETHODCALLTYPE Release() noexcept override
+    {
+        const ULONG current = _refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (current == 0)
+        {
+            delete this;
+        }
+        return current;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetBuffer(FileInfo** ppFileInfo) noexcept override
+    {
+        if (ppFileInfo == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        *ppFileInfo = _buffer.empty() ? nullptr : reinterpret_cast<FileInfo*>(_buffer.data());
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetBufferSize(unsigned long* pSize) noexcept override
+    {
+        if (pSize == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        *pSize = static_cast<unsigned long>(_buffer.size());
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetAllocatedSize(unsigned long* pSize) noexcept override
+    {
+        if (pSize == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        *pSize = static_cast<unsigned long>(_buffer.capacity());
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetCount(unsigned long* pCount) noexcept override
+    {
+        if (pCount == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        *pCount = static_cast<unsigned long>(_offsets.size());
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE Get(unsigned long index, FileInfo** ppEntry) noexcept override
+    {
+        if (ppEntry == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        *ppEntry = nullptr;
+        if (index >= _offsets.size())
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_INDEX);
+        }
+
+        *ppEntry = reinterpret_cast<FileInfo*>(_buffer.data() + _offsets[index]);
+        return S_OK;
+    }
+
+private:
+    ~SyntheticFilesInformation() = default;
+
+    std::atomic_ulong _refCount{1};
+    std::vector<std::byte> _buffer;
+    std::vector<unsigned long> _offsets;
+};
+
+// Builds one side of a synthetic compare pair of `count` files (count must be a multiple of 10). The right side drops every
+// tenth left name, adds as many right-only names, changes the size of another tenth and upper-cases every seventh name, so
+// the join sees left-only, right-only, case-folded and differing pairs.
+[[nodiscard]] wil::com_ptr<IFilesInformation> BuildSyntheticCompareListing(size_t count, bool rightSide) noexcept
+{
+    std::vector<std::byte> buffer;
+    std::vector<unsigned long> offsets;
+    try
+    {
+        offsets.reserve(count);
+        buffer.reserve(count * ((offsetof(FileInfo, FileName) + 18u * sizeof(wchar_t) + 3u) & ~size_t{3u}));
+
+        std::wstring name;
+        for (size_t k = 0; k < count; ++k)
+        {
+            const size_t i = (k * kCompareJoinStride) % count;
+            uint64_t size  = 64u + (i % 13u);
+            if (! rightSide)
+            {
+                name = std::format(L"entry_{:07}.dat", i);
+            }
+            else if (i % 10u == 0u)
+            {
+                name = std::format(L"extra_{:07}.dat", i);
+            }
+            else
+            {
+                name = std::format(i % 7u == 0u ? L"ENTRY_{:07}.DAT" : L"entry_{:07}.dat", i);
+                size += (i % 10u == 5u) ? 1u : 0u;
+            }
+
+            const size_t entryBytes = (offsetof(FileInfo, FileName) + (name.size() + 1u) * sizeof(wchar_t) + 3u) & ~size_t{3u};
+            const size_t offset     = buffer.size();
+            buffer.resize(offset + entryBytes, std::byte{0});
+            offsets.push_back(static_cast<unsigned long>(offset));
+
+            auto* entry           = reinterpret_cast<FileInfo*>(buffer.data() + offset);
+            entry->FileAttributes = FILE_ATTRIBUTE_ARCHIVE;
+            entry->EndOfFile      = static_cast<__int64>(size);
+            entry->AllocationSize = static_cast<__int64>(size);
+            entry->LastWriteTime  = 133'000'000'000'000'000ll + static_cast<__int64>(i);
+            entry->FileNameSize   = static_cast<unsigned long>(name.size() * sizeof(wchar_t));
+            std::memcpy(entry->FileName, name.data(), name.size() * sizeof(wchar_t));
+        }
+
+        for (size_t k = 0; k + 1u < offsets.size(); ++k)
+        {
+            reinterpret_cast<FileInfo*>(buffer.data() + offsets[k])->NextEntryOffset = offsets[k + 1u] - offsets[k];
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+
+    wil::com_ptr<IFilesInformation> info;
+    info.attach(new (std::nothrow) SyntheticFilesInformation(std::move(buffer), std::move(offsets)));
+    return info;
+}
+
+// In-memory IFileSystem serving fixed listings by path: isolates the compare engine's join cost from enumeration I/O.
+class SyntheticCompareFileSystem final : public IFileSystem
+{
+public:
+    SyntheticCompareFileSystem() = default;
+
+    SyntheticCompareFileSystem(const SyntheticCompareFileSystem&)            = delete;
+    SyntheticCompareFileSystem& operator=(const SyntheticCompareFileSystem&) = delete;
+    SyntheticCompareFileSystem(SyntheticCompareFileSystem&&)                 = delete;
+    SyntheticCompareFileSystem& operator=(SyntheticCompareFileSystem&&)      = delete;
+
+    void SetListing(const wchar_t* path, wil::com_ptr<IFilesInformation> info)
+    {
+        _listings[MakeKey(path)] = std::move(info);
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) noexcept override
+    {
+        if (ppvObject == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(IFileSystem))
+        {
+            *ppvObject = static_cast<IFileSystem*>(this);
+            AddRef();
+            return S_OK;
+        }
+
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() noexcept override
+    {
+        return _refCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    ULONG STDMETHODCALLTYPE Release() noexcept override
+    {
+        const ULONG current = _refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (current == 0)
+        {
+            delete this;
+        }
+        return current;
+    }
+
+    HRESULT STDMETHODCALLTYPE ReadDirectoryInfo(const wchar_t* path, IFilesInformation** ppFilesInformation) noexcept override
+    {
+        if (path == nullptr || ppFilesInformation == nullptr)
+        {
+            return E_POINTER;
+        }
+
+        *ppFilesInformation = nullptr;
+        try
+        {
+            const auto it = _listings.find(MakeKey(path));
+            if (it == _listings.end() || ! it->second)
+            {
+                return HRESULT_FROM_WIN32(ERROR_PATH_NOT_FOUND);
+            }
+
+            *ppFilesInformation = it->second.get();
+        }
+        catch (const std::bad_alloc&)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        (*ppFilesInformation)->AddRef();
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE CopyItem(const wchar_t*, const wchar_t*, FileSystemFlags, const FileSystemOptions*, IFileSystemCallback*, void*) noexcept override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE MoveItem(const wchar_t*, const wchar_t*, FileSystemFlags, const FileSystemOptions*, IFileSystemCallback*, void*) noexcept override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE DeleteItem(const wchar_t*, FileSystemFlags, const FileSystemOptions*, IFileSystemCallback*, void*) noexcept override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    RenameItem(const wchar_t*, const wchar_t*, FileSystemFlags, const FileSystemOptions*, IFileSystemCallback*, void*) noexcept override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    CopyItems(const wchar_t* const*, unsigned long, const wchar_t*, FileSystemFlags, const FileSystemOptions*, IFileSystemCallback*, void*) noexcept override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    MoveItems(const wchar_t* const*, unsigned long, const wchar_t*, FileSystemFlags, const FileSystemOptions*, IFileSystemCallback*, void*) noexcept override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    DeleteItems(const wchar_t* const*, unsigned long, FileSystemFlags, const FileSystemOptions*, IFileSystemCallback*, void*) noexcept override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    RenameItems(const FileSystemRenamePair*, unsigned long, FileSystemFlags, const FileSystemOptions*, IFileSystemCallback*, void*) noexcept override
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetCapabilities(const char** jsonUtf8) noexcept override
+    {
+        if (jsonUtf8 != nullptr)
+        {
+            *jsonUtf8 = nullptr;
+        }
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+private:
+    ~SyntheticCompareFileSystem() = default;
+
+    // The engine asks for (root / relative).lexically_normal(), which may carry a trailing separator.
+    [[nodiscard]] static std::wstring MakeKey(const wchar_t* path)
+    {
+        std::wstring key = std::filesystem::path(path).lexically_normal().wstring();
+        while (key.size() > 1u && (key.back() == L'\\' || key.back() == L'/'))
+        {
+            key.pop_back();
+        }
+        return key;
+    }
+
+    std::atomic_ulong _refCount{1};
+    std::unordered_map<std::wstring, wil::com_ptr<IFilesInformation>> _listings;
+};
+} // namespace
+
+namespace BenchmarksSelfTest
+{
+void RunCompareCases(const Context& context) noexcept
+{
+    const BaselineMap& baselines             = context.baselines;
+    const wil::com_ptr<IFileSystem>& localFs = context.localFs;
+    const std::filesystem::path& workRoot    = context.workRoot;
+
+    SelfTest::RunCase(context.options, context.suite, L"compare.local.scan", [&](SelfTest::CaseState& state) noexcept
+    {
+        // Compare Directories scan (size + time, no content) of two local trees with ~10% differences.
+        const std::filesystem::path left  = workRoot / L"compare" / L"left";
+        const std::filesystem::path right = workRoot / L"compare" / L"right";
+        bool created                      = RecreateDirectory(left) && RecreateDirectory(right);
+        for (size_t folderIndex = 0; created && folderIndex < kCompareFolderCount; ++folderIndex)
+        {
+            const std::wstring folderName = std::format(L"dir_{:02}", folderIndex);
+            created                       = SelfTest::EnsureDirectory(left / folderName) && SelfTest::EnsureDirectory(right / folderName);
+            for (size_t i = 0; created && i < kCompareFilesPerFolder; ++i)
+            {
+                const std::wstring fileName = std::format(L"item_{:04}.bin", i);
+                const uint64_t size         = 64u + (i % 13u);
+                created                     = CreateFilledFile(left / folderName / fileName, size, static_cast<uint8_t>(i));
+                if (created && i % 10u != 0u)
+                {
+                    created = CreateFilledFile(right / folderName / fileName, (i % 10u == 5u) ? size + 1u : size, static_cast<uint8_t>(i));
+                }
+            }
+        }
+        if (! state.Require(created, L"Failed to create compare trees."))
+        {
+            return false;
+        }
+
+        Common::Settings::CompareDirectoriesSettings settings{};
+        settings.compareSize = true;
+
+        const uint64_t entries = static_cast<uint64_t>(kCompareFolderCount * kCompareFilesPerFolder);
+        return Measure(state, L"compare.local.scan", baselines, entries, 0, [&](Stopwatch& stopwatch) noexcept
+        {
+            stopwatch.Start();
+            auto session      = std::make_shared<CompareDirectoriesSession>(localFs, left, right, settings);
+            auto rootDecision = session->GetOrComputeDecision(std::filesystem::path{});
+            bool ok           = rootDecision && SUCCEEDED(rootDecision->hr);
+            for (size_t folderIndex = 0; ok && folderIndex < kCompareFolderCount; ++folderIndex)
+            {
+                auto decision = session->GetOrComputeDecision(std::filesystem::path(std::format(L"dir_{:02}", folderIndex)));
+                ok            = decision && SUCCEEDED(decision->hr) && decision->anyDifferent;
+            }
+            stopwatch.Stop();
+            return ok;
+        });
+    });
+
+    for (const size_t joinEntries : {size_t{100'000}, size_t{1'000'000}})
+    {
+        const std::wstring caseName = joinEntries >= 1'000'000u ? L"compare.synthetic.join.1m" : L"compare.synthetic.join.100k";
+        SelfTest::RunCase(context.options, context.suite, caseName, [&](SelfTest::CaseState& state) noexcept
+        {
+            // Compare Directories join of one synthetic folder pair served from memory (listing sort, merge join, decisions).
+            const std::filesystem::path leftRoot(L"/left");
+            const std::filesystem::path rightRoot(L"/right");
+            wil::com_ptr<SyntheticCompareFileSystem> syntheticFs;
+            syntheticFs.attach(new (std::nothrow) SyntheticCompareFileSystem());
+            wil::com_ptr<IFilesInformation> leftInfo  = BuildSyntheticCompareListing(joinEntries, false);
+            wil::com_ptr<IFilesInformation> rightInfo = BuildSyntheticCompareListing(joinEntries, true);
+            if (! state.Require(syntheticFs && leftInfo && rightInfo, L"Failed to build synthetic compare listings."))
+            {
+                return false;
+            }
+
+            try
+            {
+                syntheticFs->SetListing(leftRoot.c_str(), std::move(leftInfo));
+                syntheticFs->SetListing(rightRoot.c_str(), std::move(rightInfo));
+            }
+            catch (const std::bad_alloc&)
+            {
+                return state.Require(false, L"Out of memory while registering synthetic compare listings.");
+            }
+
+            Common::Settings::CompareDirectoriesSettings settings{};
+            settings.compareSize = true;
+
+            const wil::com_ptr<IFileSystem> fileSystem = syntheticFs.query<IFileSystem>();
+            const size_t expectedItems                 = joinEntries + joinEntries / 10u;
+            return Measure(state, caseName, baselines, joinEntries * 2u, 0, [&](Stopwatch& stopwatch) noexcept
+            {
+                auto session = std::make_shared<CompareDirectoriesSession>(fileSystem, leftRoot, rightRoot, settings);
+                stopwatch.Start();
+                auto decision = session->GetOrComputeDecision(std::filesystem::path{});
+                stopwatch.Stop();
+                return decision && SUCCEEDED(decision->hr) && decision->anyDifferent && decision->items.size() == expectedItems;
+            });
+        });
+    }
+}
+} // namespace BenchmarksSelfTest
@@ -0,0 +1,491 @@
+#include "Benchmarks.SelfTestInternal.h"
+
+#include "Framework.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "FolderWindow.FileOperationsInternal.h"
+#include "FolderWindow.h"
+#include "SettingsStore.h"
+
+extern Common::Settings::Settings g_settings;
+
+namespace
+{
+constexpr size_t kSmallFileCount          = 500;
+constexpr size_t kSmallFileBytes          = 4u * 1024u;
+constexpr uint64_t kLargeFileBytes        = 64ull * 1024ull * 1024ull;
+constexpr uint64_t kLargeUnalignedBytes   = kLargeFileBytes + 12345ull; // not a sector multiple: exercises the unbuffered tail read
+constexpr size_t kSmallTreeFolders        = 20;
+constexpr size_t kSmallTreeFilesPerFolder = 500;
+constexpr size_t kSmallTreeFileBytes      = 1024u;
+
+constexpr std::wstring_view kFolderWindowClassName = L"RedSalamander.FolderWindow";
+constexpr unsigned long kBridgeDummyMaxChildren    = 24;
+constexpr unsigned long kBridgeDummyLatencyMs      = 1; // per open / per listed child: stands in for a remote plugin
+constexpr ULONGLONG kBridgeTaskTimeoutMs           = 120'000;
+
+[[nodiscard]] FolderWindow::FileOperationState* TryGetFileOperations(HWND mainWindow) noexcept
+{
+    const HWND folderWindowHwnd = mainWindow ? FindWindowExW(mainWindow, nullptr, kFolderWindowClassName.data(), nullptr) : nullptr;
+    if (! folderWindowHwnd)
+    {
+        return nullptr;
+    }
+
+    auto* folderWindow = reinterpret_cast<FolderWindow*>(GetWindowLongPtrW(folderWindowHwnd, GWLP_USERDATA));
+    return folderWindow ? folderWindow->BenchmarkGetFileOperationState() : nullptr;
+}
+
+// Runs one cross-filesystem copy task through FileOperationState (the real bridge path, pre-calc included) and pumps
+// messages on the calling UI thread until the task has recorded its completion summary.
+[[nodiscard]] HRESULT RunBridgeCopyTask(FolderWindow::FileOperationState& fileOps,
+                                        const wil::com_ptr<IFileSystem>& sourceFs,
+                                        const wil::com_ptr<IFileSystem>& destinationFs,
+                                        const std::filesystem::path& source,
+                                        const std::filesystem::path& destinationFolder) noexcept
+{
+    std::vector<FolderWindow::FileOperationState::Task*> tasks;
+    fileOps.CollectTasks(tasks);
+    std::vector<uint64_t> existingIds;
+    existingIds.reserve(tasks.size());
+    for (const auto* task : tasks)
+    {
+        if (task)
+        {
+            existingIds.push_back(task->GetId());
+        }
+    }
+
+    const FileSystemFlags flags = static_cast<FileSystemFlags>(FILESYSTEM_FLAG_RECURSIVE | FILESYSTEM_FLAG_ALLOW_OVERWRITE);
+
+    HRESULT hr = fileOps.StartOperation(FILESYSTEM_COPY,
+                                        FolderWindow::Pane::Left,
+                                        FolderWindow::Pane::Right,
+                                        sourceFs,
+                                        {source},
+                                        destinationFolder,
+                                        flags,
+                                        false,
+                                        0,
+                                        FolderWindow::FileOperationState::ExecutionMode::PerItem,
+                                        false,
+                                        destinationFs);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    uint64_t taskId = 0;
+    tasks.clear();
+    fileOps.CollectTasks(tasks);
+    for (const auto* task : tasks)
+    {
+        if (task && std::find(existingIds.begin(), existingIds.end(), task->GetId()) == existingIds.end())
+        {
+            taskId = task->GetId();
+            break;
+        }
+    }
+    if (taskId == 0)
+    {
+        return E_UNEXPECTED;
+    }
+
+    const ULONGLONG deadline = GetTickCount64() + kBridgeTaskTimeoutMs;
+    std::vector<FolderWindow::FileOperationState::CompletedTaskSummary> completed;
+    for (;;)
+    {
+        completed.clear();
+        fileOps.CollectCompletedTasks(completed);
+        const auto it = std::find_if(completed.begin(), completed.end(), [&](const auto& summary) { return summary.taskId == taskId; });
+        if (it != completed.end())
+        {
+            hr = it->resultHr;
+            fileOps.DismissCompletedTask(taskId);
+            return hr;
+        }
+
+        if (GetTickCount64() > deadline)
+        {
+            fileOps.CancelAll();
+            return HRESULT_FROM_WIN32(ERROR_TIMEOUT);
+        }
+
+        static_cast<void>(MsgWaitForMultipleObjects(0, nullptr, FALSE, 5, QS_ALLINPUT));
+        MSG msg{};
+        while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+        {
+            if (msg.message == WM_QUIT)
+            {
+                PostQuitMessage(static_cast<int>(msg.wParam));
+                return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+            }
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+    }
+}
+
+[[nodiscard]] bool CountTree(const std::filesystem::path& root, uint64_t& outFiles, uint64_t& outBytes) noexcept
+{
+    outFiles = 0;
+    outBytes = 0;
+
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(root, ec), end; ! ec && it != end; it.increment(ec))
+    {
+        if (it->is_regular_file(ec))
+        {
+            ++outFiles;
+            outBytes += static_cast<uint64_t>(it->file_size(ec));
+        }
+    }
+    return ! ec;
+}
+
+// Overrides fileOperations.bridgeMaxConcurrentFiles on the live settings read by the FolderWindow; restores on destruction.
+class BridgeConcurrencyOverride
+{
+public:
+    explicit BridgeConcurrencyOverride(std::optional<uint32_t> maxConcurrentFiles) noexcept : _saved(g_settings.fileOperations)
+    {
+        if (! g_settings.fileOperations.has_value())
+        {
+            g_settings.fileOperations.emplace();
+        }
+        g_settings.fileOperations->bridgeMaxConcurrentFiles = maxConcurrentFiles;
+    }
+
+    ~BridgeConcurrencyOverride()
+    {
+        g_settings.fileOperations = std::move(_saved);
+    }
+
+    BridgeConcurrencyOverride(const BridgeConcurrencyOverride&)            = delete;
+    BridgeConcurrencyOverride& operator=(const BridgeConcurrencyOverride&) = delete;
+    BridgeConcurrencyOverride(BridgeConcurrencyOverride&&)                 = delete;
+    BridgeConcurrencyOverride& operator=(BridgeConcurrencyOverride&&)      = delete;
+
+private:
+    std::optional<Common::Settings::FileOperationsSettings> _saved;
+};
+} // namespace
+
+namespace BenchmarksSelfTest
+{
+void RunFileOperationCases(const Context& context) noexcept
+{
+    const BaselineMap& baselines             = context.baselines;
+    const wil::com_ptr<IFileSystem>& localFs = context.localFs;
+    const wil::com_ptr<IFileSystem>& dummyFs = context.dummyFs;
+    const std::filesystem::path& workRoot    = context.workRoot;
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.copy.large", [&](SelfTest::CaseState& state) noexcept
+    {
+        // Single large file copy through the local plugin (throughput is bytes_per_s in results.json).
+        const std::filesystem::path folder = workRoot / L"copy-large";
+        const std::filesystem::path source = folder / L"source.bin";
+        const std::filesystem::path target = folder / L"target.bin";
+        if (! state.Require(RecreateDirectory(folder) && CreateFilledFile(source, kLargeFileBytes, 0x5A), L"Failed to create large copy source."))
+        {
+            return false;
+        }
+
+        return Measure(state, L"fileops.copy.large", baselines, 1, kLargeFileBytes, [&](Stopwatch& stopwatch) noexcept
+        {
+            static_cast<void>(DeleteFileW(target.c_str()));
+            stopwatch.Start();
+            const HRESULT hr = localFs->CopyItem(source.c_str(), target.c_str(), FILESYSTEM_FLAG_ALLOW_OVERWRITE);
+            stopwatch.Stop();
+            return SUCCEEDED(hr);
+        });
+    });
+
+    // Same large file with the copy engine pinned: CopyFileExW vs the unbuffered overlapped engine. The priming copy is
+    // compared byte for byte so an unaligned size also checks the engine's short tail read.
+    const auto runLargeCopyEngineCase = [&](SelfTest::CaseState& state, std::wstring_view caseName, unsigned long thresholdMiB, uint64_t fileBytes) noexcept
+    {
+        const std::string localConfig = std::format("{{\"unbufferedCopyThresholdMiB\":{}}}", thresholdMiB);
+        const SelfTest::PluginConfigurationGuard localConfigGuard(localFs.get(), localConfig);
+        if (! state.Require(localConfigGuard.Applied(), L"FileSystem: failed to set copy engine configuration."))
+        {
+            return false;
+        }
+
+        const std::filesystem::path folder = workRoot / L"copy-large-engine";
+        const std::filesystem::path source = folder / L"source.bin";
+        const std::filesystem::path target = folder / L"target.bin";
+        if (! state.Require(RecreateDirectory(folder) && CreateFilledFile(source, fileBytes, 0x3C), L"Failed to create large copy source."))
+        {
+            return false;
+        }
+
+        if (! state.Require(SUCCEEDED(localFs->CopyItem(source.c_str(), target.c_str(), FILESYSTEM_FLAG_ALLOW_OVERWRITE)) &&
+                                FileContentsEqual(source, target),
+                            L"Large copy: priming copy failed or differs from the source."))
+        {
+            return false;
+        }
+
+        return Measure(state, caseName, baselines, 1, fileBytes, [&](Stopwatch& stopwatch) noexcept
+        {
+            static_cast<void>(DeleteFileW(target.c_str()));
+            stopwatch.Start();
+            const HRESULT hr = localFs->CopyItem(source.c_str(), target.c_str(), FILESYSTEM_FLAG_ALLOW_OVERWRITE);
+            stopwatch.Stop();
+            std::error_code ec;
+            return SUCCEEDED(hr) && std::filesystem::file_size(target, ec) == fileBytes && ! ec;
+        });
+    };
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.copy.large.copyfileex", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runLargeCopyEngineCase(state, L"fileops.copy.large.copyfileex", 0ul, kLargeFileBytes);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.copy.large.unbuffered", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runLargeCopyEngineCase(state, L"fileops.copy.large.unbuffered", 1ul, kLargeFileBytes);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.copy.large.unbuffered.unaligned", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runLargeCopyEngineCase(state, L"fileops.copy.large.unbuffered.unaligned", 1ul, kLargeUnalignedBytes);
+    });
+
+    const std::filesystem::path smallSource = workRoot / L"small-a";
+    const std::filesystem::path smallOther  = workRoot / L"small-b";
+    std::vector<std::wstring> smallNames;
+    smallNames.reserve(kSmallFileCount);
+    for (size_t i = 0; i < kSmallFileCount; ++i)
+    {
+        smallNames.push_back(std::format(L"small_{:04}.dat", i));
+    }
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.copy.small", [&](SelfTest::CaseState& state) noexcept
+    {
+        // Many small files in one CopyItems call (per-file overhead dominates).
+        const std::filesystem::path target = workRoot / L"small-copy";
+        bool created                       = RecreateDirectory(smallSource) && RecreateDirectory(smallOther);
+        for (size_t i = 0; created && i < kSmallFileCount; ++i)
+        {
+            created = CreateFilledFile(smallSource / smallNames[i], kSmallFileBytes, static_cast<uint8_t>(i));
+        }
+        if (! state.Require(created, L"Failed to create small-file copy sources."))
+        {
+            return false;
+        }
+
+        std::vector<std::wstring> paths;
+        std::vector<const wchar_t*> pointers;
+        paths.reserve(kSmallFileCount);
+        pointers.reserve(kSmallFileCount);
+        for (const std::wstring& name : smallNames)
+        {
+            paths.push_back((smallSource / name).wstring());
+            pointers.push_back(paths.back().c_str());
+        }
+
+        const uint64_t bytes = static_cast<uint64_t>(kSmallFileCount * kSmallFileBytes);
+        return Measure(state, L"fileops.copy.small", baselines, kSmallFileCount, bytes, [&](Stopwatch& stopwatch) noexcept
+        {
+            if (! RecreateDirectory(target))
+            {
+                return false;
+            }
+
+            stopwatch.Start();
+            const HRESULT hr = localFs->CopyItems(
+                pointers.data(), static_cast<unsigned long>(pointers.size()), target.c_str(), FILESYSTEM_FLAG_ALLOW_OVERWRITE);
+            stopwatch.Stop();
+            return SUCCEEDED(hr);
+        });
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.move.small", [&](SelfTest::CaseState& state) noexcept
+    {
+        // Same-volume move of many small files, alternating between two folders so every iteration moves the full set.
+        std::vector<std::wstring> paths[2];
+        std::vector<const wchar_t*> pointers[2];
+        const std::filesystem::path* folders[2] = {&smallSource, &smallOther};
+        for (size_t side = 0; side < 2u; ++side)
+        {
+            paths[side].reserve(kSmallFileCount);
+            pointers[side].reserve(kSmallFileCount);
+            for (const std::wstring& name : smallNames)
+            {
+                paths[side].push_back((*folders[side] / name).wstring());
+                pointers[side].push_back(paths[side].back().c_str());
+            }
+        }
+
+        if (! state.Require(SelfTest::PathExists(smallSource / smallNames.front()), L"Small-file move sources missing."))
+        {
+            return false;
+        }
+
+        size_t from = 0;
+        return Measure(state, L"fileops.move.small", baselines, kSmallFileCount, 0, [&](Stopwatch& stopwatch) noexcept
+        {
+            const size_t to = 1u - from;
+            stopwatch.Start();
+            const HRESULT hr = localFs->MoveItems(
+                pointers[from].data(), static_cast<unsigned long>(pointers[from].size()), folders[to]->c_str(), FILESYSTEM_FLAG_ALLOW_OVERWRITE);
+            stopwatch.Stop();
+            from = to;
+            return SUCCEEDED(hr);
+        });
+    });
+
+    // Synthetic small-file tree (kSmallTreeFolders x kSmallTreeFilesPerFolder tiny files) copied and deleted with the local
+    // plugin's small-file batch mode off (smallFileBatchMinFiles = 0, one call chain per file) and at its default threshold.
+    const std::filesystem::path smallTree = workRoot / L"small-tree";
+    bool smallTreeReady                   = RecreateDirectory(smallTree);
+    for (size_t folder = 0; smallTreeReady && folder < kSmallTreeFolders; ++folder)
+    {
+        const std::filesystem::path folderPath = smallTree / std::format(L"dir_{:03}", folder);
+        smallTreeReady                         = SelfTest::EnsureDirectory(folderPath);
+        for (size_t i = 0; smallTreeReady && i < kSmallTreeFilesPerFolder; ++i)
+        {
+            smallTreeReady = CreateFilledFile(folderPath / std::format(L"f_{:05}.txt", i), kSmallTreeFileBytes, static_cast<uint8_t>(i));
+        }
+    }
+
+    const auto runSmallTreeCase =
+        [&](SelfTest::CaseState& state, std::wstring_view caseName, bool deleteCase, std::optional<unsigned long> minFiles) noexcept
+    {
+        if (! state.Require(smallTreeReady, L"Failed to create the small-file tree."))
+        {
+            return false;
+        }
+
+        const std::string localConfig = minFiles.has_value() ? std::format("{{\"smallFileBatchMinFiles\":{}}}", minFiles.value()) : std::string("{}");
+        const SelfTest::PluginConfigurationGuard localConfigGuard(localFs.get(), localConfig);
+        if (! state.Require(localConfigGuard.Applied(), L"FileSystem: failed to set small-file batch configuration."))
+        {
+            return false;
+        }
+
+        const std::filesystem::path target = workRoot / L"small-tree-target";
+        constexpr uint64_t files           = static_cast<uint64_t>(kSmallTreeFolders * kSmallTreeFilesPerFolder);
+        return Measure(state, caseName, baselines, files, files * kSmallTreeFileBytes, [&](Stopwatch& stopwatch) noexcept
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(target, ec);
+            if (deleteCase)
+            {
+                if (FAILED(localFs->CopyItem(smallTree.c_str(), target.c_str(), FILESYSTEM_FLAG_RECURSIVE)))
+                {
+                    return false;
+                }
+
+                stopwatch.Start();
+                const HRESULT hr = localFs->DeleteItem(target.c_str(), FILESYSTEM_FLAG_RECURSIVE);
+                stopwatch.Stop();
+                return SUCCEEDED(hr) && ! SelfTest::PathExists(target);
+            }
+
+            stopwatch.Start();
+            const HRESULT hr = localFs->CopyItem(smallTree.c_str(), target.c_str(), FILESYSTEM_FLAG_RECURSIVE);
+            stopwatch.Stop();
+            return SUCCEEDED(hr);
+        });
+    };
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.tree.copy.perfile", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runSmallTreeCase(state, L"fileops.tree.copy.perfile", false, 0ul);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.tree.copy.batched", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runSmallTreeCase(state, L"fileops.tree.copy.batched", false, std::nullopt);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.tree.delete.perfile", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runSmallTreeCase(state, L"fileops.tree.delete.perfile", true, 0ul);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.tree.delete.batched", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runSmallTreeCase(state, L"fileops.tree.delete.batched", true, std::nullopt);
+    });
+
+    // Cross-filesystem bridge (FileSystemDummy -> local temp folder) through a real file-operation task. The serial case
+    // pins one file lane; the default case uses bridgeMaxConcurrentFiles lanes, so the p50 ratio shows the multi-file gain.
+    const std::string bridgeConfig =
+        std::format("{{\"maxChildrenPerDirectory\":{},\"maxDepth\":2,\"seed\":7,\"latencyMs\":{},\"virtualSpeedLimit\":\"0\"}}",
+                    kBridgeDummyMaxChildren,
+                    kBridgeDummyLatencyMs);
+    FolderWindow::FileOperationState* fileOps = TryGetFileOperations(context.mainWindow);
+    const HRESULT bridgeConfigHr              = context.dummyInfo->SetConfiguration(bridgeConfig.c_str());
+    std::wstring bridgeFolder;
+    unsigned long bridgeEntries = 0;
+    for (uint32_t i = 0; fileOps && SUCCEEDED(bridgeConfigHr) && i < kDummyRootCandidates; ++i)
+    {
+        const std::wstring candidate = std::format(L"/bridge-{:02}", i);
+        wil::com_ptr<IFilesInformation> info;
+        if (SUCCEEDED(dummyFs->ReadDirectoryInfo(candidate.c_str(), info.put())) && GetEntryCount(info.get()) > bridgeEntries)
+        {
+            bridgeEntries = GetEntryCount(info.get());
+            bridgeFolder  = candidate;
+        }
+    }
+
+    const auto runBridgeCase = [&](SelfTest::CaseState& state, std::wstring_view caseName, std::optional<uint32_t> maxConcurrentFiles) noexcept
+    {
+        if (! state.Require(fileOps != nullptr && ! bridgeFolder.empty(), L"Bridge benchmark requires the folder window and a dummy source tree."))
+        {
+            return false;
+        }
+
+        const BridgeConcurrencyOverride concurrency(maxConcurrentFiles);
+        const std::filesystem::path target = workRoot / L"bridge";
+        const std::filesystem::path copied = target / std::filesystem::path(bridgeFolder).filename();
+
+        uint64_t files = 0;
+        uint64_t bytes = 0;
+        if (! state.Require(RecreateDirectory(target) && SUCCEEDED(RunBridgeCopyTask(*fileOps, dummyFs, localFs, bridgeFolder, target)) &&
+                                CountTree(copied, files, bytes) && files > 0,
+                            L"Bridge benchmark: priming copy failed."))
+        {
+            return false;
+        }
+
+        return Measure(state, caseName, baselines, files, bytes, [&](Stopwatch& stopwatch) noexcept
+        {
+            if (! RecreateDirectory(target))
+            {
+                return false;
+            }
+
+            stopwatch.Start();
+            const HRESULT hr = RunBridgeCopyTask(*fileOps, dummyFs, localFs, bridgeFolder, target);
+            stopwatch.Stop();
+            return SUCCEEDED(hr);
+        });
+    };
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.bridge.serial", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runBridgeCase(state, L"fileops.bridge.serial", 1u);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.bridge.lanes", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runBridgeCase(state, L"fileops.bridge.lanes", std::nullopt);
+    });
+}
+} // namespace BenchmarksSelfTest
@@ -0,0 +1,171 @@
+#include "Benchmarks.SelfTestInternal.h"
+
+#include "Framework.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "FolderView.h"
+#include "FolderWindow.h"
+
+namespace
+{
+constexpr std::wstring_view kFolderWindowClassName    = L"RedSalamander.FolderWindow";
+constexpr std::wstring_view kBuiltinDummyFileSystemId = L"builtin/file-system-dummy";
+constexpr unsigned long kScrollDummyMaxChildren       = 50000;
+constexpr uint32_t kScrollFramesPerIteration          = 120; // one column per frame, a long wheel fling
+constexpr ULONGLONG kScrollListingTimeoutMs           = 60'000;
+
+[[nodiscard]] FolderWindow* TryGetFolderWindow(HWND mainWindow) noexcept
+{
+    const HWND folderWindowHwnd = mainWindow ? FindWindowExW(mainWindow, nullptr, kFolderWindowClassName.data(), nullptr) : nullptr;
+    return folderWindowHwnd ? reinterpret_cast<FolderWindow*>(GetWindowLongPtrW(folderWindowHwnd, GWLP_USERDATA)) : nullptr;
+}
+
+// Pumps messages on the UI thread until the pane's FolderView shows `expectedItems` items (the enumeration worker posts
+// its result back to the window).
+[[nodiscard]] bool WaitForItemCount(const FolderView& folderView, size_t expectedItems) noexcept
+{
+    const ULONGLONG deadline = GetTickCount64() + kScrollListingTimeoutMs;
+    while (folderView.BenchmarkGetItemCount() != expectedItems)
+    {
+        if (GetTickCount64() > deadline)
+        {
+            return false;
+        }
+
+        static_cast<void>(MsgWaitForMultipleObjects(0, nullptr, FALSE, 5, QS_ALLINPUT));
+        MSG msg{};
+        while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+        {
+            if (msg.message == WM_QUIT)
+            {
+                PostQuitMessage(static_cast<int>(msg.wParam));
+                return false;
+            }
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+    }
+    return true;
+}
+
+// Puts the left pane back on the plugin and folder it showed before the scroll cases.
+class PaneLocationGuard
+{
+public:
+    explicit PaneLocationGuard(FolderWindow& folderWindow) noexcept
+        : _folderWindow(folderWindow),
+          _pluginId(folderWindow.GetFileSystemPluginId(FolderWindow::Pane::Left)),
+          _folder(folderWindow.GetCurrentPluginPath(FolderWindow::Pane::Left))
+    {
+    }
+
+    ~PaneLocationGuard()
+    {
+        if (_pluginId.empty())
+        {
+            return;
+        }
+
+        static_cast<void>(_folderWindow.SetFileSystemPluginForPane(FolderWindow::Pane::Left, _pluginId));
+        if (_folder.has_value())
+        {
+            _folderWindow.SetFolderPath(FolderWindow::Pane::Left, _folder.value());
+        }
+    }
+
+    PaneLocationGuard(const PaneLocationGuard&)            = delete;
+    PaneLocationGuard& operator=(const PaneLocationGuard&) = delete;
+    PaneLocationGuard(PaneLocationGuard&&)                 = delete;
+    PaneLocationGuard& operator=(PaneLocationGuard&&)      = delete;
+
+private:
+    FolderWindow& _folderWindow;
+    std::wstring _pluginId;
+    std::optional<std::filesystem::path> _folder;
+};
+} // namespace
+
+namespace BenchmarksSelfTest
+{
+void RunFolderViewCases(const Context& context) noexcept
+{
+    const BaselineMap& baselines             = context.baselines;
+    const wil::com_ptr<IFileSystem>& dummyFs = context.dummyFs;
+
+    // Wheel-scrolling the left pane across a large FileSystemDummy listing, one synchronous paint per column. The
+    // .layouts case draws every label from a per-item IDWriteTextLayout (the path the cached glyph runs replaced), the
+    // .glyphruns case from the glyph-run cache, so the p50 ratio of one run is the before/after of that change. Label
+    // state is dropped between iterations; the glyph-run cache keeps its shaped names, as it does when a user scrolls back.
+    const std::string scrollConfig =
+        std::format("{{\"maxChildrenPerDirectory\":{},\"maxDepth\":1,\"seed\":3,\"latencyMs\":0,\"virtualSpeedLimit\":\"0\"}}", kScrollDummyMaxChildren);
+    const SelfTest::PluginConfigurationGuard scrollConfigGuard(dummyFs.get(), scrollConfig);
+    FolderWindow* folderWindow = TryGetFolderWindow(context.mainWindow);
+    const HWND folderViewHwnd  = folderWindow ? folderWindow->GetFolderViewHwnd(FolderWindow::Pane::Left) : nullptr;
+    auto* folderView           = folderViewHwnd ? reinterpret_cast<FolderView*>(GetWindowLongPtrW(folderViewHwnd, GWLP_USERDATA)) : nullptr;
+
+    std::wstring scrollFolder;
+    unsigned long scrollEntries = 0;
+    for (uint32_t i = 0; folderView && scrollConfigGuard.Applied() && i < kDummyRootCandidates; ++i)
+    {
+        const std::wstring candidate = std::format(L"/scroll-{:02}", i);
+        wil::com_ptr<IFilesInformation> info;
+        if (SUCCEEDED(dummyFs->ReadDirectoryInfo(candidate.c_str(), info.put())) && GetEntryCount(info.get()) > scrollEntries)
+        {
+            scrollEntries = GetEntryCount(info.get());
+            scrollFolder  = candidate;
+        }
+    }
+
+    std::optional<PaneLocationGuard> paneLocation;
+    bool listed = false;
+    if (folderView && IsWindowVisible(folderViewHwnd) && ! scrollFolder.empty())
+    {
+        paneLocation.emplace(*folderWindow);
+        if (SUCCEEDED(folderWindow->SetFileSystemPluginForPane(FolderWindow::Pane::Left, kBuiltinDummyFileSystemId)))
+        {
+            folderWindow->SetFolderPath(FolderWindow::Pane::Left, scrollFolder);
+            listed = WaitForItemCount(*folderView, scrollEntries);
+        }
+        Trace(std::format(L"Benchmarks: FolderView scroll listing {} ({} entries)", scrollFolder, scrollEntries));
+    }
+
+    const auto runScrollCase = [&](SelfTest::CaseState& state, std::wstring_view caseName, bool useLabelGlyphRuns) noexcept
+    {
+        if (! state.Require(listed, L"FolderView scroll benchmark requires a visible folder window showing the dummy listing."))
+        {
+            return false;
+        }
+
+        const bool ok = Measure(state, caseName, baselines, kScrollFramesPerIteration, 0, [&](Stopwatch& stopwatch) noexcept
+        {
+            folderView->BenchmarkResetScroll(useLabelGlyphRuns);
+            stopwatch.Start();
+            for (uint32_t frame = 0; frame < kScrollFramesPerIteration; ++frame)
+            {
+                folderView->BenchmarkScrollFrame(1);
+            }
+            stopwatch.Stop();
+            return folderView->BenchmarkGetItemCount() == scrollEntries;
+        });
+        folderView->BenchmarkResetScroll(true);
+        return ok;
+    };
+
+    SelfTest::RunCase(context.options, context.suite, L"folderview.scroll.layouts", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runScrollCase(state, L"folderview.scroll.layouts", false);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"folderview.scroll.glyphruns", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runScrollCase(state, L"folderview.scroll.glyphruns", true);
+    });
+}
+} // namespace BenchmarksSelfTest
@@ -0,0 +1,263 @@
+#include "Benchmarks.SelfTestInternal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#include "PixelKernels.h"
+
+namespace
+{
+// A 12 MP frame (a typical RAW embedded preview / mid-size sensor), converted and downsampled in the same row bands the
+// ViewerImgRaw decode and mip paths use.
+constexpr uint32_t kKernelFrameWidth  = 4000;
+constexpr uint32_t kKernelFrameHeight = 3000;
+constexpr uint32_t kKernelRowsPerBand = 64;
+constexpr uint32_t kKernelColors      = 3;
+constexpr uint64_t kKernelFramePixels = static_cast<uint64_t>(kKernelFrameWidth) * kKernelFrameHeight;
+
+// Largest odd-size input the exactness checks feed the kernels (pixel counts below 100, downsample sources up to 69x5).
+constexpr size_t kKernelMaxCheckPixels  = 100;
+constexpr uint32_t kKernelMaxCheckWidth = 69;
+constexpr uint32_t kKernelMaxCheckRows  = 5;
+
+template <typename Sample> void FillNoise(std::vector<Sample>& samples, uint32_t seed) noexcept
+{
+    uint32_t state = seed;
+    for (Sample& sample : samples)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        sample = static_cast<Sample>(state);
+    }
+}
+
+// Runs `scalar` and `vector` over every channel count at small and odd pixel counts (vector tails), then over the full
+// frame, and reports whether the outputs match byte for byte.
+template <typename Sample, typename Scalar, typename Vector>
+[[nodiscard]] bool ConversionMatchesScalar(const std::vector<Sample>& frame, Scalar scalar, Vector vector) noexcept
+{
+    try
+    {
+        std::vector<uint8_t> expected;
+        std::vector<uint8_t> actual;
+        for (uint32_t colors = 1; colors <= 4; ++colors)
+        {
+            for (size_t count = 0; count < kKernelMaxCheckPixels; ++count)
+            {
+                expected.assign(count * 4u, 0x00);
+                actual.assign(count * 4u, 0xFF);
+                scalar(frame.data(), colors, expected.data(), count);
+                vector(frame.data(), colors, actual.data(), count);
+                if (expected != actual)
+                {
+                    return false;
+                }
+            }
+        }
+
+        expected.assign(static_cast<size_t>(kKernelFramePixels) * 4u, 0x00);
+        actual.assign(static_cast<size_t>(kKernelFramePixels) * 4u, 0xFF);
+        scalar(frame.data(), kKernelColors, expected.data(), static_cast<size_t>(kKernelFramePixels));
+        vector(frame.data(), kKernelColors, actual.data(), static_cast<size_t>(kKernelFramePixels));
+        return expected == actual;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+}
+
+// Same check for the 2x2 downsample: every source width up to kKernelMaxCheckWidth (odd last column, AVX2/SSE2 tails) and
+// height up to kKernelMaxCheckRows (odd last row), then the full frame.
+[[nodiscard]] bool DownsampleMatchesScalar(const std::vector<uint8_t>& frame) noexcept
+{
+    const auto matches = [&](uint32_t srcW, uint32_t srcH)
+    {
+        const size_t dstBytes = static_cast<size_t>((srcW + 1u) / 2u) * ((srcH + 1u) / 2u) * 4u;
+        std::vector<uint8_t> expected(dstBytes, 0x00);
+        std::vector<uint8_t> actual(dstBytes, 0xFF);
+        PixelKernels::DownsampleBgraBox2x2RowsScalar(frame.data(), srcW, srcH, expected.data(), 0, (srcH + 1u) / 2u);
+        PixelKernels::DownsampleBgraBox2x2Rows(frame.data(), srcW, srcH, actual.data(), 0, (srcH + 1u) / 2u);
+        return expected == actual;
+    };
+
+    try
+    {
+        for (uint32_t srcH = 1; srcH <= kKernelMaxCheckRows; ++srcH)
+        {
+            for (uint32_t srcW = 1; srcW <= kKernelMaxCheckWidth; ++srcW)
+            {
+                if (! matches(srcW, srcH))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return matches(kKernelFrameWidth, kKernelFrameHeight);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+}
+} // namespace
+
+namespace BenchmarksSelfTest
+{
+void RunImageKernelCases(const Context& context) noexcept
+{
+    const BaselineMap& baselines = context.baselines;
+
+    std::vector<uint8_t> rgb8;
+    std::vector<uint16_t> rgb16;
+    std::vector<uint8_t> bgra;
+    std::vector<uint8_t> half;
+    bool inputsReady = false;
+    try
+    {
+        rgb8.resize(static_cast<size_t>(kKernelFramePixels) * kKernelColors);
+        rgb16.resize(static_cast<size_t>(kKernelFramePixels) * kKernelColors);
+        bgra.resize(static_cast<size_t>(kKernelFramePixels) * 4u);
+        half.resize(static_cast<size_t>((kKernelFrameWidth + 1u) / 2u) * ((kKernelFrameHeight + 1u) / 2u) * 4u);
+        FillNoise(rgb8, 0x2545F491u);
+        FillNoise(rgb16, 0x9E3779B9u);
+        FillNoise(bgra, 0x85EBCA6Bu);
+        inputsReady = true;
+    }
+    catch (const std::bad_alloc&)
+    {
+        Trace(L"Benchmarks: out of memory allocating the pixel kernel frames.");
+    }
+
+    // Pixel kernel throughput on one frame: items = source pixels, so items_per_s / 1e6 is megapixels per second. Each
+    // kernel has a .scalar twin (the reference loop, same banding) and the vectorized case first checks that it matches
+    // the reference exactly.
+    const auto runKernelCase = [&](SelfTest::CaseState& state,
+                                   std::wstring_view caseName,
+                                   uint32_t rows,
+                                   uint64_t sourceBytes,
+                                   bool exact,
+                                   const auto& band) noexcept
+    {
+        if (! state.Require(inputsReady, std::format(L"{}: pixel kernel frames are not available.", caseName)) ||
+            ! state.Require(exact, std::format(L"{}: output differs from the scalar reference.", caseName)))
+        {
+            return false;
+        }
+
+        const bool ok = Measure(state, caseName, baselines, kKernelFramePixels, sourceBytes, [&](Stopwatch& stopwatch) noexcept
+        {
+            try
+            {
+                stopwatch.Start();
+                PixelKernels::ForEachRowBand(rows, kKernelRowsPerBand, band);
+                stopwatch.Stop();
+                return true;
+            }
+            catch (const std::bad_alloc&)
+            {
+                return false;
+            }
+        });
+
+        if (ok && state.benchmark.has_value())
+        {
+            Trace(std::format(L"{}: {:.1f} us/MP", caseName, static_cast<double>(state.benchmark->p50Us) * 1e6 / static_cast<double>(kKernelFramePixels)));
+        }
+        return ok;
+    };
+
+    const size_t rowPixels = kKernelFrameWidth;
+    const auto convertRgb8 = [&](bool vector)
+    {
+        return [&, vector](uint32_t rowBegin, uint32_t rowEnd) noexcept
+        {
+            const size_t first = static_cast<size_t>(rowBegin) * rowPixels;
+            const size_t count = static_cast<size_t>(rowEnd - rowBegin) * rowPixels;
+            const uint8_t* src = rgb8.data() + first * kKernelColors;
+            if (vector)
+            {
+                PixelKernels::ConvertRgb8ToBgra(src, kKernelColors, bgra.data() + first * 4u, count);
+            }
+            else
+            {
+                PixelKernels::ConvertRgb8ToBgraScalar(src, kKernelColors, bgra.data() + first * 4u, count);
+            }
+        };
+    };
+
+    const auto convertRgb16 = [&](bool vector)
+    {
+        return [&, vector](uint32_t rowBegin, uint32_t rowEnd) noexcept
+        {
+            const size_t first  = static_cast<size_t>(rowBegin) * rowPixels;
+            const size_t count  = static_cast<size_t>(rowEnd - rowBegin) * rowPixels;
+            const uint16_t* src = rgb16.data() + first * kKernelColors;
+            if (vector)
+            {
+                PixelKernels::ConvertRgb16ToBgra(src, kKernelColors, bgra.data() + first * 4u, count);
+            }
+            else
+            {
+                PixelKernels::ConvertRgb16ToBgraScalar(src, kKernelColors, bgra.data() + first * 4u, count);
+            }
+        };
+    };
+
+    const auto downsample = [&](bool vector)
+    {
+        return [&, vector](uint32_t rowBegin, uint32_t rowEnd) noexcept
+        {
+            if (vector)
+            {
+                PixelKernels::DownsampleBgraBox2x2Rows(bgra.data(), kKernelFrameWidth, kKernelFrameHeight, half.data(), rowBegin, rowEnd);
+            }
+            else
+            {
+                PixelKernels::DownsampleBgraBox2x2RowsScalar(bgra.data(), kKernelFrameWidth, kKernelFrameHeight, half.data(), rowBegin, rowEnd);
+            }
+        };
+    };
+
+    const uint32_t halfRows = (kKernelFrameHeight + 1u) / 2u;
+
+    SelfTest::RunCase(context.options, context.suite, L"viewer.imgraw.kernels.rgb8.scalar", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runKernelCase(state, L"viewer.imgraw.kernels.rgb8.scalar", kKernelFrameHeight, rgb8.size(), true, convertRgb8(false));
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"viewer.imgraw.kernels.rgb8", [&](SelfTest::CaseState& state) noexcept
+    {
+        const bool exact = inputsReady && ConversionMatchesScalar(rgb8, PixelKernels::ConvertRgb8ToBgraScalar, PixelKernels::ConvertRgb8ToBgra);
+        return runKernelCase(state, L"viewer.imgraw.kernels.rgb8", kKernelFrameHeight, rgb8.size(), exact, convertRgb8(true));
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"viewer.imgraw.kernels.rgb16.scalar", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runKernelCase(state, L"viewer.imgraw.kernels.rgb16.scalar", kKernelFrameHeight, rgb16.size() * sizeof(uint16_t), true, convertRgb16(false));
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"viewer.imgraw.kernels.rgb16", [&](SelfTest::CaseState& state) noexcept
+    {
+        const bool exact = inputsReady && ConversionMatchesScalar(rgb16, PixelKernels::ConvertRgb16ToBgraScalar, PixelKernels::ConvertRgb16ToBgra);
+        return runKernelCase(state, L"viewer.imgraw.kernels.rgb16", kKernelFrameHeight, rgb16.size() * sizeof(uint16_t), exact, convertRgb16(true));
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"viewer.imgraw.kernels.downsample.scalar", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runKernelCase(state, L"viewer.imgraw.kernels.downsample.scalar", halfRows, bgra.size(), true, downsample(false));
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"viewer.imgraw.kernels.downsample", [&](SelfTest::CaseState& state) noexcept
+    {
+        const bool exact = inputsReady && DownsampleMatchesScalar(bgra);
+        return runKernelCase(state, L"viewer.imgraw.kernels.downsample", halfRows, bgra.size(), exact, downsample(true));
+    });
+}
+} // namespace BenchmarksSelfTest
@@ -0,0 +1,263 @@
+#include "Benchmarks.SelfTestInternal.h"
+
+#include "Framework.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+// Remote copy cases run only against a local test server named by these variables (plugin path with credentials, e.g.
+// "//user:pass@127.0.0.1:2121/bench"); the folder is reused as scratch space.
+constexpr std::wstring_view kFtpFileSystemId       = L"builtin/file-system-ftp";
+constexpr std::wstring_view kSftpFileSystemId      = L"builtin/file-system-sftp";
+constexpr std::wstring_view kBenchFtpRootVariable  = L"REDSALAMANDER_BENCH_FTP_ROOT";
+constexpr std::wstring_view kBenchSftpRootVariable = L"REDSALAMANDER_BENCH_SFTP_ROOT";
+constexpr std::wstring_view kBenchSftpRttVariable  = L"REDSALAMANDER_BENCH_SFTP_RTT_MS"; // emulated RTT (tc/netem), names the cases
+constexpr size_t kRemoteFileCount                  = 200;
+constexpr size_t kRemoteFileBytes                  = 4u * 1024u;
+constexpr uint64_t kRemoteStreamBytes              = 32ull * 1024ull * 1024ull;
+constexpr unsigned long kRemoteStreamChunkBytes    = 256u * 1024u;
+
+[[nodiscard]] std::wstring GetEnvironmentString(std::wstring_view name) noexcept
+{
+    const std::wstring nameText(name);
+    const DWORD required = GetEnvironmentVariableW(nameText.c_str(), nullptr, 0);
+    if (required <= 1)
+    {
+        return {};
+    }
+
+    std::wstring value(required, L'\0');
+    const DWORD written = GetEnvironmentVariableW(nameText.c_str(), value.data(), required);
+    if (written == 0 || written >= required)
+    {
+        return {};
+    }
+
+    value.resize(written);
+    return value;
+}
+
+// Creates root/source with kRemoteFileCount small files through the plugin's directory and writer interfaces.
+[[nodiscard]] HRESULT SeedRemoteSourceTree(IFileSystem* fileSystem, const std::wstring& sourceFolder) noexcept
+{
+    wil::com_ptr<IFileSystemIO> io;
+    wil::com_ptr<IFileSystemDirectoryOperations> directoryOps;
+    HRESULT hr = fileSystem->QueryInterface(__uuidof(IFileSystemIO), io.put_void());
+    if (SUCCEEDED(hr))
+    {
+        hr = fileSystem->QueryInterface(__uuidof(IFileSystemDirectoryOperations), directoryOps.put_void());
+    }
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    static_cast<void>(fileSystem->DeleteItem(sourceFolder.c_str(), FILESYSTEM_FLAG_RECURSIVE));
+    hr = directoryOps->CreateDirectory(sourceFolder.c_str());
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    std::vector<uint8_t> content(kRemoteFileBytes);
+    for (size_t i = 0; i < kRemoteFileCount; ++i)
+    {
+        std::fill(content.begin(), content.end(), static_cast<uint8_t>(i));
+
+        const std::wstring filePath = std::format(L"{}/f_{:05}.bin", sourceFolder, i);
+        wil::com_ptr<IFileWriter> writer;
+        hr = io->CreateFileWriter(filePath.c_str(), FILESYSTEM_FLAG_ALLOW_OVERWRITE, writer.put());
+        unsigned long written = 0;
+        if (SUCCEEDED(hr))
+        {
+            hr = writer->Write(content.data(), static_cast<unsigned long>(content.size()), &written);
+        }
+        if (SUCCEEDED(hr))
+        {
+            hr = writer->Commit();
+        }
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+    }
+
+    return S_OK;
+}
+} // namespace
+
+namespace BenchmarksSelfTest
+{
+void RunRemoteCases(const Context& context) noexcept
+{
+    const BaselineMap& baselines = context.baselines;
+
+    // Many-file remote copy (kRemoteFileCount small files, server-side folder to folder) on FileSystemCurl, once with one
+    // blocking transfer per worker thread (multiTransferEngine = false) and once on the shared curl_multi engine.
+    const auto runRemoteCopyCase = [&](SelfTest::CaseState& state,
+                                       std::wstring_view caseName,
+                                       std::wstring_view pluginId,
+                                       std::wstring_view rootVariable,
+                                       bool multiTransferEngine) noexcept
+    {
+        const std::wstring root = GetEnvironmentString(rootVariable);
+        if (root.empty())
+        {
+            state.Skip(std::format(L"{} is not set (no local test server).", rootVariable));
+            return true;
+        }
+
+        wil::com_ptr<IFileSystem> remoteFs = SelfTest::GetFileSystem(pluginId);
+        if (! state.Require(remoteFs != nullptr, L"FileSystemCurl: plugin not available."))
+        {
+            return false;
+        }
+
+        const char* remoteConfig = multiTransferEngine ? "{}" : "{\"multiTransferEngine\":false}";
+        const SelfTest::PluginConfigurationGuard remoteConfigGuard(remoteFs.get(), remoteConfig);
+        if (! state.Require(remoteConfigGuard.Applied(), L"FileSystemCurl: failed to set transfer engine configuration."))
+        {
+            return false;
+        }
+
+        const std::wstring base   = root.ends_with(L'/') ? root.substr(0, root.size() - 1) : root;
+        const std::wstring source = base + L"/rs-bench-source";
+        const std::wstring target = base + L"/rs-bench-target";
+        if (! state.Require(SUCCEEDED(SeedRemoteSourceTree(remoteFs.get(), source)), L"FileSystemCurl: failed to seed the remote source tree."))
+        {
+            return false;
+        }
+
+        const bool ok = Measure(state, caseName, baselines, kRemoteFileCount, kRemoteFileCount * kRemoteFileBytes, [&](Stopwatch& stopwatch) noexcept
+        {
+            static_cast<void>(remoteFs->DeleteItem(target.c_str(), FILESYSTEM_FLAG_RECURSIVE));
+
+            stopwatch.Start();
+            const HRESULT hr = remoteFs->CopyItem(source.c_str(), target.c_str(), FILESYSTEM_FLAG_RECURSIVE);
+            stopwatch.Stop();
+            return SUCCEEDED(hr);
+        });
+
+        static_cast<void>(remoteFs->DeleteItem(target.c_str(), FILESYSTEM_FLAG_RECURSIVE));
+        static_cast<void>(remoteFs->DeleteItem(source.c_str(), FILESYSTEM_FLAG_RECURSIVE));
+        return ok;
+    };
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.remote.ftp.threads", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runRemoteCopyCase(state, L"fileops.remote.ftp.threads", kFtpFileSystemId, kBenchFtpRootVariable, false);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.remote.ftp.multi", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runRemoteCopyCase(state, L"fileops.remote.ftp.multi", kFtpFileSystemId, kBenchFtpRootVariable, true);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.remote.sftp.threads", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runRemoteCopyCase(state, L"fileops.remote.sftp.threads", kSftpFileSystemId, kBenchSftpRootVariable, false);
+    });
+
+    SelfTest::RunCase(context.options, context.suite, L"fileops.remote.sftp.multi", [&](SelfTest::CaseState& state) noexcept
+    {
+        return runRemoteCopyCase(state, L"fileops.remote.sftp.multi", kSftpFileSystemId, kBenchSftpRootVariable, true);
+    });
+
+    // Large-file SFTP streaming (IFileWriter upload, then IFileReader download) with a single outstanding request
+    // (sftpRequestWindow = 1, no adaptation) and with the default adaptive window. Run once per emulated RTT (e.g. netem
+    // delay on the server at 0 / 50 / 150 ms) with REDSALAMANDER_BENCH_SFTP_RTT_MS set; the value is appended to the case
+    // names so each RTT keeps its own baseline, and bytes_per_s carries the MB/s figure.
+    const std::wstring sftpRtt      = GetEnvironmentString(kBenchSftpRttVariable);
+    const std::wstring sftpRttLabel = sftpRtt.empty() ? std::wstring() : std::format(L".rtt{}", sftpRtt);
+    const auto runSftpStreamCase    = [&](SelfTest::CaseState& state, const std::wstring& caseName, bool upload, bool windowed) noexcept
+    {
+        const std::wstring root = GetEnvironmentString(kBenchSftpRootVariable);
+        if (root.empty())
+        {
+            state.Skip(std::format(L"{} is not set (no local test server).", kBenchSftpRootVariable));
+            return true;
+        }
+
+        wil::com_ptr<IFileSystem> remoteFs = SelfTest::GetFileSystem(kSftpFileSystemId);
+        wil::com_ptr<IFileSystemIO> remoteIo;
+        if (! state.Require(remoteFs && SUCCEEDED(remoteFs->QueryInterface(__uuidof(IFileSystemIO), remoteIo.put_void())) && remoteIo,
+                            L"FileSystemCurl: SFTP plugin not available."))
+        {
+            return false;
+        }
+
+        const char* remoteConfig = windowed ? "{}" : "{\"sftpRequestWindow\":1,\"sftpAdaptiveWindow\":false}";
+        const SelfTest::PluginConfigurationGuard remoteConfigGuard(remoteFs.get(), remoteConfig);
+        if (! state.Require(remoteConfigGuard.Applied(), L"FileSystemCurl: failed to set SFTP window configuration."))
+        {
+            return false;
+        }
+
+        const std::wstring base = root.ends_with(L'/') ? root.substr(0, root.size() - 1) : root;
+        const std::wstring file = base + L"/rs-bench-stream.bin";
+        std::vector<uint8_t> chunk(kRemoteStreamChunkBytes, static_cast<uint8_t>(0x5A));
+
+        const auto writeFile = [&]() noexcept
+        {
+            wil::com_ptr<IFileWriter> writer;
+            HRESULT hr = remoteIo->CreateFileWriter(file.c_str(), FILESYSTEM_FLAG_ALLOW_OVERWRITE, writer.put());
+            for (uint64_t written = 0; SUCCEEDED(hr) && written < kRemoteStreamBytes; written += kRemoteStreamChunkBytes)
+            {
+                unsigned long chunkWritten = 0;
+                hr = writer->Write(chunk.data(), kRemoteStreamChunkBytes, &chunkWritten);
+            }
+            return SUCCEEDED(hr) ? writer->Commit() : hr;
+        };
+
+        const auto readFile = [&]() noexcept
+        {
+            wil::com_ptr<IFileReader> reader;
+            HRESULT hr      = remoteIo->CreateFileReader(file.c_str(), reader.put());
+            uint64_t total  = 0;
+            unsigned long n = 1;
+            while (SUCCEEDED(hr) && n > 0)
+            {
+                hr = reader->Read(chunk.data(), kRemoteStreamChunkBytes, &n);
+                total += n;
+            }
+            return SUCCEEDED(hr) && total != kRemoteStreamBytes ? HRESULT_FROM_WIN32(ERROR_HANDLE_EOF) : hr;
+        };
+
+        if (! upload && ! state.Require(SUCCEEDED(writeFile()), L"FileSystemCurl: failed to upload the SFTP stream sample."))
+        {
+            return false;
+        }
+
+        const bool ok = Measure(state, caseName, baselines, 1, kRemoteStreamBytes, [&](Stopwatch& stopwatch) noexcept
+        {
+            stopwatch.Start();
+            const HRESULT hr = upload ? writeFile() : readFile();
+            stopwatch.Stop();
+            return SUCCEEDED(hr);
+        });
+
+        static_cast<void>(remoteFs->DeleteItem(file.c_str(), FILESYSTEM_FLAG_NONE));
+        return ok;
+    };
+
+    for (const bool upload : {true, false})
+    {
+        for (const bool windowed : {false, true})
+        {
+            const std::wstring caseName =
+                std::format(L"fileops.remote.sftp.{}.{}{}", upload ? L"write" : L"read", windowed ? L"window" : L"w1", sftpRttLabel);
+            SelfTest::RunCase(context.options, context.suite, caseName, [&](SelfTest::CaseState& state) noexcept
+            {
+                return runSftpStreamCase(state, caseName, upload, windowed);
+            });
+        }
+    }
+}
+} // namespace BenchmarksSelfTest
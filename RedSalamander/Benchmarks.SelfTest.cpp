@@ -0,0 +1,799 @@
+#include "Benchmarks.SelfTest.h"
+
+#include "Framework.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#pragma warning(push)
+// WIL: C4625 (copy ctor deleted), C4626 (copy assign deleted), C5026 (move ctor deleted), C5027 (move assign deleted)
+#pragma warning(disable : 4625 4626 5026 5027 28182)
+#include <wil/com.h>
+#include <wil/resource.h>
+#pragma warning(pop)
+
+#include <yyjson.h>
+
+#include "Benchmarks.SelfTestInternal.h"
+#include "CompactFilesListing.h"
+#include "DirectoryInfoCache.h"
+#include "FolderView.h"
+#include "Helpers.h"
+#include "SelfTestCommon.h"
+#include "SettingsStore.h"
+#include "ViewerPluginManager.h"
+
+extern Common::Settings::Settings g_settings;
+
+namespace BenchmarksSelfTest
+{
+namespace
+{
+constexpr std::wstring_view kBuiltinLocalFileSystemId = L"builtin/file-system";
+constexpr std::wstring_view kBuiltinDummyFileSystemId = L"builtin/file-system-dummy";
+constexpr std::wstring_view kTextViewerId             = L"builtin/viewer-text";
+
+// p50 regressions beyond kRegressionWarnRatio are flagged in results.json; beyond kRegressionFailRatio (and by more
+// than the noise floor, so sub-millisecond jitter never fails a run) the case fails and the process exits non-zero.
+constexpr double kRegressionWarnRatio      = 1.15;
+constexpr double kRegressionFailRatio      = 1.50;
+constexpr uint64_t kRegressionNoiseFloorUs = 500;
+
+constexpr unsigned long kDummyMaxChildren = 20000;
+constexpr uint32_t kBorrowHitsPerSample   = 1000;
+constexpr size_t kLocalEnumFileCount      = 2000;
+constexpr size_t kS3ListingEntryCount     = 1'000'000;
+constexpr size_t kS3FolderViewEntryCount  = 100'000;
+constexpr size_t kViewerFileBytes         = 1u * 1024u * 1024u;
+
+constexpr std::wstring_view kBaselineFileName = L"benchmarks-baseline.json";
+
+[[nodiscard]] std::wstring Utf16FromUtf8(std::string_view text) noexcept
+{
+    if (text.empty() || text.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        return {};
+    }
+
+    const int required = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, text.data(), static_cast<int>(text.size()), nullptr, 0);
+    if (required <= 0)
+    {
+        return {};
+    }
+
+    std::wstring result(static_cast<size_t>(required), L'\0');
+    const int written = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, text.data(), static_cast<int>(text.size()), result.data(), required);
+    if (written != required)
+    {
+        return {};
+    }
+
+    return result;
+}
+
+[[nodiscard]] std::string Utf8FromUtf16(std::wstring_view text) noexcept
+{
+    if (text.empty() || text.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        return {};
+    }
+
+    const int required = WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, text.data(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    if (required <= 0)
+    {
+        return {};
+    }
+
+    std::string result(static_cast<size_t>(required), '\0');
+    const int written =
+        WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, text.data(), static_cast<int>(text.size()), result.data(), required, nullptr, nullptr);
+    if (written != required)
+    {
+        return {};
+    }
+
+    return result;
+}
+
+// The baseline lives next to last_run\ and previous_run\ rather than inside them: any self-test run rotates those folders,
+// so previous_run\benchmarks is only a usable baseline when the two benchmark runs were back to back.
+[[nodiscard]] std::filesystem::path GetBaselinePath()
+{
+    const std::filesystem::path& root = SelfTest::SelfTestRoot();
+    return root.empty() ? std::filesystem::path{} : root / kBaselineFileName;
+}
+
+// Reads p50 per case from a results.json-shaped file (`cases[].name`, `cases[].benchmark.p50_us`).
+[[nodiscard]] bool ReadBaselineFile(const std::filesystem::path& path, BaselineMap& baselines) noexcept
+{
+    std::string json;
+    if (path.empty() || ! SelfTest::ReadBinaryFile(path, json) || json.empty())
+    {
+        return false;
+    }
+
+    yyjson_doc* doc = yyjson_read(json.data(), json.size(), 0);
+    if (! doc)
+    {
+        return false;
+    }
+
+    auto freeDoc      = wil::scope_exit([&] { yyjson_doc_free(doc); });
+    yyjson_val* cases = yyjson_obj_get(yyjson_doc_get_root(doc), "cases");
+    if (! yyjson_is_arr(cases))
+    {
+        return false;
+    }
+
+    size_t index      = 0;
+    size_t count      = 0;
+    yyjson_val* entry = nullptr;
+    yyjson_arr_foreach(cases, index, count, entry)
+    {
+        yyjson_val* name = yyjson_obj_get(entry, "name");
+        yyjson_val* p50  = yyjson_obj_get(yyjson_obj_get(entry, "benchmark"), "p50_us");
+        if (! yyjson_is_str(name) || ! yyjson_is_uint(p50))
+        {
+            continue;
+        }
+
+        std::wstring caseName = Utf16FromUtf8(std::string_view(yyjson_get_str(name), yyjson_get_len(name)));
+        if (! caseName.empty())
+        {
+            baselines[std::move(caseName)] = yyjson_get_uint(p50);
+        }
+    }
+
+    return true;
+}
+
+// Loads the dedicated baseline file; until the first benchmark run has written it, falls back to
+// previous_run\benchmarks\results.json. Missing or unreadable files yield an empty map (no diff).
+[[nodiscard]] BaselineMap LoadBaselines(std::wstring_view& source) noexcept
+{
+    BaselineMap baselines;
+    source = kBaselineFileName;
+    if (ReadBaselineFile(GetBaselinePath(), baselines))
+    {
+        return baselines;
+    }
+
+    baselines.clear();
+    source = L"previous_run\\benchmarks\\results.json";
+    static_cast<void>(ReadBaselineFile(SelfTest::GetPreviousSuiteArtifactPath(SelfTest::SelfTestSuite::Benchmarks, L"results.json"), baselines));
+    return baselines;
+}
+
+// Folds the p50 of every passed case into the baseline file. Cases that did not run this time (remote cases without a
+// server, other emulated RTTs) keep their value; failed runs are never saved, so a regression does not become the baseline.
+void SaveBaselines(BaselineMap baselines, const SelfTest::SelfTestSuiteResult& suite) noexcept
+{
+    const std::filesystem::path path = GetBaselinePath();
+    if (path.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        for (const SelfTest::SelfTestCaseResult& testCase : suite.cases)
+        {
+            if (testCase.status == SelfTest::SelfTestCaseResult::Status::passed && testCase.benchmark.has_value() && testCase.benchmark->p50Us > 0)
+            {
+                baselines[testCase.name] = testCase.benchmark->p50Us;
+            }
+        }
+
+        std::vector<std::pair<std::string, uint64_t>> rows;
+        rows.reserve(baselines.size());
+        for (const auto& [name, p50Us] : baselines)
+        {
+            std::string nameUtf8 = Utf8FromUtf16(name);
+            if (! nameUtf8.empty())
+            {
+                rows.emplace_back(std::move(nameUtf8), p50Us);
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+
+        yyjson_mut_doc* doc = yyjson_mut_doc_new(nullptr);
+        if (! doc)
+        {
+            return;
+        }
+
+        auto freeDoc          = wil::scope_exit([&] { yyjson_mut_doc_free(doc); });
+        yyjson_mut_val* root  = yyjson_mut_obj(doc);
+        yyjson_mut_val* cases = yyjson_mut_arr(doc);
+        if (! root || ! cases)
+        {
+            return;
+        }
+
+        yyjson_mut_doc_set_root(doc, root);
+        for (const auto& [name, p50Us] : rows)
+        {
+            yyjson_mut_val* caseObj  = yyjson_mut_arr_add_obj(doc, cases);
+            yyjson_mut_val* benchObj = yyjson_mut_obj(doc);
+            if (! caseObj || ! benchObj)
+            {
+                return;
+            }
+
+            yyjson_mut_obj_add_strn(doc, caseObj, "name", name.data(), name.size());
+            yyjson_mut_obj_add_uint(doc, benchObj, "p50_us", p50Us);
+            yyjson_mut_obj_add_val(doc, caseObj, "benchmark", benchObj);
+        }
+        yyjson_mut_obj_add_val(doc, root, "cases", cases);
+
+        size_t length = 0;
+        char* text    = yyjson_mut_write(doc, YYJSON_WRITE_PRETTY, &length);
+        if (! text)
+        {
+            return;
+        }
+
+        auto freeText = wil::scope_exit([&] { free(text); });
+        if (! SelfTest::WriteTextFile(path, std::string_view(text, length)))
+        {
+            Trace(std::format(L"Benchmarks: failed to write baseline file {}", path.native()));
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        Trace(L"Benchmarks: out of memory while saving the baseline file");
+    }
+}
+
+[[nodiscard]] SelfTest::SelfTestBenchmarkStats ComputeStats(std::vector<uint64_t> samplesUs) noexcept
+{
+    SelfTest::SelfTestBenchmarkStats stats{};
+    if (samplesUs.empty())
+    {
+        return stats;
+    }
+
+    std::sort(samplesUs.begin(), samplesUs.end());
+
+    // Nearest-rank percentile: the smallest sample with at least p% of the samples at or below it.
+    const auto percentile = [&](double p) noexcept
+    {
+        const double rank  = std::ceil((p / 100.0) * static_cast<double>(samplesUs.size()));
+        const size_t index = static_cast<size_t>(std::max(rank, 1.0)) - 1u;
+        return samplesUs[std::min(index, samplesUs.size() - 1u)];
+    };
+
+    uint64_t totalUs = 0;
+    for (const uint64_t sample : samplesUs)
+    {
+        totalUs += sample;
+    }
+
+    stats.iterations = static_cast<uint32_t>(samplesUs.size());
+    stats.minUs      = samplesUs.front();
+    stats.p50Us      = percentile(50.0);
+    stats.p95Us      = percentile(95.0);
+    stats.p99Us      = percentile(99.0);
+    stats.maxUs      = samplesUs.back();
+    stats.meanUs     = static_cast<double>(totalUs) / static_cast<double>(samplesUs.size());
+    return stats;
+}
+
+[[nodiscard]] bool CreateTextFile(const std::filesystem::path& path, size_t sizeBytes) noexcept
+{
+    std::string text;
+    text.reserve(sizeBytes + 128u);
+    for (size_t line = 0; text.size() < sizeBytes; ++line)
+    {
+        std::format_to(std::back_inserter(text), "{:08} The quick brown fox jumps over the lazy dog; benchmark payload line.\r\n", line);
+    }
+    return SelfTest::WriteTextFile(path, std::string_view(text));
+}
+
+// Field-for-field copy of FilesInformationS3::Entry (the plugin header is not part of the host build).
+struct S3ListingEntry
+{
+    std::wstring name;
+    unsigned long fileIndex  = 0;
+    unsigned long attributes = 0;
+    uint64_t sizeBytes       = 0;
+    __int64 creationTime     = 0;
+    __int64 lastAccessTime   = 0;
+    __int64 lastWriteTime    = 0;
+    __int64 changeTime       = 0;
+};
+
+// The listing class the S3 plugin uses, minus its sort (entries are generated in order).
+class S3ListingFilesInformation final : public CompactFilesInformationBase
+{
+public:
+    HRESULT Build(const std::vector<S3ListingEntry>& entries) noexcept
+    {
+        return Assign(entries);
+    }
+};
+
+// One flat S3 prefix of `count` objects, in listing order. A non-zero file index keeps the listing off the compact path,
+// i.e. lays it out as FileInfo records the way S3 listings were stored before compact listings.
+[[nodiscard]] bool BuildS3ListingEntries(size_t count, bool forceFileInfo, std::vector<S3ListingEntry>& entries) noexcept
+{
+    try
+    {
+        entries.clear();
+        entries.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            S3ListingEntry& entry = entries.emplace_back();
+            entry.name            = std::format(L"part-{:07}.json.gz", i);
+            entry.fileIndex       = forceFileInfo ? static_cast<unsigned long>(i + 1u) : 0u;
+            entry.attributes      = FILE_ATTRIBUTE_ARCHIVE;
+            entry.sizeBytes       = 4096u + (i % 8191u);
+            entry.lastWriteTime   = 133'000'000'000'000'000ll + static_cast<__int64>(i);
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        entries.clear();
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+void Trace(std::wstring_view message) noexcept
+{
+    SelfTest::AppendSuiteTrace(SelfTest::SelfTestSuite::Benchmarks, message);
+    SelfTest::AppendSelfTestTrace(message);
+}
+
+bool RecordMeasurement(SelfTest::CaseState& state,
+                       std::wstring_view caseName,
+                       const BaselineMap& baselines,
+                       std::vector<uint64_t> samplesUs,
+                       uint64_t itemsPerIteration,
+                       uint64_t bytesPerIteration) noexcept
+{
+    SelfTest::SelfTestBenchmarkStats stats = ComputeStats(std::move(samplesUs));
+    stats.itemsPerIteration                = itemsPerIteration;
+    stats.bytesPerIteration                = bytesPerIteration;
+
+    bool failRegression = false;
+    const auto baseline = baselines.find(std::wstring(caseName));
+    if (baseline != baselines.end() && baseline->second > 0)
+    {
+        const double ratio  = static_cast<double>(stats.p50Us) / static_cast<double>(baseline->second);
+        stats.baselineP50Us = baseline->second;
+        stats.deltaPercent  = (ratio - 1.0) * 100.0;
+        stats.regressed     = ratio > kRegressionWarnRatio;
+        failRegression      = ratio > kRegressionFailRatio && stats.p50Us > baseline->second + kRegressionNoiseFloorUs;
+    }
+
+    Trace(std::format(L"{}: p50={}us p95={}us p99={}us max={}us baseline_p50={}us delta={:+.1f}%{}",
+                      caseName,
+                      stats.p50Us,
+                      stats.p95Us,
+                      stats.p99Us,
+                      stats.maxUs,
+                      stats.baselineP50Us,
+                      stats.deltaPercent,
+                      stats.regressed ? L" REGRESSED" : L""));
+
+    state.benchmark = stats;
+    return state.Require(! failRegression,
+                         std::format(L"{}: p50 regressed from {}us to {}us ({:+.1f}%).", caseName, stats.baselineP50Us, stats.p50Us, stats.deltaPercent));
+}
+
+bool CreateFilledFile(const std::filesystem::path& path, uint64_t sizeBytes, uint8_t seed) noexcept
+{
+    wil::unique_handle file(CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+    if (! file)
+    {
+        return false;
+    }
+
+    constexpr size_t kChunkBytes = 1024u * 1024u;
+    std::vector<uint8_t> chunk(static_cast<size_t>(std::min<uint64_t>(sizeBytes, kChunkBytes)));
+    for (size_t i = 0; i < chunk.size(); ++i)
+    {
+        chunk[i] = static_cast<uint8_t>((i * 31u + seed) & 0xFFu);
+    }
+
+    uint64_t remaining = sizeBytes;
+    while (remaining > 0)
+    {
+        const DWORD toWrite = static_cast<DWORD>(std::min<uint64_t>(remaining, chunk.size()));
+        DWORD written       = 0;
+        if (! WriteFile(file.get(), chunk.data(), toWrite, &written, nullptr) || written != toWrite)
+        {
+            return false;
+        }
+        remaining -= written;
+    }
+
+    return true;
+}
+
+bool FileContentsEqual(const std::filesystem::path& left, const std::filesystem::path& right) noexcept
+{
+    wil::unique_handle leftFile(CreateFileW(left.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+    wil::unique_handle rightFile(CreateFileW(right.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+    if (! leftFile || ! rightFile)
+    {
+        return false;
+    }
+
+    constexpr DWORD kChunkBytes = 1024u * 1024u;
+    std::vector<uint8_t> leftChunk(kChunkBytes);
+    std::vector<uint8_t> rightChunk(kChunkBytes);
+    for (;;)
+    {
+        DWORD leftRead  = 0;
+        DWORD rightRead = 0;
+        if (! ReadFile(leftFile.get(), leftChunk.data(), kChunkBytes, &leftRead, nullptr) ||
+            ! ReadFile(rightFile.get(), rightChunk.data(), kChunkBytes, &rightRead, nullptr) || leftRead != rightRead)
+        {
+            return false;
+        }
+        if (leftRead == 0)
+        {
+            return true;
+        }
+        if (std::memcmp(leftChunk.data(), rightChunk.data(), leftRead) != 0)
+        {
+            return false;
+        }
+    }
+}
+
+bool RecreateDirectory(const std::filesystem::path& path) noexcept
+{
+    std::error_code ec;
+    std::filesystem::remove_all(path, ec);
+    return SelfTest::EnsureDirectory(path);
+}
+
+unsigned long GetEntryCount(IFilesInformation* info) noexcept
+{
+    unsigned long count = 0;
+    if (! info || FAILED(info->GetCount(&count)))
+    {
+        return 0;
+    }
+    return count;
+}
+} // namespace BenchmarksSelfTest
+
+bool BenchmarksSelfTest::Run(HWND mainWindow, const SelfTest::SelfTestOptions& options, SelfTest::SelfTestSuiteResult* outResult) noexcept
+{
+    const auto startedAt = std::chrono::steady_clock::now();
+    Debug::Info(L"Benchmarks: begin");
+    Trace(L"Benchmarks: begin");
+
+    SelfTest::SelfTestSuiteResult suite{};
+    suite.suite = SelfTest::SelfTestSuite::Benchmarks;
+
+    std::wstring_view baselineSource;
+    const BaselineMap baselines = LoadBaselines(baselineSource);
+    Trace(std::format(L"Benchmarks: {} baseline case(s) loaded from {}", baselines.size(), baselineSource));
+
+    std::wstring setupFailure;
+    wil::com_ptr<IFileSystem> localFs = SelfTest::GetFileSystem(kBuiltinLocalFileSystemId);
+    wil::com_ptr<IFileSystem> dummyFs = SelfTest::GetFileSystem(kBuiltinDummyFileSystemId);
+    wil::com_ptr<IInformations> dummyInfo;
+    if (! localFs)
+    {
+        setupFailure = L"Benchmarks: local file system plugin not available.";
+    }
+    else if (! dummyFs || FAILED(dummyFs->QueryInterface(__uuidof(IInformations), dummyInfo.put_void())) || ! dummyInfo)
+    {
+        setupFailure = L"Benchmarks: FileSystemDummy plugin not available.";
+    }
+
+    const std::filesystem::path workRoot = SelfTest::GetTempRoot(SelfTest::SelfTestSuite::Benchmarks) / L"work";
+    if (setupFailure.empty() && ! RecreateDirectory(workRoot))
+    {
+        setupFailure = L"Benchmarks: failed to create work root folder.";
+    }
+
+    if (! setupFailure.empty())
+    {
+        SelfTest::SelfTestCaseResult setup{};
+        setup.name   = L"setup";
+        setup.status = SelfTest::SelfTestCaseResult::Status::failed;
+        setup.reason = setupFailure;
+        suite.cases.push_back(std::move(setup));
+        ++suite.failed;
+        suite.failureMessage = setupFailure;
+    }
+    else
+    {
+        const std::string dummyConfig =
+            std::format("{{\"maxChildrenPerDirectory\":{},\"maxDepth\":1,\"seed\":1,\"latencyMs\":0,\"virtualSpeedLimit\":\"0\"}}", kDummyMaxChildren);
+        const SelfTest::PluginConfigurationGuard dummyConfigGuard(dummyFs.get(), dummyConfig);
+
+        // The dummy generator picks a skewed child count per root; probe a fixed set of roots and keep the largest so the
+        // listing is both deterministic and big enough to exercise the parallel sort path.
+        std::wstring dummyFolder;
+        unsigned long dummyEntries = 0;
+        for (uint32_t i = 0; dummyConfigGuard.Applied() && i < kDummyRootCandidates; ++i)
+        {
+            const std::wstring candidate = std::format(L"/benchmarks-{:02}", i);
+            wil::com_ptr<IFilesInformation> info;
+            if (SUCCEEDED(dummyFs->ReadDirectoryInfo(candidate.c_str(), info.put())) && GetEntryCount(info.get()) > dummyEntries)
+            {
+                dummyEntries = GetEntryCount(info.get());
+                dummyFolder  = candidate;
+            }
+        }
+        Trace(std::format(L"Benchmarks: dummy listing {} ({} entries)", dummyFolder, dummyEntries));
+
+        SelfTest::RunCase(options, suite, L"enum.dummy.read", [&](SelfTest::CaseState& state) noexcept
+        {
+            // Plugin enumeration cost: ReadDirectoryInfo into a FileInfo arena.
+            if (! state.Require(! dummyFolder.empty(), L"FileSystemDummy: no benchmark listing available."))
+            {
+                return false;
+            }
+
+            return Measure(state, L"enum.dummy.read", baselines, dummyEntries, 0, [&](Stopwatch& stopwatch) noexcept
+            {
+                wil::com_ptr<IFilesInformation> info;
+                stopwatch.Start();
+                const HRESULT hr = dummyFs->ReadDirectoryInfo(dummyFolder.c_str(), info.put());
+                stopwatch.Stop();
+                return SUCCEEDED(hr) && GetEntryCount(info.get()) == dummyEntries;
+            });
+        });
+
+        SelfTest::RunCase(options, suite, L"enum.dummy.folderview_items", [&](SelfTest::CaseState& state) noexcept
+        {
+            // FolderView worker cost after enumeration: build items from the FileInfo buffer and sort (directories first).
+            wil::com_ptr<IFilesInformation> info;
+            if (! state.Require(! dummyFolder.empty() && SUCCEEDED(dummyFs->ReadDirectoryInfo(dummyFolder.c_str(), info.put())),
+                                L"FileSystemDummy: benchmark listing read failed."))
+            {
+                return false;
+            }
+
+            return Measure(state, L"enum.dummy.folderview_items", baselines, dummyEntries, 0, [&](Stopwatch& stopwatch) noexcept
+            {
+                size_t itemCount = 0;
+                stopwatch.Start();
+                const HRESULT hr = FolderView::BenchmarkBuildSortedItems(info.get(), dummyFolder, itemCount);
+                stopwatch.Stop();
+                return SUCCEEDED(hr) && itemCount == dummyEntries;
+            });
+        });
+
+        SelfTest::RunCase(options, suite, L"enum.s3.folderview_items", [&](SelfTest::CaseState& state) noexcept
+        {
+            // Same step on a compact S3 listing: FolderView reads the columns and the shared UTF-16 name pool.
+            std::vector<S3ListingEntry> entries;
+            wil::com_ptr<S3ListingFilesInformation> info;
+            info.attach(new (std::nothrow) S3ListingFilesInformation());
+            if (! state.Require(info && BuildS3ListingEntries(kS3FolderViewEntryCount, false, entries) && SUCCEEDED(info->Build(entries)),
+                                L"Failed to build the compact S3 listing."))
+            {
+                return false;
+            }
+
+            return Measure(state, L"enum.s3.folderview_items", baselines, kS3FolderViewEntryCount, 0, [&](Stopwatch& stopwatch) noexcept
+            {
+                size_t itemCount = 0;
+                stopwatch.Start();
+                const HRESULT hr = FolderView::BenchmarkBuildSortedItems(info.get(), L"s3://bench/prefix", itemCount);
+                stopwatch.Stop();
+                return SUCCEEDED(hr) && itemCount == kS3FolderViewEntryCount;
+            });
+        });
+
+        for (const bool compactListing : {true, false})
+        {
+            const std::wstring caseName = compactListing ? L"enum.s3.1m.compact" : L"enum.s3.1m.fileinfo";
+            SelfTest::RunCase(options, suite, caseName, [&](SelfTest::CaseState& state) noexcept
+            {
+                // 1M-object S3 listing stored as compact columns vs FileInfo records: build time, and memory_bytes as
+                // DirectoryInfoCache weighs the listing.
+                std::vector<S3ListingEntry> entries;
+                if (! state.Require(BuildS3ListingEntries(kS3ListingEntryCount, ! compactListing, entries), L"Out of memory while generating S3 entries."))
+                {
+                    return false;
+                }
+
+                uint64_t memoryBytes = 0;
+                const bool ok        = Measure(state, caseName, baselines, kS3ListingEntryCount, 0, [&](Stopwatch& stopwatch) noexcept
+                {
+                    wil::com_ptr<S3ListingFilesInformation> info;
+                    info.attach(new (std::nothrow) S3ListingFilesInformation());
+                    if (! info)
+                    {
+                        return false;
+                    }
+
+                    stopwatch.Start();
+                    const HRESULT hr = info->Build(entries);
+                    stopwatch.Stop();
+
+                    wil::com_ptr<IFilesInformationCompact> compact;
+                    const bool isCompact = SUCCEEDED(info->QueryInterface(__uuidof(IFilesInformationCompact), compact.put_void()));
+                    memoryBytes          = DirectoryInfoCache::MeasureEntryBytes(info.get());
+                    return SUCCEEDED(hr) && isCompact == compactListing;
+                });
+
+                if (state.benchmark.has_value())
+                {
+                    state.benchmark->memoryBytes = memoryBytes;
+                    Trace(std::format(L"{}: memory={} bytes ({:.1f} bytes/entry)",
+                                      caseName,
+                                      memoryBytes,
+                                      static_cast<double>(memoryBytes) / static_cast<double>(kS3ListingEntryCount)));
+                }
+                return ok;
+            });
+        }
+
+        SelfTest::RunCase(options, suite, L"cache.borrow.miss", [&](SelfTest::CaseState& state) noexcept
+        {
+            // DirectoryInfoCache borrow of a dirty entry (re-enumerates through the plugin).
+            if (! state.Require(! dummyFolder.empty(), L"FileSystemDummy: no benchmark listing available."))
+            {
+                return false;
+            }
+
+            DirectoryInfoCache& cache = DirectoryInfoCache::GetInstance();
+            return Measure(state, L"cache.borrow.miss", baselines, dummyEntries, 0, [&](Stopwatch& stopwatch) noexcept
+            {
+                cache.InvalidateFolder(dummyFs.get(), dummyFolder);
+                stopwatch.Start();
+                auto borrowed = cache.BorrowDirectoryInfo(dummyFs.get(), dummyFolder, DirectoryInfoCache::BorrowMode::AllowEnumerate);
+                stopwatch.Stop();
+                return borrowed.Status() == S_OK && GetEntryCount(borrowed.Get()) == dummyEntries;
+            });
+        });
+
+        SelfTest::RunCase(options, suite, L"cache.borrow.hit", [&](SelfTest::CaseState& state) noexcept
+        {
+            // DirectoryInfoCache borrow of a clean entry; one sample covers kBorrowHitsPerSample borrows.
+            DirectoryInfoCache& cache = DirectoryInfoCache::GetInstance();
+            auto primed               = cache.BorrowDirectoryInfo(dummyFs.get(), dummyFolder, DirectoryInfoCache::BorrowMode::AllowEnumerate);
+            if (! state.Require(! dummyFolder.empty() && primed.Status() == S_OK, L"DirectoryInfoCache: failed to prime benchmark listing."))
+            {
+                return false;
+            }
+
+            return Measure(state, L"cache.borrow.hit", baselines, kBorrowHitsPerSample, 0, [&](Stopwatch& stopwatch) noexcept
+            {
+                bool ok = true;
+                stopwatch.Start();
+                for (uint32_t i = 0; i < kBorrowHitsPerSample; ++i)
+                {
+                    auto borrowed = cache.BorrowDirectoryInfo(dummyFs.get(), dummyFolder, DirectoryInfoCache::BorrowMode::CacheOnly);
+                    ok            = ok && borrowed.Status() == S_OK;
+                }
+                stopwatch.Stop();
+                return ok;
+            });
+        });
+
+        SelfTest::RunCase(options, suite, L"enum.local.read", [&](SelfTest::CaseState& state) noexcept
+        {
+            // Local file system enumeration of a flat folder.
+            const std::filesystem::path folder = workRoot / L"enum";
+            bool created                       = RecreateDirectory(folder);
+            for (size_t i = 0; created && i < kLocalEnumFileCount; ++i)
+            {
+                created = CreateFilledFile(folder / std::format(L"file_{:05}.dat", i), i % 97u, static_cast<uint8_t>(i));
+            }
+            if (! state.Require(created, L"Failed to create local enumeration tree."))
+            {
+                return false;
+            }
+
+            return Measure(state, L"enum.local.read", baselines, kLocalEnumFileCount, 0, [&](Stopwatch& stopwatch) noexcept
+            {
+                wil::com_ptr<IFilesInformation> info;
+                stopwatch.Start();
+                const HRESULT hr = localFs->ReadDirectoryInfo(folder.c_str(), info.put());
+                stopwatch.Stop();
+                return SUCCEEDED(hr) && GetEntryCount(info.get()) == kLocalEnumFileCount;
+            });
+        });
+
+        const Context fixtures{mainWindow, options, suite, baselines, localFs, dummyFs, dummyInfo, workRoot};
+        RunCompareCases(fixtures);
+        RunFileOperationCases(fixtures);
+        RunRemoteCases(fixtures);
+        RunFolderViewCases(fixtures);
+
+        SelfTest::RunCase(options, suite, L"viewer.text.open", [&](SelfTest::CaseState& state) noexcept
+        {
+            // Viewer open latency: instance creation + Open() until the viewer window is up (content loads asynchronously).
+            const std::filesystem::path file = workRoot / L"viewer" / L"sample.txt";
+            if (! state.Require(SelfTest::EnsureDirectory(file.parent_path()) && CreateTextFile(file, kViewerFileBytes), L"Failed to create viewer sample."))
+            {
+                return false;
+            }
+
+            const std::wstring focusedPath = file.wstring();
+            const wchar_t* otherFiles[]    = {focusedPath.c_str()};
+            ViewerPluginManager& viewers   = ViewerPluginManager::GetInstance();
+
+            return Measure(state, L"viewer.text.open", baselines, 1, kViewerFileBytes, [&](Stopwatch& stopwatch) noexcept
+            {
+                ViewerOpenContext context{};
+                context.ownerWindow           = mainWindow;
+                context.fileSystem            = localFs.get();
+                context.focusedPath           = focusedPath.c_str();
+                context.otherFiles            = otherFiles;
+                context.otherFileCount        = 1;
+                context.focusedOtherFileIndex = 0;
+                context.flags                 = VIEWER_OPEN_FLAG_NONE;
+
+                wil::com_ptr<IViewer> viewer;
+                stopwatch.Start();
+                HRESULT hr = viewers.CreateViewerInstance(kTextViewerId, g_settings, viewer);
+                if (SUCCEEDED(hr) && viewer)
+                {
+                    hr = viewer->Open(&context);
+                }
+                stopwatch.Stop();
+
+                if (viewer)
+                {
+                    static_cast<void>(viewer->Close());
+                }
+                return SUCCEEDED(hr) && viewer;
+            });
+        });
+
+        RunImageKernelCases(fixtures);
+
+        DirectoryInfoCache::GetInstance().ClearForFileSystem(dummyFs.get());
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(workRoot, ec);
+
+    const auto endedAt = std::chrono::steady_clock::now();
+    suite.durationMs   = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(endedAt - startedAt).count());
+
+    if (outResult)
+    {
+        *outResult = suite;
+    }
+
+    if (options.writeJsonSummary)
+    {
+        SelfTest::WriteSuiteJson(suite, SelfTest::GetSuiteArtifactPath(SelfTest::SelfTestSuite::Benchmarks, L"results.json"));
+    }
+
+    if (suite.failed == 0)
+    {
+        SaveBaselines(baselines, suite);
+    }
+
+    if (suite.failed != 0)
+    {
+        Trace(L"Benchmarks: failed");
+        Debug::Error(L"Benchmarks: failed.");
+        return false;
+    }
+
+    Trace(L"Benchmarks: passed");
+    Debug::Info(L"Benchmarks: passed.");
+    return true;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include "SelfTestCommon.h"
+
+// BenchmarksSelfTest - headless timing suite (compiled in every configuration, run via --benchmarks).
+// Each case times a hot path over deterministic FileSystemDummy trees or generated local temp trees and records
+// percentiles in benchmarks\results.json; p50 is diffed against previous_run\benchmarks\results.json.
+namespace BenchmarksSelfTest
+{
+[[nodiscard]] bool Run(HWND mainWindow, const SelfTest::SelfTestOptions& options = {}, SelfTest::SelfTestSuiteResult* outResult = nullptr) noexcept;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+// Internal implementation header for the --benchmarks suite.
+// Keep this header private to the Benchmarks.SelfTest*.cpp translation units.
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#pragma warning(push)
+// WIL: C4625 (copy ctor deleted), C4626 (copy assign deleted), C5026 (move ctor deleted), C5027 (move assign deleted)
+#pragma warning(disable : 4625 4626 5026 5027 28182)
+#include <wil/com.h>
+#pragma warning(pop)
+
+#include "PlugInterfaces/FileSystem.h"
+#include "PlugInterfaces/Informations.h"
+#include "SelfTestCommon.h"
+
+namespace BenchmarksSelfTest
+{
+inline constexpr uint32_t kWarmupIterations   = 2;
+inline constexpr uint32_t kMeasuredIterations = 15;
+
+// FileSystemDummy roots probed for the largest listing (the generator picks a skewed child count per root).
+inline constexpr uint32_t kDummyRootCandidates = 16;
+
+using BaselineMap = std::unordered_map<std::wstring, uint64_t>;
+
+void Trace(std::wstring_view message) noexcept;
+
+class Stopwatch
+{
+public:
+    void Start() noexcept
+    {
+        _startedAt = std::chrono::steady_clock::now();
+    }
+
+    void Stop() noexcept
+    {
+        _elapsed += std::chrono::steady_clock::now() - _startedAt;
+    }
+
+    uint64_t ElapsedUs() const noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(_elapsed).count());
+    }
+
+private:
+    std::chrono::steady_clock::time_point _startedAt{};
+    std::chrono::steady_clock::duration _elapsed{};
+};
+
+// Turns the measured samples into state.benchmark (percentiles, throughput inputs, baseline delta) and fails the case on a
+// p50 regression beyond the fail ratio.
+bool RecordMeasurement(SelfTest::CaseState& state,
+                       std::wstring_view caseName,
+                       const BaselineMap& baselines,
+                       std::vector<uint64_t> samplesUs,
+                       uint64_t itemsPerIteration,
+                       uint64_t bytesPerIteration) noexcept;
+
+// Runs kWarmupIterations + kMeasuredIterations iterations of `iteration(Stopwatch&)`; the callback starts/stops the
+// stopwatch around the measured work so per-iteration setup (deleting copy targets, etc.) is excluded.
+template <typename Func>
+bool Measure(SelfTest::CaseState& state,
+             std::wstring_view caseName,
+             const BaselineMap& baselines,
+             uint64_t itemsPerIteration,
+             uint64_t bytesPerIteration,
+             Func&& iteration) noexcept
+{
+    std::vector<uint64_t> samplesUs;
+    samplesUs.reserve(kMeasuredIterations);
+
+    for (uint32_t i = 0; i < kWarmupIterations + kMeasuredIterations; ++i)
+    {
+        Stopwatch stopwatch;
+        if (! iteration(stopwatch))
+        {
+            return state.Require(false, std::format(L"{}: iteration {} failed.", caseName, i));
+        }
+
+        if (i >= kWarmupIterations)
+        {
+            samplesUs.push_back(stopwatch.ElapsedUs());
+        }
+    }
+
+    return RecordMeasurement(state, caseName, baselines, std::move(samplesUs), itemsPerIteration, bytesPerIteration);
+}
+
+[[nodiscard]] bool CreateFilledFile(const std::filesystem::path& path, uint64_t sizeBytes, uint8_t seed) noexcept;
+[[nodiscard]] bool FileContentsEqual(const std::filesystem::path& left, const std::filesystem::path& right) noexcept;
+[[nodiscard]] bool RecreateDirectory(const std::filesystem::path& path) noexcept;
+[[nodiscard]] unsigned long GetEntryCount(IFilesInformation* info) noexcept;
+
+// Fixtures Run() sets up before the first case, shared by the per-area case runners.
+struct Context
+{
+    HWND mainWindow;
+    const SelfTest::SelfTestOptions& options;
+    SelfTest::SelfTestSuiteResult& suite;
+    const BaselineMap& baselines;
+    const wil::com_ptr<IFileSystem>& localFs;
+    const wil::com_ptr<IFileSystem>& dummyFs;
+    const wil::com_ptr<IInformations>& dummyInfo;
+    const std::filesystem::path& workRoot;
+};
+
+// Per-area case runners, called by Run() in this order (Benchmarks.SelfTest.Compare.cpp, .FileOps.cpp, .Remote.cpp,
+// .FolderView.cpp, .Kernels.cpp).
+void RunCompareCases(const Context& context) noexcept;
+void RunFileOperationCases(const Context& context) noexcept;
+void RunRemoteCases(const Context& context) noexcept;
+void RunFolderViewCases(const Context& context) noexcept;
+void RunImageKernelCases(const Context& context) noexcept;
+} // namespace BenchmarksSelfTest
@@ -69,6 +69,7 @@ constexpr std::array<CommandInfo, 125> kCommands = {
     CommandInfo{L"cmd/pane/display/brief", IDS_CMD_DISPLAY_BRIEF, IDS_CMD_DESC_DISPLAY_BRIEF, IDM_PANE_DISPLAY_BRIEF},
     CommandInfo{L"cmd/pane/display/detailed", IDS_CMD_DISPLAY_DETAILED, IDS_CMD_DESC_DISPLAY_DETAILED, IDM_PANE_DISPLAY_DETAILED},
     CommandInfo{L"cmd/pane/display/extraDetailed", IDS_CMD_DISPLAY_EXTRA_DETAILED, IDS_CMD_DESC_DISPLAY_EXTRA_DETAILED, IDM_PANE_DISPLAY_EXTRA_DETAILED},
+    CommandInfo{L"cmd/pane/display/thumbnails", IDS_CMD_DISPLAY_THUMBNAILS, IDS_CMD_DESC_DISPLAY_THUMBNAILS, IDM_PANE_DISPLAY_THUMBNAILS},
     CommandInfo{L"cmd/pane/edit", IDS_CMD_EDIT, IDS_CMD_DESC_EDIT, IDM_PANE_EDIT},
     CommandInfo{L"cmd/pane/editNew", IDS_CMD_EDIT_NEW, IDS_CMD_DESC_EDIT_NEW, IDM_PANE_EDIT_NEW},
     CommandInfo{L"cmd/pane/editWidth", IDS_CMD_EDIT_WIDTH, IDS_CMD_DESC_EDIT_WIDTH, IDM_PANE_EDIT_WIDTH},
@@ -1,21 +1,28 @@
 #include "Framework.h"
 
 #include "CompareDirectoriesEngine.h"
+#include "Helpers.h"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <cwctype>
 #include <deque>
+#include <execution>
 #include <filesystem>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -26,16 +33,32 @@
 #include <wil/resource.h>
 #pragma warning(pop)
 
+#include <yyjson.h>
+
 namespace
 {
+constexpr uint32_t kDefaultScanWorkersPerPane = 4u;
+constexpr uint32_t kMaxScanWorkersPerPane     = 16u;
+
 struct SideEntry
 {
+    std::wstring_view name; // Normalized name, pointing into the listing's IFilesInformation buffer
     bool isDirectory      = false;
     uint64_t sizeBytes    = 0;
     int64_t lastWriteTime = 0;
     DWORD fileAttributes  = 0;
 };
 
+// One side of a folder: entries sorted with WStringViewNoCaseLess, duplicates removed (first listed wins).
+struct SideListing
+{
+    wil::com_ptr<IFilesInformation> info; // Keeps the name views alive
+    std::vector<SideEntry> entries;
+    bool succeeded     = true;
+    bool folderMissing = false;
+    HRESULT hr         = S_OK;
+};
+
 [[nodiscard]] size_t CombineHash(size_t seed, size_t value) noexcept
 {
     // 64-bit mix (boost-like).
@@ -235,8 +258,323 @@ struct SideEntry
 
     return settings.ignoreFiles && MatchesAnyPattern(name, ignoreFilePatterns);
 }
+
+[[nodiscard]] uint32_t DetermineScanWorkersPerPane(const wil::com_ptr<IFileSystem>& fileSystem) noexcept
+{
+    // Plugins may cap concurrent directory reads via capabilities "concurrency.readDirectoryMax"; listings are read-only, so an
+    // absent key falls back to a small default rather than to 1.
+    if (! fileSystem)
+    {
+        return kDefaultScanWorkersPerPane;
+    }
+
+    const char* capabilitiesText = nullptr;
+    if (FAILED(fileSystem->GetCapabilities(&capabilitiesText)) || ! capabilitiesText || capabilitiesText[0] == '\0')
+    {
+        return kDefaultScanWorkersPerPane;
+    }
+
+    const std::string_view capabilitiesView(capabilitiesText);
+    std::unique_ptr<yyjson_doc, decltype(&yyjson_doc_free)> doc(
+        yyjson_read(capabilitiesView.data(), capabilitiesView.size(), YYJSON_READ_JSON5 | YYJSON_READ_ALLOW_BOM), &yyjson_doc_free);
+    if (! doc)
+    {
+        return kDefaultScanWorkersPerPane;
+    }
+
+    yyjson_val* root              = yyjson_doc_get_root(doc.get());
+    yyjson_val* concurrencyObject = (root && yyjson_is_obj(root)) ? yyjson_obj_get(root, "concurrency") : nullptr;
+    yyjson_val* valueNode         = (concurrencyObject && yyjson_is_obj(concurrencyObject)) ? yyjson_obj_get(concurrencyObject, "readDirectoryMax") : nullptr;
+    if (! valueNode)
+    {
+        return kDefaultScanWorkersPerPane;
+    }
+
+    uint64_t concurrency = 0;
+    if (yyjson_is_uint(valueNode))
+    {
+        concurrency = yyjson_get_uint(valueNode);
+    }
+    else if (yyjson_is_int(valueNode))
+    {
+        const int64_t signedValue = yyjson_get_int(valueNode);
+        if (signedValue > 0)
+        {
+            concurrency = static_cast<uint64_t>(signedValue);
+        }
+    }
+
+    if (concurrency == 0)
+    {
+        return kDefaultScanWorkersPerPane;
+    }
+
+    return static_cast<uint32_t>(std::min<uint64_t>(concurrency, kMaxScanWorkersPerPane));
+}
 } // namespace
 
+CompareDirectoriesItemTable::CompareDirectoriesItemTable(const CompareDirectoriesItemTable& other) : _entries(other._entries)
+{
+    AdoptNamePool(other._namePool, other._namePool.data());
+}
+
+CompareDirectoriesItemTable& CompareDirectoriesItemTable::operator=(const CompareDirectoriesItemTable& other)
+{
+    if (this != &other)
+    {
+        CompareDirectoriesItemTable copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+void CompareDirectoriesItemTable::AdoptNamePool(std::vector<wchar_t> pool, const wchar_t* previousBase) noexcept
+{
+    // `pool` holds the same characters as the buffer at `previousBase` (which is still alive); re-point every name into it.
+    for (value_type& entry : _entries)
+    {
+        const size_t offset = static_cast<size_t>(entry.first.data() - previousBase);
+        entry.first         = std::wstring_view(pool.data() + offset, entry.first.size());
+    }
+    _namePool = std::move(pool);
+}
+
+void CompareDirectoriesItemTable::Reserve(size_t count, size_t nameChars)
+{
+    _entries.reserve(count);
+    if (nameChars > _namePool.capacity())
+    {
+        std::vector<wchar_t> pool;
+        pool.reserve(nameChars);
+        pool.assign(_namePool.begin(), _namePool.end());
+        AdoptNamePool(std::move(pool), _namePool.data());
+    }
+}
+
+CompareDirectoriesItemDecision& CompareDirectoriesItemTable::Append(std::wstring_view name, const CompareDirectoriesItemDecision& item)
+{
+    if (_namePool.size() + name.size() > _namePool.capacity())
+    {
+        Reserve(_entries.size() + 1u, std::max(_namePool.capacity() * 2u, _namePool.size() + name.size()));
+    }
+
+    const size_t offset = _namePool.size();
+    _namePool.insert(_namePool.end(), name.begin(), name.end());
+    _entries.emplace_back(std::wstring_view(_namePool.data() + offset, name.size()), item);
+    return _entries.back().second;
+}
+
+CompareDirectoriesItemTable::iterator CompareDirectoriesItemTable::find(std::wstring_view name) noexcept
+{
+    const WStringViewNoCaseLess less;
+    const auto entryLess = [&](const value_type& entry, std::wstring_view key) noexcept { return less(entry.first, key); };
+    const auto it        = std::lower_bound(_entries.begin(), _entries.end(), name, entryLess);
+    return (it != _entries.end() && ! less(name, it->first)) ? it : _entries.end();
+}
+
+CompareDirectoriesItemTable::const_iterator CompareDirectoriesItemTable::find(std::wstring_view name) const noexcept
+{
+    const WStringViewNoCaseLess less;
+    const auto entryLess = [&](const value_type& entry, std::wstring_view key) noexcept { return less(entry.first, key); };
+    const auto it        = std::lower_bound(_entries.begin(), _entries.end(), name, entryLess);
+    return (it != _entries.end() && ! less(name, it->first)) ? it : _entries.end();
+}
+
+namespace
+{
+thread_local const void* g_scanWorkerGroup = nullptr;
+thread_local size_t g_scanWorkerQueue      = 0;
+} // namespace
+
+// Bounded work-stealing pool for directory listings, owned by the session and shared by every GetOrComputeDecision call.
+// Each pane gets its own group of workers, so concurrent ReadDirectoryInfo calls against either root never exceed the group
+// size, however many scans run at once. A worker pops its own queue LIFO (depth-first keeps the frontier small) and steals
+// FIFO from its siblings when idle. Each call tracks its own tasks with a Batch.
+class CompareScanPool final
+{
+public:
+    using Task = std::function<void()>;
+
+    class Batch final
+    {
+    public:
+        Batch() noexcept = default;
+
+        Batch(const Batch&)            = delete;
+        Batch& operator=(const Batch&) = delete;
+        Batch(Batch&&)                 = delete;
+        Batch& operator=(Batch&&)      = delete;
+
+        void Add() noexcept
+        {
+            static_cast<void>(_outstanding.fetch_add(1u, std::memory_order_acq_rel));
+        }
+
+        void Done() noexcept
+        {
+            if (_outstanding.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            {
+                // Notify under the lock: the waiter owns the batch on its stack and may destroy it as soon as it wakes.
+                std::lock_guard guard(_mutex);
+                _cv.notify_all();
+            }
+        }
+
+        // Returns once every task and hold added to this batch (including ones added by its tasks) is done.
+        void Wait() noexcept
+        {
+            std::unique_lock lock(_mutex);
+            _cv.wait(lock, [&]() noexcept { return _outstanding.load(std::memory_order_acquire) == 0u; });
+        }
+
+    private:
+        std::atomic_uint64_t _outstanding{0};
+        std::mutex _mutex;
+        std::condition_variable _cv;
+    };
+
+    explicit CompareScanPool(uint32_t workersPerPane)
+    {
+        const uint32_t workers = std::max(workersPerPane, 1u);
+        for (Group& group : _groups)
+        {
+            group.queues.reserve(workers);
+            for (uint32_t i = 0; i < workers; ++i)
+            {
+                group.queues.emplace_back(std::make_unique<Queue>());
+            }
+
+            group.threads.reserve(workers);
+            for (uint32_t i = 0; i < workers; ++i)
+            {
+                const size_t queueIndex = i;
+                group.threads.emplace_back([this, &group, queueIndex](std::stop_token stopToken) noexcept { WorkerLoop(stopToken, group, queueIndex); });
+            }
+        }
+    }
+
+    ~CompareScanPool()
+    {
+        for (Group& group : _groups)
+        {
+            for (auto& thread : group.threads)
+            {
+                thread.request_stop();
+            }
+            group.threads.clear();
+        }
+    }
+
+    CompareScanPool(const CompareScanPool&)            = delete;
+    CompareScanPool& operator=(const CompareScanPool&) = delete;
+    CompareScanPool(CompareScanPool&&)                 = delete;
+    CompareScanPool& operator=(CompareScanPool&&)      = delete;
+
+    void Submit(ComparePane pane, Batch& batch, Task task)
+    {
+        Group& group = _groups[pane == ComparePane::Left ? 0u : 1u];
+
+        // Work spawned by a worker stays on its own queue; everything else is spread round-robin.
+        const size_t queueIndex =
+            g_scanWorkerGroup == &group ? g_scanWorkerQueue : (group.nextQueue.fetch_add(1u, std::memory_order_relaxed) % group.queues.size());
+
+        batch.Add();
+        {
+            Queue& queue = *group.queues[queueIndex];
+            std::lock_guard guard(queue.mutex);
+            queue.tasks.push_back(Work{&batch, std::move(task)});
+        }
+        {
+            std::lock_guard guard(group.wakeMutex);
+            ++group.queued;
+        }
+        group.wakeCv.notify_one();
+    }
+
+private:
+    struct Work
+    {
+        Batch* batch = nullptr;
+        Task run;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Work> tasks;
+    };
+
+    struct Group
+    {
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::atomic_uint32_t nextQueue{0};
+        std::mutex wakeMutex;
+        std::condition_variable_any wakeCv;
+        int64_t queued = 0; // Guarded by wakeMutex; may dip below zero briefly while a push races a steal
+        std::vector<std::jthread> threads;
+    };
+
+    [[nodiscard]] static bool TryTake(Group& group, size_t queueIndex, Work& outWork) noexcept
+    {
+        const size_t queueCount = group.queues.size();
+        for (size_t attempt = 0; attempt < queueCount; ++attempt)
+        {
+            Queue& queue = *group.queues[(queueIndex + attempt) % queueCount];
+            std::lock_guard guard(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                continue;
+            }
+
+            if (attempt == 0)
+            {
+                outWork = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                outWork = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            break;
+        }
+
+        if (! outWork.run)
+        {
+            return false;
+        }
+
+        std::lock_guard guard(group.wakeMutex);
+        --group.queued;
+        return true;
+    }
+
+    void WorkerLoop(std::stop_token stopToken, Group& group, size_t queueIndex) noexcept
+    {
+        [[maybe_unused]] auto coInit = wil::CoInitializeEx(COINIT_MULTITHREADED);
+
+        g_scanWorkerGroup = &group;
+        g_scanWorkerQueue = queueIndex;
+
+        while (! stopToken.stop_requested())
+        {
+            Work work;
+            if (! TryTake(group, queueIndex, work))
+            {
+                std::unique_lock lock(group.wakeMutex);
+                static_cast<void>(group.wakeCv.wait(lock, stopToken, [&]() noexcept { return group.queued > 0; }));
+                continue;
+            }
+
+            work.run();
+            work.run = nullptr;
+            work.batch->Done();
+        }
+    }
+
+    std::array<Group, 2> _groups;
+};
+
 CompareDirectoriesSession::CompareDirectoriesSession(wil::com_ptr<IFileSystem> baseFileSystem,
                                                      std::filesystem::path leftRoot,
                                                      std::filesystem::path rightRoot,
@@ -262,10 +600,15 @@ CompareDirectoriesSession::CompareDirectoriesSession(wil::com_ptr<IFileSystem> b
             _baseFileSystemIo = std::move(io);
         }
     }
+
+    _scanWorkersPerPane = DetermineScanWorkersPerPane(_baseFileSystem);
 }
 
 CompareDirectoriesSession::~CompareDirectoriesSession()
 {
+    // No scan can be running once the last owner lets go; stopping the listing workers first keeps them off the members below.
+    _scanPool.reset();
+
     for (auto& worker : _contentCompareWorkers)
     {
         worker.request_stop();
@@ -281,6 +624,36 @@ CompareDirectoriesSession::~CompareDirectoriesSession()
     _contentCompareCv.notify_all();
 }
 
+CompareScanPool& CompareDirectoriesSession::GetScanPool()
+{
+    std::lock_guard guard(_mutex);
+    if (! _scanPool)
+    {
+        _scanPool = std::make_unique<CompareScanPool>(_scanWorkersPerPane);
+    }
+    return *_scanPool;
+}
+
+void CompareDirectoriesSession::ReleaseScanClaim(const std::wstring& key, const std::shared_ptr<ScanClaim>& claim) noexcept
+{
+    std::vector<std::function<void()>> waiters;
+    {
+        std::lock_guard guard(_mutex);
+        const auto it = _scanClaims.find(key);
+        if (it != _scanClaims.end() && it->second == claim)
+        {
+            _scanClaims.erase(it);
+        }
+        waiters.swap(claim->waiters);
+    }
+
+    // Waiters may finalize (and publish) folders of other calls, which takes _mutex again.
+    for (auto& waiter : waiters)
+    {
+        waiter();
+    }
+}
+
 size_t CompareDirectoriesSession::ContentCompareKeyHash::operator()(const ContentCompareKey& key) const noexcept
 {
     size_t hash = std::hash<std::wstring_view>{}(key.leftPath);
@@ -1154,68 +1527,96 @@ namespace
                                            const Common::Settings::CompareDirectoriesSettings& settings,
                                            const std::vector<std::wstring>& ignoreFilePatterns,
                                            const std::vector<std::wstring>& ignoreDirectoryPatterns,
-                                           std::map<std::wstring, SideEntry, WStringViewNoCaseLess>& outEntries,
-                                           bool& outFolderMissing,
-                                           HRESULT& outHr) noexcept
+                                           SideListing& outListing) noexcept
 {
-    outEntries.clear();
-    outFolderMissing = false;
-    outHr            = S_OK;
+    outListing.info.reset();
+    outListing.entries.clear();
+    outListing.folderMissing = false;
+    outListing.hr            = S_OK;
 
     if (! baseFs)
     {
-        outHr = E_POINTER;
+        outListing.hr = E_POINTER;
         return false;
     }
 
-    wil::com_ptr<IFilesInformation> info;
-    const HRESULT hr = baseFs->ReadDirectoryInfo(absoluteFolder.c_str(), info.put());
+    const HRESULT hr = baseFs->ReadDirectoryInfo(absoluteFolder.c_str(), outListing.info.put());
     if (FAILED(hr))
     {
+        outListing.info.reset();
         if (IsMissingPathError(hr))
         {
-            outFolderMissing = true;
-            outHr            = S_OK;
+            outListing.folderMissing = true;
             return true;
         }
 
-        outHr = hr;
+        outListing.hr = hr;
         return false;
     }
 
     FileInfo* head         = nullptr;
-    const HRESULT hrBuffer = info->GetBuffer(&head);
+    const HRESULT hrBuffer = outListing.info->GetBuffer(&head);
     if (FAILED(hrBuffer))
     {
-        outHr = hrBuffer;
+        outListing.hr = hrBuffer;
         return false;
     }
 
-    for (FileInfo* entry = head; entry != nullptr;)
+    unsigned long count = 0;
+    static_cast<void>(outListing.info->GetCount(&count));
+
+    std::vector<SideEntry>& entries = outListing.entries;
+    try
     {
-        const size_t nameChars = static_cast<size_t>(entry->FileNameSize) / sizeof(wchar_t);
-        const std::wstring_view name(entry->FileName, nameChars);
-        const std::wstring_view normalizedName = NormalizeEntryNameForCompare(name);
+        entries.reserve(count);
 
-        const bool isDir = (entry->FileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-        if (! ShouldIgnoreEntry(normalizedName, isDir, settings, ignoreFilePatterns, ignoreDirectoryPatterns))
+        for (FileInfo* entry = head; entry != nullptr;)
         {
-            SideEntry out{};
-            out.isDirectory    = isDir;
-            out.fileAttributes = entry->FileAttributes;
-            out.lastWriteTime  = entry->LastWriteTime;
-            out.sizeBytes      = (! isDir && entry->EndOfFile > 0) ? static_cast<uint64_t>(entry->EndOfFile) : 0;
-            outEntries.emplace(std::wstring(normalizedName), out);
-        }
+            const size_t nameChars = static_cast<size_t>(entry->FileNameSize) / sizeof(wchar_t);
+            const std::wstring_view name(entry->FileName, nameChars);
+            const std::wstring_view normalizedName = NormalizeEntryNameForCompare(name);
 
-        if (entry->NextEntryOffset == 0)
-        {
-            break;
+            const bool isDir = (entry->FileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            if (! ShouldIgnoreEntry(normalizedName, isDir, settings, ignoreFilePatterns, ignoreDirectoryPatterns))
+            {
+                SideEntry out{};
+                out.name           = normalizedName;
+                out.isDirectory    = isDir;
+                out.fileAttributes = entry->FileAttributes;
+                out.lastWriteTime  = entry->LastWriteTime;
+                out.sizeBytes      = (! isDir && entry->EndOfFile > 0) ? static_cast<uint64_t>(entry->EndOfFile) : 0;
+                entries.push_back(out);
+            }
+
+            if (entry->NextEntryOffset == 0)
+            {
+                break;
+            }
+            entry = reinterpret_cast<FileInfo*>(reinterpret_cast<unsigned char*>(entry) + entry->NextEntryOffset);
         }
-        entry = reinterpret_cast<FileInfo*>(reinterpret_cast<unsigned char*>(entry) + entry->NextEntryOffset);
+    }
+    catch (const std::bad_alloc&)
+    {
+        outListing.hr = E_OUTOFMEMORY;
+        return false;
     }
 
-    outHr = S_OK;
+    // Stable so that, as with the previous map insert, the first listed of several equal names is the one kept.
+    // The merge join and CompareDirectoriesItemTable::find rely on this exact order, so all three use WStringViewNoCaseLess.
+    const auto nameLess = [](const SideEntry& a, const SideEntry& b) noexcept { return WStringViewNoCaseLess::Compare(a.name, b.name) < 0; };
+    if (entries.size() >= kParallelSortThreshold)
+    {
+        std::stable_sort(std::execution::par, entries.begin(), entries.end(), nameLess);
+    }
+    else
+    {
+        std::stable_sort(entries.begin(), entries.end(), nameLess);
+    }
+
+    const auto nameEqual = [](const SideEntry& a, const SideEntry& b) noexcept { return WStringViewNoCaseLess::Compare(a.name, b.name) == 0; };
+    entries.erase(std::unique(entries.begin(), entries.end(), nameEqual), entries.end());
+
+    outListing.hr = S_OK;
     return true;
 }
 
@@ -1758,7 +2159,14 @@ std::shared_ptr<const CompareDirectoriesFolderDecision> CompareDirectoriesSessio
         return {};
     };
 
-    auto computeDecisionBase = [&](const std::filesystem::path& folderRel) -> std::shared_ptr<CompareDirectoriesFolderDecision>
+    auto readSide = [&](ComparePane pane, const std::filesystem::path& folderRel, SideListing& listing)
+    {
+        const std::filesystem::path folder = ResolveAbsolute(pane, folderRel);
+        listing.succeeded                  = TryReadDirectoryEntries(_baseFileSystem, folder, settings, ignoreFilePatterns, ignoreDirectoryPatterns, listing);
+    };
+
+    auto computeDecisionBase =
+        [&](const std::filesystem::path& folderRel, const SideListing& left, const SideListing& right) -> std::shared_ptr<CompareDirectoriesFolderDecision>
     {
         const std::filesystem::path leftFolder  = ResolveAbsolute(ComparePane::Left, folderRel);
         const std::filesystem::path rightFolder = ResolveAbsolute(ComparePane::Right, folderRel);
@@ -1782,66 +2190,80 @@ std::shared_ptr<const CompareDirectoriesFolderDecision> CompareDirectoriesSessio
             return decision;
         }
 
-        std::map<std::wstring, SideEntry, WStringViewNoCaseLess> leftEntries;
-        std::map<std::wstring, SideEntry, WStringViewNoCaseLess> rightEntries;
+        const auto& leftEntries  = left.entries;
+        const auto& rightEntries = right.entries;
 
-        bool leftMissing = false;
-        HRESULT leftHr   = S_OK;
-        if (! TryReadDirectoryEntries(_baseFileSystem, leftFolder, settings, ignoreFilePatterns, ignoreDirectoryPatterns, leftEntries, leftMissing, leftHr))
+        // Both sides were listed concurrently; report them as the sequential read did (a left failure masks the right side).
+        if (! left.succeeded)
         {
-            decision->hr = leftHr;
+            decision->hr = left.hr;
         }
-        decision->leftFolderMissing = leftMissing;
+        decision->leftFolderMissing = left.folderMissing;
 
-        if (isCancelled())
+        if (SUCCEEDED(decision->hr) && ! right.succeeded)
         {
-            return decision;
+            decision->hr = right.hr;
         }
-
-        bool rightMissing = false;
-        HRESULT rightHr   = S_OK;
-        if (SUCCEEDED(decision->hr) &&
-            ! TryReadDirectoryEntries(_baseFileSystem, rightFolder, settings, ignoreFilePatterns, ignoreDirectoryPatterns, rightEntries, rightMissing, rightHr))
-        {
-            decision->hr = rightHr;
-        }
-        decision->rightFolderMissing = rightMissing;
+        decision->rightFolderMissing = left.succeeded && right.folderMissing;
 
         if (SUCCEEDED(decision->hr))
         {
-            // Seed with left entries first (preserves left casing as key when both exist).
-            for (const auto& [name, entry] : leftEntries)
+            // Linear merge join of the two sorted listings (left casing names the item when both exist).
+            size_t nameChars = 0;
+            for (const auto* side : {&leftEntries, &rightEntries})
             {
-                CompareDirectoriesItemDecision item{};
-                item.existsLeft         = true;
-                item.isDirectory        = entry.isDirectory;
-                item.leftSizeBytes      = entry.sizeBytes;
-                item.leftLastWriteTime  = entry.lastWriteTime;
-                item.leftFileAttributes = entry.fileAttributes;
-                decision->items.emplace(name, item);
+                for (const SideEntry& entry : *side)
+                {
+                    nameChars += entry.name.size();
+                }
             }
+            decision->items.Reserve(leftEntries.size() + rightEntries.size(), nameChars);
 
-            for (const auto& [name, entry] : rightEntries)
+            size_t leftIndex  = 0;
+            size_t rightIndex = 0;
+            while (leftIndex < leftEntries.size() || rightIndex < rightEntries.size())
             {
-                auto it = decision->items.find(name);
-                if (it == decision->items.end())
+                int order = 0;
+                if (leftIndex == leftEntries.size())
+                {
+                    order = 1;
+                }
+                else if (rightIndex == rightEntries.size())
+                {
+                    order = -1;
+                }
+                else
+                {
+                    order = WStringViewNoCaseLess::Compare(leftEntries[leftIndex].name, rightEntries[rightIndex].name);
+                }
+
+                CompareDirectoriesItemDecision item{};
+                std::wstring_view name;
+                if (order <= 0)
+                {
+                    const SideEntry& entry  = leftEntries[leftIndex++];
+                    name                    = entry.name;
+                    item.existsLeft         = true;
+                    item.isDirectory        = entry.isDirectory;
+                    item.leftSizeBytes      = entry.sizeBytes;
+                    item.leftLastWriteTime  = entry.lastWriteTime;
+                    item.leftFileAttributes = entry.fileAttributes;
+                }
+                if (order >= 0)
                 {
-                    CompareDirectoriesItemDecision item{};
+                    const SideEntry& entry = rightEntries[rightIndex++];
+                    if (! item.existsLeft)
+                    {
+                        name = entry.name;
+                    }
                     item.existsRight         = true;
-                    item.isDirectory         = entry.isDirectory;
+                    item.isDirectory         = item.isDirectory || entry.isDirectory;
                     item.rightSizeBytes      = entry.sizeBytes;
                     item.rightLastWriteTime  = entry.lastWriteTime;
                     item.rightFileAttributes = entry.fileAttributes;
-                    decision->items.emplace(name, item);
-                    continue;
                 }
 
-                CompareDirectoriesItemDecision& item = it->second;
-                item.existsRight                     = true;
-                item.isDirectory                     = item.isDirectory || entry.isDirectory;
-                item.rightSizeBytes                  = entry.sizeBytes;
-                item.rightLastWriteTime              = entry.lastWriteTime;
-                item.rightFileAttributes             = entry.fileAttributes;
+                decision->items.Append(name, item);
             }
 
             for (auto& [name, item] : decision->items)
@@ -2087,188 +2509,329 @@ std::shared_ptr<const CompareDirectoriesFolderDecision> CompareDirectoriesSessio
         return decision;
     };
 
-    struct FolderFrame
+    // Scan scheduler: every folder of the subtree is a node whose two listings run as separate tasks on the session's pool
+    // (left and right concurrently, each bounded by its pane's worker group across all calls). Whichever listing finishes
+    // second builds the base decision and fans out the child folders; a node is finalized (subdir bits, aggregates) and
+    // published into _cache as soon as its last child subtree finishes, so callers navigating into a finished subtree do not
+    // wait for the whole scan. A folder another call is already scanning is not listed twice: this call waits for it instead.
+    struct ScanNode
     {
-        enum class State : uint8_t
+        ScanNode() = default;
+
+        ScanNode(const ScanNode&)            = delete;
+        ScanNode& operator=(const ScanNode&) = delete;
+        ScanNode(ScanNode&&)                 = delete;
+        ScanNode& operator=(ScanNode&&)      = delete;
+
+        ~ScanNode()
         {
-            NeedScan,
-            NeedFinalize,
-        };
+            // A scan abandoned before publishing (cancelled) still wakes the calls waiting on this folder.
+            if (claim)
+            {
+                session->ReleaseScanClaim(key, claim);
+            }
+        }
 
+        CompareDirectoriesSession* session = nullptr;
+        std::shared_ptr<ScanClaim> claim;
         std::filesystem::path relativeFolder;
         std::wstring key;
-        State state = State::NeedScan;
+        std::shared_ptr<ScanNode> parent;
+        std::array<SideListing, 2> sides;
+        std::atomic_uint32_t sidesPending{2};
+        std::atomic_uint32_t childrenPending{1}; // +1 held by the node itself until its children are submitted
+        std::atomic_bool scanAnnounced{false};
         std::shared_ptr<CompareDirectoriesFolderDecision> decision;
     };
 
+    const bool scanSubtree = allowBackgroundWork && settings.compareSubdirectories;
+
+    std::mutex computedMutex;
     std::map<std::wstring, std::shared_ptr<const CompareDirectoriesFolderDecision>, WStringViewNoCaseLess> computed;
     std::shared_ptr<const CompareDirectoriesFolderDecision> bestRootDecision;
-    std::deque<FolderFrame> stack;
-    stack.push_back(FolderFrame{relativeFolder, rootKey});
 
-    while (! stack.empty())
+    auto findComputed = [&](const std::wstring& key) -> std::shared_ptr<const CompareDirectoriesFolderDecision>
     {
-        if (isCancelled())
+        std::lock_guard guard(computedMutex);
+        const auto it = computed.find(key);
+        return it != computed.end() ? it->second : nullptr;
+    };
+
+    CompareScanPool& pool = GetScanPool();
+    CompareScanPool::Batch batch;
+
+    struct ScanStart
+    {
+        std::shared_ptr<const CompareDirectoriesFolderDecision> cached;
+        std::shared_ptr<ScanClaim> claim;
+    };
+
+    // Returns the folder's published decision, or a claim to scan it, or neither when another call is already scanning it
+    // (after queueing makeWaiter()'s result behind that call when `mayWait`).
+    auto claimScan = [&](const std::wstring& key, bool mayWait, const auto& makeWaiter) -> ScanStart
+    {
+        ScanStart start;
+        std::lock_guard guard(_mutex);
+        ApplyPendingContentCompareUpdatesLocked(key);
+        if (const auto it = _cache.find(key); it != _cache.end() && it->second && it->second->version == version)
         {
-            break;
+            start.cached = it->second;
+            return start;
         }
 
-        FolderFrame& frame = stack.back();
-
-        if (computed.find(frame.key) != computed.end())
+        std::shared_ptr<ScanClaim>& slot = _scanClaims[key];
+        if (slot && slot->version == version && slot->cancelToken == cancelToken)
         {
-            stack.pop_back();
-            continue;
+            if (mayWait)
+            {
+                slot->waiters.push_back(makeWaiter());
+            }
+            return start;
         }
 
-        if (auto cached = tryGetCachedDecision(frame.key))
+        slot              = std::make_shared<ScanClaim>();
+        slot->version     = version;
+        slot->cancelToken = cancelToken;
+        start.claim       = slot;
+        return start;
+    };
+
+    auto isSubdirPair = [](const CompareDirectoriesItemDecision& item) noexcept
+    {
+        if (! item.existsLeft || ! item.existsRight)
         {
-            computed.emplace(frame.key, std::move(cached));
-            stack.pop_back();
-            continue;
+            return false;
         }
 
-        if (frame.state == FolderFrame::State::NeedScan)
+        const bool leftIsDir  = (item.leftFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        const bool rightIsDir = (item.rightFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+
+        // Avoid following directory reparse points (symlinks/junctions).
+        return leftIsDir && rightIsDir && ! IsReparsePairEntry(item);
+    };
+
+    auto finalizeNode = [&](std::shared_ptr<ScanNode> node)
+    {
+        // Walks up while each finished subtree completes its parent's last outstanding child.
+        while (node && node->childrenPending.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
         {
-            beginFolderScan(frame.relativeFolder, frame.key == rootKey ? scanStarted : false);
-            frame.decision = computeDecisionBase(frame.relativeFolder);
-            if (frame.key == rootKey)
+            if (isCancelled() || ! node->decision)
             {
-                bestRootDecision = frame.decision;
+                return;
             }
-            frame.state = FolderFrame::State::NeedFinalize;
 
-            if (allowBackgroundWork && settings.compareSubdirectories && frame.decision && SUCCEEDED(frame.decision->hr))
+            CompareDirectoriesFolderDecision& decision = *node->decision;
+            if (settings.compareSubdirectories && SUCCEEDED(decision.hr))
             {
-                for (const auto& [name, item] : frame.decision->items)
+                for (auto& [name, item] : decision.items)
                 {
                     if (isCancelled())
                     {
-                        break;
+                        return;
                     }
 
-                    if (! item.existsLeft || ! item.existsRight)
+                    if (! isSubdirPair(item))
                     {
                         continue;
                     }
 
-                    const bool leftIsDir  = (item.leftFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-                    const bool rightIsDir = (item.rightFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-                    if (! leftIsDir || ! rightIsDir)
+                    const std::filesystem::path childRel = node->relativeFolder / std::filesystem::path(name);
+                    const std::wstring childKey          = MakeCacheKey(childRel);
+
+                    std::shared_ptr<const CompareDirectoriesFolderDecision> childDecision = findComputed(childKey);
+                    if (! childDecision)
                     {
-                        continue;
+                        childDecision = tryGetCachedDecision(childKey);
                     }
 
-                    // Avoid following directory reparse points (symlinks/junctions).
-                    if (IsReparsePairEntry(item))
+                    if (! childDecision)
                     {
+                        if (allowBackgroundWork)
+                        {
+                            item.differenceMask |= static_cast<uint32_t>(CompareDirectoriesDiffBit::SubdirPending);
+                        }
                         continue;
                     }
 
-                    const std::filesystem::path childRel = frame.relativeFolder / std::filesystem::path(name);
-                    const std::wstring childKey          = MakeCacheKey(childRel);
-                    if (computed.find(childKey) != computed.end())
+                    const bool childPending = SUCCEEDED(childDecision->hr) && childDecision->anyPending;
+                    if (allowBackgroundWork && childPending)
                     {
-                        continue;
+                        item.differenceMask |= static_cast<uint32_t>(CompareDirectoriesDiffBit::SubdirPending);
                     }
 
-                    stack.push_back(FolderFrame{childRel, std::move(childKey)});
+                    const bool childDifferent = FAILED(childDecision->hr) || childDecision->anyDifferent;
+                    if (childDifferent)
+                    {
+                        item.differenceMask |= static_cast<uint32_t>(CompareDirectoriesDiffBit::SubdirContent);
+                        item.isDifferent = true;
+                        item.selectLeft  = true;
+                        item.selectRight = true;
+                    }
                 }
             }
 
-            continue;
-        }
+            // Compute aggregate flags once, after all item bits (including subdir) are finalized.
+            decision.anyDifferent = AnyChildDifferent(decision);
+            decision.anyPending   = AnyChildPending(decision);
 
-        if (settings.compareSubdirectories && frame.decision && SUCCEEDED(frame.decision->hr))
-        {
-            for (auto& [name, item] : frame.decision->items)
+            const std::shared_ptr<const CompareDirectoriesFolderDecision> finalDecision = node->decision;
             {
-                if (isCancelled())
+                std::lock_guard guard(_mutex);
+                if (_version.load(std::memory_order_relaxed) == version)
                 {
-                    break;
+                    _cache[node->key] = finalDecision;
                 }
+            }
 
-                if (! item.existsLeft || ! item.existsRight)
+            {
+                std::lock_guard guard(computedMutex);
+                computed.emplace(node->key, finalDecision);
+                if (node->key == rootKey)
                 {
-                    continue;
+                    bestRootDecision = finalDecision;
                 }
+            }
 
-                const bool leftIsDir  = (item.leftFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-                const bool rightIsDir = (item.rightFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-                if (! leftIsDir || ! rightIsDir)
-                {
-                    continue;
-                }
+            if (node->claim)
+            {
+                ReleaseScanClaim(node->key, std::exchange(node->claim, nullptr));
+            }
 
-                // Avoid following directory reparse points (symlinks/junctions).
-                if (IsReparsePairEntry(item))
-                {
-                    continue;
-                }
+            node = std::move(node->parent);
+        }
+    };
+
+    std::function<void(const std::shared_ptr<ScanNode>&, ComparePane)> runListing;
+
+    auto submitListings = [&](const std::shared_ptr<ScanNode>& node)
+    {
+        pool.Submit(ComparePane::Left, batch, [&runListing, node]() noexcept { runListing(node, ComparePane::Left); });
+        pool.Submit(ComparePane::Right, batch, [&runListing, node]() noexcept { runListing(node, ComparePane::Right); });
+    };
+
+    runListing = [&](const std::shared_ptr<ScanNode>& node, ComparePane pane)
+    {
+        if (isCancelled())
+        {
+            return;
+        }
+
+        if (! node->scanAnnounced.exchange(true, std::memory_order_acq_rel))
+        {
+            beginFolderScan(node->relativeFolder, node->key == rootKey ? scanStarted : false);
+        }
 
-                const std::filesystem::path childRel = frame.relativeFolder / std::filesystem::path(name);
-                const std::wstring childKey          = MakeCacheKey(childRel);
+        readSide(pane, node->relativeFolder, node->sides[pane == ComparePane::Left ? 0u : 1u]);
+        if (node->sidesPending.fetch_sub(1u, std::memory_order_acq_rel) != 1u || isCancelled())
+        {
+            return;
+        }
+
+        node->decision = computeDecisionBase(node->relativeFolder, node->sides[0], node->sides[1]);
+        node->sides    = {};
+        if (node->key == rootKey)
+        {
+            std::lock_guard guard(computedMutex);
+            bestRootDecision = node->decision;
+        }
 
-                std::shared_ptr<const CompareDirectoriesFolderDecision> childDecision;
-                if (const auto it = computed.find(childKey); it != computed.end())
+        if (scanSubtree && SUCCEEDED(node->decision->hr))
+        {
+            for (const auto& [name, item] : node->decision->items)
+            {
+                if (isCancelled())
                 {
-                    childDecision = it->second;
+                    break;
                 }
-                else
+
+                if (! isSubdirPair(item))
                 {
-                    childDecision = tryGetCachedDecision(childKey);
+                    continue;
                 }
 
-                if (! childDecision)
+                auto child            = std::make_shared<ScanNode>();
+                child->session        = this;
+                child->relativeFolder = node->relativeFolder / std::filesystem::path(name);
+                child->key            = MakeCacheKey(child->relativeFolder);
+                if (findComputed(child->key))
                 {
-                    if (allowBackgroundWork)
-                    {
-                        item.differenceMask |= static_cast<uint32_t>(CompareDirectoriesDiffBit::SubdirPending);
-                    }
                     continue;
                 }
 
-                const bool childPending = SUCCEEDED(childDecision->hr) && childDecision->anyPending;
-                if (allowBackgroundWork && childPending)
+                // A subtree another call is scanning stays a pending child of this node until that call publishes it.
+                ScanStart start = claimScan(child->key,
+                                            true,
+                                            [&, node]()
+                                            {
+                                                static_cast<void>(node->childrenPending.fetch_add(1u, std::memory_order_acq_rel));
+                                                batch.Add();
+                                                return std::function<void()>(
+                                                    [&, node]()
+                                                    {
+                                                        finalizeNode(node);
+                                                        batch.Done();
+                                                    });
+                                            });
+                if (start.cached)
                 {
-                    item.differenceMask |= static_cast<uint32_t>(CompareDirectoriesDiffBit::SubdirPending);
+                    std::lock_guard guard(computedMutex);
+                    computed.emplace(child->key, std::move(start.cached));
+                    continue;
                 }
 
-                const bool childDifferent = FAILED(childDecision->hr) || childDecision->anyDifferent;
-                if (childDifferent)
+                if (! start.claim)
                 {
-                    item.differenceMask |= static_cast<uint32_t>(CompareDirectoriesDiffBit::SubdirContent);
-                    item.isDifferent = true;
-                    item.selectLeft  = true;
-                    item.selectRight = true;
+                    continue;
                 }
+
+                child->claim  = std::move(start.claim);
+                child->parent = node;
+                static_cast<void>(node->childrenPending.fetch_add(1u, std::memory_order_acq_rel));
+                submitListings(child);
             }
         }
 
-        // Compute aggregate flags once, after all item bits (including subdir) are finalized.
-        if (frame.decision)
+        finalizeNode(node);
+    };
+
+    auto root            = std::make_shared<ScanNode>();
+    root->session        = this;
+    root->relativeFolder = relativeFolder;
+    root->key            = rootKey;
+    for (;;)
+    {
+        ScanStart start = claimScan(rootKey,
+                                    scanSubtree,
+                                    [&]()
+                                    {
+                                        batch.Add();
+                                        return std::function<void()>([&batch]() noexcept { batch.Done(); });
+                                    });
+        if (start.cached)
         {
-            frame.decision->anyDifferent = AnyChildDifferent(*frame.decision);
-            frame.decision->anyPending   = AnyChildPending(*frame.decision);
+            return start.cached;
         }
 
-        const std::shared_ptr<const CompareDirectoriesFolderDecision> finalDecision = frame.decision;
+        if (start.claim)
         {
-            std::lock_guard guard(_mutex);
-            if (_version.load(std::memory_order_relaxed) == version)
-            {
-                _cache[frame.key] = finalDecision;
-            }
+            root->claim = std::move(start.claim);
+            break;
         }
 
-        computed.emplace(frame.key, finalDecision);
-        if (frame.key == rootKey)
+        if (! scanSubtree)
         {
-            bestRootDecision = finalDecision;
+            // Listing one level is cheaper than waiting for the other call's whole subtree.
+            break;
         }
-        stack.pop_back();
+
+        // Another call is scanning this folder: take its result, or claim the folder again if that scan was abandoned.
+        batch.Wait();
     }
 
+    submitListings(root);
+    root.reset();
+    batch.Wait();
+
     if (const auto it = computed.find(rootKey); it != computed.end())
     {
         return it->second;
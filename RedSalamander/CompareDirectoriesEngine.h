@@ -16,6 +16,7 @@
 #include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #define WIN32_LEAN_AND_MEAN
@@ -42,16 +43,22 @@ struct WStringViewNoCaseLess
 {
     using is_transparent = void;
 
-    bool operator()(std::wstring_view left, std::wstring_view right) const noexcept
+    // Three-way form of the same ordering (<0, 0, >0); the listing sort, the merge join and CompareDirectoriesItemTable::find all use it.
+    static int Compare(std::wstring_view left, std::wstring_view right) noexcept
     {
         if (left.size() > static_cast<size_t>(std::numeric_limits<int>::max()) || right.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
         {
-            return left < right;
+            return left.compare(right);
         }
         const int leftLen  = static_cast<int>(left.size());
         const int rightLen = static_cast<int>(right.size());
         const int cmp      = CompareStringOrdinal(left.data(), leftLen, right.data(), rightLen, TRUE);
-        return cmp == CSTR_LESS_THAN;
+        return (cmp == CSTR_LESS_THAN) ? -1 : ((cmp == CSTR_GREATER_THAN) ? 1 : 0);
+    }
+
+    bool operator()(std::wstring_view left, std::wstring_view right) const noexcept
+    {
+        return Compare(left, right) < 0;
     }
 };
 
@@ -109,6 +116,67 @@ struct CompareDirectoriesItemDecision
     DWORD rightFileAttributes  = 0;
 };
 
+// Flat decision table for one folder: entries sorted in CompareStringOrdinal (ignore case) order, names stored in a single pool.
+// Built once by the merge join in GetOrComputeDecision; find() is a binary search and iteration yields (name, item) pairs.
+class CompareDirectoriesItemTable
+{
+public:
+    using value_type     = std::pair<std::wstring_view, CompareDirectoriesItemDecision>;
+    using iterator       = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    CompareDirectoriesItemTable()  = default;
+    ~CompareDirectoriesItemTable() = default;
+
+    CompareDirectoriesItemTable(const CompareDirectoriesItemTable& other);
+    CompareDirectoriesItemTable& operator=(const CompareDirectoriesItemTable& other);
+    CompareDirectoriesItemTable(CompareDirectoriesItemTable&&) noexcept            = default;
+    CompareDirectoriesItemTable& operator=(CompareDirectoriesItemTable&&) noexcept = default;
+
+    void Reserve(size_t count, size_t nameChars);
+    // Entries must be appended in ascending order with unique names; Append neither sorts nor de-duplicates.
+    CompareDirectoriesItemDecision& Append(std::wstring_view name, const CompareDirectoriesItemDecision& item);
+
+    [[nodiscard]] iterator find(std::wstring_view name) noexcept;
+    [[nodiscard]] const_iterator find(std::wstring_view name) const noexcept;
+
+    [[nodiscard]] iterator begin() noexcept
+    {
+        return _entries.begin();
+    }
+
+    [[nodiscard]] iterator end() noexcept
+    {
+        return _entries.end();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+        return _entries.begin();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return _entries.end();
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return _entries.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _entries.empty();
+    }
+
+private:
+    void AdoptNamePool(std::vector<wchar_t> pool, const wchar_t* previousBase) noexcept;
+
+    std::vector<wchar_t> _namePool;
+    std::vector<value_type> _entries;
+};
+
 struct CompareDirectoriesFolderDecision
 {
     uint64_t version        = 0;
@@ -118,9 +186,11 @@ struct CompareDirectoriesFolderDecision
     // Precomputed aggregates over items — avoids O(n) scans in hot ancestor-propagation paths.
     bool anyDifferent = false;
     bool anyPending   = false;
-    std::map<std::wstring, CompareDirectoriesItemDecision, WStringViewNoCaseLess> items;
+    CompareDirectoriesItemTable items;
 };
 
+class CompareScanPool;
+
 class CompareDirectoriesSession final : public std::enable_shared_from_this<CompareDirectoriesSession>
 {
 public:
@@ -239,7 +309,18 @@ private:
         bool areEqual              = false;
     };
 
+    // A folder one GetOrComputeDecision call is scanning. Other calls that reach it queue a waiter instead of listing it
+    // again; waiters run once the folder is published into _cache or its scan is abandoned.
+    struct ScanClaim
+    {
+        uint64_t version     = 0;
+        uint64_t cancelToken = 0;
+        std::vector<std::function<void()>> waiters; // Guarded by _mutex
+    };
+
     std::wstring MakeCacheKey(const std::filesystem::path& relativeFolder) const;
+    [[nodiscard]] CompareScanPool& GetScanPool();
+    void ReleaseScanClaim(const std::wstring& key, const std::shared_ptr<ScanClaim>& claim) noexcept;
     void InvalidateForRelativePathLocked(const std::filesystem::path& relativePath, bool includeSubtree) noexcept;
     void NotifyScanProgress(const std::filesystem::path& relativeFolder, std::wstring_view currentEntryName, bool force) noexcept;
     void NotifyContentProgress(
@@ -276,6 +357,9 @@ private:
 
     std::map<std::wstring, std::shared_ptr<const CompareDirectoriesFolderDecision>, WStringViewNoCaseLess> _cache;
 
+    uint32_t _scanWorkersPerPane = 1;                                                     // Concurrent ReadDirectoryInfo calls per pane, across all scans
+    std::unique_ptr<CompareScanPool> _scanPool;                                           // Created by the first scan; guarded by _mutex
+    std::map<std::wstring, std::shared_ptr<ScanClaim>, WStringViewNoCaseLess> _scanClaims; // Guarded by _mutex
     std::atomic_uint32_t _scanActiveScans{0};
     std::atomic_uint64_t _scanFoldersScanned{0};
     std::atomic_uint64_t _scanEntriesScanned{0};
@@ -238,13 +238,7 @@ DirectoryInfoCache::Borrowed& DirectoryInfoCache::Borrowed::operator=(Borrowed&&
 
     if (_owner && _entry)
     {
-        std::vector<std::unique_ptr<FolderWatcher>> watchersToStop;
-        {
-            std::lock_guard lock(_owner->_mutex);
-            _owner->ReleaseBorrowLocked(_entry);
-            _owner->MaybeEvictLocked(watchersToStop);
-            _owner->UpdateWatchersLocked(watchersToStop);
-        }
+        _owner->ReleaseBorrow(_entry);
     }
 
     _owner  = other._owner;
@@ -263,13 +257,7 @@ DirectoryInfoCache::Borrowed::~Borrowed()
         return;
     }
 
-    std::vector<std::unique_ptr<FolderWatcher>> watchersToStop;
-    {
-        std::lock_guard lock(_owner->_mutex);
-        _owner->ReleaseBorrowLocked(_entry);
-        _owner->MaybeEvictLocked(watchersToStop);
-        _owner->UpdateWatchersLocked(watchersToStop);
-    }
+    _owner->ReleaseBorrow(_entry);
 }
 
 HRESULT DirectoryInfoCache::Borrowed::Status() const noexcept
@@ -670,6 +658,50 @@ void DirectoryInfoCache::ReleaseBorrowLocked(const std::shared_ptr<Entry>& entry
     }
 }
 
+void DirectoryInfoCache::ReleaseBorrow(const std::shared_ptr<Entry>& entry) noexcept
+{
+    // The borrower may have made a compact listing build its FileInfo buffer or UTF-16 names: weigh the entry again (outside
+    // the lock, the listing takes its own) so eviction sees what the snapshot really holds now.
+    wil::com_ptr<IFilesInformation> info;
+    {
+        std::lock_guard lock(_mutex);
+        info = entry->info;
+    }
+    const uint64_t entryBytes = info ? MeasureEntryBytes(info.get()) : 0;
+
+    std::vector<std::unique_ptr<FolderWatcher>> watchersToStop;
+    std::lock_guard lock(_mutex);
+    if (info && entry->info.get() == info.get() && entry->bytes != entryBytes)
+    {
+        _currentBytes = (_currentBytes >= entry->bytes) ? (_currentBytes - entry->bytes) : 0;
+        _currentBytes += entryBytes;
+        entry->bytes = entryBytes;
+    }
+
+    ReleaseBorrowLocked(entry);
+    MaybeEvictLocked(watchersToStop);
+    UpdateWatchersLocked(watchersToStop);
+}
+
+uint64_t DirectoryInfoCache::MeasureEntryBytes(IFilesInformation* info) noexcept
+{
+    // Compact listings are measured through their view: GetAllocatedSize would build the FileInfo buffer we want to avoid.
+    wil::com_ptr<IFilesInformationCompact> compact;
+    FilesInformationCompactView compactView{};
+    if (SUCCEEDED(info->QueryInterface(__uuidof(IFilesInformationCompact), compact.put_void())) && compact &&
+        SUCCEEDED(compact->GetCompactView(&compactView)))
+    {
+        return compactView.allocatedBytes;
+    }
+
+    unsigned long allocated = 0;
+    if (SUCCEEDED(info->GetAllocatedSize(&allocated)))
+    {
+        return static_cast<uint64_t>(allocated);
+    }
+    return 0;
+}
+
 void DirectoryInfoCache::AddPinLocked(const std::shared_ptr<Entry>& entry) noexcept
 {
     if (! entry)
@@ -983,15 +1015,7 @@ HRESULT DirectoryInfoCache::EnsureLoaded(const std::shared_ptr<Entry>& entry, Bo
     const HRESULT hr = fileSystem ? fileSystem->ReadDirectoryInfo(entry->key.path.c_str(), info.put()) : E_POINTER;
     perf.SetHr(hr);
 
-    uint64_t entryBytes = 0;
-    if (SUCCEEDED(hr) && info)
-    {
-        unsigned long allocated = 0;
-        if (SUCCEEDED(info->GetAllocatedSize(&allocated)))
-        {
-            entryBytes = static_cast<uint64_t>(allocated);
-        }
-    }
+    const uint64_t entryBytes = (SUCCEEDED(hr) && info) ? MeasureEntryBytes(info.get()) : 0;
     perf.SetValue0(entryBytes);
 
     {
@@ -112,6 +112,9 @@ public:
     Borrowed BorrowDirectoryInfo(IFileSystem* fileSystem, const std::filesystem::path& folder, BorrowMode mode, std::stop_token stopToken) noexcept;
     Pin PinFolder(IFileSystem* fileSystem, const std::filesystem::path& folder, HWND hwnd, UINT message) noexcept;
 
+    // Memory weight of a listing as the cache accounts it (compact view bytes, else GetAllocatedSize).
+    static uint64_t MeasureEntryBytes(IFilesInformation* info) noexcept;
+
 private:
     DirectoryInfoCache()                                     = default;
     ~DirectoryInfoCache()                                    = default;
@@ -184,6 +187,7 @@ private:
 
     void AddBorrowLocked(const std::shared_ptr<Entry>& entry) noexcept;
     void ReleaseBorrowLocked(const std::shared_ptr<Entry>& entry) noexcept;
+    void ReleaseBorrow(const std::shared_ptr<Entry>& entry) noexcept;
     void AddPinLocked(const std::shared_ptr<Entry>& entry) noexcept;
     void ReleasePinLocked(const std::shared_ptr<Entry>& entry) noexcept;
 
@@ -211,41 +211,15 @@ void FolderView::EnumerationWorker(std::stop_token stopToken)
     }
 }
 
-std::unique_ptr<FolderView::EnumerationPayload>
-FolderView::ExecuteEnumeration(const std::filesystem::path& folder, uint64_t generation, std::stop_token stopToken)
+template <typename IsCanceled>
+HRESULT FolderView::BuildSortedItems(IFilesInformation* filesInformation,
+                                     std::wstring_view folderText,
+                                     IsCanceled&& isCanceled,
+                                     std::vector<FolderItem>& items,
+                                     size_t& directoryCount)
 {
-    TRACER_CTX(folder.c_str());
-
-    using UniqueThreadpoolWork = wil::unique_any<PTP_WORK, decltype(&::CloseThreadpoolWork), ::CloseThreadpoolWork>;
-
-    auto payload        = std::make_unique<EnumerationPayload>();
-    payload->generation = generation;
-    payload->status     = S_OK;
-
-    if (! _fileSystem)
-    {
-        payload->status = HRESULT_FROM_WIN32(ERROR_DLL_NOT_FOUND);
-        return payload;
-    }
-
-    auto borrowed = DirectoryInfoCache::GetInstance().BorrowDirectoryInfo(_fileSystem.get(), folder, DirectoryInfoCache::BorrowMode::AllowEnumerate);
-    if (borrowed.Status() != S_OK)
-    {
-        payload->status = borrowed.Status();
-        return payload;
-    }
-
-    IFilesInformation* filesInformation = borrowed.Get();
-    if (! filesInformation)
-    {
-        payload->status = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
-        return payload;
-    }
-
-    // Zero-copy: take a COM ref to keep arena buffer alive
-    // This allows FolderItems to use string_view pointing into the buffer
-    payload->arenaBuffer = filesInformation;
-    payload->folder      = folder;
+    items.clear();
+    directoryCount = 0;
 
     unsigned long entryCount = 0;
     HRESULT hr               = filesInformation->GetCount(&entryCount);
@@ -262,15 +236,121 @@ FolderView::ExecuteEnumeration(const std::filesystem::path& folder, uint64_t gen
     directories.reserve(std::max(estimatedDirs, static_cast<size_t>(128u)));
     files.reserve(std::max(estimatedFiles, static_cast<size_t>(256u)));
 
-    // Best-effort: this runs on a background worker; translate exceptions into a failed payload.
-    try
+    const auto appendStableHash32 = [](uint32_t hash, std::wstring_view text) noexcept -> uint32_t
+    {
+        static constexpr uint32_t kFnvPrime32 = 16777619u;
+        for (const wchar_t ch : text)
+        {
+            const uint16_t value = static_cast<uint16_t>(ch);
+
+            hash ^= static_cast<uint8_t>(value & 0xFFu);
+            hash *= kFnvPrime32;
+
+            hash ^= static_cast<uint8_t>((value >> 8) & 0xFFu);
+            hash *= kFnvPrime32;
+        }
+        return hash;
+    };
+
+    static constexpr std::wstring_view kStableHashSeparator = L"|";
+    const uint32_t folderStableHashSeed                     = appendStableHash32(StableHash32(folderText), kStableHashSeparator);
+
+    const auto appendItem = [&](std::wstring_view name, DWORD attributes, uint64_t sizeBytes, int64_t lastWriteTime)
+    {
+        // Zero-copy: displayName points into the listing
+        FolderItem item{};
+        item.displayName = name;
+
+        // Stable hash used for rainbow rendering (avoid storing full paths per item).
+        {
+            item.stableHash32 = appendStableHash32(folderStableHashSeed, item.displayName);
+        }
+
+        item.isDirectory    = (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        item.fileAttributes = attributes;
+        item.lastWriteTime  = lastWriteTime;
+        if (! item.isDirectory)
+        {
+            item.sizeBytes = sizeBytes;
+        }
+
+        // Compute extension offset for files (zero-copy)
+        if (! item.isDirectory && ! item.displayName.empty())
+        {
+            const size_t dotPos = item.displayName.rfind(L'.');
+            if (dotPos != std::wstring_view::npos && dotPos > 0)
+            {
+                item.extensionOffset = static_cast<uint16_t>(dotPos);
+                // Detect .lnk shortcuts
+                const auto ext  = item.displayName.substr(dotPos);
+                item.isShortcut = (ext.size() == 4 && (ext[1] == L'l' || ext[1] == L'L') && (ext[2] == L'n' || ext[2] == L'N') &&
+                                   (ext[3] == L'k' || ext[3] == L'K'));
+            }
+        }
+
+        if (item.isDirectory)
+        {
+            directories.emplace_back(std::move(item));
+        }
+        else
+        {
+            files.emplace_back(std::move(item));
+        }
+    };
+
+    HRESULT status = S_OK;
+
+    // Plugins that only know name/size/mtime/attributes may expose their listing as columns; reading those avoids building
+    // the FileInfo buffer altogether.
+    wil::com_ptr<IFilesInformationCompact> compact;
+    FilesInformationCompactView compactView{};
+    if (SUCCEEDED(filesInformation->QueryInterface(__uuidof(IFilesInformationCompact), compact.put_void())) && compact &&
+        SUCCEEDED(compact->GetCompactView(&compactView)))
+    {
+        Debug::Perf::Scope perf(L"FolderView.ExecuteEnumeration.BuildItems");
+        perf.SetDetail(folderText);
+        perf.SetValue0(compactView.count);
+
+        // FolderItem names are UTF-16 views into the listing: a narrow pool is widened once by the listing itself, shared with
+        // every other view of the same folder and kept alive by the caller's reference to the listing.
+        const size_t poolChars = compactView.count > 0 ? static_cast<size_t>(compactView.nameOffsets[compactView.count]) : 0u;
+        const wchar_t* names   = nullptr;
+        hr                     = compact->GetWideNamePool(&names);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        for (unsigned long i = 0; i < compactView.count; ++i)
+        {
+            if (isCanceled())
+            {
+                return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+            }
+
+            const size_t nameBegin = compactView.nameOffsets[i];
+            const size_t nameEnd   = compactView.nameOffsets[i + 1u];
+            if (nameEnd < nameBegin || nameEnd > poolChars)
+            {
+                status = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+                break;
+            }
+
+            appendItem(std::wstring_view(names + nameBegin, nameEnd - nameBegin),
+                       compactView.attributes[i],
+                       compactView.sizes[i],
+                       compactView.lastWriteTimes[i]);
+        }
+
+        perf.SetValue1(directories.size() + files.size());
+    }
+    else
     {
         FileInfo* entry = nullptr;
         hr              = filesInformation->GetBuffer(&entry);
         if (FAILED(hr))
         {
-            payload->status = hr;
-            return payload;
+            return hr;
         }
 
         if (entry != nullptr)
@@ -279,171 +359,191 @@ FolderView::ExecuteEnumeration(const std::filesystem::path& folder, uint64_t gen
             hr                       = filesInformation->GetBufferSize(&bufferSize);
             if (FAILED(hr))
             {
-                payload->status = hr;
-                return payload;
+                return hr;
             }
 
             unsigned long allocatedSize = 0;
             hr                          = filesInformation->GetAllocatedSize(&allocatedSize);
             if (FAILED(hr))
             {
-                payload->status = hr;
-                return payload;
+                return hr;
             }
 
             if (allocatedSize < bufferSize || allocatedSize < sizeof(FileInfo))
             {
-                payload->status = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
-                return payload;
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
             }
 
             std::byte* base = reinterpret_cast<std::byte*>(entry);
             std::byte* end  = base + bufferSize;
 
-            {
-                Debug::Perf::Scope perf(L"FolderView.ExecuteEnumeration.BuildItems");
-                const std::wstring_view folderText = folder.native();
-                perf.SetDetail(folderText);
-                perf.SetValue0(entryCount);
+            Debug::Perf::Scope perf(L"FolderView.ExecuteEnumeration.BuildItems");
+            perf.SetDetail(folderText);
+            perf.SetValue0(entryCount);
 
-                const auto appendStableHash32 = [](uint32_t hash, std::wstring_view text) noexcept -> uint32_t
+            for (;;)
+            {
+                if (isCanceled())
                 {
-                    static constexpr uint32_t kFnvPrime32 = 16777619u;
-                    for (const wchar_t ch : text)
-                    {
-                        const uint16_t value = static_cast<uint16_t>(ch);
+                    return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+                }
 
-                        hash ^= static_cast<uint8_t>(value & 0xFFu);
-                        hash *= kFnvPrime32;
+                const size_t nameChars = static_cast<size_t>(entry->FileNameSize) / sizeof(wchar_t);
+                appendItem(std::wstring_view(entry->FileName, nameChars),
+                           entry->FileAttributes,
+                           entry->EndOfFile > 0 ? static_cast<uint64_t>(entry->EndOfFile) : 0u,
+                           entry->LastWriteTime);
 
-                        hash ^= static_cast<uint8_t>((value >> 8) & 0xFFu);
-                        hash *= kFnvPrime32;
-                    }
-                    return hash;
-                };
+                if (entry->NextEntryOffset == 0)
+                {
+                    break;
+                }
 
-                static constexpr std::wstring_view kStableHashSeparator = L"|";
-                const uint32_t folderStableHashSeed                     = appendStableHash32(StableHash32(folderText), kStableHashSeparator);
+                if (entry->NextEntryOffset < sizeof(FileInfo))
+                {
+                    status = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+                    break;
+                }
 
-                while (! stopToken.stop_requested())
+                std::byte* next = reinterpret_cast<std::byte*>(entry) + entry->NextEntryOffset;
+                if (next < base || next + sizeof(FileInfo) > end)
                 {
-                    if (_enumerationGeneration.load(std::memory_order_acquire) != generation)
-                    {
-                        return nullptr;
-                    }
+                    status = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+                    break;
+                }
 
-                    const size_t nameChars = static_cast<size_t>(entry->FileNameSize) / sizeof(wchar_t);
+                entry = reinterpret_cast<FileInfo*>(next);
+            }
 
-                    // Zero-copy: create string_view pointing into arena buffer for displayName
-                    FolderItem item{};
-                    item.displayName = std::wstring_view(entry->FileName, nameChars);
+            perf.SetValue1(directories.size() + files.size());
+        }
+    }
 
-                    // Stable hash used for rainbow rendering (avoid storing full paths per item).
-                    {
-                        item.stableHash32 = appendStableHash32(folderStableHashSeed, item.displayName);
-                    }
+    if (isCanceled())
+    {
+        return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+    }
 
-                    item.isDirectory    = (entry->FileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-                    item.fileAttributes = entry->FileAttributes;
-                    item.lastWriteTime  = entry->LastWriteTime;
-                    if (! item.isDirectory && entry->EndOfFile > 0)
-                    {
-                        item.sizeBytes = static_cast<uint64_t>(entry->EndOfFile);
-                    }
+    if (FAILED(status))
+    {
+        return status;
+    }
 
-                    // Compute extension offset for files (zero-copy)
-                    if (! item.isDirectory && ! item.displayName.empty())
-                    {
-                        const size_t dotPos = item.displayName.rfind(L'.');
-                        if (dotPos != std::wstring_view::npos && dotPos > 0)
-                        {
-                            item.extensionOffset = static_cast<uint16_t>(dotPos);
-                            // Detect .lnk shortcuts
-                            const auto ext  = item.displayName.substr(dotPos);
-                            item.isShortcut = (ext.size() == 4 && (ext[1] == L'l' || ext[1] == L'L') && (ext[2] == L'n' || ext[2] == L'N') &&
-                                               (ext[3] == L'k' || ext[3] == L'K'));
-                        }
-                    }
+    Debug::Perf::Scope perf(L"FolderView.ExecuteEnumeration.SortMerge");
+    perf.SetDetail(folderText);
+    perf.SetValue0(directories.size());
+    perf.SetValue1(files.size());
 
-                    if (item.isDirectory)
-                    {
-                        directories.emplace_back(std::move(item));
-                    }
-                    else
-                    {
-                        files.emplace_back(std::move(item));
-                    }
+    // Use CompareStringOrdinal for string_view comparison (handles non-null-terminated strings)
+    auto compare = [](const FolderItem& a, const FolderItem& b)
+    {
+        const int result = CompareStringOrdinal(
+            a.displayName.data(), static_cast<int>(a.displayName.size()), b.displayName.data(), static_cast<int>(b.displayName.size()), TRUE);
+        return result == CSTR_LESS_THAN;
+    };
 
-                    if (entry->NextEntryOffset == 0)
-                    {
-                        break;
-                    }
+    // Use parallel sorting for large directories
+    if (directories.size() >= kParallelSortThreshold)
+    {
+        std::sort(std::execution::par, directories.begin(), directories.end(), compare);
+    }
+    else
+    {
+        std::sort(directories.begin(), directories.end(), compare);
+    }
 
-                    if (entry->NextEntryOffset < sizeof(FileInfo))
-                    {
-                        payload->status = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
-                        break;
-                    }
+    if (files.size() >= kParallelSortThreshold)
+    {
+        std::sort(std::execution::par, files.begin(), files.end(), compare);
+    }
+    else
+    {
+        std::sort(files.begin(), files.end(), compare);
+    }
 
-                    std::byte* next = reinterpret_cast<std::byte*>(entry) + entry->NextEntryOffset;
-                    if (next < base || next + sizeof(FileInfo) > end)
-                    {
-                        payload->status = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
-                        break;
-                    }
+    items.reserve(directories.size() + files.size());
+    items.insert(items.end(), std::make_move_iterator(directories.begin()), std::make_move_iterator(directories.end()));
+    items.insert(items.end(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+    directoryCount = directories.size();
+    return S_OK;
+}
 
-                    entry = reinterpret_cast<FileInfo*>(next);
-                }
+HRESULT FolderView::BenchmarkBuildSortedItems(IFilesInformation* filesInformation, std::wstring_view folder, size_t& itemCount) noexcept
+{
+    itemCount = 0;
+    if (! filesInformation)
+    {
+        return E_POINTER;
+    }
 
-                perf.SetValue1(directories.size() + files.size());
-            }
-        }
+    try
+    {
+        std::vector<FolderItem> items;
+        size_t directoryCount = 0;
+        const HRESULT hr      = BuildSortedItems(filesInformation, folder, []() noexcept { return false; }, items, directoryCount);
+        itemCount             = items.size();
+        return hr;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return E_OUTOFMEMORY;
+    }
+}
 
-        if (stopToken.stop_requested() || _enumerationGeneration.load(std::memory_order_acquire) != generation)
-        {
-            return nullptr;
-        }
+std::unique_ptr<FolderView::EnumerationPayload>
+FolderView::ExecuteEnumeration(const std::filesystem::path& folder, uint64_t generation, std::stop_token stopToken)
+{
+    TRACER_CTX(folder.c_str());
 
-        if (SUCCEEDED(payload->status))
-        {
-            Debug::Perf::Scope perf(L"FolderView.ExecuteEnumeration.SortMerge");
-            perf.SetDetail(folder.native());
-            perf.SetValue0(directories.size());
-            perf.SetValue1(files.size());
+    using UniqueThreadpoolWork = wil::unique_any<PTP_WORK, decltype(&::CloseThreadpoolWork), ::CloseThreadpoolWork>;
 
-            // Use CompareStringOrdinal for string_view comparison (handles non-null-terminated strings)
-            auto compare = [](const FolderItem& a, const FolderItem& b)
-            {
-                const int result = CompareStringOrdinal(
-                    a.displayName.data(), static_cast<int>(a.displayName.size()), b.displayName.data(), static_cast<int>(b.displayName.size()), TRUE);
-                return result == CSTR_LESS_THAN;
-            };
+    auto payload        = std::make_unique<EnumerationPayload>();
+    payload->generation = generation;
+    payload->status     = S_OK;
 
-            // Use parallel sorting for large directories (threshold: 1000 items)
-            constexpr size_t kParallelSortThreshold = 1000;
-            if (directories.size() >= kParallelSortThreshold)
-            {
-                std::sort(std::execution::par, directories.begin(), directories.end(), compare);
-            }
-            else
-            {
-                std::sort(directories.begin(), directories.end(), compare);
-            }
+    if (! _fileSystem)
+    {
+        payload->status = HRESULT_FROM_WIN32(ERROR_DLL_NOT_FOUND);
+        return payload;
+    }
 
-            if (files.size() >= kParallelSortThreshold)
-            {
-                std::sort(std::execution::par, files.begin(), files.end(), compare);
-            }
-            else
-            {
-                std::sort(files.begin(), files.end(), compare);
-            }
+    auto borrowed = DirectoryInfoCache::GetInstance().BorrowDirectoryInfo(_fileSystem.get(), folder, DirectoryInfoCache::BorrowMode::AllowEnumerate);
+    if (borrowed.Status() != S_OK)
+    {
+        payload->status = borrowed.Status();
+        return payload;
+    }
 
-            payload->items.reserve(directories.size() + files.size());
-            payload->items.insert(payload->items.end(), std::make_move_iterator(directories.begin()), std::make_move_iterator(directories.end()));
-            payload->items.insert(payload->items.end(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+    IFilesInformation* filesInformation = borrowed.Get();
+    if (! filesInformation)
+    {
+        payload->status = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        return payload;
+    }
+
+    // Zero-copy: take a COM ref to keep arena buffer alive
+    // This allows FolderItems to use string_view pointing into the buffer
+    payload->arenaBuffer = filesInformation;
+    payload->folder      = folder;
 
-            Debug::Info(L"FolderView enumeration completed: {} directories, {} files (total: {})", directories.size(), files.size(), payload->items.size());
+    // Best-effort: this runs on a background worker; translate exceptions into a failed payload.
+    try
+    {
+        const auto isCanceled = [&]() noexcept { return stopToken.stop_requested() || _enumerationGeneration.load(std::memory_order_acquire) != generation; };
+
+        size_t directoryCount = 0;
+        payload->status       = BuildSortedItems(filesInformation, folder.native(), isCanceled, payload->items, directoryCount);
+        if (isCanceled())
+        {
+            return nullptr;
+        }
+
+        if (SUCCEEDED(payload->status))
+        {
+            Debug::Info(L"FolderView enumeration completed: {} directories, {} files (total: {})",
+                        directoryCount,
+                        payload->items.size() - directoryCount,
+                        payload->items.size());
 
             // Step 1: Collect unique extensions that need icon queries (parallel optimization)
             struct ExtensionQuery
@@ -651,6 +751,8 @@ FolderView::ExecuteEnumeration(const std::filesystem::path& folder, uint64_t gen
                 {
                     size_t itemIndex;
                     std::wstring fullPath;
+                    int64_t lastWriteTime                    = 0;
+                    float iconSizeDip                        = 16.0f;
                     std::mutex* resultsMutex                 = nullptr;
                     std::unordered_map<size_t, int>* results = nullptr;
                     std::atomic<bool>* stopRequested         = nullptr;
@@ -662,18 +764,33 @@ FolderView::ExecuteEnumeration(const std::filesystem::path& folder, uint64_t gen
                 std::vector<std::unique_ptr<PerFileWork>> perFileWorks;
                 perFileWorks.reserve(perFileIconIndices.size());
 
-                uint64_t perFilePathChars = 0;
+                uint64_t perFilePathChars     = 0;
+                uint64_t perFilePersistentHits = 0;
                 {
                     Debug::Perf::Scope perFilePathsPerf(L"FolderView.ExecuteEnumeration.IconIndex.BuildPerFilePaths");
                     perFilePathsPerf.SetDetail(folder.native());
                     perFilePathsPerf.SetValue0(perFileIconIndices.size());
 
+                    const float iconSizeDip = _iconSizeDip;
                     for (size_t idx : perFileIconIndices)
                     {
                         auto work       = std::make_unique<PerFileWork>();
                         work->itemIndex = idx;
                         work->fullPath  = (folder / payload->items[idx].displayName).wstring();
                         perFilePathChars += static_cast<uint64_t>(work->fullPath.size());
+
+                        // Icon pack hit (same path and last write time as a previous session): skip the shell query
+                        const int64_t lastWriteTime = payload->items[idx].lastWriteTime;
+                        const auto persistentIndex  = IconCache::GetInstance().TryGetPersistentFileIconIndex(work->fullPath, lastWriteTime, iconSizeDip);
+                        if (persistentIndex.has_value())
+                        {
+                            payload->items[idx].iconIndex = persistentIndex.value();
+                            ++perFilePersistentHits;
+                            continue;
+                        }
+
+                        work->lastWriteTime     = lastWriteTime;
+                        work->iconSizeDip       = iconSizeDip;
                         work->resultsMutex      = &perFileResultsMutex;
                         work->results           = &perFileResults;
                         work->stopRequested     = &perFileStopRequested;
@@ -700,7 +817,7 @@ FolderView::ExecuteEnumeration(const std::filesystem::path& folder, uint64_t gen
                                 return;
                             }
 
-                            const auto iconIndex = IconCache::GetInstance().QuerySysIconIndexForPath(work->fullPath.c_str(), 0, false);
+                            const auto iconIndex = IconCache::GetInstance().QuerySysIconIndexForFile(work->fullPath, work->lastWriteTime, work->iconSizeDip);
 
                             std::lock_guard<std::mutex> lock(*work->resultsMutex);
                             (*work->results)[work->itemIndex] = iconIndex.value_or(-1);
@@ -743,6 +860,11 @@ FolderView::ExecuteEnumeration(const std::filesystem::path& folder, uint64_t gen
                 }
 
                 perFileQueryPerf.SetValue1(perFileFailures);
+                if (perFilePersistentHits > 0)
+                {
+                    DBGOUT_INFO(
+                        L"FolderView: {} of {} per-file icons from the icon pack for '{}'", perFilePersistentHits, perFileIconIndices.size(), folder.c_str());
+                }
             }
         }
     }
@@ -1029,8 +1151,7 @@ void FolderView::ApplyCurrentSort(std::wstring_view preferredFocusedPath, size_t
         return compareName(a, b);
     };
 
-    // Use parallel sorting for large directories (threshold: 1000 items)
-    constexpr size_t kParallelSortThreshold = 1000;
+    // Use parallel sorting for large directories
     if (_items.size() >= kParallelSortThreshold)
     {
         std::stable_sort(std::execution::par, _items.begin(), _items.end(), compare);
@@ -1338,6 +1459,7 @@ void FolderView::ProcessEnumerationResult(std::unique_ptr<EnumerationPayload> pa
 
             // Transfer rendering state from old item
             newItem.labelLayout     = oldItem.labelLayout;
+            newItem.labelGlyphRun   = oldItem.labelGlyphRun;
             newItem.labelMetrics    = oldItem.labelMetrics;
             newItem.detailsText     = oldItem.detailsText;
             newItem.detailsLayout   = oldItem.detailsLayout;
@@ -1345,10 +1467,10 @@ void FolderView::ProcessEnumerationResult(std::unique_ptr<EnumerationPayload> pa
             newItem.metadataText    = oldItem.metadataText;
             newItem.metadataLayout  = oldItem.metadataLayout;
             newItem.metadataMetrics = oldItem.metadataMetrics;
-            // Only preserve D2D bitmap if icon index matches (icons are shared by extension)
-            if (oldItem.iconIndex == newItem.iconIndex && oldItem.icon)
+            // Only preserve the atlas slot if icon index matches (icons are shared by extension)
+            if (oldItem.iconIndex == newItem.iconIndex && oldItem.iconSlot.IsValid())
             {
-                newItem.icon = oldItem.icon;
+                newItem.iconSlot = oldItem.iconSlot;
             }
 
             // Preserve selection state
@@ -1436,6 +1558,7 @@ void FolderView::ProcessEnumerationResult(std::unique_ptr<EnumerationPayload> pa
     // Queue icon loading after layout - only for items without D2D bitmaps
     Debug::Info(L"FolderView: About to queue icons for {} items", _items.size());
     QueueIconLoading();
+    QueueThumbnailLoading();
 
     if (! _items.empty())
     {
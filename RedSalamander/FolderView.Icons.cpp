@@ -62,7 +62,7 @@ void FolderView::QueueIconLoading()
             continue;
         }
 
-        if (item.icon)
+        if (item.iconSlot.IsValid())
         {
             ++skippedHasIcon;
             continue;
@@ -85,7 +85,7 @@ void FolderView::QueueIconLoading()
         group.itemIndices.push_back(i);
     }
 
-    // Build grouped requests and stamp already-cached bitmaps immediately.
+    // Build grouped requests and stamp already-cached icons immediately.
     std::vector<IconLoadRequest> visibleRequests;
     std::vector<IconLoadRequest> offscreenRequests;
     visibleRequests.reserve(std::min<size_t>(groups.size(), 128u));
@@ -100,9 +100,9 @@ void FolderView::QueueIconLoading()
             continue;
         }
 
-        // If the bitmap already exists for our D2D device, apply it immediately (no background work).
-        auto cachedBitmap = IconCache::GetInstance().GetCachedBitmap(iconIndex, _d2dContext.get());
-        if (cachedBitmap)
+        // If the bitmap already exists for our D2D device, apply its atlas slot immediately (no background work).
+        const IconCache::AtlasSlot cachedSlot = IconCache::GetInstance().GetAtlasSlot(iconIndex, _d2dContext.get());
+        if (cachedSlot.IsValid())
         {
             for (const size_t itemIndex : group.itemIndices)
             {
@@ -111,11 +111,11 @@ void FolderView::QueueIconLoading()
                     continue;
                 }
                 auto& item = _items[itemIndex];
-                if (item.icon || item.iconIndex != iconIndex)
+                if (item.iconSlot.IsValid() || item.iconIndex != iconIndex)
                 {
                     continue;
                 }
-                item.icon = cachedBitmap;
+                item.iconSlot = cachedSlot;
                 ++stampedFromCache;
             }
             continue;
@@ -184,6 +184,8 @@ void FolderView::QueueIconLoading()
 
 void FolderView::BoostIconLoadingForVisibleRange()
 {
+    BoostThumbnailLoadingForVisibleRange();
+
     if (_items.empty() || ! _hWnd || ! _d2dContext)
     {
         return;
@@ -203,18 +205,18 @@ void FolderView::BoostIconLoadingForVisibleRange()
     std::vector<int> neededIconIndices;
     neededIconIndices.reserve(std::min<size_t>(rangeEnd - rangeStart, 256u));
 
-    // Fast-path: if the bitmap already exists for our device, stamp it immediately.
+    // Fast-path: if the bitmap already exists for our device, stamp its atlas slot immediately.
     for (size_t i = rangeStart; i < rangeEnd; ++i)
     {
         auto& item = _items[i];
-        if (item.icon || item.iconIndex < 0)
+        if (item.iconSlot.IsValid() || item.iconIndex < 0)
         {
             continue;
         }
 
-        if (auto cached = IconCache::GetInstance().GetCachedBitmap(item.iconIndex, _d2dContext.get()))
+        if (const IconCache::AtlasSlot cachedSlot = IconCache::GetInstance().GetAtlasSlot(item.iconIndex, _d2dContext.get()); cachedSlot.IsValid())
         {
-            item.icon = std::move(cached);
+            item.iconSlot = cachedSlot;
             continue;
         }
 
@@ -328,12 +330,27 @@ void FolderView::ProcessIconLoadQueue()
                             uniqueQueued,
                             _iconLoadStats.extracted.load(std::memory_order_relaxed),
                             elapsedMs);
-                Debug::Info(L"FolderView: IconCache stats - {} cached icons (~{} MB), {} hits, {} misses, {} LRU evictions",
+                Debug::Info(L"FolderView: IconCache stats - {} cached icons in {} atlas pages (~{} MB), {} hits, {} misses, {} LRU evictions",
                             cacheStats.cacheSize,
+                            cacheStats.atlasPages,
                             cacheMemoryMB,
                             cacheStats.hitCount,
                             cacheStats.missCount,
                             cacheStats.lruEvictions);
+                Debug::Info(L"FolderView: Icon frames - sprite batch {} (avg {}us, max {}us), per-icon {} (avg {}us, max {}us), last {} icons in {} draws",
+                            cacheStats.spriteBatchFrames,
+                            cacheStats.spriteBatchFrameUs,
+                            cacheStats.spriteBatchFrameMaxUs,
+                            cacheStats.perIconFrames,
+                            cacheStats.perIconFrameUs,
+                            cacheStats.perIconFrameMaxUs,
+                            cacheStats.lastFrameIcons,
+                            cacheStats.lastFrameDrawCalls);
+                Debug::Info(L"FolderView: Icon pack - {} entries, {} hits, {} misses, {} captured this session",
+                            cacheStats.persistentEntries,
+                            cacheStats.persistentHits,
+                            cacheStats.persistentMisses,
+                            cacheStats.persistentCaptured);
                 break;
             }
 
@@ -432,12 +449,11 @@ void FolderView::OnCreateIconBitmap(std::unique_ptr<IconBitmapRequest> requestPt
         return;
     }
 
-    wil::com_ptr<ID2D1Bitmap1> bitmap;
     if (requestPtr->hIcon)
     {
         // Convert HICON to D2D bitmap on UI thread (thread-safe)
         const auto convertStart = std::chrono::steady_clock::now();
-        bitmap                  = IconCache::GetInstance().ConvertIconToBitmapOnUIThread(requestPtr->hIcon.get(), requestPtr->iconIndex, _d2dContext.get());
+        const auto bitmap       = IconCache::GetInstance().ConvertIconToBitmapOnUIThread(requestPtr->hIcon.get(), requestPtr->iconIndex, _d2dContext.get());
         const auto convertEnd   = std::chrono::steady_clock::now();
 
         const uint64_t convertUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(convertEnd - convertStart).count());
@@ -455,14 +471,12 @@ void FolderView::OnCreateIconBitmap(std::unique_ptr<IconBitmapRequest> requestPt
             return;
         }
     }
-    else
+
+    // Copy into the atlas (or reuse the slot when already cached for our device).
+    const IconCache::AtlasSlot slot = IconCache::GetInstance().GetAtlasSlot(requestPtr->iconIndex, _d2dContext.get());
+    if (! slot.IsValid())
     {
-        // Already cached for our device; just retrieve it.
-        bitmap = IconCache::GetInstance().GetCachedBitmap(requestPtr->iconIndex, _d2dContext.get());
-        if (! bitmap)
-        {
-            return;
-        }
+        return;
     }
 
     size_t applied = 0;
@@ -477,12 +491,12 @@ void FolderView::OnCreateIconBitmap(std::unique_ptr<IconBitmapRequest> requestPt
         auto& item = _items[itemIndex];
 
         // Verify icon index still matches (item might have changed)
-        if (item.iconIndex != requestPtr->iconIndex || item.icon)
+        if (item.iconIndex != requestPtr->iconIndex || item.iconSlot.IsValid())
         {
             continue;
         }
 
-        item.icon = bitmap;
+        item.iconSlot = slot;
         if (! firstAppliedIndex.has_value())
         {
             firstAppliedIndex = itemIndex;
@@ -532,16 +546,16 @@ void FolderView::OnBatchIconUpdate()
     for (auto& item : _items)
     {
         // Skip if no valid icon index or already has icon
-        if (item.iconIndex < 0 || item.icon)
+        if (item.iconIndex < 0 || item.iconSlot.IsValid())
         {
             continue;
         }
 
         // Try to get from cache
-        auto bitmap = IconCache::GetInstance().GetCachedBitmap(item.iconIndex, _d2dContext.get());
-        if (bitmap)
+        const IconCache::AtlasSlot slot = IconCache::GetInstance().GetAtlasSlot(item.iconIndex, _d2dContext.get());
+        if (slot.IsValid())
         {
-            item.icon = bitmap;
+            item.iconSlot = slot;
             ++retrieved;
         }
     }
@@ -613,16 +627,16 @@ void FolderView::OnIconLoaded(size_t itemIndex)
 
     auto& item = _items[itemIndex];
 
-    if (item.iconIndex < 0 || item.icon)
+    if (item.iconIndex < 0 || item.iconSlot.IsValid())
     {
         return; // Already has icon or invalid index
     }
 
-    // Get from cache (already converted, just retrieve)
-    auto bitmap = IconCache::GetInstance().GetCachedBitmap(item.iconIndex, _d2dContext.get());
-    if (bitmap)
+    // Get from cache (already converted, just retrieve its atlas slot)
+    const IconCache::AtlasSlot slot = IconCache::GetInstance().GetAtlasSlot(item.iconIndex, _d2dContext.get());
+    if (slot.IsValid())
     {
-        item.icon = bitmap;
+        item.iconSlot = slot;
 
         // Invalidate just the item's bounds for efficient redraw
         const D2D1_RECT_F viewBounds = OffsetRect(item.bounds, -_horizontalOffset, -_scrollOffset);
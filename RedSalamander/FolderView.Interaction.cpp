@@ -307,6 +307,47 @@ void FolderView::OnMouseWheel(int delta, bool horizontal)
     InvalidateRect(_hWnd.get(), nullptr, FALSE);
 }
 
+size_t FolderView::BenchmarkGetItemCount() const noexcept
+{
+    return _items.size();
+}
+
+void FolderView::BenchmarkResetScroll(bool useLabelGlyphRuns) noexcept
+{
+    _labelGlyphRunsDisabled = ! useLabelGlyphRuns;
+    for (auto& item : _items)
+    {
+        item.labelLayout.reset();
+        item.labelGlyphRun.reset();
+        item.labelMetrics = {};
+        item.detailsLayout.reset();
+        item.detailsMetrics = {};
+        item.metadataLayout.reset();
+        item.metadataMetrics = {};
+    }
+
+    _horizontalOffset = 0.0f;
+    UpdateScrollMetrics();
+    if (_hWnd)
+    {
+        InvalidateRect(_hWnd.get(), nullptr, FALSE);
+        UpdateWindow(_hWnd.get());
+    }
+}
+
+void FolderView::BenchmarkScrollFrame(int columns) noexcept
+{
+    if (! _hWnd)
+    {
+        return;
+    }
+
+    OnMouseWheel(-columns * WHEEL_DELTA, false);
+    _presentSyncInterval = 0;
+    UpdateWindow(_hWnd.get());
+    _presentSyncInterval = 1;
+}
+
 void FolderView::OnLButtonDown(POINT pt, WPARAM keys)
 {
     ErrorOverlayState overlay{};
@@ -129,8 +129,9 @@ void FolderView::LayoutItems()
                 continue;
             }
 
-            // Estimate label width based on character count
-            const float estimatedWidth                         = static_cast<float>(item.displayName.length()) * _estimatedCharWidthDip;
+            // Estimate label width based on character count (exact when the name was already shaped into a glyph run)
+            const float estimatedWidth =
+                item.labelGlyphRun ? item.labelGlyphRun->width : static_cast<float>(item.displayName.length()) * _estimatedCharWidthDip;
             item.labelMetrics.width                            = estimatedWidth;
             item.labelMetrics.widthIncludingTrailingWhitespace = estimatedWidth;
             item.labelMetrics.height                           = _estimatedLabelHeightDip;
@@ -229,6 +230,11 @@ void FolderView::LayoutItems()
     const float targetColumnWidth  = std::max(minColumnWidth, desiredColumnWidth);
     const float maxAllowedWidth    = std::max(1.0f, clientWidthDip);
     _tileWidthDip                  = std::min(targetColumnWidth, maxAllowedWidth);
+    if (_displayMode == DisplayMode::Thumbnails)
+    {
+        // Fixed-width tiles: thumbnail on top, name centered below it (clipped with an ellipsis).
+        _tileWidthDip = std::min(kThumbnailSizeDip + kLabelHorizontalPaddingDip * 2.0f, maxAllowedWidth);
+    }
 
     _labelHeightDip = maxLabelHeight + kLabelVerticalPaddingDip * 2.0f;
     if (_displayMode == DisplayMode::Detailed || _displayMode == DisplayMode::ExtraDetailed)
@@ -242,6 +248,10 @@ void FolderView::LayoutItems()
         }
         _tileHeightDip = std::max(_iconSizeDip, textBlockHeight) + kLabelVerticalPaddingDip * 2.0f;
     }
+    else if (_displayMode == DisplayMode::Thumbnails)
+    {
+        _tileHeightDip = kThumbnailSizeDip + kThumbnailLabelGapDip + maxLabelHeight + kLabelVerticalPaddingDip * 2.0f;
+    }
     else
     {
         _tileHeightDip = std::max(_iconSizeDip, maxLabelHeight) + kLabelVerticalPaddingDip * 2.0f;
@@ -302,7 +312,7 @@ void FolderView::LayoutItems()
         x += columnStride;
     }
 
-    const float labelWidth = std::max(0.0f, _tileWidthDip - (kLabelHorizontalPaddingDip * 2.0f) - _iconSizeDip - kIconTextGapDip);
+    const float labelWidth = ComputeLabelWidthDip();
 
     // Track width changes to avoid unnecessary layout work
     constexpr float kWidthChangeThreshold = 1.0f; // DIPs
@@ -391,6 +401,7 @@ void FolderView::UpdateItemTextLayouts(float labelWidth)
         if (item.displayName.empty())
         {
             item.labelLayout.reset();
+            item.labelGlyphRun.reset();
             item.detailsLayout.reset();
             item.detailsMetrics = {};
             item.metadataLayout.reset();
@@ -398,8 +409,8 @@ void FolderView::UpdateItemTextLayouts(float labelWidth)
             continue;
         }
 
-        // Create label layout lazily if needed
-        if (! item.labelLayout)
+        // Create label layout lazily if needed (simple names use a cached glyph run instead)
+        if (! item.labelLayout && ! EnsureItemLabelGlyphRun(item))
         {
             wil::com_ptr<IDWriteTextLayout> layout;
             HRESULT hr = _dwriteFactory->CreateTextLayout(item.displayName.data(),
@@ -431,7 +442,7 @@ void FolderView::UpdateItemTextLayouts(float labelWidth)
             item.labelLayout->SetMaxHeight(constrainedHeight);
         }
 
-        if (_displayMode == DisplayMode::Brief)
+        if (_displayMode == DisplayMode::Brief || _displayMode == DisplayMode::Thumbnails)
         {
             item.detailsLayout.reset();
             item.detailsMetrics = {};
@@ -539,6 +550,17 @@ void FolderView::UpdateItemTextLayouts(float labelWidth)
     // ReleaseDistantRenderingState();
 }
 
+float FolderView::ComputeLabelWidthDip() const noexcept
+{
+    if (_displayMode == DisplayMode::Thumbnails)
+    {
+        // Label sits below the thumbnail and spans the tile.
+        return std::max(0.0f, _tileWidthDip - (kLabelHorizontalPaddingDip * 2.0f));
+    }
+
+    return std::max(0.0f, _tileWidthDip - (kLabelHorizontalPaddingDip * 2.0f) - _iconSizeDip - kIconTextGapDip);
+}
+
 std::pair<size_t, size_t> FolderView::GetVisibleItemRange() const
 {
     if (_items.empty() || _columnCounts.empty() || _tileWidthDip <= 0.0f || _tileHeightDip <= 0.0f)
@@ -607,8 +629,8 @@ std::pair<size_t, size_t> FolderView::GetVisibleItemRange() const
 
 void FolderView::ReleaseDistantRenderingState()
 {
-    // For large directories, release rendering resources (layouts, icons) for items
-    // far from the visible range to bound memory usage
+    // For large directories, release rendering resources (text layouts) for items
+    // far from the visible range to bound memory usage; icon atlas slots hold no resources and are kept
     constexpr size_t kMinItemsForSparseMode = 10000; // Only apply to large directories
     constexpr size_t kKeepAroundVisible     = 2000;  // Keep this many items around visible range
 
@@ -629,9 +651,10 @@ void FolderView::ReleaseDistantRenderingState()
     for (size_t i = 0; i < keepStart && i < _items.size(); ++i)
     {
         auto& item = _items[i];
-        if (item.labelLayout || item.detailsLayout || item.metadataLayout || item.icon)
+        if (item.labelLayout || item.labelGlyphRun || item.detailsLayout || item.metadataLayout)
         {
             item.labelLayout.reset();
+            item.labelGlyphRun.reset();
             item.labelMetrics = {};
             item.detailsLayout.reset();
             item.detailsMetrics = {};
@@ -641,7 +664,6 @@ void FolderView::ReleaseDistantRenderingState()
             item.metadataMetrics = {};
             item.metadataText.clear();
             item.metadataText.shrink_to_fit();
-            item.icon.reset();
             ++released;
         }
     }
@@ -650,9 +672,10 @@ void FolderView::ReleaseDistantRenderingState()
     for (size_t i = keepEnd; i < _items.size(); ++i)
     {
         auto& item = _items[i];
-        if (item.labelLayout || item.detailsLayout || item.metadataLayout || item.icon)
+        if (item.labelLayout || item.labelGlyphRun || item.detailsLayout || item.metadataLayout)
         {
             item.labelLayout.reset();
+            item.labelGlyphRun.reset();
             item.labelMetrics = {};
             item.detailsLayout.reset();
             item.detailsMetrics = {};
@@ -662,7 +685,6 @@ void FolderView::ReleaseDistantRenderingState()
             item.metadataMetrics = {};
             item.metadataText.clear();
             item.metadataText.shrink_to_fit();
-            item.icon.reset();
             ++released;
         }
     }
@@ -690,8 +712,13 @@ void FolderView::EnsureItemTextLayout(FolderItem& item, float labelWidth)
     const float constrainedDetailsHeight  = std::max(_detailsLineHeightDip, 1.0f);
     const float constrainedMetadataHeight = std::max(_metadataLineHeightDip, 1.0f);
 
-    // Create label layout if not yet created
-    if (! item.labelLayout)
+    // Create label layout if not yet created; simple names are drawn from a cached glyph run instead
+    if (item.labelLayout)
+    {
+        item.labelLayout->SetMaxWidth(constrainedWidth);
+        item.labelLayout->SetMaxHeight(constrainedHeight);
+    }
+    else if (! EnsureItemLabelGlyphRun(item))
     {
         wil::com_ptr<IDWriteTextLayout> layout;
         HRESULT hr = _dwriteFactory->CreateTextLayout(item.displayName.data(),
@@ -713,11 +740,6 @@ void FolderView::EnsureItemTextLayout(FolderItem& item, float labelWidth)
             item.labelLayout = std::move(layout);
         }
     }
-    else
-    {
-        item.labelLayout->SetMaxWidth(constrainedWidth);
-        item.labelLayout->SetMaxHeight(constrainedHeight);
-    }
 
     // Create details layout if in detailed/extra detailed mode and not yet created
     if ((_displayMode == DisplayMode::Detailed || _displayMode == DisplayMode::ExtraDetailed) && _detailsFormat)
@@ -807,6 +829,29 @@ void FolderView::EnsureItemTextLayout(FolderItem& item, float labelWidth)
     }
 }
 
+bool FolderView::EnsureItemLabelGlyphRun(FolderItem& item)
+{
+    // Incremental search highlights rely on IDWriteTextLayout (drawing effects + hit-testing), so labels keep using layouts meanwhile.
+    if (_incrementalSearch.active || _labelGlyphRunsDisabled || ! _labelGlyphRuns.IsInitialized() || item.displayName.empty())
+    {
+        return false;
+    }
+
+    if (! item.labelGlyphRun)
+    {
+        item.labelGlyphRun = _labelGlyphRuns.GetRun(item.displayName);
+        if (! item.labelGlyphRun)
+        {
+            return false; // Complex script or font fallback needed
+        }
+    }
+
+    item.labelMetrics.width                            = item.labelGlyphRun->width;
+    item.labelMetrics.widthIncludingTrailingWhitespace = item.labelGlyphRun->width;
+    item.labelMetrics.height                           = _labelGlyphRuns.GetLineHeightDip();
+    return true;
+}
+
 void FolderView::ScheduleIdleLayoutCreation()
 {
     // Don't schedule if already running or no items need processing
@@ -823,7 +868,7 @@ void FolderView::ScheduleIdleLayoutCreation()
     bool hasUnprocessedItems = false;
     for (size_t i = _idleLayoutNextIndex; i < _items.size(); ++i)
     {
-        if (! _items[i].labelLayout && ! _items[i].displayName.empty())
+        if (! _items[i].labelLayout && ! _items[i].labelGlyphRun && ! _items[i].displayName.empty())
         {
             hasUnprocessedItems = true;
             break;
@@ -835,7 +880,7 @@ void FolderView::ScheduleIdleLayoutCreation()
         // Check items before visible range too
         for (size_t i = 0; i < startIndex && i < _items.size(); ++i)
         {
-            if (! _items[i].labelLayout && ! _items[i].displayName.empty())
+            if (! _items[i].labelLayout && ! _items[i].labelGlyphRun && ! _items[i].displayName.empty())
             {
                 hasUnprocessedItems  = true;
                 _idleLayoutNextIndex = i;
@@ -862,7 +907,7 @@ void FolderView::ProcessIdleLayoutBatch()
         return;
     }
 
-    const float labelWidth                = std::max(0.0f, _tileWidthDip - (kLabelHorizontalPaddingDip * 2.0f) - _iconSizeDip - kIconTextGapDip);
+    const float labelWidth                = ComputeLabelWidthDip();
     const float constrainedWidth          = std::max(labelWidth, 1.0f);
     const float constrainedHeight         = std::max(_labelHeightDip, 1.0f);
     const float constrainedDetailsHeight  = std::max(_detailsLineHeightDip, 1.0f);
@@ -877,28 +922,32 @@ void FolderView::ProcessIdleLayoutBatch()
         auto& item = _items[_idleLayoutNextIndex];
         ++_idleLayoutNextIndex;
 
-        if (item.displayName.empty() || item.labelLayout)
+        if (item.displayName.empty() || item.labelLayout || item.labelGlyphRun)
         {
             continue; // Skip empty names or already processed items
         }
 
-        // Create label layout
-        wil::com_ptr<IDWriteTextLayout> layout;
-        HRESULT hr = _dwriteFactory->CreateTextLayout(item.displayName.data(),
-                                                      static_cast<UINT32>(item.displayName.length()),
-                                                      _labelFormat.get(),
-                                                      constrainedWidth,
-                                                      constrainedHeight,
-                                                      layout.addressof());
-        if (SUCCEEDED(hr))
+        // Shape simple names into a cached glyph run; create a label layout only for complex text
+        HRESULT hr = S_OK;
+        if (! EnsureItemLabelGlyphRun(item))
         {
-            ConfigureLabelLayout(layout.get(), _ellipsisSign.get());
-            DWRITE_TEXT_METRICS metrics{};
-            if (SUCCEEDED(layout->GetMetrics(&metrics)))
+            wil::com_ptr<IDWriteTextLayout> layout;
+            hr = _dwriteFactory->CreateTextLayout(item.displayName.data(),
+                                                  static_cast<UINT32>(item.displayName.length()),
+                                                  _labelFormat.get(),
+                                                  constrainedWidth,
+                                                  constrainedHeight,
+                                                  layout.addressof());
+            if (SUCCEEDED(hr))
             {
-                item.labelMetrics = metrics;
+                ConfigureLabelLayout(layout.get(), _ellipsisSign.get());
+                DWRITE_TEXT_METRICS metrics{};
+                if (SUCCEEDED(layout->GetMetrics(&metrics)))
+                {
+                    item.labelMetrics = metrics;
+                }
+                item.labelLayout = std::move(layout);
             }
-            item.labelLayout = std::move(layout);
         }
 
         // Create details layout if needed
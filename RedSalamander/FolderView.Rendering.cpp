@@ -45,6 +45,12 @@ void FolderView::EnsureDeviceIndependentResources()
             _labelFormat->SetTrimming(&trimming, nullptr);
             _ellipsisSign.reset();
         }
+
+        const HRESULT hrGlyphRuns = _labelGlyphRuns.Initialize(_dwriteFactory.get(), _labelFormat.get());
+        if (FAILED(hrGlyphRuns))
+        {
+            Debug::Warning(L"FolderView: Label glyph runs unavailable, all labels use text layouts: 0x{:08X}", static_cast<unsigned long>(hrGlyphRuns));
+        }
     }
 
     if (! _detailsFormat)
@@ -539,11 +545,14 @@ void FolderView::DiscardDeviceResources()
 {
     ReleaseSwapChain();
 
-    // Clear per-item cached icons: ID2D1Bitmap1 instances are tied to the originating ID2D1Device.
+    // Clear per-item atlas slots: the atlas pages are tied to the originating ID2D1Device.
     for (auto& item : _items)
     {
-        item.icon.reset();
+        item.iconSlot = {};
     }
+    _iconSprites.clear();
+    _iconSpriteItems.clear();
+    ReleaseThumbnails(); // Bitmaps belong to the old device; visible ones are re-requested (from ThumbnailCache memory) on the next render
 
     wil::com_ptr<ID2D1Device> oldD2DDevice;
     {
@@ -568,6 +577,7 @@ void FolderView::DiscardDeviceResources()
     _placeholderFileIcon.reset();
     _shortcutOverlayIcon.reset();
 
+    _labelGlyphRuns.Reset();
     _labelFormat.reset();
     _detailsFormat.reset();
     _incrementalSearchIndicatorLayout.reset();
@@ -828,7 +838,13 @@ void FolderView::Render(const RECT& invalidRect)
 
     HRESULT hr               = S_OK;
     const uint64_t nowTickMs = GetTickCount64();
+    const auto frameStart    = std::chrono::steady_clock::now();
+    size_t staleIconSprites  = 0;
     {
+        _iconSprites.clear();
+        _iconSpriteItems.clear();
+        _thumbnailMissingInFrame = false;
+
         _d2dContext->BeginDraw();
         auto endDraw = wil::scope_exit([&] { hr = _d2dContext->EndDraw(); });
         _d2dContext->SetTransform(D2D1::Matrix3x2F::Identity());
@@ -917,6 +933,8 @@ void FolderView::Render(const RECT& invalidRect)
             }
         }
 
+        staleIconSprites = FlushIconSprites();
+
         if (_items.empty() && _displayedFolder.has_value() && ! _emptyStateMessage.empty() && _dwriteFactory && (_detailsFormat || _labelFormat))
         {
             bool hasOverlay = false;
@@ -959,6 +977,28 @@ void FolderView::Render(const RECT& invalidRect)
         _d2dContext->PopAxisAlignedClip();
     }
 
+    if (SUCCEEDED(hr) && ! _iconSprites.empty())
+    {
+        const auto frameUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frameStart).count();
+        IconCache::GetInstance().RecordIconFrameTime(static_cast<uint64_t>(frameUs));
+    }
+
+    if (staleIconSprites > 0)
+    {
+        // Some visible icons were evicted from the atlas; stamp or reload them and repaint.
+        BoostIconLoadingForVisibleRange();
+        if (_hWnd)
+        {
+            InvalidateRect(_hWnd.get(), nullptr, FALSE);
+        }
+    }
+
+    if (_thumbnailMissingInFrame)
+    {
+        // Visible tiles whose thumbnail was never requested (or released after device loss); results repaint as they arrive.
+        BoostThumbnailLoadingForVisibleRange();
+    }
+
     if (FAILED(hr))
     {
         ReportError(L"ID2D1DeviceContext::EndDraw", hr);
@@ -972,12 +1012,12 @@ void FolderView::Render(const RECT& invalidRect)
         params.pDirtyRects     = &paintRect;
         params.pScrollRect     = nullptr;
         params.pScrollOffset   = nullptr;
-        _swapChain->Present1(1, 0, &params);
+        _swapChain->Present1(_presentSyncInterval, 0, &params);
         ClearErrorOverlay(ErrorOverlayKind::Rendering);
     }
     else if (_swapChainLegacy)
     {
-        _swapChainLegacy->Present(1, 0);
+        _swapChainLegacy->Present(_presentSyncInterval, 0);
         ClearErrorOverlay(ErrorOverlayKind::Rendering);
     }
 }
@@ -1162,7 +1202,7 @@ void FolderView::DrawIncrementalSearchIndicator(uint64_t nowTickMs)
 void FolderView::DrawItem(FolderItem& item)
 {
     // Ensure text layout is created lazily before rendering
-    const float labelWidth = std::max(0.0f, _tileWidthDip - (kLabelHorizontalPaddingDip * 2.0f) - _iconSizeDip - kIconTextGapDip);
+    const float labelWidth = ComputeLabelWidthDip();
     EnsureItemTextLayout(item, labelWidth);
 
     D2D1_RECT_F bounds = OffsetRect(item.bounds, -_horizontalOffset, -_scrollOffset);
@@ -1298,41 +1338,59 @@ void FolderView::DrawItem(FolderItem& item)
     const float contentBottom = bounds.bottom - kLabelVerticalPaddingDip;
     const float contentHeight = std::max(0.0f, contentBottom - contentTop);
 
-    const float iconLeft = bounds.left + kLabelHorizontalPaddingDip;
-    const float iconTop  = _displayMode == DisplayMode::Brief ? contentTop + std::max(0.0f, (contentHeight - _iconSizeDip) * 0.5f) : contentTop;
-    D2D1_RECT_F iconRect = D2D1::RectF(iconLeft, iconTop, iconLeft + _iconSizeDip, iconTop + _iconSizeDip);
-    if (item.icon)
-    {
-        // Render icon with nearest neighbor interpolation for crisp pixel-perfect rendering
-        _d2dContext->DrawBitmap(item.icon.get(), iconRect, 1.0f, D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
-
-        // Render shortcut overlay if applicable
-        if (item.isShortcut && _shortcutOverlayIcon)
+    const bool thumbnailsMode = _displayMode == DisplayMode::Thumbnails;
+    D2D1_RECT_F thumbnailRect{};
+    D2D1_RECT_F iconRect{};
+    if (thumbnailsMode)
+    {
+        // Thumbnail area at the top of the tile; until a thumbnail is ready (or when none exists) the icon is centered in it.
+        const float thumbnailLeft = bounds.left + std::max(0.0f, (itemWidth - kThumbnailSizeDip) * 0.5f);
+        const float iconInset     = (kThumbnailSizeDip - kThumbnailFallbackIconDip) * 0.5f;
+        const float iconLeft      = thumbnailLeft + iconInset;
+        const float iconTop       = contentTop + iconInset;
+        thumbnailRect             = D2D1::RectF(thumbnailLeft, contentTop, thumbnailLeft + kThumbnailSizeDip, contentTop + kThumbnailSizeDip);
+        iconRect                  = D2D1::RectF(iconLeft, iconTop, iconLeft + kThumbnailFallbackIconDip, iconTop + kThumbnailFallbackIconDip);
+        if (item.thumbnailState == ThumbnailState::None)
         {
-            // Position overlay at bottom-right corner of icon
-            const float overlaySize = _iconSizeDip * 0.5f; // Half icon size for overlay
-            D2D1_RECT_F overlayRect = D2D1::RectF(iconRect.right - overlaySize, iconRect.bottom - overlaySize, iconRect.right, iconRect.bottom);
-            _d2dContext->DrawBitmap(_shortcutOverlayIcon.get(), &overlayRect, 1.0f, D2D1_INTERPOLATION_MODE_LINEAR);
+            _thumbnailMissingInFrame = true;
         }
     }
     else
     {
-        // Select appropriate placeholder based on item type
-        auto& placeholder = item.isDirectory ? _placeholderFolderIcon : _placeholderFileIcon;
-        if (placeholder)
-        {
-            // Draw placeholder with reduced opacity and linear interpolation
-            _d2dContext->DrawBitmap(placeholder.get(), &iconRect, 0.4f, D2D1_INTERPOLATION_MODE_LINEAR);
-        }
-        else
-        {
-            // Fallback if placeholders not created
-            _d2dContext->FillRectangle(iconRect, _backgroundBrush.get());
-            _d2dContext->DrawRectangle(iconRect, _focusBrush.get(), 1.0f);
-        }
+        const float iconLeft = bounds.left + kLabelHorizontalPaddingDip;
+        const float iconTop  = _displayMode == DisplayMode::Brief ? contentTop + std::max(0.0f, (contentHeight - _iconSizeDip) * 0.5f) : contentTop;
+        iconRect             = D2D1::RectF(iconLeft, iconTop, iconLeft + _iconSizeDip, iconTop + _iconSizeDip);
+    }
+
+    if (thumbnailsMode && item.thumbnail)
+    {
+        // Aspect-fit, never upscaled past the decoded size (bitmaps carry the window DPI, so GetSize() is in DIPs).
+        const D2D1_SIZE_F thumbnailSize = item.thumbnail->GetSize();
+        const float scaleX              = kThumbnailSizeDip / std::max(thumbnailSize.width, 1.0f);
+        const float scaleY              = kThumbnailSizeDip / std::max(thumbnailSize.height, 1.0f);
+        const float scale               = std::min({1.0f, scaleX, scaleY});
+        const float drawWidth           = thumbnailSize.width * scale;
+        const float drawHeight          = thumbnailSize.height * scale;
+        const float drawLeft            = thumbnailRect.left + (kThumbnailSizeDip - drawWidth) * 0.5f;
+        const float drawTop             = thumbnailRect.top + (kThumbnailSizeDip - drawHeight) * 0.5f;
+        const D2D1_RECT_F drawRect      = D2D1::RectF(drawLeft, drawTop, drawLeft + drawWidth, drawTop + drawHeight);
+        _d2dContext->DrawBitmap(item.thumbnail.get(), &drawRect, 1.0f, D2D1_INTERPOLATION_MODE_HIGH_QUALITY_CUBIC);
+    }
+    else if (item.iconSlot.IsValid())
+    {
+        // Icons are drawn together from the atlas after all items (see FlushIconSprites); items never overlap.
+        IconCache::AtlasSprite sprite;
+        sprite.slot        = item.iconSlot;
+        sprite.destination = iconRect;
+        _iconSprites.push_back(sprite);
+        _iconSpriteItems.push_back(static_cast<size_t>(std::addressof(item) - _items.data()));
+    }
+    else
+    {
+        DrawIconPlaceholder(item, iconRect);
     }
 
-    const float labelLeft      = iconRect.right + kIconTextGapDip;
+    const float labelLeft      = thumbnailsMode ? bounds.left + kLabelHorizontalPaddingDip : iconRect.right + kIconTextGapDip;
     const float labelRight     = bounds.right - kLabelHorizontalPaddingDip;
     const float availableWidth = std::max(0.0f, labelRight - labelLeft);
 
@@ -1505,17 +1563,32 @@ void FolderView::DrawItem(FolderItem& item)
         }
     }
 
-    if (item.labelLayout)
+    // Simple names are drawn from their cached glyph run; layouts (complex text, incremental search) take precedence.
+    const bool useGlyphRun = ! item.labelLayout && item.labelGlyphRun && _labelGlyphRuns.IsInitialized();
+
+    auto drawLabel = [&](D2D1_POINT_2F origin, float maxWidth)
+    {
+        if (useGlyphRun)
+        {
+            // Snap the baseline to a device pixel like DrawTextLayout does.
+            const float baselineY = DipFromPx(PxFromDip(origin.y + _labelGlyphRuns.GetBaselineDip()));
+            _labelGlyphRuns.Draw(_d2dContext.get(), D2D1::Point2F(origin.x, baselineY), *item.labelGlyphRun, maxWidth, textBrush);
+            return;
+        }
+
+        if (incrementalSearchRange.has_value())
+        {
+            drawIncrementalSearchHighlight(origin, incrementalSearchRange.value());
+        }
+        _d2dContext->DrawTextLayout(origin, item.labelLayout.get(), textBrush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
+    };
+
+    if (item.labelLayout || useGlyphRun)
     {
         if (_displayMode == DisplayMode::Detailed || _displayMode == DisplayMode::ExtraDetailed)
         {
             const float nameHeight = item.labelMetrics.height > 0.0f ? item.labelMetrics.height : std::max(0.0f, contentHeight * 0.5f);
-            D2D1_POINT_2F origin{labelLeft, contentTop};
-            if (incrementalSearchRange.has_value())
-            {
-                drawIncrementalSearchHighlight(origin, incrementalSearchRange.value());
-            }
-            _d2dContext->DrawTextLayout(origin, item.labelLayout.get(), textBrush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
+            drawLabel(D2D1::Point2F(labelLeft, contentTop), availableWidth);
 
             ID2D1SolidColorBrush* detailsBrush = item.selected ? textBrush : (_detailsTextBrush ? _detailsTextBrush.get() : textBrush);
 
@@ -1561,16 +1634,17 @@ void FolderView::DrawItem(FolderItem& item)
                 }
             }
         }
+        else if (thumbnailsMode)
+        {
+            const float labelTop = thumbnailRect.bottom + kThumbnailLabelGapDip;
+            const float offsetX  = std::max(0.0f, (availableWidth - item.labelMetrics.width) * 0.5f);
+            drawLabel(D2D1::Point2F(labelLeft + offsetX, labelTop), availableWidth - offsetX);
+        }
         else
         {
             const float metricsHeight = item.labelMetrics.height > 0.0f ? item.labelMetrics.height : contentHeight;
             const float offsetY       = std::max(0.0f, (contentHeight - metricsHeight) * 0.5f);
-            D2D1_POINT_2F origin{labelLeft, contentTop + offsetY};
-            if (incrementalSearchRange.has_value())
-            {
-                drawIncrementalSearchHighlight(origin, incrementalSearchRange.value());
-            }
-            _d2dContext->DrawTextLayout(origin, item.labelLayout.get(), textBrush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
+            drawLabel(D2D1::Point2F(labelLeft, contentTop + offsetY), availableWidth);
         }
     }
     else
@@ -1616,13 +1690,72 @@ void FolderView::DrawItem(FolderItem& item)
         }
         else
         {
-            D2D1_RECT_F labelRect = D2D1::RectF(labelLeft, contentTop, labelLeft + availableWidth, contentBottom);
+            const float labelTop  = thumbnailsMode ? thumbnailRect.bottom + kThumbnailLabelGapDip : contentTop;
+            D2D1_RECT_F labelRect = D2D1::RectF(labelLeft, labelTop, labelLeft + availableWidth, contentBottom);
             _d2dContext->DrawTextW(
                 item.displayName.data(), static_cast<UINT32>(item.displayName.length()), _labelFormat.get(), labelRect, textBrush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
         }
     }
 }
 
+void FolderView::DrawIconPlaceholder(const FolderItem& item, const D2D1_RECT_F& iconRect)
+{
+    // Select appropriate placeholder based on item type
+    const auto& placeholder = item.isDirectory ? _placeholderFolderIcon : _placeholderFileIcon;
+    if (placeholder)
+    {
+        // Draw placeholder with reduced opacity and linear interpolation
+        _d2dContext->DrawBitmap(placeholder.get(), &iconRect, 0.4f, D2D1_INTERPOLATION_MODE_LINEAR);
+    }
+    else
+    {
+        // Fallback if placeholders not created
+        _d2dContext->FillRectangle(iconRect, _backgroundBrush.get());
+        _d2dContext->DrawRectangle(iconRect, _focusBrush.get(), 1.0f);
+    }
+}
+
+size_t FolderView::FlushIconSprites()
+{
+    if (_iconSprites.empty())
+    {
+        return 0;
+    }
+
+    // One sprite batch draw per atlas page instead of one DrawBitmap (and bitmap switch) per visible item.
+    const size_t stale = IconCache::GetInstance().DrawAtlasSprites(_d2dContext.get(), _iconSprites);
+
+    for (size_t i = 0; i < _iconSprites.size(); ++i)
+    {
+        const size_t itemIndex = _iconSpriteItems[i];
+        if (itemIndex >= _items.size())
+        {
+            continue;
+        }
+
+        auto& item                  = _items[itemIndex];
+        const D2D1_RECT_F& iconRect = _iconSprites[i].destination;
+        if (! _iconSprites[i].slot.IsValid())
+        {
+            // Evicted since it was stamped: show the placeholder until the icon is reloaded.
+            item.iconSlot = {};
+            DrawIconPlaceholder(item, iconRect);
+            continue;
+        }
+
+        // Render shortcut overlay if applicable (on top of the batched icon)
+        if (item.isShortcut && _shortcutOverlayIcon)
+        {
+            // Position overlay at bottom-right corner of icon
+            const float overlaySize = (iconRect.right - iconRect.left) * 0.5f; // Half icon size for overlay
+            D2D1_RECT_F overlayRect = D2D1::RectF(iconRect.right - overlaySize, iconRect.bottom - overlaySize, iconRect.right, iconRect.bottom);
+            _d2dContext->DrawBitmap(_shortcutOverlayIcon.get(), &overlayRect, 1.0f, D2D1_INTERPOLATION_MODE_LINEAR);
+        }
+    }
+
+    return stale;
+}
+
 D2D1_RECT_F FolderView::OffsetRect(const D2D1_RECT_F& rect, float dx, float dy) const
 {
     return D2D1::RectF(rect.left + dx, rect.top + dy, rect.right + dx, rect.bottom + dy);
@@ -0,0 +1,340 @@
+#include "FolderViewInternal.h"
+
+namespace
+{
+constexpr size_t kThumbnailKeepAroundVisible = 512; // Bitmaps kept (and prefetched) around the visible range; ~36 KB each at 96 px
+constexpr size_t kThumbnailBoostBufferItems  = 32;  // Scroll look-ahead re-prioritized by BoostThumbnailLoadingForVisibleRange
+constexpr unsigned int kMaxThumbnailWorkers  = 4;   // Decodes in flight; more would only compete for the same disk or connection
+} // namespace
+
+std::optional<FolderView::ThumbnailRequest> FolderView::BuildThumbnailRequest(size_t itemIndex, uint64_t generation, uint32_t bucketPx)
+{
+    if (itemIndex >= _items.size())
+    {
+        return std::nullopt;
+    }
+
+    auto& item = _items[itemIndex];
+    if (item.thumbnailState != ThumbnailState::None || item.isDirectory || item.displayName.empty())
+    {
+        return std::nullopt;
+    }
+
+    const std::wstring_view extension = item.GetExtension();
+    if (extension.empty() || ! _thumbnailProviderResolver || ! _fileSystem)
+    {
+        item.thumbnailState = ThumbnailState::Unavailable;
+        return std::nullopt;
+    }
+
+    std::wstring extensionKey(extension);
+    for (wchar_t& ch : extensionKey)
+    {
+        ch = static_cast<wchar_t>(std::towlower(static_cast<wint_t>(ch)));
+    }
+
+    auto providerIt = _thumbnailProviders.find(extensionKey);
+    if (providerIt == _thumbnailProviders.end())
+    {
+        wil::com_ptr<IViewerThumbnail> resolved = _thumbnailProviderResolver(extensionKey);
+        providerIt                              = _thumbnailProviders.emplace(std::move(extensionKey), std::move(resolved)).first;
+    }
+
+    if (! providerIt->second)
+    {
+        item.thumbnailState = ThumbnailState::Unavailable;
+        return std::nullopt;
+    }
+
+    ThumbnailRequest request;
+    request.generation    = generation;
+    request.itemIndex     = itemIndex;
+    request.path          = GetItemFullPath(item).native();
+    request.sizeBytes     = item.sizeBytes;
+    request.lastWriteTime = item.lastWriteTime;
+    request.bucketPx      = bucketPx;
+    request.provider      = providerIt->second;
+    request.fileSystem    = _fileSystem;
+    request.cacheScope    = std::format(L"{}|{}", _fileSystemPluginId, _fileSystemInstanceContext);
+
+    item.thumbnailState = ThumbnailState::Queued;
+    return request;
+}
+
+void FolderView::QueueThumbnailLoading()
+{
+    if (_displayMode != DisplayMode::Thumbnails || _items.empty() || ! _hWnd || ! _d2dContext)
+    {
+        return;
+    }
+
+    // Items were replaced or reordered: requests of the previous generation are dropped (and their results ignored).
+    ++_thumbnailGeneration;
+    _thumbnailProviders.clear(); // Re-resolve per batch so "open with viewer" changes apply on the next refresh
+
+    for (auto& item : _items)
+    {
+        if (item.thumbnailState == ThumbnailState::Queued)
+        {
+            item.thumbnailState = ThumbnailState::None;
+        }
+    }
+
+    const uint32_t bucketPx       = ThumbnailCache::SelectBucketPx(static_cast<uint32_t>(std::max(1, PxFromDip(kThumbnailSizeDip))));
+    const auto [visStart, visEnd] = GetVisibleItemRange();
+    const size_t first            = std::min(visStart, _items.size());
+    const size_t last             = std::clamp(visEnd, first, _items.size());
+
+    std::deque<ThumbnailRequest> queue;
+    auto enqueue = [&](size_t itemIndex)
+    {
+        if (auto request = BuildThumbnailRequest(itemIndex, _thumbnailGeneration, bucketPx))
+        {
+            queue.push_back(std::move(request.value()));
+        }
+    };
+
+    // Visible items first, then prefetch outward (ahead of the view before behind it).
+    for (size_t i = first; i < last; ++i)
+    {
+        enqueue(i);
+    }
+    for (size_t offset = 0; offset < kThumbnailKeepAroundVisible; ++offset)
+    {
+        if (last + offset < _items.size())
+        {
+            enqueue(last + offset);
+        }
+        if (first > offset)
+        {
+            enqueue(first - offset - 1u);
+        }
+    }
+
+    const size_t queued = queue.size();
+    {
+        std::lock_guard lock(_thumbnailMutex);
+        _thumbnailQueue = std::move(queue);
+    }
+
+    if (queued > 0)
+    {
+        EnsureThumbnailWorkers();
+        _thumbnailCv.notify_all();
+    }
+
+    Debug::Info(L"FolderView: Thumbnail load queued - {} items ({} visible), bucket {} px", queued, last - first, bucketPx);
+}
+
+void FolderView::BoostThumbnailLoadingForVisibleRange()
+{
+    if (_displayMode != DisplayMode::Thumbnails || _items.empty() || ! _hWnd || ! _d2dContext)
+    {
+        return;
+    }
+
+    const auto [visStart, visEnd] = GetVisibleItemRange();
+    if (visStart >= _items.size() || visEnd <= visStart)
+    {
+        return;
+    }
+
+    // Release bitmaps far from the view to bound GPU memory; scrolling back re-requests them (usually a ThumbnailCache memory hit).
+    const size_t keepStart = (visStart > kThumbnailKeepAroundVisible) ? (visStart - kThumbnailKeepAroundVisible) : 0;
+    const size_t keepEnd   = std::min(visEnd + kThumbnailKeepAroundVisible, _items.size());
+
+    auto releaseRange = [this](size_t begin, size_t end) noexcept
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto& item = _items[i];
+            if (item.thumbnailState == ThumbnailState::Ready)
+            {
+                item.thumbnail.reset();
+                item.thumbnailState = ThumbnailState::None;
+            }
+        }
+    };
+    releaseRange(0, keepStart);
+    releaseRange(keepEnd, _items.size());
+
+    const size_t rangeStart = (visStart > kThumbnailBoostBufferItems) ? (visStart - kThumbnailBoostBufferItems) : 0;
+    const size_t rangeEnd   = std::min(visEnd + kThumbnailBoostBufferItems, _items.size());
+    const uint32_t bucketPx = ThumbnailCache::SelectBucketPx(static_cast<uint32_t>(std::max(1, PxFromDip(kThumbnailSizeDip))));
+
+    std::vector<ThumbnailRequest> added;
+    for (size_t i = rangeStart; i < rangeEnd; ++i)
+    {
+        if (auto request = BuildThumbnailRequest(i, _thumbnailGeneration, bucketPx))
+        {
+            added.push_back(std::move(request.value()));
+        }
+    }
+
+    {
+        std::lock_guard lock(_thumbnailMutex);
+
+        // Requests already queued for the new range move ahead of the off-screen prefetch.
+        std::stable_partition(_thumbnailQueue.begin(),
+                              _thumbnailQueue.end(),
+                              [&](const ThumbnailRequest& request) { return request.itemIndex >= rangeStart && request.itemIndex < rangeEnd; });
+        _thumbnailQueue.insert(_thumbnailQueue.begin(), std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()));
+
+        if (_thumbnailQueue.empty())
+        {
+            return;
+        }
+    }
+
+    EnsureThumbnailWorkers();
+    _thumbnailCv.notify_all();
+}
+
+void FolderView::EnsureThumbnailWorkers()
+{
+    if (! _thumbnailThreads.empty())
+    {
+        return;
+    }
+
+    // A few decodes overlap so one slow file (a large JPEG, a remote read) does not hold up the visible tiles behind it.
+    const unsigned int workerCount = std::clamp(std::thread::hardware_concurrency() / 2u, 2u, kMaxThumbnailWorkers);
+    _thumbnailThreads.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        try
+        {
+            _thumbnailThreads.emplace_back([this](std::stop_token stopToken) { ThumbnailWorker(stopToken); });
+        }
+        catch (const std::system_error&)
+        {
+            Debug::Warning(L"FolderView: Failed to start thumbnail worker {} of {}.", i + 1u, workerCount);
+            break;
+        }
+    }
+}
+
+void FolderView::ThumbnailWorker(std::stop_token stopToken)
+{
+    // Viewer plugins read through IFileSystem/IFileSystemIO (COM); join the MTA like the enumeration worker.
+    [[maybe_unused]] auto coInit = wil::CoInitializeEx(COINIT_MULTITHREADED);
+
+    [[maybe_unused]] const std::stop_callback notifyOnStop(stopToken, [this]() noexcept { _thumbnailCv.notify_all(); });
+    while (! stopToken.stop_requested())
+    {
+        ThumbnailRequest request;
+        {
+            std::unique_lock lock(_thumbnailMutex);
+            _thumbnailCv.wait(lock, [&]() { return stopToken.stop_requested() || ! _thumbnailQueue.empty(); });
+            if (stopToken.stop_requested())
+            {
+                break;
+            }
+
+            request = std::move(_thumbnailQueue.front());
+            _thumbnailQueue.pop_front();
+        }
+
+        ThumbnailCache& cache = ThumbnailCache::GetInstance();
+
+        auto result        = std::make_unique<ThumbnailResult>();
+        result->generation = request.generation;
+        result->itemIndex  = request.itemIndex;
+        result->hr         = cache.GetThumbnail(request.provider.get(),
+                                                request.fileSystem.get(),
+                                                request.path,
+                                                request.cacheScope,
+                                                request.sizeBytes,
+                                                request.lastWriteTime,
+                                                request.bucketPx,
+                                                result->image);
+
+        if (stopToken.stop_requested() || ! _hWnd)
+        {
+            break;
+        }
+
+        static_cast<void>(PostMessagePayload(_hWnd.get(), WndMsg::kFolderViewThumbnailReady, 0, std::move(result)));
+    }
+}
+
+void FolderView::OnThumbnailReady(std::unique_ptr<ThumbnailResult> result)
+{
+    if (! result || result->generation != _thumbnailGeneration || result->itemIndex >= _items.size())
+    {
+        return;
+    }
+
+    auto& item = _items[result->itemIndex];
+    if (item.thumbnailState != ThumbnailState::Queued)
+    {
+        return;
+    }
+
+    if (FAILED(result->hr) || ! result->image || ! _d2dContext)
+    {
+        item.thumbnailState = ThumbnailState::Unavailable;
+        return;
+    }
+
+    const ThumbnailCache::Image& image = *result->image;
+    const D2D1_BITMAP_PROPERTIES1 properties =
+        D2D1::BitmapProperties1(D2D1_BITMAP_OPTIONS_NONE, D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED), _dpi, _dpi);
+
+    wil::com_ptr<ID2D1Bitmap1> bitmap;
+    const HRESULT hr = _d2dContext->CreateBitmap(D2D1::SizeU(image.width, image.height), image.bgra.data(), image.width * 4u, &properties, bitmap.addressof());
+    if (FAILED(hr) || ! bitmap)
+    {
+        Debug::Warning(L"FolderView: Failed to create thumbnail bitmap ({}x{}): 0x{:08X}", image.width, image.height, static_cast<unsigned long>(hr));
+        item.thumbnailState = ThumbnailState::Unavailable;
+        return;
+    }
+
+    item.thumbnail      = std::move(bitmap);
+    item.thumbnailState = ThumbnailState::Ready;
+
+    if (_hWnd)
+    {
+        const D2D1_RECT_F viewBounds = OffsetRect(item.bounds, -_horizontalOffset, -_scrollOffset);
+        RECT updateRect;
+        updateRect.left   = PxFromDip(viewBounds.left);
+        updateRect.top    = PxFromDip(viewBounds.top);
+        updateRect.right  = PxFromDip(viewBounds.right);
+        updateRect.bottom = PxFromDip(viewBounds.bottom);
+        InvalidateRect(_hWnd.get(), &updateRect, FALSE);
+    }
+}
+
+void FolderView::ReleaseThumbnails() noexcept
+{
+    ++_thumbnailGeneration;
+    {
+        std::lock_guard lock(_thumbnailMutex);
+        _thumbnailQueue.clear();
+    }
+
+    for (auto& item : _items)
+    {
+        item.thumbnail.reset();
+        item.thumbnailState = ThumbnailState::None;
+    }
+}
+
+void FolderView::StopThumbnailThreads() noexcept
+{
+    if (_thumbnailThreads.empty())
+    {
+        return;
+    }
+
+    for (auto& thread : _thumbnailThreads)
+    {
+        thread.request_stop();
+    }
+    {
+        std::lock_guard lock(_thumbnailMutex);
+        _thumbnailQueue.clear();
+    }
+    _thumbnailCv.notify_all();
+    _thumbnailThreads.clear();
+}
@@ -93,6 +93,7 @@ void FolderView::Destroy()
 {
     CancelPendingEnumeration();
     StopEnumerationThread();
+    StopThumbnailThreads();
 
     _directoryCachePin = {};
     _items.clear();
@@ -191,7 +192,7 @@ void FolderView::SetEmptyStateMessage(std::wstring message)
 
 void FolderView::RefreshDetailsText()
 {
-    if (_displayMode == DisplayMode::Brief)
+    if (_displayMode == DisplayMode::Brief || _displayMode == DisplayMode::Thumbnails)
     {
         return;
     }
@@ -373,6 +374,12 @@ LRESULT FolderView::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lPara
             return 0;
         }
         case WndMsg::kFolderViewDirectoryCacheDirty: OnDirectoryCacheDirty(); return 0;
+        case WndMsg::kFolderViewThumbnailReady:
+        {
+            auto result = TakeMessagePayload<ThumbnailResult>(lParam);
+            OnThumbnailReady(std::move(result));
+            return 0;
+        }
         case WM_DESTROY: OnDestroy(); return 0;
         case WM_NCDESTROY: static_cast<void>(DrainPostedPayloadsForWindow(hwnd)); break;
         case WM_SIZE: OnSize(LOWORD(lParam), HIWORD(lParam)); return 0;
@@ -534,6 +541,7 @@ void FolderView::OnDeferredInit()
     // Icon loading can be queued before D2D resources exist (during early enumeration).
     // Re-queue now that we can actually convert icons to bitmaps.
     QueueIconLoading();
+    QueueThumbnailLoading();
 
     if (_hWnd)
     {
@@ -554,6 +562,7 @@ void FolderView::OnDestroy()
     StopOverlayTimer();
     CancelPendingEnumeration();
     StopEnumerationThread();
+    StopThumbnailThreads();
     _directoryCachePin = DirectoryInfoCache::Pin{};
     if (_dropTargetRegistered && _hWnd)
     {
@@ -684,6 +693,11 @@ void FolderView::SetDisplayMode(DisplayMode mode)
         return;
     }
 
+    if (_displayMode == DisplayMode::Thumbnails)
+    {
+        ReleaseThumbnails();
+    }
+
     _displayMode            = mode;
     _itemMetricsCached      = false;
     _cachedMaxLabelWidth    = 0.0f;
@@ -693,7 +707,7 @@ void FolderView::SetDisplayMode(DisplayMode mode)
     _detailsSizeSlotChars   = 0;
     _lastLayoutWidth        = 0.0f;
 
-    if (_displayMode == DisplayMode::Brief)
+    if (_displayMode == DisplayMode::Brief || _displayMode == DisplayMode::Thumbnails)
     {
         for (auto& item : _items)
         {
@@ -715,6 +729,7 @@ void FolderView::SetDisplayMode(DisplayMode mode)
     LayoutItems();
     UpdateScrollMetrics();
     QueueIconLoading();
+    QueueThumbnailLoading();
 
     if (_hWnd)
     {
@@ -736,6 +751,7 @@ void FolderView::SetSort(SortBy sortBy, SortDirection direction)
     LayoutItems();
     UpdateScrollMetrics();
     QueueIconLoading();
+    QueueThumbnailLoading();
 
     if (_hWnd)
     {
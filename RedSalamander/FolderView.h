@@ -47,9 +47,13 @@
 #include "AppTheme.h"
 #include "DirectoryInfoCache.h"
 #include "Helpers.h"
+#include "IconCache.h"
+#include "LabelGlyphRunCache.h"
+#include "ThumbnailCache.h"
 
 struct IWICImagingFactory;
 struct IFileSystem;
+struct IViewerThumbnail;
 struct PluginMetaData;
 enum FileSystemOperation : uint32_t;
 enum FileSystemFlags : uint32_t;
@@ -72,6 +76,18 @@ public:
 
     static ATOM RegisterWndClass(HINSTANCE instance);
 
+    // Runs the enumeration worker's build + sort step on a listing, exactly as enumerating `folder` would, and discards the
+    // items (--benchmarks times the real code path through this).
+    static HRESULT BenchmarkBuildSortedItems(IFilesInformation* filesInformation, std::wstring_view folder, size_t& itemCount) noexcept;
+
+    // Scroll hooks for --benchmarks (UI thread). BenchmarkResetScroll returns to the first column, drops every item's label,
+    // details and metadata state, and picks how simple labels are drawn: cached glyph runs (the default) or one
+    // IDWriteTextLayout per item, the path glyph runs replaced. BenchmarkScrollFrame scrolls like the mouse wheel and paints
+    // the frame synchronously, presenting without waiting for vertical blank so frames are not capped at the refresh rate.
+    [[nodiscard]] size_t BenchmarkGetItemCount() const noexcept;
+    void BenchmarkResetScroll(bool useLabelGlyphRuns) noexcept;
+    void BenchmarkScrollFrame(int columns) noexcept;
+
     HWND Create(HWND parent, int x, int y, int width, int height);
     void Destroy();
 
@@ -181,6 +197,7 @@ public:
         Brief,
         Detailed,
         ExtraDetailed,
+        Thumbnails,
     };
 
     enum class SortBy : uint8_t
@@ -351,6 +368,14 @@ public:
         _metadataTextProvider = std::move(provider);
     }
 
+    // Resolves the thumbnail decoder for a file extension (lowercase, including the dot); returns nullptr when none applies.
+    // Called on the UI thread; the returned provider is then used from the thumbnail worker.
+    using ThumbnailProviderResolver = std::function<wil::com_ptr<IViewerThumbnail>(std::wstring_view extension)>;
+    void SetThumbnailProviderResolver(ThumbnailProviderResolver resolver)
+    {
+        _thumbnailProviderResolver = std::move(resolver);
+    }
+
     // Optional non-error empty-state message shown when enumeration succeeds but no items are displayed.
     // Caller controls when it is set/cleared (e.g. "This folder doesn't exist in this hierarchy.").
     void SetEmptyStateMessage(std::wstring message);
@@ -393,6 +418,14 @@ private:
         wil::unique_hicon hIcon = nullptr;
     };
 
+    enum class ThumbnailState : uint8_t
+    {
+        None,        // Not requested (or released when far from the visible range)
+        Queued,      // Waiting for the thumbnail worker
+        Ready,       // `thumbnail` holds the bitmap
+        Unavailable, // No provider or decode failed; draw the icon
+    };
+
     struct FolderItem
     {
         // Zero-copy displayName: points into arena buffer (IFilesInformation kept alive)
@@ -411,11 +444,12 @@ private:
 
         // Rendering state
         D2D1_RECT_F bounds{};
-        wil::com_ptr<ID2D1Bitmap1> icon;
-        int iconIndex = -1; // System image list icon index from SHGetFileInfo
+        IconCache::AtlasSlot iconSlot; // Icon position in the IconCache atlas (drawn in one sprite batch per frame)
+        int iconIndex = -1;            // System image list icon index from SHGetFileInfo
         int column    = 0;
         int row       = 0;
         wil::com_ptr<IDWriteTextLayout> labelLayout;
+        std::shared_ptr<const LabelGlyphRunCache::Run> labelGlyphRun; // Simple names: drawn with DrawGlyphRun instead of labelLayout
         DWRITE_TEXT_METRICS labelMetrics{};
         std::wstring detailsText;
         wil::com_ptr<IDWriteTextLayout> detailsLayout;
@@ -425,6 +459,9 @@ private:
         wil::com_ptr<IDWriteTextLayout> metadataLayout;
         DWRITE_TEXT_METRICS metadataMetrics{};
 
+        wil::com_ptr<ID2D1Bitmap1> thumbnail; // Thumbnails display mode only
+        ThumbnailState thumbnailState = ThumbnailState::None;
+
         // Get extension from displayName (zero-copy)
         [[nodiscard]] std::wstring_view GetExtension() const noexcept
         {
@@ -536,6 +573,7 @@ private:
     wil::com_ptr<ID2D1Bitmap1> _d2dTarget;
     wil::com_ptr<IDWriteFactory> _dwriteFactory;
     wil::com_ptr<IDWriteTextFormat> _labelFormat;
+    LabelGlyphRunCache _labelGlyphRuns;
     wil::com_ptr<IDWriteTextFormat> _detailsFormat;
     wil::com_ptr<IDWriteInlineObject> _ellipsisSign;
     wil::com_ptr<IDWriteInlineObject> _detailsEllipsisSign;
@@ -554,6 +592,8 @@ private:
     wil::com_ptr<ID2D1Bitmap> _placeholderFolderIcon; // Folder placeholder (48×48) with Fluent Design
     wil::com_ptr<ID2D1Bitmap> _placeholderFileIcon;   // File placeholder (48×48) with Fluent Design
     wil::com_ptr<ID2D1Bitmap> _shortcutOverlayIcon;   // 16×16 shortcut arrow overlay
+    std::vector<IconCache::AtlasSprite> _iconSprites; // Icons collected by DrawItem, drawn by FlushIconSprites
+    std::vector<size_t> _iconSpriteItems;             // Item index per entry in _iconSprites
     wil::com_ptr<IWICImagingFactory> _wicFactory;
     wil::com_ptr<IDropTarget> _dropTarget;
     std::unique_ptr<RedSalamander::Ui::AlertOverlay> _alertOverlay;
@@ -590,6 +630,8 @@ private:
     bool _oleInitialized            = false;
     bool _dropTargetRegistered      = false;
     bool _supportsPresent1          = true;
+    UINT _presentSyncInterval       = 1;     // 0 only while BenchmarkScrollFrame paints
+    bool _labelGlyphRunsDisabled    = false; // BenchmarkResetScroll: draw every label from an IDWriteTextLayout
     bool _paneFocused               = false;
     IncrementalSearchState _incrementalSearch{};
     std::wstring _incrementalSearchIndicatorDisplayQuery;
@@ -653,6 +695,7 @@ private:
     EnumerationCompletedCallback _enumerationCompletedCallback;
     DetailsTextProvider _detailsTextProvider;
     MetadataTextProvider _metadataTextProvider;
+    ThumbnailProviderResolver _thumbnailProviderResolver;
 
     SelectionStats _selectionStats{};
 
@@ -712,12 +755,22 @@ private:
     void EnsureEnumerationThread();
     void EnumerationWorker(std::stop_token stopToken);
     std::unique_ptr<EnumerationPayload> ExecuteEnumeration(const std::filesystem::path& folder, uint64_t generation, std::stop_token stopToken);
+    // Builds FolderItems from a listing (compact columns when offered, else the FileInfo buffer) and sorts them, directories first.
+    // Returns HRESULT_FROM_WIN32(ERROR_CANCELLED) as soon as isCanceled() does.
+    template <typename IsCanceled>
+    static HRESULT BuildSortedItems(IFilesInformation* filesInformation,
+                                    std::wstring_view folderText,
+                                    IsCanceled&& isCanceled,
+                                    std::vector<FolderItem>& items,
+                                    size_t& directoryCount);
     void ApplyCurrentSort();
     void ApplyCurrentSort(std::wstring_view focusedPath, size_t fallbackFocusIndex);
     void LayoutItems();
     void UpdateScrollMetrics();
     void Render(const RECT& invalidRect);
     void DrawItem(FolderItem& item);
+    void DrawIconPlaceholder(const FolderItem& item, const D2D1_RECT_F& iconRect);
+    size_t FlushIconSprites();
     void DrawIncrementalSearchIndicator(uint64_t nowTickMs);
 
     void SelectSingle(size_t index);
@@ -749,8 +802,10 @@ private:
     std::vector<std::filesystem::path> GetSelectedPaths() const;
     void UpdateItemTextLayouts(float labelWidth);
     void EnsureItemTextLayout(FolderItem& item, float labelWidth);
+    bool EnsureItemLabelGlyphRun(FolderItem& item);
+    [[nodiscard]] float ComputeLabelWidthDip() const noexcept;
     std::pair<size_t, size_t> GetVisibleItemRange() const;
-    void ReleaseDistantRenderingState(); // Release layouts/icons for items far from visible range
+    void ReleaseDistantRenderingState(); // Release text layouts for items far from visible range
     void ScheduleIdleLayoutCreation();
     void ProcessIdleLayoutBatch();
     void UpdateEstimatedMetrics();
@@ -858,4 +913,44 @@ private:
     void OnCreateIconBitmap(std::unique_ptr<IconBitmapRequest> request);
     void MaybeEmitIconBitmapSummary(uint64_t batchId) noexcept;
     void BoostIconLoadingForVisibleRange();
+
+    // Thumbnails display mode (FolderView.Thumbnails.cpp): decoded by a small pool of workers through ThumbnailCache,
+    // visible items first, and uploaded to ID2D1Bitmap1 on the UI thread.
+    struct ThumbnailRequest
+    {
+        uint64_t generation = 0;
+        size_t itemIndex    = 0;
+        std::wstring path;
+        uint64_t sizeBytes    = 0;
+        int64_t lastWriteTime = 0;
+        uint32_t bucketPx     = 0;
+        wil::com_ptr<IViewerThumbnail> provider;
+        wil::com_ptr<IFileSystem> fileSystem;
+        std::wstring cacheScope;
+    };
+
+    struct ThumbnailResult
+    {
+        uint64_t generation = 0;
+        size_t itemIndex    = 0;
+        HRESULT hr          = S_OK;
+        std::shared_ptr<const ThumbnailCache::Image> image;
+    };
+
+    void QueueThumbnailLoading();
+    void BoostThumbnailLoadingForVisibleRange();
+    void EnsureThumbnailWorkers();
+    void ThumbnailWorker(std::stop_token stopToken);
+    void OnThumbnailReady(std::unique_ptr<ThumbnailResult> result);
+    void ReleaseThumbnails() noexcept;
+    void StopThumbnailThreads() noexcept;
+    [[nodiscard]] std::optional<ThumbnailRequest> BuildThumbnailRequest(size_t itemIndex, uint64_t generation, uint32_t bucketPx);
+
+    std::mutex _thumbnailMutex;
+    std::condition_variable _thumbnailCv;
+    std::deque<ThumbnailRequest> _thumbnailQueue;
+    uint64_t _thumbnailGeneration = 0;     // UI thread; copied into requests and checked when results arrive
+    bool _thumbnailMissingInFrame = false; // Set by DrawItem for visible tiles whose thumbnail was never requested
+    std::unordered_map<std::wstring, wil::com_ptr<IViewerThumbnail>> _thumbnailProviders; // Per extension (nullptr = none)
+    std::vector<std::jthread> _thumbnailThreads; // Started on first request; share _thumbnailQueue
 };
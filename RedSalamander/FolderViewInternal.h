@@ -51,6 +51,7 @@
 #include "Helpers.h"
 #include "PlugInterfaces/FileSystem.h"
 #include "PlugInterfaces/Informations.h"
+#include "PlugInterfaces/Viewer.h"
 #include "Ui/AlertOverlay.h"
 
 #include "FolderView.h"
@@ -102,6 +103,9 @@ constexpr float kIconTextGapDip                   = 12.0f;
 constexpr float kColumnSpacingDip                 = 18.0f;
 constexpr float kRowSpacingDip                    = 4.0f;
 constexpr float kDetailsGapDip                    = 2.0f;
+constexpr float kThumbnailSizeDip                 = 96.0f;
+constexpr float kThumbnailLabelGapDip             = 4.0f;
+constexpr float kThumbnailFallbackIconDip         = 32.0f;
 constexpr float kDetailsTextAlpha                 = 0.75f;
 constexpr float kMetadataTextAlpha                = 0.55f;
 constexpr UINT kSwapChainBufferCount              = 2;
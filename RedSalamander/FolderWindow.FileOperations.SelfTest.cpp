@@ -416,37 +416,6 @@ FolderView* TryGetFolderView(FolderWindow* folderWindow, FolderWindow::Pane pane
     return reinterpret_cast<FolderView*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
 }
 
-bool BackupPluginConfiguration(IInformations* info, std::string& outConfigUtf8) noexcept
-{
-    if (! info)
-    {
-        return false;
-    }
-
-    const char* config = nullptr;
-    const HRESULT hr   = info->GetConfiguration(&config);
-    if (FAILED(hr) || ! config)
-    {
-        return false;
-    }
-
-    outConfigUtf8 = config;
-    return true;
-}
-
-bool SetPluginConfiguration(IInformations* info, std::string_view configUtf8) noexcept
-{
-    if (! info)
-    {
-        return false;
-    }
-
-    std::string owned(configUtf8);
-    owned.push_back('\0');
-    const HRESULT hr = info->SetConfiguration(owned.c_str());
-    return SUCCEEDED(hr);
-}
-
 void PerformCleanup(SelfTestState& state) noexcept
 {
     if (state.fileOps)
@@ -456,11 +425,11 @@ void PerformCleanup(SelfTestState& state) noexcept
 
     if (! state.localConfigOriginal.empty())
     {
-        static_cast<void>(SetPluginConfiguration(state.infoLocal.get(), state.localConfigOriginal));
+        static_cast<void>(SelfTest::SetPluginConfiguration(state.infoLocal.get(), state.localConfigOriginal));
     }
     if (! state.dummyConfigOriginal.empty())
     {
-        static_cast<void>(SetPluginConfiguration(state.infoDummy.get(), state.dummyConfigOriginal));
+        static_cast<void>(SelfTest::SetPluginConfiguration(state.infoDummy.get(), state.dummyConfigOriginal));
     }
 
     state.directoryWatchCallback.reset();
@@ -1539,11 +1508,11 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
 
             if (state.localConfigOriginal.empty())
             {
-                static_cast<void>(BackupPluginConfiguration(state.infoLocal.get(), state.localConfigOriginal));
+                static_cast<void>(SelfTest::BackupPluginConfiguration(state.infoLocal.get(), state.localConfigOriginal));
             }
             if (state.dummyConfigOriginal.empty())
             {
-                static_cast<void>(BackupPluginConfiguration(state.infoDummy.get(), state.dummyConfigOriginal));
+                static_cast<void>(SelfTest::BackupPluginConfiguration(state.infoDummy.get(), state.dummyConfigOriginal));
             }
 
             if (state.dummyPaths.empty())
@@ -1568,7 +1537,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
                 {
                     const std::string config =
                         std::format(R"json({{"maxChildrenPerDirectory":128,"maxDepth":10,"seed":{},"latencyMs":5,"virtualSpeedLimit":"0"}})json", seed);
-                    if (! SetPluginConfiguration(state.infoDummy.get(), config))
+                    if (! SelfTest::SetPluginConfiguration(state.infoDummy.get(), config))
                     {
                         return false;
                     }
@@ -2149,7 +2118,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
                 // Make deletion slow/predictable so we can reliably observe pre-calc and queue-pause behavior.
                 const std::string config =
                     R"json({"copyMoveMaxConcurrency":4,"deleteMaxConcurrency":1,"deleteRecycleBinMaxConcurrency":1,"enumerationSoftMaxBufferMiB":512,"enumerationHardMaxBufferMiB":2048,"directorySizeDelayMs":1})json";
-                static_cast<void>(SetPluginConfiguration(state.infoLocal.get(), config));
+                static_cast<void>(SelfTest::SetPluginConfiguration(state.infoLocal.get(), config));
 
                 state.taskA = StartFileOperationAndGetId(
                     state.fileOps, FILESYSTEM_DELETE, FolderWindow::Pane::Left, std::nullopt, state.fsLocal, {state.tempRoot / L"precalc-a"}, {}, flags, false);
@@ -2737,7 +2706,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
                 }
 
                 // Force the enumeration code down the grow/trim paths by lowering caps.
-                static_cast<void>(SetPluginConfiguration(
+                static_cast<void>(SelfTest::SetPluginConfiguration(
                     state.infoLocal.get(),
                     R"json({"copyMoveMaxConcurrency":4,"deleteMaxConcurrency":8,"deleteRecycleBinMaxConcurrency":2,"enumerationSoftMaxBufferMiB":1,"enumerationHardMaxBufferMiB":8})json"));
 
@@ -2873,7 +2842,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
                 const std::string config = std::format(
                     R"json({{"copyMoveMaxConcurrency":{},"deleteMaxConcurrency":8,"deleteRecycleBinMaxConcurrency":2,"enumerationSoftMaxBufferMiB":512,"enumerationHardMaxBufferMiB":2048}})json",
                     conc);
-                static_cast<void>(SetPluginConfiguration(state.infoLocal.get(), config));
+                static_cast<void>(SelfTest::SetPluginConfiguration(state.infoLocal.get(), config));
 
                 if (! RecreateEmptyDirectory(dstDir))
                 {
@@ -3120,7 +3089,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
                 state.baselineThreadCount  = 0;
                 state.lastProgressLogTick  = 0;
 
-                static_cast<void>(SetPluginConfiguration(
+                static_cast<void>(SelfTest::SetPluginConfiguration(
                     state.infoLocal.get(),
                     R"json({"copyMoveMaxConcurrency":8,"deleteMaxConcurrency":8,"deleteRecycleBinMaxConcurrency":2,"enumerationSoftMaxBufferMiB":512,"enumerationHardMaxBufferMiB":2048,"directorySizeDelayMs":1})json"));
 
@@ -3544,7 +3513,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
                 const std::string config = std::format(
                     R"json({{"copyMoveMaxConcurrency":4,"deleteMaxConcurrency":{},"deleteRecycleBinMaxConcurrency":2,"enumerationSoftMaxBufferMiB":512,"enumerationHardMaxBufferMiB":2048}})json",
                     conc);
-                static_cast<void>(SetPluginConfiguration(state.infoLocal.get(), config));
+                static_cast<void>(SelfTest::SetPluginConfiguration(state.infoLocal.get(), config));
 
                 if (! CreateDeleteTree(delRoot, 6, 30, 16 * 1024))
                 {
@@ -4778,7 +4747,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
 
             if (state.stepState == 0)
             {
-                static_cast<void>(SetPluginConfiguration(
+                static_cast<void>(SelfTest::SetPluginConfiguration(
                     state.infoLocal.get(),
                     R"json({"copyMoveMaxConcurrency":4,"deleteMaxConcurrency":8,"deleteRecycleBinMaxConcurrency":2,"enumerationSoftMaxBufferMiB":512,"enumerationHardMaxBufferMiB":2048})json"));
 
@@ -5660,7 +5629,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
 
             if (state.stepState == 0)
             {
-                static_cast<void>(SetPluginConfiguration(state.infoLocal.get(), R"json({"reparsePointPolicy":"copyReparse"})json"));
+                static_cast<void>(SelfTest::SetPluginConfiguration(state.infoLocal.get(), R"json({"reparsePointPolicy":"copyReparse"})json"));
 
                 if (! RecreateEmptyDirectory(srcDir) || ! RecreateEmptyDirectory(dstDir) || ! RecreateEmptyDirectory(moveSrc) ||
                     ! RecreateEmptyDirectory(moveDst) || ! RecreateEmptyDirectory(delDir) || ! RecreateEmptyDirectory(targetDir))
@@ -5820,7 +5789,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
                     return true;
                 }
 
-                static_cast<void>(SetPluginConfiguration(state.infoLocal.get(), R"json({"reparsePointPolicy":"skip"})json"));
+                static_cast<void>(SelfTest::SetPluginConfiguration(state.infoLocal.get(), R"json({"reparsePointPolicy":"skip"})json"));
 
                 if (! EnsureDummyFolderExists(state.fsDummy.get(), dummyBridgeMoveRoot))
                 {
@@ -5882,7 +5851,7 @@ bool FileOperationsSelfTest::Tick(HWND /*mainWindow*/) noexcept
                     return true;
                 }
 
-                static_cast<void>(SetPluginConfiguration(state.infoLocal.get(), R"json({"reparsePointPolicy":"copyReparse"})json"));
+                static_cast<void>(SelfTest::SetPluginConfiguration(state.infoLocal.get(), R"json({"reparsePointPolicy":"copyReparse"})json"));
 
                 if (! EnsureDummyFolderExists(state.fsDummy.get(), dummyBridgeCopyRoot))
                 {
@@ -8,6 +8,7 @@
 
 #include <bit>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <iterator>
 #include <psapi.h>
@@ -148,6 +149,9 @@ constexpr size_t kDefaultMaxDiagnosticsLogFiles              = 14u;
 constexpr size_t kDefaultMaxDiagnosticsIssueReportFiles      = 60u;
 constexpr ULONGLONG kDefaultDiagnosticsFlushIntervalMs       = 5'000ull;
 constexpr ULONGLONG kDefaultDiagnosticsCleanupIntervalMs     = 15ull * 60ull * 1000ull;
+constexpr unsigned int kDefaultBridgeMaxConcurrentFiles      = 4u;
+constexpr size_t kBridgePipelineDepth                        = 4u;  // read-ahead buffers per bridged file (BufferSize() each)
+constexpr size_t kBridgeMaxQueuedFilesPerLane                = 64u; // listed-but-unstarted files per lane before the walker helps copy
 
 struct DiagnosticsSettings
 {
@@ -289,7 +293,8 @@ void SetAutoDismissSuccessInSettings(Common::Settings::Settings& settings, bool
                                fileOperations.diagnosticsInfoEnabled != defaults.diagnosticsInfoEnabled ||
                                fileOperations.diagnosticsDebugEnabled != defaults.diagnosticsDebugEnabled || fileOperations.maxIssueReportFiles.has_value() ||
                                fileOperations.maxDiagnosticsInMemory.has_value() || fileOperations.maxDiagnosticsPerFlush.has_value() ||
-                               fileOperations.diagnosticsFlushIntervalMs.has_value() || fileOperations.diagnosticsCleanupIntervalMs.has_value();
+                               fileOperations.diagnosticsFlushIntervalMs.has_value() || fileOperations.diagnosticsCleanupIntervalMs.has_value() ||
+                               fileOperations.bridgeMaxConcurrentFiles.has_value();
     if (! hasNonDefault)
     {
         settings.fileOperations.reset();
@@ -317,6 +322,16 @@ void SetAutoDismissSuccessInSettings(Common::Settings::Settings& settings, bool
     return diagnostics;
 }
 
+[[nodiscard]] unsigned int GetBridgeMaxConcurrentFilesFromSettings(const Common::Settings::Settings* settings) noexcept
+{
+    if (! settings || ! settings->fileOperations.has_value())
+    {
+        return kDefaultBridgeMaxConcurrentFiles;
+    }
+
+    return static_cast<unsigned int>(GetPositiveSizeOrDefault(settings->fileOperations->bridgeMaxConcurrentFiles, kDefaultBridgeMaxConcurrentFiles));
+}
+
 [[nodiscard]] const wchar_t* OperationToString(FileSystemOperation operation) noexcept
 {
     switch (operation)
@@ -1736,6 +1751,25 @@ HRESULT STDMETHODCALLTYPE FolderWindow::FileOperationState::Task::FileSystemItem
         }
     }
 
+    if (status == FILESYSTEM_S_COPY_SERVER_SIDE)
+    {
+        LogDiagnostic(DiagnosticSeverity::Info,
+                      status,
+                      L"copy.serverSide",
+                      L"Copied on the server; no data was transferred through this PC.",
+                      sourcePath ? sourcePath : L"",
+                      destinationPath ? destinationPath : L"");
+    }
+    else if (status == FILESYSTEM_S_COPY_RELAYED)
+    {
+        LogDiagnostic(DiagnosticSeverity::Info,
+                      status,
+                      L"copy.relayed",
+                      L"Server-side copy unavailable; data was relayed through this PC.",
+                      sourcePath ? sourcePath : L"",
+                      destinationPath ? destinationPath : L"");
+    }
+
     if (_cancelled.load(std::memory_order_acquire))
     {
         return HRESULT_FROM_WIN32(ERROR_CANCELLED);
@@ -2919,6 +2953,8 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
             return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
         }
 
+        unsigned int bridgeConcurrentFiles = 1u;
+
         _perItemTotalItems     = static_cast<unsigned long>(count64);
         _perItemMaxConcurrency = DeterminePerItemMaxConcurrency(_fileSystem, _operation, _flags, static_cast<unsigned int>(kMaxInFlightFiles));
         _perItemMaxConcurrency = std::max(1u, _perItemMaxConcurrency);
@@ -2929,6 +2965,14 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                 DeterminePerItemMaxConcurrency(_destinationFileSystem, _operation, _flags, static_cast<unsigned int>(kMaxInFlightFiles));
             _perItemMaxConcurrency = std::min(_perItemMaxConcurrency, destinationMaxConcurrency);
             _perItemMaxConcurrency = std::max(1u, _perItemMaxConcurrency);
+
+            // Files inside bridged directories share the task's in-flight budget with the top-level items, and must stay within
+            // what both plugins accept concurrently.
+            const unsigned int pluginMaxConcurrency =
+                std::min(DeterminePerItemMaxConcurrency(_fileSystem, _operation, _flags, static_cast<unsigned int>(kMaxInFlightFiles)),
+                         destinationMaxConcurrency);
+            const unsigned int configuredFiles = GetBridgeMaxConcurrentFilesFromSettings(_folderWindow ? _folderWindow->_settings : nullptr);
+            bridgeConcurrentFiles              = std::max(1u, std::min(configuredFiles, pluginMaxConcurrency) / _perItemMaxConcurrency);
         }
         _perItemCompletedItems      = 0;
         _perItemCompletedEntryCount = 0;
@@ -3289,6 +3333,41 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                 return 50u;
             }
 
+            // Read-ahead ring between a lane's reader thread (producer) and the lane itself (consumer). The lane hands one file
+            // at a time to the reader by setting `reader`; the reader thread clears it once it stopped touching that file.
+            struct PipelineRing
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::array<unsigned long, kBridgePipelineDepth> bytes{};
+                IFileReader* reader = nullptr;
+                size_t depth        = 0;
+                size_t filled       = 0;
+                bool endOfFile      = false;
+                bool abort          = false;
+                bool shutdown       = false;
+                HRESULT readHr      = S_OK;
+            };
+
+            // One lane per concurrently copied file. Lane 0 belongs to the thread that walks the tree; buffers and the reader
+            // thread are created on first use and kept for the lifetime of the bridge, so small files never pay for the
+            // read-ahead ring and large ones never pay for a thread start.
+            struct TransferLane
+            {
+                std::array<std::unique_ptr<std::byte[]>, kBridgePipelineDepth> buffers;
+                size_t allocatedBuffers   = 0;
+                uint64_t progressStreamId = 0;
+                PipelineRing ring;
+                std::jthread readerThread;
+            };
+
+            // A file found by the tree walk, waiting for a free lane. Its destination directory already exists.
+            struct QueuedFile
+            {
+                std::wstring sourcePath;
+                std::wstring destinationPath;
+            };
+
             Task& task;
             IFileSystem& sourceFs;
             IFileSystem& destinationFs;
@@ -3299,20 +3378,37 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
             void* cookie                                      = nullptr;
             DWORD sourceRootAttributesHint                    = 0;
             ReparsePointPolicy reparsePointPolicy             = ReparsePointPolicy::CopyReparse;
+            unsigned int concurrentFiles                      = 1;
 
             // Total bytes is best-effort: if unknown, keep 0.
             uint64_t totalBytes                         = 0;
             uint64_t completedBytes                     = 0;
+            uint64_t inFlightBytes                      = 0;
             unsigned long skippedDirectoryReparseCount  = 0;
             bool rootDirectoryReparseSkipped            = false;
             bool unsupportedDirectoryReparseEncountered = false;
 
-            ULONGLONG startTick = 0;
+            // Guards byte counters, startTick and options (the task updates bandwidthLimitBytesPerSecond from FileSystemProgress).
+            // Never held across task.FileSystemProgress: lanes snapshot under it and report outside it.
+            std::mutex progressMutex;
+            ULONGLONG startTick        = 0;
+            uint64_t reportedCallBytes = 0;
             FileSystemOptions options{};
 
-            std::unique_ptr<std::byte[]> buffer;
+            std::array<TransferLane, Task::kMaxInFlightFiles> lanes;
             unsigned long bufferBytes = 0;
 
+            // Tree-wide file queue: the walking thread enqueues every file of the tree and lanes 1..N-1 (started once per
+            // bridge) drain it, so lanes keep working across directory boundaries. The first failure drops the queued files.
+            std::mutex queueMutex;
+            std::condition_variable queueCv;
+            std::deque<QueuedFile> queuedFiles;
+            size_t busyLanes        = 0;
+            bool stopLanes          = false;
+            HRESULT queueFailure    = S_OK;
+            bool laneWorkersStarted = false;
+            std::vector<std::jthread> laneWorkers;
+
             CrossFileSystemBridge(Task& owner,
                                   IFileSystem& source,
                                   IFileSystem& destination,
@@ -3323,7 +3419,8 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                                   void* cookieIn,
                                   uint64_t totalBytesIn,
                                   DWORD sourceRootAttributesHintIn,
-                                  ReparsePointPolicy reparsePointPolicyIn) noexcept
+                                  ReparsePointPolicy reparsePointPolicyIn,
+                                  unsigned int concurrentFilesIn) noexcept
                 : task(owner),
                   sourceFs(source),
                   destinationFs(destination),
@@ -3334,15 +3431,43 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                   cookie(cookieIn),
                   sourceRootAttributesHint(sourceRootAttributesHintIn),
                   reparsePointPolicy(reparsePointPolicyIn),
+                  concurrentFiles(std::clamp(concurrentFilesIn, 1u, static_cast<unsigned int>(Task::kMaxInFlightFiles))),
                   totalBytes(totalBytesIn)
             {
                 options.bandwidthLimitBytesPerSecond = task._desiredSpeedLimitBytesPerSecond.load(std::memory_order_acquire);
 
-                buffer.reset(new (std::nothrow) std::byte[BufferSize()]);
+                for (size_t i = 0; i < lanes.size(); ++i)
+                {
+                    lanes[i].progressStreamId = static_cast<uint64_t>(i);
+                }
+
                 bufferBytes = BufferSize() > static_cast<size_t>(std::numeric_limits<unsigned long>::max()) ? std::numeric_limits<unsigned long>::max()
                                                                                                             : static_cast<unsigned long>(BufferSize());
             }
 
+            ~CrossFileSystemBridge() noexcept
+            {
+                {
+                    std::scoped_lock lock(queueMutex);
+                    stopLanes = true;
+                }
+                queueCv.notify_all();
+                laneWorkers.clear();
+
+                for (TransferLane& lane : lanes)
+                {
+                    {
+                        std::scoped_lock lock(lane.ring.mutex);
+                        lane.ring.shutdown = true;
+                    }
+                    lane.ring.cv.notify_all();
+                    if (lane.readerThread.joinable())
+                    {
+                        lane.readerThread.join();
+                    }
+                }
+            }
+
             CrossFileSystemBridge(const CrossFileSystemBridge&)            = delete;
             CrossFileSystemBridge(CrossFileSystemBridge&&)                 = delete;
             CrossFileSystemBridge& operator=(const CrossFileSystemBridge&) = delete;
@@ -3353,6 +3478,21 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                 return task._cancelled.load(std::memory_order_acquire) || task._stopToken.stop_requested();
             }
 
+            [[nodiscard]] size_t EnsureLaneBuffers(TransferLane& lane, size_t wanted) noexcept
+            {
+                wanted = (std::min)(wanted, lane.buffers.size());
+                while (lane.allocatedBuffers < wanted)
+                {
+                    lane.buffers[lane.allocatedBuffers].reset(new (std::nothrow) std::byte[BufferSize()]);
+                    if (! lane.buffers[lane.allocatedBuffers])
+                    {
+                        break;
+                    }
+                    ++lane.allocatedBuffers;
+                }
+                return lane.allocatedBuffers;
+            }
+
             void SleepResponsive(DWORD totalMs) noexcept
             {
                 while (totalMs > 0)
@@ -3372,19 +3512,25 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
 
             void Throttle(uint64_t bytesSoFar) noexcept
             {
-                const uint64_t bandwidthLimit = options.bandwidthLimitBytesPerSecond;
-                if (bandwidthLimit == 0)
+                uint64_t bandwidthLimit = 0;
+                ULONGLONG elapsedTicks  = 0;
                 {
-                    return;
-                }
+                    std::scoped_lock lock(progressMutex);
+                    bandwidthLimit = options.bandwidthLimitBytesPerSecond;
+                    if (bandwidthLimit == 0)
+                    {
+                        return;
+                    }
 
-                if (startTick == 0)
-                {
-                    startTick = GetTickCount64();
+                    const ULONGLONG now = GetTickCount64();
+                    if (startTick == 0)
+                    {
+                        startTick = now;
+                    }
+                    elapsedTicks = now - startTick;
                 }
 
-                const ULONGLONG now      = GetTickCount64();
-                const uint64_t elapsedMs = static_cast<uint64_t>(now - startTick);
+                const uint64_t elapsedMs = static_cast<uint64_t>(elapsedTicks);
 
                 constexpr uint64_t maxSafeBytes = std::numeric_limits<uint64_t>::max() / 1000u;
 
@@ -3409,25 +3555,81 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                 }
             }
 
-            HRESULT ReportProgress(const std::wstring& currentSourcePath,
+            [[nodiscard]] static uint64_t SaturatingAdd(uint64_t a, uint64_t b) noexcept
+            {
+                return (a > (std::numeric_limits<uint64_t>::max)() - b) ? (std::numeric_limits<uint64_t>::max)() : (a + b);
+            }
+
+            // Call-level completed bytes: finished files plus the partial bytes of every file still in flight.
+            [[nodiscard]] uint64_t AddInFlightBytes(uint64_t delta) noexcept
+            {
+                std::scoped_lock lock(progressMutex);
+                inFlightBytes = SaturatingAdd(inFlightBytes, delta);
+                return SaturatingAdd(completedBytes, inFlightBytes);
+            }
+
+            [[nodiscard]] uint64_t CallCompletedBytes() noexcept
+            {
+                std::scoped_lock lock(progressMutex);
+                return SaturatingAdd(completedBytes, inFlightBytes);
+            }
+
+            HRESULT RetireFile(uint64_t fileCompletedBytes, bool succeeded) noexcept
+            {
+                std::scoped_lock lock(progressMutex);
+                inFlightBytes -= (std::min)(inFlightBytes, fileCompletedBytes);
+                if (! succeeded)
+                {
+                    return S_OK;
+                }
+
+                if (completedBytes > std::numeric_limits<uint64_t>::max() - fileCompletedBytes)
+                {
+                    return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+                }
+                completedBytes += fileCompletedBytes;
+                return S_OK;
+            }
+
+            HRESULT ReportProgress(const TransferLane& lane,
+                                   const std::wstring& currentSourcePath,
                                    const std::wstring& currentDestinationPath,
                                    uint64_t currentItemTotalBytes,
                                    uint64_t currentItemCompletedBytes,
                                    uint64_t callCompletedBytes) noexcept
             {
-                const uint64_t clampedCallCompleted = (totalBytes > 0) ? (std::min)(totalBytes, callCompletedBytes) : callCompletedBytes;
-                return task.FileSystemProgress(task._operation,
-                                               1,
-                                               0,
-                                               totalBytes,
-                                               clampedCallCompleted,
-                                               currentSourcePath.c_str(),
-                                               currentDestinationPath.c_str(),
-                                               currentItemTotalBytes,
-                                               currentItemCompletedBytes,
-                                               &options,
-                                               0,
-                                               cookie);
+                // Lanes share one cookie, so call-level bytes are kept monotonic here. The callback runs outside progressMutex
+                // (it may wait while paused), on a snapshot of options; a limit the task changes is written back afterwards.
+                uint64_t reportedCompleted = 0;
+                FileSystemOptions laneOptions{};
+                {
+                    std::scoped_lock lock(progressMutex);
+                    const uint64_t clampedCallCompleted = (totalBytes > 0) ? (std::min)(totalBytes, callCompletedBytes) : callCompletedBytes;
+                    reportedCallBytes                   = (std::max)(reportedCallBytes, clampedCallCompleted);
+                    reportedCompleted                   = reportedCallBytes;
+                    laneOptions                         = options;
+                }
+
+                const uint64_t snapshotLimit = laneOptions.bandwidthLimitBytesPerSecond;
+                const HRESULT hr             = task.FileSystemProgress(task._operation,
+                                                                       1,
+                                                                       0,
+                                                                       totalBytes,
+                                                                       reportedCompleted,
+                                                                       currentSourcePath.c_str(),
+                                                                       currentDestinationPath.c_str(),
+                                                                       currentItemTotalBytes,
+                                                                       currentItemCompletedBytes,
+                                                                       &laneOptions,
+                                                                       lane.progressStreamId,
+                                                                       cookie);
+
+                if (laneOptions.bandwidthLimitBytesPerSecond != snapshotLimit)
+                {
+                    std::scoped_lock lock(progressMutex);
+                    options.bandwidthLimitBytesPerSecond = laneOptions.bandwidthLimitBytesPerSecond;
+                }
+                return hr;
             }
 
             HRESULT EnsureDestinationDirectory(const std::wstring& destinationPath) noexcept
@@ -3484,12 +3686,260 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                                    sourcePath,
                                    destinationPath);
 
-                static_cast<void>(ReportProgress(sourcePath, destinationPath, 0, 0, completedBytes));
+                static_cast<void>(ReportProgress(lanes[0], sourcePath, destinationPath, 0, 0, CallCompletedBytes()));
+            }
+
+            HRESULT WriteChunk(const TransferLane& lane,
+                               IFileWriter& writer,
+                               const std::byte* data,
+                               unsigned long bytes,
+                               const std::wstring& sourcePath,
+                               const std::wstring& destinationPath,
+                               uint64_t fileTotalBytes,
+                               uint64_t& fileCompletedBytes) noexcept
+            {
+                size_t offset = 0;
+                while (offset < bytes)
+                {
+                    if (CancelRequested())
+                    {
+                        return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+                    }
+
+                    unsigned long bytesWritten  = 0;
+                    const unsigned long toWrite = static_cast<unsigned long>(bytes - offset);
+                    HRESULT hr                  = writer.Write(data + offset, toWrite, &bytesWritten);
+                    if (FAILED(hr))
+                    {
+                        return hr;
+                    }
+                    if (bytesWritten == 0)
+                    {
+                        return HRESULT_FROM_WIN32(ERROR_WRITE_FAULT);
+                    }
+
+                    offset += bytesWritten;
+
+                    if (fileCompletedBytes > std::numeric_limits<uint64_t>::max() - static_cast<uint64_t>(bytesWritten))
+                    {
+                        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+                    }
+                    fileCompletedBytes += bytesWritten;
+
+                    const uint64_t callCompleted = AddInFlightBytes(bytesWritten);
+                    hr                           = ReportProgress(lane, sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes, callCompleted);
+                    if (FAILED(hr))
+                    {
+                        return hr;
+                    }
+
+                    Throttle(callCompleted);
+                }
+
+                return S_OK;
+            }
+
+            HRESULT PumpSerial(TransferLane& lane,
+                               IFileReader& reader,
+                               IFileWriter& writer,
+                               const std::wstring& sourcePath,
+                               const std::wstring& destinationPath,
+                               uint64_t fileTotalBytes,
+                               uint64_t& fileCompletedBytes) noexcept
+            {
+                for (;;)
+                {
+                    if (CancelRequested())
+                    {
+                        return HRESULT_FROM_WIN32(ERROR_CANCELLED);
+                    }
+
+                    unsigned long bytesRead = 0;
+                    HRESULT hr              = reader.Read(lane.buffers[0].get(), bufferBytes, &bytesRead);
+                    if (FAILED(hr))
+                    {
+                        return hr;
+                    }
+
+                    if (bytesRead == 0)
+                    {
+                        return S_OK;
+                    }
+
+                    hr = WriteChunk(lane, writer, lane.buffers[0].get(), bytesRead, sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes);
+                    if (FAILED(hr))
+                    {
+                        return hr;
+                    }
+                }
+            }
+
+            void ReadAhead(TransferLane& lane, size_t depth, IFileReader& reader) noexcept
+            {
+                PipelineRing& ring = lane.ring;
+                size_t slot        = 0;
+                for (;;)
+                {
+                    {
+                        std::unique_lock lock(ring.mutex);
+                        ring.cv.wait(lock, [&] { return ring.filled < depth || ring.abort; });
+                        if (ring.abort)
+                        {
+                            return;
+                        }
+                    }
+
+                    unsigned long bytesRead = 0;
+                    const HRESULT hr =
+                        CancelRequested() ? HRESULT_FROM_WIN32(ERROR_CANCELLED) : reader.Read(lane.buffers[slot].get(), bufferBytes, &bytesRead);
+
+                    {
+                        std::scoped_lock lock(ring.mutex);
+                        if (FAILED(hr))
+                        {
+                            ring.readHr    = hr;
+                            ring.endOfFile = true;
+                        }
+                        else if (bytesRead == 0)
+                        {
+                            ring.endOfFile = true;
+                        }
+                        else
+                        {
+                            ring.bytes[slot] = bytesRead;
+                            ++ring.filled;
+                        }
+                    }
+                    ring.cv.notify_all();
+
+                    if (FAILED(hr) || bytesRead == 0)
+                    {
+                        return;
+                    }
+
+                    slot = (slot + 1u) % depth;
+                }
+            }
+
+            // Serves every pipelined file of one lane, so a tree of large files costs one reader thread per lane, not per file.
+            void ReaderMain(TransferLane& lane) noexcept
+            {
+                PipelineRing& ring = lane.ring;
+                for (;;)
+                {
+                    IFileReader* reader = nullptr;
+                    size_t depth        = 0;
+                    {
+                        std::unique_lock lock(ring.mutex);
+                        ring.cv.wait(lock, [&] { return ring.reader != nullptr || ring.shutdown; });
+                        if (ring.shutdown)
+                        {
+                            return;
+                        }
+                        reader = ring.reader;
+                        depth  = ring.depth;
+                    }
+
+                    ReadAhead(lane, depth, *reader);
+
+                    {
+                        std::scoped_lock lock(ring.mutex);
+                        ring.reader = nullptr;
+                    }
+                    ring.cv.notify_all();
+                }
+            }
+
+            [[nodiscard]] bool EnsureReaderThread(TransferLane& lane) noexcept
+            {
+                if (lane.readerThread.joinable())
+                {
+                    return true;
+                }
+
+                try
+                {
+                    lane.readerThread = std::jthread([this, &lane]() noexcept { ReaderMain(lane); });
+                }
+                catch (const std::system_error&)
+                {
+                    return false;
+                }
+                return true;
+            }
+
+            // The lane's reader thread fills its ring while this thread drains it into the writer, so source reads overlap
+            // destination writes (and their network round-trips). Progress, throttling and cancel checks stay on the lane.
+            HRESULT PumpPipelined(TransferLane& lane,
+                                  size_t depth,
+                                  IFileReader& reader,
+                                  IFileWriter& writer,
+                                  const std::wstring& sourcePath,
+                                  const std::wstring& destinationPath,
+                                  uint64_t fileTotalBytes,
+                                  uint64_t& fileCompletedBytes) noexcept
+            {
+                if (! EnsureReaderThread(lane))
+                {
+                    return PumpSerial(lane, reader, writer, sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes);
+                }
+
+                PipelineRing& ring = lane.ring;
+                {
+                    std::scoped_lock lock(ring.mutex);
+                    ring.bytes     = {};
+                    ring.depth     = depth;
+                    ring.filled    = 0;
+                    ring.endOfFile = false;
+                    ring.abort     = false;
+                    ring.readHr    = S_OK;
+                    ring.reader    = &reader;
+                }
+                ring.cv.notify_all();
+
+                HRESULT hr  = S_OK;
+                size_t slot = 0;
+                for (;;)
+                {
+                    unsigned long bytes = 0;
+                    {
+                        std::unique_lock lock(ring.mutex);
+                        ring.cv.wait(lock, [&] { return ring.filled > 0 || ring.endOfFile; });
+                        if (ring.filled == 0)
+                        {
+                            hr = ring.readHr;
+                            break;
+                        }
+                        bytes = ring.bytes[slot];
+                    }
+
+                    hr = WriteChunk(lane, writer, lane.buffers[slot].get(), bytes, sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes);
+                    if (FAILED(hr))
+                    {
+                        break;
+                    }
+
+                    {
+                        std::scoped_lock lock(ring.mutex);
+                        --ring.filled;
+                    }
+                    ring.cv.notify_all();
+                    slot = (slot + 1u) % depth;
+                }
+
+                // The reader may still be inside reader.Read; wait until it lets go of the file before the caller releases it.
+                {
+                    std::unique_lock lock(ring.mutex);
+                    ring.abort = true;
+                    ring.cv.notify_all();
+                    ring.cv.wait(lock, [&] { return ring.reader == nullptr; });
+                }
+                return hr;
             }
 
-            HRESULT CopyFile(const std::wstring& sourcePath, const std::wstring& destinationPath) noexcept
+            HRESULT CopyFile(TransferLane& lane, const std::wstring& sourcePath, const std::wstring& destinationPath) noexcept
             {
-                if (! buffer || bufferBytes == 0)
+                if (bufferBytes == 0 || EnsureLaneBuffers(lane, 1u) == 0)
                 {
                     return E_OUTOFMEMORY;
                 }
@@ -3522,9 +3972,12 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
 
                 uint64_t fileTotalBytes = 0;
                 static_cast<void>(reader->GetSize(&fileTotalBytes));
-                if (totalBytes == 0 && fileTotalBytes > 0)
                 {
-                    totalBytes = fileTotalBytes;
+                    std::scoped_lock lock(progressMutex);
+                    if (totalBytes == 0 && fileTotalBytes > 0)
+                    {
+                        totalBytes = fileTotalBytes;
+                    }
                 }
 
                 wil::com_ptr<IFileWriter> writer;
@@ -3535,69 +3988,28 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                 }
 
                 uint64_t fileCompletedBytes = 0;
-                hr                          = ReportProgress(sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes, completedBytes);
+                hr                          = ReportProgress(lane, sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes, CallCompletedBytes());
                 if (FAILED(hr))
                 {
                     return hr;
                 }
 
-                for (;;)
+                // Files that fit in one buffer (the common many-small-files case) gain nothing from read-ahead.
+                const bool wantPipeline = fileTotalBytes == 0 || fileTotalBytes > static_cast<uint64_t>(bufferBytes);
+                const size_t depth      = wantPipeline ? EnsureLaneBuffers(lane, kBridgePipelineDepth) : 1u;
+                if (depth > 1u)
                 {
-                    if (CancelRequested())
-                    {
-                        return HRESULT_FROM_WIN32(ERROR_CANCELLED);
-                    }
-
-                    unsigned long bytesRead = 0;
-                    hr                      = reader->Read(buffer.get(), bufferBytes, &bytesRead);
-                    if (FAILED(hr))
-                    {
-                        return hr;
-                    }
-
-                    if (bytesRead == 0)
-                    {
-                        break;
-                    }
-
-                    size_t offset = 0;
-                    while (offset < bytesRead)
-                    {
-                        if (CancelRequested())
-                        {
-                            return HRESULT_FROM_WIN32(ERROR_CANCELLED);
-                        }
-
-                        unsigned long bytesWritten  = 0;
-                        const unsigned long toWrite = static_cast<unsigned long>(
-                            std::min(static_cast<size_t>(bytesRead - offset), static_cast<size_t>(std::numeric_limits<unsigned long>::max())));
-                        hr = writer->Write(buffer.get() + offset, toWrite, &bytesWritten);
-                        if (FAILED(hr))
-                        {
-                            return hr;
-                        }
-                        if (bytesWritten == 0)
-                        {
-                            return HRESULT_FROM_WIN32(ERROR_WRITE_FAULT);
-                        }
-
-                        offset += bytesWritten;
-
-                        if (fileCompletedBytes > std::numeric_limits<uint64_t>::max() - static_cast<uint64_t>(bytesWritten))
-                        {
-                            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-                        }
-                        fileCompletedBytes += bytesWritten;
-
-                        const uint64_t callCompleted = completedBytes + fileCompletedBytes;
-                        hr                           = ReportProgress(sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes, callCompleted);
-                        if (FAILED(hr))
-                        {
-                            return hr;
-                        }
+                    hr = PumpPipelined(lane, depth, *reader, *writer, sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes);
+                }
+                else
+                {
+                    hr = PumpSerial(lane, *reader, *writer, sourcePath, destinationPath, fileTotalBytes, fileCompletedBytes);
+                }
 
-                        Throttle(callCompleted);
-                    }
+                if (FAILED(hr))
+                {
+                    static_cast<void>(RetireFile(fileCompletedBytes, false));
+                    return hr;
                 }
 
                 if (fileTotalBytes > 0 && fileCompletedBytes >= fileTotalBytes)
@@ -3608,12 +4020,10 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                     constexpr uint64_t kSmallFileCommitIndeterminateThresholdBytes = 1024ull * 1024ull;
                     if (fileTotalBytes <= kSmallFileCommitIndeterminateThresholdBytes)
                     {
-                        const uint64_t callCompleted = (completedBytes > (std::numeric_limits<uint64_t>::max)() - fileCompletedBytes)
-                                                           ? (std::numeric_limits<uint64_t>::max)()
-                                                           : (completedBytes + fileCompletedBytes);
-                        hr                           = ReportProgress(sourcePath, destinationPath, 0, 0, callCompleted);
+                        hr = ReportProgress(lane, sourcePath, destinationPath, 0, 0, CallCompletedBytes());
                         if (FAILED(hr))
                         {
+                            static_cast<void>(RetireFile(fileCompletedBytes, false));
                             return hr;
                         }
                     }
@@ -3622,6 +4032,7 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                 hr = writer->Commit();
                 if (FAILED(hr))
                 {
+                    static_cast<void>(RetireFile(fileCompletedBytes, false));
                     return hr;
                 }
 
@@ -3642,16 +4053,16 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                     }
                 }
 
-                if (completedBytes > std::numeric_limits<uint64_t>::max() - fileCompletedBytes)
+                hr = RetireFile(fileCompletedBytes, true);
+                if (FAILED(hr))
                 {
-                    return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+                    return hr;
                 }
-                completedBytes += fileCompletedBytes;
 
                 const uint64_t finalTotal     = fileTotalBytes > 0 ? fileTotalBytes : fileCompletedBytes;
                 const uint64_t finalCompleted = fileCompletedBytes;
 
-                hr = ReportProgress(sourcePath, destinationPath, finalTotal, finalCompleted, completedBytes);
+                hr = ReportProgress(lane, sourcePath, destinationPath, finalTotal, finalCompleted, CallCompletedBytes());
                 if (FAILED(hr))
                 {
                     return hr;
@@ -3660,6 +4071,179 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                 return S_OK;
             }
 
+            // Records the first failure of a bridged tree and drops the files nobody started yet.
+            void FailQueueLocked(HRESULT hr) noexcept
+            {
+                if (SUCCEEDED(queueFailure))
+                {
+                    queueFailure = hr;
+                }
+                queuedFiles.clear();
+            }
+
+            [[nodiscard]] bool TakeQueuedFileLocked(QueuedFile& file) noexcept
+            {
+                if (queuedFiles.empty())
+                {
+                    return false;
+                }
+
+                file = std::move(queuedFiles.front());
+                queuedFiles.pop_front();
+                ++busyLanes;
+                return true;
+            }
+
+            void CopyQueuedFile(TransferLane& lane, const QueuedFile& file) noexcept
+            {
+                HRESULT hr = S_OK;
+                task.WaitWhilePaused();
+                if (CancelRequested())
+                {
+                    hr = HRESULT_FROM_WIN32(ERROR_CANCELLED);
+                }
+                else
+                {
+                    hr = CopyFile(lane, file.sourcePath, file.destinationPath);
+                }
+
+                {
+                    std::scoped_lock lock(queueMutex);
+                    --busyLanes;
+                    if (FAILED(hr))
+                    {
+                        FailQueueLocked(hr);
+                    }
+                }
+                queueCv.notify_all();
+            }
+
+            void LaneMain(TransferLane& lane) noexcept
+            {
+                for (;;)
+                {
+                    QueuedFile file;
+                    {
+                        std::unique_lock lock(queueMutex);
+                        queueCv.wait(lock, [&] { return stopLanes || ! queuedFiles.empty(); });
+                        if (stopLanes || ! TakeQueuedFileLocked(file))
+                        {
+                            return;
+                        }
+                    }
+
+                    CopyQueuedFile(lane, file);
+                }
+            }
+
+            // Lanes 1..N-1 are started on the first queued file and then serve every directory of the tree until the bridge
+            // is destroyed. When no worker can be started the walking thread copies each file itself.
+            void EnsureLaneWorkers() noexcept
+            {
+                if (laneWorkersStarted)
+                {
+                    return;
+                }
+                laneWorkersStarted = true;
+
+                try
+                {
+                    laneWorkers.reserve(concurrentFiles - 1u);
+                }
+                catch (const std::bad_alloc&)
+                {
+                    return;
+                }
+
+                for (size_t laneIndex = 1; laneIndex < concurrentFiles; ++laneIndex)
+                {
+                    try
+                    {
+                        laneWorkers.emplace_back([this, &lane = lanes[laneIndex]]() noexcept { LaneMain(lane); });
+                    }
+                    catch (const std::system_error&)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            // Hands a file to the lanes. The walking thread keeps listing directories while lanes copy, and steps in on lane 0
+            // whenever the queue runs ahead of the lanes, which also bounds the queue's memory on huge trees.
+            HRESULT EnqueueFile(std::wstring sourcePath, std::wstring destinationPath) noexcept
+            {
+                EnsureLaneWorkers();
+                if (laneWorkers.empty())
+                {
+                    return CopyFile(lanes[0], sourcePath, destinationPath);
+                }
+
+                {
+                    std::scoped_lock lock(queueMutex);
+                    if (FAILED(queueFailure))
+                    {
+                        return queueFailure;
+                    }
+
+                    try
+                    {
+                        queuedFiles.push_back(QueuedFile{std::move(sourcePath), std::move(destinationPath)});
+                    }
+                    catch (const std::bad_alloc&)
+                    {
+                        FailQueueLocked(E_OUTOFMEMORY);
+                        return E_OUTOFMEMORY;
+                    }
+                }
+                queueCv.notify_one();
+
+                for (;;)
+                {
+                    QueuedFile file;
+                    {
+                        std::scoped_lock lock(queueMutex);
+                        if (FAILED(queueFailure))
+                        {
+                            return queueFailure;
+                        }
+                        if (queuedFiles.size() <= kBridgeMaxQueuedFilesPerLane * concurrentFiles || ! TakeQueuedFileLocked(file))
+                        {
+                            return S_OK;
+                        }
+                    }
+
+                    CopyQueuedFile(lanes[0], file);
+                }
+            }
+
+            // Called once the walk is over (or failed): lane 0 helps drain the queue, then waits for files still on other lanes.
+            HRESULT FinishQueuedFiles(HRESULT walkHr) noexcept
+            {
+                if (FAILED(walkHr))
+                {
+                    std::scoped_lock lock(queueMutex);
+                    FailQueueLocked(walkHr);
+                }
+
+                for (;;)
+                {
+                    QueuedFile file;
+                    {
+                        std::scoped_lock lock(queueMutex);
+                        if (! TakeQueuedFileLocked(file))
+                        {
+                            break;
+                        }
+                    }
+
+                    CopyQueuedFile(lanes[0], file);
+                }
+
+                std::unique_lock lock(queueMutex);
+                queueCv.wait(lock, [&] { return busyLanes == 0; });
+                return queueFailure;
+            }
+
             HRESULT CopyDirectory(const std::wstring& sourcePath, const std::wstring& destinationPath) noexcept
             {
                 if (CancelRequested())
@@ -3697,6 +4281,9 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                 std::byte* base = reinterpret_cast<std::byte*>(entry);
                 std::byte* end  = base + bufferSize;
 
+                // Files go to the tree-wide lane queue as they are listed; subdirectories recurse once this listing is released.
+                std::vector<std::pair<std::wstring, std::wstring>> directories;
+
                 for (;;)
                 {
                     task.WaitWhilePaused();
@@ -3711,21 +4298,15 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                     const bool isDot = (name == L"." || name == L"..");
                     if (! name.empty() && ! isDot)
                     {
-                        const bool isDirectory         = (entry->FileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-                        const bool isReparse           = (entry->FileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
-                        const std::wstring childSource = JoinFolderAndLeaf(sourcePath, name);
-                        const std::wstring childDest   = JoinFolderAndLeaf(destinationPath, name);
+                        const bool isDirectory   = (entry->FileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+                        const bool isReparse     = (entry->FileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+                        std::wstring childSource = JoinFolderAndLeaf(sourcePath, name);
+                        std::wstring childDest   = JoinFolderAndLeaf(destinationPath, name);
 
-                        if (isDirectory)
+                        if (isDirectory && isReparse && reparsePointPolicy != ReparsePointPolicy::FollowTargets)
                         {
-                            if (isReparse && reparsePointPolicy != ReparsePointPolicy::FollowTargets)
+                            if (reparsePointPolicy != ReparsePointPolicy::Skip)
                             {
-                                if (reparsePointPolicy == ReparsePointPolicy::Skip)
-                                {
-                                    MarkDirectoryReparseSkipped(childSource, childDest, false);
-                                    continue;
-                                }
-
                                 // copyReparse requires preserving a link; bridge cannot preserve NTFS reparse payloads.
                                 task.LogDiagnostic(FileOperationState::DiagnosticSeverity::Error,
                                                    HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED),
@@ -3736,16 +4317,20 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                                 unsupportedDirectoryReparseEncountered = true;
                                 return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
                             }
-                            hr = CopyDirectory(childSource, childDest);
+
+                            MarkDirectoryReparseSkipped(childSource, childDest, false);
                         }
-                        else
+                        else if (isDirectory)
                         {
-                            hr = CopyFile(childSource, childDest);
+                            directories.emplace_back(std::move(childSource), std::move(childDest));
                         }
-
-                        if (FAILED(hr))
+                        else
                         {
-                            return hr;
+                            hr = EnqueueFile(std::move(childSource), std::move(childDest));
+                            if (FAILED(hr))
+                            {
+                                return hr;
+                            }
                         }
                     }
 
@@ -3768,6 +4353,17 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                     entry = reinterpret_cast<FileInfo*>(next);
                 }
 
+                info.reset();
+
+                for (const auto& [childSource, childDest] : directories)
+                {
+                    hr = CopyDirectory(childSource, childDest);
+                    if (FAILED(hr))
+                    {
+                        return hr;
+                    }
+                }
+
                 return S_OK;
             }
 
@@ -3813,10 +4409,10 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                         unsupportedDirectoryReparseEncountered = true;
                         return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
                     }
-                    return CopyDirectory(sourcePath, destinationPath);
+                    return FinishQueuedFiles(CopyDirectory(sourcePath, destinationPath));
                 }
 
-                return CopyFile(sourcePath, destinationPath);
+                return CopyFile(lanes[0], sourcePath, destinationPath);
             }
         };
 
@@ -3900,7 +4496,8 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                                                          static_cast<void*>(&cookie),
                                                          preCalcBytesForItem,
                                                          (index < _sourcePathAttributesHint.size()) ? _sourcePathAttributesHint[index] : 0,
-                                                         reparsePointPolicy);
+                                                         reparsePointPolicy,
+                                                         bridgeConcurrentFiles);
                             itemHr = bridge.CopyPath(sourceText, destinationItemText);
                         }
                         else
@@ -4348,7 +4945,8 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                                                      static_cast<void*>(&cookie),
                                                      preCalcBytesForItem,
                                                      (index < _sourcePathAttributesHint.size()) ? _sourcePathAttributesHint[index] : 0,
-                                                     reparsePointPolicy);
+                                                     reparsePointPolicy,
+                                                     bridgeConcurrentFiles);
                         itemHr                             = bridge.CopyPath(sourceText, destinationItemText);
                         bridgeSkippedDirectoryReparseCount = bridge.skippedDirectoryReparseCount;
                         bridgeRootDirectoryReparseSkipped  = bridge.rootDirectoryReparseSkipped;
@@ -4379,7 +4977,8 @@ HRESULT FolderWindow::FileOperationState::Task::ExecuteOperation() noexcept
                                                          static_cast<void*>(&cookie),
                                                          preCalcBytesForItem,
                                                          (index < _sourcePathAttributesHint.size()) ? _sourcePathAttributesHint[index] : 0,
-                                                         reparsePointPolicy);
+                                                         reparsePointPolicy,
+                                                         bridgeConcurrentFiles);
                             itemHr                             = bridge.CopyPath(sourceText, destinationItemText);
                             bridgeSkippedDirectoryReparseCount = bridge.skippedDirectoryReparseCount;
                             bridgeRootDirectoryReparseSkipped  = bridge.rootDirectoryReparseSkipped;
@@ -424,12 +424,17 @@ bool FolderWindow::IsFileOperationsIssuesPaneVisible() noexcept
     return _fileOperations->IsIssuesPaneVisible();
 }
 
-#ifdef _DEBUG
-FolderWindow::FileOperationState* FolderWindow::DebugGetFileOperationState() noexcept
+FolderWindow::FileOperationState* FolderWindow::BenchmarkGetFileOperationState() noexcept
 {
     EnsureFileOperations();
     return _fileOperations.get();
 }
+
+#ifdef _DEBUG
+FolderWindow::FileOperationState* FolderWindow::DebugGetFileOperationState() noexcept
+{
+    return BenchmarkGetFileOperationState();
+}
 #endif
 
 bool FolderWindow::ConfirmCancelAllFileOperations(HWND ownerWindow) noexcept
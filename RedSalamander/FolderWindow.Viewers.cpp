@@ -192,6 +192,37 @@ void FolderWindow::CloseAllViewers() noexcept
     ShutdownViewers();
 }
 
+wil::com_ptr<IViewerThumbnail> FolderWindow::ResolveThumbnailProvider(std::wstring_view extension) noexcept
+{
+    if (! _settings || extension.empty())
+    {
+        return nullptr;
+    }
+
+    const auto it = _settings->extensions.openWithViewerByExtension.find(std::wstring(extension));
+    if (it == _settings->extensions.openWithViewerByExtension.end() || it->second.empty())
+    {
+        return nullptr;
+    }
+
+    // Thumbnail decoding is stateless: one (never opened) viewer instance per plugin serves both panes.
+    if (const auto providerIt = _thumbnailProvidersByPluginId.find(it->second); providerIt != _thumbnailProvidersByPluginId.end())
+    {
+        return providerIt->second;
+    }
+
+    wil::com_ptr<IViewer> viewer;
+    wil::com_ptr<IViewerThumbnail> provider;
+    const HRESULT hr = ViewerPluginManager::GetInstance().CreateViewerInstance(it->second, *_settings, viewer);
+    if (SUCCEEDED(hr) && viewer)
+    {
+        static_cast<void>(viewer->QueryInterface(__uuidof(IViewerThumbnail), provider.put_void()));
+    }
+
+    _thumbnailProvidersByPluginId.emplace(it->second, provider);
+    return provider;
+}
+
 bool FolderWindow::TryViewFileWithViewer(Pane pane, const FolderView::ViewFileRequest& request) noexcept
 {
     PaneState& state = pane == Pane::Left ? _leftPane : _rightPane;
@@ -737,6 +737,7 @@ bool FolderWindow::OnCreate(HWND hwnd) noexcept
 
             state.folderView.SetIncrementalSearchChangedCallback([this, pane] { UpdatePaneStatusBar(pane); });
             state.folderView.SetSelectionSizeComputationRequestedCallback([this, pane] { RequestSelectionSizeComputation(pane); });
+            state.folderView.SetThumbnailProviderResolver([this](std::wstring_view extension) { return ResolveThumbnailProvider(extension); });
         }
 
         {
@@ -883,6 +884,7 @@ void FolderWindow::OnDestroy()
     _networkChangeSubscription.reset();
 
     ShutdownViewers();
+    _thumbnailProvidersByPluginId.clear();
     ShutdownFileOperations();
 
     CancelSelectionSizeComputation(Pane::Left);
@@ -11,6 +11,7 @@
 #include <string>
 #include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "AppTheme.h"
@@ -274,6 +275,10 @@ public:
 
     struct FileOperationState;
 
+    // Benchmark hook (--benchmarks runs in every configuration): the file-operations state the bridge cases drive.
+    // Initializes file operations if they are not yet created.
+    FileOperationState* BenchmarkGetFileOperationState() noexcept;
+
 #ifdef _DEBUG
     // Debug/testing hook: access the file-operations state for automation/self-tests.
     // This will initialize file operations if they are not yet created.
@@ -359,6 +364,7 @@ private:
     bool TryOpenFileAsVirtualFileSystem(Pane pane, const std::filesystem::path& path) noexcept;
     bool TryViewFileWithViewer(Pane pane, const FolderView::ViewFileRequest& request) noexcept;
     bool TryViewSpaceWithViewer(Pane pane, const std::filesystem::path& folderPath) noexcept;
+    wil::com_ptr<IViewerThumbnail> ResolveThumbnailProvider(std::wstring_view extension) noexcept;
 
     struct ViewerInstance final
     {
@@ -482,6 +488,7 @@ private:
 
     ViewerCallbackState _viewerCallback;
     std::vector<std::unique_ptr<ViewerInstance>> _viewerInstances;
+    std::unordered_map<std::wstring, wil::com_ptr<IViewerThumbnail>> _thumbnailProvidersByPluginId; // nullptr = plugin has no thumbnails
 
     std::unique_ptr<NetworkChangeSubscription> _networkChangeSubscription;
     uint64_t _lastNetworkConnectivityRefreshTick = 0;
@@ -0,0 +1,763 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <cwctype>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#define WINDOWS_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include <CommCtrl.h>
+#include <CommonControls.h>
+#include <KnownFolders.h>
+#include <ShlObj.h>
+
+#pragma warning(push)
+// WIL: C4625 (copy ctor deleted), C4626 (copy assign deleted), C5026 (move ctor deleted), C5027 (move assign deleted)
+#pragma warning(disable : 4625 4626 5026 5027)
+#include <wil/result.h>
+#pragma warning(pop)
+
+#include <wincodec.h>
+
+#include "Helpers.h"
+#include "IconCache.h"
+
+// Persistent icon pack.
+//
+// Layout (little-endian): PackHeader, PackEntry[entryCount] sorted by keyHash, then UTF-16 keys and 32bpp BGRA pixels
+// (straight alpha, top-down) referenced by offset. The pack is mapped read-only on first lookup and rewritten by
+// SavePersistentCache() with the icons captured this session.
+//
+// Keys: "ext|<normalized extension>" (lastWriteTime 0) and "file|<lowercase full path>" + the file's last write time.
+// Each entry is stored per system image list size (SHIL_*), so a DPI change picks the matching pixels or misses.
+
+namespace
+{
+constexpr wchar_t kCompanyDirName[]   = L"RedSalamander";
+constexpr wchar_t kCacheDirName[]     = L"Cache";
+constexpr wchar_t kPackFileName[]     = L"Icons.pack";
+constexpr wchar_t kPackTempFileName[] = L"Icons.pack.tmp";
+
+constexpr uint32_t kPackMagic       = 0x50495352u; // 'RSIP'
+constexpr uint32_t kPackVersion     = 1u;
+constexpr uint32_t kMaxIconPixels   = 256u;
+constexpr size_t kImageListSizes    = static_cast<size_t>(SHIL_LAST) + 1u;
+constexpr size_t kMaxPackEntries    = 16384u;
+constexpr uint64_t kMaxPackBytes    = 64ull * 1024ull * 1024ull;
+constexpr size_t kMaxPendingKeys    = 16384u;
+constexpr size_t kMaxCapturedPixels = 4096u;
+
+constexpr int64_t kFileTimeTicksPerDay = 24ll * 60ll * 60ll * 10'000'000ll;
+constexpr int64_t kExtensionMaxAgeDays = 14; // File associations can change without notice; refresh extension icons periodically
+constexpr int64_t kFileMaxAgeDays      = 60; // Per-file entries are validated by last write time; age only bounds churn
+
+constexpr std::wstring_view kExtensionKeyPrefix = L"ext|";
+constexpr std::wstring_view kFileKeyPrefix      = L"file|";
+
+struct PackHeader
+{
+    uint32_t magic      = 0;
+    uint32_t version    = 0;
+    uint32_t entryCount = 0;
+    uint32_t reserved   = 0;
+    uint64_t fileSize   = 0;
+};
+static_assert(sizeof(PackHeader) == 24);
+
+struct PackEntry
+{
+    uint64_t keyHash      = 0;
+    int64_t lastWriteTime = 0;
+    int64_t storedTime    = 0; // FILETIME of capture
+    uint32_t keyOffset    = 0;
+    uint32_t keyChars     = 0;
+    uint32_t pixelOffset  = 0;
+    uint16_t width        = 0;
+    uint16_t height       = 0;
+    uint8_t imageListSize = 0; // SHIL_*
+    uint8_t reserved[7]{};
+};
+static_assert(sizeof(PackEntry) == 48);
+
+[[nodiscard]] uint64_t HashPackKey(std::wstring_view key) noexcept
+{
+    // FNV-1a over the UTF-16 code units
+    uint64_t hash = 14695981039346656037ull;
+    for (const wchar_t ch : key)
+    {
+        hash ^= static_cast<uint64_t>(static_cast<uint16_t>(ch));
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+[[nodiscard]] int64_t CurrentFileTime() noexcept
+{
+    FILETIME now{};
+    GetSystemTimeAsFileTime(&now);
+    return static_cast<int64_t>((static_cast<uint64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime);
+}
+
+[[nodiscard]] bool IsPackEntryExpired(std::wstring_view key, int64_t storedTime, int64_t now) noexcept
+{
+    const int64_t maxAgeDays = key.starts_with(kExtensionKeyPrefix) ? kExtensionMaxAgeDays : kFileMaxAgeDays;
+    return storedTime <= 0 || now - storedTime > maxAgeDays * kFileTimeTicksPerDay;
+}
+
+[[nodiscard]] std::wstring MakeFileKey(std::wstring_view fullPath)
+{
+    std::wstring key;
+    key.reserve(kFileKeyPrefix.size() + fullPath.size());
+    key.append(kFileKeyPrefix);
+    for (const wchar_t ch : fullPath)
+    {
+        key.push_back(static_cast<wchar_t>(std::towlower(static_cast<wint_t>(ch))));
+    }
+    return key;
+}
+
+[[nodiscard]] std::wstring MakeSessionKey(std::wstring_view key, int64_t lastWriteTime, int imageListSize)
+{
+    return std::format(L"{}|{}|{}", key, lastWriteTime, imageListSize);
+}
+
+[[nodiscard]] std::filesystem::path GetIconPackDirectory() noexcept
+{
+    wil::unique_cotaskmem_string localAppData;
+    const HRESULT hr = SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, localAppData.put());
+    if (FAILED(hr) || ! localAppData)
+    {
+        return {};
+    }
+
+    return std::filesystem::path(localAppData.get()) / kCompanyDirName / kCacheDirName;
+}
+
+[[nodiscard]] wil::unique_hicon CreateIconFromBgra(uint32_t width, uint32_t height, const uint8_t* pixels) noexcept
+{
+    BITMAPINFO bmi{};
+    bmi.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth       = static_cast<LONG>(width);
+    bmi.bmiHeader.biHeight      = -static_cast<LONG>(height); // Top-down
+    bmi.bmiHeader.biPlanes      = 1;
+    bmi.bmiHeader.biBitCount    = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    wil::unique_hbitmap color(CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0));
+    if (! color || ! bits)
+    {
+        return {};
+    }
+    std::memcpy(bits, pixels, static_cast<size_t>(width) * static_cast<size_t>(height) * 4u);
+    GdiFlush();
+
+    // All-zero mask: the alpha channel of the 32bpp color bitmap drives transparency.
+    const size_t maskStride = ((static_cast<size_t>(width) + 15u) / 16u) * 2u;
+    std::vector<uint8_t> maskBits(maskStride * height, 0);
+    wil::unique_hbitmap mask(CreateBitmap(static_cast<int>(width), static_cast<int>(height), 1, 1, maskBits.data()));
+    if (! mask)
+    {
+        return {};
+    }
+
+    ICONINFO iconInfo{};
+    iconInfo.fIcon    = TRUE;
+    iconInfo.hbmMask  = mask.get();
+    iconInfo.hbmColor = color.get();
+    return wil::unique_hicon(CreateIconIndirect(&iconInfo));
+}
+} // namespace
+
+struct IconCache::PersistentStore
+{
+    struct Pixels
+    {
+        uint32_t width  = 0;
+        uint32_t height = 0;
+        std::shared_ptr<const std::vector<uint8_t>> bgra;
+    };
+
+    struct PendingKey
+    {
+        std::wstring key;
+        int64_t lastWriteTime = 0;
+        int imageListSize     = 0;
+    };
+
+    struct NewEntry
+    {
+        std::wstring key;
+        int64_t lastWriteTime = 0;
+        int64_t storedTime    = 0;
+        int imageListSize     = 0;
+        Pixels pixels;
+    };
+
+    // Persistent icon index - kPersistentIconIndexBase; pack entry per image list size (index + 1, 0 = none)
+    struct IconRef
+    {
+        std::array<uint32_t, kImageListSizes> entryPlusOne{};
+    };
+
+    std::mutex mutex;
+    bool loaded = false; // Mapping attempted
+    bool closed = false; // SavePersistentCache ran: lookups miss and persistent icons are unavailable
+
+    wil::unique_handle mapping;
+    wil::unique_mapview_ptr<uint8_t> view;
+    size_t viewSize = 0;
+    std::span<const PackEntry> entries;
+
+    std::vector<IconRef> icons;
+    std::unordered_map<std::wstring, int> iconIndexByKey; // key|lastWriteTime -> persistent icon index
+
+    std::unordered_map<int, std::vector<PendingKey>> pendingKeysByIconIndex;
+    size_t pendingKeyCount = 0;
+    std::unordered_map<uint64_t, Pixels> capturedPixels; // (iconIndex << 8 | imageListSize) -> pixels
+    std::unordered_map<std::wstring, NewEntry> newEntries; // Session key -> entry
+
+    size_t hits   = 0;
+    size_t misses = 0;
+
+    [[nodiscard]] std::wstring_view EntryKey(const PackEntry& entry) const noexcept
+    {
+        return {reinterpret_cast<const wchar_t*>(view.get() + entry.keyOffset), entry.keyChars};
+    }
+
+    [[nodiscard]] const uint8_t* EntryPixels(const PackEntry& entry) const noexcept
+    {
+        return view.get() + entry.pixelOffset;
+    }
+
+    void EnsureLoaded() noexcept;
+    void Unmap() noexcept;
+    [[nodiscard]] std::optional<uint32_t> Find(std::wstring_view key, int64_t lastWriteTime, int imageListSize, int64_t now) const noexcept;
+};
+
+void IconCache::PersistentStore::EnsureLoaded() noexcept
+{
+    // Must be called with mutex locked
+    if (loaded || closed)
+    {
+        return;
+    }
+    loaded = true;
+
+    const std::filesystem::path directory = GetIconPackDirectory();
+    if (directory.empty())
+    {
+        return;
+    }
+
+    const std::filesystem::path packPath = directory / kPackFileName;
+    wil::unique_hfile file(
+        CreateFileW(packPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+    if (! file)
+    {
+        return;
+    }
+
+    LARGE_INTEGER size{};
+    if (! GetFileSizeEx(file.get(), &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(PackHeader)) ||
+        static_cast<uint64_t>(size.QuadPart) > kMaxPackBytes * 2u)
+    {
+        return;
+    }
+
+    wil::unique_handle fileMapping(CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+    if (! fileMapping)
+    {
+        Debug::Warning(L"IconCache: CreateFileMappingW failed for icon pack: {}", GetLastError());
+        return;
+    }
+
+    wil::unique_mapview_ptr<uint8_t> fileView(static_cast<uint8_t*>(MapViewOfFile(fileMapping.get(), FILE_MAP_READ, 0, 0, 0)));
+    if (! fileView)
+    {
+        Debug::Warning(L"IconCache: MapViewOfFile failed for icon pack: {}", GetLastError());
+        return;
+    }
+
+    const size_t fileSize = static_cast<size_t>(size.QuadPart);
+    PackHeader header{};
+    std::memcpy(&header, fileView.get(), sizeof(header));
+    const uint64_t tableBytes = static_cast<uint64_t>(header.entryCount) * sizeof(PackEntry);
+    if (header.magic != kPackMagic || header.version != kPackVersion || header.fileSize != fileSize || sizeof(PackHeader) + tableBytes > fileSize)
+    {
+        Debug::Warning(L"IconCache: Ignoring icon pack with unexpected header (version {}, {} entries)", header.version, header.entryCount);
+        return;
+    }
+
+    const std::span<const PackEntry> table(reinterpret_cast<const PackEntry*>(fileView.get() + sizeof(PackHeader)), header.entryCount);
+    for (const PackEntry& entry : table)
+    {
+        const uint64_t keyEnd   = static_cast<uint64_t>(entry.keyOffset) + static_cast<uint64_t>(entry.keyChars) * sizeof(wchar_t);
+        const uint64_t pixelEnd = static_cast<uint64_t>(entry.pixelOffset) + static_cast<uint64_t>(entry.width) * entry.height * 4u;
+        if ((entry.keyOffset % sizeof(wchar_t)) != 0 || keyEnd > fileSize || pixelEnd > fileSize || entry.width == 0 || entry.height == 0 ||
+            entry.width > kMaxIconPixels || entry.height > kMaxIconPixels || entry.imageListSize >= kImageListSizes)
+        {
+            Debug::Warning(L"IconCache: Ignoring corrupt icon pack ({} entries)", header.entryCount);
+            return;
+        }
+    }
+
+    if (! std::is_sorted(table.begin(), table.end(), [](const PackEntry& a, const PackEntry& b) { return a.keyHash < b.keyHash; }))
+    {
+        Debug::Warning(L"IconCache: Ignoring unsorted icon pack ({} entries)", header.entryCount);
+        return;
+    }
+
+    mapping  = std::move(fileMapping);
+    view     = std::move(fileView);
+    viewSize = fileSize;
+    entries  = table;
+
+    DBGOUT_INFO(L"IconCache: Mapped icon pack ({} entries, {} KB)", entries.size(), fileSize / 1024u);
+}
+
+void IconCache::PersistentStore::Unmap() noexcept
+{
+    // Must be called with mutex locked
+    entries = {};
+    view.reset();
+    mapping.reset();
+    viewSize = 0;
+    icons.clear();
+    iconIndexByKey.clear();
+}
+
+std::optional<uint32_t> IconCache::PersistentStore::Find(std::wstring_view key, int64_t lastWriteTime, int imageListSize, int64_t now) const noexcept
+{
+    // Must be called with mutex locked
+    const uint64_t hash = HashPackKey(key);
+    const auto first = std::lower_bound(entries.begin(), entries.end(), hash, [](const PackEntry& entry, uint64_t value) { return entry.keyHash < value; });
+    for (auto it = first; it != entries.end() && it->keyHash == hash; ++it)
+    {
+        if (it->lastWriteTime == lastWriteTime && it->imageListSize == imageListSize && EntryKey(*it) == key && ! IsPackEntryExpired(key, it->storedTime, now))
+        {
+            return static_cast<uint32_t>(it - entries.begin());
+        }
+    }
+    return std::nullopt;
+}
+
+IconCache::IconCache() : _persistentStore(std::make_unique<PersistentStore>())
+{
+}
+
+IconCache::~IconCache() = default;
+
+std::wstring IconCache::MakePersistentExtensionKey(std::wstring_view normalizedExtension)
+{
+    std::wstring key(kExtensionKeyPrefix);
+    key.append(normalizedExtension);
+    return key;
+}
+
+std::optional<int> IconCache::TryGetPersistentIconIndex(const std::wstring& key, int64_t lastWriteTime, float targetDipSize)
+{
+    const int imageListSize = SelectOptimalImageListSize(targetDipSize);
+
+    PersistentStore& store = *_persistentStore;
+    std::lock_guard lock(store.mutex);
+    store.EnsureLoaded();
+
+    const auto entryIndex = store.entries.empty() ? std::nullopt : store.Find(key, lastWriteTime, imageListSize, CurrentFileTime());
+    if (! entryIndex.has_value())
+    {
+        ++store.misses;
+        return std::nullopt;
+    }
+    ++store.hits;
+
+    // One persistent icon index per key, shared by all image list sizes found for it this session
+    std::wstring refKey = std::format(L"{}|{}", key, lastWriteTime);
+    auto it             = store.iconIndexByKey.find(refKey);
+    if (it == store.iconIndexByKey.end())
+    {
+        const int iconIndex = kPersistentIconIndexBase + static_cast<int>(store.icons.size());
+        store.icons.emplace_back();
+        it = store.iconIndexByKey.emplace(std::move(refKey), iconIndex).first;
+    }
+
+    store.icons[static_cast<size_t>(it->second - kPersistentIconIndexBase)].entryPlusOne[static_cast<size_t>(imageListSize)] = entryIndex.value() + 1u;
+    return it->second;
+}
+
+std::optional<int> IconCache::TryGetPersistentFileIconIndex(std::wstring_view fullPath, int64_t lastWriteTime, float targetDipSize)
+{
+    if (fullPath.empty() || lastWriteTime == 0)
+    {
+        return std::nullopt;
+    }
+
+    return TryGetPersistentIconIndex(MakeFileKey(fullPath), lastWriteTime, targetDipSize);
+}
+
+std::optional<int> IconCache::QuerySysIconIndexForFile(const std::wstring& fullPath, int64_t lastWriteTime, float targetDipSize)
+{
+    const auto iconIndex = QuerySysIconIndexForPath(fullPath.c_str(), 0, false);
+    if (iconIndex.has_value() && lastWriteTime != 0)
+    {
+        RememberPersistentKey(iconIndex.value(), MakeFileKey(fullPath), lastWriteTime, targetDipSize);
+    }
+    return iconIndex;
+}
+
+void IconCache::RememberPersistentKey(int iconIndex, std::wstring key, int64_t lastWriteTime, float targetDipSize)
+{
+    if (iconIndex < 0 || iconIndex >= kPersistentIconIndexBase || key.empty())
+    {
+        return;
+    }
+
+    const int imageListSize = SelectOptimalImageListSize(targetDipSize);
+
+    PersistentStore& store = *_persistentStore;
+    std::lock_guard lock(store.mutex);
+    if (store.closed)
+    {
+        return;
+    }
+
+    std::wstring sessionKey = MakeSessionKey(key, lastWriteTime, imageListSize);
+    if (store.newEntries.find(sessionKey) != store.newEntries.end())
+    {
+        return;
+    }
+
+    // Already extracted this session (e.g. the D2D bitmap is cached and will not be extracted again): write it right away.
+    const uint64_t pixelsKey = (static_cast<uint64_t>(iconIndex) << 8) | static_cast<uint64_t>(imageListSize);
+    if (const auto captured = store.capturedPixels.find(pixelsKey); captured != store.capturedPixels.end())
+    {
+        PersistentStore::NewEntry entry;
+        entry.key           = std::move(key);
+        entry.lastWriteTime = lastWriteTime;
+        entry.storedTime    = CurrentFileTime();
+        entry.imageListSize = imageListSize;
+        entry.pixels        = captured->second;
+        store.newEntries.emplace(std::move(sessionKey), std::move(entry));
+        return;
+    }
+
+    if (store.pendingKeyCount >= kMaxPendingKeys)
+    {
+        return;
+    }
+
+    store.pendingKeysByIconIndex[iconIndex].push_back(PersistentStore::PendingKey{std::move(key), lastWriteTime, imageListSize});
+    ++store.pendingKeyCount;
+}
+
+void IconCache::CapturePersistentIcon(int iconIndex, float targetDipSize, HICON icon)
+{
+    if (! icon || ! _wicFactory)
+    {
+        return;
+    }
+
+    const int imageListSize  = SelectOptimalImageListSize(targetDipSize);
+    const uint64_t pixelsKey = (static_cast<uint64_t>(iconIndex) << 8) | static_cast<uint64_t>(imageListSize);
+
+    PersistentStore& store = *_persistentStore;
+    {
+        std::lock_guard lock(store.mutex);
+        if (store.closed || store.capturedPixels.find(pixelsKey) != store.capturedPixels.end() || store.capturedPixels.size() >= kMaxCapturedPixels)
+        {
+            return;
+        }
+    }
+
+    // Read straight-alpha BGRA pixels outside the lock (WIC factory is thread-safe)
+    wil::com_ptr<IWICBitmap> wicBitmap;
+    HRESULT hr = _wicFactory->CreateBitmapFromHICON(icon, wicBitmap.put());
+    if (FAILED(hr))
+    {
+        return;
+    }
+
+    UINT width  = 0;
+    UINT height = 0;
+    if (FAILED(wicBitmap->GetSize(&width, &height)) || width == 0 || height == 0 || width > kMaxIconPixels || height > kMaxIconPixels)
+    {
+        return;
+    }
+
+    wil::com_ptr<IWICFormatConverter> converter;
+    hr = _wicFactory->CreateFormatConverter(converter.put());
+    if (SUCCEEDED(hr))
+    {
+        hr = converter->Initialize(wicBitmap.get(), GUID_WICPixelFormat32bppBGRA, WICBitmapDitherTypeNone, nullptr, 0.0f, WICBitmapPaletteTypeCustom);
+    }
+
+    auto bgra        = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(width) * height * 4u);
+    const UINT stride = width * 4u;
+    if (SUCCEEDED(hr))
+    {
+        hr = converter->CopyPixels(nullptr, stride, static_cast<UINT>(bgra->size()), bgra->data());
+    }
+    if (FAILED(hr))
+    {
+        Debug::Warning(L"IconCache: Failed to read icon {} pixels for the icon pack: 0x{:08X}", iconIndex, hr);
+        return;
+    }
+
+    PersistentStore::Pixels pixels;
+    pixels.width  = width;
+    pixels.height = height;
+    pixels.bgra   = std::move(bgra);
+
+    std::lock_guard lock(store.mutex);
+    if (store.closed)
+    {
+        return;
+    }
+
+    store.capturedPixels.emplace(pixelsKey, pixels);
+
+    const auto pendingIt = store.pendingKeysByIconIndex.find(iconIndex);
+    if (pendingIt == store.pendingKeysByIconIndex.end())
+    {
+        return;
+    }
+
+    const int64_t now = CurrentFileTime();
+    auto& pending     = pendingIt->second;
+    for (auto it = pending.begin(); it != pending.end();)
+    {
+        if (it->imageListSize != imageListSize)
+        {
+            ++it;
+            continue;
+        }
+
+        PersistentStore::NewEntry entry;
+        entry.key           = std::move(it->key);
+        entry.lastWriteTime = it->lastWriteTime;
+        entry.storedTime    = now;
+        entry.imageListSize = imageListSize;
+        entry.pixels        = pixels;
+        store.newEntries.insert_or_assign(MakeSessionKey(entry.key, entry.lastWriteTime, imageListSize), std::move(entry));
+
+        it = pending.erase(it);
+        --store.pendingKeyCount;
+    }
+
+    if (pending.empty())
+    {
+        store.pendingKeysByIconIndex.erase(pendingIt);
+    }
+}
+
+wil::unique_hicon IconCache::CreatePersistentIcon(int iconIndex, float targetDipSize)
+{
+    const int imageListSize = SelectOptimalImageListSize(targetDipSize);
+
+    PersistentStore& store = *_persistentStore;
+    std::lock_guard lock(store.mutex);
+    const size_t slot = static_cast<size_t>(iconIndex - kPersistentIconIndexBase);
+    if (store.closed || slot >= store.icons.size())
+    {
+        return {};
+    }
+
+    // Prefer the requested image list size; otherwise any size found for this key (D2D scales it to the icon rect).
+    const auto& entryPlusOne = store.icons[slot].entryPlusOne;
+    uint32_t entryIndex      = entryPlusOne[static_cast<size_t>(imageListSize)];
+    if (entryIndex == 0)
+    {
+        const auto any = std::find_if(entryPlusOne.begin(), entryPlusOne.end(), [](uint32_t value) { return value != 0; });
+        entryIndex     = any != entryPlusOne.end() ? *any : 0;
+    }
+    if (entryIndex == 0 || entryIndex > store.entries.size())
+    {
+        return {};
+    }
+
+    const PackEntry& entry = store.entries[entryIndex - 1u];
+    return CreateIconFromBgra(entry.width, entry.height, store.EntryPixels(entry));
+}
+
+void IconCache::FillPersistentStats(Stats& stats) const
+{
+    PersistentStore& store = *_persistentStore;
+    std::lock_guard lock(store.mutex);
+    stats.persistentEntries  = store.entries.size();
+    stats.persistentHits     = store.hits;
+    stats.persistentMisses   = store.misses;
+    stats.persistentCaptured = store.newEntries.size();
+}
+
+void IconCache::SavePersistentCache() noexcept
+{
+    Debug::Perf::Scope perf(L"IconCache.SavePersistentCache");
+
+    PersistentStore& store = *_persistentStore;
+    std::lock_guard lock(store.mutex);
+    if (store.closed)
+    {
+        return;
+    }
+    store.closed = true;
+
+    const int64_t now = CurrentFileTime();
+
+    struct OutEntry
+    {
+        std::wstring_view key;
+        int64_t lastWriteTime = 0;
+        int64_t storedTime    = 0;
+        int imageListSize     = 0;
+        uint32_t width        = 0;
+        uint32_t height       = 0;
+        const uint8_t* pixels = nullptr;
+    };
+
+    // New captures first, then still-valid mapped entries they do not supersede.
+    std::vector<OutEntry> out;
+    out.reserve(store.newEntries.size() + store.entries.size());
+    for (const auto& [sessionKey, entry] : store.newEntries)
+    {
+        static_cast<void>(sessionKey);
+        const PersistentStore::Pixels& pixels = entry.pixels;
+        out.push_back(OutEntry{entry.key, entry.lastWriteTime, entry.storedTime, entry.imageListSize, pixels.width, pixels.height, pixels.bgra->data()});
+    }
+
+    size_t dropped = 0;
+    for (const PackEntry& entry : store.entries)
+    {
+        const std::wstring_view key = store.EntryKey(entry);
+        if (IsPackEntryExpired(key, entry.storedTime, now) ||
+            store.newEntries.find(MakeSessionKey(key, entry.lastWriteTime, entry.imageListSize)) != store.newEntries.end())
+        {
+            ++dropped;
+            continue;
+        }
+        out.push_back(OutEntry{key, entry.lastWriteTime, entry.storedTime, entry.imageListSize, entry.width, entry.height, store.EntryPixels(entry)});
+    }
+
+    if (store.newEntries.empty() && dropped == 0)
+    {
+        store.Unmap();
+        return;
+    }
+
+    // Bound the pack: keep the most recently captured entries.
+    std::sort(out.begin(), out.end(), [](const OutEntry& a, const OutEntry& b) { return a.storedTime > b.storedTime; });
+    uint64_t totalBytes = sizeof(PackHeader);
+    size_t keep         = 0;
+    for (; keep < out.size() && keep < kMaxPackEntries; ++keep)
+    {
+        const uint64_t entryBytes = sizeof(PackEntry) + out[keep].key.size() * sizeof(wchar_t) + static_cast<uint64_t>(out[keep].width) * out[keep].height * 4u;
+        if (totalBytes + entryBytes > kMaxPackBytes)
+        {
+            break;
+        }
+        totalBytes += entryBytes;
+    }
+    out.resize(keep);
+
+    std::vector<std::pair<uint64_t, size_t>> order;
+    order.reserve(out.size());
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        order.emplace_back(HashPackKey(out[i].key), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<uint8_t> buffer(static_cast<size_t>(totalBytes));
+    PackHeader header{};
+    header.magic      = kPackMagic;
+    header.version    = kPackVersion;
+    header.entryCount = static_cast<uint32_t>(out.size());
+    header.fileSize   = totalBytes;
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    size_t tableOffset = sizeof(PackHeader);
+    size_t dataOffset  = sizeof(PackHeader) + out.size() * sizeof(PackEntry);
+    for (const auto& [hash, index] : order)
+    {
+        const OutEntry& source = out[index];
+
+        PackEntry entry{};
+        entry.keyHash       = hash;
+        entry.lastWriteTime = source.lastWriteTime;
+        entry.storedTime    = source.storedTime;
+        entry.keyOffset     = static_cast<uint32_t>(dataOffset);
+        entry.keyChars      = static_cast<uint32_t>(source.key.size());
+        entry.width         = static_cast<uint16_t>(source.width);
+        entry.height        = static_cast<uint16_t>(source.height);
+        entry.imageListSize = static_cast<uint8_t>(source.imageListSize);
+
+        std::memcpy(buffer.data() + dataOffset, source.key.data(), source.key.size() * sizeof(wchar_t));
+        dataOffset += source.key.size() * sizeof(wchar_t);
+
+        const size_t pixelBytes = static_cast<size_t>(source.width) * source.height * 4u;
+        entry.pixelOffset       = static_cast<uint32_t>(dataOffset);
+        std::memcpy(buffer.data() + dataOffset, source.pixels, pixelBytes);
+        dataOffset += pixelBytes;
+
+        std::memcpy(buffer.data() + tableOffset, &entry, sizeof(entry));
+        tableOffset += sizeof(entry);
+    }
+
+    // The pack is still mapped (and pixels above were read from it); release it before replacing the file.
+    store.Unmap();
+    store.newEntries.clear();
+    store.capturedPixels.clear();
+    store.pendingKeysByIconIndex.clear();
+
+    const std::filesystem::path directory = GetIconPackDirectory();
+    if (directory.empty())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    const std::filesystem::path tempPath = directory / kPackTempFileName;
+    const std::filesystem::path packPath = directory / kPackFileName;
+    {
+        wil::unique_hfile file(CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (! file)
+        {
+            Debug::Warning(L"IconCache: Failed to create '{}': {}", tempPath.c_str(), GetLastError());
+            return;
+        }
+
+        size_t written = 0;
+        while (written < buffer.size())
+        {
+            const DWORD chunk = static_cast<DWORD>(std::min<size_t>(buffer.size() - written, 16u * 1024u * 1024u));
+            DWORD chunkWritten = 0;
+            if (! WriteFile(file.get(), buffer.data() + written, chunk, &chunkWritten, nullptr) || chunkWritten != chunk)
+            {
+                Debug::Warning(L"IconCache: Failed to write '{}': {}", tempPath.c_str(), GetLastError());
+                file.reset();
+                DeleteFileW(tempPath.c_str());
+                return;
+            }
+            written += chunkWritten;
+        }
+    }
+
+    if (! MoveFileExW(tempPath.c_str(), packPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        Debug::Warning(L"IconCache: Failed to replace '{}': {}", packPath.c_str(), GetLastError());
+        DeleteFileW(tempPath.c_str());
+        return;
+    }
+
+    perf.SetValue0(out.size());
+    perf.SetValue1(totalBytes);
+    DBGOUT_INFO(L"IconCache: Saved icon pack ({} entries, {} KB, {} dropped)", out.size(), totalBytes / 1024u, dropped);
+}
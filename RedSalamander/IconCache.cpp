@@ -1,4 +1,6 @@
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include <cwctype>
@@ -28,6 +30,8 @@
 namespace
 {
 constexpr std::wstring_view kDirectoryExtensionKey = L"<directory>";
+constexpr uint32_t kAtlasPageSizePx                = 1024u; // 4 MB per page; 3600 cells at 16px, 441 at 48px, 9 at 256px
+constexpr uint32_t kAtlasGutterPx                  = 1u;
 constexpr std::wstring_view kWslLocalhostPrefix    = L"\\\\wsl.localhost\\";
 constexpr std::wstring_view kWslDollarPrefix       = L"\\\\wsl$\\";
 
@@ -120,6 +124,12 @@ void IconCache::Initialize(ID2D1DeviceContext* d2dContext, float dpi)
     std::lock_guard lock(_mutex);
     _dpi.store(dpi, std::memory_order_relaxed);
 
+    // REDSALAMANDER_ICON_SPRITEBATCH=0 forces one DrawBitmap per icon, so frame times can be compared against the sprite batch path.
+    wchar_t spriteBatchSetting[4]{};
+    const DWORD spriteBatchSettingLength =
+        GetEnvironmentVariableW(L"REDSALAMANDER_ICON_SPRITEBATCH", spriteBatchSetting, static_cast<DWORD>(std::size(spriteBatchSetting)));
+    _spriteBatchEnabled = ! (spriteBatchSettingLength == 1 && spriteBatchSetting[0] == L'0');
+
     // Initialize WIC factory for high-quality icon conversion
     wil::com_ptr<IWICImagingFactory> wicFactory;
     HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory2, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&wicFactory));
@@ -277,6 +287,10 @@ wil::com_ptr<ID2D1Bitmap1> IconCache::GetIconBitmap(int iconIndex, ID2D1DeviceCo
             cache.device = device;
         }
         EvictLRUIfNeeded(cache);
+        if (const auto existing = cache.bitmaps.find(iconIndex); existing != cache.bitmaps.end())
+        {
+            ReleaseAtlasSlot(cache, existing->second.slot);
+        }
         CacheEntry entry;
         entry.bitmap             = bitmap;
         entry.lastAccessTime     = ++cache.accessCounter;
@@ -333,6 +347,300 @@ wil::com_ptr<ID2D1Bitmap1> IconCache::GetCachedBitmap(int iconIndex, ID2D1Device
     return nullptr;
 }
 
+IconCache::AtlasSlot IconCache::GetAtlasSlot(int iconIndex, ID2D1DeviceContext* d2dContext)
+{
+    if (iconIndex < 0 || ! d2dContext)
+    {
+        return {};
+    }
+
+    wil::com_ptr<ID2D1Device> device;
+    d2dContext->GetDevice(device.put());
+    if (! device)
+    {
+        return {};
+    }
+
+    std::lock_guard lock(_mutex);
+    const auto deviceIt = _deviceCaches.find(device.get());
+    if (deviceIt == _deviceCaches.end())
+    {
+        return {};
+    }
+
+    auto& cache   = deviceIt->second;
+    const auto it = cache.bitmaps.find(iconIndex);
+    if (it == cache.bitmaps.end())
+    {
+        return {};
+    }
+
+    it->second.lastAccessTime = ++cache.accessCounter;
+    if (! it->second.slot.IsValid())
+    {
+        it->second.slot = AllocateAtlasSlot(cache, it->second, d2dContext);
+    }
+    return it->second.slot;
+}
+
+IconCache::AtlasSlot IconCache::AllocateAtlasSlot(DeviceCache& cache, const CacheEntry& entry, ID2D1DeviceContext* d2dContext)
+{
+    // Must be called with _mutex locked
+    if (! entry.bitmap)
+    {
+        return {};
+    }
+
+    const D2D1_SIZE_U iconSize = entry.bitmap->GetPixelSize();
+    if (iconSize.width == 0 || iconSize.height == 0 || iconSize.width + kAtlasGutterPx > kAtlasPageSizePx ||
+        iconSize.height + kAtlasGutterPx > kAtlasPageSizePx)
+    {
+        return {};
+    }
+
+    size_t pageIndex = cache.atlasPages.size();
+    for (size_t i = 0; i < cache.atlasPages.size(); ++i)
+    {
+        const AtlasPage& candidate = cache.atlasPages[i];
+        if (candidate.iconWidth == iconSize.width && candidate.iconHeight == iconSize.height && ! candidate.freeCells.empty())
+        {
+            pageIndex = i;
+            break;
+        }
+    }
+
+    const uint32_t cellWidth  = iconSize.width + kAtlasGutterPx;
+    const uint32_t cellHeight = iconSize.height + kAtlasGutterPx;
+
+    if (pageIndex == cache.atlasPages.size())
+    {
+        if (cache.atlasPages.size() > std::numeric_limits<uint16_t>::max())
+        {
+            return {};
+        }
+
+        const uint32_t columns   = kAtlasPageSizePx / cellWidth;
+        const uint32_t rows      = kAtlasPageSizePx / cellHeight;
+        const uint32_t cellCount = std::min<uint32_t>(columns * rows, std::numeric_limits<uint16_t>::max() + 1u);
+
+        // Pages are 96 DPI so DrawBitmap source rectangles (DIPs of the bitmap) match the pixel rectangles used by sprite batches.
+        D2D1_BITMAP_PROPERTIES1 pageProps{};
+        pageProps.pixelFormat.format    = DXGI_FORMAT_B8G8R8A8_UNORM;
+        pageProps.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+        pageProps.dpiX                  = 96.0f;
+        pageProps.dpiY                  = 96.0f;
+        pageProps.bitmapOptions         = D2D1_BITMAP_OPTIONS_NONE;
+
+        wil::com_ptr<ID2D1Bitmap1> pageBitmap;
+        const HRESULT hr = d2dContext->CreateBitmap(D2D1::SizeU(columns * cellWidth, rows * cellHeight), nullptr, 0, &pageProps, pageBitmap.put());
+        if (FAILED(hr))
+        {
+            Debug::Warning(L"IconCache: Failed to create {}x{} icon atlas page: 0x{:08X}", iconSize.width, iconSize.height, hr);
+            return {};
+        }
+
+        AtlasPage page;
+        page.bitmap     = std::move(pageBitmap);
+        page.iconWidth  = iconSize.width;
+        page.iconHeight = iconSize.height;
+        page.columns    = columns;
+        page.generations.assign(cellCount, 0u);
+        page.lastDrawn.assign(cellCount, 0u);
+        page.freeCells.reserve(cellCount);
+        for (uint32_t cell = cellCount; cell > 0; --cell)
+        {
+            page.freeCells.push_back(static_cast<uint16_t>(cell - 1u));
+        }
+        cache.atlasPages.push_back(std::move(page));
+
+        DBGOUT_INFO(L"IconCache: Created icon atlas page {} ({}x{} icons, {} cells)", pageIndex, iconSize.width, iconSize.height, cellCount);
+    }
+
+    AtlasPage& page     = cache.atlasPages[pageIndex];
+    const uint16_t cell = page.freeCells.back();
+
+    const D2D1_POINT_2U destination = D2D1::Point2U((cell % page.columns) * cellWidth, (cell / page.columns) * cellHeight);
+    const HRESULT hrCopy            = page.bitmap->CopyFromBitmap(&destination, entry.bitmap.get(), nullptr);
+    if (FAILED(hrCopy))
+    {
+        Debug::Warning(L"IconCache: Failed to copy icon into atlas page {}: 0x{:08X}", pageIndex, hrCopy);
+        return {};
+    }
+    page.freeCells.pop_back();
+
+    if (++_atlasGeneration == 0)
+    {
+        ++_atlasGeneration; // 0 marks an empty slot
+    }
+
+    page.generations[cell] = _atlasGeneration;
+    page.lastDrawn[cell]   = 0;
+
+    AtlasSlot slot;
+    slot.generation = _atlasGeneration;
+    slot.page       = static_cast<uint16_t>(pageIndex);
+    slot.cell       = cell;
+    return slot;
+}
+
+void IconCache::ReleaseAtlasSlot(DeviceCache& cache, const AtlasSlot& slot) noexcept
+{
+    // Must be called with _mutex locked
+    if (! slot.IsValid() || slot.page >= cache.atlasPages.size())
+    {
+        return;
+    }
+
+    AtlasPage& page = cache.atlasPages[slot.page];
+    if (slot.cell >= page.generations.size() || page.generations[slot.cell] != slot.generation)
+    {
+        return;
+    }
+
+    page.generations[slot.cell] = 0;
+    page.freeCells.push_back(slot.cell);
+}
+
+size_t IconCache::DrawAtlasSprites(ID2D1DeviceContext* d2dContext, std::span<AtlasSprite> sprites)
+{
+    if (! d2dContext || sprites.empty())
+    {
+        return 0;
+    }
+
+    wil::com_ptr<ID2D1Device> device;
+    d2dContext->GetDevice(device.put());
+
+    std::lock_guard lock(_mutex);
+    const auto deviceIt = device ? _deviceCaches.find(device.get()) : _deviceCaches.end();
+    if (deviceIt == _deviceCaches.end())
+    {
+        for (AtlasSprite& sprite : sprites)
+        {
+            sprite.slot = {};
+        }
+        return sprites.size();
+    }
+
+    DeviceCache& cache = deviceIt->second;
+
+    // Bucket sprites per page; stale slots (evicted or replaced icons) are reset for the caller.
+    const size_t frameAccess = ++cache.accessCounter;
+    size_t stale             = 0;
+    for (AtlasSprite& sprite : sprites)
+    {
+        const AtlasSlot& slot = sprite.slot;
+        if (! slot.IsValid() || slot.page >= cache.atlasPages.size() || slot.cell >= cache.atlasPages[slot.page].generations.size() ||
+            cache.atlasPages[slot.page].generations[slot.cell] != slot.generation)
+        {
+            sprite.slot = {};
+            ++stale;
+            continue;
+        }
+
+        AtlasPage& page     = cache.atlasPages[slot.page];
+        const uint32_t left = (slot.cell % page.columns) * (page.iconWidth + kAtlasGutterPx);
+        const uint32_t top  = (slot.cell / page.columns) * (page.iconHeight + kAtlasGutterPx);
+
+        page.lastDrawn[slot.cell] = frameAccess;
+        page.pendingDestinations.push_back(sprite.destination);
+        page.pendingSources.push_back(D2D1::RectU(left, top, left + page.iconWidth, top + page.iconHeight));
+    }
+
+    wil::com_ptr<ID2D1DeviceContext3> context3;
+    if (_spriteBatchEnabled && ! cache.spriteBatchUnavailable)
+    {
+        if (SUCCEEDED(d2dContext->QueryInterface(IID_PPV_ARGS(context3.put()))) && ! cache.spriteBatch)
+        {
+            const HRESULT hr = context3->CreateSpriteBatch(cache.spriteBatch.put());
+            if (FAILED(hr))
+            {
+                Debug::Warning(L"IconCache: CreateSpriteBatch failed, drawing icons one by one: 0x{:08X}", hr);
+            }
+        }
+
+        if (! context3 || ! cache.spriteBatch)
+        {
+            cache.spriteBatchUnavailable = true;
+            context3.reset();
+        }
+    }
+
+    size_t drawCalls = 0;
+    for (AtlasPage& page : cache.atlasPages)
+    {
+        if (page.pendingDestinations.empty())
+        {
+            continue;
+        }
+
+        if (context3)
+        {
+            // Sprite batches require aliased antialiasing; icon destinations are pixel-aligned anyway.
+            const D2D1_ANTIALIAS_MODE previousMode = context3->GetAntialiasMode();
+            context3->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+
+            cache.spriteBatch->Clear();
+            const HRESULT hr = cache.spriteBatch->AddSprites(static_cast<UINT32>(page.pendingDestinations.size()),
+                                                             page.pendingDestinations.data(),
+                                                             page.pendingSources.data(),
+                                                             nullptr,
+                                                             nullptr,
+                                                             sizeof(D2D1_RECT_F),
+                                                             sizeof(D2D1_RECT_U),
+                                                             0,
+                                                             0);
+            if (SUCCEEDED(hr))
+            {
+                context3->DrawSpriteBatch(cache.spriteBatch.get(), page.bitmap.get(), D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+                ++drawCalls;
+            }
+            else
+            {
+                Debug::Warning(L"IconCache: ID2D1SpriteBatch::AddSprites failed: 0x{:08X}", hr);
+            }
+
+            context3->SetAntialiasMode(previousMode);
+        }
+        else
+        {
+            for (size_t i = 0; i < page.pendingDestinations.size(); ++i)
+            {
+                const D2D1_RECT_U& source    = page.pendingSources[i];
+                const D2D1_RECT_F sourceRect = D2D1::RectF(
+                    static_cast<float>(source.left), static_cast<float>(source.top), static_cast<float>(source.right), static_cast<float>(source.bottom));
+                d2dContext->DrawBitmap(page.bitmap.get(), &page.pendingDestinations[i], 1.0f, D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR, &sourceRect);
+                ++drawCalls;
+            }
+        }
+
+        page.pendingDestinations.clear();
+        page.pendingSources.clear();
+    }
+
+    _lastDrawUsedSpriteBatch = context3 != nullptr;
+    _lastFrameIcons          = sprites.size() - stale;
+    _lastFrameDrawCalls      = drawCalls;
+    return stale;
+}
+
+void IconCache::RecordIconFrameTime(uint64_t frameUs)
+{
+    std::lock_guard lock(_mutex);
+    if (_lastDrawUsedSpriteBatch)
+    {
+        ++_spriteBatchFrames;
+        _spriteBatchFrameUsTotal += frameUs;
+        _spriteBatchFrameUsMax = std::max(_spriteBatchFrameUsMax, frameUs);
+    }
+    else
+    {
+        ++_perIconFrames;
+        _perIconFrameUsTotal += frameUs;
+        _perIconFrameUsMax = std::max(_perIconFrameUsMax, frameUs);
+    }
+}
+
 wil::unique_hicon IconCache::ExtractSystemIcon(int iconIndex, float targetDipSize)
 {
     if (iconIndex < 0)
@@ -345,6 +653,21 @@ wil::unique_hicon IconCache::ExtractSystemIcon(int iconIndex, float targetDipSiz
         return {};
     }
 
+    if (iconIndex >= kPersistentIconIndexBase)
+    {
+        return CreatePersistentIcon(iconIndex, targetDipSize);
+    }
+
+    wil::unique_hicon icon = ExtractImageListIcon(iconIndex, targetDipSize);
+    if (icon)
+    {
+        CapturePersistentIcon(iconIndex, targetDipSize, icon.get());
+    }
+    return icon;
+}
+
+wil::unique_hicon IconCache::ExtractImageListIcon(int iconIndex, float targetDipSize)
+{
     auto tryExtract = [&](IImageList* imageList) -> wil::unique_hicon
     {
         if (! imageList)
@@ -738,6 +1061,10 @@ wil::com_ptr<ID2D1Bitmap1> IconCache::ConvertIconToBitmapOnUIThread(HICON icon,
             cache.device = device;
         }
         EvictLRUIfNeeded(cache);
+        if (const auto existing = cache.bitmaps.find(iconIndex); existing != cache.bitmaps.end())
+        {
+            ReleaseAtlasSlot(cache, existing->second.slot);
+        }
         CacheEntry entry;
         entry.bitmap             = bitmap;
         entry.lastAccessTime     = ++cache.accessCounter;
@@ -843,6 +1170,19 @@ void IconCache::WarmCommonExtensions()
             }
         }
 
+        // Persistent icon pack first: no Shell call, pixels are served from the pack
+        std::wstring persistentKey = MakePersistentExtensionKey(extKey);
+        if (const auto persistentIndex = TryGetPersistentIconIndex(persistentKey, 0, 16.0f); persistentIndex.has_value())
+        {
+            std::lock_guard lock(_mutex);
+            if (_extensionToIconIndex.find(extKey) == _extensionToIconIndex.end())
+            {
+                _extensionToIconIndex[std::move(extKey)] = persistentIndex.value();
+                ++warmed;
+            }
+            continue;
+        }
+
         // Query icon index
         // For folders: Use SHGFI_USEFILEATTRIBUTES with FILE_ATTRIBUTE_DIRECTORY
         // Note: Icon indices are size-agnostic; we extract from size-specific image lists later
@@ -862,6 +1202,8 @@ void IconCache::WarmCommonExtensions()
         const DWORD_PTR result = SHGetFileInfoW(queryPath.c_str(), attrib, &sfi, sizeof(sfi), SHGFI_SYSICONINDEX | SHGFI_USEFILEATTRIBUTES);
         if (result != 0 && sfi.iIcon >= 0)
         {
+            RememberPersistentKey(sfi.iIcon, std::move(persistentKey), 0, 16.0f);
+
             std::lock_guard lock(_mutex);
             if (_extensionToIconIndex.find(extKey) == _extensionToIconIndex.end())
             {
@@ -952,11 +1294,21 @@ IconCache::Stats IconCache::GetStats() const
     for (const auto& entry : _deviceCaches)
     {
         stats.cacheSize += entry.second.bitmaps.size();
-    }
-    stats.hitCount           = _hitCount;
-    stats.missCount          = _missCount;
-    stats.extensionCacheSize = _extensionToIconIndex.size();
-    stats.lruEvictions       = _lruEvictions;
+        stats.atlasPages += entry.second.atlasPages.size();
+    }
+    stats.hitCount              = _hitCount;
+    stats.missCount             = _missCount;
+    stats.extensionCacheSize    = _extensionToIconIndex.size();
+    stats.lruEvictions          = _lruEvictions;
+    stats.spriteBatchFrames     = _spriteBatchFrames;
+    stats.spriteBatchFrameUs    = _spriteBatchFrames > 0 ? _spriteBatchFrameUsTotal / _spriteBatchFrames : 0;
+    stats.spriteBatchFrameMaxUs = _spriteBatchFrameUsMax;
+    stats.perIconFrames         = _perIconFrames;
+    stats.perIconFrameUs        = _perIconFrames > 0 ? _perIconFrameUsTotal / _perIconFrames : 0;
+    stats.perIconFrameMaxUs     = _perIconFrameUsMax;
+    stats.lastFrameIcons        = _lastFrameIcons;
+    stats.lastFrameDrawCalls    = _lastFrameDrawCalls;
+    FillPersistentStats(stats);
     return stats;
 }
 
@@ -1010,10 +1362,18 @@ std::optional<int> IconCache::GetOrQueryIconIndexByExtension(std::wstring_view e
         queryPath.append(keyView);
     }
 
+    std::wstring persistentKey = MakePersistentExtensionKey(keyView);
+    if (const auto persistentIndex = TryGetPersistentIconIndex(persistentKey, 0, 16.0f); persistentIndex.has_value())
+    {
+        RegisterExtension(keyView, *persistentIndex);
+        return persistentIndex;
+    }
+
     const auto iconIndex = QuerySysIconIndexForPath(queryPath.c_str(), fileAttributes, true);
     if (iconIndex.has_value())
     {
         RegisterExtension(keyView, *iconIndex);
+        RememberPersistentKey(*iconIndex, std::move(persistentKey), 0, 16.0f);
     }
     return iconIndex;
 }
@@ -1065,21 +1425,28 @@ void IconCache::EvictLRUIfNeeded(IconCache::DeviceCache& cache)
         return;
     }
 
-    // Find oldest entry by access time
+    // Find oldest entry by access time (atlas draws count as accesses)
     int oldestKey     = -1;
     size_t oldestTime = SIZE_MAX;
 
     for (const auto& [key, entry] : cache.bitmaps)
     {
-        if (entry.lastAccessTime < oldestTime)
+        size_t accessTime = entry.lastAccessTime;
+        if (entry.slot.IsValid() && entry.slot.page < cache.atlasPages.size())
         {
-            oldestTime = entry.lastAccessTime;
+            accessTime = std::max(accessTime, cache.atlasPages[entry.slot.page].lastDrawn[entry.slot.cell]);
+        }
+
+        if (accessTime < oldestTime)
+        {
+            oldestTime = accessTime;
             oldestKey  = key;
         }
     }
 
     if (oldestKey >= 0)
     {
+        ReleaseAtlasSlot(cache, cache.bitmaps[oldestKey].slot);
         cache.bitmaps.erase(oldestKey);
         _lruEvictions++;
         DBGOUT_INFO(L"IconCache: Evicted icon index {} (LRU), cache size now {}", oldestKey, cache.bitmaps.size());
@@ -1191,6 +1558,11 @@ size_t IconCache::GetMemoryUsage() const
             static_cast<void>(iconIndex);
             bytes += cacheEntry.bytes;
         }
+        for (const auto& page : entry.second.atlasPages)
+        {
+            const D2D1_SIZE_U pageSize = page.bitmap->GetPixelSize();
+            bytes += static_cast<size_t>(pageSize.width) * static_cast<size_t>(pageSize.height) * 4u;
+        }
     }
     return bytes;
 }
@@ -5,17 +5,21 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <ShlObj.h>
 #include <Windows.h>
 
-#include <d2d1_1.h>
+#include <d2d1_3.h>
 
 #pragma warning(push)
 // WIL: C4625 (copy ctor deleted), C4626 (copy assign deleted), C5026 (move ctor deleted), C5027
@@ -31,6 +35,7 @@ struct IWICImagingFactory;
 
 // Application-wide icon cache using Windows system image lists.
 // Converts HICON to ID2D1Bitmap1 and caches by icon index (per Direct2D device) for sharing across views.
+// Cached icons are also packed into per-device atlas pages so FolderView can draw a frame's icons with ID2D1SpriteBatch.
 // Thread-safe for concurrent access from multiple windows and background threads.
 class IconCache
 {
@@ -66,13 +71,47 @@ public:
     // Cached or newly created D2D bitmap, or nullptr on failure</returns>
     wil::com_ptr<ID2D1Bitmap1> GetIconBitmap(int iconIndex, ID2D1DeviceContext* d2dContext);
 
+    // Slot of a cached icon inside the per-device icon atlas.
+    // generation identifies the occupant: a slot goes stale once its icon is evicted (LRU, DPI change, device loss).
+    struct AtlasSlot
+    {
+        uint32_t generation = 0; // 0 = no slot
+        uint16_t page       = 0;
+        uint16_t cell       = 0;
+
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return generation != 0;
+        }
+    };
+
+    struct AtlasSprite
+    {
+        AtlasSlot slot;
+        D2D1_RECT_F destination{};
+    };
+
+    // Get the atlas slot of a cached icon, copying the icon into the atlas on first use (UI thread only).
+    // Returns an invalid slot if the icon is not cached for the device of d2dContext.
+    AtlasSlot GetAtlasSlot(int iconIndex, ID2D1DeviceContext* d2dContext);
+
+    // Draw icons from the atlas (UI thread, between BeginDraw/EndDraw).
+    // Issues one ID2D1SpriteBatch draw per atlas page; falls back to one DrawBitmap per icon when sprite batches are unavailable
+    // (pre-ID2D1DeviceContext3 systems, or REDSALAMANDER_ICON_SPRITEBATCH=0 to measure the old path).
+    // Stale sprites are skipped and their slot is reset so the caller can draw a placeholder and reload them.
+    // Returns the number of stale sprites.
+    size_t DrawAtlasSprites(ID2D1DeviceContext* d2dContext, std::span<AtlasSprite> sprites);
+
+    // Record the CPU time of a frame that drew icons through DrawAtlasSprites (reported per draw path by GetStats()).
+    void RecordIconFrameTime(uint64_t frameUs);
+
     // Check if icon is already cached for the given D2D device (thread-safe, no D2D calls).
     bool HasCachedIcon(int iconIndex, ID2D1Device* device) const;
 
     // Get cached bitmap without creating (returns nullptr if not cached).
     wil::com_ptr<ID2D1Bitmap1> GetCachedBitmap(int iconIndex, ID2D1DeviceContext* d2dContext) const;
 
-    // Extract an icon from the system image list.
+    // Extract an icon from the system image list (or from the persistent icon pack for persistent icon indices).
     // Contract:
     // - Requires IconCache::Initialize(...) to have run.
     // - Caller thread must have COM initialized. UI thread is STA; worker threads must initialize COM as MTA
@@ -117,6 +156,23 @@ public:
     // fileAttributes: FILE_ATTRIBUTE_DIRECTORY for L"<directory>", FILE_ATTRIBUTE_NORMAL for files.
     std::optional<int> GetOrQueryIconIndexByExtension(std::wstring_view extension, DWORD fileAttributes);
 
+    // Persistent icon pack: %LOCALAPPDATA%\RedSalamander\Cache\Icons.pack, memory-mapped on first use.
+    // Holds icon pixels per system image list size, keyed by extension and by path + last write time for per-file types.
+    // Pack hits resolve to persistent icon indices (>= kPersistentIconIndexBase) that ExtractSystemIcon serves from the pack,
+    // so a cold start does not wait on SHGetFileInfo / image list extraction. Misses are captured when first extracted.
+    static constexpr int kPersistentIconIndexBase = 0x40000000;
+
+    // Look up a per-file icon (RequiresPerFileLookup types, special folders) in the pack (thread-safe, no Shell calls).
+    // lastWriteTime: file time as stored in FileInfo::LastWriteTime; 0 bypasses the pack.
+    std::optional<int> TryGetPersistentFileIconIndex(std::wstring_view fullPath, int64_t lastWriteTime, float targetDipSize = 16.0f);
+
+    // Query the system icon index for a per-file icon and remember path + lastWriteTime so the icon is written to the pack
+    // once extracted at targetDipSize (thread-safe).
+    std::optional<int> QuerySysIconIndexForFile(const std::wstring& fullPath, int64_t lastWriteTime, float targetDipSize = 16.0f);
+
+    // Write icons captured this session to the pack and close it (call on shutdown, after views are destroyed).
+    void SavePersistentCache() noexcept;
+
     // Check if extension requires per-file icon lookup (e.g., .exe, .ico, .lnk).
     // These file types have unique icons per file, not by extension.
     bool RequiresPerFileLookup(std::wstring_view extension) const;
@@ -139,9 +195,26 @@ public:
         size_t missCount          = 0;
         size_t extensionCacheSize = 0;
         size_t lruEvictions       = 0;
+        size_t atlasPages         = 0;
+
+        // Frames that drew icons: sprite batch path vs. one DrawBitmap per icon (average/max CPU frame time).
+        size_t spriteBatchFrames       = 0;
+        uint64_t spriteBatchFrameUs    = 0;
+        uint64_t spriteBatchFrameMaxUs = 0;
+        size_t perIconFrames           = 0;
+        uint64_t perIconFrameUs        = 0;
+        uint64_t perIconFrameMaxUs     = 0;
+        size_t lastFrameIcons          = 0;
+        size_t lastFrameDrawCalls      = 0;
+
+        // Persistent icon pack
+        size_t persistentEntries  = 0;
+        size_t persistentHits     = 0;
+        size_t persistentMisses   = 0;
+        size_t persistentCaptured = 0;
     };
     Stats GetStats() const;
-    // Get approximate bitmap memory usage in bytes (sum of width × height × 4 for cached entries).
+    // Get approximate bitmap memory usage in bytes (sum of width × height × 4 for cached entries and atlas pages).
     size_t GetMemoryUsage() const;
 
     // Check if path is a special folder (Desktop, Documents, etc.)
@@ -168,8 +241,8 @@ public:
     std::optional<SpecialFolderMatch> TryGetSpecialFolderForPathPrefix(std::wstring_view path) const;
 
 private:
-    IconCache()                            = default;
-    ~IconCache()                           = default;
+    IconCache();  // Defined with PersistentStore in IconCache.Persistent.cpp
+    ~IconCache();
     IconCache(const IconCache&)            = delete;
     IconCache& operator=(const IconCache&) = delete;
 
@@ -178,6 +251,18 @@ private:
     // Returns: SHIL_JUMBO (256×256), SHIL_EXTRALARGE (48×48), SHIL_LARGE (32×32), or SHIL_SMALL (16×16)
     int SelectOptimalImageListSize(float targetDipSize) const;
 
+    // Extract from the system image lists (optimal size first, then the fallback cascade).
+    wil::unique_hicon ExtractImageListIcon(int iconIndex, float targetDipSize);
+
+    // Persistent icon pack (IconCache.Persistent.cpp). PersistentStore owns the mapped pack and its own mutex.
+    struct PersistentStore;
+    std::optional<int> TryGetPersistentIconIndex(const std::wstring& key, int64_t lastWriteTime, float targetDipSize);
+    void RememberPersistentKey(int iconIndex, std::wstring key, int64_t lastWriteTime, float targetDipSize);
+    wil::unique_hicon CreatePersistentIcon(int iconIndex, float targetDipSize);
+    void CapturePersistentIcon(int iconIndex, float targetDipSize, HICON icon);
+    void FillPersistentStats(Stats& stats) const;
+    static std::wstring MakePersistentExtensionKey(std::wstring_view normalizedExtension);
+
     // Convert HICON to ID2D1Bitmap1 using WIC for superior quality. WIC-based conversion provides crisp icons without GDI quality degradation.
     // Returns nullptr on WIC conversion failures (logged via Debug::Warning).
     wil::com_ptr<ID2D1Bitmap1> ConvertIconToBitmap(HICON icon, ID2D1DeviceContext* d2dContext);
@@ -186,20 +271,44 @@ private:
     struct CacheEntry
     {
         wil::com_ptr<ID2D1Bitmap1> bitmap;
+        AtlasSlot slot;
         size_t lastAccessTime = 0;
         size_t bytes          = 0; // Approximate: width × height × 4 (BGRA)
     };
 
+    // One atlas texture holding icons of a single pixel size in a grid of cells (1px gutter between cells).
+    struct AtlasPage
+    {
+        wil::com_ptr<ID2D1Bitmap1> bitmap;
+        uint32_t iconWidth  = 0;
+        uint32_t iconHeight = 0;
+        uint32_t columns    = 0;
+        std::vector<uint32_t> generations; // Occupant generation per cell (0 = free)
+        std::vector<size_t> lastDrawn;     // Access time of the last frame that drew the cell (keeps visible icons out of LRU eviction)
+        std::vector<uint16_t> freeCells;
+        std::vector<D2D1_RECT_F> pendingDestinations; // Per-frame sprite scratch (capacity reused)
+        std::vector<D2D1_RECT_U> pendingSources;
+    };
+
     struct DeviceCache
     {
         wil::com_ptr<ID2D1Device> device;
         std::unordered_map<int, CacheEntry> bitmaps;
-        size_t accessCounter = 0;
+        std::vector<AtlasPage> atlasPages;
+        wil::com_ptr<ID2D1SpriteBatch> spriteBatch;
+        bool spriteBatchUnavailable = false;
+        size_t accessCounter        = 0;
     };
 
     // Evict least recently used icon if cache exceeds size limit.
     void EvictLRUIfNeeded(DeviceCache& cache);
 
+    // Copy a cached bitmap into a free atlas cell (creating a page if needed). Must be called with _mutex locked.
+    AtlasSlot AllocateAtlasSlot(DeviceCache& cache, const CacheEntry& entry, ID2D1DeviceContext* d2dContext);
+
+    // Return an atlas cell to its page's free list. Must be called with _mutex locked.
+    static void ReleaseAtlasSlot(DeviceCache& cache, const AtlasSlot& slot) noexcept;
+
     mutable std::mutex _mutex;
     std::unordered_map<ID2D1Device*, DeviceCache> _deviceCaches;
     std::unordered_map<std::wstring, int> _extensionToIconIndex;
@@ -213,6 +322,19 @@ private:
     mutable size_t _missCount    = 0;
     mutable size_t _lruEvictions = 0;
 
+    // Atlas draw statistics (see Stats)
+    uint32_t _atlasGeneration         = 0;
+    bool _spriteBatchEnabled          = true;
+    bool _lastDrawUsedSpriteBatch     = false;
+    size_t _lastFrameIcons            = 0;
+    size_t _lastFrameDrawCalls        = 0;
+    size_t _spriteBatchFrames         = 0;
+    uint64_t _spriteBatchFrameUsTotal = 0;
+    uint64_t _spriteBatchFrameUsMax   = 0;
+    size_t _perIconFrames             = 0;
+    uint64_t _perIconFrameUsTotal     = 0;
+    uint64_t _perIconFrameUsMax       = 0;
+
     // System image list COM objects (cached) - initialized once and treated as immutable for lock-free reads in hot paths.
     // NOTE: Clear() does not reset these; they remain valid for the lifetime of the process once acquired.
     wil::com_ptr<IImageList> _systemImageListJumbo; // 256×256 (SHIL_JUMBO)
@@ -235,6 +357,8 @@ private:
     std::atomic<bool> _warmingCompleted{false};
     std::atomic<bool> _warmingInProgress{false};
 
+    const std::unique_ptr<PersistentStore> _persistentStore; // Created by the constructor; the pack itself opens on first lookup
+
     // Initialize special folder paths cache
     static void InitializeSpecialFolders();
 };
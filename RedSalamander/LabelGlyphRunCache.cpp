@@ -0,0 +1,302 @@
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#define WINDOWS_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include "LabelGlyphRunCache.h"
+
+namespace
+{
+constexpr size_t kMaxCachedRuns     = 65536; // Cleared wholesale when exceeded; items keep their shared_ptr alive
+constexpr size_t kMaxShapedTextLen  = 1024;  // Longer names go through IDWriteTextLayout
+constexpr UINT32 kEllipsisCodePoint = 0x2026;
+} // namespace
+
+HRESULT LabelGlyphRunCache::Initialize(IDWriteFactory* factory, IDWriteTextFormat* format) noexcept
+{
+    Reset();
+
+    if (! factory || ! format)
+    {
+        return E_INVALIDARG;
+    }
+
+    wil::com_ptr<IDWriteFontCollection> collection;
+    HRESULT hr = format->GetFontCollection(collection.addressof());
+    if (FAILED(hr) || ! collection)
+    {
+        hr = factory->GetSystemFontCollection(collection.addressof(), FALSE);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+    }
+
+    const UINT32 familyNameLength = format->GetFontFamilyNameLength();
+    std::wstring familyName(static_cast<size_t>(familyNameLength) + 1u, L'\0');
+    hr = format->GetFontFamilyName(familyName.data(), familyNameLength + 1u);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    familyName.resize(familyNameLength);
+
+    UINT32 familyIndex = 0;
+    BOOL familyExists  = FALSE;
+    hr                 = collection->FindFamilyName(familyName.c_str(), &familyIndex, &familyExists);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    if (! familyExists)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+    }
+
+    wil::com_ptr<IDWriteFontFamily> family;
+    hr = collection->GetFontFamily(familyIndex, family.addressof());
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    wil::com_ptr<IDWriteFont> font;
+    hr = family->GetFirstMatchingFont(format->GetFontWeight(), format->GetFontStretch(), format->GetFontStyle(), font.addressof());
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    wil::com_ptr<IDWriteFontFace> fontFace;
+    hr = font->CreateFontFace(fontFace.addressof());
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    wil::com_ptr<IDWriteTextAnalyzer> analyzer;
+    hr = factory->CreateTextAnalyzer(analyzer.addressof());
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    wil::com_ptr<IDWriteTextAnalyzer1> analyzer1 = analyzer.try_query<IDWriteTextAnalyzer1>();
+    if (! analyzer1)
+    {
+        return E_NOINTERFACE;
+    }
+
+    // Take the line box from a real layout so glyph runs sit exactly where DrawTextLayout puts the same label.
+    wil::com_ptr<IDWriteTextLayout> probeLayout;
+    hr = factory->CreateTextLayout(L"A", 1u, format, 1000.0f, 1000.0f, probeLayout.addressof());
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    DWRITE_LINE_METRICS lineMetrics{};
+    UINT32 lineCount = 0;
+    hr               = probeLayout->GetLineMetrics(&lineMetrics, 1u, &lineCount);
+    if (FAILED(hr) || lineCount == 0)
+    {
+        return FAILED(hr) ? hr : E_UNEXPECTED;
+    }
+
+    _fontFace      = std::move(fontFace);
+    _analyzer      = std::move(analyzer1);
+    _fontEmSize    = format->GetFontSize();
+    _baselineDip   = lineMetrics.baseline;
+    _lineHeightDip = lineMetrics.height;
+
+    UINT16 ellipsisGlyph = 0;
+    if (SUCCEEDED(_fontFace->GetGlyphIndicesW(&kEllipsisCodePoint, 1u, &ellipsisGlyph)) && ellipsisGlyph != 0)
+    {
+        _ellipsisGlyphs.assign(1u, ellipsisGlyph);
+    }
+    else
+    {
+        const UINT32 dot = L'.';
+        UINT16 dotGlyph  = 0;
+        static_cast<void>(_fontFace->GetGlyphIndicesW(&dot, 1u, &dotGlyph));
+        _ellipsisGlyphs.assign(3u, dotGlyph);
+    }
+
+    DWRITE_FONT_METRICS fontMetrics{};
+    _fontFace->GetMetrics(&fontMetrics);
+    const float designScale = fontMetrics.designUnitsPerEm > 0 ? _fontEmSize / static_cast<float>(fontMetrics.designUnitsPerEm) : 0.0f;
+
+    std::array<DWRITE_GLYPH_METRICS, 3> ellipsisMetrics{};
+    if (FAILED(_fontFace->GetDesignGlyphMetrics(_ellipsisGlyphs.data(), static_cast<UINT32>(_ellipsisGlyphs.size()), ellipsisMetrics.data(), FALSE)))
+    {
+        Reset();
+        return E_FAIL;
+    }
+
+    _ellipsisAdvances.clear();
+    _ellipsisWidth = 0.0f;
+    for (size_t i = 0; i < _ellipsisGlyphs.size(); ++i)
+    {
+        const float advance = static_cast<float>(ellipsisMetrics[i].advanceWidth) * designScale;
+        _ellipsisAdvances.push_back(advance);
+        _ellipsisWidth += advance;
+    }
+
+    return S_OK;
+}
+
+void LabelGlyphRunCache::Reset() noexcept
+{
+    _fontFace.reset();
+    _analyzer.reset();
+    _fontEmSize    = 0.0f;
+    _baselineDip   = 0.0f;
+    _lineHeightDip = 0.0f;
+    _ellipsisGlyphs.clear();
+    _ellipsisAdvances.clear();
+    _ellipsisWidth = 0.0f;
+    _runs.clear();
+}
+
+std::shared_ptr<const LabelGlyphRunCache::Run> LabelGlyphRunCache::GetRun(std::wstring_view text)
+{
+    if (! _fontFace || ! _analyzer || text.empty())
+    {
+        return nullptr;
+    }
+
+    if (const auto it = _runs.find(text); it != _runs.end())
+    {
+        return it->second;
+    }
+
+    if (_runs.size() >= kMaxCachedRuns)
+    {
+        _runs.clear();
+    }
+
+    std::shared_ptr<const Run> run = Shape(text);
+    _runs.emplace(std::wstring(text), run);
+    return run;
+}
+
+std::shared_ptr<const LabelGlyphRunCache::Run> LabelGlyphRunCache::Shape(std::wstring_view text)
+{
+    if (text.size() > kMaxShapedTextLen)
+    {
+        return nullptr;
+    }
+
+    const UINT32 length = static_cast<UINT32>(text.size());
+
+    auto run = std::make_shared<Run>();
+    run->glyphIndices.resize(length);
+
+    // Simple text maps 1:1 from UTF-16 code units to nominal glyphs (no shaping, no bidi, no surrogates).
+    BOOL isTextSimple = FALSE;
+    UINT32 lengthRead = 0;
+    HRESULT hr        = _analyzer->GetTextComplexity(text.data(), length, _fontFace.get(), &isTextSimple, &lengthRead, run->glyphIndices.data());
+    if (FAILED(hr) || ! isTextSimple || lengthRead != length)
+    {
+        return nullptr;
+    }
+
+    // Glyph 0 means the label font lacks the character; IDWriteTextLayout would pick a fallback font.
+    if (std::find(run->glyphIndices.begin(), run->glyphIndices.end(), static_cast<UINT16>(0)) != run->glyphIndices.end())
+    {
+        return nullptr;
+    }
+
+    _glyphMetrics.resize(length);
+    hr = _fontFace->GetDesignGlyphMetrics(run->glyphIndices.data(), length, _glyphMetrics.data(), FALSE);
+    if (FAILED(hr))
+    {
+        return nullptr;
+    }
+
+    DWRITE_FONT_METRICS fontMetrics{};
+    _fontFace->GetMetrics(&fontMetrics);
+    if (fontMetrics.designUnitsPerEm == 0)
+    {
+        return nullptr;
+    }
+    const float designScale = _fontEmSize / static_cast<float>(fontMetrics.designUnitsPerEm);
+
+    std::vector<INT32> designAdvances(length);
+    for (UINT32 i = 0; i < length; ++i)
+    {
+        designAdvances[i] = static_cast<INT32>(_glyphMetrics[i].advanceWidth);
+    }
+
+    // Apply pair kerning from the legacy 'kern' table like the layout does by default (GPOS kerning is not applied on this fast path).
+    if (auto fontFace1 = _fontFace.try_query<IDWriteFontFace1>(); fontFace1 && fontFace1->HasKerningPairs() && length > 1)
+    {
+        std::vector<INT32> kerning(length);
+        if (SUCCEEDED(fontFace1->GetKerningPairAdjustments(length, run->glyphIndices.data(), kerning.data())))
+        {
+            for (UINT32 i = 0; i < length; ++i)
+            {
+                designAdvances[i] += kerning[i];
+            }
+        }
+    }
+
+    run->glyphAdvances.resize(length);
+    for (UINT32 i = 0; i < length; ++i)
+    {
+        const float advance   = static_cast<float>(designAdvances[i]) * designScale;
+        run->glyphAdvances[i] = advance;
+        run->width += advance;
+    }
+
+    return run;
+}
+
+void LabelGlyphRunCache::Draw(ID2D1DeviceContext* context, D2D1_POINT_2F baselineOrigin, const Run& run, float maxWidthDip, ID2D1Brush* brush)
+{
+    if (! context || ! brush || ! _fontFace || run.glyphIndices.empty())
+    {
+        return;
+    }
+
+    const UINT16* glyphs  = run.glyphIndices.data();
+    const FLOAT* advances = run.glyphAdvances.data();
+    UINT32 glyphCount     = static_cast<UINT32>(run.glyphIndices.size());
+
+    if (run.width > maxWidthDip)
+    {
+        // Character-granularity trimming (same as the label layouts): keep the longest prefix that still fits the ellipsis.
+        const float budget = maxWidthDip - _ellipsisWidth;
+        size_t keep        = 0;
+        float used         = 0.0f;
+        while (keep < run.glyphIndices.size() && used + run.glyphAdvances[keep] <= budget)
+        {
+            used += run.glyphAdvances[keep];
+            ++keep;
+        }
+
+        _drawGlyphs.assign(run.glyphIndices.begin(), run.glyphIndices.begin() + static_cast<std::ptrdiff_t>(keep));
+        _drawGlyphs.insert(_drawGlyphs.end(), _ellipsisGlyphs.begin(), _ellipsisGlyphs.end());
+        _drawAdvances.assign(run.glyphAdvances.begin(), run.glyphAdvances.begin() + static_cast<std::ptrdiff_t>(keep));
+        _drawAdvances.insert(_drawAdvances.end(), _ellipsisAdvances.begin(), _ellipsisAdvances.end());
+
+        glyphs     = _drawGlyphs.data();
+        advances   = _drawAdvances.data();
+        glyphCount = static_cast<UINT32>(_drawGlyphs.size());
+    }
+
+    DWRITE_GLYPH_RUN glyphRun{};
+    glyphRun.fontFace      = _fontFace.get();
+    glyphRun.fontEmSize    = _fontEmSize;
+    glyphRun.glyphCount    = glyphCount;
+    glyphRun.glyphIndices  = glyphs;
+    glyphRun.glyphAdvances = advances;
+    glyphRun.glyphOffsets  = nullptr;
+    glyphRun.isSideways    = FALSE;
+    glyphRun.bidiLevel     = 0;
+
+    context->DrawGlyphRun(baselineOrigin, &glyphRun, nullptr, brush, DWRITE_MEASURING_MODE_NATURAL);
+}
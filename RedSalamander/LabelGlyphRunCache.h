@@ -0,0 +1,104 @@
+#pragma once
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <Windows.h>
+
+#include <d2d1_1.h>
+#include <dwrite_1.h>
+
+#pragma warning(push)
+// WIL: C4625 (copy ctor deleted), C4626 (copy assign deleted), C5026 (move ctor deleted), C5027
+// (move assign deleted), C4820 (padding)
+#pragma warning(disable : 4625 4626 5026 5027 4820 28182)
+#include <wil/com.h>
+#pragma warning(pop)
+
+// Shaping cache for single-line FolderView labels.
+// Simple text (per IDWriteTextAnalyzer1::GetTextComplexity, fully covered by the label font) is shaped once into
+// glyph indices + advances and drawn with ID2D1RenderTarget::DrawGlyphRun; ellipsis trimming is computed from the
+// cached advances. Complex scripts and text needing font fallback return nullptr so callers keep using IDWriteTextLayout.
+// UI thread only (owned by one FolderView).
+class LabelGlyphRunCache
+{
+public:
+    struct Run
+    {
+        std::vector<UINT16> glyphIndices;
+        std::vector<FLOAT> glyphAdvances; // DIP
+        float width = 0.0f;               // Sum of glyphAdvances
+    };
+
+    LabelGlyphRunCache()  = default;
+    ~LabelGlyphRunCache() = default;
+
+    LabelGlyphRunCache(const LabelGlyphRunCache&)            = delete;
+    LabelGlyphRunCache& operator=(const LabelGlyphRunCache&) = delete;
+    LabelGlyphRunCache(LabelGlyphRunCache&&)                 = delete;
+    LabelGlyphRunCache& operator=(LabelGlyphRunCache&&)      = delete;
+
+    // Resolves the font face of `format` (its first family, weight, style and stretch) and the text analyzer.
+    HRESULT Initialize(IDWriteFactory* factory, IDWriteTextFormat* format) noexcept;
+    void Reset() noexcept;
+
+    [[nodiscard]] bool IsInitialized() const noexcept
+    {
+        return static_cast<bool>(_fontFace);
+    }
+
+    // Returns the cached run for `text`, shaping it on first use; nullptr when the text needs a full text layout.
+    [[nodiscard]] std::shared_ptr<const Run> GetRun(std::wstring_view text);
+
+    // Distance from the top of the line box to the baseline, and the line box height (DIP); matches IDWriteTextLayout's default line spacing.
+    [[nodiscard]] float GetBaselineDip() const noexcept
+    {
+        return _baselineDip;
+    }
+
+    [[nodiscard]] float GetLineHeightDip() const noexcept
+    {
+        return _lineHeightDip;
+    }
+
+    // Draws `run` at `baselineOrigin`; runs wider than maxWidthDip are cut at the last glyph that still fits an ellipsis.
+    void Draw(ID2D1DeviceContext* context, D2D1_POINT_2F baselineOrigin, const Run& run, float maxWidthDip, ID2D1Brush* brush);
+
+private:
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::wstring_view value) const noexcept
+        {
+            return std::hash<std::wstring_view>{}(value);
+        }
+    };
+
+    std::shared_ptr<const Run> Shape(std::wstring_view text);
+
+    wil::com_ptr<IDWriteFontFace> _fontFace;
+    wil::com_ptr<IDWriteTextAnalyzer1> _analyzer;
+    float _fontEmSize    = 0.0f;
+    float _baselineDip   = 0.0f;
+    float _lineHeightDip = 0.0f;
+
+    std::vector<UINT16> _ellipsisGlyphs; // U+2026, or "..." when the font has no ellipsis glyph
+    std::vector<FLOAT> _ellipsisAdvances;
+    float _ellipsisWidth = 0.0f;
+
+    // nullptr values remember complex text so it is analyzed once.
+    std::unordered_map<std::wstring, std::shared_ptr<const Run>, StringHash, std::equal_to<>> _runs;
+
+    // Scratch buffers for trimmed draws and shaping.
+    std::vector<UINT16> _drawGlyphs;
+    std::vector<FLOAT> _drawAdvances;
+    std::vector<DWRITE_GLYPH_METRICS> _glyphMetrics;
+};
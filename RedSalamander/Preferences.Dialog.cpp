@@ -829,7 +829,8 @@ void EnsureFonts(PreferencesDialogState& state, HFONT baseFont) noexcept
             baselineFileOperations.maxDiagnosticsInMemory != workingFileOperations.maxDiagnosticsInMemory ||
             baselineFileOperations.maxDiagnosticsPerFlush != workingFileOperations.maxDiagnosticsPerFlush ||
             baselineFileOperations.diagnosticsFlushIntervalMs != workingFileOperations.diagnosticsFlushIntervalMs ||
-            baselineFileOperations.diagnosticsCleanupIntervalMs != workingFileOperations.diagnosticsCleanupIntervalMs)
+            baselineFileOperations.diagnosticsCleanupIntervalMs != workingFileOperations.diagnosticsCleanupIntervalMs ||
+            baselineFileOperations.bridgeMaxConcurrentFiles != workingFileOperations.bridgeMaxConcurrentFiles)
         {
             return true;
         }
@@ -967,7 +968,8 @@ namespace
             baselineFileOperations.maxDiagnosticsInMemory != workingFileOperations.maxDiagnosticsInMemory ||
             baselineFileOperations.maxDiagnosticsPerFlush != workingFileOperations.maxDiagnosticsPerFlush ||
             baselineFileOperations.diagnosticsFlushIntervalMs != workingFileOperations.diagnosticsFlushIntervalMs ||
-            baselineFileOperations.diagnosticsCleanupIntervalMs != workingFileOperations.diagnosticsCleanupIntervalMs)
+            baselineFileOperations.diagnosticsCleanupIntervalMs != workingFileOperations.diagnosticsCleanupIntervalMs ||
+            baselineFileOperations.bridgeMaxConcurrentFiles != workingFileOperations.bridgeMaxConcurrentFiles)
         {
             merged.fileOperations = state.workingSettings.fileOperations;
         }
@@ -1859,7 +1859,8 @@ void MaybeResetWorkingFileOperationsSettingsIfEmpty(Common::Settings::Settings&
                                fileOperations.diagnosticsInfoEnabled != defaults.diagnosticsInfoEnabled ||
                                fileOperations.diagnosticsDebugEnabled != defaults.diagnosticsDebugEnabled || fileOperations.maxIssueReportFiles.has_value() ||
                                fileOperations.maxDiagnosticsInMemory.has_value() || fileOperations.maxDiagnosticsPerFlush.has_value() ||
-                               fileOperations.diagnosticsFlushIntervalMs.has_value() || fileOperations.diagnosticsCleanupIntervalMs.has_value();
+                               fileOperations.diagnosticsFlushIntervalMs.has_value() || fileOperations.diagnosticsCleanupIntervalMs.has_value() ||
+                               fileOperations.bridgeMaxConcurrentFiles.has_value();
 
     if (! hasNonDefault)
     {
@@ -41,6 +41,7 @@
 #include "ExceptionHelpers.h"
 #include "Version.h"
 
+#include "Benchmarks.SelfTest.h"
 #include "CommandRegistry.h"
 #include "CompareDirectoriesWindow.h"
 #include "ConnectionManagerDialog.h"
@@ -95,6 +96,8 @@ constexpr wchar_t kItemPropertiesWindowClassName[] = L"RedSalamander.ItemPropert
 constexpr wchar_t kLeftPaneSlot[]                  = L"left";
 constexpr wchar_t kRightPaneSlot[]                 = L"right";
 
+bool g_runBenchmarks = false; // --benchmarks (available in every build configuration)
+
 #ifdef _DEBUG
 bool g_runFileOpsSelfTest = false;
 bool g_runCompareDirectoriesSelfTest = false;
@@ -184,6 +187,7 @@ void ShutdownSelfTestMonitor() noexcept
         L"--compare-selftest",
         L"--commands-selftest",
         L"--fileops-selftest",
+        L"--benchmarks",
     };
 
     for (int i = 1; i < argc; ++i)
@@ -414,17 +418,34 @@ constexpr UINT kFunctionBarPressedKeyClearDelayMs     = 200u;
 std::optional<uint32_t> g_functionBarPressedKey;
 std::optional<uint32_t> g_functionBarPressedKeyClearPending;
 
-#ifdef _DEBUG
 #include "SelfTestCommon.h"
 
+#ifdef _DEBUG
 constexpr UINT_PTR kFileOpsSelfTestTimerId     = 1002u;
 constexpr UINT kFileOpsSelfTestTimerIntervalMs = 50u;
-int g_selfTestExitCode                         = 0;
+#endif
+
+// --benchmarks starts from a one-shot timer so the main window is created and painted before anything is timed.
+constexpr UINT_PTR kBenchmarksTimerId  = 1003u;
+constexpr UINT kBenchmarksStartDelayMs = 250u;
+
+int g_selfTestExitCode = 0;
 SelfTest::SelfTestOptions g_selfTestOptions{};
 SelfTest::SelfTestRunResult g_selfTestRunResult{};
 std::optional<std::chrono::time_point<std::chrono::steady_clock>> g_selfTestRunStart{};
 bool g_selfTestRunFinalized = false;
 
+[[nodiscard]] bool IsSelfTestRunRequested() noexcept
+{
+#ifdef _DEBUG
+    if (g_runFileOpsSelfTest || g_runCompareDirectoriesSelfTest || g_runCommandsSelfTest)
+    {
+        return true;
+    }
+#endif
+    return g_runBenchmarks;
+}
+
 [[nodiscard]] std::wstring GetSelfTestUtcIso8601() noexcept
 {
     const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
@@ -449,7 +470,9 @@ void FinalizeSelfTestRun() noexcept
         return;
     }
 
+#ifdef _DEBUG
     ShutdownSelfTestMonitor();
+#endif
 
     const auto now                   = std::chrono::steady_clock::now();
     g_selfTestRunResult.durationMs   = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - g_selfTestRunStart.value()).count());
@@ -482,7 +505,51 @@ void RecordSelfTestSuite(SelfTest::SelfTestSuiteResult result) noexcept
 {
     g_selfTestRunResult.suites.push_back(std::move(result));
 }
-#endif
+
+void ScheduleBenchmarks(HWND hWnd) noexcept
+{
+    Debug::Info(L"Benchmarks: scheduling");
+    if (SetTimer(hWnd, kBenchmarksTimerId, kBenchmarksStartDelayMs, nullptr) != 0)
+    {
+        return;
+    }
+
+    const HRESULT hr     = HRESULT_FROM_WIN32(GetLastError());
+    std::wstring message = std::format(L"Benchmarks: SetTimer failed: 0x{:08X}", static_cast<unsigned>(hr));
+    Debug::Error(L"{}", message);
+    SelfTest::AppendSelfTestTrace(message);
+
+    SelfTest::SelfTestSuiteResult failure{};
+    failure.suite          = SelfTest::SelfTestSuite::Benchmarks;
+    failure.failed         = 1;
+    failure.failureMessage = std::move(message);
+    RecordSelfTestSuite(std::move(failure));
+
+    g_selfTestExitCode |= 1;
+    TraceSelfTestExitCode(L"Benchmarks: scheduling failed", g_selfTestExitCode);
+    FinalizeSelfTestRun();
+    PostMessageW(hWnd, WM_CLOSE, 0, 0);
+}
+
+void RunScheduledBenchmarks(HWND hWnd) noexcept
+{
+    KillTimer(hWnd, kBenchmarksTimerId);
+
+    SelfTest::SelfTestSuiteResult benchmarksResult;
+    Debug::Info(L"Benchmarks: running");
+    SelfTest::InitSelfTestRun(g_selfTestOptions);
+    SelfTest::AppendSelfTestTrace(L"Benchmarks: begin");
+    g_selfTestExitCode |= BenchmarksSelfTest::Run(hWnd, g_selfTestOptions, &benchmarksResult) ? 0 : 1;
+    SelfTest::AppendSelfTestTrace(benchmarksResult.failed != 0 ? L"Benchmarks: FAIL" : L"Benchmarks: PASS");
+    if (! benchmarksResult.failureMessage.empty())
+    {
+        SelfTest::AppendSelfTestTrace(benchmarksResult.failureMessage);
+    }
+    RecordSelfTestSuite(std::move(benchmarksResult));
+    TraceSelfTestExitCode(L"Benchmarks: end", g_selfTestExitCode);
+    FinalizeSelfTestRun();
+    PostMessageW(hWnd, WM_CLOSE, 0, 0);
+}
 
 HMENU g_leftPaneMenu    = nullptr;
 HMENU g_leftSortMenu    = nullptr;
@@ -602,6 +669,11 @@ LRESULT OnMainWindowTimer(HWND hWnd, UINT_PTR timerId) noexcept
                 SelfTest::AppendSelfTestTrace(L"FileOpsSelfTest: PASS");
             }
             TraceSelfTestExitCode(L"FileOpsSelfTest: end", g_selfTestExitCode);
+            if (g_runBenchmarks)
+            {
+                ScheduleBenchmarks(hWnd); // runs after the file-operations suite so the two never interleave
+                return 0;
+            }
             FinalizeSelfTestRun();
             PostMessageW(hWnd, WM_CLOSE, 0, 0);
         }
@@ -609,6 +681,12 @@ LRESULT OnMainWindowTimer(HWND hWnd, UINT_PTR timerId) noexcept
     }
 #endif
 
+    if (timerId == kBenchmarksTimerId)
+    {
+        RunScheduledBenchmarks(hWnd);
+        return 0;
+    }
+
     if (timerId != kFunctionBarPressedKeyClearTimerId)
     {
         return DefWindowProcW(hWnd, WM_TIMER, timerId, 0);
@@ -688,6 +766,7 @@ Common::Settings::FolderDisplayMode DisplayModeToSettings(FolderView::DisplayMod
         case FolderView::DisplayMode::Brief: return Common::Settings::FolderDisplayMode::Brief;
         case FolderView::DisplayMode::Detailed: return Common::Settings::FolderDisplayMode::Detailed;
         case FolderView::DisplayMode::ExtraDetailed: return Common::Settings::FolderDisplayMode::Detailed;
+        case FolderView::DisplayMode::Thumbnails: return Common::Settings::FolderDisplayMode::Brief;
     }
     return Common::Settings::FolderDisplayMode::Brief;
 }
@@ -1107,6 +1186,7 @@ void SaveAppSettings(HWND hWnd) noexcept
     }
     FileSystemPluginManager::GetInstance().Shutdown(g_settings);
     ViewerPluginManager::GetInstance().Shutdown(g_settings);
+    IconCache::GetInstance().SavePersistentCache();
 
     const HRESULT saveHr = Common::Settings::SaveSettings(kAppId, SettingsSave::PrepareForSave(g_settings));
     if (SUCCEEDED(saveHr))
@@ -1825,7 +1905,8 @@ void UpdatePaneMenuChecks() noexcept
 
         const FolderView::DisplayMode display = g_folderWindow.GetDisplayMode(pane);
         const UINT displayChecked             = displayBase + static_cast<UINT>(display);
-        CheckMenuRadioItem(displayMenu, displayBase, displayBase + 1, displayChecked, MF_BYCOMMAND);
+        const UINT displayLast                = displayBase + static_cast<UINT>(FolderView::DisplayMode::Thumbnails);
+        CheckMenuRadioItem(displayMenu, displayBase, displayLast, displayChecked, MF_BYCOMMAND);
     };
 
     if (g_leftSortMenu && g_leftDisplayMenu)
@@ -2259,6 +2340,8 @@ void SplitMenuText(std::wstring_view raw, std::wstring& text, std::wstring& shor
         case IDM_RIGHT_DISPLAY_BRIEF: return L"cmd/pane/display/brief";
         case IDM_LEFT_DISPLAY_DETAILED:
         case IDM_RIGHT_DISPLAY_DETAILED: return L"cmd/pane/display/detailed";
+        case IDM_LEFT_DISPLAY_THUMBNAILS:
+        case IDM_RIGHT_DISPLAY_THUMBNAILS: return L"cmd/pane/display/thumbnails";
 
         case IDM_LEFT_SORT_NONE:
         case IDM_RIGHT_SORT_NONE: return L"cmd/pane/sort/none";
@@ -3966,6 +4049,7 @@ static int RunApplication(HINSTANCE hInstance, int nCmdShow)
             L"Options:\r\n"
             L"  -h, --help, /?                 Show this help.\r\n"
             L"  --crash-test                    Trigger crash handler test.\r\n"
+            L"  --benchmarks                    Run the Benchmarks suite (timings + diff vs previous run) and exit.\r\n"
 #ifdef _DEBUG
             L"  --selftest                      Run all debug self-test suites and exit.\r\n"
             L"  --compare-selftest              Run CompareDirectories self-test suite.\r\n"
@@ -4029,7 +4113,6 @@ static int RunApplication(HINSTANCE hInstance, int nCmdShow)
         CrashHandler::TriggerCrashTest();
     }
 
-#ifdef _DEBUG
     g_selfTestOptions                  = SelfTest::GetSelfTestOptions();
     g_selfTestOptions.failFast         = hasArg(L"--selftest-fail-fast");
     g_selfTestOptions.timeoutScale     = 1.0;
@@ -4050,6 +4133,9 @@ static int RunApplication(HINSTANCE hInstance, int nCmdShow)
     SelfTest::GetSelfTestOptions() = g_selfTestOptions;
     SelfTest::InitSelfTestRun(g_selfTestOptions);
 
+    g_runBenchmarks = hasArg(L"--benchmarks");
+
+#ifdef _DEBUG
     if (hasArg(L"--selftest"))
     {
         g_runFileOpsSelfTest              = true;
@@ -4073,14 +4159,14 @@ static int RunApplication(HINSTANCE hInstance, int nCmdShow)
     {
         g_runCommandsSelfTest = true;
     }
+#endif
 
-    if (g_runFileOpsSelfTest || g_runCompareDirectoriesSelfTest || g_runCommandsSelfTest)
+    if (IsSelfTestRunRequested())
     {
         SelfTest::GetSelfTestOptions() = g_selfTestOptions;
         SelfTest::RotateSelfTestRuns();
         ResetSelfTestRunState();
     }
-#endif
 
     HRESULT comHr       = S_OK;
     bool comInitialized = false;
@@ -4425,13 +4511,11 @@ static int RunApplication(HINSTANCE hInstance, int nCmdShow)
     }
 
     const int exitCode = static_cast<int>(msg.wParam);
-#ifdef _DEBUG
-    if (g_runFileOpsSelfTest || g_runCompareDirectoriesSelfTest || g_runCommandsSelfTest)
+    if (IsSelfTestRunRequested())
     {
         SelfTest::AppendSelfTestTrace(std::format(L"RunApplication: message loop exit={}", exitCode));
         FinalizeSelfTestRun();
     }
-#endif
     return exitCode;
 }
 
@@ -4939,10 +5023,19 @@ LRESULT OnMainWindowCreate(HWND hWnd, [[maybe_unused]] const CREATESTRUCTW* crea
         }
     }
 
-    if ((g_runCompareDirectoriesSelfTest || g_runCommandsSelfTest) && ! g_runFileOpsSelfTest)
+    if (g_runBenchmarks && ! g_runFileOpsSelfTest)
+    {
+        ScheduleBenchmarks(hWnd);
+    }
+    else if (IsSelfTestRunRequested() && ! g_runFileOpsSelfTest)
     {
         PostMessageW(hWnd, WM_CLOSE, 0, 0);
     }
+#else
+    if (g_runBenchmarks)
+    {
+        ScheduleBenchmarks(hWnd);
+    }
 #endif
 
     wmCreatePerf.SetHr(S_OK);
@@ -5775,6 +5868,7 @@ LRESULT OnMainWindowCommand(HWND hWnd, UINT id, UINT codeNotify, HWND hwndCtl)
         case IDM_PANE_DISPLAY_BRIEF:
         case IDM_PANE_DISPLAY_DETAILED:
         case IDM_PANE_DISPLAY_EXTRA_DETAILED:
+        case IDM_PANE_DISPLAY_THUMBNAILS:
         {
             const FolderWindow::Pane pane = g_folderWindow.GetFocusedPane();
             g_folderWindow.SetActivePane(pane);
@@ -5785,6 +5879,7 @@ LRESULT OnMainWindowCommand(HWND hWnd, UINT id, UINT codeNotify, HWND hwndCtl)
                 case IDM_PANE_DISPLAY_BRIEF: mode = FolderView::DisplayMode::Brief; break;
                 case IDM_PANE_DISPLAY_DETAILED: mode = FolderView::DisplayMode::Detailed; break;
                 case IDM_PANE_DISPLAY_EXTRA_DETAILED: mode = FolderView::DisplayMode::ExtraDetailed; break;
+                case IDM_PANE_DISPLAY_THUMBNAILS: mode = FolderView::DisplayMode::Thumbnails; break;
             }
             g_folderWindow.SetDisplayMode(pane, mode);
             break;
@@ -5825,6 +5920,10 @@ LRESULT OnMainWindowCommand(HWND hWnd, UINT id, UINT codeNotify, HWND hwndCtl)
             g_folderWindow.SetActivePane(FolderWindow::Pane::Left);
             g_folderWindow.SetDisplayMode(FolderWindow::Pane::Left, FolderView::DisplayMode::ExtraDetailed);
             break;
+        case IDM_LEFT_DISPLAY_THUMBNAILS:
+            g_folderWindow.SetActivePane(FolderWindow::Pane::Left);
+            g_folderWindow.SetDisplayMode(FolderWindow::Pane::Left, FolderView::DisplayMode::Thumbnails);
+            break;
         case IDM_RIGHT_SORT_NAME:
             g_folderWindow.SetActivePane(FolderWindow::Pane::Right);
             g_folderWindow.CycleSortBy(FolderWindow::Pane::Right, FolderView::SortBy::Name);
@@ -5861,6 +5960,10 @@ LRESULT OnMainWindowCommand(HWND hWnd, UINT id, UINT codeNotify, HWND hwndCtl)
             g_folderWindow.SetActivePane(FolderWindow::Pane::Right);
             g_folderWindow.SetDisplayMode(FolderWindow::Pane::Right, FolderView::DisplayMode::ExtraDetailed);
             break;
+        case IDM_RIGHT_DISPLAY_THUMBNAILS:
+            g_folderWindow.SetActivePane(FolderWindow::Pane::Right);
+            g_folderWindow.SetDisplayMode(FolderWindow::Pane::Right, FolderView::DisplayMode::Thumbnails);
+            break;
         case IDM_LEFT_OVERLAY_SAMPLE_ERROR:
             if (! IsOverlaySampleEnabled())
             {
@@ -6318,8 +6421,7 @@ LRESULT OnMainWindowConnectionManagerConnect([[maybe_unused]] HWND hWnd, WPARAM
 
 LRESULT OnMainWindowClose(HWND hWnd)
 {
-#ifdef _DEBUG
-    if (g_runFileOpsSelfTest || g_runCompareDirectoriesSelfTest || g_runCommandsSelfTest)
+    if (IsSelfTestRunRequested())
     {
         if (! DestroyWindow(hWnd))
         {
@@ -6327,7 +6429,6 @@ LRESULT OnMainWindowClose(HWND hWnd)
         }
         return 0;
     }
-#endif
 
     if (! g_folderWindow.ConfirmCancelAllFileOperations(hWnd))
     {
@@ -6344,12 +6445,16 @@ LRESULT OnMainWindowDestroy(HWND hWnd)
 
 #ifdef _DEBUG
     ShutdownSelfTestMonitor();
-    TraceSelfTestExitCode(
-        L"OnMainWindowDestroy: PostQuitMessage", (g_runFileOpsSelfTest || g_runCompareDirectoriesSelfTest || g_runCommandsSelfTest) ? g_selfTestExitCode : 0);
-    PostQuitMessage((g_runFileOpsSelfTest || g_runCompareDirectoriesSelfTest || g_runCommandsSelfTest) ? g_selfTestExitCode : 0);
-#else
-    PostQuitMessage(0);
 #endif
+    if (IsSelfTestRunRequested())
+    {
+        TraceSelfTestExitCode(L"OnMainWindowDestroy: PostQuitMessage", g_selfTestExitCode);
+        PostQuitMessage(g_selfTestExitCode);
+    }
+    else
+    {
+        PostQuitMessage(0);
+    }
 
     return 0;
 }
@@ -692,6 +692,7 @@
 #define IDS_CMD_DISPLAY_BRIEF 356
 #define IDS_CMD_DISPLAY_DETAILED 357
 #define IDS_CMD_DISPLAY_EXTRA_DETAILED 600
+#define IDS_CMD_DISPLAY_THUMBNAILS 602
 #define IDS_MOD_CTRL 358
 #define IDS_MOD_ALT 359
 #define IDS_MOD_SHIFT 360
@@ -754,6 +755,7 @@
 #define IDS_CMD_DESC_DISPLAY_BRIEF 417
 #define IDS_CMD_DESC_DISPLAY_DETAILED 418
 #define IDS_CMD_DESC_DISPLAY_EXTRA_DETAILED 601
+#define IDS_CMD_DESC_DISPLAY_THUMBNAILS 603
 #define IDS_SHORTCUTS_SEARCH_CUE 419
 #define IDS_CMD_DESC_EDIT 420
 #define IDS_CMD_DESC_EDIT_NEW 421
@@ -1177,6 +1179,7 @@
 #define IDM_PANE_DISPLAY_BRIEF 33010
 #define IDM_PANE_DISPLAY_DETAILED 33011
 #define IDM_PANE_DISPLAY_EXTRA_DETAILED 33012
+#define IDM_PANE_DISPLAY_THUMBNAILS 33013
 #define IDM_PANE_RENAME 33020
 #define IDM_PANE_VIEW 33021
 #define IDM_PANE_COPY_TO_OTHER 33022
@@ -1255,6 +1258,7 @@
 #define IDM_LEFT_DISPLAY_BRIEF 33110
 #define IDM_LEFT_DISPLAY_DETAILED 33111
 #define IDM_LEFT_DISPLAY_EXTRA_DETAILED 33112
+#define IDM_LEFT_DISPLAY_THUMBNAILS 33113
 #define IDM_LEFT_STATUSBAR 33120
 #define IDM_LEFT_CHANGE_DRIVE 33130
 #define IDM_LEFT_GO_TO_BACK 33131
@@ -1275,6 +1279,7 @@
 #define IDM_RIGHT_DISPLAY_BRIEF 33210
 #define IDM_RIGHT_DISPLAY_DETAILED 33211
 #define IDM_RIGHT_DISPLAY_EXTRA_DETAILED 33212
+#define IDM_RIGHT_DISPLAY_THUMBNAILS 33213
 #define IDM_RIGHT_STATUSBAR 33220
 #define IDM_RIGHT_CHANGE_DRIVE 33230
 #define IDM_RIGHT_GO_TO_BACK 33231
@@ -1,5 +1,3 @@
-#ifdef _DEBUG
-
 #include "SelfTestCommon.h"
 
 #include <array>
@@ -41,10 +39,12 @@ constexpr std::wstring_view kPreviousRunDirName{L"previous_run"};
 constexpr std::wstring_view kCompareDirName{L"compare"};
 constexpr std::wstring_view kFileOpsDirName{L"fileops"};
 constexpr std::wstring_view kCommandsDirName{L"commands"};
+constexpr std::wstring_view kBenchmarksDirName{L"benchmarks"};
 constexpr std::wstring_view kTraceFileName{L"trace.txt"};
 constexpr const char* kSuiteCompareName = "CompareDirectories";
 constexpr const char* kSuiteFileOpsName = "FileOperations";
 constexpr const char* kSuiteCommandsName = "Commands";
+constexpr const char* kSuiteBenchmarksName = "Benchmarks";
 
 SelfTestOptions g_options{};
 std::wstring g_runStartedUtcIso;
@@ -78,6 +78,18 @@ std::wstring g_runStartedUtcIso;
     return std::filesystem::path(buffer);
 }
 
+[[nodiscard]] std::wstring_view SuiteDirName(SelfTestSuite suite) noexcept
+{
+    switch (suite)
+    {
+        case SelfTestSuite::CompareDirectories: return kCompareDirName;
+        case SelfTestSuite::FileOperations: return kFileOpsDirName;
+        case SelfTestSuite::Commands: return kCommandsDirName;
+        case SelfTestSuite::Benchmarks: return kBenchmarksDirName;
+    }
+    return {};
+}
+
 [[nodiscard]] const char* SuiteName(SelfTestSuite suite) noexcept
 {
     switch (suite)
@@ -85,6 +97,7 @@ std::wstring g_runStartedUtcIso;
         case SelfTestSuite::CompareDirectories: return kSuiteCompareName;
         case SelfTestSuite::FileOperations: return kSuiteFileOpsName;
         case SelfTestSuite::Commands: return kSuiteCommandsName;
+        case SelfTestSuite::Benchmarks: return kSuiteBenchmarksName;
     }
     return "Unknown";
 }
@@ -248,6 +261,41 @@ void AddCaseJson(yyjson_mut_doc* doc, yyjson_mut_val* casesArray, const SelfTest
         }
     }
 
+    if (testCase.benchmark.has_value())
+    {
+        const SelfTestBenchmarkStats& stats = testCase.benchmark.value();
+        yyjson_mut_val* benchObj            = yyjson_mut_obj(doc);
+        if (benchObj)
+        {
+            yyjson_mut_obj_add_uint(doc, benchObj, "iterations", stats.iterations);
+            yyjson_mut_obj_add_uint(doc, benchObj, "min_us", stats.minUs);
+            yyjson_mut_obj_add_uint(doc, benchObj, "p50_us", stats.p50Us);
+            yyjson_mut_obj_add_uint(doc, benchObj, "p95_us", stats.p95Us);
+            yyjson_mut_obj_add_uint(doc, benchObj, "p99_us", stats.p99Us);
+            yyjson_mut_obj_add_uint(doc, benchObj, "max_us", stats.maxUs);
+            yyjson_mut_obj_add_real(doc, benchObj, "mean_us", stats.meanUs);
+            yyjson_mut_obj_add_uint(doc, benchObj, "items_per_iteration", stats.itemsPerIteration);
+            yyjson_mut_obj_add_uint(doc, benchObj, "bytes_per_iteration", stats.bytesPerIteration);
+            if (stats.memoryBytes > 0)
+            {
+                yyjson_mut_obj_add_uint(doc, benchObj, "memory_bytes", stats.memoryBytes);
+            }
+            if (stats.p50Us > 0)
+            {
+                const double seconds = static_cast<double>(stats.p50Us) / 1'000'000.0;
+                yyjson_mut_obj_add_real(doc, benchObj, "items_per_s", static_cast<double>(stats.itemsPerIteration) / seconds);
+                yyjson_mut_obj_add_real(doc, benchObj, "bytes_per_s", static_cast<double>(stats.bytesPerIteration) / seconds);
+            }
+            if (stats.baselineP50Us > 0)
+            {
+                yyjson_mut_obj_add_uint(doc, benchObj, "baseline_p50_us", stats.baselineP50Us);
+                yyjson_mut_obj_add_real(doc, benchObj, "delta_percent", stats.deltaPercent);
+            }
+            yyjson_mut_obj_add_bool(doc, benchObj, "regressed", stats.regressed);
+            yyjson_mut_obj_add_val(doc, caseObj, "benchmark", benchObj);
+        }
+    }
+
     static_cast<void>(yyjson_mut_arr_add_val(casesArray, caseObj));
 }
 
@@ -328,13 +376,10 @@ std::filesystem::path GetSuiteRoot(SelfTestSuite suite)
         return {};
     }
 
-    std::filesystem::path suiteDir;
-    switch (suite)
+    const std::wstring_view suiteDir = SuiteDirName(suite);
+    if (suiteDir.empty())
     {
-        case SelfTestSuite::CompareDirectories: suiteDir = kCompareDirName; break;
-        case SelfTestSuite::FileOperations: suiteDir = kFileOpsDirName; break;
-        case SelfTestSuite::Commands: suiteDir = kCommandsDirName; break;
-        default: return {};
+        return {};
     }
     return root / kLastRunDirName / suiteDir;
 }
@@ -350,6 +395,18 @@ std::filesystem::path GetSuiteArtifactPath(SelfTestSuite suite, std::wstring_vie
     return suiteRoot / filename;
 }
 
+std::filesystem::path GetPreviousSuiteArtifactPath(SelfTestSuite suite, std::wstring_view filename)
+{
+    const std::filesystem::path root = SelfTestRoot();
+    const std::wstring_view suiteDir = SuiteDirName(suite);
+    if (root.empty() || suiteDir.empty() || filename.empty())
+    {
+        return {};
+    }
+
+    return root / kPreviousRunDirName / suiteDir / filename;
+}
+
 wil::com_ptr<IFileSystem> GetFileSystem(std::wstring_view pluginId) noexcept
 {
     if (pluginId.empty())
@@ -378,6 +435,55 @@ wil::com_ptr<IFileSystem> GetFileSystem(std::wstring_view pluginId) noexcept
     return {};
 }
 
+bool BackupPluginConfiguration(IInformations* info, std::string& outConfigUtf8) noexcept
+{
+    if (! info)
+    {
+        return false;
+    }
+
+    const char* config = nullptr;
+    const HRESULT hr   = info->GetConfiguration(&config);
+    if (FAILED(hr) || ! config)
+    {
+        return false;
+    }
+
+    outConfigUtf8 = config;
+    return true;
+}
+
+bool SetPluginConfiguration(IInformations* info, std::string_view configUtf8) noexcept
+{
+    if (! info)
+    {
+        return false;
+    }
+
+    std::string owned(configUtf8);
+    owned.push_back('\0');
+    const HRESULT hr = info->SetConfiguration(owned.c_str());
+    return SUCCEEDED(hr);
+}
+
+PluginConfigurationGuard::PluginConfigurationGuard(IFileSystem* fileSystem, std::string_view configuration) noexcept
+{
+    if (! fileSystem || FAILED(fileSystem->QueryInterface(__uuidof(IInformations), _info.put_void())) || ! _info)
+    {
+        return;
+    }
+
+    _applied = BackupPluginConfiguration(_info.get(), _saved) && SetPluginConfiguration(_info.get(), configuration);
+}
+
+PluginConfigurationGuard::~PluginConfigurationGuard()
+{
+    if (_applied)
+    {
+        static_cast<void>(SetPluginConfiguration(_info.get(), _saved));
+    }
+}
+
 // Rotate artifacts: previous_run/ is discarded, last_run/ is renamed to previous_run/,
 // and fresh empty directories are created under last_run/ ready for the new run.
 void RotateSelfTestRuns()
@@ -409,11 +515,13 @@ void RotateSelfTestRuns()
     std::filesystem::create_directories(lastRun / kCompareDirName, ec);
     std::filesystem::create_directories(lastRun / kFileOpsDirName, ec);
     std::filesystem::create_directories(lastRun / kCommandsDirName, ec);
+    std::filesystem::create_directories(lastRun / kBenchmarksDirName, ec);
 
     TruncateUtf16Log(lastRun / kTraceFileName);
     TruncateUtf16Log(lastRun / kCompareDirName / kTraceFileName);
     TruncateUtf16Log(lastRun / kFileOpsDirName / kTraceFileName);
     TruncateUtf16Log(lastRun / kCommandsDirName / kTraceFileName);
+    TruncateUtf16Log(lastRun / kBenchmarksDirName / kTraceFileName);
 }
 
 void InitSelfTestRun(const SelfTestOptions& options)
@@ -535,6 +643,42 @@ bool WriteTextFile(const std::filesystem::path& path, std::string_view text)
     return WriteBinaryFile(path, std::as_bytes(std::span<const char>(text)));
 }
 
+bool ReadBinaryFile(const std::filesystem::path& path, std::string& outBytes) noexcept
+{
+    outBytes.clear();
+    if (path.empty())
+    {
+        return false;
+    }
+
+    wil::unique_handle file(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+    if (! file)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (! GetFileSizeEx(file.get(), &size) || size.QuadPart < 0 || static_cast<uint64_t>(size.QuadPart) > std::numeric_limits<DWORD>::max())
+    {
+        return false;
+    }
+
+    outBytes.resize(static_cast<size_t>(size.QuadPart));
+    size_t offset = 0;
+    while (offset < outBytes.size())
+    {
+        DWORD read = 0;
+        if (! ReadFile(file.get(), outBytes.data() + offset, static_cast<DWORD>(outBytes.size() - offset), &read, nullptr) || read == 0)
+        {
+            outBytes.clear();
+            return false;
+        }
+        offset += static_cast<size_t>(read);
+    }
+
+    return true;
+}
+
 std::filesystem::path GetTempRoot(SelfTestSuite suite)
 {
     const std::filesystem::path suiteRoot = GetSuiteRoot(suite);
@@ -704,5 +848,3 @@ void WriteRunJson(const SelfTestRunResult& result, const std::filesystem::path&
 }
 
 } // namespace SelfTest
-
-#endif // _DEBUG
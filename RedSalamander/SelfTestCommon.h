@@ -1,15 +1,13 @@
 #pragma once
 
-// SelfTestCommon - debug-only self-test infrastructure shared by all suites.
+// SelfTestCommon - self-test infrastructure shared by all suites.
 //
 // Artifacts are written to:
 //   %LOCALAPPDATA%\RedSalamander\SelfTest\last_run\   (current run)
 //   %LOCALAPPDATA%\RedSalamander\SelfTest\previous_run\  (previous run, kept for diffing)
 //
-// Everything in this header is compiled only in _DEBUG builds.  Release builds produce
-// empty stub implementations so that call-sites do not need conditional compilation.
-
-#ifdef _DEBUG
+// The infrastructure is compiled in every configuration so the Benchmarks suite can run against
+// release binaries; the correctness suites (CompareDirectories, FileOperations, Commands) remain _DEBUG-only.
 
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
@@ -19,6 +17,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -28,6 +27,7 @@
 #include <wil/com.h>
 
 struct IFileSystem;
+struct IInformations;
 
 namespace SelfTest
 {
@@ -37,6 +37,7 @@ enum class SelfTestSuite
     CompareDirectories,
     FileOperations,
     Commands,
+    Benchmarks,
 };
 
 struct SelfTestOptions
@@ -49,6 +50,27 @@ struct SelfTestOptions
     bool writeJsonSummary = true;
 };
 
+// Timing summary for one benchmark case (microseconds, nearest-rank percentiles over the measured iterations).
+struct SelfTestBenchmarkStats
+{
+    uint32_t iterations = 0;
+    uint64_t minUs      = 0;
+    uint64_t p50Us      = 0;
+    uint64_t p95Us      = 0;
+    uint64_t p99Us      = 0;
+    uint64_t maxUs      = 0;
+    double meanUs       = 0.0;
+    // Work done by one iteration (entries, files, bytes...); used to derive throughput.
+    uint64_t itemsPerIteration = 0;
+    uint64_t bytesPerIteration = 0;
+    // Bytes held by the structure the case builds, for memory comparisons (0 when the case does not report memory).
+    uint64_t memoryBytes = 0;
+    // p50 of the same case in the benchmark baseline (0 when there is no baseline).
+    uint64_t baselineP50Us = 0;
+    double deltaPercent    = 0.0;
+    bool regressed         = false;
+};
+
 struct SelfTestCaseResult
 {
     std::wstring name;
@@ -61,6 +83,7 @@ struct SelfTestCaseResult
 
     uint64_t durationMs = 0;
     std::wstring reason;
+    std::optional<SelfTestBenchmarkStats> benchmark;
 };
 
 struct SelfTestSuiteResult
@@ -80,6 +103,14 @@ void AppendSuiteTrace(SelfTestSuite suite, std::wstring_view msg) noexcept;
 struct CaseState
 {
     std::wstring failure;
+    std::wstring skipReason;
+    std::optional<SelfTestBenchmarkStats> benchmark;
+
+    // Marks the case skipped (an optional external prerequisite is not configured); the case then returns true.
+    void Skip(std::wstring_view reason) noexcept
+    {
+        skipReason.assign(reason);
+    }
 
     bool Require(bool condition, std::wstring_view message) noexcept
     {
@@ -124,6 +155,7 @@ void RunCase(const SelfTestOptions& options, SelfTestSuiteResult& suite, std::ws
     const auto endedAt = std::chrono::steady_clock::now();
 
     result.durationMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(endedAt - startedAt).count());
+    result.benchmark  = std::move(state.benchmark);
 
     if (! ok || ! state.failure.empty())
     {
@@ -139,6 +171,15 @@ void RunCase(const SelfTestOptions& options, SelfTestSuiteResult& suite, std::ws
         return;
     }
 
+    if (! state.skipReason.empty())
+    {
+        result.status = SelfTestCaseResult::Status::skipped;
+        result.reason = std::move(state.skipReason);
+        suite.cases.push_back(std::move(result));
+        ++suite.skipped;
+        return;
+    }
+
     result.status = SelfTestCaseResult::Status::passed;
     suite.cases.push_back(std::move(result));
     ++suite.passed;
@@ -157,8 +198,38 @@ SelfTestOptions& GetSelfTestOptions() noexcept;
 const std::filesystem::path& SelfTestRoot() noexcept;
 std::filesystem::path GetSuiteRoot(SelfTestSuite suite);
 std::filesystem::path GetSuiteArtifactPath(SelfTestSuite suite, std::wstring_view filename);
+// Same artifact in previous_run/ (as rotated by RotateSelfTestRuns); used by suites that diff against the previous run.
+std::filesystem::path GetPreviousSuiteArtifactPath(SelfTestSuite suite, std::wstring_view filename);
 wil::com_ptr<IFileSystem> GetFileSystem(std::wstring_view pluginId) noexcept;
 
+// Plugin configuration round trip through IInformations (suites reconfigure the shared plugin instances).
+[[nodiscard]] bool BackupPluginConfiguration(IInformations* info, std::string& outConfigUtf8) noexcept;
+[[nodiscard]] bool SetPluginConfiguration(IInformations* info, std::string_view configUtf8) noexcept;
+
+// Applies `configuration` to the plugin behind `fileSystem` for the guard's lifetime and restores the configuration it
+// replaced. Applied() is false, and the plugin is left untouched, when the plugin has no IInformations or rejects it.
+class PluginConfigurationGuard
+{
+public:
+    PluginConfigurationGuard(IFileSystem* fileSystem, std::string_view configuration) noexcept;
+    ~PluginConfigurationGuard();
+
+    PluginConfigurationGuard(const PluginConfigurationGuard&)            = delete;
+    PluginConfigurationGuard& operator=(const PluginConfigurationGuard&) = delete;
+    PluginConfigurationGuard(PluginConfigurationGuard&&)                 = delete;
+    PluginConfigurationGuard& operator=(PluginConfigurationGuard&&)      = delete;
+
+    [[nodiscard]] bool Applied() const noexcept
+    {
+        return _applied;
+    }
+
+private:
+    wil::com_ptr<IInformations> _info;
+    std::string _saved;
+    bool _applied = false;
+};
+
 void RotateSelfTestRuns();
 void InitSelfTestRun(const SelfTestOptions& options);
 
@@ -169,6 +240,7 @@ bool EnsureDirectory(const std::filesystem::path& path) noexcept;
 [[nodiscard]] bool WriteBinaryFile(const std::filesystem::path& path, std::span<const std::byte> bytes) noexcept;
 [[nodiscard]] bool WriteTextFile(const std::filesystem::path& path, std::wstring_view text);
 [[nodiscard]] bool WriteTextFile(const std::filesystem::path& path, std::string_view text);
+[[nodiscard]] bool ReadBinaryFile(const std::filesystem::path& path, std::string& outBytes) noexcept;
 
 std::filesystem::path GetTempRoot(SelfTestSuite suite);
 bool PathExists(const std::filesystem::path& p);
@@ -192,5 +264,3 @@ void WriteSuiteJson(const SelfTestSuiteResult& result, const std::filesystem::pa
 void WriteRunJson(const SelfTestRunResult& result, const std::filesystem::path& path);
 
 } // namespace SelfTest
-
-#endif // _DEBUG
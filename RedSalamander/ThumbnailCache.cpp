@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#define WINDOWS_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include <KnownFolders.h>
+#include <ShlObj.h>
+
+#pragma warning(push)
+// WIL: C4625 (copy ctor deleted), C4626 (copy assign deleted), C5026 (move ctor deleted), C5027 (move assign deleted)
+#pragma warning(disable : 4625 4626 5026 5027)
+#include <wil/result.h>
+#pragma warning(pop)
+
+#include "Helpers.h"
+#include "ThumbnailCache.h"
+
+#include "PlugInterfaces/Viewer.h"
+
+// Disk cache file layout (little-endian): ThumbnailFileHeader, UTF-16 key (keyChars, verified on load to rule out hash
+// collisions), then width * height 32bpp premultiplied BGRA pixels (top-down).
+
+namespace
+{
+constexpr wchar_t kCompanyDirName[]    = L"RedSalamander";
+constexpr wchar_t kCacheDirName[]      = L"Cache";
+constexpr wchar_t kThumbnailsDirName[] = L"Thumbnails";
+
+constexpr uint32_t kThumbnailFileMagic   = 0x4E545352u; // 'RSTN'
+constexpr uint16_t kThumbnailFileVersion = 1u;
+
+constexpr std::array<uint32_t, 3> kBucketsPx{96u, 160u, 256u};
+
+constexpr size_t kMaxMemoryBytes         = 64u * 1024u * 1024u;
+constexpr uint64_t kMaxDiskBytes         = 256ull * 1024ull * 1024ull;
+constexpr uint64_t kDiskTrimTargetBytes  = 192ull * 1024ull * 1024ull; // Trim below the limit so the next sessions don't trim again right away
+constexpr size_t kNegativeEntryCostBytes = 256u;
+
+struct ThumbnailFileHeader
+{
+    uint32_t magic    = 0;
+    uint16_t version  = 0;
+    uint16_t keyChars = 0;
+    uint32_t width    = 0;
+    uint32_t height   = 0;
+};
+static_assert(sizeof(ThumbnailFileHeader) == 16);
+
+[[nodiscard]] uint64_t HashThumbnailKey(std::wstring_view key) noexcept
+{
+    // FNV-1a over the UTF-16 code units
+    uint64_t hash = 14695981039346656037ull;
+    for (const wchar_t ch : key)
+    {
+        hash ^= static_cast<uint64_t>(static_cast<uint16_t>(ch));
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+[[nodiscard]] std::filesystem::path GetThumbnailDirectory() noexcept
+{
+    wil::unique_cotaskmem_string localAppData;
+    const HRESULT hr = SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, localAppData.put());
+    if (FAILED(hr) || ! localAppData)
+    {
+        return {};
+    }
+
+    return std::filesystem::path(localAppData.get()) / kCompanyDirName / kCacheDirName / kThumbnailsDirName;
+}
+
+[[nodiscard]] std::filesystem::path GetThumbnailFilePath(const std::filesystem::path& directory, uint32_t bucketPx, std::wstring_view key)
+{
+    return directory / std::to_wstring(bucketPx) / std::format(L"{:016x}.thumb", HashThumbnailKey(key));
+}
+
+[[nodiscard]] size_t GetImageCostBytes(const ThumbnailCache::Image* image) noexcept
+{
+    return image ? image->bgra.size() + sizeof(ThumbnailCache::Image) : kNegativeEntryCostBytes;
+}
+
+[[nodiscard]] bool ReadExact(HANDLE file, void* buffer, size_t bytes) noexcept
+{
+    if (bytes > std::numeric_limits<DWORD>::max())
+    {
+        return false;
+    }
+
+    DWORD read = 0;
+    return ReadFile(file, buffer, static_cast<DWORD>(bytes), &read, nullptr) && read == bytes;
+}
+
+[[nodiscard]] bool TryLoadThumbnailFile(const std::filesystem::path& path, std::wstring_view key, uint32_t bucketPx, ThumbnailCache::Image& out) noexcept
+{
+    wil::unique_hfile file(
+        CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+    if (! file)
+    {
+        return false;
+    }
+
+    ThumbnailFileHeader header{};
+    if (! ReadExact(file.get(), &header, sizeof(header)))
+    {
+        return false;
+    }
+
+    if (header.magic != kThumbnailFileMagic || header.version != kThumbnailFileVersion || header.keyChars != key.size() || header.width == 0 ||
+        header.height == 0 || header.width > bucketPx || header.height > bucketPx)
+    {
+        return false;
+    }
+
+    std::wstring storedKey(header.keyChars, L'\0');
+    if (! ReadExact(file.get(), storedKey.data(), storedKey.size() * sizeof(wchar_t)) || storedKey != key)
+    {
+        return false;
+    }
+
+    out.width  = header.width;
+    out.height = header.height;
+    out.bgra.resize(static_cast<size_t>(header.width) * header.height * 4u);
+    return ReadExact(file.get(), out.bgra.data(), out.bgra.size());
+}
+
+void SaveThumbnailFile(const std::filesystem::path& path, std::wstring_view key, const ThumbnailCache::Image& image) noexcept
+{
+    if (key.size() > std::numeric_limits<uint16_t>::max())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    ThumbnailFileHeader header{};
+    header.magic    = kThumbnailFileMagic;
+    header.version  = kThumbnailFileVersion;
+    header.keyChars = static_cast<uint16_t>(key.size());
+    header.width    = image.width;
+    header.height   = image.height;
+
+    std::vector<uint8_t> buffer(sizeof(header) + key.size() * sizeof(wchar_t) + image.bgra.size());
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + sizeof(header), key.data(), key.size() * sizeof(wchar_t));
+    std::memcpy(buffer.data() + sizeof(header) + key.size() * sizeof(wchar_t), image.bgra.data(), image.bgra.size());
+
+    // Write to a per-thread temp name and rename, so a concurrent reader never sees a partial file.
+    std::filesystem::path tempPath = path;
+    tempPath += std::format(L".{}.tmp", GetCurrentThreadId());
+    {
+        wil::unique_hfile file(CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (! file)
+        {
+            return;
+        }
+
+        DWORD written = 0;
+        if (! WriteFile(file.get(), buffer.data(), static_cast<DWORD>(buffer.size()), &written, nullptr) || written != buffer.size())
+        {
+            file.reset();
+            DeleteFileW(tempPath.c_str());
+            return;
+        }
+    }
+
+    if (! MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFileW(tempPath.c_str());
+    }
+}
+} // namespace
+
+ThumbnailCache& ThumbnailCache::GetInstance()
+{
+    static ThumbnailCache instance;
+    return instance;
+}
+
+uint32_t ThumbnailCache::SelectBucketPx(uint32_t desiredPx) noexcept
+{
+    for (const uint32_t bucketPx : kBucketsPx)
+    {
+        if (bucketPx >= desiredPx)
+        {
+            return bucketPx;
+        }
+    }
+    return kBucketsPx.back();
+}
+
+HRESULT ThumbnailCache::GetThumbnail(IViewerThumbnail* provider,
+                                     IFileSystem* fileSystem,
+                                     const std::wstring& path,
+                                     std::wstring_view cacheScope,
+                                     uint64_t sizeBytes,
+                                     int64_t lastWriteTime,
+                                     uint32_t bucketPx,
+                                     std::shared_ptr<const Image>& out) noexcept
+{
+    out.reset();
+    if (! provider || ! fileSystem || path.empty() || bucketPx == 0)
+    {
+        return E_INVALIDARG;
+    }
+
+    TrimDiskCacheOnce();
+
+    const std::wstring key = std::format(L"{}|{}|{}|{}|{}", cacheScope, path, sizeBytes, lastWriteTime, bucketPx);
+
+    HRESULT cachedHr = S_OK;
+    if (TryGetFromMemory(key, out, cachedHr))
+    {
+        _memoryHits.fetch_add(1u, std::memory_order_relaxed);
+        return cachedHr;
+    }
+
+    const std::filesystem::path directory = GetThumbnailDirectory();
+    const std::filesystem::path filePath  = directory.empty() ? std::filesystem::path{} : GetThumbnailFilePath(directory, bucketPx, key);
+
+    if (! filePath.empty())
+    {
+        auto image = std::make_shared<Image>();
+        if (TryLoadThumbnailFile(filePath, key, bucketPx, *image))
+        {
+            _diskHits.fetch_add(1u, std::memory_order_relaxed);
+            out = image;
+            StoreInMemory(key, std::move(image), S_OK);
+            return S_OK;
+        }
+    }
+
+    const size_t capacity = static_cast<size_t>(bucketPx) * bucketPx * 4u;
+    auto image            = std::make_shared<Image>();
+    image->bgra.resize(capacity);
+
+    ViewerThumbnailImage result{};
+    result.pixels        = image->bgra.data();
+    result.capacityBytes = capacity;
+
+    const HRESULT hr = provider->GetThumbnail(fileSystem, path.c_str(), bucketPx, &result);
+    if (FAILED(hr) || result.width == 0 || result.height == 0 || static_cast<uint64_t>(result.width) * result.height * 4u > capacity)
+    {
+        const HRESULT failHr = FAILED(hr) ? hr : E_UNEXPECTED;
+        _failed.fetch_add(1u, std::memory_order_relaxed);
+        StoreInMemory(key, nullptr, failHr);
+        return failHr;
+    }
+
+    image->width  = result.width;
+    image->height = result.height;
+    image->bgra.resize(static_cast<size_t>(result.width) * result.height * 4u);
+    image->bgra.shrink_to_fit();
+    _decoded.fetch_add(1u, std::memory_order_relaxed);
+
+    if (! filePath.empty())
+    {
+        SaveThumbnailFile(filePath, key, *image);
+    }
+
+    out = image;
+    StoreInMemory(key, std::move(image), S_OK);
+    return S_OK;
+}
+
+ThumbnailCache::Stats ThumbnailCache::GetStats() const noexcept
+{
+    Stats stats{};
+    stats.memoryHits = _memoryHits.load(std::memory_order_relaxed);
+    stats.diskHits   = _diskHits.load(std::memory_order_relaxed);
+    stats.decoded    = _decoded.load(std::memory_order_relaxed);
+    stats.failed     = _failed.load(std::memory_order_relaxed);
+
+    std::lock_guard lock(_mutex);
+    stats.memoryEntries = _lru.size();
+    stats.memoryBytes   = _memoryBytes;
+    return stats;
+}
+
+bool ThumbnailCache::TryGetFromMemory(const std::wstring& key, std::shared_ptr<const Image>& out, HRESULT& hr) noexcept
+{
+    std::lock_guard lock(_mutex);
+    const auto it = _index.find(key);
+    if (it == _index.end())
+    {
+        return false;
+    }
+
+    _lru.splice(_lru.begin(), _lru, it->second);
+    out = it->second->image;
+    hr  = it->second->hr;
+    return true;
+}
+
+void ThumbnailCache::StoreInMemory(const std::wstring& key, std::shared_ptr<const Image> image, HRESULT hr) noexcept
+{
+    const size_t cost = GetImageCostBytes(image.get());
+
+    std::lock_guard lock(_mutex);
+    if (const auto it = _index.find(key); it != _index.end())
+    {
+        _memoryBytes -= GetImageCostBytes(it->second->image.get());
+        _lru.erase(it->second);
+        _index.erase(it);
+    }
+
+    _lru.push_front(MemoryEntry{key, std::move(image), hr});
+    _index.emplace(key, _lru.begin());
+    _memoryBytes += cost;
+
+    while (_memoryBytes > kMaxMemoryBytes && _lru.size() > 1u)
+    {
+        const MemoryEntry& victim = _lru.back();
+        _memoryBytes -= GetImageCostBytes(victim.image.get());
+        _index.erase(victim.key);
+        _lru.pop_back();
+    }
+}
+
+void ThumbnailCache::TrimDiskCacheOnce() noexcept
+{
+    std::call_once(_diskTrimOnce,
+                   []
+                   {
+                       const std::filesystem::path directory = GetThumbnailDirectory();
+                       if (directory.empty())
+                       {
+                           return;
+                       }
+
+                       struct CachedFile
+                       {
+                           std::filesystem::file_time_type lastWrite;
+                           uint64_t bytes = 0;
+                           std::filesystem::path path;
+                       };
+
+                       std::vector<CachedFile> files;
+                       uint64_t totalBytes = 0;
+
+                       std::error_code ec;
+                       for (std::filesystem::recursive_directory_iterator it(directory, ec), end; ! ec && it != end; it.increment(ec))
+                       {
+                           std::error_code entryEc;
+                           if (! it->is_regular_file(entryEc))
+                           {
+                               continue;
+                           }
+
+                           CachedFile file;
+                           file.bytes     = it->file_size(entryEc);
+                           file.lastWrite = it->last_write_time(entryEc);
+                           file.path      = it->path();
+                           if (entryEc)
+                           {
+                               continue;
+                           }
+                           totalBytes += file.bytes;
+                           files.push_back(std::move(file));
+                       }
+
+                       if (totalBytes <= kMaxDiskBytes)
+                       {
+                           return;
+                       }
+
+                       std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) { return a.lastWrite < b.lastWrite; });
+
+                       size_t deleted = 0;
+                       for (const CachedFile& file : files)
+                       {
+                           if (totalBytes <= kDiskTrimTargetBytes)
+                           {
+                               break;
+                           }
+
+                           std::error_code removeEc;
+                           if (std::filesystem::remove(file.path, removeEc))
+                           {
+                               totalBytes -= file.bytes;
+                               ++deleted;
+                           }
+                       }
+
+                       DBGOUT_INFO(L"ThumbnailCache: Trimmed disk cache ({} files deleted, {} MB kept)", deleted, totalBytes / (1024u * 1024u));
+                   });
+}
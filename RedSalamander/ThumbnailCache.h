@@ -0,0 +1,96 @@
+#pragma once
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <Windows.h>
+
+struct IFileSystem;
+struct IViewerThumbnail;
+
+// Application-wide thumbnail cache for FolderView's Thumbnails display mode.
+// Thumbnails are produced by viewer plugins (IViewerThumbnail) and cached in two tiers:
+// - memory: LRU of decoded images, bounded by kMaxMemoryBytes (failures are remembered too, so broken files are not retried)
+// - disk: one file per thumbnail under %LOCALAPPDATA%\RedSalamander\Cache\Thumbnails\<bucket px>
+// Entries are keyed by file system scope + path + size + last write time + size bucket, so edits miss naturally.
+// Thread-safe; GetThumbnail is meant to be called from background workers.
+class ThumbnailCache
+{
+public:
+    // Decoded thumbnail: 32bpp BGRA, premultiplied alpha, top-down, stride = width * 4.
+    struct Image
+    {
+        uint32_t width  = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> bgra;
+    };
+
+    struct Stats
+    {
+        uint64_t memoryHits  = 0;
+        uint64_t diskHits    = 0;
+        uint64_t decoded     = 0;
+        uint64_t failed      = 0;
+        size_t memoryEntries = 0;
+        size_t memoryBytes   = 0;
+    };
+
+    static ThumbnailCache& GetInstance();
+
+    // Smallest size bucket (pixels) that covers desiredPx; buckets keep the disk cache reusable across DPI/zoom changes.
+    [[nodiscard]] static uint32_t SelectBucketPx(uint32_t desiredPx) noexcept;
+
+    // Returns S_OK with `out` set, or a failure HRESULT (HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED) when the provider can't decode the file).
+    // cacheScope identifies the file system instance (plugin id + instance context) so equal paths on different file systems don't collide.
+    HRESULT GetThumbnail(IViewerThumbnail* provider,
+                         IFileSystem* fileSystem,
+                         const std::wstring& path,
+                         std::wstring_view cacheScope,
+                         uint64_t sizeBytes,
+                         int64_t lastWriteTime,
+                         uint32_t bucketPx,
+                         std::shared_ptr<const Image>& out) noexcept;
+
+    [[nodiscard]] Stats GetStats() const noexcept;
+
+    ThumbnailCache(const ThumbnailCache&)            = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+    ThumbnailCache(ThumbnailCache&&)                 = delete;
+    ThumbnailCache& operator=(ThumbnailCache&&)      = delete;
+
+private:
+    ThumbnailCache()  = default;
+    ~ThumbnailCache() = default;
+
+    struct MemoryEntry
+    {
+        std::wstring key;
+        std::shared_ptr<const Image> image; // nullptr = decode failed (negative entry)
+        HRESULT hr = S_OK;
+    };
+
+    bool TryGetFromMemory(const std::wstring& key, std::shared_ptr<const Image>& out, HRESULT& hr) noexcept;
+    void StoreInMemory(const std::wstring& key, std::shared_ptr<const Image> image, HRESULT hr) noexcept;
+    void TrimDiskCacheOnce() noexcept;
+
+    mutable std::mutex _mutex;
+    std::list<MemoryEntry> _lru; // front = most recently used
+    std::unordered_map<std::wstring, std::list<MemoryEntry>::iterator> _index;
+    size_t _memoryBytes = 0;
+    std::once_flag _diskTrimOnce;
+
+    std::atomic<uint64_t> _memoryHits{0};
+    std::atomic<uint64_t> _diskHits{0};
+    std::atomic<uint64_t> _decoded{0};
+    std::atomic<uint64_t> _failed{0};
+};
@@ -8,9 +8,11 @@
 #include <atomic>
 #include <cmath>
 #include <cwctype>
+#include <execution>
 #include <fstream>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <thread>
 #include <utility>
 
@@ -122,6 +124,7 @@ ColorTextView::~ColorTextView()
 {
     // Clear atomic HWND first so ETW worker thread stops posting messages
     _hWndAtomic.store(nullptr, std::memory_order_release);
+    CancelSearch();
     // wil::critical_section (_etwQueueCS) cleans up automatically via RAII
 }
 
@@ -458,8 +461,10 @@ void ColorTextView::SetText(const std::wstring& text)
     _selEnd           = 0;
     _caretPos         = 0;
     _scrollY          = 0.0f;
+    CancelSearch();
     _matches.clear();
-    _matchIndex = -1;
+    _matchIndex        = -1;
+    _searchLinesQueued = 0;
 
     _textLayout.reset();
     _tailLayout.reset();
@@ -627,8 +632,10 @@ void ColorTextView::ClearText()
     _lineWidthCache.clear();
     _maxMeasuredWidth = 0.f;
     _maxMeasuredIndex = 0;
+    CancelSearch();
     _matches.clear();
-    _matchIndex = -1;
+    _matchIndex        = -1;
+    _searchLinesQueued = 0;
     _textLayout.reset();
     _tailLayout.reset();
     _fallbackLayout.reset();
@@ -776,7 +783,15 @@ void ColorTextView::GoToEnd(bool enableAutoScroll)
 void ColorTextView::FindNext(bool backward)
 {
     if (_matches.empty())
+    {
+        // First results of a background search are not in yet; jump once it completes
+        if (_searchRunning)
+        {
+            _findNextPending  = true;
+            _findNextBackward = backward;
+        }
         return;
+    }
 
     if (_matchIndex >= 0)
     {
@@ -4537,44 +4552,172 @@ void ColorTextView::CopySelectionToClipboard()
 
 void ColorTextView::RebuildMatches()
 {
-    _matches.clear();
-    _matchIndex = -1;
-
-    if (_search.empty() || _document.TotalLineCount() == 0)
-        return;
+    SearchKey key{_search, _searchCaseSensitive, _document.GetFilterMask(), _document.IsShowIds(), _document.ContentGeneration()};
+    const size_t totalLines = _document.TotalLineCount();
 
-    const auto addMatchesForLine = [&](size_t sourceIndex, const Line& line)
+    // Same query over a document that only grew: search just the new tail. The last covered line is searched again
+    // because AppendText may have extended it.
+    if (! _search.empty() && key == _searchKey && _searchLinesQueued > 0 && totalLines >= _searchLinesQueued)
     {
-        const UINT32 lineStart = _document.GetLineStartOffset(sourceIndex);
-        const UINT32 plen      = _document.PrefixLength(line);
-        size_t pos             = 0;
-        while (true)
+        if (_searchRunning)
         {
-            pos = _searchCaseSensitive ? line.text.find(_search, pos) : FindCaseIncensitive(line.text, _search, pos);
-            if (pos == std::wstring::npos)
-                break;
-            _matches.push_back(Line::ColorSpan{lineStart + plen + static_cast<UINT32>(pos), static_cast<UINT32>(_search.size()), _theme.searchHighlight});
-            pos += _search.size();
+            _searchTailPending = true;
+            return;
         }
-    };
 
-    // In filtered mode, only search visible lines. Otherwise FindNext() can land on hidden lines
-    // which makes caret/selection behavior confusing.
-    if (_document.GetFilterMask() != Debug::InfoParam::Type::All)
+        const size_t firstLine = _searchLinesQueued - 1;
+        _searchLinesQueued     = totalLines;
+        StartSearch(firstLine, totalLines);
+        return;
+    }
+
+    CancelSearch();
+    _matches.clear();
+    _matchIndex        = -1;
+    _searchKey         = std::move(key);
+    _searchLinesQueued = 0;
+
+    if (_search.empty() || totalLines == 0)
+        return;
+
+    _searchLinesQueued = totalLines;
+    StartSearch(0, totalLines);
+}
+
+void ColorTextView::StartSearch(size_t firstLine, size_t endLine)
+{
+    auto query = std::make_shared<const TextSearch::Query>(TextSearch::Query::Parse(_search, _searchCaseSensitive));
+    if (query->Empty() || firstLine >= endLine)
+        return;
+
+    const size_t firstChunk = firstLine / Document::kChunkLines;
+    const size_t endChunk   = (endLine + Document::kChunkLines - 1) / Document::kChunkLines;
+
+    // Small documents and live-append tails are searched inline so highlights stay in step with the text
+    if (endLine - firstLine <= kInlineSearchLines)
     {
-        for (const auto& visible : _document.VisibleLines())
+        std::vector<Document::SearchHit> hits;
+        for (size_t chunkIndex = firstChunk; chunkIndex < endChunk; ++chunkIndex)
+            _document.SearchChunk(*query, chunkIndex, firstLine, endLine, hits);
+        MergeSearchHits(firstLine, endLine, hits);
+        return;
+    }
+
+    const UINT32 seq = _searchSeq.load();
+    _searchRunning   = true;
+    _searchThread    = std::jthread(
+        [this, query, firstLine, endLine, firstChunk, endChunk, seq](std::stop_token stopToken) noexcept
         {
-            const auto& line = _document.GetSourceLine(visible.sourceIndex);
-            addMatchesForLine(visible.sourceIndex, line);
-        }
+            const auto post = [this](std::unique_ptr<SearchPacket> pkt) noexcept
+            {
+                const HWND hwnd = _hWndAtomic.load(std::memory_order_acquire);
+                if (hwnd && PostMessage(hwnd, WndMsg::kColorTextViewSearchResults, reinterpret_cast<WPARAM>(pkt.get()), 0))
+                    static_cast<void>(pkt.release());
+            };
+
+            std::vector<size_t> chunks(endChunk - firstChunk);
+            std::iota(chunks.begin(), chunks.end(), firstChunk);
+            std::for_each(std::execution::par,
+                          chunks.begin(),
+                          chunks.end(),
+                          [&](size_t chunkIndex) noexcept
+                          {
+                              if (stopToken.stop_requested())
+                                  return;
+
+                              auto pkt = wil::make_unique_nothrow<SearchPacket>();
+                              if (! pkt)
+                                  return;
+
+                              pkt->seq       = seq;
+                              pkt->firstLine = std::max(chunkIndex * Document::kChunkLines, firstLine);
+                              pkt->endLine   = std::min((chunkIndex + 1) * Document::kChunkLines, endLine);
+                              _document.SearchChunk(*query, chunkIndex, pkt->firstLine, pkt->endLine, pkt->hits);
+
+                              // Empty chunks only matter when they replace matches recorded for a re-searched tail line
+                              if (pkt->hits.empty() && pkt->firstLine != firstLine)
+                                  return;
+                              post(std::move(pkt));
+                          });
+
+            auto done = wil::make_unique_nothrow<SearchPacket>();
+            if (done)
+            {
+                done->seq  = seq;
+                done->done = true;
+                post(std::move(done));
+            }
+        });
+}
+
+void ColorTextView::CancelSearch()
+{
+    _searchSeq.fetch_add(1); // results already queued for the old search are dropped in OnAppSearchResults
+    _searchThread      = std::jthread(); // request_stop + join; workers bail out before their next chunk
+    _searchRunning     = false;
+    _searchTailPending = false;
+    _findNextPending   = false;
+}
+
+void ColorTextView::MergeSearchHits(size_t firstLine, size_t endLine, const std::vector<Document::SearchHit>& hits)
+{
+    const size_t totalLines = _document.TotalLineCount();
+    if (firstLine >= totalLines)
         return;
+
+    std::vector<Line::ColorSpan> spans;
+    _document.ResolveSearchHits(hits, _theme.searchHighlight, spans);
+
+    // Replace whatever is recorded for [firstLine, endLine) so re-searched tail lines never duplicate matches
+    const UINT32 rangeStart = _document.GetLineStartOffset(firstLine);
+    const UINT32 rangeEnd   = endLine < totalLines ? _document.GetLineStartOffset(endLine) : UINT32_MAX;
+    const auto byStart      = [](const Line::ColorSpan& span, UINT32 value) { return span.start < value; };
+    const auto first        = std::lower_bound(_matches.begin(), _matches.end(), rangeStart, byStart);
+    const auto last         = std::lower_bound(first, _matches.end(), rangeEnd, byStart);
+    const size_t insertAt   = static_cast<size_t>(std::distance(_matches.begin(), first));
+    const size_t erased     = static_cast<size_t>(std::distance(first, last));
+    if (erased == 0 && spans.empty())
+        return;
+
+    if (_matchIndex >= 0)
+    {
+        const size_t active = static_cast<size_t>(_matchIndex);
+        if (active >= insertAt + erased)
+            _matchIndex += static_cast<__int64>(spans.size()) - static_cast<__int64>(erased);
+        else if (active >= insertAt)
+            _matchIndex = -1;
     }
 
-    for (size_t i = 0; i < _document.TotalLineCount(); ++i)
+    _matches.erase(first, last);
+    _matches.insert(_matches.begin() + static_cast<ptrdiff_t>(insertAt), spans.begin(), spans.end());
+}
+
+LRESULT ColorTextView::OnAppSearchResults(SearchPacket* pkt)
+{
+    std::unique_ptr<SearchPacket> holder(pkt);
+    if (! pkt || pkt->seq != _searchSeq.load())
     {
-        const auto& line = _document.GetSourceLine(i);
-        addMatchesForLine(i, line);
+        return 0;
+    }
+
+    if (! pkt->done)
+    {
+        MergeSearchHits(pkt->firstLine, pkt->endLine, pkt->hits);
+        Invalidate();
+        return 0;
     }
+
+    // The worker posts `done` as its last action, so the join is immediate
+    _searchThread      = std::jthread();
+    _searchRunning     = false;
+    const bool tail    = std::exchange(_searchTailPending, false);
+    const bool findNow = std::exchange(_findNextPending, false);
+    if (tail)
+        RebuildMatches();
+    if (findNow)
+        FindNext(_findNextBackward);
+    Invalidate();
+    return 0;
 }
 
 // ---- Message dispatch ----
@@ -5034,6 +5177,7 @@ LRESULT ColorTextView::WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam
         case WndMsg::kColorTextViewLayoutReady: return OnAppLayoutReady(reinterpret_cast<LayoutPacket*>(wParam));
         case WndMsg::kColorTextViewEtwBatch: return OnAppEtwBatch();
         case WndMsg::kColorTextViewWidthReady: return OnAppWidthReady(reinterpret_cast<WidthPacket*>(wParam));
+        case WndMsg::kColorTextViewSearchResults: return OnAppSearchResults(reinterpret_cast<SearchPacket*>(wParam));
     }
     return DefWindowProc(hwnd, msg, wParam, lParam);
 }
@@ -16,6 +16,7 @@
 #include <optional>
 #include <shared_mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -148,6 +149,7 @@ private:
 
     struct LayoutPacket;
     struct WidthPacket;
+    struct SearchPacket;
 
     void OnCreate(const CREATESTRUCT* pCreateStruct);
     void OnEnterSizeMove();
@@ -169,6 +171,7 @@ private:
     LRESULT OnAppLayoutReady(LayoutPacket* pkt);
     LRESULT OnAppEtwBatch();
     LRESULT OnAppWidthReady(WidthPacket* pkt);
+    LRESULT OnAppSearchResults(SearchPacket* pkt);
 
     // Scrolling
     void ScrollBy(float dy);
@@ -221,6 +224,9 @@ private:
     void ClampScroll();
     void CopySelectionToClipboard();
     void RebuildMatches();
+    void StartSearch(size_t firstLine, size_t endLine);
+    void CancelSearch();
+    void MergeSearchHits(size_t firstLine, size_t endLine, const std::vector<Document::SearchHit>& hits);
     bool ValidateDeviceState() const;
     void LogSystemInfo() const;
     std::pair<size_t, size_t> GetVisibleLineRange() const;
@@ -363,6 +369,28 @@ private:
     bool _searchCaseSensitive = false;
     std::vector<Line::ColorSpan> _matches;
     __int64 _matchIndex = -1;
+    // Background search: chunks are searched on the parallel pool and merged as kColorTextViewSearchResults arrive.
+    // While the key is unchanged the document only grew, so later rebuilds just search the new tail lines.
+    static constexpr size_t kInlineSearchLines = 4 * Document::kChunkLines; // smaller ranges are searched on the UI thread
+    struct SearchKey
+    {
+        std::wstring text;
+        bool caseSensitive         = false;
+        uint32_t filterMask        = 0;
+        bool showIds               = false;
+        uint64_t contentGeneration = 0;
+
+        bool operator==(const SearchKey&) const = default;
+    };
+    SearchKey _searchKey;
+    size_t _searchLinesQueued = 0;     // source lines [0, _searchLinesQueued) are covered by finished or running searches
+    bool _searchRunning       = false; // a worker is still posting results
+    bool _searchTailPending   = false; // lines were appended while the worker was running
+    bool _findNextPending     = false; // FindNext() arrived before the first results
+    bool _findNextBackward    = false;
+    std::atomic<UINT32> _searchSeq{0};
+    std::jthread _searchThread;
+
     enum class FindStartMode : uint8_t
     {
         CurrentPosition = 0,
@@ -470,6 +498,15 @@ private:
         std::vector<size_t> indices;
         std::vector<float> widths;
     };
+    // structure for WndMsg::kColorTextViewSearchResults (one per searched chunk, plus a final `done` packet)
+    struct SearchPacket
+    {
+        UINT32 seq{};
+        bool done{};
+        size_t firstLine{};
+        size_t endLine{};
+        std::vector<Document::SearchHit> hits;
+    };
 
     // ETW event queue entry - accumulated from worker thread, batch-processed on UI thread
     struct EtwEventEntry
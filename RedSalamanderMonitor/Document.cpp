@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <array>
+#include <execution>
 #include <format>
+#include <numeric>
 
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
@@ -29,8 +31,98 @@ static std::wstring_view EmojiForType(Debug::InfoParam::Type t)
     }
 }
 
+// Documents with at least this many lines rebuild the visible-line index on the parallel algorithms pool
+static constexpr size_t kParallelRebuildLines = 64 * Document::kChunkLines;
+
+template <typename Fn> static void ForEachChunk(size_t chunkCount, bool parallel, Fn&& fn)
+{
+    if (! parallel)
+    {
+        for (size_t i = 0; i < chunkCount; ++i)
+            fn(i);
+        return;
+    }
+
+    std::vector<size_t> indices(chunkCount);
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    std::for_each(std::execution::par, indices.begin(), indices.end(), fn);
+}
+
 // --- Document Implementation ---
 
+uint32_t Document::TypeBitForLine(const Line& line) noexcept
+{
+    if (! line.hasMeta)
+        return kUntypedLineBit;
+
+    switch (line.meta.type)
+    {
+        case Debug::InfoParam::Type::Text: return 1u << 0;
+        case Debug::InfoParam::Type::Error: return 1u << 1;
+        case Debug::InfoParam::Type::Warning: return 1u << 2;
+        case Debug::InfoParam::Type::Info: return 1u << 3;
+        case Debug::InfoParam::Type::Debug: return 1u << 4;
+        case Debug::InfoParam::Type::All: return kAllTypeLineBit;
+        default: return 1u << 0; // unknown types filter like Text
+    }
+}
+
+uint64_t Document::IdBit(uint32_t id) noexcept
+{
+    // Windows pids/tids are multiples of 4; drop those bits before the Fibonacci hash so the 64 buckets are all used.
+    const uint32_t hash = (id >> 2) * 0x9E3779B1u;
+    return uint64_t{1} << (hash >> 26);
+}
+
+uint32_t Document::VisibleTypeBitsUnsafe() const noexcept
+{
+    return (_filterMask & Debug::InfoParam::Type::All) | kUntypedLineBit | kAllTypeLineBit;
+}
+
+void Document::IndexNewLinesUnsafe()
+{
+    // Caller must hold unique lock
+    if (_lineKeys.capacity() < _lines.capacity())
+        _lineKeys.reserve(_lines.capacity());
+
+    for (size_t i = _lineKeys.size(); i < _lines.size(); ++i)
+    {
+        const Line& line = _lines[i];
+        LineKey key;
+        key.newlineCount = line.newlineCount;
+        key.typeBit      = TypeBitForLine(line);
+        if (line.hasMeta)
+        {
+            key.processId = line.meta.processID;
+            key.threadId  = line.meta.threadID;
+        }
+
+        const size_t chunkIndex = i / kChunkLines;
+        if (chunkIndex == _chunks.size())
+            _chunks.emplace_back();
+
+        LineChunkSummary& chunk = _chunks[chunkIndex];
+        chunk.typeBits |= key.typeBit;
+        chunk.lineCount += 1u;
+        chunk.displayRows += key.newlineCount + 1u;
+        if (line.hasMeta)
+        {
+            chunk.processBits |= IdBit(key.processId);
+            chunk.threadBits |= IdBit(key.threadId);
+        }
+
+        _lineKeys.push_back(key);
+    }
+}
+
+void Document::ResetLineIndexUnsafe()
+{
+    // Caller must hold unique lock
+    _lineKeys.clear();
+    _chunks.clear();
+    ++_contentGeneration;
+}
+
 void Document::InvalidateCaches(CacheInvalidationReason reason)
 {
     switch (reason)
@@ -185,6 +277,7 @@ void Document::SetText(const std::wstring& text)
     std::unique_lock lock(_rwMutex); // Write operation
     _lines.clear();
     _visibleLines.clear(); // Clear visible lines when replacing all text
+    ResetLineIndexUnsafe();
     size_t start = 0;
     size_t end   = 0;
     while (end != std::wstring::npos)
@@ -201,6 +294,7 @@ void Document::SetText(const std::wstring& text)
         _lines.push_back(std::move(line));
         start = (end == std::wstring::npos) ? end : end + 1;
     }
+    IndexNewLinesUnsafe();
     InvalidateCaches();
     MarkAllDirtyUnsafe();  // Already holding lock
     RebuildVisibleLines(); // Rebuild visible lines after replacing all text
@@ -221,6 +315,8 @@ void Document::AppendText(const std::wstring& more)
         _lines.reserve(newCapacity);
     }
 
+    // Existing lines keep their visibility (text is only appended to the tail line), so only new lines need indexing
+    const size_t firstNewLine = _lines.size();
     if (_lines.empty())
         _lines.push_back(Line{});
     const size_t prevLineCount = _lines.size();
@@ -309,8 +405,8 @@ void Document::AppendText(const std::wstring& more)
         UpdateDirtyRange(firstDirty, lastIndex);
     }
 
-    // Rebuild visibleLines after bulk append since multiple lines may have been added
-    RebuildVisibleLines();
+    IndexNewLinesUnsafe();
+    AppendVisibleLinesUnsafe(firstNewLine);
 }
 
 void Document::AppendInfoLine(const std::wstring& text, const Debug::InfoParam& info)
@@ -376,18 +472,8 @@ void Document::AppendInfoLine(const std::wstring& text, const Debug::InfoParam&
     }
 
     // Update visibleLines incrementally if the new line is visible
-    // Use unsafe version since we already hold unique_lock
-    if (IsLineVisibleUnsafe(newIndex))
-    {
-        UINT32 displayRow = 0;
-        if (! _visibleLines.empty())
-        {
-            // Calculate display row based on last visible line
-            const auto& lastVisible = _visibleLines.back();
-            displayRow              = lastVisible.displayRowStart + _lines[lastVisible.sourceIndex].newlineCount + 1u;
-        }
-        _visibleLines.push_back({newIndex, displayRow});
-    }
+    IndexNewLinesUnsafe();
+    AppendVisibleLinesUnsafe(newIndex);
 
     UpdateDirtyRange(newIndex, newIndex);
 }
@@ -397,6 +483,7 @@ void Document::Clear()
     std::unique_lock lock(_rwMutex); // Write operation
     _lines.clear();
     _visibleLines.clear(); // Clear visible lines when document is cleared
+    ResetLineIndexUnsafe();
     InvalidateCaches();
 }
 
@@ -460,94 +547,132 @@ void Document::SetFilterMask(uint32_t mask)
 void Document::RebuildVisibleLines()
 {
     // No lock needed - called from methods that already hold unique_lock
-    _visibleLines.clear();
-
-    if (_filterMask == Debug::InfoParam::Type::All)
+    // Pass 1 counts visible lines/rows per chunk: chunks without a visible type are skipped and fully visible chunks are taken
+    // from the summary, so only mixed chunks are scanned (over the compact _lineKeys). A prefix sum then gives each chunk its
+    // slice of _visibleLines, which pass 2 fills independently. Large documents run both passes on the parallel pool.
+    enum class ChunkCoverage : uint8_t
     {
-        // No filtering - all lines visible
-        _visibleLines.reserve(_lines.size());
-        UINT32 displayRow = 0;
-        for (size_t i = 0; i < _lines.size(); ++i)
-        {
-            _visibleLines.push_back({i, displayRow});
-            displayRow += _lines[i].newlineCount + 1u;
-        }
-    }
-    else
+        None,
+        Partial,
+        All,
+    };
+    struct ChunkPlan
     {
-        // Filtering active - only visible lines
-        size_t estimatedVisible = _lines.size() / 2; // Rough estimate for initial capacity
-        _visibleLines.reserve(estimatedVisible);
-
-        UINT32 displayRow = 0;
-        for (size_t i = 0; i < _lines.size(); ++i)
-        {
-            const auto& line = _lines[i];
-
-            // Lines without metadata are always visible
-            bool visible = ! line.hasMeta;
-            if (line.hasMeta)
-            {
-                // Check filter mask for this line's type
-                uint32_t bitPos = 0;
-                switch (line.meta.type)
-                {
-                    case Debug::InfoParam::Type::Text: bitPos = 0; break;
-                    case Debug::InfoParam::Type::Error: bitPos = 1; break;
-                    case Debug::InfoParam::Type::Warning: bitPos = 2; break;
-                    case Debug::InfoParam::Type::Info: bitPos = 3; break;
-                    case Debug::InfoParam::Type::Debug: bitPos = 4; break;
-                    case Debug::InfoParam::Type::All: visible = true; break;
-                }
-                if (line.meta.type != Debug::InfoParam::Type::All)
-                {
-                    visible = (_filterMask & (1u << bitPos)) != 0;
-                }
-            }
+        size_t visibleCount    = 0;
+        size_t firstVisible    = 0;
+        UINT32 displayRows     = 0;
+        UINT32 firstDisplayRow = 0;
+        ChunkCoverage coverage = ChunkCoverage::None;
+    };
 
-            if (visible)
-            {
-                _visibleLines.push_back({i, displayRow});
-                displayRow += line.newlineCount + 1u;
-            }
-        }
+    const uint32_t visibleBits = VisibleTypeBitsUnsafe();
+    const bool parallel        = _lines.size() >= kParallelRebuildLines;
+    std::vector<ChunkPlan> plans(_chunks.size());
+
+    ForEachChunk(_chunks.size(),
+                 parallel,
+                 [&](size_t chunkIndex) noexcept
+                 {
+                     const LineChunkSummary& chunk = _chunks[chunkIndex];
+                     ChunkPlan& plan               = plans[chunkIndex];
+                     if ((chunk.typeBits & visibleBits) == 0)
+                         return;
+
+                     if ((chunk.typeBits & ~visibleBits) == 0)
+                     {
+                         plan.coverage     = ChunkCoverage::All;
+                         plan.visibleCount = chunk.lineCount;
+                         plan.displayRows  = chunk.displayRows;
+                         return;
+                     }
+
+                     plan.coverage      = ChunkCoverage::Partial;
+                     const size_t begin = chunkIndex * kChunkLines;
+                     const size_t end   = begin + chunk.lineCount;
+                     for (size_t i = begin; i < end; ++i)
+                     {
+                         const LineKey& key = _lineKeys[i];
+                         if ((key.typeBit & visibleBits) != 0)
+                         {
+                             plan.visibleCount += 1;
+                             plan.displayRows += key.newlineCount + 1u;
+                         }
+                     }
+                 });
+
+    size_t visibleTotal = 0;
+    UINT32 displayRow   = 0;
+    for (ChunkPlan& plan : plans)
+    {
+        plan.firstVisible    = visibleTotal;
+        plan.firstDisplayRow = displayRow;
+        visibleTotal += plan.visibleCount;
+        displayRow += plan.displayRows;
     }
 
+    _visibleLines.clear();
+    _visibleLines.resize(visibleTotal);
+
+    ForEachChunk(_chunks.size(),
+                 parallel,
+                 [&](size_t chunkIndex) noexcept
+                 {
+                     const ChunkPlan& plan = plans[chunkIndex];
+                     if (plan.visibleCount == 0)
+                         return;
+
+                     VisibleLine* out   = _visibleLines.data() + plan.firstVisible;
+                     UINT32 row         = plan.firstDisplayRow;
+                     const size_t begin = chunkIndex * kChunkLines;
+                     const size_t end   = begin + _chunks[chunkIndex].lineCount;
+                     for (size_t i = begin; i < end; ++i)
+                     {
+                         const LineKey& key = _lineKeys[i];
+                         if (plan.coverage == ChunkCoverage::Partial && (key.typeBit & visibleBits) == 0)
+                             continue;
+                         *out++ = VisibleLine{i, row};
+                         row += key.newlineCount + 1u;
+                     }
+                 });
+
 #ifdef _DEBUG
-    auto msg = std::format("RebuildVisibleLines: {} visible of {} total lines, {} display rows\n",
-                           _visibleLines.size(),
-                           _lines.size(),
-                           _visibleLines.empty() ? 0u : _visibleLines.back().displayRowStart + _lines[_visibleLines.back().sourceIndex].newlineCount + 1u);
+    auto msg = std::format("RebuildVisibleLines: {} visible of {} total lines, {} display rows\n", _visibleLines.size(), _lines.size(), displayRow);
     OutputDebugStringA(msg.c_str());
 #endif
 }
 
+void Document::AppendVisibleLinesUnsafe(size_t firstSourceIndex)
+{
+    // Caller must hold unique lock; lines before firstSourceIndex are already reflected in _visibleLines
+    const uint32_t visibleBits = VisibleTypeBitsUnsafe();
+    UINT32 displayRow          = 0;
+    if (! _visibleLines.empty())
+    {
+        // Calculate display row based on last visible line
+        const auto& lastVisible = _visibleLines.back();
+        displayRow              = lastVisible.displayRowStart + _lineKeys[lastVisible.sourceIndex].newlineCount + 1u;
+    }
+
+    for (size_t i = firstSourceIndex; i < _lineKeys.size(); ++i)
+    {
+        const LineKey& key = _lineKeys[i];
+        if ((key.typeBit & visibleBits) == 0)
+            continue;
+        _visibleLines.push_back({i, displayRow});
+        displayRow += key.newlineCount + 1u;
+    }
+}
+
 bool Document::IsLineVisibleUnsafe(size_t sourceIndex) const
 {
     // Caller must hold lock
     if (_filterMask == Debug::InfoParam::Type::All)
         return true;
 
-    if (sourceIndex >= _lines.size())
+    if (sourceIndex >= _lineKeys.size())
         return false;
 
-    const auto& line = _lines[sourceIndex];
-    if (! line.hasMeta)
-        return true; // Lines without metadata always visible
-
-    // Convert InfoParam::Type enum value to bit position
-    uint32_t bitPos = 0;
-    switch (line.meta.type)
-    {
-        case Debug::InfoParam::Type::Text: bitPos = 0; break;
-        case Debug::InfoParam::Type::Error: bitPos = 1; break;
-        case Debug::InfoParam::Type::Warning: bitPos = 2; break;
-        case Debug::InfoParam::Type::Info: bitPos = 3; break;
-        case Debug::InfoParam::Type::Debug: bitPos = 4; break;
-        case Debug::InfoParam::Type::All: return true;
-    }
-
-    return (_filterMask & (1u << bitPos)) != 0;
+    return (_lineKeys[sourceIndex].typeBit & VisibleTypeBitsUnsafe()) != 0;
 }
 
 bool Document::IsLineVisible(size_t sourceIndex) const
@@ -712,6 +837,86 @@ std::pair<size_t, UINT32> Document::GetLineAndOffset(UINT32 position) const
     return GetLineAndOffsetUnsafe(position);
 }
 
+uint64_t Document::ContentGeneration() const
+{
+    std::shared_lock lock(_rwMutex);
+    return _contentGeneration;
+}
+
+void Document::SearchChunk(const TextSearch::Query& query, size_t chunkIndex, size_t firstLine, size_t endLine, std::vector<SearchHit>& hits) const
+{
+    // Reads only Line::text and the line index, never the mutable display caches the UI thread fills under the shared lock.
+    std::shared_lock lock(_rwMutex);
+    if (chunkIndex >= _chunks.size() || query.Empty())
+        return;
+
+    // In filtered mode, only search visible lines. Otherwise FindNext() can land on hidden lines
+    // which makes caret/selection behavior confusing.
+    const LineChunkSummary& chunk = _chunks[chunkIndex];
+    const uint32_t visibleBits    = VisibleTypeBitsUnsafe();
+    if ((chunk.typeBits & visibleBits) == 0)
+        return;
+    if (query.processId.has_value() && (chunk.processBits & IdBit(query.processId.value())) == 0)
+        return;
+    if (query.threadId.has_value() && (chunk.threadBits & IdBit(query.threadId.value())) == 0)
+        return;
+
+    const bool idFilter  = query.processId.has_value() || query.threadId.has_value();
+    const size_t begin   = std::max(chunkIndex * kChunkLines, firstLine);
+    const size_t end     = std::min(chunkIndex * kChunkLines + chunk.lineCount, endLine);
+    const UINT32 findLen = static_cast<UINT32>(query.text.Length());
+    for (size_t i = begin; i < end; ++i)
+    {
+        const LineKey& key = _lineKeys[i];
+        if ((key.typeBit & visibleBits) == 0)
+            continue;
+        if (idFilter)
+        {
+            if ((key.typeBit & kUntypedLineBit) != 0)
+                continue; // no metadata
+            if (query.processId.has_value() && key.processId != query.processId.value())
+                continue;
+            if (query.threadId.has_value() && key.threadId != query.threadId.value())
+                continue;
+        }
+
+        const std::wstring& text = _lines[i].text;
+        if (query.text.Empty())
+        {
+            hits.push_back(SearchHit{i, 0, static_cast<UINT32>(text.size())});
+            continue;
+        }
+
+        size_t pos = 0;
+        while ((pos = query.text.Find(text, pos)) != std::wstring_view::npos)
+        {
+            hits.push_back(SearchHit{i, static_cast<UINT32>(pos), findLen});
+            pos += findLen;
+        }
+    }
+}
+
+void Document::ResolveSearchHits(const std::vector<SearchHit>& hits, const D2D1_COLOR_F& color, std::vector<Line::ColorSpan>& out) const
+{
+    std::shared_lock lock(_rwMutex);
+    EnsureOffsetsValid();
+    if (! _offsetsValid || _lineOffsets.size() != _lines.size())
+        return;
+
+    out.reserve(out.size() + hits.size());
+    for (const SearchHit& hit : hits)
+    {
+        if (hit.sourceIndex >= _lines.size())
+            continue;
+
+        const Line& line = _lines[hit.sourceIndex];
+        if (static_cast<size_t>(hit.offset) + hit.length > line.text.size())
+            continue; // document changed after the chunk was searched
+
+        out.push_back(Line::ColorSpan{_lineOffsets[hit.sourceIndex] + PrefixLength(line) + hit.offset, hit.length, color});
+    }
+}
+
 const std::wstring& Document::GetDisplayTextRef(size_t visibleIndex) const
 {
     std::shared_lock lock(_rwMutex);
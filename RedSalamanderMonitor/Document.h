@@ -12,6 +12,7 @@
 #include <d2d1.h>
 
 #include "Helpers.h"
+#include "TextSearch.h"
 
 #pragma warning(push)
 #pragma warning(disable : 4820) // bytes padding added after data member
@@ -48,6 +49,8 @@ struct VisibleLine
 
 // Document: Manages document content with filtering support and display row mapping
 // Thread-safe with reader-writer lock for concurrent access
+// Lines are also grouped into fixed chunks of kChunkLines with an OR-ed summary (types, hashed pid/tid bitmaps, display rows)
+// so filter rebuilds and searches can skip or bulk-accept whole chunks without touching the Line objects.
 class Document
 {
 public:
@@ -138,6 +141,19 @@ public:
     };
     FilteredTailResult BuildFilteredTailText(size_t firstAll, size_t lastAll) const;
 
+    // Chunked search - SearchChunk() is safe to call from worker threads (shared lock held for one chunk only).
+    // Hits are reported in source order with offsets into Line::text; ResolveSearchHits() maps them to document positions.
+    static constexpr size_t kChunkLines = 4096;
+    struct SearchHit
+    {
+        size_t sourceIndex = 0;
+        UINT32 offset      = 0; // offset into Line::text (prefix excluded)
+        UINT32 length      = 0;
+    };
+    uint64_t ContentGeneration() const; // bumped when existing lines are replaced or removed (SetText/Clear)
+    void SearchChunk(const TextSearch::Query& query, size_t chunkIndex, size_t firstLine, size_t endLine, std::vector<SearchHit>& hits) const;
+    void ResolveSearchHits(const std::vector<SearchHit>& hits, const D2D1_COLOR_F& color, std::vector<Line::ColorSpan>& out) const;
+
     // Coloring
     void AddColorRange(UINT32 start, UINT32 length, const D2D1_COLOR_F& color);
     void ClearColoring();
@@ -163,6 +179,35 @@ private:
         FullInvalidation // Invalidate everything
     };
 
+    // LineKey: compact per-line filter attributes stored next to _lines so index scans stay cache friendly
+    struct LineKey
+    {
+        uint32_t processId  = 0;
+        uint32_t threadId   = 0;
+        UINT32 newlineCount = 0;
+        uint32_t typeBit    = 0; // TypeBitForLine()
+    };
+
+    // LineChunkSummary: OR of LineKey attributes for kChunkLines consecutive source lines
+    struct LineChunkSummary
+    {
+        uint32_t typeBits    = 0;
+        uint32_t lineCount   = 0;
+        UINT32 displayRows   = 0; // sum of (newlineCount + 1)
+        uint64_t processBits = 0; // IdBit() of every pid in the chunk
+        uint64_t threadBits  = 0; // IdBit() of every tid in the chunk
+    };
+
+    // Type bits 0-4 follow the filter mask; lines without metadata (or typed All) are always visible.
+    static constexpr uint32_t kUntypedLineBit = 1u << 5;
+    static constexpr uint32_t kAllTypeLineBit = 1u << 6;
+    static uint32_t TypeBitForLine(const Line& line) noexcept;
+    static uint64_t IdBit(uint32_t id) noexcept;
+    uint32_t VisibleTypeBitsUnsafe() const noexcept;
+    void IndexNewLinesUnsafe();  // Append keys/summaries for lines added since the last call
+    void ResetLineIndexUnsafe(); // Drop keys/summaries (SetText/Clear)
+    void AppendVisibleLinesUnsafe(size_t firstSourceIndex); // Extend _visibleLines for lines appended at the tail
+
     void RebuildVisibleLines(); // Rebuild visibleLines vector from current filter mask
     // Compute display prefix (emoji + time + ids) based on metadata and settings
     const std::wstring& BuildPrefix(const Line& line) const;
@@ -183,6 +228,9 @@ private:
     std::vector<Line> _lines;               // Source of truth: all lines (append-only)
     std::vector<VisibleLine> _visibleLines; // Computed view: maps visible index -> source index + display row
     mutable std::shared_mutex _rwMutex;     // Reader-writer lock for better concurrency
+    std::vector<LineKey> _lineKeys;         // Parallel to _lines
+    std::vector<LineChunkSummary> _chunks;  // One per kChunkLines source lines
+    uint64_t _contentGeneration = 0;
 
     // Cache for performance
     mutable bool _totalLengthValid    = false;
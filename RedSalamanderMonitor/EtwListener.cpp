@@ -1,5 +1,6 @@
 #include "EtwListener.h"
 #include "Helpers.h" // For Debug::InfoParam definition
+#include "PerfScopeStats.h"
 #include <vector>
 
 #pragma warning(push)
@@ -20,7 +21,7 @@ EtwListener::~EtwListener()
     Stop();
 }
 
-bool EtwListener::Start(EventCallback callback)
+bool EtwListener::Start(EventCallback callback, PerfScopeCallback perfScopeCallback)
 {
     _lastErrorCode = ERROR_SUCCESS;
     _lastError.clear();
@@ -39,7 +40,8 @@ bool EtwListener::Start(EventCallback callback)
         return false;
     }
 
-    _userCallback = std::move(callback);
+    _userCallback      = std::move(callback);
+    _perfScopeCallback = std::move(perfScopeCallback);
     s_instance.store(this, std::memory_order_release);
 
     // Stop any existing session with the same name
@@ -247,14 +249,20 @@ void EtwListener::HandleEvent(PEVENT_RECORD eventRecord)
     // Extract event data
     Debug::InfoParam info{};
     std::wstring message;
+    PerfScopeSample perfSample;
 
-    if (ExtractEventData(eventRecord, info, message))
+    if (ExtractEventData(eventRecord, info, message, perfSample))
     {
+        if (_perfScopeCallback && ! perfSample.name.empty())
+        {
+            _perfScopeCallback(perfSample);
+        }
+
         _userCallback(info, message);
     }
 }
 
-bool EtwListener::ExtractEventData(PEVENT_RECORD eventRecord, Debug::InfoParam& info, std::wstring& message)
+bool EtwListener::ExtractEventData(PEVENT_RECORD eventRecord, Debug::InfoParam& info, std::wstring& message, PerfScopeSample& perfSample)
 {
     // PERF NOTE: TDH (Trace Data Helper) API is slow — each event requires TdhGetEventInformation
     // plus per-property TdhGetPropertySize + TdhGetProperty calls (17+ total). For a known provider
@@ -433,6 +441,14 @@ bool EtwListener::ExtractEventData(PEVENT_RECORD eventRecord, Debug::InfoParam&
         {
             message = std::format(L"[perf] {}{} {} v0={} v1={} hr=0x{:08X}", perfEmoji, perfScopeName, perfDurationText, perfValue0, perfValue1, perfHr);
         }
+
+        perfSample.name       = std::move(perfScopeName);
+        perfSample.detail     = std::move(perfScopeDetail);
+        perfSample.durationUs = perfDurationUs;
+        perfSample.value0     = perfValue0;
+        perfSample.value1     = perfValue1;
+        perfSample.hr         = perfHr;
+        perfSample.processId  = info.processID;
     }
 
     return ! message.empty();
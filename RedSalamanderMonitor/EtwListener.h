@@ -17,6 +17,7 @@ namespace Debug
 {
 struct InfoParam;
 }
+struct PerfScopeSample;
 
 // ETW Real-Time Listener for RedSalamanderMonitor
 // Consumes TraceLogging events from the RedSalamander provider in real-time
@@ -27,6 +28,8 @@ public:
     // Callback invoked for each debug message event
     // Parameters: InfoParam (metadata), message (payload text)
     using EventCallback = std::function<void(const Debug::InfoParam&, const std::wstring&)>;
+    // Optional callback invoked (on the ETW worker thread) for each decoded PerfScope event, before the text line is emitted
+    using PerfScopeCallback = std::function<void(const PerfScopeSample&)>;
 
     EtwListener();
     ~EtwListener();
@@ -39,7 +42,7 @@ public:
 
     // Start listening for events with the given callback
     // Returns true on success, false if session couldn't start
-    bool Start(EventCallback callback);
+    bool Start(EventCallback callback, PerfScopeCallback perfScopeCallback = {});
 
     // Stop listening and clean up resources
     void Stop();
@@ -74,13 +77,14 @@ private:
     void HandleEvent(PEVENT_RECORD eventRecord);
 
     // Extract data from TraceLogging event
-    bool ExtractEventData(PEVENT_RECORD eventRecord, Debug::InfoParam& info, std::wstring& message);
+    bool ExtractEventData(PEVENT_RECORD eventRecord, Debug::InfoParam& info, std::wstring& message, PerfScopeSample& perfSample);
 
     // Worker thread function
     void ProcessTraceThread();
 
     // Member variables
     EventCallback _userCallback;
+    PerfScopeCallback _perfScopeCallback;
     TRACEHANDLE _sessionHandle;
     TRACEHANDLE _traceHandle;
     std::jthread _workerThread;
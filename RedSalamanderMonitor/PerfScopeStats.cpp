@@ -0,0 +1,313 @@
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <fstream>
+
+#pragma warning(push)
+// WIL: C4625 (copy ctor deleted), C4626 (copy assign deleted), C5026 (move ctor deleted), C5027 (move assign deleted)
+#pragma warning(disable : 4625 4626 5026 5027)
+#include <wil/resource.h>
+#pragma warning(pop)
+
+#include <yyjson.h>
+
+#include "PerfScopeStats.h"
+
+namespace
+{
+std::string Utf8FromUtf16(std::wstring_view text)
+{
+    if (text.empty())
+    {
+        return {};
+    }
+
+    const int required = WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    if (required <= 0)
+    {
+        return {};
+    }
+
+    std::string result(static_cast<size_t>(required), '\0');
+    const int written = WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), result.data(), required, nullptr, nullptr);
+    if (written <= 0)
+    {
+        return {};
+    }
+
+    result.resize(static_cast<size_t>(written));
+    return result;
+}
+
+void AppendCsvField(std::string& out, std::string_view field)
+{
+    const bool needsQuotes = field.find_first_of(",\"\r\n") != std::string_view::npos;
+    if (! needsQuotes)
+    {
+        out.append(field);
+        return;
+    }
+
+    out.push_back('"');
+    for (const char ch : field)
+    {
+        if (ch == '"')
+        {
+            out.push_back('"');
+        }
+        out.push_back(ch);
+    }
+    out.push_back('"');
+}
+} // namespace
+
+// ===== PerfScopeHistogram =====
+
+uint32_t PerfScopeHistogram::BucketIndexForValue(uint64_t value) noexcept
+{
+    if (value < kSubBucketCount)
+    {
+        return static_cast<uint32_t>(value);
+    }
+
+    constexpr uint64_t kMaxValue = (uint64_t{1} << kMaxValueBits) - 1u;
+    value                        = std::min(value, kMaxValue);
+
+    // shift >= 1 here; mantissa is always in [kSubBucketHalfCount, kSubBucketCount)
+    const uint32_t shift    = static_cast<uint32_t>(std::bit_width(value)) - kSubBucketBits;
+    const uint32_t mantissa = static_cast<uint32_t>(value >> shift);
+    return kSubBucketCount + (shift - 1u) * kSubBucketHalfCount + (mantissa - kSubBucketHalfCount);
+}
+
+uint64_t PerfScopeHistogram::HighestEquivalentValue(uint32_t bucketIndex) noexcept
+{
+    if (bucketIndex < kSubBucketCount)
+    {
+        return bucketIndex;
+    }
+
+    const uint32_t relative = bucketIndex - kSubBucketCount;
+    const uint32_t shift    = relative / kSubBucketHalfCount + 1u;
+    const uint64_t mantissa = kSubBucketHalfCount + relative % kSubBucketHalfCount;
+    return ((mantissa + 1u) << shift) - 1u;
+}
+
+void PerfScopeHistogram::Record(uint64_t value) noexcept
+{
+    ++_buckets[BucketIndexForValue(value)];
+    ++_count;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+}
+
+void PerfScopeHistogram::Reset() noexcept
+{
+    _buckets.fill(0);
+    _count = 0;
+    _min   = UINT64_MAX;
+    _max   = 0;
+}
+
+uint64_t PerfScopeHistogram::ValueAtPercentile(double percentile) const noexcept
+{
+    if (_count == 0)
+    {
+        return 0;
+    }
+
+    percentile          = std::clamp(percentile, 0.0, 100.0);
+    const double rank   = std::ceil((percentile / 100.0) * static_cast<double>(_count));
+    const uint64_t goal = std::max<uint64_t>(1u, static_cast<uint64_t>(rank));
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < kBucketCount; ++i)
+    {
+        seen += _buckets[i];
+        if (seen >= goal)
+        {
+            return std::min(HighestEquivalentValue(i), _max);
+        }
+    }
+
+    return _max;
+}
+
+// ===== PerfScopeAggregator =====
+
+void PerfScopeAggregator::Record(const PerfScopeSample& sample)
+{
+    if (sample.name.empty())
+    {
+        return;
+    }
+
+    std::lock_guard lock(_mutex);
+    ScopeStats& stats = _scopes[sample.name];
+    stats.histogram.Record(sample.durationUs);
+    stats.totalUs += sample.durationUs;
+    stats.lastUs = sample.durationUs;
+    stats.value0Total += sample.value0;
+    stats.value1Total += sample.value1;
+    if (FAILED(static_cast<HRESULT>(sample.hr)))
+    {
+        ++stats.failures;
+    }
+    ++_generation;
+}
+
+void PerfScopeAggregator::Reset() noexcept
+{
+    std::lock_guard lock(_mutex);
+    _scopes.clear();
+    ++_generation;
+}
+
+uint64_t PerfScopeAggregator::Generation() const noexcept
+{
+    std::lock_guard lock(_mutex);
+    return _generation;
+}
+
+std::vector<PerfScopeRow> PerfScopeAggregator::Snapshot() const
+{
+    std::vector<PerfScopeRow> rows;
+
+    std::lock_guard lock(_mutex);
+    rows.reserve(_scopes.size());
+    for (const auto& [name, stats] : _scopes)
+    {
+        PerfScopeRow row;
+        row.name        = name;
+        row.count       = stats.histogram.Count();
+        row.failures    = stats.failures;
+        row.totalUs     = stats.totalUs;
+        row.minUs       = stats.histogram.Min();
+        row.p50Us       = stats.histogram.ValueAtPercentile(50.0);
+        row.p95Us       = stats.histogram.ValueAtPercentile(95.0);
+        row.p99Us       = stats.histogram.ValueAtPercentile(99.0);
+        row.maxUs       = stats.histogram.Max();
+        row.lastUs      = stats.lastUs;
+        row.value0Total = stats.value0Total;
+        row.value1Total = stats.value1Total;
+        row.meanUs      = row.count > 0 ? static_cast<double>(stats.totalUs) / static_cast<double>(row.count) : 0.0;
+
+        if (stats.totalUs > 0)
+        {
+            const double seconds = static_cast<double>(stats.totalUs) / 1'000'000.0;
+            row.value0PerSecond  = static_cast<double>(stats.value0Total) / seconds;
+            row.value1PerSecond  = static_cast<double>(stats.value1Total) / seconds;
+        }
+
+        rows.push_back(std::move(row));
+    }
+
+    return rows;
+}
+
+// ===== Export =====
+
+std::string BuildPerfScopeCsv(const std::vector<PerfScopeRow>& rows)
+{
+    std::string out;
+    out.reserve(128 + rows.size() * 160);
+    out.append("scope,count,failures,total_us,mean_us,min_us,p50_us,p95_us,p99_us,max_us,last_us,value0_total,value1_total,value0_per_s,value1_per_s\r\n");
+
+    for (const PerfScopeRow& row : rows)
+    {
+        AppendCsvField(out, Utf8FromUtf16(row.name));
+        std::format_to(std::back_inserter(out),
+                       ",{},{},{},{:.1f},{},{},{},{},{},{},{},{},{:.1f},{:.1f}\r\n",
+                       row.count,
+                       row.failures,
+                       row.totalUs,
+                       row.meanUs,
+                       row.minUs,
+                       row.p50Us,
+                       row.p95Us,
+                       row.p99Us,
+                       row.maxUs,
+                       row.lastUs,
+                       row.value0Total,
+                       row.value1Total,
+                       row.value0PerSecond,
+                       row.value1PerSecond);
+    }
+
+    return out;
+}
+
+std::string BuildPerfScopeJson(const std::vector<PerfScopeRow>& rows)
+{
+    yyjson_mut_doc* doc = yyjson_mut_doc_new(nullptr);
+    if (! doc)
+    {
+        return {};
+    }
+
+    auto freeDoc         = wil::scope_exit([&] { yyjson_mut_doc_free(doc); });
+    yyjson_mut_val* root = yyjson_mut_obj(doc);
+    yyjson_mut_val* arr  = yyjson_mut_arr(doc);
+    if (! root || ! arr)
+    {
+        return {};
+    }
+
+    yyjson_mut_doc_set_root(doc, root);
+    yyjson_mut_obj_add_uint(doc, root, "version", 1);
+    yyjson_mut_obj_add_str(doc, root, "unit", "us");
+
+    for (const PerfScopeRow& row : rows)
+    {
+        yyjson_mut_val* item = yyjson_mut_arr_add_obj(doc, arr);
+        if (! item)
+        {
+            return {};
+        }
+
+        const std::string name = Utf8FromUtf16(row.name);
+        yyjson_mut_obj_add_strncpy(doc, item, "scope", name.data(), name.size());
+        yyjson_mut_obj_add_uint(doc, item, "count", row.count);
+        yyjson_mut_obj_add_uint(doc, item, "failures", row.failures);
+        yyjson_mut_obj_add_uint(doc, item, "total_us", row.totalUs);
+        yyjson_mut_obj_add_real(doc, item, "mean_us", row.meanUs);
+        yyjson_mut_obj_add_uint(doc, item, "min_us", row.minUs);
+        yyjson_mut_obj_add_uint(doc, item, "p50_us", row.p50Us);
+        yyjson_mut_obj_add_uint(doc, item, "p95_us", row.p95Us);
+        yyjson_mut_obj_add_uint(doc, item, "p99_us", row.p99Us);
+        yyjson_mut_obj_add_uint(doc, item, "max_us", row.maxUs);
+        yyjson_mut_obj_add_uint(doc, item, "last_us", row.lastUs);
+        yyjson_mut_obj_add_uint(doc, item, "value0_total", row.value0Total);
+        yyjson_mut_obj_add_uint(doc, item, "value1_total", row.value1Total);
+        yyjson_mut_obj_add_real(doc, item, "value0_per_s", row.value0PerSecond);
+        yyjson_mut_obj_add_real(doc, item, "value1_per_s", row.value1PerSecond);
+    }
+
+    yyjson_mut_obj_add_val(doc, root, "scopes", arr);
+
+    size_t length = 0;
+    char* json    = yyjson_mut_write(doc, YYJSON_WRITE_PRETTY, &length);
+    if (! json)
+    {
+        return {};
+    }
+
+    auto freeJson = wil::scope_exit([&] { free(json); });
+    return std::string(json, length);
+}
+
+bool WritePerfScopeExport(const std::wstring& path, std::string_view utf8)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (! file)
+    {
+        return false;
+    }
+
+    file.write(utf8.data(), static_cast<std::streamsize>(utf8.size()));
+    return file.good();
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#pragma warning(push)
+#pragma warning(disable : 4820) // bytes padding added after data member
+
+// PerfScopeSample: one decoded `PerfScope` TraceLogging event (see Debug::Perf::Scope in Common/Helpers.h)
+struct PerfScopeSample
+{
+    std::wstring name;
+    std::wstring detail;
+    uint64_t durationUs = 0;
+    uint64_t value0     = 0;
+    uint64_t value1     = 0;
+    uint32_t hr         = 0;
+    uint32_t processId  = 0;
+};
+
+// PerfScopeHistogram: HDR-style log-linear histogram of microsecond durations.
+// Values below kSubBucketCount are recorded exactly; larger values land in power-of-two ranges split into
+// kSubBucketHalfCount linear sub-buckets, which bounds the relative error of any reported percentile to ~3%.
+// Fixed-size storage (no allocation after construction), O(1) record, O(buckets) percentile query.
+class PerfScopeHistogram
+{
+public:
+    static constexpr uint32_t kSubBucketBits      = 6;
+    static constexpr uint32_t kSubBucketCount     = 1u << kSubBucketBits; // 64
+    static constexpr uint32_t kSubBucketHalfCount = kSubBucketCount / 2;  // 32
+    static constexpr uint32_t kMaxValueBits       = 40;                   // ~12.7 days in microseconds; larger values are clamped
+    static constexpr uint32_t kBucketCount        = kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kSubBucketHalfCount;
+
+    void Record(uint64_t value) noexcept;
+    void Reset() noexcept;
+
+    uint64_t Count() const noexcept
+    {
+        return _count;
+    }
+    uint64_t Min() const noexcept
+    {
+        return _count > 0 ? _min : 0;
+    }
+    uint64_t Max() const noexcept
+    {
+        return _max;
+    }
+
+    // Returns the highest value equivalent to the bucket containing the requested percentile (0..100], clamped to Max().
+    uint64_t ValueAtPercentile(double percentile) const noexcept;
+
+    static uint32_t BucketIndexForValue(uint64_t value) noexcept;
+    static uint64_t HighestEquivalentValue(uint32_t bucketIndex) noexcept;
+
+private:
+    std::array<uint64_t, kBucketCount> _buckets{};
+    uint64_t _count = 0;
+    uint64_t _min   = UINT64_MAX;
+    uint64_t _max   = 0;
+};
+
+// PerfScopeRow: immutable snapshot of one scope's aggregate, used by the table view and the exporters
+struct PerfScopeRow
+{
+    std::wstring name;
+    uint64_t count         = 0;
+    uint64_t failures      = 0; // samples with FAILED(hr)
+    uint64_t totalUs       = 0;
+    uint64_t minUs         = 0;
+    uint64_t p50Us         = 0;
+    uint64_t p95Us         = 0;
+    uint64_t p99Us         = 0;
+    uint64_t maxUs         = 0;
+    uint64_t lastUs        = 0;
+    uint64_t value0Total   = 0;
+    uint64_t value1Total   = 0;
+    double meanUs          = 0.0;
+    double value0PerSecond = 0.0; // sum(Value0) / sum(DurationUs), i.e. items/s while the scope was running
+    double value1PerSecond = 0.0;
+};
+
+// PerfScopeAggregator: thread-safe per-scope aggregation.
+// Record() is called from the ETW worker thread; Snapshot()/Reset() are called from the UI thread.
+class PerfScopeAggregator
+{
+public:
+    PerfScopeAggregator() = default;
+
+    PerfScopeAggregator(const PerfScopeAggregator&)            = delete;
+    PerfScopeAggregator& operator=(const PerfScopeAggregator&) = delete;
+    PerfScopeAggregator(PerfScopeAggregator&&)                 = delete;
+    PerfScopeAggregator& operator=(PerfScopeAggregator&&)      = delete;
+
+    void Record(const PerfScopeSample& sample);
+    void Reset() noexcept;
+
+    // Monotonic counter bumped on every Record/Reset so the view can skip refreshes when nothing changed.
+    uint64_t Generation() const noexcept;
+    std::vector<PerfScopeRow> Snapshot() const;
+
+private:
+    struct ScopeStats
+    {
+        PerfScopeHistogram histogram;
+        uint64_t failures    = 0;
+        uint64_t totalUs     = 0;
+        uint64_t lastUs      = 0;
+        uint64_t value0Total = 0;
+        uint64_t value1Total = 0;
+    };
+
+    mutable std::mutex _mutex;
+    std::unordered_map<std::wstring, ScopeStats> _scopes;
+    uint64_t _generation = 0;
+};
+
+// Export helpers (UTF-8 output, one row per scope)
+std::string BuildPerfScopeCsv(const std::vector<PerfScopeRow>& rows);
+std::string BuildPerfScopeJson(const std::vector<PerfScopeRow>& rows);
+bool WritePerfScopeExport(const std::wstring& path, std::string_view utf8);
+
+#pragma warning(pop)
@@ -0,0 +1,548 @@
+#include "PerfScopeView.h"
+#include "Helpers.h"
+#include "resource.h"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <iterator>
+
+#include <commctrl.h>
+#include <commdlg.h>
+#include <uxtheme.h>
+#pragma comment(lib, "UxTheme.lib")
+
+#pragma warning(push)
+// WIL: C4625 (copy ctor deleted), C4626 (copy assign deleted), C5026 (move ctor deleted), C5027 (move assign deleted)
+#pragma warning(disable : 4625 4626 5026 5027)
+#include <wil/resource.h>
+#pragma warning(pop)
+
+#ifndef GET_X_LPARAM
+#define GET_X_LPARAM(lp) ((int)(short)LOWORD(lp))
+#define GET_Y_LPARAM(lp) ((int)(short)HIWORD(lp))
+#endif
+
+namespace
+{
+constexpr wchar_t kPerfScopeViewClassName[] = L"RedSalamanderMonitorPerfScopeView";
+constexpr UINT_PTR kRefreshTimerId          = 1;
+constexpr UINT kRefreshIntervalMs           = 1000;
+constexpr int kDefaultWidthDip              = 1100;
+constexpr int kDefaultHeightDip             = 420;
+
+struct ColumnSpec
+{
+    UINT titleId;
+    int widthDip;
+    bool rightAligned;
+};
+
+constexpr std::array<ColumnSpec, 12> kColumns = {{
+    {IDS_PERFSCOPE_COL_SCOPE, 320, false},
+    {IDS_PERFSCOPE_COL_COUNT, 70, true},
+    {IDS_PERFSCOPE_COL_FAILURES, 50, true},
+    {IDS_PERFSCOPE_COL_MEAN, 80, true},
+    {IDS_PERFSCOPE_COL_P50, 80, true},
+    {IDS_PERFSCOPE_COL_P95, 80, true},
+    {IDS_PERFSCOPE_COL_P99, 80, true},
+    {IDS_PERFSCOPE_COL_MAX, 80, true},
+    {IDS_PERFSCOPE_COL_LAST, 80, true},
+    {IDS_PERFSCOPE_COL_TOTAL, 90, true},
+    {IDS_PERFSCOPE_COL_VALUE0_RATE, 90, true},
+    {IDS_PERFSCOPE_COL_VALUE1_RATE, 90, true},
+}};
+
+int DipsToPx(HWND hwnd, int dip) noexcept
+{
+    const UINT dpi = hwnd ? GetDpiForWindow(hwnd) : USER_DEFAULT_SCREEN_DPI;
+    return MulDiv(dip, static_cast<int>(dpi), USER_DEFAULT_SCREEN_DPI);
+}
+
+// Durations are microseconds on the wire; show µs below 1 ms and milliseconds above.
+std::wstring FormatDurationUs(uint64_t us)
+{
+    if (us < 1000u)
+    {
+        return std::format(L"{} µs", us);
+    }
+    return std::format(L"{:.3f} ms", static_cast<double>(us) / 1000.0);
+}
+
+std::wstring FormatRate(double perSecond)
+{
+    if (perSecond <= 0.0)
+    {
+        return {};
+    }
+    if (perSecond >= 1'000'000.0)
+    {
+        return std::format(L"{:.2f} M/s", perSecond / 1'000'000.0);
+    }
+    if (perSecond >= 1'000.0)
+    {
+        return std::format(L"{:.1f} K/s", perSecond / 1'000.0);
+    }
+    return std::format(L"{:.1f} /s", perSecond);
+}
+} // namespace
+
+PerfScopeView::PerfScopeView(PerfScopeAggregator& aggregator) noexcept : _aggregator(aggregator)
+{
+}
+
+PerfScopeView::~PerfScopeView()
+{
+    Close();
+}
+
+ATOM PerfScopeView::RegisterWndClass(HINSTANCE hinst)
+{
+    static ATOM s_atom = 0;
+    if (s_atom)
+        return s_atom;
+
+    WNDCLASSEXW wc{};
+    wc.cbSize        = sizeof(wc);
+    wc.hInstance     = hinst;
+    wc.lpfnWndProc   = &PerfScopeView::WndProcThunk;
+    wc.lpszClassName = kPerfScopeViewClassName;
+    wc.hCursor       = LoadCursor(nullptr, IDC_ARROW);
+    wc.hIcon         = LoadIconW(hinst, MAKEINTRESOURCEW(IDI_REDSALAMANDERMONITOR));
+    wc.hIconSm       = LoadIconW(hinst, MAKEINTRESOURCEW(IDI_SMALL));
+    wc.hbrBackground = reinterpret_cast<HBRUSH>(COLOR_WINDOW + 1);
+    s_atom           = RegisterClassExW(&wc);
+    return s_atom;
+}
+
+void PerfScopeView::Show(HWND owner)
+{
+    if (_hWnd)
+    {
+        if (IsIconic(_hWnd))
+        {
+            ShowWindow(_hWnd, SW_RESTORE);
+        }
+        SetForegroundWindow(_hWnd);
+        return;
+    }
+
+    HINSTANCE hinst = reinterpret_cast<HINSTANCE>(GetWindowLongPtrW(owner, GWLP_HINSTANCE));
+    RegisterWndClass(hinst);
+
+    const std::wstring title = LoadStringResource(hinst, IDS_PERFSCOPE_TITLE);
+    const int width          = DipsToPx(owner, kDefaultWidthDip);
+    const int height         = DipsToPx(owner, kDefaultHeightDip);
+    HWND hwnd = CreateWindowExW(0, kPerfScopeViewClassName, title.c_str(), WS_OVERLAPPEDWINDOW | WS_CLIPCHILDREN, CW_USEDEFAULT, CW_USEDEFAULT, width, height, owner, nullptr, hinst, this);
+    if (! hwnd)
+    {
+        Debug::ErrorWithLastError(L"PerfScopeView: CreateWindowExW failed");
+        return;
+    }
+
+    ShowWindow(hwnd, SW_SHOWNORMAL);
+}
+
+void PerfScopeView::Close() noexcept
+{
+    // WM_NCDESTROY clears _hWnd/_hList.
+    if (_hWnd)
+    {
+        DestroyWindow(_hWnd);
+    }
+}
+
+void PerfScopeView::SetColors(COLORREF background, COLORREF text, bool darkMode) noexcept
+{
+    _background = background;
+    _text       = text;
+    _darkMode   = darkMode;
+    ApplyColors();
+}
+
+LRESULT CALLBACK PerfScopeView::WndProcThunk(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
+{
+    PerfScopeView* self = nullptr;
+    if (msg == WM_NCCREATE)
+    {
+        const auto* cs = reinterpret_cast<const CREATESTRUCTW*>(lp);
+        self           = static_cast<PerfScopeView*>(cs->lpCreateParams);
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(self));
+        self->_hWnd    = hwnd;
+    }
+    else
+    {
+        self = reinterpret_cast<PerfScopeView*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+    }
+
+    if (! self)
+    {
+        return DefWindowProcW(hwnd, msg, wp, lp);
+    }
+
+    return self->WndProc(hwnd, msg, wp, lp);
+}
+
+LRESULT PerfScopeView::WndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
+{
+    switch (msg)
+    {
+        case WM_CREATE: OnCreate(hwnd); return 0;
+        case WM_SIZE: OnSize(LOWORD(lp), HIWORD(lp)); return 0;
+        case WM_TIMER:
+            if (static_cast<UINT_PTR>(wp) == kRefreshTimerId)
+            {
+                OnTimer();
+                return 0;
+            }
+            break;
+        case WM_NOTIFY: return OnNotify(reinterpret_cast<const NMHDR*>(lp));
+        case WM_CONTEXTMENU: OnContextMenu(hwnd, GET_X_LPARAM(lp), GET_Y_LPARAM(lp)); return 0;
+        case WM_COMMAND: OnCommand(LOWORD(wp)); return 0;
+        case WM_DPICHANGED:
+        {
+            const RECT* suggested = reinterpret_cast<const RECT*>(lp);
+            SetWindowPos(hwnd,
+                         nullptr,
+                         suggested->left,
+                         suggested->top,
+                         suggested->right - suggested->left,
+                         suggested->bottom - suggested->top,
+                         SWP_NOZORDER | SWP_NOACTIVATE);
+            return 0;
+        }
+        case WM_CLOSE: DestroyWindow(hwnd); return 0;
+        case WM_DESTROY: KillTimer(hwnd, kRefreshTimerId); return 0;
+        case WM_NCDESTROY:
+            SetWindowLongPtrW(hwnd, GWLP_USERDATA, 0);
+            _hWnd           = nullptr;
+            _hList          = nullptr;
+            _lastGeneration = UINT64_MAX;
+            return DefWindowProcW(hwnd, msg, wp, lp);
+    }
+
+    return DefWindowProcW(hwnd, msg, wp, lp);
+}
+
+void PerfScopeView::OnCreate(HWND hwnd)
+{
+    HINSTANCE hinst   = reinterpret_cast<HINSTANCE>(GetWindowLongPtrW(hwnd, GWLP_HINSTANCE));
+    const DWORD style = WS_CHILD | WS_VISIBLE | WS_TABSTOP | LVS_REPORT | LVS_OWNERDATA | LVS_SINGLESEL | LVS_SHOWSELALWAYS;
+    _hList            = CreateWindowExW(0, WC_LISTVIEWW, L"", style, 0, 0, 0, 0, hwnd, nullptr, hinst, nullptr);
+    if (! _hList)
+    {
+        Debug::ErrorWithLastError(L"PerfScopeView: failed to create list view");
+        return;
+    }
+
+    ListView_SetExtendedListViewStyle(_hList, LVS_EX_FULLROWSELECT | LVS_EX_DOUBLEBUFFER | LVS_EX_HEADERDRAGDROP);
+    CreateColumns();
+    ApplyColors();
+    RefreshRows(true);
+    SetTimer(hwnd, kRefreshTimerId, kRefreshIntervalMs, nullptr);
+}
+
+void PerfScopeView::CreateColumns()
+{
+    HINSTANCE hinst = reinterpret_cast<HINSTANCE>(GetWindowLongPtrW(_hWnd, GWLP_HINSTANCE));
+    for (size_t i = 0; i < kColumns.size(); ++i)
+    {
+        std::wstring title = LoadStringResource(hinst, kColumns[i].titleId);
+
+        LVCOLUMNW col{};
+        col.mask     = LVCF_TEXT | LVCF_WIDTH | LVCF_FMT | LVCF_SUBITEM;
+        col.fmt      = kColumns[i].rightAligned ? LVCFMT_RIGHT : LVCFMT_LEFT;
+        col.cx       = DipsToPx(_hWnd, kColumns[i].widthDip);
+        col.pszText  = title.data();
+        col.iSubItem = static_cast<int>(i);
+        ListView_InsertColumn(_hList, static_cast<int>(i), &col);
+    }
+    UpdateSortArrow();
+}
+
+void PerfScopeView::ApplyColors() noexcept
+{
+    if (! _hList)
+    {
+        return;
+    }
+
+    SetWindowTheme(_hList, _darkMode ? L"DarkMode_Explorer" : L"Explorer", nullptr);
+    ListView_SetBkColor(_hList, _background);
+    ListView_SetTextBkColor(_hList, _background);
+    ListView_SetTextColor(_hList, _text);
+    InvalidateRect(_hList, nullptr, TRUE);
+}
+
+void PerfScopeView::OnSize(UINT width, UINT height) noexcept
+{
+    if (_hList)
+    {
+        MoveWindow(_hList, 0, 0, static_cast<int>(width), static_cast<int>(height), TRUE);
+    }
+}
+
+void PerfScopeView::OnTimer() noexcept
+{
+    RefreshRows(false);
+}
+
+void PerfScopeView::RefreshRows(bool force)
+{
+    if (! _hList)
+    {
+        return;
+    }
+
+    const uint64_t generation = _aggregator.Generation();
+    if (! force && generation == _lastGeneration)
+    {
+        return;
+    }
+    _lastGeneration = generation;
+
+    // Preserve the selected scope across re-sorts (owner-data selection is index based).
+    std::wstring selectedName;
+    const int selected = ListView_GetNextItem(_hList, -1, LVNI_SELECTED);
+    if (selected >= 0 && static_cast<size_t>(selected) < _rows.size())
+    {
+        selectedName = _rows[static_cast<size_t>(selected)].name;
+    }
+
+    _rows = _aggregator.Snapshot();
+    SortRows();
+
+    ListView_SetItemCountEx(_hList, static_cast<int>(_rows.size()), LVSICF_NOSCROLL | LVSICF_NOINVALIDATEALL);
+
+    if (! selectedName.empty())
+    {
+        ListView_SetItemState(_hList, -1, 0, LVIS_SELECTED | LVIS_FOCUSED);
+        const auto it = std::find_if(_rows.begin(), _rows.end(), [&](const PerfScopeRow& row) { return row.name == selectedName; });
+        if (it != _rows.end())
+        {
+            const int index = static_cast<int>(std::distance(_rows.begin(), it));
+            ListView_SetItemState(_hList, index, LVIS_SELECTED | LVIS_FOCUSED, LVIS_SELECTED | LVIS_FOCUSED);
+        }
+    }
+
+    InvalidateRect(_hList, nullptr, FALSE);
+}
+
+void PerfScopeView::SortRows()
+{
+    const Column column   = _sortColumn;
+    const bool ascending  = _sortAscending;
+    const auto numericKey = [column](const PerfScopeRow& row) noexcept -> double
+    {
+        switch (column)
+        {
+            case Column::Count: return static_cast<double>(row.count);
+            case Column::Failures: return static_cast<double>(row.failures);
+            case Column::Mean: return row.meanUs;
+            case Column::P50: return static_cast<double>(row.p50Us);
+            case Column::P95: return static_cast<double>(row.p95Us);
+            case Column::P99: return static_cast<double>(row.p99Us);
+            case Column::Max: return static_cast<double>(row.maxUs);
+            case Column::Last: return static_cast<double>(row.lastUs);
+            case Column::Total: return static_cast<double>(row.totalUs);
+            case Column::Value0PerSecond: return row.value0PerSecond;
+            case Column::Value1PerSecond: return row.value1PerSecond;
+            case Column::Scope:
+            case Column::ColumnCount:
+            default: return 0.0;
+        }
+    };
+
+    std::stable_sort(_rows.begin(),
+                     _rows.end(),
+                     [&](const PerfScopeRow& a, const PerfScopeRow& b)
+                     {
+                         if (column == Column::Scope)
+                         {
+                             const int cmp = OrdinalString::Compare(a.name, b.name, true);
+                             return ascending ? cmp < 0 : cmp > 0;
+                         }
+
+                         const double ka = numericKey(a);
+                         const double kb = numericKey(b);
+                         if (ka == kb)
+                         {
+                             return OrdinalString::LessNoCase(a.name, b.name);
+                         }
+                         return ascending ? ka < kb : ka > kb;
+                     });
+}
+
+void PerfScopeView::UpdateSortArrow() noexcept
+{
+    HWND header = ListView_GetHeader(_hList);
+    if (! header)
+    {
+        return;
+    }
+
+    const int count = Header_GetItemCount(header);
+    for (int i = 0; i < count; ++i)
+    {
+        HDITEMW item{};
+        item.mask = HDI_FORMAT;
+        if (! Header_GetItem(header, i, &item))
+        {
+            continue;
+        }
+
+        item.fmt &= ~(HDF_SORTUP | HDF_SORTDOWN);
+        if (i == static_cast<int>(_sortColumn))
+        {
+            item.fmt |= _sortAscending ? HDF_SORTUP : HDF_SORTDOWN;
+        }
+        Header_SetItem(header, i, &item);
+    }
+}
+
+std::wstring PerfScopeView::FormatCell(const PerfScopeRow& row, Column column) const
+{
+    switch (column)
+    {
+        case Column::Scope: return row.name;
+        case Column::Count: return std::format(LocaleFormatting::GetFormatLocale(), L"{:L}", row.count);
+        case Column::Failures: return row.failures > 0 ? std::format(L"{}", row.failures) : std::wstring{};
+        case Column::Mean: return FormatDurationUs(static_cast<uint64_t>(row.meanUs));
+        case Column::P50: return FormatDurationUs(row.p50Us);
+        case Column::P95: return FormatDurationUs(row.p95Us);
+        case Column::P99: return FormatDurationUs(row.p99Us);
+        case Column::Max: return FormatDurationUs(row.maxUs);
+        case Column::Last: return FormatDurationUs(row.lastUs);
+        case Column::Total: return FormatDurationUs(row.totalUs);
+        case Column::Value0PerSecond: return FormatRate(row.value0PerSecond);
+        case Column::Value1PerSecond: return FormatRate(row.value1PerSecond);
+        case Column::ColumnCount:
+        default: return {};
+    }
+}
+
+LRESULT PerfScopeView::OnNotify(const NMHDR* header)
+{
+    if (! header || header->hwndFrom != _hList)
+    {
+        return 0;
+    }
+
+    switch (header->code)
+    {
+        case LVN_GETDISPINFOW:
+        {
+            auto* info = reinterpret_cast<NMLVDISPINFOW*>(const_cast<NMHDR*>(header));
+            if ((info->item.mask & LVIF_TEXT) == 0 || info->item.iItem < 0 || static_cast<size_t>(info->item.iItem) >= _rows.size())
+            {
+                return 0;
+            }
+
+            const int sub = info->item.iSubItem;
+            if (sub < 0 || sub >= static_cast<int>(Column::ColumnCount))
+            {
+                return 0;
+            }
+
+            const std::wstring text = FormatCell(_rows[static_cast<size_t>(info->item.iItem)], static_cast<Column>(sub));
+            wcsncpy_s(info->item.pszText, static_cast<size_t>(info->item.cchTextMax), text.c_str(), _TRUNCATE);
+            return 0;
+        }
+        case LVN_COLUMNCLICK:
+        {
+            const auto* click   = reinterpret_cast<const NMLISTVIEW*>(header);
+            const Column column = static_cast<Column>(click->iSubItem);
+            if (column == _sortColumn)
+            {
+                _sortAscending = ! _sortAscending;
+            }
+            else
+            {
+                // Names read naturally A→Z; numeric columns are most useful largest-first.
+                _sortColumn    = column;
+                _sortAscending = column == Column::Scope;
+            }
+            UpdateSortArrow();
+            RefreshRows(true);
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+void PerfScopeView::OnContextMenu(HWND hwnd, int x, int y)
+{
+    HINSTANCE hinst = reinterpret_cast<HINSTANCE>(GetWindowLongPtrW(hwnd, GWLP_HINSTANCE));
+    wil::unique_hmenu menu(CreatePopupMenu());
+    if (! menu)
+    {
+        return;
+    }
+
+    const std::wstring exportCsv  = LoadStringResource(hinst, IDS_PERFSCOPE_MENU_EXPORT_CSV);
+    const std::wstring exportJson = LoadStringResource(hinst, IDS_PERFSCOPE_MENU_EXPORT_JSON);
+    const std::wstring reset      = LoadStringResource(hinst, IDS_PERFSCOPE_MENU_RESET);
+    const UINT exportFlags        = _rows.empty() ? MF_GRAYED : 0u;
+
+    AppendMenuW(menu.get(), MF_STRING | exportFlags, IDM_PERFSCOPE_EXPORT_CSV, exportCsv.c_str());
+    AppendMenuW(menu.get(), MF_STRING | exportFlags, IDM_PERFSCOPE_EXPORT_JSON, exportJson.c_str());
+    AppendMenuW(menu.get(), MF_SEPARATOR, 0, nullptr);
+    AppendMenuW(menu.get(), MF_STRING, IDM_PERFSCOPE_RESET, reset.c_str());
+
+    if (x == -1 && y == -1)
+    {
+        // Keyboard invocation (Shift+F10 / Menu key): anchor at the window's top-left corner.
+        RECT rc{};
+        GetWindowRect(hwnd, &rc);
+        x = rc.left;
+        y = rc.top;
+    }
+
+    TrackPopupMenu(menu.get(), TPM_RIGHTBUTTON, x, y, 0, hwnd, nullptr);
+}
+
+void PerfScopeView::OnCommand(UINT id)
+{
+    switch (id)
+    {
+        case IDM_PERFSCOPE_EXPORT_CSV: ExportTo(ExportFormat::Csv); break;
+        case IDM_PERFSCOPE_EXPORT_JSON: ExportTo(ExportFormat::Json); break;
+        case IDM_PERFSCOPE_RESET:
+            _aggregator.Reset();
+            RefreshRows(true);
+            break;
+    }
+}
+
+void PerfScopeView::ExportTo(ExportFormat format)
+{
+    HINSTANCE hinst = reinterpret_cast<HINSTANCE>(GetWindowLongPtrW(_hWnd, GWLP_HINSTANCE));
+
+    const bool csv                = format == ExportFormat::Csv;
+    const std::wstring filter     = LoadStringResource(hinst, csv ? IDS_PERFSCOPE_FILTER_CSV : IDS_PERFSCOPE_FILTER_JSON);
+    const std::wstring defaultExt = csv ? L"csv" : L"json";
+
+    wchar_t file[MAX_PATH] = L"";
+    OPENFILENAMEW ofn{};
+    ofn.lStructSize = sizeof(ofn);
+    ofn.hwndOwner   = _hWnd;
+    ofn.lpstrFilter = filter.empty() ? nullptr : filter.c_str();
+    ofn.lpstrFile   = file;
+    ofn.nMaxFile    = static_cast<DWORD>(std::size(file));
+    ofn.Flags       = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT | OFN_EXPLORER;
+    ofn.lpstrDefExt = defaultExt.c_str();
+    if (! GetSaveFileNameW(&ofn))
+    {
+        return;
+    }
+
+    // Export what the table currently shows (same order), refreshed to the latest aggregate.
+    RefreshRows(true);
+    const std::string payload = csv ? BuildPerfScopeCsv(_rows) : BuildPerfScopeJson(_rows);
+    if (payload.empty() || ! WritePerfScopeExport(file, payload))
+    {
+        Debug::Error(L"PerfScopeView: failed to export {}", file);
+        MessageBoxResource(_hWnd, hinst, IDS_PERFSCOPE_MSG_EXPORT_FAILED, IDS_CAPTION_ERROR, MB_OK | MB_ICONERROR);
+    }
+}
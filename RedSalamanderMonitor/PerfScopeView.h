@@ -0,0 +1,96 @@
+#pragma once
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+#include "PerfScopeStats.h"
+
+#pragma warning(push)
+#pragma warning(disable : 4820) // bytes padding added after data member
+
+// PerfScopeView: owned top-level window showing live PerfScope aggregates in a sortable virtual ListView.
+// The aggregator is fed from the ETW worker thread; the view polls it on a UI timer and only rebuilds
+// its row snapshot when the aggregator generation changed.
+class PerfScopeView
+{
+public:
+    explicit PerfScopeView(PerfScopeAggregator& aggregator) noexcept;
+    ~PerfScopeView();
+
+    PerfScopeView(const PerfScopeView&)            = delete;
+    PerfScopeView& operator=(const PerfScopeView&) = delete;
+    PerfScopeView(PerfScopeView&&)                 = delete;
+    PerfScopeView& operator=(PerfScopeView&&)      = delete;
+
+    // Creates the window on first use, otherwise restores and activates it.
+    void Show(HWND owner);
+    void Close() noexcept;
+    [[maybe_unused]] bool IsOpen() const noexcept
+    {
+        return _hWnd != nullptr;
+    }
+
+    void SetColors(COLORREF background, COLORREF text, bool darkMode) noexcept;
+
+private:
+    enum class Column : int
+    {
+        Scope = 0,
+        Count,
+        Failures,
+        Mean,
+        P50,
+        P95,
+        P99,
+        Max,
+        Last,
+        Total,
+        Value0PerSecond,
+        Value1PerSecond,
+        ColumnCount,
+    };
+
+    enum class ExportFormat : uint8_t
+    {
+        Csv,
+        Json,
+    };
+
+    static ATOM RegisterWndClass(HINSTANCE hinst);
+    static LRESULT CALLBACK WndProcThunk(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp);
+    LRESULT WndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp);
+
+    void OnCreate(HWND hwnd);
+    void OnSize(UINT width, UINT height) noexcept;
+    void OnTimer() noexcept;
+    LRESULT OnNotify(const NMHDR* header);
+    void OnContextMenu(HWND hwnd, int x, int y);
+    void OnCommand(UINT id);
+
+    void CreateColumns();
+    void ApplyColors() noexcept;
+    void RefreshRows(bool force);
+    void SortRows();
+    void UpdateSortArrow() noexcept;
+    void ExportTo(ExportFormat format);
+    std::wstring FormatCell(const PerfScopeRow& row, Column column) const;
+
+    PerfScopeAggregator& _aggregator;
+    HWND _hWnd  = nullptr;
+    HWND _hList = nullptr; // child of _hWnd, destroyed with it
+    std::vector<PerfScopeRow> _rows;
+    uint64_t _lastGeneration = UINT64_MAX;
+    Column _sortColumn       = Column::Total;
+    bool _sortAscending      = false;
+
+    COLORREF _background = RGB(255, 255, 255);
+    COLORREF _text       = RGB(0, 0, 0);
+    bool _darkMode       = false;
+};
+
+#pragma warning(pop)
@@ -48,6 +48,8 @@
 #include "Configuration.h"
 #include "EtwListener.h"
 #include "ExceptionHelpers.h" // Shared exception handling utilities
+#include "PerfScopeStats.h"
+#include "PerfScopeView.h"
 #include "RedSalamanderMonitor.h"
 #include "SettingsStore.h"
 #include "resource.h"
@@ -70,6 +72,8 @@ bool g_lineNumbersVisible = true;            // Line numbers menu state
 bool g_autoScrollEnabled  = true;            // Auto-scroll menu state
 // Auto-scroll state is now managed by ColorTextView (_autoScrollEnabled member)
 static std::unique_ptr<EtwListener> g_etwListener; // ETW real-time event listener
+static PerfScopeAggregator g_perfScopeAggregator;   // Fed from the ETW worker thread (internally synchronized)
+static PerfScopeView g_perfScopeView(g_perfScopeAggregator);
 Common::Settings::Settings g_settings;
 
 // Filter state: bitmask where bit N corresponds to InfoParam::Type value N (0x1F = all 5 types enabled)
@@ -583,10 +587,20 @@ ColorTextView::Theme ResolveMonitorTheme() noexcept
     return theme;
 }
 
+COLORREF ColorRefFromD2D(const D2D1_COLOR_F& color) noexcept
+{
+    const auto channel = [](float v) noexcept { return static_cast<BYTE>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return RGB(channel(color.r), channel(color.g), channel(color.b));
+}
+
 void ApplyMonitorTheme() noexcept
 {
     const ColorTextView::Theme theme = ResolveMonitorTheme();
     g_colorView.SetTheme(theme);
+
+    // Perceived luminance decides the native control theme (DarkMode_Explorer vs Explorer) for the PerfScope table.
+    const float luminance = 0.299f * theme.bg.r + 0.587f * theme.bg.g + 0.114f * theme.bg.b;
+    g_perfScopeView.SetColors(ColorRefFromD2D(theme.bg), ColorRefFromD2D(theme.fg), luminance < 0.5f);
 }
 
 bool TryFindMenuPathToCommand(HMENU menu, UINT commandId, std::vector<HMENU>& path) noexcept
@@ -1899,7 +1913,8 @@ LRESULT OnCreateMainWindow(HWND hWnd)
             }
 
             g_colorView.QueueEtwEvent(info, std::move(normalizedMsg));
-        });
+        },
+        [](const PerfScopeSample& sample) { g_perfScopeAggregator.Record(sample); });
 
     if (! etwStarted)
     {
@@ -2015,6 +2030,7 @@ LRESULT OnCommandMainWindow(HWND hWnd, UINT id, UINT codeNotify, HWND hwndCtl)
         case IDM_EDIT_FIND: g_colorView.ShowFind(); break;
         case IDM_EDIT_FIND_NEXT: g_colorView.FindNext(false); break;
         case IDM_EDIT_FIND_PREV: g_colorView.FindNext(true); break;
+        case IDM_VIEW_PERF_SCOPES: g_perfScopeView.Show(hWnd); break;
         case IDM_FILE_PRINT:
         {
             const std::wstring caption = LoadStringResource(g_hInstance, IDS_CAPTION_PRINT);
@@ -2234,6 +2250,7 @@ LRESULT OnDestroyMainWindow(HWND hWnd)
         g_etwListener.reset();
     }
 
+    g_perfScopeView.Close();
     g_hColorView.reset();
     if (g_hToolbar)
     {
@@ -0,0 +1,306 @@
+#include "TextSearch.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <cwctype>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#elif defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+constexpr size_t kLanes        = 8;      // UTF-16 code units per 128-bit vector
+constexpr wchar_t kNonAsciiBit = 0xFF80; // any of these bits set => code unit >= 0x80
+
+constexpr bool IsAsciiLower(wchar_t ch) noexcept
+{
+    return ch >= L'a' && ch <= L'z';
+}
+
+bool StartsWithNoCase(std::wstring_view text, std::wstring_view prefix) noexcept
+{
+    if (text.size() < prefix.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < prefix.size(); ++i)
+    {
+        if (towlower(text[i]) != towlower(prefix[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parses a decimal or 0x-prefixed hex id; the whole token must be consumed.
+std::optional<uint32_t> ParseId(std::wstring_view token) noexcept
+{
+    uint32_t base = 10;
+    if (token.size() > 2 && token[0] == L'0' && (token[1] == L'x' || token[1] == L'X'))
+    {
+        base = 16;
+        token.remove_prefix(2);
+    }
+
+    if (token.empty())
+    {
+        return std::nullopt;
+    }
+
+    uint64_t value = 0;
+    for (const wchar_t ch : token)
+    {
+        uint32_t digit = 0;
+        if (ch >= L'0' && ch <= L'9')
+        {
+            digit = static_cast<uint32_t>(ch - L'0');
+        }
+        else if (base == 16 && ch >= L'a' && ch <= L'f')
+        {
+            digit = static_cast<uint32_t>(ch - L'a') + 10u;
+        }
+        else if (base == 16 && ch >= L'A' && ch <= L'F')
+        {
+            digit = static_cast<uint32_t>(ch - L'A') + 10u;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+
+        value = value * base + digit;
+        if (value > UINT32_MAX)
+        {
+            return std::nullopt;
+        }
+    }
+
+    return static_cast<uint32_t>(value);
+}
+} // namespace
+
+namespace TextSearch
+{
+Finder::Finder(std::wstring_view needle, bool caseSensitive) : _needle(needle), _caseSensitive(caseSensitive)
+{
+    if (_needle.empty())
+    {
+        return;
+    }
+
+    if (_caseSensitive)
+    {
+        _first[0] = _first[1] = _needle.front();
+        _last[0] = _last[1] = _needle.back();
+        _vectorized         = true;
+        return;
+    }
+
+    for (wchar_t& ch : _needle)
+    {
+        ch = static_cast<wchar_t>(towlower(ch));
+    }
+
+    const wchar_t first = _needle.front();
+    const wchar_t last  = _needle.back();
+    if (first >= 0x80 || last >= 0x80)
+    {
+        return; // non-ASCII folding has too many equivalents for a two-value compare
+    }
+
+    _firstIsAlpha = IsAsciiLower(first);
+    _lastIsAlpha  = IsAsciiLower(last);
+    _first[0]     = first;
+    _first[1]     = _firstIsAlpha ? static_cast<wchar_t>(first - L'a' + L'A') : first;
+    _last[0]      = last;
+    _last[1]      = _lastIsAlpha ? static_cast<wchar_t>(last - L'a' + L'A') : last;
+    _vectorized   = true;
+}
+
+bool Finder::Verify(const wchar_t* at) const noexcept
+{
+    if (_caseSensitive)
+    {
+        return std::memcmp(at, _needle.data(), _needle.size() * sizeof(wchar_t)) == 0;
+    }
+
+    for (size_t i = 0; i < _needle.size(); ++i)
+    {
+        if (static_cast<wchar_t>(towlower(at[i])) != _needle[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t Finder::FindScalar(std::wstring_view hay, size_t from, size_t lastStart) const noexcept
+{
+    if (_caseSensitive)
+    {
+        return hay.find(_needle, from);
+    }
+
+    const wchar_t first = _needle.front();
+    for (size_t pos = from; pos <= lastStart; ++pos)
+    {
+        if (static_cast<wchar_t>(towlower(hay[pos])) == first && Verify(hay.data() + pos))
+        {
+            return pos;
+        }
+    }
+    return std::wstring_view::npos;
+}
+
+size_t Finder::Find(std::wstring_view hay, size_t from) const noexcept
+{
+    const size_t length = _needle.size();
+    if (length == 0 || hay.size() < length || from > hay.size() - length)
+    {
+        return std::wstring_view::npos;
+    }
+
+    const size_t lastStart = hay.size() - length;
+    size_t pos             = from;
+
+#if defined(_M_X64) || defined(_M_IX86)
+    if (_vectorized)
+    {
+        const wchar_t* data    = hay.data();
+        const __m128i first0   = _mm_set1_epi16(static_cast<short>(_first[0]));
+        const __m128i first1   = _mm_set1_epi16(static_cast<short>(_first[1]));
+        const __m128i last0    = _mm_set1_epi16(static_cast<short>(_last[0]));
+        const __m128i last1    = _mm_set1_epi16(static_cast<short>(_last[1]));
+        const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(kNonAsciiBit));
+        const __m128i zero     = _mm_setzero_si128();
+        const __m128i ones     = _mm_cmpeq_epi16(zero, zero);
+
+        // pos + kLanes - 1 <= lastStart, so the tail load ends at or before the last code unit of hay
+        for (; pos + kLanes <= lastStart + 1; pos += kLanes)
+        {
+            const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + length - 1));
+
+            __m128i headHit = _mm_or_si128(_mm_cmpeq_epi16(head, first0), _mm_cmpeq_epi16(head, first1));
+            __m128i tailHit = _mm_or_si128(_mm_cmpeq_epi16(tail, last0), _mm_cmpeq_epi16(tail, last1));
+            if (_firstIsAlpha)
+            {
+                headHit = _mm_or_si128(headHit, _mm_andnot_si128(_mm_cmpeq_epi16(_mm_and_si128(head, nonAscii), zero), ones));
+            }
+            if (_lastIsAlpha)
+            {
+                tailHit = _mm_or_si128(tailHit, _mm_andnot_si128(_mm_cmpeq_epi16(_mm_and_si128(tail, nonAscii), zero), ones));
+            }
+
+            // One bit per 16-bit lane (movemask yields two identical bits per lane)
+            unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(headHit, tailHit))) & 0x5555u;
+            while (mask != 0)
+            {
+                const size_t candidate = pos + (static_cast<size_t>(std::countr_zero(mask)) >> 1);
+                if (Verify(data + candidate))
+                {
+                    return candidate;
+                }
+                mask &= mask - 1u;
+            }
+        }
+    }
+#elif defined(_M_ARM64)
+    if (_vectorized)
+    {
+        const uint16_t* data      = reinterpret_cast<const uint16_t*>(hay.data());
+        const uint16x8_t first0   = vdupq_n_u16(static_cast<uint16_t>(_first[0]));
+        const uint16x8_t first1   = vdupq_n_u16(static_cast<uint16_t>(_first[1]));
+        const uint16x8_t last0    = vdupq_n_u16(static_cast<uint16_t>(_last[0]));
+        const uint16x8_t last1    = vdupq_n_u16(static_cast<uint16_t>(_last[1]));
+        const uint16x8_t nonAscii = vdupq_n_u16(static_cast<uint16_t>(kNonAsciiBit));
+
+        for (; pos + kLanes <= lastStart + 1; pos += kLanes)
+        {
+            const uint16x8_t head = vld1q_u16(data + pos);
+            const uint16x8_t tail = vld1q_u16(data + pos + length - 1);
+
+            uint16x8_t headHit = vorrq_u16(vceqq_u16(head, first0), vceqq_u16(head, first1));
+            uint16x8_t tailHit = vorrq_u16(vceqq_u16(tail, last0), vceqq_u16(tail, last1));
+            if (_firstIsAlpha)
+            {
+                headHit = vorrq_u16(headHit, vtstq_u16(head, nonAscii));
+            }
+            if (_lastIsAlpha)
+            {
+                tailHit = vorrq_u16(tailHit, vtstq_u16(tail, nonAscii));
+            }
+
+            const uint16x8_t hit = vandq_u16(headHit, tailHit);
+            if (vmaxvq_u16(hit) == 0)
+            {
+                continue;
+            }
+
+            std::array<uint16_t, kLanes> lanes{};
+            vst1q_u16(lanes.data(), hit);
+            for (size_t lane = 0; lane < kLanes; ++lane)
+            {
+                if (lanes[lane] != 0 && Verify(hay.data() + pos + lane))
+                {
+                    return pos + lane;
+                }
+            }
+        }
+    }
+#endif
+
+    return FindScalar(hay, pos, lastStart);
+}
+
+Query Query::Parse(std::wstring_view input, bool caseSensitive)
+{
+    Query query;
+    std::wstring_view rest = input;
+
+    while (true)
+    {
+        std::wstring_view token = rest;
+        while (! token.empty() && token.front() == L' ')
+        {
+            token.remove_prefix(1);
+        }
+
+        const bool isPid = StartsWithNoCase(token, L"pid:");
+        const bool isTid = ! isPid && StartsWithNoCase(token, L"tid:");
+        if (! isPid && ! isTid)
+        {
+            break;
+        }
+
+        token.remove_prefix(4);
+        const size_t end                 = std::min(token.find(L' '), token.size());
+        const std::optional<uint32_t> id = ParseId(token.substr(0, end));
+        if (! id.has_value())
+        {
+            break; // not an id token; treat the rest as literal text
+        }
+
+        (isPid ? query.processId : query.threadId) = id;
+        rest                                        = token.substr(end);
+    }
+
+    if (query.processId.has_value() || query.threadId.has_value())
+    {
+        while (! rest.empty() && rest.front() == L' ')
+        {
+            rest.remove_prefix(1);
+        }
+    }
+
+    query.text = Finder(rest, caseSensitive);
+    return query;
+}
+} // namespace TextSearch
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#pragma warning(push)
+#pragma warning(disable : 4820) // bytes padding added after data member
+
+namespace TextSearch
+{
+// Finder: precompiled UTF-16 substring matcher used by the scroll-back search workers.
+// Candidate positions are located 8 code units at a time (SSE2 on x86/x64, NEON on ARM64) by comparing the first and
+// last needle characters, then verified with a full compare. Case-insensitive matching keeps the find bar semantics
+// (towlower(hay) == towlower(needle)); non-ASCII code units that may fold onto an ASCII letter are always treated as candidates.
+class Finder
+{
+public:
+    Finder() = default;
+    Finder(std::wstring_view needle, bool caseSensitive);
+
+    bool Empty() const noexcept
+    {
+        return _needle.empty();
+    }
+    size_t Length() const noexcept
+    {
+        return _needle.size();
+    }
+
+    // Returns the first match position at or after `from`, or std::wstring_view::npos.
+    size_t Find(std::wstring_view hay, size_t from) const noexcept;
+
+private:
+    bool Verify(const wchar_t* at) const noexcept;
+    size_t FindScalar(std::wstring_view hay, size_t from, size_t lastStart) const noexcept;
+
+    std::wstring _needle; // lowercased when ! _caseSensitive
+    bool _caseSensitive = true;
+    bool _vectorized    = false; // false when a case-insensitive endpoint is not ASCII (scalar path handles full folding)
+    bool _firstIsAlpha  = false; // case-insensitive ASCII letter endpoints also accept any non-ASCII code unit as candidate
+    bool _lastIsAlpha   = false;
+    wchar_t _first[2]{};         // accepted code units for needle.front() (lower/upper)
+    wchar_t _last[2]{};          // accepted code units for needle.back()
+};
+
+// Query: parsed find-bar input. Leading `pid:<n>` / `tid:<n>` tokens (decimal or 0x-hex) restrict matches to lines
+// with that metadata; the remainder is the text to find. An id-only query matches the whole message text of each line.
+struct Query
+{
+    Finder text;
+    std::optional<uint32_t> processId;
+    std::optional<uint32_t> threadId;
+
+    bool Empty() const noexcept
+    {
+        return text.Empty() && ! processId.has_value() && ! threadId.has_value();
+    }
+
+    static Query Parse(std::wstring_view input, bool caseSensitive);
+};
+} // namespace TextSearch
+
+#pragma warning(pop)
@@ -45,6 +45,25 @@
 #define IDS_FIND_FROM_CURRENT_POSITION 182
 #define IDS_FIND_FROM_TOP 183
 #define IDS_FIND_FROM_BOTTOM 184
+#define IDS_PERFSCOPE_TITLE 300
+#define IDS_PERFSCOPE_COL_SCOPE 301
+#define IDS_PERFSCOPE_COL_COUNT 302
+#define IDS_PERFSCOPE_COL_FAILURES 303
+#define IDS_PERFSCOPE_COL_MEAN 304
+#define IDS_PERFSCOPE_COL_P50 305
+#define IDS_PERFSCOPE_COL_P95 306
+#define IDS_PERFSCOPE_COL_P99 307
+#define IDS_PERFSCOPE_COL_MAX 308
+#define IDS_PERFSCOPE_COL_LAST 309
+#define IDS_PERFSCOPE_COL_TOTAL 310
+#define IDS_PERFSCOPE_COL_VALUE0_RATE 311
+#define IDS_PERFSCOPE_COL_VALUE1_RATE 312
+#define IDS_PERFSCOPE_MENU_EXPORT_CSV 313
+#define IDS_PERFSCOPE_MENU_EXPORT_JSON 314
+#define IDS_PERFSCOPE_MENU_RESET 315
+#define IDS_PERFSCOPE_FILTER_CSV 316
+#define IDS_PERFSCOPE_FILTER_JSON 317
+#define IDS_PERFSCOPE_MSG_EXPORT_FAILED 318
 #define IDI_REDSALAMANDERMONITOR 107
 #define IDI_SMALL 108
 #define IDC_REDSALAMANDERMONITOR 109
@@ -85,6 +104,10 @@
 #define IDM_EDIT_FIND_NEXT 32797
 #define IDM_EDIT_FIND_PREV 32798
 #define IDM_FILTER_PRESET_ERRORS_DEBUG 32799
+#define IDM_VIEW_PERF_SCOPES 32806
+#define IDM_PERFSCOPE_EXPORT_CSV 32807
+#define IDM_PERFSCOPE_EXPORT_JSON 32808
+#define IDM_PERFSCOPE_RESET 32809
 #define IDC_STATIC -1
 
 // Next default values for new objects
@@ -93,7 +116,7 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_NO_MFC 1
 #define _APS_NEXT_RESOURCE_VALUE 131
-#define _APS_NEXT_COMMAND_VALUE 32806
+#define _APS_NEXT_COMMAND_VALUE 32810
 #define _APS_NEXT_CONTROL_VALUE 2001
 #define _APS_NEXT_SYMED_VALUE 110
 #endif